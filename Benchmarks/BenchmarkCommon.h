@@ -0,0 +1,74 @@
+﻿//--------------------------------------------------------------------------------------
+// File: BenchmarkCommon.h
+//
+// ベンチマークの時間の計測と引数の処理（ヘッダーのみ）
+//
+// Usage: MeasureSeconds は関数を指定した回数だけ実行し、一番速かった１回の時間を返します。
+//        引数に --quick を付けると IsQuick が true を返すので、問題の大きさや回数を
+//        減らしてください（CTest では --quick を付けて、動くことだけを確認します）。
+//        DoNotOptimize は計算結果が最適化で消されないようにする関数、ClobberMemory は
+//        同じ計算を繰り返すループが１回にまとめられないようにする関数です。
+//
+//	<<< 記述例 >>
+//	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+//	double seconds = ImaseBenchmark::MeasureSeconds([&]() { Work(); }, quick ? 1 : 10);
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ImaseBenchmark
+{
+	// --quick が指定されたか調べる関数
+	inline bool IsQuick(int argc, char* argv[])
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			if (std::strcmp(argv[i], "--quick") == 0) return true;
+		}
+		return false;
+	}
+
+	// 関数を repeat 回実行して一番速かった時間（秒）を返す関数
+	template <class Function>
+	double MeasureSeconds(const Function& function, int repeat)
+	{
+		double best = 0.0;
+		for (int i = 0; i < std::max(repeat, 1); i++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			function();
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (i == 0 || seconds < best) best = seconds;
+		}
+		return best;
+	}
+
+	// 計算結果が最適化で消されないようにする関数
+	template <class T>
+	inline void DoNotOptimize(const T& value)
+	{
+		static volatile char s_sink;
+		s_sink = *reinterpret_cast<const volatile char*>(&value);
+		(void)s_sink;
+	}
+
+	// メモリの内容が変わったものとしてコンパイラに扱わせる関数
+	inline void ClobberMemory()
+	{
+#if defined(_MSC_VER)
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+}
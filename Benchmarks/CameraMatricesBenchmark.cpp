@@ -0,0 +1,90 @@
+﻿//--------------------------------------------------------------------------------------
+// File: CameraMatricesBenchmark.cpp
+//
+// CameraMatrices（複数のビュー行列・射影行列の作成）のベンチマーク
+//
+// SIMD 版とスカラー版（基準の実装）で、行列１つあたりの作成時間を比べます。
+//
+//   CameraMatricesBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "CameraMatrices.h"
+
+using namespace Imase::Math;
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const size_t count = 1024;
+	const int loops = quick ? 10 : 2000;
+	const int repeat = quick ? 1 : 5;
+
+	std::vector<Vector3> eyes(count), targets(count), ups(count);
+	std::vector<float> fovY(count), aspect(count), nearPlane(count), farPlane(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		float t = static_cast<float>(i);
+		eyes[i] = Vector3(std::sin(t) * 20.0f, 5.0f + std::cos(t * 0.7f), std::cos(t) * 20.0f);
+		targets[i] = Vector3(0.0f, 1.0f, 0.0f);
+		ups[i] = Vector3(0.1f, 1.0f, 0.0f);
+		fovY[i] = 0.5f + 0.001f * t;
+		aspect[i] = 16.0f / 9.0f;
+		nearPlane[i] = 0.1f;
+		farPlane[i] = 100.0f;
+	}
+	std::vector<Matrix> matrices(count);
+
+	auto report = [&](const char* name, double seconds)
+	{
+		std::printf("%-28s %8.2f ns/matrix\n", name, seconds * 1.0e9 / (static_cast<double>(count) * loops));
+	};
+
+	report("LookAt scalar", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int i = 0; i < loops; i++)
+		{
+			CreateLookAtMatricesScalar(eyes.data(), targets.data(), ups.data(), matrices.data(), count);
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(matrices[0]);
+	}, repeat));
+
+	report("LookAt SIMD", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int i = 0; i < loops; i++)
+		{
+			CreateLookAtMatrices(eyes.data(), targets.data(), ups.data(), matrices.data(), count);
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(matrices[0]);
+	}, repeat));
+
+	report("Perspective scalar", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int i = 0; i < loops; i++)
+		{
+			CreatePerspectiveMatricesScalar(fovY.data(), aspect.data(), nearPlane.data(), farPlane.data(), matrices.data(), count);
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(matrices[0]);
+	}, repeat));
+
+	report("Perspective SIMD", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int i = 0; i < loops; i++)
+		{
+			CreatePerspectiveMatrices(fovY.data(), aspect.data(), nearPlane.data(), farPlane.data(), matrices.data(), count);
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(matrices[0]);
+	}, repeat));
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+﻿//--------------------------------------------------------------------------------------
+// File: EntityWorldBenchmark.cpp
+//
+// EntityWorld（アーキタイプごとの SoA 形式のエンティティの入れ物）のベンチマーク
+//
+// 1,000,000 個のエンティティで次を計測します。
+//   ・ForEach / ParallelForEach で位置を速度で進める１エンティティあたりの時間
+//     （同じ計算を std::vector の SoA 配列で行った場合と比べる）
+//   ・作成・コンポーネントの追加・削除・エンティティの削除（構造の変更）の１回あたりの時間
+//   ・TreeScene::Update の配列の作り直しと、変更がない場合に省略した時の時間
+//
+//   EntityWorldBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "EntityWorld.h"
+#include "JobSystem.h"
+#include "TreeScene.h"
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	struct Position { Vector3 value; };
+	struct Velocity { Vector3 value; };
+	struct Tag { uint32_t value; };
+}
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const size_t count = quick ? 20000 : 1000000;
+	const size_t changeCount = count / 10;
+	const int loops = quick ? 1 : 20;
+	const int repeat = quick ? 1 : 5;
+	const float elapsedTime = 1.0f / 60.0f;
+
+	std::printf("%zu entities\n", count);
+
+	auto report = [](const char* name, double seconds, double operations)
+	{
+		std::printf("%-32s %9.3f ms  %7.2f ns/op\n", name, seconds * 1.0e3, seconds * 1.0e9 / operations);
+	};
+
+	// ----- 構造の変更 ----- //
+
+	EntityWorld world;
+	std::vector<Entity> entities(count);
+
+	report("Create (Position, Velocity)", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		world.Clear();
+		for (size_t i = 0; i < count; i++)
+		{
+			float f = static_cast<float>(i);
+			entities[i] = world.Create(Position{ Vector3(f, 0.0f, 0.0f) }, Velocity{ Vector3(1.0f, 2.0f, 3.0f) });
+		}
+	}, repeat), static_cast<double>(count));
+
+	report("Add<Tag>", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (size_t i = 0; i < changeCount; i++) world.Add(entities[i * 10], Tag{ static_cast<uint32_t>(i) });
+	}, 1), static_cast<double>(changeCount));
+
+	report("Remove<Tag>", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (size_t i = 0; i < changeCount; i++) world.Remove<Tag>(entities[i * 10]);
+	}, 1), static_cast<double>(changeCount));
+
+	report("Get<Position> (random order)", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		float sum = 0.0f;
+		for (size_t i = 0; i < changeCount; i++) sum += world.Get<Position>(entities[(i * 7919) % count])->value.x;
+		ImaseBenchmark::DoNotOptimize(sum);
+	}, repeat), static_cast<double>(changeCount));
+
+	// ----- 反復 ----- //
+
+	std::printf("archetypes %zu  chunks %zu\n", world.GetArchetypeCount(), world.GetChunkCount());
+
+	report("ForEach integrate", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			world.ForEach<Position, Velocity>([&](const EntityChunkView& chunk, Position* position, const Velocity* velocity)
+				{
+					for (size_t i = 0; i < chunk.count; i++) position[i].value += velocity[i].value * elapsedTime;
+				});
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat), static_cast<double>(count) * loops);
+
+	report("ParallelForEach integrate", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			world.ParallelForEach<Position, Velocity>([&](const EntityChunkView& chunk, Position* position, const Velocity* velocity)
+				{
+					for (size_t i = 0; i < chunk.count; i++) position[i].value += velocity[i].value * elapsedTime;
+				});
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat), static_cast<double>(count) * loops);
+
+	// 比較用：同じ計算を１つの配列で行う
+	std::vector<Vector3> positions(count, Vector3(0.0f, 0.0f, 0.0f)), velocities(count, Vector3(1.0f, 2.0f, 3.0f));
+	report("std::vector integrate", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (size_t i = 0; i < count; i++) positions[i] += velocities[i] * elapsedTime;
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat), static_cast<double>(count) * loops);
+
+	report("Destroy (every 10th)", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (size_t i = 0; i < changeCount; i++) world.Destroy(entities[i * 10]);
+	}, 1), static_cast<double>(changeCount));
+
+	// ----- TreeScene::Update ----- //
+
+	TreeScene scene;
+	scene.Initialize();
+	const int updateLoops = quick ? 10 : 1000;
+
+	report("TreeScene::Update rebuild", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < updateLoops; l++)
+		{
+			scene.GetWorld();		// 変更できるようにしたので作り直す
+			scene.Update();
+		}
+	}, repeat), static_cast<double>(updateLoops));
+
+	report("TreeScene::Update unchanged", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < updateLoops; l++)
+		{
+			scene.Update();
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat), static_cast<double>(updateLoops));
+
+	std::printf("trees %zu  workers: %u\n", scene.GetForestTreeCount(), JobSystem::GetDefault().GetWorkerCount());
+	return 0;
+}
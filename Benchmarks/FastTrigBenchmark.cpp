@@ -0,0 +1,68 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FastTrigBenchmark.cpp
+//
+// FastTrig（高速な三角関数）のベンチマーク
+//
+// libm（std::sin / std::cos / std::tan / std::atan2 の float 版）、FastTrig のスカラー版、
+// 配列版（SIMD）で、１要素あたりの時間を比べます。
+//
+//   FastTrigBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "FastTrig.h"
+
+using namespace Imase::Math;
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const size_t count = 4096;
+	const int loops = quick ? 2 : 2000;
+	const int repeat = quick ? 1 : 5;
+
+	// カメラやアニメーションで使う程度の範囲の角度
+	std::vector<float> x(count), y(count), s(count), c(count), t(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		x[i] = (static_cast<float>(i) / count - 0.5f) * 200.0f;
+		y[i] = std::cos(static_cast<float>(i) * 0.37f) * 10.0f;
+	}
+
+	auto report = [&](const char* name, double seconds)
+	{
+		std::printf("%-28s %8.2f ns/element\n", name, seconds * 1.0e9 / (static_cast<double>(count) * loops));
+	};
+
+	auto run = [&](const char* name, auto function)
+	{
+		report(name, ImaseBenchmark::MeasureSeconds([&]()
+		{
+			for (int l = 0; l < loops; l++)
+			{
+				function();
+				ImaseBenchmark::ClobberMemory();
+			}
+		}, repeat));
+	};
+
+	run("std::sin + std::cos", [&]() { for (size_t i = 0; i < count; i++) { s[i] = std::sin(x[i]); c[i] = std::cos(x[i]); } });
+	run("SinCos scalar", [&]() { for (size_t i = 0; i < count; i++) SinCos(x[i], &s[i], &c[i]); });
+	run("SinCos array (SIMD)", [&]() { SinCos(x.data(), s.data(), c.data(), count); });
+
+	run("std::tan", [&]() { for (size_t i = 0; i < count; i++) t[i] = std::tan(x[i]); });
+	run("Tan scalar", [&]() { for (size_t i = 0; i < count; i++) t[i] = Tan(x[i]); });
+	run("Tan array (SIMD)", [&]() { Tan(x.data(), t.data(), count); });
+
+	run("std::atan2", [&]() { for (size_t i = 0; i < count; i++) t[i] = std::atan2(y[i], x[i]); });
+	run("Atan2 scalar", [&]() { for (size_t i = 0; i < count; i++) t[i] = Atan2(y[i], x[i]); });
+	run("Atan2 array (SIMD)", [&]() { Atan2(y.data(), x.data(), t.data(), count); });
+
+	return 0;
+}
@@ -0,0 +1,121 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FrustumCullingBenchmark.cpp
+//
+// FrustumCulling（視錐台カリング）のベンチマーク
+//
+// 100,000 個のバウンディングスフィア／AABB を、スカラー版（Frustum::Intersects）、
+// SIMD 版（１スレッド）、SIMD 版（ジョブシステムの全ワーカー）で判定して比べます。
+//
+//   FrustumCullingBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "FrustumCulling.h"
+#include "JobSystem.h"
+
+using namespace Imase;
+using namespace Imase::Math;
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const size_t count = quick ? 10000 : 100000;
+	const int loops = quick ? 1 : 50;
+	const int repeat = quick ? 1 : 5;
+
+	Matrix view = Matrix::CreateLookAt(Vector3(0.0f, 5.0f, 20.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3::Up());
+	Matrix proj = Matrix::CreatePerspective(0.785398163f, 16.0f / 9.0f, 0.1f, 100.0f);
+	Frustum frustum = Frustum::CreateFromViewProjection(view * proj);
+
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+	std::uniform_real_distribution<float> size(0.1f, 5.0f);
+	std::vector<float> x(count), y(count), z(count), r(count), ex(count), ey(count), ez(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		x[i] = position(random); y[i] = position(random) * 0.2f; z[i] = position(random);
+		r[i] = size(random); ex[i] = size(random); ey[i] = size(random); ez[i] = size(random);
+	}
+	SphereArrays spheres = { x.data(), y.data(), z.data(), r.data() };
+	BoxArrays boxes = { x.data(), y.data(), z.data(), ex.data(), ey.data(), ez.data() };
+	std::vector<uint32_t> visible(count);
+	size_t visibleCount = 0;
+
+	auto report = [&](const char* name, double seconds)
+	{
+		std::printf("%-28s %8.3f ms  %6.2f ns/object  (%zu visible)\n",
+			name, seconds * 1.0e3 / loops, seconds * 1.0e9 / (static_cast<double>(count) * loops), visibleCount);
+	};
+
+	report("Spheres scalar", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			visibleCount = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (frustum.Intersects(Vector3(x[i], y[i], z[i]), r[i])) visible[visibleCount++] = static_cast<uint32_t>(i);
+			}
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	report("Spheres SIMD 1 thread", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			visibleCount = CullSpheres(frustum, spheres, count, visible.data(), 1);
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	report("Spheres SIMD all workers", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			visibleCount = CullSpheres(frustum, spheres, count, visible.data());
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	report("Boxes scalar", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			visibleCount = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (frustum.Intersects(Vector3(x[i], y[i], z[i]), Vector3(ex[i], ey[i], ez[i]))) visible[visibleCount++] = static_cast<uint32_t>(i);
+			}
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	report("Boxes SIMD 1 thread", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			visibleCount = CullBoxes(frustum, boxes, count, visible.data(), 1);
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	report("Boxes SIMD all workers", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			visibleCount = CullBoxes(frustum, boxes, count, visible.data());
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	std::printf("workers: %u\n", JobSystem::GetDefault().GetWorkerCount());
+	return 0;
+}
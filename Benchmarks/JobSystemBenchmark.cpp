@@ -0,0 +1,100 @@
+﻿//--------------------------------------------------------------------------------------
+// File: JobSystemBenchmark.cpp
+//
+// JobSystem（ワークスティーリングのジョブシステム）のスケーリングのベンチマーク
+//
+// ワーカーの数を 1, 2, 4, … と増やしながら、次の３つを計測します。
+//   ・空のジョブを積んで待つ１ジョブあたりの時間（投入・盗み・完了のオーバーヘッド）
+//   ・計算の重い ParallelFor の時間と１ワーカーに対する速度の比
+//   ・継続を連鎖させた場合の１段あたりの時間（ジョブの間の待ち時間）
+// コアの数より多いワーカーでは速度は上がらないので、結果は CPU のコア数と合わせて見てください。
+//
+//   JobSystemBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.h"
+
+using namespace Imase;
+
+namespace
+{
+	void Empty(void*) {}
+}
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const uint32_t jobCount = quick ? 1000 : 20000;
+	const size_t elementCount = quick ? 100000 : 4000000;
+	const uint32_t chainLength = quick ? 100 : 2000;
+	const int repeat = quick ? 1 : 5;
+
+	unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+	unsigned int maxWorkers = std::min(std::max(4u, cores), JobSystem::MAX_WORKERS);
+
+	std::vector<float> values(elementCount);
+	for (size_t i = 0; i < elementCount; i++) values[i] = static_cast<float>(i % 1000) * 0.01f;
+	std::vector<float> results(elementCount);
+
+	std::printf("cores: %u\n", cores);
+	std::printf("%-8s %12s %14s %9s %16s\n", "workers", "ns/job", "ParallelFor ms", "speedup", "ns/continuation");
+
+	double baseSeconds = 0.0;
+	for (unsigned int workers = 1; workers <= maxWorkers; workers *= 2)
+	{
+		JobSystem jobs;
+		jobs.Initialize(workers);
+
+		// 空のジョブ
+		double emptySeconds = ImaseBenchmark::MeasureSeconds([&]()
+		{
+			JobCounter counter;
+			for (uint32_t i = 0; i < jobCount; i++) jobs.Run(&Empty, nullptr, &counter);
+			jobs.Wait(&counter);
+		}, repeat);
+
+		// 計算の重い ParallelFor
+		double forSeconds = ImaseBenchmark::MeasureSeconds([&]()
+		{
+			jobs.ParallelFor(0, elementCount, 4096, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++) results[i] = std::sqrt(values[i]) * std::sin(values[i]);
+				});
+			ImaseBenchmark::ClobberMemory();
+		}, repeat);
+		if (workers == 1) baseSeconds = forSeconds;
+
+		// 継続の連鎖
+		std::unique_ptr<JobCounter[]> counters;
+		double chainSeconds = ImaseBenchmark::MeasureSeconds([&]()
+		{
+			counters.reset(new JobCounter[chainLength]);
+			for (uint32_t i = 0; i < chainLength; i++)
+			{
+				jobs.RunAfter(i > 0 ? &counters[i - 1] : nullptr, &Empty, nullptr, &counters[i]);
+			}
+			jobs.Wait(&counters[chainLength - 1]);
+		}, repeat);
+
+		std::printf("%-8u %12.1f %14.3f %8.2fx %16.1f\n", workers,
+			emptySeconds * 1.0e9 / jobCount, forSeconds * 1.0e3, baseSeconds / forSeconds,
+			chainSeconds * 1.0e9 / chainLength);
+
+		jobs.Shutdown();
+	}
+
+	ImaseBenchmark::DoNotOptimize(results[elementCount / 2]);
+	return 0;
+}
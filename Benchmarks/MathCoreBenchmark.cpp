@@ -0,0 +1,121 @@
+﻿//--------------------------------------------------------------------------------------
+// File: MathCoreBenchmark.cpp
+//
+// MathCore（ベクトル・行列・クォータニオン）のベンチマーク
+//
+// 行列の積と座標変換の SIMD 版とスカラー版、逆行列、クォータニオンの回転の時間を
+// １回あたりで比べます。
+//
+//   MathCoreBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "MathCore.h"
+
+using namespace Imase::Math;
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const size_t count = 4096;
+	const int loops = quick ? 2 : 500;
+	const int repeat = quick ? 1 : 5;
+
+	// 入力（キャッシュに収まる大きさ）
+	std::vector<Matrix> a(count), b(count), r(count);
+	std::vector<Vector4> v(count), vr(count);
+	std::vector<Quaternion> q(count);
+	std::vector<Vector3> p(count), pr(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		float t = static_cast<float>(i) * 0.01f;
+		a[i] = Matrix::CreateWorld(Vector3(t, 1.0f, -t), Quaternion::CreateFromYawPitchRoll(t, 0.5f * t, 0.1f), Vector3(1.0f, 2.0f, 1.0f));
+		b[i] = Matrix::CreateLookAt(Vector3(10.0f, 5.0f, t), Vector3(), Vector3::Up());
+		v[i] = Vector4(t, 2.0f * t, 1.0f, 1.0f);
+		q[i] = Quaternion::CreateFromAxisAngle(Vector3::UnitY(), t);
+		p[i] = Vector3(t, -t, 1.0f);
+	}
+
+	auto report = [&](const char* name, double seconds)
+	{
+		std::printf("%-28s %8.2f ns/op\n", name, seconds * 1.0e9 / (static_cast<double>(count) * loops));
+	};
+
+	report("Multiply scalar", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (size_t i = 0; i < count; i++) r[i] = Matrix::MultiplyScalar(a[i], b[i]);
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(r[0]);
+	}, repeat));
+
+	report("Multiply SIMD", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (size_t i = 0; i < count; i++) r[i] = Matrix::Multiply(a[i], b[i]);
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(r[0]);
+	}, repeat));
+
+	report("Transform Vector4 SIMD", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (size_t i = 0; i < count; i++) vr[i] = a[i].Transform(v[i]);
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(vr[0]);
+	}, repeat));
+
+	report("TransformPoint scalar", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (size_t i = 0; i < count; i++) pr[i] = a[i].TransformPoint(p[i]);
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(pr[0]);
+	}, repeat));
+
+	report("Invert", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (size_t i = 0; i < count; i++) r[i] = a[i].Invert();
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(r[0]);
+	}, repeat));
+
+	report("InvertOrthonormal", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (size_t i = 0; i < count; i++) r[i] = b[i].InvertOrthonormal();
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(r[0]);
+	}, repeat));
+
+	report("Quaternion::Rotate", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (size_t i = 0; i < count; i++) pr[i] = q[i].Rotate(p[i]);
+			ImaseBenchmark::ClobberMemory();
+		}
+		ImaseBenchmark::DoNotOptimize(pr[0]);
+	}, repeat));
+
+	return 0;
+}
@@ -0,0 +1,184 @@
+﻿//--------------------------------------------------------------------------------------
+// File: OcclusionCullingBenchmark.cpp
+//
+// OcclusionCuller（マスク付きのソフトウェアオクルージョンカリング）のベンチマーク
+//
+// SceneBenchmark と同じ配置（半径 5 の円形に並べた 12 枚の壁と、64×64 本の森）を
+// 壁より低い視点から見て、遮蔽物のラスタライズと AABB の判定（IsVisible を１つずつ呼ぶ場合と
+// CullBoxes の１スレッド・ジョブシステムの全ワーカー）の処理時間と隠れた数を計測します。
+//
+//   OcclusionCullingBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "FastTrig.h"
+#include "JobSystem.h"
+#include "OcclusionCulling.h"
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	// 壁の箱（底面が y = 0 の単位立方体）
+	const Vector3 BOX_POSITIONS[8] =
+	{
+		Vector3(-0.5f, 0.0f, -0.5f), Vector3(0.5f, 0.0f, -0.5f),
+		Vector3(0.5f, 1.0f, -0.5f), Vector3(-0.5f, 1.0f, -0.5f),
+		Vector3(-0.5f, 0.0f, 0.5f), Vector3(0.5f, 0.0f, 0.5f),
+		Vector3(0.5f, 1.0f, 0.5f), Vector3(-0.5f, 1.0f, 0.5f),
+	};
+
+	const uint16_t BOX_INDICES[36] =
+	{
+		0, 2, 1, 0, 3, 2,	// 奥
+		4, 5, 6, 4, 6, 7,	// 手前
+		0, 4, 7, 0, 7, 3,	// 左
+		1, 2, 6, 1, 6, 5,	// 右
+		3, 7, 6, 3, 6, 2,	// 上
+		0, 1, 5, 0, 5, 4,	// 下
+	};
+
+	constexpr int WALL_COUNT = 12;
+	constexpr float RING_RADIUS = 5.0f;
+	constexpr float WALL_HEIGHT = 3.0f;
+	constexpr float WALL_THICKNESS = 0.5f;
+
+	constexpr int FOREST_SIZE = 64;
+	constexpr float FOREST_SPACING = 1.5f;
+	constexpr float FOREST_CLEARING = 6.0f;
+}
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const int loops = quick ? 1 : 200;
+	const int repeat = quick ? 1 : 5;
+
+	// 壁の上端より低い視点（SceneBenchmark の既定の回るカメラと同じ高さと距離）
+	Matrix view = Matrix::CreateLookAt(Vector3(4.0f, 2.6f, 13.3f), Vector3(0.0f, 0.0f, 0.0f), Vector3::Up());
+	Matrix proj = Matrix::CreatePerspectiveInfiniteReverseZ(0.785398163f, 16.0f / 9.0f, 0.1f);
+	Matrix viewProjection = view * proj;
+
+	std::vector<Matrix> walls;
+	for (int i = 0; i < WALL_COUNT; i++)
+	{
+		float angle = 6.28318531f * i / WALL_COUNT;
+		float width = 6.28318531f * RING_RADIUS / WALL_COUNT * 0.75f;
+		float s, c;
+		SinCos(angle, &s, &c);
+		walls.push_back(Matrix::CreateScale(Vector3(width, WALL_HEIGHT, WALL_THICKNESS))
+			* Matrix::CreateRotationY(angle)
+			* Matrix::CreateTranslation(Vector3(s, 0.0f, c) * RING_RADIUS));
+	}
+
+	// 木の AABB（中央の床の範囲には置かない）
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> jitter(0.0f, 1.0f);
+	std::vector<float> x, y, z, ex, ey, ez;
+	for (int j = 0; j < FOREST_SIZE; j++)
+	{
+		for (int i = 0; i < FOREST_SIZE; i++)
+		{
+			float px = (i - FOREST_SIZE / 2 + jitter(random)) * FOREST_SPACING;
+			float pz = (j - FOREST_SIZE / 2 + jitter(random)) * FOREST_SPACING;
+			if (std::fabs(px) < FOREST_CLEARING && std::fabs(pz) < FOREST_CLEARING) continue;
+			x.push_back(px); y.push_back(1.0f); z.push_back(pz);
+			ex.push_back(1.0f); ey.push_back(1.0f); ez.push_back(1.0f);
+		}
+	}
+	const size_t count = x.size();
+	BoxArrays boxes = { x.data(), y.data(), z.data(), ex.data(), ey.data(), ez.data() };
+	std::vector<uint32_t> visible(count);
+	size_t visibleCount = 0;
+
+	OcclusionCuller culler;
+	auto renderOccluders = [&](unsigned int threadCount)
+	{
+		culler.BeginFrame(viewProjection);
+		for (const Matrix& world : walls) culler.AddOccluder(BOX_POSITIONS, 8, BOX_INDICES, 36, world);
+		culler.RenderOccluders(threadCount);
+	};
+
+	std::printf("%zu boxes, %d walls, %ux%u buffer\n", count, WALL_COUNT, culler.GetWidth(), culler.GetHeight());
+
+	auto reportRaster = [&](const char* name, double seconds)
+	{
+		std::printf("%-28s %8.3f us  (%u triangles rasterized)\n",
+			name, seconds * 1.0e6 / loops, culler.GetStats().rasterizedTriangles);
+	};
+
+	reportRaster("Rasterize 1 thread", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			renderOccluders(1);
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	reportRaster("Rasterize all workers", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			renderOccluders(0);
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	auto report = [&](const char* name, double seconds)
+	{
+		std::printf("%-28s %8.3f us  %6.2f ns/box  (%zu occluded)\n",
+			name, seconds * 1.0e6 / loops, seconds * 1.0e9 / (static_cast<double>(count) * loops), count - visibleCount);
+	};
+
+	report("IsVisible per box", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			visibleCount = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (culler.IsVisible(Vector3(x[i], y[i], z[i]), Vector3(ex[i], ey[i], ez[i]))) visible[visibleCount++] = static_cast<uint32_t>(i);
+			}
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+	size_t occludedSerial = count - visibleCount;
+
+	report("CullBoxes 1 thread", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			visibleCount = culler.CullBoxes(boxes, nullptr, count, visible.data(), 1);
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	report("CullBoxes all workers", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			visibleCount = culler.CullBoxes(boxes, nullptr, count, visible.data());
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	std::printf("workers: %u\n", JobSystem::GetDefault().GetWorkerCount());
+
+	// 壁の後ろの木が隠れない場合は配置か判定が壊れている
+	if (occludedSerial == 0 || count - visibleCount != occludedSerial)
+	{
+		std::printf("FAILED: occluded %zu (IsVisible) / %zu (CullBoxes)\n", occludedSerial, count - visibleCount);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,168 @@
+﻿//--------------------------------------------------------------------------------------
+// File: PickingBenchmark.cpp
+//
+// Picking（レイと BVH の交差判定）のベンチマーク
+//
+// 起伏のある地面（三角形）と散らばった箱（AABB）で BVH を構築し、画面の格子状の
+// 位置から作成したレイで、BVH の判定と全ての三角形を調べる総当たりの判定を比べます。
+// 総当たりと結果が一致しないレイの数も表示します（0 になるはず）。
+//
+//   PickingBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Picking.h"
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	// レイと三角形の交差判定（Möller–Trumbore、総当たりの比較用）
+	bool IntersectTriangle(const Ray& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, float* distance)
+	{
+		Vector3 e1 = v1 - v0, e2 = v2 - v0;
+		Vector3 p = ray.direction.Cross(e2);
+		float det = e1.Dot(p);
+		if (std::fabs(det) < 1.0e-12f) return false;
+		float inv = 1.0f / det;
+		Vector3 s = ray.origin - v0;
+		float u = s.Dot(p) * inv;
+		if (u < 0.0f || u > 1.0f) return false;
+		Vector3 q = s.Cross(e1);
+		float v = ray.direction.Dot(q) * inv;
+		if (v < 0.0f || u + v > 1.0f) return false;
+		float t = e2.Dot(q) * inv;
+		if (t < 0.0f) return false;
+		*distance = t;
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const int grid = quick ? 64 : 256;
+	const int rayGrid = quick ? 16 : 64;
+	const int repeat = quick ? 1 : 5;
+
+	// 起伏のある地面（grid × grid の四角形 × ２の三角形）
+	std::vector<Vector3> positions;
+	std::vector<uint32_t> indices;
+	for (int z = 0; z <= grid; z++)
+	{
+		for (int x = 0; x <= grid; x++)
+		{
+			float fx = (static_cast<float>(x) / grid - 0.5f) * 100.0f;
+			float fz = (static_cast<float>(z) / grid - 0.5f) * 100.0f;
+			positions.push_back(Vector3(fx, std::sin(fx * 0.2f) * std::cos(fz * 0.15f) * 2.0f, fz));
+		}
+	}
+	for (int z = 0; z < grid; z++)
+	{
+		for (int x = 0; x < grid; x++)
+		{
+			uint32_t i = static_cast<uint32_t>(z * (grid + 1) + x);
+			uint32_t quad[6] = { i, i + grid + 1, i + 1, i + 1, i + grid + 1, i + grid + 2 };
+			indices.insert(indices.end(), quad, quad + 6);
+		}
+	}
+	size_t triangleCount = indices.size() / 3;
+
+	// 散らばった箱
+	const size_t boxCount = quick ? 10000 : 100000;
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> size(0.1f, 1.0f);
+	std::vector<Vector3> boxMin(boxCount), boxMax(boxCount);
+	for (size_t i = 0; i < boxCount; i++)
+	{
+		Vector3 c(position(random), position(random) * 0.05f + 2.0f, position(random));
+		Vector3 e(size(random), size(random), size(random));
+		boxMin[i] = c - e;
+		boxMax[i] = c + e;
+	}
+
+	// 画面の格子状の位置からのレイ
+	Matrix view = Matrix::CreateLookAt(Vector3(0.0f, 20.0f, 60.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3::Up());
+	Matrix proj = Matrix::CreatePerspective(0.785398163f, 16.0f / 9.0f, 0.1f, 1000.0f);
+	std::vector<Ray> rays;
+	for (int y = 0; y < rayGrid; y++)
+	{
+		for (int x = 0; x < rayGrid; x++)
+		{
+			rays.push_back(CreateRayFromScreen((x + 0.5f) * 1280.0f / rayGrid, (y + 0.5f) * 720.0f / rayGrid, 1280.0f, 720.0f, view, proj));
+		}
+	}
+
+	// ----- 構築 ----- //
+
+	Bvh triangles, boxes;
+	double buildTriangles = ImaseBenchmark::MeasureSeconds([&]() { triangles.BuildFromTriangles(positions.data(), indices.data(), triangleCount); }, repeat);
+	double buildBoxes = ImaseBenchmark::MeasureSeconds([&]() { boxes.BuildFromBoxes(boxMin.data(), boxMax.data(), boxCount); }, repeat);
+	std::printf("Build %zu triangles          %8.2f ms  (%zu nodes)\n", triangleCount, buildTriangles * 1.0e3, triangles.GetNodeCount());
+	std::printf("Build %zu boxes              %8.2f ms  (%zu nodes)\n", boxCount, buildBoxes * 1.0e3, boxes.GetNodeCount());
+
+	// ----- 交差判定 ----- //
+
+	size_t hits = 0;
+	auto report = [&](const char* name, double seconds, size_t rayCount)
+	{
+		std::printf("%-32s %8.3f us/ray  (%zu / %zu hit)\n", name, seconds * 1.0e6 / rayCount, hits, rayCount);
+	};
+
+	report("Triangles BVH Intersect", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		hits = 0;
+		RayHit hit;
+		for (const Ray& ray : rays) if (triangles.Intersect(ray, &hit)) hits++;
+	}, repeat), rays.size());
+
+	report("Triangles BVH IntersectAny", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		hits = 0;
+		for (const Ray& ray : rays) if (triangles.IntersectAny(ray)) hits++;
+	}, repeat), rays.size());
+
+	report("Boxes BVH Intersect", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		hits = 0;
+		RayHit hit;
+		for (const Ray& ray : rays) if (boxes.Intersect(ray, &hit)) hits++;
+	}, repeat), rays.size());
+
+	// 総当たり（時間がかかるので一部のレイだけ）
+	size_t bruteRays = quick ? 16 : 256;
+	size_t mismatches = 0;
+	report("Triangles brute force", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		hits = 0;
+		mismatches = 0;
+		for (size_t r = 0; r < bruteRays; r++)
+		{
+			const Ray& ray = rays[r * rays.size() / bruteRays];
+			float nearest = FLT_MAX;
+			for (size_t t = 0; t < triangleCount; t++)
+			{
+				float d;
+				if (IntersectTriangle(ray, positions[indices[t * 3]], positions[indices[t * 3 + 1]], positions[indices[t * 3 + 2]], &d) && d < nearest) nearest = d;
+			}
+			bool isHit = nearest < FLT_MAX;
+			if (isHit) hits++;
+
+			RayHit hit;
+			bool bvhHit = triangles.Intersect(ray, &hit);
+			if (bvhHit != isHit || (isHit && std::fabs(hit.distance - nearest) > 1.0e-3f * nearest)) mismatches++;
+		}
+	}, 1), bruteRays);
+	std::printf("BVH vs brute force mismatches: %zu\n", mismatches);
+
+	return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+﻿//--------------------------------------------------------------------------------------
+// File: RenderQueueBenchmark.cpp
+//
+// RenderQueue（ソートキーで並べ替えるレンダーキュー）のベンチマーク
+//
+// 100,000 個の描画パケットを積み、基数ソート（RenderQueue::Sort）と比較ソート
+// （std::stable_sort）の時間、Execute の時間、並べ替える前と後のステートの変更の回数を
+// 比べます。基数ソートの順番が std::stable_sort と一致しない場合は失敗します。
+//
+//   RenderQueueBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "RenderQueue.h"
+
+using namespace Imase;
+
+namespace
+{
+	// ステートの変更を数えるだけのハンドラー
+	class CountingHandler : public IRenderPacketHandler
+	{
+	public:
+		void BindShader(uint32_t shader) override { m_checksum += shader; }
+		void BindMaterial(uint32_t material) override { m_checksum += material; }
+		void Draw(const RenderPacket& packet) override { m_checksum += packet.argument; }
+
+		uint64_t GetChecksum() const { return m_checksum; }
+
+	private:
+		uint64_t m_checksum = 0;
+	};
+
+	// レイヤー
+	enum : uint32_t
+	{
+		LAYER_OPAQUE,
+		LAYER_TRANSLUCENT,
+		LAYER_OVERLAY,
+		LAYER_COUNT,
+	};
+}
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const size_t count = quick ? 10000 : 100000;
+	const int loops = quick ? 1 : 20;
+	const int repeat = quick ? 1 : 5;
+
+	// 積むパケット（シェーダー 64 種類、マテリアル 1024 種類、距離はばらばら）
+	struct Input { uint32_t layer, shader, material; float depth; };
+	std::vector<Input> inputs(count);
+	std::mt19937 random(11);
+	std::uniform_int_distribution<uint32_t> layer(0, 9);
+	std::uniform_int_distribution<uint32_t> shader(0, 63);
+	std::uniform_int_distribution<uint32_t> material(0, 1023);
+	std::uniform_real_distribution<float> depth(0.1f, 500.0f);
+	for (Input& input : inputs)
+	{
+		uint32_t l = layer(random);
+		input = { l < 7 ? LAYER_OPAQUE : l < 9 ? LAYER_TRANSLUCENT : LAYER_OVERLAY, shader(random), material(random), depth(random) };
+	}
+
+	RenderQueue queue;
+	queue.SetLayerSortMode(LAYER_TRANSLUCENT, RenderSortMode::BackToFront);
+	queue.Reserve(count);
+
+	auto submitAll = [&]()
+	{
+		queue.Clear();
+		for (size_t i = 0; i < count; i++)
+		{
+			const Input& input = inputs[i];
+			queue.Submit(input.layer, input.shader, input.material, input.depth, 0, static_cast<uint32_t>(i));
+		}
+	};
+
+	auto report = [&](const char* name, double seconds)
+	{
+		std::printf("%-28s %8.3f ms  %6.2f ns/packet\n", name, seconds * 1.0e3 / loops, seconds * 1.0e9 / (static_cast<double>(count) * loops));
+	};
+
+	// ----- 積む・並べ替える・実行する ----- //
+
+	report("Submit", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++) { submitAll(); ImaseBenchmark::ClobberMemory(); }
+	}, repeat));
+
+	// Sort は積んだ直後の状態から毎回並べ替える（Submit の時間を除くため、先に積んだものを複製しておく）
+	std::vector<RenderQueue> queues(static_cast<size_t>(loops), queue);
+	report("Sort (radix)", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (RenderQueue& q : queues) { q.Sort(); ImaseBenchmark::ClobberMemory(); }
+	}, 1));
+
+	std::vector<uint64_t> keys(count);
+	std::vector<uint32_t> order(count);
+	report("std::stable_sort (keys)", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (size_t i = 0; i < count; i++) { keys[i] = queue.GetPacket(i).key; order[i] = static_cast<uint32_t>(i); }
+			std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat));
+
+	queue.Sort();
+	CountingHandler handler;
+	report("Execute", ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++) { queue.Execute(&handler); ImaseBenchmark::ClobberMemory(); }
+	}, repeat));
+	ImaseBenchmark::DoNotOptimize(handler.GetChecksum());
+
+	// ----- 結果の確認 ----- //
+
+	size_t mismatches = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (queue.GetSortedPacket(i).argument != order[i]) mismatches++;
+	}
+
+	// 積んだ順番のまま実行した場合のステートの変更の回数
+	size_t unsortedShaderChanges = 0, unsortedMaterialChanges = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (i == 0 || inputs[i].shader != inputs[i - 1].shader) unsortedShaderChanges++;
+		if (i == 0 || inputs[i].material != inputs[i - 1].material || inputs[i].shader != inputs[i - 1].shader) unsortedMaterialChanges++;
+	}
+
+	const RenderQueueStats& stats = queue.GetStats();
+	std::printf("state changes  unsorted: shader %zu material %zu  sorted: shader %zu material %zu  (%zu packets)\n",
+		unsortedShaderChanges, unsortedMaterialChanges, stats.shaderChanges, stats.materialChanges, stats.packetCount);
+	std::printf("radix vs std::stable_sort order mismatches: %zu\n", mismatches);
+
+	return mismatches == 0 ? 0 : 1;
+}
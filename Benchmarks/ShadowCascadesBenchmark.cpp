@@ -0,0 +1,120 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ShadowCascadesBenchmark.cpp
+//
+// ShadowCascades（カスケードシャドウの CPU 側の計算）のベンチマーク
+//
+// 回転するカメラでの ComputeShadowCascades・WriteShadowConstants の１回あたりの時間と、
+// 100,000 個のバウンディングスフィアの影を落とすオブジェクトのカリング（全カスケードを
+// １回の走査で判定）を、カスケードごとに CullSpheres で４回走査する場合と比べます。
+// カスケードごとの影を落とすオブジェクトの数も表示するので、両方の結果を比べられます。
+//
+//   ShadowCascadesBenchmark [--quick]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "BenchmarkCommon.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "ShadowCascades.h"
+
+using namespace Imase;
+using namespace Imase::Math;
+
+int main(int argc, char* argv[])
+{
+	bool quick = ImaseBenchmark::IsQuick(argc, argv);
+	const size_t count = quick ? 10000 : 100000;
+	const int frames = quick ? 100 : 10000;
+	const int loops = quick ? 1 : 20;
+	const int repeat = quick ? 1 : 5;
+
+	const float fovY = 0.785398163f, aspect = 16.0f / 9.0f, nearPlane = 0.1f, farPlane = 200.0f;
+	Vector3 lightDirection = Vector3(-0.5f, -1.0f, -0.3f).Normalized();
+	ShadowCascadeSettings settings;
+
+	// フレームごとのカメラ（注視点の周りを回る）
+	std::vector<Matrix> views(frames);
+	for (int i = 0; i < frames; i++)
+	{
+		float angle = static_cast<float>(i) * 0.01f;
+		views[i] = Matrix::CreateLookAt(Vector3(std::sin(angle) * 30.0f, 10.0f, std::cos(angle) * 30.0f), Vector3(), Vector3::Up());
+	}
+
+	ShadowCascades cascades = {};
+	ShadowConstants constants = {};
+
+	double compute = ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int i = 0; i < frames; i++)
+		{
+			cascades = ComputeShadowCascades(views[i], fovY, aspect, nearPlane, farPlane, lightDirection, settings);
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat);
+	std::printf("ComputeShadowCascades (%d)       %8.3f us/frame\n", settings.cascadeCount, compute * 1.0e6 / frames);
+
+	double write = ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int i = 0; i < frames; i++)
+		{
+			WriteShadowConstants(cascades, &constants);
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat);
+	std::printf("WriteShadowConstants             %8.3f us/frame\n", write * 1.0e6 / frames);
+
+	// 影を落とすオブジェクト
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+	std::uniform_real_distribution<float> size(0.2f, 3.0f);
+	std::vector<float> x(count), y(count), z(count), r(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		x[i] = position(random); y[i] = position(random) * 0.05f; z[i] = position(random); r[i] = size(random);
+	}
+	SphereArrays spheres = { x.data(), y.data(), z.data(), r.data() };
+
+	cascades = ComputeShadowCascades(views[0], fovY, aspect, nearPlane, farPlane, lightDirection, settings);
+
+	std::vector<uint8_t> masks(count);
+	std::vector<std::vector<uint32_t>> indices(MAX_SHADOW_CASCADES, std::vector<uint32_t>(count));
+	uint32_t* indexPointers[MAX_SHADOW_CASCADES] = { indices[0].data(), indices[1].data(), indices[2].data(), indices[3].data() };
+	size_t casterCounts[MAX_SHADOW_CASCADES] = {};
+	size_t total = 0;
+
+	double single = ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			total = CullShadowCasters(cascades, spheres, count, masks.data(), indexPointers, casterCounts);
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat);
+	std::printf("CullShadowCasters (1 pass)       %8.3f ms  %6.2f ns/object  casters %zu / %zu / %zu / %zu (any %zu)\n",
+		single * 1.0e3 / loops, single * 1.0e9 / (static_cast<double>(count) * loops),
+		casterCounts[0], casterCounts[1], casterCounts[2], casterCounts[3], total);
+
+	Frustum frustums[MAX_SHADOW_CASCADES];
+	for (int c = 0; c < cascades.count; c++) frustums[c] = Frustum::CreateFromViewProjection(cascades.cascades[c].viewProjection);
+
+	double separate = ImaseBenchmark::MeasureSeconds([&]()
+	{
+		for (int l = 0; l < loops; l++)
+		{
+			for (int c = 0; c < cascades.count; c++)
+			{
+				casterCounts[c] = CullSpheres(frustums[c], spheres, count, indexPointers[c], 1);
+			}
+			ImaseBenchmark::ClobberMemory();
+		}
+	}, repeat);
+	std::printf("CullSpheres x %d (per cascade)    %8.3f ms  %6.2f ns/object  casters %zu / %zu / %zu / %zu\n",
+		cascades.count, separate * 1.0e3 / loops, separate * 1.0e9 / (static_cast<double>(count) * loops),
+		casterCounts[0], casterCounts[1], casterCounts[2], casterCounts[3]);
+
+	return 0;
+}
@@ -71,6 +71,7 @@ DeviceResources::DeviceResources(
         m_backBufferFormat(backBufferFormat),
         m_depthBufferFormat(depthBufferFormat),
         m_backBufferCount(backBufferCount),
+        m_maxFrameLatency(3),
         m_d3dMinFeatureLevel(minFeatureLevel),
         m_window(nullptr),
         m_d3dFeatureLevel(D3D_FEATURE_LEVEL_9_1),
@@ -253,6 +254,12 @@ void DeviceResources::CreateDeviceResources()
     ThrowIfFailed(device.As(&m_d3dDevice));
     ThrowIfFailed(context.As(&m_d3dContext));
     ThrowIfFailed(context.As(&m_d3dAnnotation));
+
+    // Limit how many frames the CPU can queue ahead of the GPU, and keep the value actually in effect.
+    ComPtr<IDXGIDevice1> dxgiDevice;
+    ThrowIfFailed(m_d3dDevice.As(&dxgiDevice));
+    ThrowIfFailed(dxgiDevice->SetMaximumFrameLatency(m_maxFrameLatency));
+    ThrowIfFailed(dxgiDevice->GetMaximumFrameLatency(&m_maxFrameLatency));
 }
 
 // These resources need to be recreated every time the window size is changed.
@@ -43,6 +43,7 @@ namespace DX
         bool WindowSizeChanged(int width, int height);
         void HandleDeviceLost();
         void RegisterDeviceNotify(IDeviceNotify* deviceNotify) noexcept { m_deviceNotify = deviceNotify; }
+        void SetMaximumFrameLatency(UINT maxFrameLatency) noexcept { m_maxFrameLatency = maxFrameLatency; }
         void Present();
         void UpdateColorSpace();
 
@@ -64,6 +65,7 @@ namespace DX
         DXGI_FORMAT             GetDepthBufferFormat() const noexcept   { return m_depthBufferFormat; }
         D3D11_VIEWPORT          GetScreenViewport() const noexcept      { return m_screenViewport; }
         UINT                    GetBackBufferCount() const noexcept     { return m_backBufferCount; }
+        UINT                    GetMaximumFrameLatency() const noexcept { return m_maxFrameLatency; }
         DXGI_COLOR_SPACE_TYPE   GetColorSpace() const noexcept          { return m_colorSpace; }
         unsigned int            GetDeviceOptions() const noexcept       { return m_options; }
 
@@ -105,6 +107,7 @@ namespace DX
         DXGI_FORMAT                                     m_backBufferFormat;
         DXGI_FORMAT                                     m_depthBufferFormat;
         UINT                                            m_backBufferCount;
+        UINT                                            m_maxFrameLatency;
         D3D_FEATURE_LEVEL                               m_d3dMinFeatureLevel;
 
         // Cached device properties.
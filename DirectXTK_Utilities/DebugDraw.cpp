@@ -8,13 +8,60 @@
 #include "pch.h"
 #include "DebugDraw.h"
 
+#include "ImaseLib/FastTrig.h"
+#include "ImaseLib/TransientGeometryStream.h"
+
 #include <algorithm>
+#include <cstddef>
 
 using namespace DirectX;
 
 namespace
 {
-    inline void XM_CALLCONV DrawCube(PrimitiveBatch<VertexPositionColor>* batch,
+    static_assert(sizeof(VertexPositionColor) == sizeof(Imase::TransientVertex)
+        && offsetof(VertexPositionColor, color) == offsetof(Imase::TransientVertex, color),
+        "TransientVertex must match VertexPositionColor");
+
+    inline const Imase::TransientVertex* ToTransient(const VertexPositionColor* vertices) noexcept
+    {
+        return reinterpret_cast<const Imase::TransientVertex*>(vertices);
+    }
+
+    // Exposes the PrimitiveBatch calls used below on top of a transient stream,
+    // so the same shape code feeds either one.
+    class StreamBatch
+    {
+    public:
+        explicit StreamBatch(Imase::TransientGeometryStream* stream) noexcept : m_stream(stream) {}
+
+        void Draw(D3D_PRIMITIVE_TOPOLOGY topology, const VertexPositionColor* vertices, size_t vertexCount)
+        {
+            if (topology == D3D_PRIMITIVE_TOPOLOGY_LINESTRIP)
+            {
+                m_stream->AddLineStrip(ToTransient(vertices), static_cast<uint32_t>(vertexCount));
+            }
+            else
+            {
+                m_stream->AddLines(ToTransient(vertices), static_cast<uint32_t>(vertexCount));
+            }
+        }
+
+        void DrawIndexed(D3D_PRIMITIVE_TOPOLOGY, const uint16_t* indices, size_t indexCount, const VertexPositionColor* vertices, size_t vertexCount)
+        {
+            m_stream->AddIndexedLines(indices, static_cast<uint32_t>(indexCount), ToTransient(vertices), static_cast<uint32_t>(vertexCount));
+        }
+
+        void DrawLine(const VertexPositionColor& v1, const VertexPositionColor& v2)
+        {
+            m_stream->AddLine(*ToTransient(&v1), *ToTransient(&v2));
+        }
+
+    private:
+        Imase::TransientGeometryStream* m_stream;
+    };
+
+    template <class TBatch>
+    inline void XM_CALLCONV DrawCube(TBatch* batch,
         CXMMATRIX matWorld,
         FXMVECTOR color)
     {
@@ -56,90 +103,314 @@ namespace
 
         batch->DrawIndexed(D3D_PRIMITIVE_TOPOLOGY_LINELIST, s_indices, static_cast<UINT>(std::size(s_indices)), verts, 8);
     }
+
+    template <class TBatch>
+    void XM_CALLCONV DrawRingImpl(TBatch* batch,
+        FXMVECTOR origin,
+        FXMVECTOR majorAxis,
+        FXMVECTOR minorAxis,
+        GXMVECTOR color)
+    {
+        constexpr size_t c_ringSegments = 32;
+
+        VertexPositionColor verts[c_ringSegments + 1];
+
+        // The ring is always split into the same angles, so the sin/cos table
+        // is computed once (in bulk) instead of rotating incrementally per call,
+        // which also avoids accumulating rounding error around the ring.
+        struct RingTable
+        {
+            float sines[c_ringSegments];
+            float cosines[c_ringSegments];
+
+            RingTable() noexcept
+            {
+                float angles[c_ringSegments];
+                for (size_t i = 0; i < c_ringSegments; i++)
+                {
+                    angles[i] = XM_2PI * float(i) / float(c_ringSegments);
+                }
+                Imase::Math::SinCos(angles, sines, cosines, c_ringSegments);
+            }
+        };
+        static const RingTable s_table;
+
+        for (size_t i = 0; i < c_ringSegments; i++)
+        {
+            XMVECTOR pos = XMVectorMultiplyAdd(majorAxis, XMVectorReplicate(s_table.cosines[i]), origin);
+            pos = XMVectorMultiplyAdd(minorAxis, XMVectorReplicate(s_table.sines[i]), pos);
+            XMStoreFloat3(&verts[i].position, pos);
+            XMStoreFloat4(&verts[i].color, color);
+        }
+        verts[c_ringSegments] = verts[0];
+
+        batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINESTRIP, verts, c_ringSegments + 1);
+    }
+
+    template <class TBatch>
+    void XM_CALLCONV DrawSphereImpl(TBatch* batch,
+        const BoundingSphere& sphere,
+        FXMVECTOR color)
+    {
+        const XMVECTOR origin = XMLoadFloat3(&sphere.Center);
+
+        const float radius = sphere.Radius;
+
+        const XMVECTOR xaxis = XMVectorScale(g_XMIdentityR0, radius);
+        const XMVECTOR yaxis = XMVectorScale(g_XMIdentityR1, radius);
+        const XMVECTOR zaxis = XMVectorScale(g_XMIdentityR2, radius);
+
+        DrawRingImpl(batch, origin, xaxis, zaxis, color);
+        DrawRingImpl(batch, origin, xaxis, yaxis, color);
+        DrawRingImpl(batch, origin, yaxis, zaxis, color);
+    }
+
+    template <class TBatch>
+    void XM_CALLCONV DrawBoxImpl(TBatch* batch,
+        const BoundingBox& box,
+        FXMVECTOR color)
+    {
+        XMMATRIX matWorld = XMMatrixScaling(box.Extents.x, box.Extents.y, box.Extents.z);
+        const XMVECTOR position = XMLoadFloat3(&box.Center);
+        matWorld.r[3] = XMVectorSelect(matWorld.r[3], position, g_XMSelect1110);
+
+        DrawCube(batch, matWorld, color);
+    }
+
+    template <class TBatch>
+    void XM_CALLCONV DrawOrientedBoxImpl(TBatch* batch,
+        const BoundingOrientedBox& obb,
+        FXMVECTOR color)
+    {
+        XMMATRIX matWorld = XMMatrixRotationQuaternion(XMLoadFloat4(&obb.Orientation));
+        const XMMATRIX matScale = XMMatrixScaling(obb.Extents.x, obb.Extents.y, obb.Extents.z);
+        matWorld = XMMatrixMultiply(matScale, matWorld);
+        const XMVECTOR position = XMLoadFloat3(&obb.Center);
+        matWorld.r[3] = XMVectorSelect(matWorld.r[3], position, g_XMSelect1110);
+
+        DrawCube(batch, matWorld, color);
+    }
+
+    template <class TBatch>
+    void XM_CALLCONV DrawFrustumImpl(TBatch* batch,
+        const BoundingFrustum& frustum,
+        FXMVECTOR color)
+    {
+        XMFLOAT3 corners[BoundingFrustum::CORNER_COUNT];
+        frustum.GetCorners(corners);
+
+        VertexPositionColor verts[24] = {};
+        verts[0].position = corners[0];
+        verts[1].position = corners[1];
+        verts[2].position = corners[1];
+        verts[3].position = corners[2];
+        verts[4].position = corners[2];
+        verts[5].position = corners[3];
+        verts[6].position = corners[3];
+        verts[7].position = corners[0];
+
+        verts[8].position = corners[0];
+        verts[9].position = corners[4];
+        verts[10].position = corners[1];
+        verts[11].position = corners[5];
+        verts[12].position = corners[2];
+        verts[13].position = corners[6];
+        verts[14].position = corners[3];
+        verts[15].position = corners[7];
+
+        verts[16].position = corners[4];
+        verts[17].position = corners[5];
+        verts[18].position = corners[5];
+        verts[19].position = corners[6];
+        verts[20].position = corners[6];
+        verts[21].position = corners[7];
+        verts[22].position = corners[7];
+        verts[23].position = corners[4];
+
+        for (size_t j = 0; j < std::size(verts); ++j)
+        {
+            XMStoreFloat4(&verts[j].color, color);
+        }
+
+        batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINELIST, verts, static_cast<UINT>(std::size(verts)));
+    }
+
+    template <class TBatch>
+    void XM_CALLCONV DrawGridImpl(TBatch* batch,
+        FXMVECTOR xAxis,
+        FXMVECTOR yAxis,
+        FXMVECTOR origin,
+        size_t xdivs,
+        size_t ydivs,
+        GXMVECTOR color)
+    {
+        xdivs = std::max<size_t>(1, xdivs);
+        ydivs = std::max<size_t>(1, ydivs);
+
+        for (size_t i = 0; i <= xdivs; ++i)
+        {
+            float percent = float(i) / float(xdivs);
+            percent = (percent * 2.f) - 1.f;
+            XMVECTOR scale = XMVectorScale(xAxis, percent);
+            scale = XMVectorAdd(scale, origin);
+
+            const VertexPositionColor v1(XMVectorSubtract(scale, yAxis), color);
+            const VertexPositionColor v2(XMVectorAdd(scale, yAxis), color);
+            batch->DrawLine(v1, v2);
+        }
+
+        for (size_t i = 0; i <= ydivs; i++)
+        {
+            FLOAT percent = float(i) / float(ydivs);
+            percent = (percent * 2.f) - 1.f;
+            XMVECTOR scale = XMVectorScale(yAxis, percent);
+            scale = XMVectorAdd(scale, origin);
+
+            const VertexPositionColor v1(XMVectorSubtract(scale, xAxis), color);
+            const VertexPositionColor v2(XMVectorAdd(scale, xAxis), color);
+            batch->DrawLine(v1, v2);
+        }
+    }
+
+    template <class TBatch>
+    void XM_CALLCONV DrawRayImpl(TBatch* batch,
+        FXMVECTOR origin,
+        FXMVECTOR direction,
+        bool normalize,
+        FXMVECTOR color)
+    {
+        VertexPositionColor verts[3];
+        XMStoreFloat3(&verts[0].position, origin);
+
+        XMVECTOR normDirection = XMVector3Normalize(direction);
+        XMVECTOR rayDirection = (normalize) ? normDirection : direction;
+
+        XMVECTOR perpVector = XMVector3Cross(normDirection, g_XMIdentityR1);
+
+        if (XMVector3Equal(XMVector3LengthSq(perpVector), g_XMZero))
+        {
+            perpVector = XMVector3Cross(normDirection, g_XMIdentityR2);
+        }
+        perpVector = XMVector3Normalize(perpVector);
+
+        XMStoreFloat3(&verts[1].position, XMVectorAdd(rayDirection, origin));
+        perpVector = XMVectorScale(perpVector, 0.0625f);
+        normDirection = XMVectorScale(normDirection, -0.25f);
+        rayDirection = XMVectorAdd(perpVector, rayDirection);
+        rayDirection = XMVectorAdd(normDirection, rayDirection);
+        XMStoreFloat3(&verts[2].position, XMVectorAdd(rayDirection, origin));
+
+        XMStoreFloat4(&verts[0].color, color);
+        XMStoreFloat4(&verts[1].color, color);
+        XMStoreFloat4(&verts[2].color, color);
+
+        batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINESTRIP, verts, 2);
+    }
+
+    template <class TBatch>
+    void XM_CALLCONV DrawTriangleImpl(TBatch* batch,
+        FXMVECTOR pointA,
+        FXMVECTOR pointB,
+        FXMVECTOR pointC,
+        GXMVECTOR color)
+    {
+        VertexPositionColor verts[4];
+        XMStoreFloat3(&verts[0].position, pointA);
+        XMStoreFloat3(&verts[1].position, pointB);
+        XMStoreFloat3(&verts[2].position, pointC);
+        XMStoreFloat3(&verts[3].position, pointA);
+
+        XMStoreFloat4(&verts[0].color, color);
+        XMStoreFloat4(&verts[1].color, color);
+        XMStoreFloat4(&verts[2].color, color);
+        XMStoreFloat4(&verts[3].color, color);
+
+        batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINESTRIP, verts, 4);
+    }
+
+    template <class TBatch>
+    void XM_CALLCONV DrawQuadImpl(TBatch* batch,
+        FXMVECTOR pointA,
+        FXMVECTOR pointB,
+        FXMVECTOR pointC,
+        GXMVECTOR pointD,
+        HXMVECTOR color)
+    {
+        VertexPositionColor verts[5];
+        XMStoreFloat3(&verts[0].position, pointA);
+        XMStoreFloat3(&verts[1].position, pointB);
+        XMStoreFloat3(&verts[2].position, pointC);
+        XMStoreFloat3(&verts[3].position, pointD);
+        XMStoreFloat3(&verts[4].position, pointA);
+
+        XMStoreFloat4(&verts[0].color, color);
+        XMStoreFloat4(&verts[1].color, color);
+        XMStoreFloat4(&verts[2].color, color);
+        XMStoreFloat4(&verts[3].color, color);
+        XMStoreFloat4(&verts[4].color, color);
+
+        batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINESTRIP, verts, 5);
+    }
 }
 
 void XM_CALLCONV DX::Draw(PrimitiveBatch<VertexPositionColor>* batch,
     const BoundingSphere& sphere,
     FXMVECTOR color)
 {
-    const XMVECTOR origin = XMLoadFloat3(&sphere.Center);
-
-    const float radius = sphere.Radius;
-
-    const XMVECTOR xaxis = XMVectorScale(g_XMIdentityR0, radius);
-    const XMVECTOR yaxis = XMVectorScale(g_XMIdentityR1, radius);
-    const XMVECTOR zaxis = XMVectorScale(g_XMIdentityR2, radius);
+    DrawSphereImpl(batch, sphere, color);
+}
 
-    DrawRing(batch, origin, xaxis, zaxis, color);
-    DrawRing(batch, origin, xaxis, yaxis, color);
-    DrawRing(batch, origin, yaxis, zaxis, color);
+void XM_CALLCONV DX::Draw(Imase::TransientGeometryStream* stream,
+    const BoundingSphere& sphere,
+    FXMVECTOR color)
+{
+    StreamBatch batch(stream);
+    DrawSphereImpl(&batch, sphere, color);
 }
 
 void XM_CALLCONV DX::Draw(PrimitiveBatch<VertexPositionColor>* batch,
     const BoundingBox& box,
     FXMVECTOR color)
 {
-    XMMATRIX matWorld = XMMatrixScaling(box.Extents.x, box.Extents.y, box.Extents.z);
-    const XMVECTOR position = XMLoadFloat3(&box.Center);
-    matWorld.r[3] = XMVectorSelect(matWorld.r[3], position, g_XMSelect1110);
+    DrawBoxImpl(batch, box, color);
+}
 
-    DrawCube(batch, matWorld, color);
+void XM_CALLCONV DX::Draw(Imase::TransientGeometryStream* stream,
+    const BoundingBox& box,
+    FXMVECTOR color)
+{
+    StreamBatch batch(stream);
+    DrawBoxImpl(&batch, box, color);
 }
 
 void XM_CALLCONV DX::Draw(PrimitiveBatch<VertexPositionColor>* batch,
     const BoundingOrientedBox& obb,
     FXMVECTOR color)
 {
-    XMMATRIX matWorld = XMMatrixRotationQuaternion(XMLoadFloat4(&obb.Orientation));
-    const XMMATRIX matScale = XMMatrixScaling(obb.Extents.x, obb.Extents.y, obb.Extents.z);
-    matWorld = XMMatrixMultiply(matScale, matWorld);
-    const XMVECTOR position = XMLoadFloat3(&obb.Center);
-    matWorld.r[3] = XMVectorSelect(matWorld.r[3], position, g_XMSelect1110);
+    DrawOrientedBoxImpl(batch, obb, color);
+}
 
-    DrawCube(batch, matWorld, color);
+void XM_CALLCONV DX::Draw(Imase::TransientGeometryStream* stream,
+    const BoundingOrientedBox& obb,
+    FXMVECTOR color)
+{
+    StreamBatch batch(stream);
+    DrawOrientedBoxImpl(&batch, obb, color);
 }
 
 void XM_CALLCONV DX::Draw(PrimitiveBatch<VertexPositionColor>* batch,
     const BoundingFrustum& frustum,
     FXMVECTOR color)
 {
-    XMFLOAT3 corners[BoundingFrustum::CORNER_COUNT];
-    frustum.GetCorners(corners);
-
-    VertexPositionColor verts[24] = {};
-    verts[0].position = corners[0];
-    verts[1].position = corners[1];
-    verts[2].position = corners[1];
-    verts[3].position = corners[2];
-    verts[4].position = corners[2];
-    verts[5].position = corners[3];
-    verts[6].position = corners[3];
-    verts[7].position = corners[0];
-
-    verts[8].position = corners[0];
-    verts[9].position = corners[4];
-    verts[10].position = corners[1];
-    verts[11].position = corners[5];
-    verts[12].position = corners[2];
-    verts[13].position = corners[6];
-    verts[14].position = corners[3];
-    verts[15].position = corners[7];
-
-    verts[16].position = corners[4];
-    verts[17].position = corners[5];
-    verts[18].position = corners[5];
-    verts[19].position = corners[6];
-    verts[20].position = corners[6];
-    verts[21].position = corners[7];
-    verts[22].position = corners[7];
-    verts[23].position = corners[4];
-
-    for (size_t j = 0; j < std::size(verts); ++j)
-    {
-        XMStoreFloat4(&verts[j].color, color);
-    }
+    DrawFrustumImpl(batch, frustum, color);
+}
 
-    batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINELIST, verts, static_cast<UINT>(std::size(verts)));
+void XM_CALLCONV DX::Draw(Imase::TransientGeometryStream* stream,
+    const BoundingFrustum& frustum,
+    FXMVECTOR color)
+{
+    StreamBatch batch(stream);
+    DrawFrustumImpl(&batch, frustum, color);
 }
 
 void XM_CALLCONV DX::DrawGrid(PrimitiveBatch<VertexPositionColor>* batch,
@@ -150,32 +421,19 @@ void XM_CALLCONV DX::DrawGrid(PrimitiveBatch<VertexPositionColor>* batch,
     size_t ydivs,
     GXMVECTOR color)
 {
-    xdivs = std::max<size_t>(1, xdivs);
-    ydivs = std::max<size_t>(1, ydivs);
-
-    for (size_t i = 0; i <= xdivs; ++i)
-    {
-        float percent = float(i) / float(xdivs);
-        percent = (percent * 2.f) - 1.f;
-        XMVECTOR scale = XMVectorScale(xAxis, percent);
-        scale = XMVectorAdd(scale, origin);
-
-        const VertexPositionColor v1(XMVectorSubtract(scale, yAxis), color);
-        const VertexPositionColor v2(XMVectorAdd(scale, yAxis), color);
-        batch->DrawLine(v1, v2);
-    }
+    DrawGridImpl(batch, xAxis, yAxis, origin, xdivs, ydivs, color);
+}
 
-    for (size_t i = 0; i <= ydivs; i++)
-    {
-        FLOAT percent = float(i) / float(ydivs);
-        percent = (percent * 2.f) - 1.f;
-        XMVECTOR scale = XMVectorScale(yAxis, percent);
-        scale = XMVectorAdd(scale, origin);
-
-        const VertexPositionColor v1(XMVectorSubtract(scale, xAxis), color);
-        const VertexPositionColor v2(XMVectorAdd(scale, xAxis), color);
-        batch->DrawLine(v1, v2);
-    }
+void XM_CALLCONV DX::DrawGrid(Imase::TransientGeometryStream* stream,
+    FXMVECTOR xAxis,
+    FXMVECTOR yAxis,
+    FXMVECTOR origin,
+    size_t xdivs,
+    size_t ydivs,
+    GXMVECTOR color)
+{
+    StreamBatch batch(stream);
+    DrawGridImpl(&batch, xAxis, yAxis, origin, xdivs, ydivs, color);
 }
 
 void XM_CALLCONV DX::DrawRing(PrimitiveBatch<VertexPositionColor>* batch,
@@ -184,37 +442,17 @@ void XM_CALLCONV DX::DrawRing(PrimitiveBatch<VertexPositionColor>* batch,
     FXMVECTOR minorAxis,
     GXMVECTOR color)
 {
-    constexpr size_t c_ringSegments = 32;
-
-    VertexPositionColor verts[c_ringSegments + 1];
-
-    constexpr float fAngleDelta = XM_2PI / float(c_ringSegments);
-    // Instead of calling cos/sin for each segment we calculate
-    // the sign of the angle delta and then incrementally calculate sin
-    // and cosine from then on.
-    const XMVECTOR cosDelta = XMVectorReplicate(cosf(fAngleDelta));
-    const XMVECTOR sinDelta = XMVectorReplicate(sinf(fAngleDelta));
-    XMVECTOR incrementalSin = XMVectorZero();
-    static const XMVECTORF32 s_initialCos =
-    {
-        { { 1.f, 1.f, 1.f, 1.f } }
-    };
-    XMVECTOR incrementalCos = s_initialCos.v;
-    for (size_t i = 0; i < c_ringSegments; i++)
-    {
-        XMVECTOR pos = XMVectorMultiplyAdd(majorAxis, incrementalCos, origin);
-        pos = XMVectorMultiplyAdd(minorAxis, incrementalSin, pos);
-        XMStoreFloat3(&verts[i].position, pos);
-        XMStoreFloat4(&verts[i].color, color);
-        // Standard formula to rotate a vector.
-        const XMVECTOR newCos = XMVectorSubtract(XMVectorMultiply(incrementalCos, cosDelta), XMVectorMultiply(incrementalSin, sinDelta));
-        const XMVECTOR newSin = XMVectorAdd(XMVectorMultiply(incrementalCos, sinDelta), XMVectorMultiply(incrementalSin, cosDelta));
-        incrementalCos = newCos;
-        incrementalSin = newSin;
-    }
-    verts[c_ringSegments] = verts[0];
+    DrawRingImpl(batch, origin, majorAxis, minorAxis, color);
+}
 
-    batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINESTRIP, verts, c_ringSegments + 1);
+void XM_CALLCONV DX::DrawRing(Imase::TransientGeometryStream* stream,
+    FXMVECTOR origin,
+    FXMVECTOR majorAxis,
+    FXMVECTOR minorAxis,
+    GXMVECTOR color)
+{
+    StreamBatch batch(stream);
+    DrawRingImpl(&batch, origin, majorAxis, minorAxis, color);
 }
 
 void XM_CALLCONV DX::DrawRay(PrimitiveBatch<VertexPositionColor>* batch,
@@ -223,32 +461,17 @@ void XM_CALLCONV DX::DrawRay(PrimitiveBatch<VertexPositionColor>* batch,
     bool normalize,
     FXMVECTOR color)
 {
-    VertexPositionColor verts[3];
-    XMStoreFloat3(&verts[0].position, origin);
-
-    XMVECTOR normDirection = XMVector3Normalize(direction);
-    XMVECTOR rayDirection = (normalize) ? normDirection : direction;
-
-    XMVECTOR perpVector = XMVector3Cross(normDirection, g_XMIdentityR1);
-
-    if (XMVector3Equal(XMVector3LengthSq(perpVector), g_XMZero))
-    {
-        perpVector = XMVector3Cross(normDirection, g_XMIdentityR2);
-    }
-    perpVector = XMVector3Normalize(perpVector);
-
-    XMStoreFloat3(&verts[1].position, XMVectorAdd(rayDirection, origin));
-    perpVector = XMVectorScale(perpVector, 0.0625f);
-    normDirection = XMVectorScale(normDirection, -0.25f);
-    rayDirection = XMVectorAdd(perpVector, rayDirection);
-    rayDirection = XMVectorAdd(normDirection, rayDirection);
-    XMStoreFloat3(&verts[2].position, XMVectorAdd(rayDirection, origin));
-
-    XMStoreFloat4(&verts[0].color, color);
-    XMStoreFloat4(&verts[1].color, color);
-    XMStoreFloat4(&verts[2].color, color);
+    DrawRayImpl(batch, origin, direction, normalize, color);
+}
 
-    batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINESTRIP, verts, 2);
+void XM_CALLCONV DX::DrawRay(Imase::TransientGeometryStream* stream,
+    FXMVECTOR origin,
+    FXMVECTOR direction,
+    bool normalize,
+    FXMVECTOR color)
+{
+    StreamBatch batch(stream);
+    DrawRayImpl(&batch, origin, direction, normalize, color);
 }
 
 void XM_CALLCONV DX::DrawTriangle(PrimitiveBatch<VertexPositionColor>* batch,
@@ -257,18 +480,17 @@ void XM_CALLCONV DX::DrawTriangle(PrimitiveBatch<VertexPositionColor>* batch,
     FXMVECTOR pointC,
     GXMVECTOR color)
 {
-    VertexPositionColor verts[4];
-    XMStoreFloat3(&verts[0].position, pointA);
-    XMStoreFloat3(&verts[1].position, pointB);
-    XMStoreFloat3(&verts[2].position, pointC);
-    XMStoreFloat3(&verts[3].position, pointA);
-
-    XMStoreFloat4(&verts[0].color, color);
-    XMStoreFloat4(&verts[1].color, color);
-    XMStoreFloat4(&verts[2].color, color);
-    XMStoreFloat4(&verts[3].color, color);
-
-    batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINESTRIP, verts, 4);
+    DrawTriangleImpl(batch, pointA, pointB, pointC, color);
+}
+
+void XM_CALLCONV DX::DrawTriangle(Imase::TransientGeometryStream* stream,
+    FXMVECTOR pointA,
+    FXMVECTOR pointB,
+    FXMVECTOR pointC,
+    GXMVECTOR color)
+{
+    StreamBatch batch(stream);
+    DrawTriangleImpl(&batch, pointA, pointB, pointC, color);
 }
 
 void XM_CALLCONV DX::DrawQuad(PrimitiveBatch<VertexPositionColor>* batch,
@@ -278,18 +500,16 @@ void XM_CALLCONV DX::DrawQuad(PrimitiveBatch<VertexPositionColor>* batch,
     GXMVECTOR pointD,
     HXMVECTOR color)
 {
-    VertexPositionColor verts[5];
-    XMStoreFloat3(&verts[0].position, pointA);
-    XMStoreFloat3(&verts[1].position, pointB);
-    XMStoreFloat3(&verts[2].position, pointC);
-    XMStoreFloat3(&verts[3].position, pointD);
-    XMStoreFloat3(&verts[4].position, pointA);
-
-    XMStoreFloat4(&verts[0].color, color);
-    XMStoreFloat4(&verts[1].color, color);
-    XMStoreFloat4(&verts[2].color, color);
-    XMStoreFloat4(&verts[3].color, color);
-    XMStoreFloat4(&verts[4].color, color);
-
-    batch->Draw(D3D_PRIMITIVE_TOPOLOGY_LINESTRIP, verts, 5);
+    DrawQuadImpl(batch, pointA, pointB, pointC, pointD, color);
+}
+
+void XM_CALLCONV DX::DrawQuad(Imase::TransientGeometryStream* stream,
+    FXMVECTOR pointA,
+    FXMVECTOR pointB,
+    FXMVECTOR pointC,
+    GXMVECTOR pointD,
+    HXMVECTOR color)
+{
+    StreamBatch batch(stream);
+    DrawQuadImpl(&batch, pointA, pointB, pointC, pointD, color);
 }
@@ -16,6 +16,11 @@
 #include "VertexTypes.h"
 
 
+namespace Imase
+{
+    class TransientGeometryStream;
+}
+
 namespace DX
 {
     void XM_CALLCONV Draw(DirectX::PrimitiveBatch<DirectX::VertexPositionColor>* batch,
@@ -54,4 +59,45 @@ namespace DX
     void XM_CALLCONV DrawQuad(DirectX::PrimitiveBatch<DirectX::VertexPositionColor>* batch,
         DirectX::FXMVECTOR pointA, DirectX::FXMVECTOR pointB, DirectX::FXMVECTOR pointC, DirectX::GXMVECTOR pointD,
         DirectX::HXMVECTOR color = DirectX::Colors::White);
+
+    // Overloads that append to a shared transient stream instead of a PrimitiveBatch.
+    // Strips are converted to line lists, so everything added before the stream is
+    // flushed goes out in a single draw.
+
+    void XM_CALLCONV Draw(Imase::TransientGeometryStream* stream,
+        const DirectX::BoundingSphere& sphere,
+        DirectX::FXMVECTOR color = DirectX::Colors::White);
+
+    void XM_CALLCONV Draw(Imase::TransientGeometryStream* stream,
+        const DirectX::BoundingBox& box,
+        DirectX::FXMVECTOR color = DirectX::Colors::White);
+
+    void XM_CALLCONV Draw(Imase::TransientGeometryStream* stream,
+        const DirectX::BoundingOrientedBox& obb,
+        DirectX::FXMVECTOR color = DirectX::Colors::White);
+
+    void XM_CALLCONV Draw(Imase::TransientGeometryStream* stream,
+        const DirectX::BoundingFrustum& frustum,
+        DirectX::FXMVECTOR color = DirectX::Colors::White);
+
+    void XM_CALLCONV DrawGrid(Imase::TransientGeometryStream* stream,
+        DirectX::FXMVECTOR xAxis, DirectX::FXMVECTOR yAxis,
+        DirectX::FXMVECTOR origin, size_t xdivs, size_t ydivs,
+        DirectX::GXMVECTOR color = DirectX::Colors::White);
+
+    void XM_CALLCONV DrawRing(Imase::TransientGeometryStream* stream,
+        DirectX::FXMVECTOR origin, DirectX::FXMVECTOR majorAxis, DirectX::FXMVECTOR minorAxis,
+        DirectX::GXMVECTOR color = DirectX::Colors::White);
+
+    void XM_CALLCONV DrawRay(Imase::TransientGeometryStream* stream,
+        DirectX::FXMVECTOR origin, DirectX::FXMVECTOR direction, bool normalize = true,
+        DirectX::FXMVECTOR color = DirectX::Colors::White);
+
+    void XM_CALLCONV DrawTriangle(Imase::TransientGeometryStream* stream,
+        DirectX::FXMVECTOR pointA, DirectX::FXMVECTOR pointB, DirectX::FXMVECTOR pointC,
+        DirectX::GXMVECTOR color = DirectX::Colors::White);
+
+    void XM_CALLCONV DrawQuad(Imase::TransientGeometryStream* stream,
+        DirectX::FXMVECTOR pointA, DirectX::FXMVECTOR pointB, DirectX::FXMVECTOR pointC, DirectX::GXMVECTOR pointD,
+        DirectX::HXMVECTOR color = DirectX::Colors::White);
 }
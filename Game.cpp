@@ -6,6 +6,12 @@
 #include "Game.h"
 
 #include "ImaseLib/Matrix.h"
+#include "ImaseLib/DepthPrecision.h"
+#include "ImaseLib/FrustumCulling.h"
+#include "ImaseLib/RenderQueue.h"
+#include "ImaseLib/StateFilteredContext.h"
+#include "ImaseLib/SceneBenchmark.h"
+#include "ImaseLib/JobSystem.h"
 
 extern void ExitGame() noexcept;
 
@@ -20,11 +26,20 @@ Game::Game() noexcept(false)
     //   Add DX::DeviceResources::c_AllowTearing to opt-in to variable rate displays.
     //   Add DX::DeviceResources::c_EnableHDR for HDR10 display.
     m_deviceResources->RegisterDeviceNotify(this);
+
+    // CPU  GPU ɐi߂t[A萔̃Oobt@͈͂ėpOɍ킹
+    m_deviceResources->SetMaximumFrameLatency(static_cast<UINT>(Imase::ConstantRing::FRAME_LATENCY));
+
+    // ̃|S͉珇ɕ`悷
+    m_renderQueue.SetLayerSortMode(LAYER_TRANSLUCENT, Imase::RenderSortMode::BackToFront);
 }
 
 // Initialize the Direct3D resources required to run.
 void Game::Initialize(HWND window, int width, int height)
 {
+    // WuVXẽ[J[NĩXbh[J[OɂȂj
+    Imase::JobSystem::GetDefault();
+
     m_deviceResources->SetWindow(window, width, height);
 
     m_deviceResources->CreateDeviceResources();
@@ -33,12 +48,12 @@ void Game::Initialize(HWND window, int width, int height)
     m_deviceResources->CreateWindowSizeDependentResources();
     CreateWindowSizeDependentResources();
 
-    // TODO: Change the timer settings if you want something other than the default variable timestep mode.
-    // e.g. for 60 FPS fixed timestep update logic, call:
-    /*
+    // Œ̊ԊuōXVi`͑Oƍ̍XV̏ԂԂ̂ŁA`̊ԊuقȂĂ炩ɓj
     m_timer.SetFixedTimeStep(true);
-    m_timer.SetTargetElapsedSeconds(1.0 / 60);
-    */
+    m_timer.SetTargetElapsedTicks(DX::StepTimer::TicksPerSecond / UPDATES_PER_SECOND);
+
+    // ǂȂꍇ͒ǂȂ̍XV̂ĂiXV̉񐔂Ď~܂̂hj
+    m_timer.SetMaxUpdatesPerTick(MAX_UPDATES_PER_FRAME);
 
 #ifdef _DEBUG
     // Font̕ύX
@@ -48,33 +63,228 @@ void Game::Initialize(HWND window, int width, int height)
 
     // fobOJ̍쐬
     m_debugCamera = std::make_unique<Imase::DebugCamera>(width, height);
+    m_debugCamera->SetProjectionMatrix(m_proj);
+
+    // }EX̃tHC[lZbgiXṼXbh͎~߂Ăj
+    Mouse::Get().ResetScrollWheelValue();
 }
 
 #pragma region Frame Update
 // Executes the basic game loop.
 void Game::Tick()
 {
+    // t[̃A[ii߂iȎÕt[ŊmۂꎞIȃėpj
+    Imase::FrameArena::GetDefault().BeginFrame();
+
+    // ͂͂̃XbhłPt[ɂP񂾂擾AXVɂ͂̃Rs[n
+    // iKeyboardEMouse ̓EChẼbZ[Wŏ̂ŁAXṼXbh͓ǂ܂Ȃj
+    FrameInput input = SampleInput();
+
+    // F8Ft[̃pCvC̐؂ւi~ĂXṼXbhςj
+    m_pipelineKeyboardTracker.Update(input.keyboard);
+    if (m_pipelineKeyboardTracker.pressed.F8)
+    {
+        m_framePipeline.Stop();
+        m_pipelineDepth = m_pipelineDepth ? 0 : FRAME_PIPELINE_DEPTH;
+    }
+
+    uint32_t renderSlot = 0;
+    if (m_pipelineDepth)
+    {
+        // ̃t[̍XV̓[J[̃XbhōsÃXbh͏oオt[`悷
+        if (!m_framePipeline.IsRunning())
+        {
+            // n߂ɐ[̐čXV̂ŁASĂ̔ԍɍ̓͂nĂ
+            for (uint32_t i = 0; i < m_pipelineDepth; i++)
+            {
+                m_frameInputs[i] = input;
+            }
+            m_framePipeline.Start(m_pipelineDepth, [](void* data, uint32_t slot, uint64_t)
+                {
+                    static_cast<Game*>(data)->UpdateFrame(slot);
+                }, this);
+        }
+        renderSlot = m_framePipeline.Acquire();
+    }
+    else
+    {
+        m_frameInputs[0] = input;
+        UpdateFrame(0);
+    }
+    const FrameSnapshot* snapshot = &m_snapshots[renderSlot];
+
+#ifdef _DEBUG
+    // ImGui ͕`悷t[ƂɂP񂾂XViŒ̊Ԋu̍XV͂Pt[ɂO╡ɂȂj
+    if (snapshot->updateCount > 0)
+    {
+        UpdateDebugUI(*snapshot);
+    }
+#endif // _DEBUG
+
+    Render(*snapshot);
+
+    // `悪It[̏Ԃ͎̍XVŎg
+    // iɂ̔ԍXV鎞̓͂Ƃč̓͂nBԂ܂Ń[J[͂̔ԍgȂj
+    if (m_pipelineDepth)
+    {
+        m_frameInputs[renderSlot] = input;
+        m_framePipeline.Release();
+    }
+}
+
+// Samples the keyboard and mouse (on the main thread, once per frame).
+Game::FrameInput Game::SampleInput() const
+{
+    FrameInput input = {};
+    input.keyboard = Keyboard::Get().GetState();
+    input.mouse = Imase::DebugCamera::SampleMouse();
+    input.isCameraActive = m_isCameraActive;
+    return input;
+}
+
+// Runs the updates for one frame and captures the state to render (on the pipeline worker when pipelined).
+void Game::UpdateFrame(uint32_t slot)
+{
+    const FrameInput& input = m_frameInputs[slot];
+
     m_timer.Tick([&]()
     {
-        Update(m_timer);
+        Update(m_timer, input);
     });
 
-    Render();
+    UpdateCameraPath(m_timer);
+
+    CaptureSnapshot(&m_snapshots[slot]);
+}
+
+// Runs a synthetic TreeScene benchmark without a window or GPU and reports the CPU timings.
+int Game::RunSceneBenchmark(uint32_t frameCount)
+{
+    //  TickEUpdateERender ͎sȂBTreeScene  NullRenderContext ֕`悷̂ŁA
+    //    GridFloorEDebugDrawEDebugFontEImGuiENA Present ̏Ԃ͊܂܂Ȃ
+    // L^J̌oH΍ĐAȂΒ_̎
+    Imase::SceneBenchmarkSettings settings;
+    settings.frameCount = frameCount;
+    settings.fovY = XMConvertToRadians(45.0f);
+    settings.nearPlane = NEAR_PLANE;
+    settings.farPlane = FAR_PLANE;
+
+    int w, h;
+    GetDefaultSize(w, h);
+    settings.width = static_cast<uint32_t>(w);
+    settings.height = static_cast<uint32_t>(h);
+
+    if (m_cameraPath.Load(CAMERA_PATH_FILE)) settings.cameraPath = &m_cameraPath;
+
+    // ̏̎ɎՕ̕ǂuăIN[WJOv
+    settings.occluderWalls = SCENE_BENCHMARK_OCCLUDER_WALLS;
+
+    // NullRenderContext ֕`悷iR}ȟ؂ƌvsj
+    auto loop = std::make_unique<Imase::SceneBenchmark>();
+    const Imase::SceneBenchmarkReport& report = loop->Run(settings);
+    loop->WriteReport(SCENE_BENCHMARK_REPORT_FILE);
+
+    // ʂ̗vfobOo͂֕\
+    char text[256];
+    sprintf_s(text, "SceneBenchmark: %u frames  frame %.3f ms (min %.3f / max %.3f)  draws %llu  errors %u %.80s\n",
+        report.frameCount,
+        report.phases[static_cast<int>(Imase::SceneBenchmarkPhase::Frame)].GetAverageSeconds(report.frameCount) * 1000.0,
+        report.phases[static_cast<int>(Imase::SceneBenchmarkPhase::Frame)].minSeconds * 1000.0,
+        report.phases[static_cast<int>(Imase::SceneBenchmarkPhase::Frame)].maxSeconds * 1000.0,
+        static_cast<unsigned long long>(report.renderStats.draws),
+        report.renderStats.errors, report.firstError.c_str());
+    OutputDebugStringA(text);
+
+    sprintf_s(text, "SceneBenchmark: occlusion %.1f / %.1f occluded  %.3f ms\n",
+        static_cast<double>(report.occlusionStats.occludedObjects) / std::max(report.frameCount, 1u),
+        static_cast<double>(report.occlusionStats.testedObjects) / std::max(report.frameCount, 1u),
+        (report.occlusionStats.rasterizeSeconds + report.occlusionStats.testSeconds) / std::max(report.frameCount, 1u) * 1000.0);
+    OutputDebugStringA(text);
+
+    // ɋL^R}hXgĐĂ`ɂȂ邩ׂ
+    settings.recordingChunks = PARALLEL_RECORDING_CHUNKS;
+    auto parallelLoop = std::make_unique<Imase::SceneBenchmark>();
+    const Imase::SceneBenchmarkReport& parallelReport = parallelLoop->Run(settings);
+    bool isSameDraws = parallelReport.renderStats.draws == report.renderStats.draws
+        && parallelReport.renderStats.instances == report.renderStats.instances
+        && parallelReport.renderStats.vertices == report.renderStats.vertices;
+
+    sprintf_s(text, "SceneBenchmark: recorded x%u  chunks %llu  commands %llu  draws %llu (%s)  errors %u\n",
+        PARALLEL_RECORDING_CHUNKS,
+        static_cast<unsigned long long>(parallelReport.recordedChunks),
+        static_cast<unsigned long long>(parallelReport.recordedCommands),
+        static_cast<unsigned long long>(parallelReport.renderStats.draws),
+        isSameDraws ? "same" : "DIFFERENT", parallelReport.renderStats.errors);
+    OutputDebugStringA(text);
+
+    // ̃t[̍XV[J[̃XbhōsĂ`ɂȂ邩ׂ
+    settings.recordingChunks = 0;
+    settings.pipelineDepth = FRAME_PIPELINE_DEPTH;
+    auto pipelinedLoop = std::make_unique<Imase::SceneBenchmark>();
+    const Imase::SceneBenchmarkReport& pipelinedReport = pipelinedLoop->Run(settings);
+    bool isSamePipelinedDraws = pipelinedReport.renderStats.draws == report.renderStats.draws
+        && pipelinedReport.renderStats.instances == report.renderStats.instances
+        && pipelinedReport.renderStats.vertices == report.renderStats.vertices;
+
+    sprintf_s(text, "SceneBenchmark: pipelined x%u  latency %.3f ms (max %.3f)  draws %llu (%s)  errors %u\n",
+        FRAME_PIPELINE_DEPTH,
+        pipelinedReport.pipelineStats.GetAverageLatencySeconds() * 1000.0,
+        pipelinedReport.pipelineStats.maxLatencySeconds * 1000.0,
+        static_cast<unsigned long long>(pipelinedReport.renderStats.draws),
+        isSamePipelinedDraws ? "same" : "DIFFERENT", pipelinedReport.renderStats.errors);
+    OutputDebugStringA(text);
+
+    // ؂ŃG[ꍇƕɋL^EpCvC̕`悪قȂꍇ 1 Ԃ
+    return report.renderStats.errors > 0 || parallelReport.renderStats.errors > 0 || pipelinedReport.renderStats.errors > 0
+        || !isSameDraws || !isSamePipelinedDraws ? 1 : 0;
 }
 
 // Updates the world.
-void Game::Update(DX::StepTimer const& timer)
+void Game::Update(DX::StepTimer const& timer, const FrameInput& input)
 {
     float elapsedTime = float(timer.GetElapsedSeconds());
 
     // TODO: Add your game logic here.
 
-    // L[擾
-    auto kb = Keyboard::Get().GetState();
+    // L[擾iCXbhŎ擾Rs[j
+    m_keyboardTracker.Update(input.keyboard);
 
-#ifdef _DEBUG
-    // Debug
+    // F7F`R}h̕L^̐؂ւ
+    if (m_keyboardTracker.pressed.F7)
+    {
+        m_recordingChunkCount = m_recordingChunkCount ? 0 : PARALLEL_RECORDING_CHUNKS;
+    }
+
+    // ̏ԂȌԂɂi`ł͑Oƍ̏ԂԂj
+    m_cameraState.BeginStep();
+    m_lightDirection.BeginStep();
 
+    // fobOJ̍XViImGui ̃EChE𑀍쒆͓Ȃj
+    bool wasPlayingCameraPath = m_cameraPathPlayer.IsPlaying();
+    UpdateCamera(timer, input);
+
+    // sbLO
+    UpdatePicking(input.mouse);
+
+    // `ŕԂ鍡̏Ԃݒ肷
+    // iŏ̍XVƌoH̍Đ̊JnEI̎̓JԂ̂ŕԂȂj
+    Imase::Math::Vector3 lightDirection = Imase::TreeScene::GetLightDirection(timer.GetTotalSeconds());
+    if (timer.GetFrameCount() == 1 || wasPlayingCameraPath != m_cameraPathPlayer.IsPlaying())
+    {
+        m_cameraState.Teleport(m_debugCamera->GetState());
+        m_lightDirection.Teleport(lightDirection);
+    }
+    else
+    {
+        m_cameraState.Set(m_debugCamera->GetState());
+        m_lightDirection.Set(lightDirection);
+    }
+}
+
+#ifdef _DEBUG
+// Updates the ImGui windows (once per rendered frame).
+void Game::UpdateDebugUI(const FrameSnapshot& snapshot)
+{
     // ImGui̍XV
     Imase::DXTK_ImGui::Update(m_deviceResources->GetWindow());
 
@@ -82,176 +292,466 @@ void Game::Update(DX::StepTimer const& timer)
 
     // ----- ImGuĩEChEɍڂǉ ----- //
 
-    //std::vector<float> v;
+    //  Vector3 ̗vf͘AĂ̂ŁAt[ std::vector 炸ɒ ImGui ֓n
 
     //ImGui::SeparatorText("LIGHT SETTING:");
 
     //// Cǧ
-    //v = { m_lightDirection.x, m_lightDirection.y, m_lightDirection.z };
-    //ImGui::DragFloat3("LightDirection", v.data(), 0.01f);
-    //m_lightDirection = { v[0], v[1], v[2] };
+    //ImGui::DragFloat3("LightDirection", &m_lightDirection.x, 0.01f);
     //m_lightDirection.Normalize();
 
     //// ArGgCgF
-    //v = { m_ambientLightColor.x, m_ambientLightColor.y, m_ambientLightColor.z };
-    //ImGui::ColorEdit3("AmbientLightColor", v.data());
-    //m_ambientLightColor = { v[0], v[1], v[2] };
+    //ImGui::ColorEdit3("AmbientLightColor", &m_ambientLightColor.x);
 
     //// Cg̃fBt[YF
-    //v = { m_lightDiffuseColor.x, m_lightDiffuseColor.y, m_lightDiffuseColor.z };
-    //ImGui::ColorEdit3("LightDiffuseColor", v.data());
-    //m_lightDiffuseColor = { v[0], v[1], v[2] };
+    //ImGui::ColorEdit3("LightDiffuseColor", &m_lightDiffuseColor.x);
 
     //// Cg̃XyL[F
-    //v = { m_lightSpecularColor.x, m_lightSpecularColor.y, m_lightSpecularColor.z };
-    //ImGui::ColorEdit3("LightSpecularColor", v.data());
-    //m_lightSpecularColor = { v[0], v[1], v[2] };
+    //ImGui::ColorEdit3("LightSpecularColor", &m_lightSpecularColor.x);
 
     //ImGui::SeparatorText("MATERIAL SETTING:");
 
     //// fBt[YF
-    //v = { m_diffuseColor.x, m_diffuseColor.y, m_diffuseColor.z };
-    //ImGui::ColorEdit3("DiffuseColor", v.data());
-    //m_diffuseColor = { v[0], v[1], v[2] };
+    //ImGui::ColorEdit3("DiffuseColor", &m_diffuseColor.x);
 
     //// XyL[F
-    //v = { m_specularColor.x, m_specularColor.y, m_specularColor.z };
-    //ImGui::ColorEdit3("SpecularColor", v.data());
-    //m_specularColor = { v[0], v[1], v[2] };
+    //ImGui::ColorEdit3("SpecularColor", &m_specularColor.x);
 
     //// XyL[p[
     //ImGui::DragFloat("SpecuarPower", &m_specularPower, 1.0f, 10.0f, 100.0f);
 
     //// G~bVuF
-    //v = { m_emissiveColor.x, m_emissiveColor.y, m_emissiveColor.z };
-    //ImGui::ColorEdit3("EmissiveColor", v.data());
-    //m_emissiveColor = { v[0], v[1], v[2] };
+    //ImGui::ColorEdit3("EmissiveColor", &m_emissiveColor.x);
 
     // --------------------------------------------- //
 
-    // fobOJ̍XV
-    m_debugCamera->Update(!ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows));
+    ImGui::SeparatorText("DEPTH PRECISION:");
 
-    ImGui::End();
+    // [xobt@̕\iw苗ŋʂłŏ̋j
+    {
+        Imase::DepthProjection projection;
+        projection.nearPlane = NEAR_PLANE;
+        projection.farPlane = FAR_PLANE;
+        projection.reverseZ = IsReverseZ();
+        projection.infinite = m_depthMode == DepthMode::InfiniteReverseZ;
 
-//    ImGui::ShowDemoWindow();
-#else
-    // Release
+        for (float distance : { 1.0f, 10.0f, 100.0f, 1000.0f })
+        {
+            ImGui::Text("%6.0f : D32 %.2e  D24 %.2e", distance,
+                Imase::DepthResolution(distance, projection, Imase::DepthFormat::D32_FLOAT),
+                Imase::DepthResolution(distance, projection, Imase::DepthFormat::D24_UNORM));
+        }
+    }
+
+    // EChE𑀍쒆̓fobOJ𓮂Ȃ
+    m_isCameraActive = !ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows);
+
+    ImGui::SeparatorText("SHADOW CASCADES:");
+
+    // JXP[h͈̔͂Ɖe𗎂ƂIuWFNg̐
+    {
+        const Imase::ShadowCascades& cascades = m_treeScene.GetShadowCascades();
+        const size_t* casterCounts = m_treeScene.GetShadowCasterCounts();
+        for (int i = 0; i < cascades.count; i++)
+        {
+            const Imase::ShadowCascade& cascade = cascades.cascades[i];
+            ImGui::Text("%d : %6.2f - %6.2f  texel %.4f  casters %zu",
+                i, cascade.splitNear, cascade.splitFar, cascade.texelSize, casterCounts[i]);
+        }
+    }
+
+    ImGui::SeparatorText("INSTANCING:");
+
+    // CX^X`悵؂̐ƕ`̉
+    ImGui::Text("Forest  %zu / %zu trees  %zu draws",
+        m_treeScene.GetForestInstanceCount(), m_treeScene.GetForestTreeCount(), m_treeScene.GetForestDrawCount());
 
-    // fobOJ̍XV
-    m_debugCamera->Update();
+    ImGui::SeparatorText("OCCLUSION CULLING:");
 
+    // Օ̎Op`̐EBĂ؂̐EԁiՕȂꍇ͉Ȃj
+    {
+        const Imase::OcclusionCullingStats& stats = m_treeScene.GetOcclusionStats();
+        ImGui::Text("Occluders %zu tris  occluded %u / %u  %.3f ms",
+            m_treeScene.GetOccluderTriangleCount(), stats.occludedObjects, stats.testedObjects,
+            (stats.rasterizeSeconds + stats.testSeconds) * 1000.0);
+    }
+
+    ImGui::SeparatorText("JOB SYSTEM:");
+
+    // Õt[ŎsWu̐Ɠ񂾐
+    {
+        Imase::JobSystem& jobSystem = Imase::JobSystem::GetDefault();
+        const Imase::JobSystemStats stats = jobSystem.GetStats();
+        ImGui::Text("Workers %u  jobs %llu  stolen %llu  inlined %llu", jobSystem.GetWorkerCount(),
+            static_cast<unsigned long long>(stats.executed), static_cast<unsigned long long>(stats.stolen),
+            static_cast<unsigned long long>(stats.inlined));
+        jobSystem.ResetStats();
+    }
+
+    ImGui::SeparatorText("RENDER QUEUE:");
+
+    // Õt[ŎspPbg̐ƃXe[g̕ύX̉
+    {
+        const Imase::RenderQueueStats& stats = snapshot.recordingChunkCount ? m_parallelExecutor.GetStats() : m_renderQueue.GetStats();
+        ImGui::Text("Packets %zu  shader %zu  material %zu",
+            stats.packetCount, stats.shaderChanges, stats.materialChanges);
+    }
+
+    // ɋL^`N̐
+    if (snapshot.recordingChunkCount)
+    {
+        const Imase::ParallelRenderStats& stats = m_parallelExecutor.GetParallelStats();
+        ImGui::Text("Deferred  chunks %zu  immediate %zu  (F7 : Off)", stats.chunkCount, stats.immediatePackets);
+    }
+    else
+    {
+        ImGui::Text("Immediate  (F7 : Deferred x%u)", PARALLEL_RECORDING_CHUNKS);
+    }
+
+    ImGui::SeparatorText("STATE FILTER:");
+
+    // Õt[ŃReLXg֐ݒ肵񐔂Əȗ
+    {
+        const Imase::StateFilterStats& stats = m_stateContext.GetStats();
+        ImGui::Text("Issued %u  filtered %u", stats.issued, stats.filtered);
+    }
+
+    ImGui::SeparatorText("CONSTANT RING:");
+
+    // 萔̃Oobt@̎gpʂƁANĂ̊mہEMap ̉
+    if (m_constantRing.IsValid())
+    {
+        const Imase::ConstantRingAllocator& allocator = m_constantRing.GetAllocator();
+        const Imase::ConstantRingStats& stats = m_constantRing.GetStats();
+        ImGui::Text("Used %.1f / %.1f KB  frames %u  wraps %u  failures %u",
+            allocator.GetUsedBytes() / 1024.0, allocator.GetCapacity() / 1024.0,
+            allocator.GetFramesInFlight(), stats.wraps, stats.failures);
+        ImGui::Text("Allocations %u  maps %u  discards %u", stats.allocations, stats.maps, stats.discards);
+    }
+    else
+    {
+        ImGui::Text("Not supported  (object constant buffer)");
+    }
+
+    ImGui::SeparatorText("DEBUG STREAM:");
+
+    // Õt[ŃfobO̐̒_Xg[֏񂾃oCgƕ`̉
+    {
+        const Imase::TransientGeometryStats& stats = m_debugStream.GetStats();
+        ImGui::Text("Streamed %llu bytes  draws %u  (shapes %u  vertices %u)",
+            static_cast<unsigned long long>(stats.streamedBytes), stats.draws, stats.primitives, stats.vertices);
+        ImGui::Text("Used %.1f / %.1f KB  maps %u  failures %u",
+            m_debugStream.GetVertexAllocator().GetUsedBytes() / 1024.0,
+            m_debugStream.GetVertexAllocator().GetCapacity() / 1024.0,
+            stats.maps, stats.failures);
+    }
+
+    ImGui::SeparatorText("CONSTANT BUFFERS:");
+
+    // Õt[Œ萔obt@֏񂾉񐔂ƃoCgieςȂ萔obt@͏܂Ȃj
+    {
+        const Imase::TreeSceneConstantStats& stats = m_treeScene.GetConstantStats();
+        ImGui::Text("Uploaded %llu bytes  frame %u  material %u  object %u  (skipped %u)",
+            static_cast<unsigned long long>(stats.GetUploadedBytes()),
+            stats.frame.uploads, stats.material.uploads, stats.object.uploads,
+            stats.frame.skips + stats.material.skips + stats.object.skips);
+    }
+
+    ImGui::SeparatorText("FRAME PIPELINE:");
+
+    // XV̊Jn`̏I܂ł̎ԂƁA`悷XbhXV҂ԁiρj
+    if (m_pipelineDepth)
+    {
+        const Imase::FramePipelineStats& stats = m_framePipeline.GetStats();
+        double frameCount = static_cast<double>(std::max<uint64_t>(stats.frameCount, 1));
+        ImGui::Text("Depth %u  latency %.2f ms (max %.2f)  wait %.2f ms  (F8 : Off)", m_pipelineDepth,
+            stats.GetAverageLatencySeconds() * 1000.0, stats.maxLatencySeconds * 1000.0,
+            stats.totalAcquireWaitSeconds / frameCount * 1000.0);
+    }
+    else
+    {
+        ImGui::Text("Serial  (F8 : Pipelined x%u)", FRAME_PIPELINE_DEPTH);
+    }
+
+    ImGui::SeparatorText("FRAME ARENA:");
+
+    // Õt[ŎgꎞIȃ̗ʁi`N̊mۂ̉񐔂͎gʂ肷ΑȂj
+    {
+        Imase::FrameArenaStats stats = Imase::FrameArena::GetDefault().GetStats();
+        ImGui::Text("Used %.1f KB / reserved %.1f KB  chunks %llu  threads %u",
+            stats.usedBytes / 1024.0, stats.reservedBytes / 1024.0,
+            static_cast<unsigned long long>(stats.chunkAllocations), stats.threadCount);
+    }
+
+    ImGui::End();
+
+//    ImGui::ShowDemoWindow();
+}
 #endif // _DEBUG
 
+// Picks the scene with the mouse ray.
+void Game::UpdatePicking(const Mouse::State& mouse)
+{
+    m_mouseTracker.Update(mouse);
+
+    // ENbNʒũCƖ؂̃|Š
+    if (m_mouseTracker.rightButton == Mouse::ButtonStateTracker::ButtonState::PRESSED)
+    {
+        Imase::Ray ray = m_debugCamera->CreateRay(mouse.x, mouse.y);
+        m_isPicked = m_pickingBvh.Intersect(ray, &m_pickingHit);
+    }
 }
-#pragma endregion
 
-#pragma region Frame Render
-// Draws the scene.
-void Game::Render()
+// Updates the camera (mouse or recorded path).
+void Game::UpdateCamera(DX::StepTimer const& timer, const FrameInput& input)
 {
-    // Don't try to render anything before the first Update.
-    if (m_timer.GetFrameCount() == 0)
+    // F5FJ̌oH̋L^̊JnEI
+    if (m_keyboardTracker.pressed.F5 && !m_cameraPathPlayer.IsPlaying())
+    {
+        if (m_isRecordingCameraPath)
+        {
+            // Ō̈ʒuL^Ăۑ
+            float time = static_cast<float>(DX::StepTimer::TicksToSeconds(timer.GetTotalTicks() - m_cameraPathStartTicks));
+            m_cameraPath.AddKey({ time, m_debugCamera->GetYaw(), m_debugCamera->GetPitch(), m_debugCamera->GetDistance() });
+            m_cameraPath.Save(CAMERA_PATH_FILE);
+            m_isRecordingCameraPath = false;
+        }
+        else
+        {
+            m_cameraPath.Clear();
+            m_cameraPathStartTicks = timer.GetTotalTicks();
+            m_isRecordingCameraPath = true;
+        }
+    }
+
+    // F6FJ̌oH̍Đ̊JnE~
+    if (m_keyboardTracker.pressed.F6 && !m_isRecordingCameraPath)
+    {
+        if (m_cameraPathPlayer.IsPlaying())
+        {
+            m_cameraPathPlayer.Stop();
+            m_cameraPathPlayer.WriteReport(CAMERA_PATH_REPORT_FILE);
+        }
+        else if (m_cameraPath.Load(CAMERA_PATH_FILE))
+        {
+            // Pt[ 1/60 bi߂isxɊ֌WȂ񓯂t[œʒuɂȂj
+            m_cameraPathPlayer.Start(m_cameraPath, DX::StepTimer::TicksPerSecond / 60, DX::StepTimer::TicksPerSecond);
+        }
+    }
+
+    // Đ͕`悷t[ƂɌoHŃJ𓮂iUpdateCameraPathj
+    if (m_cameraPathPlayer.IsPlaying())
     {
         return;
     }
 
-    Clear();
+    m_debugCamera->Update(input.mouse, input.isCameraActive);
+}
 
-    m_deviceResources->PIXBeginEvent(L"Render");
-    auto context = m_deviceResources->GetD3DDeviceContext();
+// Advances or records the camera path (once per rendered frame, after the updates).
+void Game::UpdateCameraPath(DX::StepTimer const& timer)
+{
+    // Đ̓}EX̑ɌoHŃJ𓮂
+    // iŒ̊Ԋu̍XV͂Pt[ɂO╡ɂȂ̂ŁAoH̓t[ƂɂP񂾂i߂j
+    if (m_cameraPathPlayer.IsPlaying())
+    {
+        Imase::CameraPathKey key;
+        if (m_cameraPathPlayer.Advance(timer.GetFrameElapsedSeconds(), &key))
+        {
+            m_debugCamera->SetState(key.yaw, key.pitch, key.distance);
+        }
+        else
+        {
+            // Ō܂ōĐvʂo͂
+            m_cameraPathPlayer.WriteReport(CAMERA_PATH_REPORT_FILE);
+        }
 
-    // TODO: Add your rendering code here.
-    context;
+        // oḦʒû܂ܕ`悷iXV̊Ԃ̕Ԃ͂Ȃj
+        m_cameraState.Teleport(m_debugCamera->GetState());
+        return;
+    }
+
+    // J̏ԂL^
+    if (m_isRecordingCameraPath)
+    {
+        float time = static_cast<float>(DX::StepTimer::TicksToSeconds(timer.GetTotalTicks() - m_cameraPathStartTicks));
+        m_cameraPath.Record({ time, m_debugCamera->GetYaw(), m_debugCamera->GetPitch(), m_debugCamera->GetDistance() }, CAMERA_PATH_KEY_INTERVAL);
+    }
+}
+#pragma endregion
 
-    // r[s擾
-    SimpleMath::Matrix view = m_debugCamera->GetCameraMatrix();
+#pragma region Frame Render
+// Captures the state to render from the latest updates (on the pipeline worker when pipelined).
+void Game::CaptureSnapshot(FrameSnapshot* snapshot)
+{
+    snapshot->updateCount = m_timer.GetFrameCount();
+    if (snapshot->updateCount == 0)
+    {
+        return;
+    }
 
-    //view = Imase::CreateViewMatrix(SimpleMath::Vector3(0, 0, 5), SimpleMath::Vector3(0, 0, 0), SimpleMath::Vector3::Up);
+    // Oƍ̍XV̊ԂԂJ̏ԂɂisƎ͕ωČvZj
+    float alpha = static_cast<float>(m_timer.GetInterpolationAlpha());
+    m_renderCameraView.SetState(m_cameraState.Get(alpha));
 
-    // Obh̏̕`
-    m_gridFloor->Render(context, view, m_proj);
+    snapshot->view = Imase::Math::ToSimpleMath(m_renderCameraView.GetView());
+    snapshot->viewProjection = Imase::Math::ToSimpleMath(m_renderCameraView.GetViewProjection());
+    snapshot->frustum = m_renderCameraView.GetFrustum();
+    snapshot->eyePosition = Imase::Math::ToSimpleMath(m_renderCameraView.GetEyePosition());
+    snapshot->cameraVersion = m_renderCameraView.GetVersion();
 
-    // ----- |S̕` ----- //
+    snapshot->lightDirection = m_lightDirection.Get(alpha).Normalized();
+    snapshot->recordingChunkCount = m_recordingChunkCount;
 
-    SimpleMath::Matrix rotY = SimpleMath::Matrix::CreateRotationY(m_timer.GetTotalSeconds());
-    SimpleMath::Vector3 lightDir = SimpleMath::Vector3::Transform(SimpleMath::Vector3::Forward, rotY);
+    // ----- ʂɕ\镶i肫Ȃꍇ͐؂l߂j ----- //
 
-    // 萔obt@̍XV
+    char* text = snapshot->debugText;
+    size_t size = DEBUG_TEXT_SIZE;
+    auto print = [&](const char* format, auto... args)
+    {
+        int length = std::snprintf(text, size, format, args...);
+        if (length <= 0) return;
+        size_t written = std::min(static_cast<size_t>(length), size - 1);
+        text += written;
+        size -= written;
+    };
+    *text = '\0';
+
+    // Œ̊Ԋu̍XV̕Ԃ̊ƁAǂɎ̂ĂXV̐
+    print("Update %u Hz  alpha %.2f  dropped %llu\n", UPDATES_PER_SECOND,
+        m_timer.GetInterpolationAlpha(), static_cast<unsigned long long>(m_timer.GetDroppedUpdateCount()));
+
+    // ENbN|S
+    if (m_isPicked)
+    {
+        print("Pick  triangle %u  distance %.3f\n", m_pickingHit.primitive, m_pickingHit.distance);
+    }
+    else
     {
-        ConstantBufferData data = {};
+        print("Right click : Pick\n");
+    }
 
-        SimpleMath::Matrix world = SimpleMath::Matrix::CreateScale(2.0f);
+    // J̌oH̏
+    if (m_isRecordingCameraPath)
+    {
+        print("Camera path  recording  keys %zu\n", m_cameraPath.GetKeyCount());
+    }
+    else if (m_cameraPathPlayer.IsPlaying())
+    {
+        print("Camera path  playing  frame %llu  %.1f / %.1f s\n",
+            static_cast<unsigned long long>(m_cameraPathPlayer.GetFrame()),
+            m_cameraPathPlayer.GetFrame() / 60.0f,
+            m_cameraPath.GetEndTime() - m_cameraPath.GetStartTime());
+    }
+    else
+    {
+        print("Camera path  F5 : Record  F6 : Play\n");
+    }
 
-        // [hs~r[s~vWFNVsݒ肷
-        SimpleMath::Matrix m = world * view * m_proj;
+    // ԂƂ̏ԁiρj
+    const auto& segmentStats = m_cameraPathPlayer.GetSegmentStats();
+    for (size_t i = 0; i < segmentStats.size(); i++)
+    {
+        if (segmentStats[i].frameCount == 0) continue;
+        print("%3zu : %6.2f ms (max %6.2f)\n", i,
+            segmentStats[i].GetAverageSeconds() * 1000.0, segmentStats[i].maxSeconds * 1000.0);
+    }
+}
 
-        // VF[_[֗Dsnߓ]u
-        data.worldViewProjection = XMMatrixTranspose(m);
+// Draws the scene.
+void Game::Render(const FrameSnapshot& snapshot)
+{
+    // Don't try to render anything before the first Update.
+    if (snapshot.updateCount == 0)
+    {
+        return;
+    }
 
-        // Cg̕xNg
-        data.lightDirection = lightDir;
+    // `撆̓XibvVbggipCvC̏ꍇ͎̃t[̍XVɓĂj
+    m_renderSnapshot = &snapshot;
 
-        D3D11_MAPPED_SUBRESOURCE mapped;
-        context->Map(m_constantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    Clear();
 
-        // CPŨobt@
-        memcpy(mapped.pData, &data, sizeof(data));
+    m_deviceResources->PIXBeginEvent(L"Render");
+    auto context = m_deviceResources->GetD3DDeviceContext();
 
-        context->Unmap(m_constantBuffer.Get(), 0);
-    }
+    // TODO: Add your rendering code here.
+    context;
 
-    // _obt@̐ݒ
-    ID3D11Buffer* buffers[] = { m_vertexBuffer.Get() };
-    UINT stride = sizeof(VertexBufferData);
-    UINT offset = 0;
-    context->IASetVertexBuffers(0, 1, buffers, &stride, &offset);
+    // r[s擾iOƍ̍XV̊ԂԂJj
+    const SimpleMath::Matrix& view = snapshot.view;
 
-    // CfbNXobt@̐ݒ
-    context->IASetIndexBuffer(m_indexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0);
+    //view = Imase::CreateViewMatrix(SimpleMath::Vector3(0, 0, 5), SimpleMath::Vector3(0, 0, 0), SimpleMath::Vector3::Up);
 
-    // ̓CAEg̐ݒ
-    context->IASetInputLayout(m_inputLayout.Get());
+    // 擾iJČvZĂj
+    const Imase::Frustum& frustum = snapshot.frustum;
 
-    // g|W[̐ݒ
-    context->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    // ----- `pPbgς ----- //
 
-    // 萔obt@̐ݒ
-    ID3D11Buffer* cBuffers[] = { m_constantBuffer.Get() };
-    context->VSSetConstantBuffers(0, 1, cBuffers);
+    m_renderQueue.Clear();
 
-    // _VF[_[̐ݒ
-    context->VSSetShader(m_vertexShader.Get(), nullptr, 0);
+    // Xe[g̐ݒ̉񐔂𐔂iÕt[̉񐔂 ImGui ŕ\ς݁j
+    m_stateContext.ResetStats();
 
-    // sNZVF[_[̐ݒ
-    context->PSSetShader(m_pixelShader.Get(), nullptr, 0);
+    // 萔̃Oobt@̃t[i߂iGPU gIt[͈̔͂ėpj
+    m_constantRing.BeginFrame();
 
-    // Tv[Xe[g̐ݒ
-    ID3D11SamplerState* samplers[] = { m_samplerState.Get() };
-    context->PSSetSamplers(0, 1, samplers);
+    // fobO̐̒_Xg[̃t[i߂iÕt[ŕ`悵Ȃ͎̂Ăj
+    m_debugStream.BeginFrame();
 
-    // VF[_[\[X̐ݒ
-    ID3D11ShaderResourceView* shaderResources[] = { m_treeTexture.Get() };
-    context->PSSetShaderResources(0, 1, shaderResources);
+    // Obh̏iDirectXTK ŃXe[gݒ肷j
+    m_renderQueue.Submit(LAYER_OPAQUE, Imase::RenderQueue::EXTERNAL_SHADER, 0, 0.0f, DRAW_GRID_FLOOR);
 
-    // X^CU[Xe[g̐ݒ
-    context->RSSetState(m_rasterizerState.Get());
+    // ؂ƐXiJXP[hVhĚvZEJOECX^X̃f[^̍XVsj
+    {
+        Imase::TreeSceneView sceneView = {};
+        sceneView.view = Imase::Math::FromSimpleMath(view);
+        sceneView.viewProjection = Imase::Math::FromSimpleMath(snapshot.viewProjection);
+        sceneView.frustum = frustum;
+        sceneView.eyePosition = Imase::Math::FromSimpleMath(snapshot.eyePosition);
+        sceneView.lightDirection = snapshot.lightDirection;
+        sceneView.fovY = m_fovY;
+        sceneView.aspectRatio = m_aspectRatio;
+        sceneView.nearPlane = NEAR_PLANE;
+        sceneView.farPlane = FAR_PLANE;
+
+        // X̖؂̃GeBeBJOp̔ziGeBeB͕`悷Xbhgj
+        m_treeScene.Update();
+        m_treeScene.Submit(&m_renderQueue, LAYER_TRANSLUCENT, sceneView);
+    }
 
-    // [xXeVobt@̐ݒ
-    context->OMSetDepthStencilState(m_depthStencilState.Get(), 0);
+    // ʂ̍ɍXV̏Ԃ\
+    {
+        int lineCount = 0;
+        for (const char* c = snapshot.debugText; *c; c++)
+        {
+            if (*c == '\n') lineCount++;
+        }
+        const auto size = m_deviceResources->GetOutputSize();
+        int y = size.bottom - static_cast<int>(m_debugFont->GetFontHeight() * lineCount);
+        m_debugFont->AddString(10, y, Colors::White, L"%hs", snapshot.debugText);
+    }
 
-    // uhXe[g̐ݒ
-    context->OMSetBlendState(m_blendState.Get(), nullptr, 0xffffffff);
+    // fobOtHgiSpriteBatch ŃXe[gݒ肷j
+    m_renderQueue.Submit(LAYER_OVERLAY, Imase::RenderQueue::EXTERNAL_SHADER, 0, 0.0f, DRAW_DEBUG_FONT);
 
-    // `
-    context->DrawIndexed(6, 0, 0);
+    // ----- \[gL[̏ɕ`悷 ----- //
 
-    // fobOtHg̕`
-    m_debugFont->Render(m_states.get());
+    m_renderQueue.Sort();
+    if (snapshot.recordingChunkCount)
+    {
+        // `NƂɒxReLXg֕ɋL^AԂɎs
+        m_parallelExecutor.Execute(m_renderQueue, this, &m_stateContext, m_deferredRecorder.get(), snapshot.recordingChunkCount);
+    }
+    else
+    {
+        m_renderQueue.Execute(this);
+    }
 
 #ifdef _DEBUG
     // ImGui̕`揈
     Imase::DXTK_ImGui::Render();
+    m_stateContext.Invalidate();
 #endif // _DEBUG
 
     m_deviceResources->PIXEndEvent();
@@ -260,6 +760,70 @@ void Game::Render()
     m_deviceResources->Present();
 }
 
+// Binds the input layout, shaders and states of a render queue shader.
+void Game::BindShader(uint32_t shader)
+{
+    // VF[_[͑SĖ؂ƐX̃V[̂
+    m_treeScene.BindShader(shader);
+}
+
+// Binds the texture of a render queue material.
+void Game::BindMaterial(uint32_t material)
+{
+    m_treeScene.BindMaterial(material);
+}
+
+// Draws one render queue packet.
+void Game::Draw(const Imase::RenderPacket& packet)
+{
+    auto context = m_deviceResources->GetD3DDeviceContext();
+
+    switch (packet.command)
+    {
+    case DRAW_GRID_FLOOR:
+        // Obh̏̕`
+        m_gridFloor->Render(context, m_renderContext.get(), &m_debugStream, m_renderSnapshot->view, m_proj, m_renderSnapshot->cameraVersion);
+        m_stateContext.Invalidate();
+        break;
+
+    case DRAW_DEBUG_FONT:
+        // fobOtHg̕`
+        m_debugFont->Render(m_states.get());
+        m_stateContext.Invalidate();
+        break;
+
+    default:
+        // ؂ƐX
+        m_treeScene.Draw(packet);
+        break;
+    }
+}
+
+// Binds a render queue shader to a chunk context (called from worker threads).
+void Game::BindShader(Imase::StateFilteredContext<Imase::IRenderContext>& context, uint32_t shader)
+{
+    m_treeScene.BindShader(context, shader);
+}
+
+// Binds a render queue material to a chunk context (called from worker threads).
+void Game::BindMaterial(Imase::StateFilteredContext<Imase::IRenderContext>& context, uint32_t material)
+{
+    m_treeScene.BindMaterial(context, material);
+}
+
+// Draws one render queue packet to a chunk context (external packets run on the immediate context).
+void Game::Draw(Imase::StateFilteredContext<Imase::IRenderContext>& context, const Imase::RenderPacket& packet)
+{
+    // DirectXTK ̕`̓C~fBGCgReLXgōs
+    if (packet.shader == Imase::RenderQueue::EXTERNAL_SHADER)
+    {
+        Draw(packet);
+        return;
+    }
+
+    m_treeScene.Draw(context, packet);
+}
+
 // Helper method to clear the back buffers.
 void Game::Clear()
 {
@@ -271,7 +835,8 @@ void Game::Clear()
     auto depthStencil = m_deviceResources->GetDepthStencilView();
 
     context->ClearRenderTargetView(renderTarget, Colors::CornflowerBlue);
-    context->ClearDepthStencilView(depthStencil, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+    // Reverse-Z ̏ꍇ͉ 0 ɂȂ
+    context->ClearDepthStencilView(depthStencil, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, IsReverseZ() ? 0.0f : 1.0f, 0);
     context->OMSetRenderTargets(1, &renderTarget, depthStencil);
 
     // Set the viewport.
@@ -301,6 +866,9 @@ void Game::OnSuspending()
 
 void Game::OnResuming()
 {
+    // XṼXbh~߂Ă^C}[ύXi Tick ōĊJj
+    m_framePipeline.Stop();
+
     m_timer.ResetElapsedTime();
 
     // TODO: Game is being power-resumed (or returning from minimize).
@@ -322,9 +890,13 @@ void Game::OnWindowSizeChanged(int width, int height)
     if (!m_deviceResources->WindowSizeChanged(width, height))
         return;
 
+    // XṼXbh~߂ĂJƎˉesύXi Tick ōĊJj
+    m_framePipeline.Stop();
+
     CreateWindowSizeDependentResources();
 
     // TODO: Game window is being resized.
+    if (m_debugCamera) m_debugCamera->SetWindowSize(width, height);
 }
 
 // Properties
@@ -353,6 +925,14 @@ void Game::CreateDeviceDependentResources()
     Imase::DXTK_ImGui::Initialize(m_deviceResources->GetWindow(), device, context, w, h);
 #endif // _DEBUG
 
+    // `R}h𔭍sReLXgƃXe[g̐ݒȗ郉bp[
+    // ifoCX蒼ꍇݒ肵j
+    m_renderContext = std::make_unique<Imase::D3D11RenderContext>(context);
+    m_stateContext.Reset(m_renderContext.get());
+
+    // `R}hɋL^xReLXgiKvɂȂɍ쐬j
+    m_deferredRecorder = std::make_unique<Imase::D3D11DeferredCommandRecorder>(context);
+
     // RXe[g̍쐬
     m_states = std::make_unique<CommonStates>(device);
 
@@ -363,6 +943,33 @@ void Game::CreateDeviceDependentResources()
     // Obh̏̍쐬
     m_gridFloor = std::make_unique<Imase::GridFloor>(
         device, context, m_states.get());
+    if (IsReverseZ())
+    {
+        m_gridFloor->SetDepthStencilState(m_states->DepthReverseZ());
+    }
+
+    // fobO̐̒_Xg[̍쐬iCPU ǋL钸_obt@ 32 rbg̃CfbNXobt@j
+    {
+        D3D11_BUFFER_DESC desc = {};
+        desc.Usage = D3D11_USAGE_DYNAMIC;
+        desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+        desc.ByteWidth = DEBUG_VERTEX_STREAM_SIZE;
+        desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        DX::ThrowIfFailed(
+            device->CreateBuffer(&desc, nullptr, m_debugVertexBuffer.ReleaseAndGetAddressOf())
+        );
+
+        desc.ByteWidth = DEBUG_INDEX_STREAM_SIZE;
+        desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+        DX::ThrowIfFailed(
+            device->CreateBuffer(&desc, nullptr, m_debugIndexBuffer.ReleaseAndGetAddressOf())
+        );
+
+        m_debugStream.Initialize(
+            Imase::ToRenderHandle(m_debugVertexBuffer.Get()), DEBUG_VERTEX_STREAM_SIZE,
+            Imase::ToRenderHandle(m_debugIndexBuffer.Get()), DEBUG_INDEX_STREAM_SIZE);
+    }
 
     // ----- _VF[_[  ̓CAEg ----- //
     {
@@ -388,6 +995,35 @@ void Game::CreateDeviceDependentResources()
         );
     }
 
+    // ----- _VF[_[  ̓CAEgiCX^X`pj ----- //
+    {
+        // _VF[_[̓ǂݍ
+        std::vector<uint8_t> data = DX::ReadData(L"Resources/Shaders/InstancedVertexShader.cso");
+
+        // _VF[_[̍쐬
+        DX::ThrowIfFailed(
+            device->CreateVertexShader(data.data(), data.size(), nullptr, m_instancedVertexShader.ReleaseAndGetAddressOf())
+        );
+
+        // ̓CAEg̍쐬iXbgP̓CX^XƂ̃f[^FImase::QuadInstancej
+        D3D11_INPUT_ELEMENT_DESC layout[] =
+        {
+            { "SV_Position", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA,   0 },
+            { "COLOR",       0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA,   0 },
+            { "TEXCOORD",    0, DXGI_FORMAT_R32G32_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA,   0 },
+            { "NORMAL",      0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA,   0 },
+            { "WORLD",       0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "WORLD",       1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "WORLD",       2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "COLOR",       1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "TEXCOORD",    1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        };
+
+        DX::ThrowIfFailed(
+            device->CreateInputLayout(layout, ARRAYSIZE(layout), data.data(), data.size(), m_instancedInputLayout.ReleaseAndGetAddressOf())
+        );
+    }
+
     // ----- sNZVF[_[ ----- //
     {
         // sNZVF[_[̓ǂݍ
@@ -402,35 +1038,65 @@ void Game::CreateDeviceDependentResources()
     // ----- 萔obt@ ----- //
     {
         // 萔obt@̍쐬
-        D3D11_BUFFER_DESC desc = {};
-        desc.ByteWidth = sizeof(ConstantBufferData);
-        desc.Usage = D3D11_USAGE_DYNAMIC;
-        desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-        DX::ThrowIfFailed(
-            device->CreateBuffer(&desc, nullptr, m_constantBuffer.ReleaseAndGetAddressOf())
-        );
+        auto createConstantBuffer = [&](UINT byteWidth, ID3D11Buffer** buffer)
+        {
+            D3D11_BUFFER_DESC desc = {};
+            desc.ByteWidth = byteWidth;
+            desc.Usage = D3D11_USAGE_DYNAMIC;
+            desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+            desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+            DX::ThrowIfFailed(
+                device->CreateBuffer(&desc, nullptr, buffer)
+            );
+        };
+
+        // XV̕pxŕit[ƁE؂̃}eAEIuWFNgƁj
+        createConstantBuffer(sizeof(Imase::TreeScene::FrameConstants), m_frameConstantBuffer.ReleaseAndGetAddressOf());
+        createConstantBuffer(sizeof(Imase::TreeScene::MaterialConstants), m_treeMaterialConstantBuffer.ReleaseAndGetAddressOf());
+        createConstantBuffer(sizeof(Imase::TreeScene::ObjectConstants), m_objectConstantBuffer.ReleaseAndGetAddressOf());
     }
 
-    // ----- _obt@ ----- //
+    // ----- 萔̃Oobt@ ----- //
     {
-        // _f[^
-        VertexBufferData vertices[] =
+        // GPU  FRAME_LATENCY t[xȂ̂ƂĔ͈͂ėp̂ŁAfoCXɐݒłmF
+        if (m_deviceResources->GetMaximumFrameLatency() != Imase::ConstantRing::FRAME_LATENCY)
         {
-            { {  -0.5f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f },{ 0.0f, 0.0f },{ 0.0f, 0.0f, 1.0f } },   // 0
-            { {   0.5f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 1.0f },{ 1.0f, 0.0f },{ 0.0f, 0.0f, 1.0f } },   // 1
-            { {   0.5f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 1.0f },{ 1.0f, 1.0f },{ 0.0f, 0.0f, 1.0f } },   // 2
-            { {  -0.5f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f, 1.0f },{ 0.0f, 1.0f },{ 0.0f, 0.0f, 1.0f } },   // 3
-        };
+            throw std::logic_error("The device frame latency does not match Imase::ConstantRing::FRAME_LATENCY");
+        }
 
+        // 萔obt@͈̔͂̎wƁA萔obt@ WRITE_NO_OVERWRITE ɑΉĂ邩ׂ
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+        bool isSupported = SUCCEEDED(device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options)))
+            && options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+
+        m_constantRingBuffer.Reset();
+        if (isSupported)
+        {
+            // 萔obt@̍쐬i`悲Ƃ̒萔 256 oCgPʂŋl߂ďށj
+            D3D11_BUFFER_DESC desc = {};
+            desc.ByteWidth = CONSTANT_RING_SIZE;
+            desc.Usage = D3D11_USAGE_DYNAMIC;
+            desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+            desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+            DX::ThrowIfFailed(
+                device->CreateBuffer(&desc, nullptr, m_constantRingBuffer.ReleaseAndGetAddressOf())
+            );
+        }
+
+        // ΉĂȂꍇ̓IuWFNgƂ̒萔 m_objectConstantBuffer ֏
+        m_constantRing.Initialize(Imase::ToRenderHandle(m_constantRingBuffer.Get()), CONSTANT_RING_SIZE);
+    }
+
+    // ----- _obt@ ----- //
+    {
         // _obt@̍쐬
         D3D11_BUFFER_DESC desc = {};
-        desc.ByteWidth = sizeof(vertices);
+        desc.ByteWidth = sizeof(Imase::TreeScene::QUAD_VERTICES);
         desc.Usage = D3D11_USAGE_DEFAULT;
         desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 
         D3D11_SUBRESOURCE_DATA data = {};
-        data.pSysMem = vertices;
+        data.pSysMem = Imase::TreeScene::QUAD_VERTICES;
 
         DX::ThrowIfFailed(
             device->CreateBuffer(&desc, &data, m_vertexBuffer.ReleaseAndGetAddressOf())
@@ -439,23 +1105,48 @@ void Game::CreateDeviceDependentResources()
 
     // ----- CfbNXobt@ ----- //
     {
-        // CfbNXf[^
-        UINT16 indices[] = { 0, 1, 2, 0, 2, 3 };
-
         // CfbNX_obt@̍쐬
         D3D11_BUFFER_DESC desc = {};
-        desc.ByteWidth = sizeof(indices);
+        desc.ByteWidth = sizeof(Imase::TreeScene::QUAD_INDICES);
         desc.Usage = D3D11_USAGE_DEFAULT;
         desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 
         D3D11_SUBRESOURCE_DATA data = {};
-        data.pSysMem = indices;
+        data.pSysMem = Imase::TreeScene::QUAD_INDICES;
 
         DX::ThrowIfFailed(
             device->CreateBuffer(&desc, &data, m_indexBuffer.ReleaseAndGetAddressOf())
         );
     }
 
+    // ----- CX^Xp̒_obt@ ----- //
+    {
+        // t[̂ CPU 珑߂悤ɂ
+        D3D11_BUFFER_DESC desc = {};
+        desc.ByteWidth = sizeof(Imase::QuadInstance) * Imase::TreeScene::MAX_QUAD_INSTANCES;
+        desc.Usage = D3D11_USAGE_DYNAMIC;
+        desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        DX::ThrowIfFailed(
+            device->CreateBuffer(&desc, nullptr, m_instanceBuffer.ReleaseAndGetAddressOf())
+        );
+    }
+
+    // ----- X̖؂̔zu ----- //
+    m_treeScene.Initialize();
+
+    // ----- sbLOp BVH ----- //
+    {
+        // ؂̃|S̃[hWi`掞̃XP[QKpς݁j
+        Imase::Math::Vector3 positions[] =
+        {
+            { -1.0f, 2.0f, 0.0f }, { 1.0f, 2.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+        };
+        uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+
+        m_pickingBvh.BuildFromTriangles(positions, indices, 2);
+    }
+
     // ----- X^CU[Xe[g ----- //
     {
         // X^CU[Xe[g̍쐬
@@ -481,7 +1172,8 @@ void Game::CreateDeviceDependentResources()
         D3D11_DEPTH_STENCIL_DESC desc = {};
         desc.DepthEnable = TRUE;
         desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
-        desc.DepthFunc = D3D11_COMPARISON_LESS;
+        // Reverse-Z ̏ꍇ͎Oقǐ[xl傫Ȃ
+        desc.DepthFunc = IsReverseZ() ? D3D11_COMPARISON_GREATER : D3D11_COMPARISON_LESS;
         desc.StencilEnable = FALSE;
         DX::ThrowIfFailed(
             device->CreateDepthStencilState(&desc, m_depthStencilState.ReleaseAndGetAddressOf())
@@ -532,6 +1224,30 @@ void Game::CreateDeviceDependentResources()
         );
     }
 
+    // ----- ؂ƐX̃V[փ\[Xn ----- //
+    {
+        Imase::TreeSceneResources resources = {};
+        resources.vertexBuffer = Imase::ToRenderHandle(m_vertexBuffer.Get());
+        resources.indexBuffer = Imase::ToRenderHandle(m_indexBuffer.Get());
+        resources.instanceBuffer = Imase::ToRenderHandle(m_instanceBuffer.Get());
+        resources.frameConstantBuffer = Imase::ToRenderHandle(m_frameConstantBuffer.Get());
+        resources.treeMaterialConstantBuffer = Imase::ToRenderHandle(m_treeMaterialConstantBuffer.Get());
+        resources.objectConstantBuffer = Imase::ToRenderHandle(m_objectConstantBuffer.Get());
+        resources.constantRing = m_constantRing.IsValid() ? &m_constantRing : nullptr;
+        resources.inputLayout = Imase::ToRenderHandle(m_inputLayout.Get());
+        resources.vertexShader = Imase::ToRenderHandle(m_vertexShader.Get());
+        resources.instancedInputLayout = Imase::ToRenderHandle(m_instancedInputLayout.Get());
+        resources.instancedVertexShader = Imase::ToRenderHandle(m_instancedVertexShader.Get());
+        resources.pixelShader = Imase::ToRenderHandle(m_pixelShader.Get());
+        resources.treeTexture = Imase::ToRenderHandle(m_treeTexture.Get());
+        resources.samplerState = Imase::ToRenderHandle(m_samplerState.Get());
+        resources.rasterizerState = Imase::ToRenderHandle(m_rasterizerState.Get());
+        resources.depthStencilState = Imase::ToRenderHandle(m_depthStencilState.Get());
+        resources.blendState = Imase::ToRenderHandle(m_blendState.Get());
+
+        m_treeScene.SetResources(resources, &m_stateContext);
+    }
+
 }
 
 // Allocate all memory resources that change on a window SizeChanged event.
@@ -543,18 +1259,41 @@ void Game::CreateWindowSizeDependentResources()
     int w, h;
     GetDefaultSize(w, h);
 
+    float fovY = XMConvertToRadians(45.0f);
+    float aspectRatio = static_cast<float>(w) / static_cast<float>(h);
+
+    m_fovY = fovY;
+    m_aspectRatio = aspectRatio;
+
     // ˉes̍쐬
-    m_proj = Imase::CreatePerspectiveMatrix(
-        // p@@@@@@@@@@AXyNg
-        XMConvertToRadians(45.0f), static_cast<float>(w) / static_cast<float>(h),
-        // Near Far
-        0.1f, 100.0f);
+    switch (m_depthMode)
+    {
+    case DepthMode::ReverseZ:
+        m_proj = Imase::CreatePerspectiveMatrixReverseZ(fovY, aspectRatio, NEAR_PLANE, FAR_PLANE);
+        break;
+    case DepthMode::InfiniteReverseZ:
+        m_proj = Imase::CreatePerspectiveMatrixInfiniteReverseZ(fovY, aspectRatio, NEAR_PLANE);
+        break;
+    default:
+        m_proj = Imase::CreatePerspectiveMatrix(fovY, aspectRatio, NEAR_PLANE, FAR_PLANE);
+        break;
+    }
+
+    // fobOJƕ`悷Jɂˉesݒ肷ir[s~ˉesƎ̌vZɎgpj
+    if (m_debugCamera) m_debugCamera->SetProjectionMatrix(m_proj);
+    m_renderCameraView.SetProjection(Imase::Math::FromSimpleMath(m_proj));
 
 }
 
 void Game::OnDeviceLost()
 {
     // TODO: Add Direct3D resource cleanup here.
+
+    // XṼXbh~߂Ă烊\[Xi Tick ōĊJj
+    m_framePipeline.Stop();
+
+    // xReLXgƋL^̃R}hXg
+    m_deferredRecorder.reset();
 }
 
 void Game::OnDeviceRestored()
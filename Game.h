@@ -12,10 +12,22 @@
 #include "ImaseLib/DebugFont.h"
 #include "ImaseLib/DebugCamera.h"
 #include "ImaseLib/GridFloor.h"
+#include "ImaseLib/CameraPath.h"
+#include "ImaseLib/Picking.h"
+#include "ImaseLib/RenderQueue.h"
+#include "ImaseLib/RenderContext.h"
+#include "ImaseLib/D3D11RenderContext.h"
+#include "ImaseLib/StateFilteredContext.h"
+#include "ImaseLib/ParallelRenderExecutor.h"
+#include "ImaseLib/TreeScene.h"
+#include "ImaseLib/ConstantRing.h"
+#include "ImaseLib/TransientGeometryStream.h"
+#include "ImaseLib/InterpolatedState.h"
+#include "ImaseLib/FramePipeline.h"
 
 // A basic game implementation that creates a D3D11 device and
 // provides a game loop.
-class Game final : public DX::IDeviceNotify
+class Game final : public DX::IDeviceNotify, public Imase::IRenderPacketHandler, public Imase::IParallelRenderPacketHandler
 {
 public:
 
@@ -34,10 +46,24 @@ public:
     // Basic game loop
     void Tick();
 
+    // Runs a synthetic TreeScene benchmark without a window or GPU and reports the CPU timings.
+    // This does not run Tick/Update/Render (see Imase::SceneBenchmark).
+    int RunSceneBenchmark(uint32_t frameCount);
+
     // IDeviceNotify
     void OnDeviceLost() override;
     void OnDeviceRestored() override;
 
+    // IRenderPacketHandler
+    void BindShader(uint32_t shader) override;
+    void BindMaterial(uint32_t material) override;
+    void Draw(const Imase::RenderPacket& packet) override;
+
+    // IParallelRenderPacketHandler
+    void BindShader(Imase::StateFilteredContext<Imase::IRenderContext>& context, uint32_t shader) override;
+    void BindMaterial(Imase::StateFilteredContext<Imase::IRenderContext>& context, uint32_t material) override;
+    void Draw(Imase::StateFilteredContext<Imase::IRenderContext>& context, const Imase::RenderPacket& packet) override;
+
     // Messages
     void OnActivated();
     void OnDeactivated();
@@ -52,8 +78,51 @@ public:
 
 private:
 
-    void Update(DX::StepTimer const& timer);
-    void Render();
+    // ʂɕ\镶̍ő̒
+    static constexpr size_t DEBUG_TEXT_SIZE = 1024;
+
+    // `悷t[̏ԁiXṼXbhōA`撆͕ύXȂj
+    struct FrameSnapshot
+    {
+        // XV񐔁i0 ̏ꍇ͂܂XVĂȂ̂ŕ`悵Ȃj
+        uint32_t updateCount;
+
+        // JiŒ̊Ԋu̍XV̊ԂԂԁj
+        DirectX::SimpleMath::Matrix view;
+        DirectX::SimpleMath::Matrix viewProjection;
+        Imase::Frustum frustum;
+        DirectX::SimpleMath::Vector3 eyePosition;
+        uint32_t cameraVersion;
+
+        // Cǧ
+        Imase::Math::Vector3 lightDirection;
+
+        // pPbg𕪊ĕɋL^`N̐
+        uint32_t recordingChunkCount;
+
+        // ʂɕ\镶i^C}[EsbLOEJ̌oH̏ԁj
+        char debugText[DEBUG_TEXT_SIZE];
+    };
+
+    // CXbhłPt[ɂP擾́iXV͂̃Rs[ǂށj
+    struct FrameInput
+    {
+        DirectX::Keyboard::State keyboard;
+        DirectX::Mouse::State mouse;
+
+        // ImGui ̃EChE𑀍삵ĂȂꍇ trueifobOJ𓮂j
+        bool isCameraActive;
+    };
+
+    FrameInput SampleInput() const;
+    void UpdateFrame(uint32_t slot);
+    void Update(DX::StepTimer const& timer, const FrameInput& input);
+    void UpdateDebugUI(const FrameSnapshot& snapshot);
+    void UpdateCamera(DX::StepTimer const& timer, const FrameInput& input);
+    void UpdateCameraPath(DX::StepTimer const& timer);
+    void UpdatePicking(const DirectX::Mouse::State& mouse);
+    void CaptureSnapshot(FrameSnapshot* snapshot);
+    void Render(const FrameSnapshot& snapshot);
 
     void Clear();
 
@@ -66,11 +135,37 @@ private:
     // Rendering loop timer.
     DX::StepTimer                           m_timer;
 
+    // Œ̊Ԋu̍XV̉񐔁iPbjƂPt[ŒǂXV̍ő吔
+    static constexpr uint32_t UPDATES_PER_SECOND = 60;
+    static constexpr uint32_t MAX_UPDATES_PER_FRAME = 4;
+
 private:
 
+    // [xobt@̎g
+    enum class DepthMode
+    {
+        Standard,           // Near  0AFar  1iLESSANAl 1j
+        ReverseZ,           // Near  1AFar  0iGREATERANAl 0j
+        InfiniteReverseZ,   // Reverse-Z  Far 
+    };
+
+    // [xobt@̎g
+    DepthMode m_depthMode = DepthMode::InfiniteReverseZ;
+
+    // Reverse-Z ̏ꍇ true Ԃ֐
+    bool IsReverseZ() const { return m_depthMode != DepthMode::Standard; }
+
+    // jANbvEt@[Nbvȉꍇ̓t@[͎gpȂj
+    static constexpr float NEAR_PLANE = 0.1f;
+    static constexpr float FAR_PLANE = 100.0f;
+
     // ˉes
     DirectX::SimpleMath::Matrix m_proj;
 
+    // ˉes̎picjƃAXyNg
+    float m_fovY = 0.0f;
+    float m_aspectRatio = 1.0f;
+
     // RXe[g
     std::unique_ptr<DirectX::CommonStates> m_states;
 
@@ -80,27 +175,124 @@ private:
     // fobOJ
     std::unique_ptr<Imase::DebugCamera> m_debugCamera;
 
+    // Oƍ̍XṼJ̏ԁi`̎ɕԂj
+    Imase::InterpolatedState<Imase::DebugCameraState> m_cameraState;
+
+    // ԂJ̏Ԃ̍sƎi`悾ɎgAsbLO̓fobOJ̍̏Ԃōsj
+    Imase::DebugCameraView m_renderCameraView;
+
+    // Oƍ̍XṼCǧi`̎ɕԂj
+    Imase::InterpolatedState<Imase::Math::Vector3> m_lightDirection;
+
+    // ImGui ̃EChE𑀍삵ĂȂꍇ trueifobOJ𓮂ASampleInput œ͂ƈꏏɓnj
+    bool m_isCameraActive = true;
+
     // Obh̏
     std::unique_ptr<Imase::GridFloor> m_gridFloor;
 
-    // 萔obt@̃f[^
-    struct ConstantBufferData
-    {
-        DirectX::XMMATRIX worldViewProjection;  // [hs~r[s~vWFNVs
-        DirectX::XMFLOAT3 lightDirection;       // Cg̕xNg
-    };
+    // fobO̐̒_Xg[̃oCgi_ 1MB   37000 _ACfbNX 256KBj
+    static constexpr uint32_t DEBUG_VERTEX_STREAM_SIZE = 1024 * 1024;
+    static constexpr uint32_t DEBUG_INDEX_STREAM_SIZE = 256 * 1024;
 
-    // 萔obt@
-    Microsoft::WRL::ComPtr<ID3D11Buffer> m_constantBuffer;
+    // fobO̐ƃObh̏t[̊Ԃ߂āAObh̏ƈꏏɂPŕ`悷钸_Xg[
+    // iDX::Draw Ȃǂ̃Xg[łŒǉj
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_debugVertexBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_debugIndexBuffer;
+    Imase::TransientGeometryStream m_debugStream;
 
-    // _obt@̃f[^
-    struct VertexBufferData
-    {
-        DirectX::XMFLOAT3 position;
-        DirectX::XMFLOAT4 color;
-        DirectX::XMFLOAT2 textureCoordinate;
-        DirectX::XMFLOAT3 normal;
-    };
+    // L[{[h̃gbJ[
+    DirectX::Keyboard::KeyboardStateTracker m_keyboardTracker;
+
+    // }EX̃gbJ[
+    DirectX::Mouse::ButtonStateTracker m_mouseTracker;
+
+    // sbLOp BVHi؂̃|Sj
+    Imase::Bvh m_pickingBvh;
+
+    // ENbNŃsbLO
+    Imase::RayHit m_pickingHit = {};
+
+    // sbLOœꍇ true
+    bool m_isPicked = false;
+
+    // J̌oHiF5FL^̊JnEIAF6FĐ̊JnE~j
+    Imase::CameraPath m_cameraPath;
+
+    // J̌oH̍ĐƏԂ̌v
+    Imase::CameraPathPlayer m_cameraPathPlayer;
+
+    // J̌oHL^Ȃ true
+    bool m_isRecordingCameraPath = false;
+
+    // L^JñeBbN
+    uint64_t m_cameraPathStartTicks = 0;
+
+    // J̌oH̃t@C
+    static constexpr const char* CAMERA_PATH_FILE = "CameraPath.bin";
+
+    // Ԃ̌vʂ̃t@C
+    static constexpr const char* CAMERA_PATH_REPORT_FILE = "CameraPathReport.csv";
+
+    // V[̃x`}[Ňvʂ̃t@C
+    static constexpr const char* SCENE_BENCHMARK_REPORT_FILE = "SceneBenchmarkReport.csv";
+
+    // V[̃x`}[NŃIN[WJOvՕ̕ǂ̐
+    static constexpr uint32_t SCENE_BENCHMARK_OCCLUDER_WALLS = 12;
+
+    // L^L[̊Ԋuibj
+    static constexpr float CAMERA_PATH_KEY_INTERVAL = 0.25f;
+
+    // ----- _[L[ ----- //
+
+    // C[iɕ`悷j
+    static constexpr uint32_t LAYER_OPAQUE = 0;         // siVF[_[E}eAj
+    static constexpr uint32_t LAYER_TRANSLUCENT = 1;    // i珇j
+    static constexpr uint32_t LAYER_OVERLAY = 2;        // ʂ̎Oɏd˂镶Ȃ
+
+    // `̎ށi؂ƐX Imase::TreeScene ̕`̎ށj
+    static constexpr uint32_t DRAW_GRID_FLOOR = 0;
+    static constexpr uint32_t DRAW_DEBUG_FONT = 1;
+
+    // _[L[
+    Imase::RenderQueue m_renderQueue;
+
+    // `R}h𔭍sReLXgiDirect3D 11j
+    std::unique_ptr<Imase::D3D11RenderContext> m_renderContext;
+
+    // Xe[g̐ݒȗReLXg̃bp[
+    // iDirectXTK  ImGui ̓bp[ʂȂ̂ŁA` Invalidate j
+    Imase::StateFilteredContext<Imase::IRenderContext> m_stateContext;
+
+    // ؂ƐX̃V[
+    Imase::TreeScene m_treeScene;
+
+    // ----- `R}h̕L^iF7F؂ւj ----- //
+
+    // ɋL^ꍇ̃`N̍ő吔
+    static constexpr uint32_t PARALLEL_RECORDING_CHUNKS = 4;
+
+    // pPbg𕪊ĕɋL^`N̐i0 ̏ꍇ̓C~fBGCgReLXg֒ڕ`悷j
+    uint32_t m_recordingChunkCount = 0;
+
+    // pPbg𕪊ĕɋL^AԂɎs鏈
+    Imase::ParallelRenderExecutor m_parallelExecutor;
+
+    // `NxReLXg֋L^郌R[_[
+    std::unique_ptr<Imase::D3D11DeferredCommandRecorder> m_deferredRecorder;
+
+    // ----- \[Xi؂ƐXj ----- //
+
+    // 萔obt@iXV̕pxŕFt[ƁE؂̃}eAEIuWFNgƁj
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_frameConstantBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_treeMaterialConstantBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_objectConstantBuffer;
+
+    // 萔̃Oobt@̃oCgi256 oCg ~ 256 j
+    static constexpr uint32_t CONSTANT_RING_SIZE = 64 * 1024;
+
+    // `悲Ƃ̒萔l߂ďރOobt@iDirect3D 11.1 ̒萔obt@͈̔͂̎wɑΉĂꍇ̂݁j
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_constantRingBuffer;
+    Imase::ConstantRing m_constantRing;
 
     // _obt@
     Microsoft::WRL::ComPtr<ID3D11Buffer> m_vertexBuffer;
@@ -108,16 +300,25 @@ private:
     // CfbNXobt@
     Microsoft::WRL::ComPtr<ID3D11Buffer> m_indexBuffer;
 
+    // CX^Xp̒_obt@iImase::QuadInstance ̔zj
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_instanceBuffer;
+
     // ----- IA ----- //
 
     // ̓CAEg
     Microsoft::WRL::ComPtr<ID3D11InputLayout> m_inputLayout;
 
+    // ̓CAEgiCX^X`pj
+    Microsoft::WRL::ComPtr<ID3D11InputLayout> m_instancedInputLayout;
+
     // ----- VS ----- //
 
     // _VF[_[
     Microsoft::WRL::ComPtr<ID3D11VertexShader> m_vertexShader;
 
+    // _VF[_[iCX^X`pj
+    Microsoft::WRL::ComPtr<ID3D11VertexShader> m_instancedVertexShader;
+
     // ----- PS ----- //
 
     // sNZVF[_[
@@ -140,4 +341,26 @@ private:
     // ؂̃eNX`nh
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_treeTexture;
 
+    // ----- t[̃pCvCiF8F؂ւj ----- //
+
+    // pCvC̐[it[ N `悵ĂԂɃt[ N + 1 XVj
+    static constexpr uint32_t FRAME_PIPELINE_DEPTH = 2;
+
+    // pCvC̐[i0 ̏ꍇ͓XbhōXVĂ`悷j
+    uint32_t m_pipelineDepth = 0;
+
+    // `悷t[̏ԁipCvC̏ꍇ͐[̐gj
+    FrameSnapshot m_snapshots[Imase::FramePipeline::MAX_DEPTH] = {};
+
+    // ԍ̃XibvVbgXV֓ńiXibvVbgԂOɃCXbhށj
+    FrameInput m_frameInputs[Imase::FramePipeline::MAX_DEPTH] = {};
+
+    // `撆̃t[̏
+    const FrameSnapshot* m_renderSnapshot = nullptr;
+
+    // F8 𒲂ׂL[{[h̃gbJ[im_keyboardTracker ͍XṼXbhgj
+    DirectX::Keyboard::KeyboardStateTracker m_pipelineKeyboardTracker;
+
+    // XV[J[̃XbhōspCvCĩo[ɒ~悤ɍŌɒuj
+    Imase::FramePipeline m_framePipeline;
 };
@@ -0,0 +1,122 @@
+﻿//--------------------------------------------------------------------------------------
+// File: SceneBenchmarkMain.cpp
+//
+// 合成したシーン（TreeScene）の描画の CPU 側の処理時間を、ウインドウと GPU を使わずに計測するプログラム
+//
+// ※ ゲームのフレーム（Game::Tick）は実行しません（詳しくは SceneBenchmark.h）。
+//
+// Usage: SceneBenchmark [フレーム数] [カメラの経路のファイル]
+//        Game::RunSceneBenchmark と同じ設定で、直接描画・並列に記録・パイプラインの３通りを実行し、
+//        処理時間の要約を表示して SceneBenchmarkReport.csv へフレームごとの計測結果を出力します。
+//        カメラの経路のファイルを読み込めない場合は注視点の周りを回るカメラで実行します。
+//        検証でエラーが見つかった場合と、並列に記録・パイプラインの描画が直接描画と
+//        異なる場合は 1 を返します（CI で実行するテストにも使用します）。
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "SceneBenchmark.h"
+
+namespace
+{
+	// Game と同じ設定
+	constexpr uint32_t DEFAULT_FRAME_COUNT = 600;
+	constexpr uint32_t SCREEN_WIDTH = 1280;
+	constexpr uint32_t SCREEN_HEIGHT = 720;
+	constexpr float FOV_Y = 0.785398163f;
+	constexpr float NEAR_PLANE = 0.1f;
+	constexpr float FAR_PLANE = 100.0f;
+	constexpr uint32_t OCCLUDER_WALLS = 12;
+	constexpr uint32_t PARALLEL_RECORDING_CHUNKS = 4;
+	constexpr uint32_t FRAME_PIPELINE_DEPTH = 2;
+
+	constexpr const char* CAMERA_PATH_FILE = "CameraPath.bin";
+	constexpr const char* REPORT_FILE = "SceneBenchmarkReport.csv";
+
+	// 直接描画した場合と描画の回数が同じか調べる関数
+	bool IsSameDraws(const Imase::SceneBenchmarkReport& a, const Imase::SceneBenchmarkReport& b)
+	{
+		return a.renderStats.draws == b.renderStats.draws
+			&& a.renderStats.instances == b.renderStats.instances
+			&& a.renderStats.vertices == b.renderStats.vertices;
+	}
+
+	// フレームあたりの平均
+	double PerFrame(double value, uint32_t frameCount)
+	{
+		return value / std::max(frameCount, 1u);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int frameCount = argc > 1 ? std::atoi(argv[1]) : 0;
+
+	Imase::SceneBenchmarkSettings settings;
+	settings.frameCount = frameCount > 0 ? static_cast<uint32_t>(frameCount) : DEFAULT_FRAME_COUNT;
+	settings.width = SCREEN_WIDTH;
+	settings.height = SCREEN_HEIGHT;
+	settings.fovY = FOV_Y;
+	settings.nearPlane = NEAR_PLANE;
+	settings.farPlane = FAR_PLANE;
+	settings.occluderWalls = OCCLUDER_WALLS;
+
+	// 記録したカメラの経路があれば再生し、なければ注視点の周りを回る
+	Imase::CameraPath cameraPath;
+	if (cameraPath.Load(argc > 2 ? argv[2] : CAMERA_PATH_FILE)) settings.cameraPath = &cameraPath;
+
+	// NullRenderContext へ描画する（コマンドの検証と計測だけを行う）
+	auto loop = std::make_unique<Imase::SceneBenchmark>();
+	const Imase::SceneBenchmarkReport& report = loop->Run(settings);
+	loop->WriteReport(REPORT_FILE);
+
+	const Imase::SceneBenchmarkPhaseStats& frame = report.phases[static_cast<int>(Imase::SceneBenchmarkPhase::Frame)];
+	std::printf("SceneBenchmark: %u frames  frame %.3f ms (min %.3f / max %.3f)  draws %llu  errors %u %.80s\n",
+		report.frameCount,
+		frame.GetAverageSeconds(report.frameCount) * 1000.0, frame.minSeconds * 1000.0, frame.maxSeconds * 1000.0,
+		static_cast<unsigned long long>(report.renderStats.draws),
+		report.renderStats.errors, report.firstError.c_str());
+
+	std::printf("SceneBenchmark: occlusion %.1f / %.1f occluded  %.3f ms\n",
+		PerFrame(static_cast<double>(report.occlusionStats.occludedObjects), report.frameCount),
+		PerFrame(static_cast<double>(report.occlusionStats.testedObjects), report.frameCount),
+		PerFrame(report.occlusionStats.rasterizeSeconds + report.occlusionStats.testSeconds, report.frameCount) * 1000.0);
+
+	// 並列に記録したコマンドリストを再生しても同じ描画になるか調べる
+	settings.recordingChunks = PARALLEL_RECORDING_CHUNKS;
+	auto parallelLoop = std::make_unique<Imase::SceneBenchmark>();
+	const Imase::SceneBenchmarkReport& parallelReport = parallelLoop->Run(settings);
+	bool isSameDraws = IsSameDraws(parallelReport, report);
+
+	std::printf("SceneBenchmark: recorded x%u  chunks %llu  commands %llu  draws %llu (%s)  errors %u\n",
+		PARALLEL_RECORDING_CHUNKS,
+		static_cast<unsigned long long>(parallelReport.recordedChunks),
+		static_cast<unsigned long long>(parallelReport.recordedCommands),
+		static_cast<unsigned long long>(parallelReport.renderStats.draws),
+		isSameDraws ? "same" : "DIFFERENT", parallelReport.renderStats.errors);
+
+	// 次のフレームの更新をワーカーのスレッドで行っても同じ描画になるか調べる
+	settings.recordingChunks = 0;
+	settings.pipelineDepth = FRAME_PIPELINE_DEPTH;
+	auto pipelinedLoop = std::make_unique<Imase::SceneBenchmark>();
+	const Imase::SceneBenchmarkReport& pipelinedReport = pipelinedLoop->Run(settings);
+	bool isSamePipelinedDraws = IsSameDraws(pipelinedReport, report);
+
+	std::printf("SceneBenchmark: pipelined x%u  latency %.3f ms (max %.3f)  draws %llu (%s)  errors %u\n",
+		FRAME_PIPELINE_DEPTH,
+		pipelinedReport.pipelineStats.GetAverageLatencySeconds() * 1000.0,
+		pipelinedReport.pipelineStats.maxLatencySeconds * 1000.0,
+		static_cast<unsigned long long>(pipelinedReport.renderStats.draws),
+		isSamePipelinedDraws ? "same" : "DIFFERENT", pipelinedReport.renderStats.errors);
+
+	// 検証でエラーが見つかった場合と並列に記録・パイプラインの描画が異なる場合は 1 を返す
+	return report.renderStats.errors > 0 || parallelReport.renderStats.errors > 0 || pipelinedReport.renderStats.errors > 0
+		|| !isSameDraws || !isSamePipelinedDraws ? 1 : 0;
+}
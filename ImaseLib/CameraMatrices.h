@@ -0,0 +1,333 @@
+﻿//--------------------------------------------------------------------------------------
+// File: CameraMatrices.h
+//
+// 複数のビュー行列・射影行列をまとめて作成する関数（ヘッダーのみ）
+//
+// Usage: シャドウのカスケードや環境キューブの６面など、１フレームで多数のビュー行列・
+//        射影行列が必要な場合に使用します。
+//        CreateLookAtMatrices / CreatePerspectiveMatrices は SSE2 が使える場合は４つ分の
+//        カメラを __m128 の各要素に割り当て（SoA）、同時に計算します。AVX を有効にして
+//        ビルドした場合（__AVX__）は８つ分を __m256 で計算し、残りを SSE2 で計算します
+//        （FastTrig の配列版と同じくコンパイル時に選ぶ）。端数と SIMD が使えない環境では
+//        Scalar 版で計算します。
+//        Scalar 版は Math::Matrix::CreateLookAt と同じ計算の基準の実装で、テストでは
+//        SIMD 版の結果をこれと比べます。X 軸は両方とも正規化するので、上向きのベクトルが
+//        視線と直交していなくても結果は一致します（丸めの差のみ）。
+//        射影行列の sin / cos は FastTrig で求めます（Imase::CreatePerspectiveMatrix と同じ）。
+//        Windows では Matrix.h の CreateViewMatrices / CreatePerspectiveMatrices から使います。
+//
+//	<<< 記述例 >>
+//	Imase::Math::Matrix views[6];
+//	Imase::Math::CreateLookAtMatrices(eyes, targets, ups, views, 6);
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+
+#include "MathCore.h"
+#include "FastTrig.h"
+
+namespace Imase
+{
+	namespace Math
+	{
+		//------------------------------------------------------------------------------
+		// スカラー版（基準の実装）
+		//------------------------------------------------------------------------------
+
+		// 複数のビュー行列を作成する関数（スカラー版）
+		inline void CreateLookAtMatricesScalar(
+			const Vector3* eyePos, const Vector3* focusPos, const Vector3* upVector, Matrix* views, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				views[i] = Matrix::CreateLookAt(eyePos[i], focusPos[i], upVector[i]);
+			}
+		}
+
+		// 射影行列を１つ作成する関数（FastTrig の sin / cos を使う）
+		inline Matrix CreatePerspectiveFast(float fovY, float aspectRatio, float nearPlane, float farPlane)
+		{
+			float s, c;
+			SinCos(fovY / 2.0f, &s, &c);
+
+			float yScale = c / s;
+			float xScale = yScale / aspectRatio;
+			float range = farPlane / (nearPlane - farPlane);
+			return Matrix(
+				xScale, 0.0f, 0.0f, 0.0f,
+				0.0f, yScale, 0.0f, 0.0f,
+				0.0f, 0.0f, range, -1.0f,
+				0.0f, 0.0f, nearPlane * range, 0.0f);
+		}
+
+		// 複数の射影行列を作成する関数（スカラー版）
+		inline void CreatePerspectiveMatricesScalar(
+			const float* fovY, const float* aspectRatio, const float* nearPlane, const float* farPlane, Matrix* projs, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				projs[i] = CreatePerspectiveFast(fovY[i], aspectRatio[i], nearPlane[i], farPlane[i]);
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		// SIMD 版
+		//------------------------------------------------------------------------------
+
+		// 複数のビュー行列をまとめて作成する関数
+		inline void CreateLookAtMatrices(
+			const Vector3* eyePos, const Vector3* focusPos, const Vector3* upVector, Matrix* views, size_t count)
+		{
+			size_t i = 0;
+#if defined(IMASE_MATH_SSE2)
+			// SoA の各軸と平行移動量を行列の各行へ転置して４つ分を書き込む
+			//   row0 = (RXx RYx RZx 0)
+			//   row1 = (RXy RYy RZy 0)
+			//   row2 = (RXz RYz RZz 0)
+			//   row3 = (-Tx -Ty -Tz 1)
+			auto store4 = [](Matrix* out, const __m128 (&x)[3], const __m128 (&y)[3], const __m128 (&z)[3], const __m128 (&t)[3])
+				{
+					__m128 zero = _mm_setzero_ps();
+					__m128 r0x = x[0], r0y = y[0], r0z = z[0], r0w = zero;
+					__m128 r1x = x[1], r1y = y[1], r1z = z[1], r1w = zero;
+					__m128 r2x = x[2], r2y = y[2], r2z = z[2], r2w = zero;
+					__m128 r3x = t[0], r3y = t[1], r3z = t[2], r3w = _mm_set1_ps(1.0f);
+					_MM_TRANSPOSE4_PS(r0x, r0y, r0z, r0w);
+					_MM_TRANSPOSE4_PS(r1x, r1y, r1z, r1w);
+					_MM_TRANSPOSE4_PS(r2x, r2y, r2z, r2w);
+					_MM_TRANSPOSE4_PS(r3x, r3y, r3z, r3w);
+
+					const __m128 rows[4][4] =
+					{
+						{ r0x, r1x, r2x, r3x },
+						{ r0y, r1y, r2y, r3y },
+						{ r0z, r1z, r2z, r3z },
+						{ r0w, r1w, r2w, r3w },
+					};
+					for (size_t j = 0; j < 4; j++)
+					{
+						for (int row = 0; row < 4; row++)
+						{
+							_mm_storeu_ps(out[j].m[row], rows[j][row]);
+						}
+					}
+				};
+#endif
+#if defined(__AVX__)
+			static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be three packed floats");
+
+			// Vector3 × ８つ（連続した 24 個の float）を x, y, z の SoA 形式へ並べ替えて読み込む
+			auto load8 = [](const Vector3* v, __m256* x, __m256* y, __m256* z)
+				{
+					const float* p = &v[0].x;
+					__m256 m03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 0)), _mm_loadu_ps(p + 12), 1);	// x0 y0 z0 x1 | x4 y4 z4 x5
+					__m256 m14 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);	// y1 z1 x2 y2 | y5 z5 x6 y6
+					__m256 m25 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);	// z2 x3 y3 z3 | z6 x7 y7 z7
+					__m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));	// x2 y2 x3 y3
+					__m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));	// y0 z0 y1 z1
+					*x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+					*y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+					*z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+				};
+
+			// 正規化する（長さが 0 の場合はそのまま、Vector3::Normalize と同じ）
+			auto normalize8 = [](__m256* x, __m256* y, __m256* z)
+				{
+					__m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(*x, *x), _mm256_add_ps(_mm256_mul_ps(*y, *y), _mm256_mul_ps(*z, *z))));
+					__m256 valid = _mm256_cmp_ps(len, _mm256_setzero_ps(), _CMP_GT_OQ);
+					__m256 one = _mm256_set1_ps(1.0f);
+					__m256 inv = _mm256_blendv_ps(one, _mm256_div_ps(one, len), valid);
+					*x = _mm256_mul_ps(*x, inv);
+					*y = _mm256_mul_ps(*y, inv);
+					*z = _mm256_mul_ps(*z, inv);
+				};
+
+			// ８つずつまとめて計算する
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 ex, ey, ez, fx, fy, fz, ux, uy, uz;
+				load8(eyePos + i, &ex, &ey, &ez);
+				load8(focusPos + i, &fx, &fy, &fz);
+				load8(upVector + i, &ux, &uy, &uz);
+
+				// Z軸（カメラの向き）
+				__m256 zx = _mm256_sub_ps(ex, fx);
+				__m256 zy = _mm256_sub_ps(ey, fy);
+				__m256 zz = _mm256_sub_ps(ez, fz);
+				normalize8(&zx, &zy, &zz);
+
+				// X軸 = Up × Z
+				__m256 xx = _mm256_sub_ps(_mm256_mul_ps(uy, zz), _mm256_mul_ps(uz, zy));
+				__m256 xy = _mm256_sub_ps(_mm256_mul_ps(uz, zx), _mm256_mul_ps(ux, zz));
+				__m256 xz = _mm256_sub_ps(_mm256_mul_ps(ux, zy), _mm256_mul_ps(uy, zx));
+				normalize8(&xx, &xy, &xz);
+
+				// Y軸 = Z × X（正規直交なので正規化は不要）
+				__m256 yx = _mm256_sub_ps(_mm256_mul_ps(zy, xz), _mm256_mul_ps(zz, xy));
+				__m256 yy = _mm256_sub_ps(_mm256_mul_ps(zz, xx), _mm256_mul_ps(zx, xz));
+				__m256 yz = _mm256_sub_ps(_mm256_mul_ps(zx, xy), _mm256_mul_ps(zy, xx));
+
+				// 平行移動量（各軸と視点の内積）
+				__m256 zero = _mm256_setzero_ps();
+				__m256 tx = _mm256_sub_ps(zero, _mm256_add_ps(_mm256_mul_ps(xx, ex), _mm256_add_ps(_mm256_mul_ps(xy, ey), _mm256_mul_ps(xz, ez))));
+				__m256 ty = _mm256_sub_ps(zero, _mm256_add_ps(_mm256_mul_ps(yx, ex), _mm256_add_ps(_mm256_mul_ps(yy, ey), _mm256_mul_ps(yz, ez))));
+				__m256 tz = _mm256_sub_ps(zero, _mm256_add_ps(_mm256_mul_ps(zx, ex), _mm256_add_ps(_mm256_mul_ps(zy, ey), _mm256_mul_ps(zz, ez))));
+
+				// 前半と後半の４つずつに分けて転置する
+				const __m128 loX[3] = { _mm256_castps256_ps128(xx), _mm256_castps256_ps128(xy), _mm256_castps256_ps128(xz) };
+				const __m128 loY[3] = { _mm256_castps256_ps128(yx), _mm256_castps256_ps128(yy), _mm256_castps256_ps128(yz) };
+				const __m128 loZ[3] = { _mm256_castps256_ps128(zx), _mm256_castps256_ps128(zy), _mm256_castps256_ps128(zz) };
+				const __m128 loT[3] = { _mm256_castps256_ps128(tx), _mm256_castps256_ps128(ty), _mm256_castps256_ps128(tz) };
+				store4(views + i, loX, loY, loZ, loT);
+
+				const __m128 hiX[3] = { _mm256_extractf128_ps(xx, 1), _mm256_extractf128_ps(xy, 1), _mm256_extractf128_ps(xz, 1) };
+				const __m128 hiY[3] = { _mm256_extractf128_ps(yx, 1), _mm256_extractf128_ps(yy, 1), _mm256_extractf128_ps(yz, 1) };
+				const __m128 hiZ[3] = { _mm256_extractf128_ps(zx, 1), _mm256_extractf128_ps(zy, 1), _mm256_extractf128_ps(zz, 1) };
+				const __m128 hiT[3] = { _mm256_extractf128_ps(tx, 1), _mm256_extractf128_ps(ty, 1), _mm256_extractf128_ps(tz, 1) };
+				store4(views + i + 4, hiX, hiY, hiZ, hiT);
+			}
+#endif
+#if defined(IMASE_MATH_SSE2)
+			// Vector3 × ４つを x, y, z の SoA 形式で読み込む
+			auto load = [](const Vector3* v, __m128* x, __m128* y, __m128* z)
+				{
+					*x = _mm_set_ps(v[3].x, v[2].x, v[1].x, v[0].x);
+					*y = _mm_set_ps(v[3].y, v[2].y, v[1].y, v[0].y);
+					*z = _mm_set_ps(v[3].z, v[2].z, v[1].z, v[0].z);
+				};
+
+			// 正規化する（長さが 0 の場合はそのまま、Vector3::Normalize と同じ）
+			auto normalize = [](__m128* x, __m128* y, __m128* z)
+				{
+					__m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(*x, *x), _mm_add_ps(_mm_mul_ps(*y, *y), _mm_mul_ps(*z, *z))));
+					__m128 valid = _mm_cmpgt_ps(len, _mm_setzero_ps());
+					__m128 inv = _mm_and_ps(valid, _mm_div_ps(_mm_set1_ps(1.0f), len));
+					inv = _mm_or_ps(inv, _mm_andnot_ps(valid, _mm_set1_ps(1.0f)));
+					*x = _mm_mul_ps(*x, inv);
+					*y = _mm_mul_ps(*y, inv);
+					*z = _mm_mul_ps(*z, inv);
+				};
+
+			// ４つずつまとめて計算する（AVX の場合は８つに満たない端数のみ）
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 ex, ey, ez, fx, fy, fz, ux, uy, uz;
+				load(eyePos + i, &ex, &ey, &ez);
+				load(focusPos + i, &fx, &fy, &fz);
+				load(upVector + i, &ux, &uy, &uz);
+
+				// Z軸（カメラの向き）
+				__m128 zx = _mm_sub_ps(ex, fx);
+				__m128 zy = _mm_sub_ps(ey, fy);
+				__m128 zz = _mm_sub_ps(ez, fz);
+				normalize(&zx, &zy, &zz);
+
+				// X軸 = Up × Z
+				__m128 xx = _mm_sub_ps(_mm_mul_ps(uy, zz), _mm_mul_ps(uz, zy));
+				__m128 xy = _mm_sub_ps(_mm_mul_ps(uz, zx), _mm_mul_ps(ux, zz));
+				__m128 xz = _mm_sub_ps(_mm_mul_ps(ux, zy), _mm_mul_ps(uy, zx));
+				normalize(&xx, &xy, &xz);
+
+				// Y軸 = Z × X（正規直交なので正規化は不要）
+				__m128 yx = _mm_sub_ps(_mm_mul_ps(zy, xz), _mm_mul_ps(zz, xy));
+				__m128 yy = _mm_sub_ps(_mm_mul_ps(zz, xx), _mm_mul_ps(zx, xz));
+				__m128 yz = _mm_sub_ps(_mm_mul_ps(zx, xy), _mm_mul_ps(zy, xx));
+
+				// 平行移動量（各軸と視点の内積）
+				__m128 zero = _mm_setzero_ps();
+				__m128 tx = _mm_sub_ps(zero, _mm_add_ps(_mm_mul_ps(xx, ex), _mm_add_ps(_mm_mul_ps(xy, ey), _mm_mul_ps(xz, ez))));
+				__m128 ty = _mm_sub_ps(zero, _mm_add_ps(_mm_mul_ps(yx, ex), _mm_add_ps(_mm_mul_ps(yy, ey), _mm_mul_ps(yz, ez))));
+				__m128 tz = _mm_sub_ps(zero, _mm_add_ps(_mm_mul_ps(zx, ex), _mm_add_ps(_mm_mul_ps(zy, ey), _mm_mul_ps(zz, ez))));
+
+				const __m128 x[3] = { xx, xy, xz };
+				const __m128 y[3] = { yx, yy, yz };
+				const __m128 z[3] = { zx, zy, zz };
+				const __m128 t[3] = { tx, ty, tz };
+				store4(views + i, x, y, z, t);
+			}
+#endif
+			// 端数はスカラー版で計算する
+			CreateLookAtMatricesScalar(eyePos + i, focusPos + i, upVector + i, views + i, count - i);
+		}
+
+		// 複数の射影行列をまとめて作成する関数
+		inline void CreatePerspectiveMatrices(
+			const float* fovY, const float* aspectRatio, const float* nearPlane, const float* farPlane, Matrix* projs, size_t count)
+		{
+			size_t i = 0;
+#if defined(IMASE_MATH_SSE2)
+			// カメラ４つ分の (xScale, yScale, range, offset) を転置して行列を書き込む
+			auto store4 = [](Matrix* out, __m128 xScale, __m128 yScale, __m128 range, __m128 offset)
+				{
+					__m128 p0 = xScale, p1 = yScale, p2 = range, p3 = offset;
+					_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+					const __m128 params[4] = { p0, p1, p2, p3 };
+
+					// 必要な要素だけマスクで取り出して各行を作る（一時配列を経由しない）
+					const __m128 mask0 = _mm_castsi128_ps(_mm_set_epi32(0, 0, 0, -1));
+					const __m128 mask1 = _mm_castsi128_ps(_mm_set_epi32(0, 0, -1, 0));
+					const __m128 mask2 = _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, 0));
+					const __m128 minusW = _mm_set_ps(-1.0f, 0.0f, 0.0f, 0.0f);
+					for (size_t j = 0; j < 4; j++)
+					{
+						__m128 v = params[j];
+						_mm_storeu_ps(out[j].m[0], _mm_and_ps(v, mask0));
+						_mm_storeu_ps(out[j].m[1], _mm_and_ps(v, mask1));
+						_mm_storeu_ps(out[j].m[2], _mm_or_ps(_mm_and_ps(v, mask2), minusW));
+						_mm_storeu_ps(out[j].m[3], _mm_and_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), mask2));
+					}
+				};
+#endif
+#if defined(__AVX__)
+			// ８つずつまとめて計算する
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 n = _mm256_loadu_ps(nearPlane + i);
+				__m256 f = _mm256_loadu_ps(farPlane + i);
+
+				// 余接（コタンジェント）
+				__m256 s, c;
+				SinCos8(_mm256_mul_ps(_mm256_loadu_ps(fovY + i), _mm256_set1_ps(0.5f)), &s, &c);
+				__m256 yScale = _mm256_div_ps(c, s);
+				__m256 xScale = _mm256_div_ps(yScale, _mm256_loadu_ps(aspectRatio + i));
+
+				__m256 range = _mm256_div_ps(f, _mm256_sub_ps(n, f));
+				__m256 offset = _mm256_mul_ps(n, range);
+
+				// 前半と後半の４つずつに分けて転置する
+				store4(projs + i,
+					_mm256_castps256_ps128(xScale), _mm256_castps256_ps128(yScale),
+					_mm256_castps256_ps128(range), _mm256_castps256_ps128(offset));
+				store4(projs + i + 4,
+					_mm256_extractf128_ps(xScale, 1), _mm256_extractf128_ps(yScale, 1),
+					_mm256_extractf128_ps(range, 1), _mm256_extractf128_ps(offset, 1));
+			}
+#endif
+#if defined(IMASE_MATH_SSE2)
+			// ４つずつまとめて計算する（AVX の場合は８つに満たない端数のみ）
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 n = _mm_loadu_ps(nearPlane + i);
+				__m128 f = _mm_loadu_ps(farPlane + i);
+
+				// 余接（コタンジェント）
+				__m128 s, c;
+				SinCos4(_mm_mul_ps(_mm_loadu_ps(fovY + i), _mm_set1_ps(0.5f)), &s, &c);
+				__m128 yScale = _mm_div_ps(c, s);
+				__m128 xScale = _mm_div_ps(yScale, _mm_loadu_ps(aspectRatio + i));
+
+				__m128 range = _mm_div_ps(f, _mm_sub_ps(n, f));
+				__m128 offset = _mm_mul_ps(n, range);
+
+				store4(projs + i, xScale, yScale, range, offset);
+			}
+#endif
+			// 端数はスカラー版で計算する
+			CreatePerspectiveMatricesScalar(fovY + i, aspectRatio + i, nearPlane + i, farPlane + i, projs + i, count - i);
+		}
+	}
+}
@@ -0,0 +1,239 @@
+﻿//--------------------------------------------------------------------------------------
+// File: CameraPath.cpp
+//
+// カメラの移動経路を記録・再生するクラス
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "CameraPath.h"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace Imase;
+
+namespace
+{
+	// 読み込めるキーの最大数（壊れたファイル対策）
+	constexpr uint32_t MAX_KEYS = 1 << 20;
+
+	// ファイルのヘッダー
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t keyCount;
+	};
+
+	// Catmull-Rom スプライン
+	inline float CatmullRom(float p0, float p1, float p2, float p3, float t)
+	{
+		float t2 = t * t;
+		float t3 = t2 * t;
+		return 0.5f * ((2.0f * p1)
+			+ (-p0 + p2) * t
+			+ (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2
+			+ (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// CameraPath
+//--------------------------------------------------------------------------------------
+
+bool CameraPath::AddKey(const CameraPathKey& key)
+{
+	if (!m_keys.empty() && key.time <= m_keys.back().time) return false;
+
+	m_keys.push_back(key);
+
+	return true;
+}
+
+bool CameraPath::Record(const CameraPathKey& key, float interval)
+{
+	if (!m_keys.empty() && key.time - m_keys.back().time < interval) return false;
+
+	return AddKey(key);
+}
+
+size_t CameraPath::GetSegmentIndex(float time) const
+{
+	if (m_keys.size() < 2) return 0;
+
+	// time より後の最初のキーを探す
+	auto it = std::upper_bound(m_keys.begin(), m_keys.end(), time,
+		[](float t, const CameraPathKey& key) { return t < key.time; });
+
+	size_t index = static_cast<size_t>(it - m_keys.begin());
+
+	return std::min(std::max(index, size_t(1)), m_keys.size() - 1) - 1;
+}
+
+CameraPathKey CameraPath::Evaluate(float time) const
+{
+	if (m_keys.empty()) return CameraPathKey{ time, 0.0f, 0.0f, 0.0f };
+	if (m_keys.size() == 1 || time <= m_keys.front().time)
+	{
+		CameraPathKey key = m_keys.front();
+		key.time = time;
+		return key;
+	}
+	if (time >= m_keys.back().time)
+	{
+		CameraPathKey key = m_keys.back();
+		key.time = time;
+		return key;
+	}
+
+	size_t i = GetSegmentIndex(time);
+
+	// 区間の前後のキー（端は同じキーを使う）
+	const CameraPathKey& k0 = m_keys[i > 0 ? i - 1 : 0];
+	const CameraPathKey& k1 = m_keys[i];
+	const CameraPathKey& k2 = m_keys[i + 1];
+	const CameraPathKey& k3 = m_keys[std::min(i + 2, m_keys.size() - 1)];
+
+	float t = (time - k1.time) / (k2.time - k1.time);
+
+	CameraPathKey key;
+	key.time = time;
+	key.yaw = CatmullRom(k0.yaw, k1.yaw, k2.yaw, k3.yaw, t);
+	key.pitch = CatmullRom(k0.pitch, k1.pitch, k2.pitch, k3.pitch, t);
+	key.distance = CatmullRom(k0.distance, k1.distance, k2.distance, k3.distance, t);
+
+	return key;
+}
+
+bool CameraPath::Save(const char* fileName) const
+{
+	std::ofstream ofs(fileName, std::ios::binary);
+	if (!ofs) return false;
+
+	FileHeader header = { FILE_MAGIC, static_cast<uint32_t>(m_keys.size()) };
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	if (!m_keys.empty())
+	{
+		ofs.write(reinterpret_cast<const char*>(m_keys.data()), sizeof(CameraPathKey) * m_keys.size());
+	}
+
+	return static_cast<bool>(ofs);
+}
+
+bool CameraPath::Load(const char* fileName)
+{
+	std::ifstream ifs(fileName, std::ios::binary);
+	if (!ifs) return false;
+
+	FileHeader header = {};
+	ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!ifs || header.magic != FILE_MAGIC || header.keyCount > MAX_KEYS) return false;
+
+	std::vector<CameraPathKey> keys(header.keyCount);
+	if (!keys.empty())
+	{
+		ifs.read(reinterpret_cast<char*>(keys.data()), sizeof(CameraPathKey) * keys.size());
+		if (!ifs) return false;
+	}
+
+	// 時間順に並んでいるか確認する
+	for (size_t i = 1; i < keys.size(); i++)
+	{
+		if (!(keys[i - 1].time < keys[i].time)) return false;
+	}
+
+	m_keys.swap(keys);
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// CameraPathPlayer
+//--------------------------------------------------------------------------------------
+
+void CameraPathPlayer::Start(const CameraPath& path, uint64_t ticksPerFrame, uint64_t ticksPerSecond)
+{
+	m_path = path.GetKeyCount() >= 2 ? &path : nullptr;
+	m_ticksPerFrame = ticksPerFrame;
+	m_ticksPerSecond = ticksPerSecond ? ticksPerSecond : 1;
+	m_frame = 0;
+	m_lastSegment = -1;
+
+	m_segmentStats.assign(path.GetSegmentCount(), CameraPathSegmentStats());
+	m_frameTimings.clear();
+}
+
+bool CameraPathPlayer::Advance(double frameSeconds, CameraPathKey* key)
+{
+	if (!m_path) return false;
+
+	// 直前のフレームの処理時間を記録する
+	AddFrameTime(frameSeconds);
+
+	// 経過時間はフレーム数から求めるので、実行速度に関係なく同じ値になる
+	uint64_t ticks = m_frame * m_ticksPerFrame;
+	double time = m_path->GetStartTime()
+		+ static_cast<double>(ticks / m_ticksPerSecond)
+		+ static_cast<double>(ticks % m_ticksPerSecond) / static_cast<double>(m_ticksPerSecond);
+
+	if (time > m_path->GetEndTime())
+	{
+		m_lastSegment = -1;
+		Stop();
+		return false;
+	}
+
+	*key = m_path->Evaluate(static_cast<float>(time));
+	m_lastSegment = static_cast<int64_t>(m_path->GetSegmentIndex(key->time));
+	m_frame++;
+
+	return true;
+}
+
+void CameraPathPlayer::AddFrameTime(double frameSeconds)
+{
+	if (m_lastSegment < 0) return;
+
+	CameraPathSegmentStats& stats = m_segmentStats[static_cast<size_t>(m_lastSegment)];
+	if (stats.frameCount == 0)
+	{
+		stats.minSeconds = stats.maxSeconds = frameSeconds;
+	}
+	else
+	{
+		stats.minSeconds = std::min(stats.minSeconds, frameSeconds);
+		stats.maxSeconds = std::max(stats.maxSeconds, frameSeconds);
+	}
+	stats.totalSeconds += frameSeconds;
+	stats.frameCount++;
+
+	m_frameTimings.push_back({ static_cast<uint32_t>(m_lastSegment), frameSeconds });
+}
+
+bool CameraPathPlayer::WriteReport(const char* fileName) const
+{
+	std::ofstream ofs(fileName);
+	if (!ofs) return false;
+
+	// 区間ごとの集計
+	ofs << "segment,frames,average_ms,min_ms,max_ms\n";
+	for (size_t i = 0; i < m_segmentStats.size(); i++)
+	{
+		const CameraPathSegmentStats& stats = m_segmentStats[i];
+		ofs << i << ',' << stats.frameCount << ','
+			<< stats.GetAverageSeconds() * 1000.0 << ','
+			<< stats.minSeconds * 1000.0 << ','
+			<< stats.maxSeconds * 1000.0 << '\n';
+	}
+
+	// フレームごとの処理時間
+	ofs << "\nframe,segment,ms\n";
+	for (size_t i = 0; i < m_frameTimings.size(); i++)
+	{
+		ofs << i << ',' << m_frameTimings[i].segment << ',' << m_frameTimings[i].seconds * 1000.0 << '\n';
+	}
+
+	return static_cast<bool>(ofs);
+}
@@ -0,0 +1,224 @@
+﻿//--------------------------------------------------------------------------------------
+// File: CameraPath.h
+//
+// カメラの移動経路を記録・再生するクラス
+//
+// Usage: デバッグカメラの状態（時間・横回転・縦回転・距離）をキーとして記録し、
+//        バイナリファイルへ保存・読み込みできます。
+//        再生は１フレームあたり固定のティック数で時間を進めるので、実行速度に関係なく
+//        毎回同じフレームで同じカメラ位置になります（ビルド間の処理時間の比較用）。
+//        再生中は区間（キーとキーの間）ごとにフレームの処理時間を集計します。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	// 記録
+//	path.Record(key, 0.25f);
+//	path.Save("CameraPath.bin");
+//
+//	// 再生
+//	player.Start(path, DX::StepTimer::TicksPerSecond / 60, DX::StepTimer::TicksPerSecond);
+//	Imase::CameraPathKey key;
+//	if (player.Advance(timer.GetFrameElapsedSeconds(), &key))
+//	{
+//		debugCamera->SetState(key.yaw, key.pitch, key.distance);
+//	}
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Imase
+{
+	// カメラの経路のキー
+	struct CameraPathKey
+	{
+		// 時間（秒）
+		float time;
+
+		// 横回転（ラジアン）
+		float yaw;
+
+		// 縦回転（ラジアン）
+		float pitch;
+
+		// 注視点からの距離
+		float distance;
+	};
+
+	// カメラの経路
+	class CameraPath
+	{
+	public:
+
+		// ファイルの識別子
+		static constexpr uint32_t FILE_MAGIC = 0x31504349;	// 'ICP1'
+
+		// キーを全て削除する関数
+		void Clear() { m_keys.clear(); }
+
+		/// <summary>
+		/// キーを追加する関数（時間は前のキーより後である必要がある）
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <returns>追加した場合は true</returns>
+		bool AddKey(const CameraPathKey& key);
+
+		/// <summary>
+		/// 記録用のキーの追加関数（前のキーから interval 秒以上経過している場合だけ追加する）
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <param name="interval">キーの最小間隔（秒）</param>
+		/// <returns>追加した場合は true</returns>
+		bool Record(const CameraPathKey& key, float interval);
+
+		/// <summary>
+		/// 指定時間のカメラの状態を求める関数（Catmull-Rom スプラインで補間）
+		/// </summary>
+		/// <param name="time">時間（秒）</param>
+		/// <returns>カメラの状態</returns>
+		CameraPathKey Evaluate(float time) const;
+
+		/// <summary>
+		/// 指定時間が含まれる区間の番号を求める関数
+		/// </summary>
+		/// <param name="time">時間（秒）</param>
+		/// <returns>区間の番号（0 ～ GetSegmentCount() - 1）</returns>
+		size_t GetSegmentIndex(float time) const;
+
+		// 区間の数を取得する関数
+		size_t GetSegmentCount() const { return m_keys.size() > 1 ? m_keys.size() - 1 : 0; }
+
+		// キーの数を取得する関数
+		size_t GetKeyCount() const { return m_keys.size(); }
+
+		// キーを取得する関数
+		const CameraPathKey& GetKey(size_t index) const { return m_keys[index]; }
+
+		// 開始時間を取得する関数
+		float GetStartTime() const { return m_keys.empty() ? 0.0f : m_keys.front().time; }
+
+		// 終了時間を取得する関数
+		float GetEndTime() const { return m_keys.empty() ? 0.0f : m_keys.back().time; }
+
+		/// <summary>
+		/// バイナリファイルへ保存する関数
+		/// </summary>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns>成功した場合は true</returns>
+		bool Save(const char* fileName) const;
+
+		/// <summary>
+		/// バイナリファイルから読み込む関数（失敗した場合は内容は変わらない）
+		/// </summary>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns>成功した場合は true</returns>
+		bool Load(const char* fileName);
+
+	private:
+
+		// キーの配列（時間順）
+		std::vector<CameraPathKey> m_keys;
+	};
+
+	// 区間ごとのフレームの処理時間の集計
+	struct CameraPathSegmentStats
+	{
+		// フレーム数
+		uint32_t frameCount = 0;
+
+		// 処理時間の合計・最小・最大（秒）
+		double totalSeconds = 0.0;
+		double minSeconds = 0.0;
+		double maxSeconds = 0.0;
+
+		// 平均の処理時間を取得する関数（秒）
+		double GetAverageSeconds() const { return frameCount ? totalSeconds / frameCount : 0.0; }
+	};
+
+	// カメラの経路の再生と処理時間の計測を行うクラス
+	class CameraPathPlayer
+	{
+	public:
+
+		// フレームごとの計測結果
+		struct FrameTiming
+		{
+			// 区間の番号
+			uint32_t segment;
+
+			// 処理時間（秒）
+			double seconds;
+		};
+
+		/// <summary>
+		/// 再生を開始する関数
+		/// </summary>
+		/// <param name="path">カメラの経路（再生中は変更しないこと）</param>
+		/// <param name="ticksPerFrame">１フレームで進めるティック数</param>
+		/// <param name="ticksPerSecond">１秒あたりのティック数</param>
+		void Start(const CameraPath& path, uint64_t ticksPerFrame, uint64_t ticksPerSecond);
+
+		// 再生を停止する関数（計測結果は残る）
+		void Stop() { m_path = nullptr; }
+
+		// 再生中か調べる関数
+		bool IsPlaying() const { return m_path != nullptr; }
+
+		/// <summary>
+		/// １フレーム進める関数
+		/// </summary>
+		/// <param name="frameSeconds">直前のフレームの処理時間（秒、直前のフレームの区間に加算される）</param>
+		/// <param name="key">このフレームのカメラの状態の出力先</param>
+		/// <returns>経路の最後まで再生した場合は false（再生は停止する）</returns>
+		bool Advance(double frameSeconds, CameraPathKey* key);
+
+		// 再生中のフレーム番号を取得する関数
+		uint64_t GetFrame() const { return m_frame; }
+
+		// 区間ごとの集計結果を取得する関数
+		const std::vector<CameraPathSegmentStats>& GetSegmentStats() const { return m_segmentStats; }
+
+		// フレームごとの計測結果を取得する関数
+		const std::vector<FrameTiming>& GetFrameTimings() const { return m_frameTimings; }
+
+		/// <summary>
+		/// 計測結果を CSV ファイルへ出力する関数
+		/// </summary>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns>成功した場合は true</returns>
+		bool WriteReport(const char* fileName) const;
+
+	private:
+
+		// 直前のフレームの処理時間を記録する関数
+		void AddFrameTime(double frameSeconds);
+
+	private:
+
+		// 再生中の経路
+		const CameraPath* m_path = nullptr;
+
+		// １フレームのティック数
+		uint64_t m_ticksPerFrame = 0;
+
+		// １秒あたりのティック数
+		uint64_t m_ticksPerSecond = 1;
+
+		// 再生中のフレーム番号
+		uint64_t m_frame = 0;
+
+		// 直前のフレームの区間の番号（-1の場合はなし）
+		int64_t m_lastSegment = -1;
+
+		// 区間ごとの集計結果
+		std::vector<CameraPathSegmentStats> m_segmentStats;
+
+		// フレームごとの計測結果
+		std::vector<FrameTiming> m_frameTimings;
+	};
+}
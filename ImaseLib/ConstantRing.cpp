@@ -0,0 +1,183 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ConstantRing.cpp
+//
+// フレームごとの定数を大きな１つの定数バッファへ詰めて書き込むリングバッファ
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "ConstantRing.h"
+
+#include <cstring>
+
+using namespace Imase;
+
+//--------------------------------------------------------------------------------------
+// 空にして容量を設定する関数
+//--------------------------------------------------------------------------------------
+void ConstantRingAllocator::Reset(uint32_t capacity)
+{
+	m_capacity = capacity & ~(ALIGNMENT - 1);
+	m_head = 0;
+	m_tail = 0;
+	m_usedBytes = 0;
+	m_frameBytes = 0;
+	m_frameBegin = 0;
+	m_frameCount = 0;
+}
+
+//--------------------------------------------------------------------------------------
+// 領域を確保する関数
+//--------------------------------------------------------------------------------------
+bool ConstantRingAllocator::Allocate(uint32_t size, uint32_t* offset, bool* wrapped)
+{
+	if (wrapped) *wrapped = false;
+
+	uint32_t alignedSize = AlignUp(size > 0 ? size : 1);
+	if (alignedSize > m_capacity - m_usedBytes)
+	{
+		m_stats.failures++;
+		return false;
+	}
+
+	// 何も使用していない場合は先頭から使う（使用中の範囲が分かれないようにする）
+	if (m_usedBytes == 0) m_head = m_tail = 0;
+
+	uint32_t skipped = 0;
+	if (m_head >= m_tail && m_usedBytes < m_capacity)
+	{
+		// 使用中の範囲は [tail, head)、空きは [head, capacity) と [0, tail)
+		if (alignedSize > m_capacity - m_head)
+		{
+			// 末尾に入らない場合は末尾を使わずに先頭へ戻る（末尾はこのフレームの範囲に含めて後で再利用する）
+			if (alignedSize > m_tail)
+			{
+				m_stats.failures++;
+				return false;
+			}
+			skipped = m_capacity - m_head;
+			m_head = 0;
+			m_stats.wraps++;
+			if (wrapped) *wrapped = true;
+		}
+	}
+	else if (alignedSize > m_tail - m_head)
+	{
+		// 空きは [head, tail) だけ
+		m_stats.failures++;
+		return false;
+	}
+
+	*offset = m_head;
+	m_head += alignedSize;
+	if (m_head == m_capacity)
+	{
+		// ちょうど最後まで使った場合も先頭へ戻る
+		m_head = 0;
+		m_stats.wraps++;
+	}
+
+	m_usedBytes += skipped + alignedSize;
+	m_frameBytes += skipped + alignedSize;
+
+	m_stats.allocations++;
+	m_stats.allocatedBytes += alignedSize;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// フレームの終わりに呼ぶ関数
+//--------------------------------------------------------------------------------------
+void ConstantRingAllocator::EndFrame(uint64_t fence)
+{
+	if (m_frameCount == MAX_FRAMES_IN_FLIGHT)
+	{
+		// 覚えきれない場合は最後のフレームへまとめる（再利用が遅くなるだけで安全）
+		FrameRecord& last = m_frames[(m_frameBegin + m_frameCount - 1) % MAX_FRAMES_IN_FLIGHT];
+		last.fence = fence;
+		last.size += m_frameBytes;
+	}
+	else
+	{
+		m_frames[(m_frameBegin + m_frameCount) % MAX_FRAMES_IN_FLIGHT] = { fence, m_frameBytes };
+		m_frameCount++;
+	}
+	m_frameBytes = 0;
+}
+
+//--------------------------------------------------------------------------------------
+// GPU が使い終わったフレームの範囲を再利用できるようにする関数
+//--------------------------------------------------------------------------------------
+void ConstantRingAllocator::Retire(uint64_t completedFence)
+{
+	while (m_frameCount > 0)
+	{
+		const FrameRecord& frame = m_frames[m_frameBegin];
+		if (frame.fence > completedFence) break;
+
+		// フレームの範囲は確保した順に並んでいるので、先頭の位置を進めるだけ
+		m_tail += frame.size;
+		if (m_tail >= m_capacity) m_tail -= m_capacity;
+		m_usedBytes -= frame.size;
+
+		m_frameBegin = (m_frameBegin + 1) % MAX_FRAMES_IN_FLIGHT;
+		m_frameCount--;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 書き込むバッファを設定する関数
+//--------------------------------------------------------------------------------------
+void ConstantRing::Initialize(RenderBuffer* buffer, uint32_t capacity)
+{
+	m_buffer = buffer;
+	m_allocator.Reset(buffer ? capacity : 0);
+	m_allocator.ResetStats();
+	m_frame = 0;
+	m_discard = true;
+}
+
+//--------------------------------------------------------------------------------------
+// フレームの最初に呼ぶ関数
+//--------------------------------------------------------------------------------------
+void ConstantRing::BeginFrame()
+{
+	if (m_frame > 0) m_allocator.EndFrame(m_frame);
+	m_frame++;
+
+	// GPU は FRAME_LATENCY フレームまで遅れるので、それより前のフレームは使い終わっている
+	if (m_frame > FRAME_LATENCY + 1) m_allocator.Retire(m_frame - FRAME_LATENCY - 1);
+}
+
+//--------------------------------------------------------------------------------------
+// 定数を書き込む関数
+//--------------------------------------------------------------------------------------
+bool ConstantRing::Write(IRenderContext* context, const void* data, uint32_t size, ConstantRingRange* range)
+{
+	if (!m_buffer || size > 4096 * 16) return false;
+
+	uint32_t offset;
+	if (!m_allocator.Allocate(size, &offset)) return false;
+
+	// GPU が使用中の範囲は確保されないので、上書きしないことを約束して Map する（バッファの名前の付け替えが起きない）
+	RenderMap mapType = m_discard ? RenderMap::WriteDiscard : RenderMap::WriteNoOverwrite;
+
+	uint8_t* mapped = static_cast<uint8_t*>(context->Map(m_buffer, mapType));
+	if (!mapped) return false;
+
+	memcpy(mapped + offset, data, size);
+	context->Unmap(m_buffer);
+
+	ConstantRingStats& stats = m_allocator.GetMutableStats();
+	stats.maps++;
+	if (mapType == RenderMap::WriteDiscard) stats.discards++;
+	m_discard = false;
+
+	range->firstConstant = offset / 16;
+	range->numConstants = ConstantRingAllocator::AlignUp(size) / 16;
+
+	return true;
+}
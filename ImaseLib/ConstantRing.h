@@ -0,0 +1,219 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ConstantRing.h
+//
+// フレームごとの定数を大きな１つの定数バッファへ詰めて書き込むリングバッファ
+//
+// Usage: ConstantRingAllocator はバッファの中の位置だけを扱うアロケーターです。
+//        Allocate は 256 バイト単位（VSSetConstantBuffers1 で指定できる単位）で先頭から順に
+//        領域を確保し、最後まで使ったら先頭へ戻ります。EndFrame でそのフレームに確保した
+//        範囲をフェンスの値と一緒に覚えておき、GPU が使い終わったフェンスの値を Retire に
+//        渡すとその範囲が再利用できるようになります。使用中のフレームの範囲まで追いついた
+//        場合は確保に失敗します（呼び出し側は別の方法で定数を渡してください）。
+//        ConstantRing は IRenderContext のバッファへ書き込むクラスで、確保した位置だけを
+//        WriteNoOverwrite で Map して書き込み、VSSetConstantBuffers1 で設定する範囲を返します。
+//        最初の書き込みだけは WriteDiscard で Map します。フェンスはフレーム番号で、
+//        GPU は FRAME_LATENCY フレームまで遅れるものとして、それより前のフレームの範囲を
+//        再利用します。フェンスは使わないので、デバイスの最大フレーム遅延
+//        （IDXGIDevice1::SetMaximumFrameLatency）を FRAME_LATENCY に設定してください。
+//        同じフレームの前の書き込みを描画に使うので、先頭へ戻る時も WriteDiscard にはしません。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	// 初期化（バッファは CPU から書き込める定数バッファ）
+//	m_constantRing.Initialize(constantRingBuffer, 64 * 1024);
+//
+//	// フレームの最初
+//	m_constantRing.BeginFrame();
+//
+//	// 描画ごとの定数
+//	Imase::ConstantRingRange range;
+//	if (m_constantRing.Write(context, &data, sizeof(data), &range))
+//	{
+//		context->VSSetConstantBuffers1(0, 1, &buffer, &range.firstConstant, &range.numConstants);
+//	}
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "RenderContext.h"
+
+namespace Imase
+{
+	// リングバッファの計測結果
+	struct ConstantRingStats
+	{
+		// 確保した回数とバイト数（256 バイト単位に揃えたバイト数）
+		uint32_t allocations;
+		uint64_t allocatedBytes;
+
+		// 最後まで使って先頭へ戻った回数
+		uint32_t wraps;
+
+		// 空きが足りずに確保できなかった回数
+		uint32_t failures;
+
+		// Map した回数と、そのうち WriteDiscard で Map した回数
+		uint32_t maps;
+		uint32_t discards;
+	};
+
+	// バッファの中の位置だけを扱うリングバッファのアロケーター
+	class ConstantRingAllocator
+	{
+	public:
+
+		// 確保する単位（VSSetConstantBuffers1 の先頭の位置と定数の数は 16 定数 = 256 バイト単位）
+		static constexpr uint32_t ALIGNMENT = 256;
+
+		// 覚えておける GPU が使用中のフレームの数（超えた場合は最後のフレームへまとめる）
+		static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 8;
+
+		// 256 バイト単位に揃えたバイト数を求める関数
+		static constexpr uint32_t AlignUp(uint32_t size) { return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+		ConstantRingAllocator() = default;
+
+		// 空にして容量を設定する関数（容量は 256 バイト単位に切り捨てる）
+		void Reset(uint32_t capacity);
+
+		/// <summary>
+		/// 領域を確保する関数
+		/// </summary>
+		/// <param name="size">バイト数</param>
+		/// <param name="offset">確保した領域の先頭の位置（バイト）の出力先</param>
+		/// <param name="wrapped">先頭へ戻った場合は true の出力先（nullptr 可）</param>
+		/// <returns>確保できた場合は true</returns>
+		bool Allocate(uint32_t size, uint32_t* offset, bool* wrapped = nullptr);
+
+		// フレームの終わりに呼ぶ関数（このフレームで確保した範囲はフェンスが完了するまで再利用しない）
+		void EndFrame(uint64_t fence);
+
+		// GPU が使い終わったフェンスの値までのフレームの範囲を再利用できるようにする関数
+		void Retire(uint64_t completedFence);
+
+		// 容量を取得する関数
+		uint32_t GetCapacity() const { return m_capacity; }
+
+		// 使用中のバイト数を取得する関数（GPU が使用中のフレームと現在のフレームの合計）
+		uint32_t GetUsedBytes() const { return m_usedBytes; }
+
+		// GPU が使用中のフレームの数を取得する関数
+		uint32_t GetFramesInFlight() const { return m_frameCount; }
+
+		// 計測結果を取得する関数
+		const ConstantRingStats& GetStats() const { return m_stats; }
+
+		// 計測結果を 0 に戻す関数
+		void ResetStats() { m_stats = {}; }
+
+		// 計測結果を書き換える関数（ConstantRing が Map の回数を数えるために使う）
+		ConstantRingStats& GetMutableStats() { return m_stats; }
+
+	private:
+
+		// フレームごとの確保した範囲
+		struct FrameRecord
+		{
+			// フェンスの値
+			uint64_t fence;
+
+			// 確保したバイト数（先頭へ戻った時に使わなかった末尾を含む）
+			uint32_t size;
+		};
+
+	private:
+
+		// 容量
+		uint32_t m_capacity = 0;
+
+		// 次に確保する位置と、使用中の範囲の先頭の位置
+		uint32_t m_head = 0;
+		uint32_t m_tail = 0;
+
+		// 使用中のバイト数
+		uint32_t m_usedBytes = 0;
+
+		// 現在のフレームで確保したバイト数
+		uint32_t m_frameBytes = 0;
+
+		// GPU が使用中のフレーム（古い順、m_frames[m_frameBegin] から m_frameCount 個）
+		FrameRecord m_frames[MAX_FRAMES_IN_FLIGHT] = {};
+		uint32_t m_frameBegin = 0;
+		uint32_t m_frameCount = 0;
+
+		// 計測結果
+		ConstantRingStats m_stats = {};
+	};
+
+	// VSSetConstantBuffers1 で設定する範囲（16 バイトの定数の単位）
+	struct ConstantRingRange
+	{
+		uint32_t firstConstant;
+		uint32_t numConstants;
+	};
+
+	// IRenderContext のバッファへ書き込む定数のリングバッファ
+	class ConstantRing
+	{
+	public:
+
+		// GPU が遅れる最大のフレーム数（これより前のフレームは GPU が使い終わっている、デバイスの最大フレーム遅延と同じ値にする）
+		static constexpr uint64_t FRAME_LATENCY = 3;
+
+		ConstantRing() = default;
+
+		/// <summary>
+		/// 書き込むバッファを設定する関数
+		/// </summary>
+		/// <param name="buffer">CPU から書き込める定数バッファ（nullptr の場合は使わない）</param>
+		/// <param name="capacity">バッファのバイト数</param>
+		void Initialize(RenderBuffer* buffer, uint32_t capacity);
+
+		// バッファを設定したか調べる関数
+		bool IsValid() const { return m_buffer != nullptr; }
+
+		// バッファを取得する関数
+		RenderBuffer* GetBuffer() const { return m_buffer; }
+
+		// フレームの最初に呼ぶ関数（前のフレームを終わらせて、古いフレームの範囲を再利用する）
+		void BeginFrame();
+
+		/// <summary>
+		/// 定数を書き込む関数
+		/// </summary>
+		/// <param name="context">Map するコンテキスト（イミディエイトコンテキスト）</param>
+		/// <param name="data">書き込むデータ</param>
+		/// <param name="size">バイト数（4096 定数 = 65536 バイト以下）</param>
+		/// <param name="range">VSSetConstantBuffers1 で設定する範囲の出力先</param>
+		/// <returns>書き込めた場合は true</returns>
+		bool Write(IRenderContext* context, const void* data, uint32_t size, ConstantRingRange* range);
+
+		// アロケーターを取得する関数
+		const ConstantRingAllocator& GetAllocator() const { return m_allocator; }
+
+		// 計測結果を取得する関数
+		const ConstantRingStats& GetStats() const { return m_allocator.GetStats(); }
+
+		// 計測結果を 0 に戻す関数
+		void ResetStats() { m_allocator.ResetStats(); }
+
+	private:
+
+		// バッファ
+		RenderBuffer* m_buffer = nullptr;
+
+		// 位置を扱うアロケーター
+		ConstantRingAllocator m_allocator;
+
+		// フレーム番号（0 はまだフレームを始めていない）
+		uint64_t m_frame = 0;
+
+		// 次の Map を WriteDiscard にする場合は true（最初の書き込みのみ）
+		bool m_discard = true;
+	};
+}
@@ -0,0 +1,241 @@
+﻿//--------------------------------------------------------------------------------------
+// File: D3D11RenderContext.cpp
+//
+// IRenderContext の Direct3D 11 の実装
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "D3D11RenderContext.h"
+
+using namespace Imase;
+
+namespace
+{
+	// ハンドルを Direct3D 11 のリソースへ戻す関数
+	template <class T, class Handle>
+	inline T* ToD3D(Handle* handle) { return reinterpret_cast<T*>(handle); }
+
+	// ハンドルの配列を Direct3D 11 のリソースの配列として扱う関数（どちらもポインタの配列）
+	template <class T, class Handle>
+	inline T* const* ToD3D(Handle* const* handles) { return reinterpret_cast<T* const*>(handles); }
+}
+
+//--------------------------------------------------------------------------------------
+// コンストラクタ
+//--------------------------------------------------------------------------------------
+D3D11RenderContext::D3D11RenderContext(ID3D11DeviceContext* context)
+	: m_context(context)
+{
+	context->QueryInterface(IID_PPV_ARGS(m_context1.ReleaseAndGetAddressOf()));
+}
+
+//--------------------------------------------------------------------------------------
+// IA
+//--------------------------------------------------------------------------------------
+void D3D11RenderContext::IASetInputLayout(RenderInputLayout* inputLayout)
+{
+	m_context->IASetInputLayout(ToD3D<ID3D11InputLayout>(inputLayout));
+}
+
+void D3D11RenderContext::IASetPrimitiveTopology(RenderTopology topology)
+{
+	m_context->IASetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(topology));
+}
+
+void D3D11RenderContext::IASetIndexBuffer(RenderBuffer* buffer, RenderIndexFormat format, uint32_t offset)
+{
+	m_context->IASetIndexBuffer(ToD3D<ID3D11Buffer>(buffer), static_cast<DXGI_FORMAT>(format), offset);
+}
+
+void D3D11RenderContext::IASetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets)
+{
+	m_context->IASetVertexBuffers(startSlot, numBuffers, ToD3D<ID3D11Buffer>(buffers), strides, offsets);
+}
+
+//--------------------------------------------------------------------------------------
+// VS
+//--------------------------------------------------------------------------------------
+void D3D11RenderContext::VSSetShader(RenderVertexShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances)
+{
+	m_context->VSSetShader(ToD3D<ID3D11VertexShader>(shader), ToD3D<ID3D11ClassInstance>(classInstances), numClassInstances);
+}
+
+void D3D11RenderContext::VSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers)
+{
+	m_context->VSSetConstantBuffers(startSlot, numBuffers, ToD3D<ID3D11Buffer>(buffers));
+}
+
+void D3D11RenderContext::VSSetConstantBuffers1(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers,
+	const uint32_t* firstConstants, const uint32_t* numConstants)
+{
+	// Direct3D 11.1 に対応していない場合は範囲を指定できない（呼び出し側で対応を確認すること）
+	if (!m_context1) return;
+
+	m_context1->VSSetConstantBuffers1(startSlot, numBuffers, ToD3D<ID3D11Buffer>(buffers), firstConstants, numConstants);
+}
+
+//--------------------------------------------------------------------------------------
+// RS
+//--------------------------------------------------------------------------------------
+void D3D11RenderContext::RSSetState(RenderRasterizerState* rasterizerState)
+{
+	m_context->RSSetState(ToD3D<ID3D11RasterizerState>(rasterizerState));
+}
+
+//--------------------------------------------------------------------------------------
+// PS
+//--------------------------------------------------------------------------------------
+void D3D11RenderContext::PSSetShader(RenderPixelShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances)
+{
+	m_context->PSSetShader(ToD3D<ID3D11PixelShader>(shader), ToD3D<ID3D11ClassInstance>(classInstances), numClassInstances);
+}
+
+void D3D11RenderContext::PSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers)
+{
+	m_context->PSSetConstantBuffers(startSlot, numBuffers, ToD3D<ID3D11Buffer>(buffers));
+}
+
+void D3D11RenderContext::PSSetShaderResources(uint32_t startSlot, uint32_t numViews, RenderShaderResource* const* views)
+{
+	m_context->PSSetShaderResources(startSlot, numViews, ToD3D<ID3D11ShaderResourceView>(views));
+}
+
+void D3D11RenderContext::PSSetSamplers(uint32_t startSlot, uint32_t numSamplers, RenderSampler* const* samplers)
+{
+	m_context->PSSetSamplers(startSlot, numSamplers, ToD3D<ID3D11SamplerState>(samplers));
+}
+
+//--------------------------------------------------------------------------------------
+// OM
+//--------------------------------------------------------------------------------------
+void D3D11RenderContext::OMSetDepthStencilState(RenderDepthStencilState* depthStencilState, uint32_t stencilRef)
+{
+	m_context->OMSetDepthStencilState(ToD3D<ID3D11DepthStencilState>(depthStencilState), stencilRef);
+}
+
+void D3D11RenderContext::OMSetBlendState(RenderBlendState* blendState, const float blendFactor[4], uint32_t sampleMask)
+{
+	m_context->OMSetBlendState(ToD3D<ID3D11BlendState>(blendState), blendFactor, sampleMask);
+}
+
+//--------------------------------------------------------------------------------------
+// リソース
+//--------------------------------------------------------------------------------------
+void* D3D11RenderContext::Map(RenderBuffer* buffer, RenderMap mapType)
+{
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (FAILED(m_context->Map(ToD3D<ID3D11Buffer>(buffer), 0, static_cast<D3D11_MAP>(mapType), 0, &mapped)))
+	{
+		return nullptr;
+	}
+	return mapped.pData;
+}
+
+void D3D11RenderContext::Unmap(RenderBuffer* buffer)
+{
+	m_context->Unmap(ToD3D<ID3D11Buffer>(buffer), 0);
+}
+
+//--------------------------------------------------------------------------------------
+// 描画
+//--------------------------------------------------------------------------------------
+void D3D11RenderContext::Draw(uint32_t vertexCount, uint32_t startVertexLocation)
+{
+	m_context->Draw(vertexCount, startVertexLocation);
+}
+
+void D3D11RenderContext::DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation)
+{
+	m_context->DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
+}
+
+void D3D11RenderContext::DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+	uint32_t startIndexLocation, int32_t baseVertexLocation, uint32_t startInstanceLocation)
+{
+	m_context->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
+}
+
+//--------------------------------------------------------------------------------------
+// チャンクの数だけ遅延コンテキストを用意する関数
+//--------------------------------------------------------------------------------------
+void D3D11DeferredCommandRecorder::Prepare(uint32_t chunkCount)
+{
+	// 足りない遅延コンテキストを作成する
+	if (m_chunks.size() < chunkCount)
+	{
+		Microsoft::WRL::ComPtr<ID3D11Device> device;
+		m_immediateContext->GetDevice(device.GetAddressOf());
+
+		m_chunks.resize(chunkCount);
+		for (Chunk& chunk : m_chunks)
+		{
+			if (chunk.deferredContext) continue;
+			DX::ThrowIfFailed(device->CreateDeferredContext(0, chunk.deferredContext.ReleaseAndGetAddressOf()));
+			chunk.renderContext = std::make_unique<D3D11RenderContext>(chunk.deferredContext.Get());
+		}
+	}
+
+	// 現在の描画先を覚える
+	ID3D11RenderTargetView* renderTargetViews[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+	ID3D11DepthStencilView* depthStencilView = nullptr;
+	m_immediateContext->OMGetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, renderTargetViews, &depthStencilView);
+	for (UINT i = 0; i < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT; i++)
+	{
+		// OMGetRenderTargets で参照カウントが増えているので Attach する
+		m_renderTargetViews[i].Attach(renderTargetViews[i]);
+	}
+	m_depthStencilView.Attach(depthStencilView);
+
+	m_viewportCount = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+	m_immediateContext->RSGetViewports(&m_viewportCount, m_viewports);
+}
+
+//--------------------------------------------------------------------------------------
+// チャンクの記録を開始する関数
+//--------------------------------------------------------------------------------------
+IRenderContext* D3D11DeferredCommandRecorder::Begin(uint32_t chunk)
+{
+	Chunk& c = m_chunks[chunk];
+	SetRenderTargets(c.deferredContext.Get());
+	return c.renderContext.get();
+}
+
+//--------------------------------------------------------------------------------------
+// チャンクの記録を終了する関数
+//--------------------------------------------------------------------------------------
+void D3D11DeferredCommandRecorder::End(uint32_t chunk)
+{
+	Chunk& c = m_chunks[chunk];
+	DX::ThrowIfFailed(c.deferredContext->FinishCommandList(FALSE, c.commandList.ReleaseAndGetAddressOf()));
+}
+
+//--------------------------------------------------------------------------------------
+// 記録したチャンクを実行する関数
+//--------------------------------------------------------------------------------------
+void D3D11DeferredCommandRecorder::Execute(uint32_t chunk)
+{
+	Chunk& c = m_chunks[chunk];
+	if (!c.commandList) return;
+
+	// ステートを戻さない方が速いので、実行後に描画先だけ設定し直す
+	m_immediateContext->ExecuteCommandList(c.commandList.Get(), FALSE);
+	c.commandList.Reset();
+
+	SetRenderTargets(m_immediateContext);
+}
+
+//--------------------------------------------------------------------------------------
+// 描画先を設定する関数
+//--------------------------------------------------------------------------------------
+void D3D11DeferredCommandRecorder::SetRenderTargets(ID3D11DeviceContext* context) const
+{
+	ID3D11RenderTargetView* renderTargetViews[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT];
+	for (UINT i = 0; i < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT; i++)
+	{
+		renderTargetViews[i] = m_renderTargetViews[i].Get();
+	}
+	context->OMSetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, renderTargetViews, m_depthStencilView.Get());
+	context->RSSetViewports(m_viewportCount, m_viewports);
+}
@@ -0,0 +1,149 @@
+﻿//--------------------------------------------------------------------------------------
+// File: D3D11RenderContext.h
+//
+// IRenderContext の Direct3D 11 の実装
+//
+// Usage: ID3D11DeviceContext を渡して作成し、IRenderContext として使用します。
+//        Direct3D 11 のリソースは ToRenderHandle でハンドルへ変換します。
+//        D3D11DeferredCommandRecorder は ParallelRenderExecutor のチャンクを遅延コンテキストへ
+//        記録し、イミディエイトコンテキストで ExecuteCommandList します。
+//
+//	<<< 記述例 >>
+//	Imase::D3D11RenderContext renderContext(context);
+//	renderContext.IASetInputLayout(Imase::ToRenderHandle(m_inputLayout.Get()));
+//
+//	Imase::D3D11DeferredCommandRecorder recorder(context);
+//	executor.Execute(queue, handler, &stateContext, &recorder, 4);
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "RenderContext.h"
+#include "ParallelRenderExecutor.h"
+
+namespace Imase
+{
+	// ----- Direct3D 11 のリソースをハンドルへ変換する関数 ----- //
+
+	inline RenderBuffer* ToRenderHandle(ID3D11Buffer* p) { return reinterpret_cast<RenderBuffer*>(p); }
+	inline RenderInputLayout* ToRenderHandle(ID3D11InputLayout* p) { return reinterpret_cast<RenderInputLayout*>(p); }
+	inline RenderVertexShader* ToRenderHandle(ID3D11VertexShader* p) { return reinterpret_cast<RenderVertexShader*>(p); }
+	inline RenderPixelShader* ToRenderHandle(ID3D11PixelShader* p) { return reinterpret_cast<RenderPixelShader*>(p); }
+	inline RenderShaderResource* ToRenderHandle(ID3D11ShaderResourceView* p) { return reinterpret_cast<RenderShaderResource*>(p); }
+	inline RenderSampler* ToRenderHandle(ID3D11SamplerState* p) { return reinterpret_cast<RenderSampler*>(p); }
+	inline RenderRasterizerState* ToRenderHandle(ID3D11RasterizerState* p) { return reinterpret_cast<RenderRasterizerState*>(p); }
+	inline RenderDepthStencilState* ToRenderHandle(ID3D11DepthStencilState* p) { return reinterpret_cast<RenderDepthStencilState*>(p); }
+	inline RenderBlendState* ToRenderHandle(ID3D11BlendState* p) { return reinterpret_cast<RenderBlendState*>(p); }
+
+	// IRenderContext の Direct3D 11 の実装
+	class D3D11RenderContext : public IRenderContext
+	{
+	public:
+
+		// コンストラクタ（定数バッファの範囲を設定するために ID3D11DeviceContext1 も取得する）
+		explicit D3D11RenderContext(ID3D11DeviceContext* context);
+
+		// デバイスコンテキストを取得する関数
+		ID3D11DeviceContext* GetD3DContext() const { return m_context; }
+
+		// ----- IA ----- //
+
+		void IASetInputLayout(RenderInputLayout* inputLayout) override;
+		void IASetPrimitiveTopology(RenderTopology topology) override;
+		void IASetIndexBuffer(RenderBuffer* buffer, RenderIndexFormat format, uint32_t offset) override;
+		void IASetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets) override;
+
+		// ----- VS ----- //
+
+		void VSSetShader(RenderVertexShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances) override;
+		void VSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers) override;
+		void VSSetConstantBuffers1(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers,
+			const uint32_t* firstConstants, const uint32_t* numConstants) override;
+
+		// ----- RS ----- //
+
+		void RSSetState(RenderRasterizerState* rasterizerState) override;
+
+		// ----- PS ----- //
+
+		void PSSetShader(RenderPixelShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances) override;
+		void PSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers) override;
+		void PSSetShaderResources(uint32_t startSlot, uint32_t numViews, RenderShaderResource* const* views) override;
+		void PSSetSamplers(uint32_t startSlot, uint32_t numSamplers, RenderSampler* const* samplers) override;
+
+		// ----- OM ----- //
+
+		void OMSetDepthStencilState(RenderDepthStencilState* depthStencilState, uint32_t stencilRef) override;
+		void OMSetBlendState(RenderBlendState* blendState, const float blendFactor[4], uint32_t sampleMask) override;
+
+		// ----- リソース ----- //
+
+		void* Map(RenderBuffer* buffer, RenderMap mapType) override;
+		void Unmap(RenderBuffer* buffer) override;
+
+		// ----- 描画 ----- //
+
+		void Draw(uint32_t vertexCount, uint32_t startVertexLocation) override;
+		void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation) override;
+		void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+			uint32_t startIndexLocation, int32_t baseVertexLocation, uint32_t startInstanceLocation) override;
+
+	private:
+
+		// デバイスコンテキスト
+		ID3D11DeviceContext* m_context;
+
+		// Direct3D 11.1 のデバイスコンテキスト（取得できない場合は nullptr）
+		Microsoft::WRL::ComPtr<ID3D11DeviceContext1> m_context1;
+	};
+
+	// チャンクを遅延コンテキストへ記録して、イミディエイトコンテキストで実行するレコーダー
+	class D3D11DeferredCommandRecorder : public IRenderCommandRecorder
+	{
+	public:
+
+		// コンストラクタ（遅延コンテキストは必要になった時に作成する）
+		explicit D3D11DeferredCommandRecorder(ID3D11DeviceContext* immediateContext) : m_immediateContext(immediateContext) {}
+
+		// ----- IRenderCommandRecorder ----- //
+
+		void Prepare(uint32_t chunkCount) override;
+		IRenderContext* Begin(uint32_t chunk) override;
+		void End(uint32_t chunk) override;
+		void Execute(uint32_t chunk) override;
+
+	private:
+
+		// 描画先（レンダーターゲット・深度バッファ・ビューポート）を設定する関数
+		void SetRenderTargets(ID3D11DeviceContext* context) const;
+
+	private:
+
+		// チャンクごとの遅延コンテキストと記録したコマンドリスト
+		struct Chunk
+		{
+			Microsoft::WRL::ComPtr<ID3D11DeviceContext> deferredContext;
+			std::unique_ptr<D3D11RenderContext> renderContext;
+			Microsoft::WRL::ComPtr<ID3D11CommandList> commandList;
+		};
+
+		// イミディエイトコンテキスト
+		ID3D11DeviceContext* m_immediateContext;
+
+		// チャンク（作成した遅延コンテキストは使い回す）
+		std::vector<Chunk> m_chunks;
+
+		// Prepare の時点の描画先
+		// （遅延コンテキストはステートが何も設定されていない状態から記録し、
+		//   ExecuteCommandList の後はイミディエイトコンテキストのステートも解除されるので設定し直す）
+		Microsoft::WRL::ComPtr<ID3D11RenderTargetView> m_renderTargetViews[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT];
+		Microsoft::WRL::ComPtr<ID3D11DepthStencilView> m_depthStencilView;
+		D3D11_VIEWPORT m_viewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE] = {};
+		UINT m_viewportCount = 0;
+	};
+}
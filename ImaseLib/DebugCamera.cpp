@@ -19,21 +19,33 @@ const float DebugCamera::DEFAULT_CAMERA_DISTANCE = 5.0f;
 // コンストラクタ
 //--------------------------------------------------------------------------------------
 DebugCamera::DebugCamera(int windowWidth, int windowHeight)
-	: m_yAngle(0.0f), m_yTmp(0.0f), m_xAngle(0.0f), m_xTmp(0.0f), m_x(0), m_y(0), m_scrollWheelValue(0), m_screenW(windowWidth), m_screenH(windowHeight)
+	: m_yAngle(0.0f), m_yTmp(0.0f), m_xAngle(0.0f), m_xTmp(0.0f), m_x(0), m_y(0), m_scrollWheelValue(0), m_distance(DEFAULT_CAMERA_DISTANCE), m_screenW(windowWidth), m_screenH(windowHeight)
 {
 	SetWindowSize(windowWidth, windowHeight);
-
-	// マウスのフォイール値をリセット
-	Mouse::Get().ResetScrollWheelValue();
 }
 
 //--------------------------------------------------------------------------------------
-// 更新
+// マウスの状態の取得
 //--------------------------------------------------------------------------------------
-void DebugCamera::Update(bool isActive)
+Mouse::State DebugCamera::SampleMouse()
 {
 	auto state = Mouse::Get().GetState();
 
+	// マウスのフォイール値が正の場合はリセット
+	if (state.scrollWheelValue > 0)
+	{
+		state.scrollWheelValue = 0;
+		Mouse::Get().ResetScrollWheelValue();
+	}
+
+	return state;
+}
+
+//--------------------------------------------------------------------------------------
+// 更新
+//--------------------------------------------------------------------------------------
+void DebugCamera::Update(const Mouse::State& state, bool isActive)
+{
 	// 相対モードなら何もしない
 	if (state.positionMode == Mouse::MODE_RELATIVE) return;
 
@@ -58,32 +70,32 @@ void DebugCamera::Update(bool isActive)
 		Motion(state.x, state.y);
 	}
 
-	// マウスのフォイール値を取得
+	// マウスのフォイール値を取得（正の値は SampleMouse で 0 に戻している）
 	m_scrollWheelValue = state.scrollWheelValue;
-	if (m_scrollWheelValue > 0)
-	{
-		m_scrollWheelValue = 0;
-		Mouse::Get().ResetScrollWheelValue();
-	}
-
-	// ビュー行列を算出する
-	SimpleMath::Matrix rotY = SimpleMath::Matrix::CreateRotationY(m_yTmp);
-	SimpleMath::Matrix rotX = SimpleMath::Matrix::CreateRotationX(m_xTmp);
 
-	SimpleMath::Matrix rt = rotY * rotX;
+	m_distance = DEFAULT_CAMERA_DISTANCE - m_scrollWheelValue / 100;
 
-	SimpleMath::Vector3 eye(0.0f, 1.0f, 1.0f);
-	SimpleMath::Vector3 target(0.0f, 0.0f, 0.0f);
-	SimpleMath::Vector3 up(0.0f, 1.0f, 0.0f);
+	m_cameraView.SetState({ m_yTmp, m_xTmp, m_distance });
+}
 
-	eye = SimpleMath::Vector3::Transform(eye, rt.Invert());
-	eye *= (DEFAULT_CAMERA_DISTANCE - m_scrollWheelValue / 100);
-	up = SimpleMath::Vector3::Transform(up, rt.Invert());
+//--------------------------------------------------------------------------------------
+// カメラの状態の設定
+//--------------------------------------------------------------------------------------
+void DebugCamera::SetState(float yaw, float pitch, float distance)
+{
+	m_xAngle = m_xTmp = pitch;
+	m_yAngle = m_yTmp = yaw;
+	m_distance = distance;
 
-	m_eye = eye;
-	m_target = target;
+	m_cameraView.SetState({ yaw, pitch, distance });
+}
 
-	m_view = SimpleMath::Matrix::CreateLookAt(eye, target, up);
+//--------------------------------------------------------------------------------------
+// 射影行列の設定
+//--------------------------------------------------------------------------------------
+void DebugCamera::SetProjectionMatrix(const DirectX::SimpleMath::Matrix& proj)
+{
+	m_cameraView.SetProjection(Math::FromSimpleMath(proj));
 }
 
 //--------------------------------------------------------------------------------------
@@ -107,23 +119,34 @@ void DebugCamera::Motion(int x, int y)
 	}
 }
 
+Ray DebugCamera::CreateRay(int x, int y) const
+{
+	return CreateRayFromScreen(
+		static_cast<float>(x), static_cast<float>(y),
+		static_cast<float>(m_screenW), static_cast<float>(m_screenH),
+		m_cameraView.GetView(), m_cameraView.GetProjection());
+}
+
 DirectX::SimpleMath::Matrix DebugCamera::GetCameraMatrix()
 {
-	return m_view;
+	return Math::ToSimpleMath(m_cameraView.GetView());
 }
 
 DirectX::SimpleMath::Vector3 DebugCamera::GetEyePosition()
 {
-	return m_eye;
+	return Math::ToSimpleMath(m_cameraView.GetEyePosition());
 }
 
 DirectX::SimpleMath::Vector3 DebugCamera::GetTargetPosition()
 {
-	return m_target;
+	return Math::ToSimpleMath(m_cameraView.GetTargetPosition());
 }
 
 void DebugCamera::SetWindowSize(int windowWidth, int windowHeight)
 {
+	m_screenW = windowWidth;
+	m_screenH = windowHeight;
+
 	// 画面サイズに対する相対的なスケールに調整
 	m_sx = 1.0f / float(windowWidth);
 	m_sy = 1.0f / float(windowHeight);
@@ -8,9 +8,11 @@
 //--------------------------------------------------------------------------------------
 #pragma once
 
+#include "DebugCameraView.h"
+#include "Picking.h"
+
 namespace Imase
 {
-
 	// デバッグ用カメラクラス
 	class DebugCamera
 	{
@@ -28,17 +30,14 @@ namespace Imase
 
 		float m_sx, m_sy;
 
-		// 生成されたビュー行列
-		DirectX::SimpleMath::Matrix m_view;
+		// 行列と視錐台（状態が変化した時だけ再計算される）
+		DebugCameraView m_cameraView;
 
 		// スクロールフォイール値
 		int m_scrollWheelValue;
 
-		// 視点
-		DirectX::SimpleMath::Vector3 m_eye;
-
-		// 注視点
-		DirectX::SimpleMath::Vector3 m_target;
+		// 注視点からの距離
+		float m_distance;
 
 		// マウストラッカー
 		DirectX::Mouse::ButtonStateTracker m_tracker;
@@ -59,10 +58,18 @@ namespace Imase
 		DebugCamera(int windowWidth, int windowHeight);
 
 		/// <summary>
-		/// デバッグカメラの更新
+		/// デバッグカメラへ渡すマウスの状態の取得関数（メインスレッドで１フレームに１回呼ぶ）
+		/// ホイールの値が正の場合はマウスのホイールの値を 0 に戻す（既定の距離より近づかない）
+		/// </summary>
+		/// <returns>マウスの状態</returns>
+		static DirectX::Mouse::State SampleMouse();
+
+		/// <summary>
+		/// デバッグカメラの更新（マウスを直接読まないので、更新のスレッドから呼べる）
 		/// </summary>
+		/// <param name="state">SampleMouse で取得したマウスの状態</param>
 		/// <param name="isActive">trueの場合アクティブ化</param>
-		void Update(bool isActive = true);
+		void Update(const DirectX::Mouse::State& state, bool isActive = true);
 
 		/// <summary>
 		/// デバッグカメラのビュー行列の取得関数
@@ -70,6 +77,65 @@ namespace Imase
 		/// <returns>ビュー行列</returns>
 		DirectX::SimpleMath::Matrix GetCameraMatrix();
 
+		/// <summary>
+		/// デバッグカメラのビュー行列の逆行列（カメラのワールド行列）の取得関数
+		/// </summary>
+		/// <returns>ビュー行列の逆行列</returns>
+		DirectX::SimpleMath::Matrix GetInverseCameraMatrix() const { return Math::ToSimpleMath(m_cameraView.GetInverseView()); }
+
+		/// <summary>
+		/// 射影行列の設定関数（ビュー行列×射影行列と視錐台の計算に使用）
+		/// </summary>
+		/// <param name="proj">射影行列</param>
+		void SetProjectionMatrix(const DirectX::SimpleMath::Matrix& proj);
+
+		/// <summary>
+		/// ビュー行列×射影行列の取得関数
+		/// </summary>
+		/// <returns>ビュー行列×射影行列</returns>
+		DirectX::SimpleMath::Matrix GetViewProjectionMatrix() const { return Math::ToSimpleMath(m_cameraView.GetViewProjection()); }
+
+		/// <summary>
+		/// 視錐台の取得関数
+		/// </summary>
+		/// <returns>視錐台</returns>
+		const Frustum& GetFrustum() const { return m_cameraView.GetFrustum(); }
+
+		/// <summary>
+		/// スクリーン座標からワールド空間のレイを作成する関数（マウスピッキング用）
+		/// </summary>
+		/// <param name="x">スクリーン座標（X）</param>
+		/// <param name="y">スクリーン座標（Y）</param>
+		/// <returns>視点から画面の奥へ向かうレイ</returns>
+		Ray CreateRay(int x, int y) const;
+
+		/// <summary>
+		/// バージョン番号の取得関数
+		/// 行列が変化した時だけ値が変わるので、前回の値と同じ場合はカメラに依存する計算を省略できる
+		/// </summary>
+		/// <returns>バージョン番号（1以上）</returns>
+		uint32_t GetVersion() const { return m_cameraView.GetVersion(); }
+
+		/// <summary>
+		/// カメラの状態の設定関数（マウスの代わりに記録した経路などで動かす場合に使用）
+		/// </summary>
+		/// <param name="yaw">横回転（ラジアン）</param>
+		/// <param name="pitch">縦回転（ラジアン）</param>
+		/// <param name="distance">注視点からの距離</param>
+		void SetState(float yaw, float pitch, float distance);
+
+		// 横回転を取得する関数（ラジアン）
+		float GetYaw() const { return m_yTmp; }
+
+		// 縦回転を取得する関数（ラジアン）
+		float GetPitch() const { return m_xTmp; }
+
+		// 注視点からの距離を取得する関数
+		float GetDistance() const { return m_distance; }
+
+		// カメラの状態を取得する関数
+		DebugCameraState GetState() const { return { m_yTmp, m_xTmp, m_distance }; }
+
 		/// <summary>
 		/// デバッグカメラの位置の取得関数
 		/// </summary>
@@ -0,0 +1,92 @@
+﻿//--------------------------------------------------------------------------------------
+// File: DebugCameraView.cpp
+//
+// デバッグカメラの行列と視錐台を計算するクラス（DebugCamera の Windows に依存しない部分）
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "DebugCameraView.h"
+#include "FastTrig.h"
+
+using namespace Imase;
+
+//--------------------------------------------------------------------------------------
+// コンストラクタ
+//--------------------------------------------------------------------------------------
+DebugCameraView::DebugCameraView()
+	: m_state{ 0.0f, 0.0f, 0.0f }, m_hasView(false), m_version(0)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// カメラの状態の設定
+//--------------------------------------------------------------------------------------
+bool DebugCameraView::SetState(const DebugCameraState& state)
+{
+	// 回転と距離が前回と同じならビュー行列は変わらない
+	if (m_hasView && state == m_state) return false;
+
+	m_state = state;
+	m_hasView = true;
+
+	Math::Vector3 up;
+	ComputeEye(state, &m_eye, &up);
+
+	m_view = Math::Matrix::CreateLookAt(m_eye, GetTargetPosition(), up);
+
+	// ビュー行列は回転＋平行移動なので、逆行列は回転部分を転置して平行移動を視点にすればよい
+	m_invView = m_view.Transpose();
+	m_invView.m[0][3] = m_invView.m[1][3] = m_invView.m[2][3] = 0.0f;
+	m_invView.m[3][0] = m_eye.x;
+	m_invView.m[3][1] = m_eye.y;
+	m_invView.m[3][2] = m_eye.z;
+
+	UpdateViewProjection();
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// 射影行列の設定
+//--------------------------------------------------------------------------------------
+bool DebugCameraView::SetProjection(const Math::Matrix& proj)
+{
+	if (proj == m_proj) return false;
+
+	m_proj = proj;
+
+	// ビュー行列が未計算の場合は最初の SetState でまとめて計算する
+	if (!m_hasView) return false;
+
+	UpdateViewProjection();
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// カメラの状態から視点と上方向を求める
+//--------------------------------------------------------------------------------------
+void DebugCameraView::ComputeEye(const DebugCameraState& state, Math::Vector3* eye, Math::Vector3* up)
+{
+	float sy, cy, sx, cx;
+	Math::SinCos(state.yaw, &sy, &cy);
+	Math::SinCos(state.pitch, &sx, &cx);
+
+	*eye = Math::Vector3(sy * sx - sy * cx, cx + sx, cy * cx - cy * sx) * state.distance;
+	*up = Math::Vector3(sy * sx, cx, -cy * sx);
+}
+
+//--------------------------------------------------------------------------------------
+// ビュー行列×射影行列と視錐台の更新
+//--------------------------------------------------------------------------------------
+void DebugCameraView::UpdateViewProjection()
+{
+	m_viewProj = m_view * m_proj;
+	m_frustum = Frustum::CreateFromViewProjection(m_viewProj);
+
+	// 0 は「未計算」として使えるように飛ばす
+	if (++m_version == 0) m_version = 1;
+}
@@ -0,0 +1,152 @@
+﻿//--------------------------------------------------------------------------------------
+// File: DebugCameraView.h
+//
+// デバッグカメラの行列と視錐台を計算するクラス（DebugCamera の Windows に依存しない部分）
+//
+// Usage: 横回転・縦回転・距離（DebugCameraState）と射影行列を設定すると、ビュー行列・
+//        その逆行列・ビュー行列×射影行列・視錐台を求めます。
+//        入力が前回と同じ場合は何も計算せず、変化した時だけバージョン番号が増えるので、
+//        カメラに依存する計算（カリングなど）は前回の番号と比べて省略できます。
+//        DebugCamera はマウスの操作からこのクラスを更新します。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	Imase::DebugCameraView cameraView;
+//	cameraView.SetProjection(proj);
+//	cameraView.SetState({ yaw, pitch, distance });
+//
+//	if (cameraView.GetVersion() != lastVersion)
+//	{
+//		// カメラが動いた
+//	}
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+
+#include "FrustumCulling.h"
+#include "MathCore.h"
+
+namespace Imase
+{
+	// デバッグカメラの状態
+	struct DebugCameraState
+	{
+		// 横回転（ラジアン）
+		float yaw;
+
+		// 縦回転（ラジアン）
+		float pitch;
+
+		// 注視点からの距離
+		float distance;
+
+		bool operator==(const DebugCameraState& s) const { return yaw == s.yaw && pitch == s.pitch && distance == s.distance; }
+		bool operator!=(const DebugCameraState& s) const { return !(*this == s); }
+	};
+
+	// 状態の補間関数（InterpolatedState で使用、回転は角度のまま線形補間する）
+	inline DebugCameraState Interpolate(const DebugCameraState& a, const DebugCameraState& b, float t)
+	{
+		return { a.yaw + (b.yaw - a.yaw) * t, a.pitch + (b.pitch - a.pitch) * t, a.distance + (b.distance - a.distance) * t };
+	}
+
+	// デバッグカメラの行列と視錐台を計算するクラス
+	class DebugCameraView
+	{
+	public:
+
+		DebugCameraView();
+
+		/// <summary>
+		/// カメラの状態の設定関数（前回と同じ場合は何もしない）
+		/// </summary>
+		/// <param name="state">カメラの状態</param>
+		/// <returns>行列を再計算した場合は true</returns>
+		bool SetState(const DebugCameraState& state);
+
+		/// <summary>
+		/// 射影行列の設定関数（前回と同じ場合は何もしない）
+		/// 状態がまだ設定されていない場合は保存だけして、最初の SetState でまとめて計算する
+		/// </summary>
+		/// <param name="proj">射影行列</param>
+		/// <returns>行列を再計算した場合は true</returns>
+		bool SetProjection(const Math::Matrix& proj);
+
+		// 最後に設定したカメラの状態を取得する関数
+		const DebugCameraState& GetState() const { return m_state; }
+
+		// ビュー行列を取得する関数
+		const Math::Matrix& GetView() const { return m_view; }
+
+		// ビュー行列の逆行列（カメラのワールド行列）を取得する関数
+		const Math::Matrix& GetInverseView() const { return m_invView; }
+
+		// 射影行列を取得する関数
+		const Math::Matrix& GetProjection() const { return m_proj; }
+
+		// ビュー行列×射影行列を取得する関数
+		const Math::Matrix& GetViewProjection() const { return m_viewProj; }
+
+		// 視錐台を取得する関数
+		const Frustum& GetFrustum() const { return m_frustum; }
+
+		// 視点の位置を取得する関数
+		const Math::Vector3& GetEyePosition() const { return m_eye; }
+
+		// 注視点の位置を取得する関数（常に原点）
+		Math::Vector3 GetTargetPosition() const { return Math::Vector3::Zero(); }
+
+		/// <summary>
+		/// バージョン番号の取得関数
+		/// 行列が変化した時だけ値が変わる（まだ計算していない場合は 0、計算後は 1 以上）
+		/// </summary>
+		uint32_t GetVersion() const { return m_version; }
+
+		/// <summary>
+		/// カメラの状態から視点と上方向を求める関数
+		/// (0, 1, 1) と (0, 1, 0) を (RotY * RotX) の逆行列で変換した結果を、回転行列を作らずに直接求める
+		/// </summary>
+		/// <param name="state">カメラの状態</param>
+		/// <param name="eye">視点の位置の出力先</param>
+		/// <param name="up">上方向の出力先</param>
+		static void ComputeEye(const DebugCameraState& state, Math::Vector3* eye, Math::Vector3* up);
+
+	private:
+
+		// ビュー行列×射影行列と視錐台を更新する
+		void UpdateViewProjection();
+
+	private:
+
+		// 最後に設定したカメラの状態
+		DebugCameraState m_state;
+
+		// 行列を計算済みか（false の場合は次の SetState で必ず計算する）
+		bool m_hasView;
+
+		// ビュー行列
+		Math::Matrix m_view;
+
+		// ビュー行列の逆行列
+		Math::Matrix m_invView;
+
+		// 射影行列
+		Math::Matrix m_proj;
+
+		// ビュー行列×射影行列
+		Math::Matrix m_viewProj;
+
+		// 視錐台
+		Frustum m_frustum;
+
+		// 視点
+		Math::Vector3 m_eye;
+
+		// 行列が更新される度に増えるバージョン番号
+		uint32_t m_version;
+	};
+}
@@ -35,14 +35,14 @@ DebugFont::~DebugFont()
 // 描画する文字列を登録する関数
 void DebugFont::AddString(const wchar_t * string, DirectX::SimpleMath::Vector2 pos, FXMVECTOR color, float scale)
 {
-	String str;
-
-	str.string = std::wstring(string);
-	str.pos = pos;
-	str.color = color;
-	str.scale = scale;
+	// 描画するまでフレームのアリーナにコピーしておく
+	RegisterString(m_strings.Copy(string), pos, color, scale);
+}
 
-	m_strings.push_back(str);
+// フレームのアリーナに置いた文字列をコピーせずに登録する関数
+void DebugFont::RegisterString(const wchar_t* string, DirectX::SimpleMath::Vector2 pos, FXMVECTOR color, float scale)
+{
+	m_strings.Add(string, pos, color, scale);
 }
 
 // 描画関数
@@ -54,7 +54,7 @@ void DebugFont::Render(DirectX::CommonStates* states)
 	{
 		m_spriteFont->DrawString(
 			m_spriteBatch.get(),
-			m_strings[i].string.c_str(),
+			m_strings[i].string,
 			m_strings[i].pos,
 			m_strings[i].color,
 			0.0f,
@@ -65,12 +65,13 @@ void DebugFont::Render(DirectX::CommonStates* states)
 	m_spriteBatch->End();
 
 	// 登録されている文字列をクリア
-	m_strings.clear();
+	m_strings.Clear();
 }
 
 // コンストラクタ
 DebugFont3D::DebugFont3D(ID3D11Device* device, ID3D11DeviceContext* context, wchar_t const* fileName)
 	: DebugFont(device, context, fileName)
+	, m_cameraVersion(0)
 {	
 	// エフェクトを作成
 	m_effect = std::make_unique<BasicEffect>(device);
@@ -103,15 +104,15 @@ void DebugFont3D::AddString(
 	DirectX::FXMVECTOR color,
 	float scale)
 {
-	String str;
+	// 描画するまでフレームのアリーナにコピーしておく
+	RegisterString(m_strings.Copy(string), pos, color, scale);
+}
 
-	str.string = std::wstring(string);
-	str.pos = pos;
-	str.color = color;
+// フレームのアリーナに置いた文字列をコピーせずに登録する関数（3D版）
+void DebugFont3D::RegisterString(const wchar_t* string, DirectX::SimpleMath::Vector3 pos, FXMVECTOR color, float scale)
+{
 	// 文字の高さが3D空間内で１になるよう調整している（余白があるのできっちりではない）
-	str.scale = scale / m_fontHeight;
-
-	m_strings.push_back(str);
+	m_strings.Add(string, pos, color, scale / m_fontHeight);
 }
 
 // 描画関数（3D版）
@@ -119,27 +120,39 @@ void DebugFont3D::Render(
 	ID3D11DeviceContext* context,
 	DirectX::CommonStates* states,
 	const DirectX::SimpleMath::Matrix& view,
-	const DirectX::SimpleMath::Matrix& proj)
+	const DirectX::SimpleMath::Matrix& proj,
+	uint32_t cameraVersion)
 {
-	// スクリーン座標はY軸が＋－逆なので
-	SimpleMath::Matrix invertY = SimpleMath::Matrix::CreateScale(1.0f, -1.0f, 1.0f);
+	// カメラが変化していない場合は前回の行列をそのまま使う
+	if (cameraVersion == 0 || cameraVersion != m_cameraVersion)
+	{
+		// スクリーン座標はY軸が＋－逆なので
+		SimpleMath::Matrix invertY = SimpleMath::Matrix::CreateScale(1.0f, -1.0f, 1.0f);
+
+		// ビュー行列の回転を打ち消す行列を作成する（回転行列の逆行列は転置行列）
+		SimpleMath::Matrix invView = view.Transpose();
+		invView._14 = 0.0f;
+		invView._24 = 0.0f;
+		invView._34 = 0.0f;
+		invView._41 = 0.0f;
+		invView._42 = 0.0f;
+		invView._43 = 0.0f;
 
-	// ビュー行列の回転を打ち消す行列を作成する
-	SimpleMath::Matrix invView = view.Invert();
-	invView._41 = 0.0f;
-	invView._42 = 0.0f;
-	invView._43 = 0.0f;
+		m_billboard = invertY * invView;
 
-	// エフェクトにビュー行列と射影行列を設定する
-	m_effect->SetView(view);
-	m_effect->SetProjection(proj);
+		// エフェクトにビュー行列と射影行列を設定する
+		m_effect->SetView(view);
+		m_effect->SetProjection(proj);
+
+		m_cameraVersion = cameraVersion;
+	}
 
 	for (size_t i = 0; i < m_strings.size(); i++)
 	{
 		m_spriteBatch->Begin(SpriteSortMode_Deferred, nullptr, nullptr, states->DepthNone(), states->CullCounterClockwise(), [=]
 			{
 				// ワールド行列作成
-				SimpleMath::Matrix world = invertY * invView * SimpleMath::Matrix::CreateTranslation(m_strings[i].pos);
+				SimpleMath::Matrix world = m_billboard * SimpleMath::Matrix::CreateTranslation(m_strings[i].pos);
 				// エフェクトを適応する
 				m_effect->SetWorld(world);
 				m_effect->Apply(context);
@@ -149,11 +162,11 @@ void DebugFont3D::Render(
 		);
 
 		// 文字列の中心が表示位置になるように設定
-		SimpleMath::Vector2 textOrigin = m_spriteFont->MeasureString(m_strings[i].string.c_str()) / 2.0f;
+		SimpleMath::Vector2 textOrigin = m_spriteFont->MeasureString(m_strings[i].string) / 2.0f;
 
 		m_spriteFont->DrawString(
 			m_spriteBatch.get(),
-			m_strings[i].string.c_str(),
+			m_strings[i].string,
 			SimpleMath::Vector2::Zero,
 			m_strings[i].color,
 			0.0f,
@@ -164,5 +177,5 @@ void DebugFont3D::Render(
 	}
 
 	// 登録されている文字列をクリア
-	m_strings.clear();
+	m_strings.Clear();
 }
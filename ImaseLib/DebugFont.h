@@ -5,6 +5,8 @@
 //
 // Usage: DebugFontクラスは2D版、DebugFont3Dクラスは3D版です。
 //        AddString関数で文字列を登録します。登録された情報は描画後クリアされます。
+//        文字列はフレームのアリーナ（FrameArena）に置くので、登録したフレームで描画してください。
+//        文字列の書式と登録は DebugTextList が行います（Windows 以外でもテストできる部分）。
 //        デバッグ用の文字列の表示などに使用してください。
 //		  ※デバッグ用なので深度バッファはみていません。（必ず描画される）
 //
@@ -13,8 +15,7 @@
 //--------------------------------------------------------------------------------------
 #pragma once
 
-#include <vector>
-#include <string>
+#include "DebugTextList.h"
 
 namespace Imase
 {
@@ -23,24 +24,8 @@ namespace Imase
 	{
 	private:
 
-		// 文字列情報
-		struct String
-		{
-			// 位置
-			DirectX::SimpleMath::Vector2 pos;
-
-			// 文字列
-			std::wstring string;
-
-			// 色
-			DirectX::SimpleMath::Color color;
-
-			// スケール
-			float scale = 1.0f;
-		};
-
 		// 表示文字列の配列
-		std::vector<String> m_strings;
+		DebugTextList<DirectX::SimpleMath::Vector2, DirectX::SimpleMath::Color> m_strings;
 
 	protected:
 
@@ -65,17 +50,10 @@ namespace Imase
 		template <class... Args>
 		void AddString(int x, int y, const DirectX::FXMVECTOR& color, const wchar_t* format, const Args& ... args)
 		{
-			int textLength = std::swprintf(nullptr, 0, format, args ...);
-			if (textLength < 0)
-			{
-				throw std::runtime_error("String Formatting Error.");
-			}
-
-			size_t bufferSize = textLength + sizeof(L'\0');
-			std::unique_ptr<wchar_t[]> buffer = std::make_unique<wchar_t[]>(bufferSize);
-			std::swprintf(buffer.get(), bufferSize, format, args ...);
+			// フレームのアリーナに書き込む（ヒープから確保しない）
+			const wchar_t* buffer = m_strings.Format(format, args ...);
 
-			AddString(buffer.get(), DirectX::SimpleMath::Vector2{ static_cast<float>(x),static_cast<float>(y) }, color);
+			RegisterString(buffer, DirectX::SimpleMath::Vector2{ static_cast<float>(x),static_cast<float>(y) }, color, 1.0f);
 		}
 
 		// 描画する文字列を登録する関数
@@ -90,30 +68,19 @@ namespace Imase
 
 		// フォントの高さを取得する関数
 		float GetFontHeight() {	return m_fontHeight; }
+
+	private:
+
+		// フレームのアリーナに置いた文字列をコピーせずに登録する関数
+		void RegisterString(const wchar_t* string, DirectX::SimpleMath::Vector2 pos, DirectX::FXMVECTOR color, float scale);
 	};
 
 	class DebugFont3D : protected DebugFont
 	{
 	private:
 
-		// 文字列情報
-		struct String
-		{
-			// 位置
-			DirectX::SimpleMath::Vector3 pos;
-
-			// 文字列
-			std::wstring string;
-
-			// 色
-			DirectX::SimpleMath::Color color;
-
-			// スケール
-			float scale = 1.0f;
-		};
-
 		// 表示文字列の配列
-		std::vector<String> m_strings;
+		DebugTextList<DirectX::SimpleMath::Vector3, DirectX::SimpleMath::Color> m_strings;
 
 		// エフェクト
 		std::unique_ptr<DirectX::BasicEffect> m_effect;
@@ -121,6 +88,12 @@ namespace Imase
 		// 入力レイアウト
 		Microsoft::WRL::ComPtr<ID3D11InputLayout> m_inputLayout;
 
+		// ビュー行列の回転を打ち消す行列（Y軸反転込み）
+		DirectX::SimpleMath::Matrix m_billboard;
+
+		// 前回設定したカメラのバージョン番号
+		uint32_t m_cameraVersion;
+
 	public:
 
 		// コンストラクタ
@@ -136,17 +109,10 @@ namespace Imase
 		template <class... Args>
 		void AddString(DirectX::SimpleMath::Vector3 pos, const DirectX::FXMVECTOR& color, const wchar_t* format, const Args& ... args)
 		{
-			int textLength = std::swprintf(nullptr, 0, format, args ...);
-			if (textLength < 0)
-			{
-				throw std::runtime_error("String Formatting Error.");
-			}
+			// フレームのアリーナに書き込む（ヒープから確保しない）
+			const wchar_t* buffer = m_strings.Format(format, args ...);
 
-			size_t bufferSize = textLength + sizeof(L'\0');
-			std::unique_ptr<wchar_t[]> buffer = std::make_unique<wchar_t[]>(bufferSize);
-			std::swprintf(buffer.get(), bufferSize, format, args ...);
-
-			AddString(buffer.get(), pos, color);
+			RegisterString(buffer, pos, color, 1.0f);
 		}
 
 		// 描画する文字列を登録する関数
@@ -156,15 +122,21 @@ namespace Imase
 			DirectX::FXMVECTOR color = DirectX::Colors::White,
 			float scale = 1.0f);
 
-		// 描画関数
+		// 描画関数（cameraVersion が前回と同じ場合は行列の計算を省略する。0の場合は毎回計算する）
 		void Render(
 			ID3D11DeviceContext* context,
 			DirectX::CommonStates* states,
 			const DirectX::SimpleMath::Matrix& view,
-			const DirectX::SimpleMath::Matrix& proj);
+			const DirectX::SimpleMath::Matrix& proj,
+			uint32_t cameraVersion = 0);
 
 		// フォントの高さを取得する関数
 		float GetFontHeight() { return m_fontHeight; }
+
+	private:
+
+		// フレームのアリーナに置いた文字列をコピーせずに登録する関数
+		void RegisterString(const wchar_t* string, DirectX::SimpleMath::Vector3 pos, DirectX::FXMVECTOR color, float scale);
 	};
 
 }
@@ -0,0 +1,136 @@
+﻿//--------------------------------------------------------------------------------------
+// File: DebugTextList.h
+//
+// 描画するデバッグ用の文字列をフレームのアリーナに置いて並べておくクラス（ヘッダーのみ）
+//
+// Usage: DebugFont・DebugFont3D の文字列の登録の部分です（描画は DebugFont が行います）。
+//        Format は書式を指定した文字列を、Copy は文字列をそのままフレームのアリーナへ書き込み、
+//        Add で位置・色・スケールと一緒に登録します。描画したら Clear で空にしてください。
+//        文字列はアリーナに、登録した情報は容量を残した配列に置くので、登録する数が
+//        安定したフレームではヒープからの確保は行われません。
+//        書式の文字列の長さは swprintf(nullptr, 0, ...) では求めません（負の値を返す環境がある）。
+//        スタックの領域へ書き込んでからアリーナへコピーし、入りきらない場合だけアリーナに
+//        大きな領域を確保して書き直します。
+//        位置と色の型はテンプレートの引数で指定するので、Windows 以外の環境でも使えます。
+//
+//	<<< 記述例 >>
+//	Imase::DebugTextList<DirectX::SimpleMath::Vector2, DirectX::SimpleMath::Color> texts;
+//
+//	texts.Add(texts.Format(L"FPS %u", fps), position, color, 1.0f);
+//
+//	for (size_t i = 0; i < texts.size(); i++) Draw(texts[i].string, texts[i].pos);
+//	texts.Clear();
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cwchar>
+#include <stdexcept>
+#include <vector>
+
+#include "FrameArena.h"
+
+namespace Imase
+{
+	// 描画するデバッグ用の文字列の配列
+	template <class TPosition, class TColor>
+	class DebugTextList
+	{
+	public:
+
+		// 文字列情報
+		struct Text
+		{
+			// 位置
+			TPosition pos;
+
+			// 文字列（フレームのアリーナのメモリ）
+			const wchar_t* string;
+
+			// 色
+			TColor color;
+
+			// スケール
+			float scale;
+		};
+
+		// スタックに書き込む文字列の長さ（終端を含む、超える場合はアリーナで書き直す）
+		static constexpr size_t LOCAL_TEXT_LENGTH = 1024;
+
+		// 書式を指定した文字列の最大の長さ（終端を含む）
+		static constexpr size_t MAX_TEXT_LENGTH = 64 * 1024;
+
+		explicit DebugTextList(FrameArena* arena = &FrameArena::GetDefault()) : m_arena(arena) {}
+
+		/// <summary>
+		/// 書式を指定した文字列をフレームのアリーナへ書き込む関数
+		/// </summary>
+		/// <param name="format">書式（swprintf と同じ）</param>
+		/// <returns>アリーナの文字列（次のフレームの終わりまで有効）</returns>
+		template <class... Args>
+		const wchar_t* Format(const wchar_t* format, const Args& ... args)
+		{
+			wchar_t local[LOCAL_TEXT_LENGTH];
+			int textLength = std::swprintf(local, LOCAL_TEXT_LENGTH, format, args ...);
+			if (textLength >= 0)
+			{
+				return Copy(local, static_cast<size_t>(textLength));
+			}
+
+			// 入りきらない場合は領域を倍にしながらアリーナへ直接書き込む
+			for (size_t bufferSize = LOCAL_TEXT_LENGTH * 2; bufferSize <= MAX_TEXT_LENGTH; bufferSize *= 2)
+			{
+				wchar_t* buffer = m_arena->AllocateArray<wchar_t>(bufferSize);
+				if (std::swprintf(buffer, bufferSize, format, args ...) >= 0) return buffer;
+			}
+
+			throw std::runtime_error("String Formatting Error.");
+		}
+
+		// 文字列をフレームのアリーナへコピーする関数
+		const wchar_t* Copy(const wchar_t* string) { return Copy(string, std::wcslen(string)); }
+
+		/// <summary>
+		/// 文字列を登録する関数（文字列はコピーしないので、Format・Copy の結果を渡す）
+		/// </summary>
+		/// <param name="string">文字列</param>
+		/// <param name="pos">位置</param>
+		/// <param name="color">色</param>
+		/// <param name="scale">スケール</param>
+		void Add(const wchar_t* string, const TPosition& pos, const TColor& color, float scale)
+		{
+			m_texts.push_back({ pos, string, color, scale });
+		}
+
+		// 登録した文字列を全て削除する関数（配列の容量は残す）
+		void Clear() { m_texts.clear(); }
+
+		// 登録した文字列の数を取得する関数
+		size_t size() const { return m_texts.size(); }
+
+		// 登録した文字列を取得する関数
+		const Text& operator[](size_t index) const { return m_texts[index]; }
+
+	private:
+
+		// 長さの分かっている文字列をアリーナへコピーする関数
+		const wchar_t* Copy(const wchar_t* string, size_t textLength)
+		{
+			wchar_t* buffer = m_arena->AllocateArray<wchar_t>(textLength + 1);
+			std::wmemcpy(buffer, string, textLength);
+			buffer[textLength] = L'\0';
+			return buffer;
+		}
+
+	private:
+
+		// 文字列を置くアリーナ
+		FrameArena* m_arena;
+
+		// 登録した文字列
+		std::vector<Text> m_texts;
+	};
+}
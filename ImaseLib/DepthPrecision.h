@@ -0,0 +1,135 @@
+﻿//--------------------------------------------------------------------------------------
+// File: DepthPrecision.h
+//
+// 深度バッファの精度（量子化誤差）を計算する関数群
+//
+// Usage: 射影行列の種類と深度バッファの形式から、指定した距離で深度値が
+//        １段階変化するのに必要な距離（＝前後関係を区別できる最小の距離）を求めます。
+//        Windows や DirectXMath に依存しないので、どの環境でも使用できます。
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+namespace Imase
+{
+	// 深度バッファの形式
+	enum class DepthFormat
+	{
+		D24_UNORM,	// 24ビット固定小数点
+		D32_FLOAT,	// 32ビット浮動小数点
+	};
+
+	// 射影行列の種類
+	struct DepthProjection
+	{
+		float nearPlane = 0.1f;
+		float farPlane = 100.0f;	// 無限遠の場合は無視される
+		bool reverseZ = false;
+		bool infinite = false;
+
+		// 深度値 = A + B / 距離 となる係数を取得する関数
+		void GetCoefficients(double& a, double& b) const
+		{
+			double n = nearPlane;
+			double f = farPlane;
+
+			if (infinite)
+			{
+				a = reverseZ ? 0.0 : 1.0;
+				b = reverseZ ? n : -n;
+			}
+			else if (reverseZ)
+			{
+				a = -n / (f - n);
+				b = n * f / (f - n);
+			}
+			else
+			{
+				a = f / (f - n);
+				b = -n * f / (f - n);
+			}
+		}
+
+		// 距離から深度値を求める関数
+		double ToDepth(double distance) const
+		{
+			double a, b;
+			GetCoefficients(a, b);
+			return a + b / distance;
+		}
+
+		// 深度値から距離を求める関数
+		double ToDistance(double depth) const
+		{
+			double a, b;
+			GetCoefficients(a, b);
+			return b / (depth - a);
+		}
+	};
+
+	// 深度値を深度バッファの形式で量子化する関数
+	inline double QuantizeDepth(double depth, DepthFormat format)
+	{
+		if (format == DepthFormat::D24_UNORM)
+		{
+			const double scale = double((1 << 24) - 1);
+			return std::round(depth * scale) / scale;
+		}
+		return static_cast<double>(static_cast<float>(depth));
+	}
+
+	// 指定した深度値での深度バッファの１段階分の大きさを求める関数
+	inline double DepthStep(double depth, DepthFormat format)
+	{
+		if (format == DepthFormat::D24_UNORM)
+		{
+			return 1.0 / double((1 << 24) - 1);
+		}
+
+		// 浮動小数点は値の大きさで刻み幅が変わる
+		float d = static_cast<float>(depth);
+		return static_cast<double>(std::nextafter(d, std::numeric_limits<float>::max()) - d);
+	}
+
+	// 指定した距離で区別できる最小の距離（深度の分解能）を求める関数
+	inline double DepthResolution(double distance, const DepthProjection& projection, DepthFormat format)
+	{
+		double depth = QuantizeDepth(projection.ToDepth(distance), format);
+		double step = DepthStep(depth, format);
+
+		// 遠くなる方向へ１段階ずらした深度値
+		double next = projection.reverseZ ? depth - step : depth + step;
+
+		return std::abs(projection.ToDistance(next) - projection.ToDistance(depth));
+	}
+
+	// 指定した距離の深度値を量子化した時の距離の誤差を求める関数
+	inline double DepthError(double distance, const DepthProjection& projection, DepthFormat format)
+	{
+		double depth = QuantizeDepth(projection.ToDepth(distance), format);
+		return std::abs(projection.ToDistance(depth) - distance);
+	}
+
+	// 距離を対数的に区切って深度の分解能を一括で計測する関数
+	//  distances, resolutions : count 個の結果を格納する配列
+	inline void MeasureDepthPrecision(
+		const DepthProjection& projection, DepthFormat format,
+		double minDistance, double maxDistance,
+		double* distances, double* resolutions, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			double t = count > 1 ? double(i) / double(count - 1) : 0.0;
+			double d = minDistance * std::pow(maxDistance / minDistance, t);
+			distances[i] = d;
+			resolutions[i] = DepthResolution(d, projection, format);
+		}
+	}
+}
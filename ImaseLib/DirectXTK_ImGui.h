@@ -24,7 +24,7 @@
 //	ImGui::DragFloat3("input float3", v, 0.1f);
 // 
 //	// ImGuĩEChEɃtH[JXĂ鎞̓J̑𐧌j
-//	m_debugCamera->Update(!ImGui::IsWindowFocused());
+//	m_debugCamera->Update(Imase::DebugCamera::SampleMouse(), !ImGui::IsWindowFocused());
 // 
 //	ImGui::End();
 //
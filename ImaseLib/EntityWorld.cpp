@@ -0,0 +1,379 @@
+﻿//--------------------------------------------------------------------------------------
+// File: EntityWorld.cpp
+//
+// アーキタイプ（コンポーネントの組み合わせ）ごとに SoA 形式で並べるエンティティの入れ物
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "EntityWorld.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+using namespace Imase;
+
+namespace
+{
+	// 登録したコンポーネントの種類の大きさ
+	size_t s_componentSizes[MAX_COMPONENT_TYPES];
+
+	// 登録したコンポーネントの種類の数
+	std::atomic<uint32_t> s_componentTypeCount(0);
+
+	// 配列の先頭をキャッシュラインに揃える関数
+	size_t AlignUp(size_t offset)
+	{
+		return (offset + ENTITY_CHUNK_ALIGNMENT - 1) & ~(ENTITY_CHUNK_ALIGNMENT - 1);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// コンポーネントの種類を登録して番号を取得する関数
+//--------------------------------------------------------------------------------------
+uint32_t Imase::RegisterComponentType(size_t size, size_t)
+{
+	uint32_t type = s_componentTypeCount.fetch_add(1);
+	if (type >= MAX_COMPONENT_TYPES)
+	{
+		throw std::length_error("Imase::RegisterComponentType: too many component types");
+	}
+
+	s_componentSizes[type] = size;
+
+	return type;
+}
+
+EntityWorld::~EntityWorld()
+{
+	for (const auto& archetype : m_archetypes)
+	{
+		for (const Chunk& chunk : archetype->chunks)
+		{
+			::operator delete(chunk.data, std::align_val_t(ENTITY_CHUNK_ALIGNMENT));
+		}
+	}
+	for (uint8_t* data : m_freeChunks)
+	{
+		::operator delete(data, std::align_val_t(ENTITY_CHUNK_ALIGNMENT));
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// エンティティを削除する関数
+//--------------------------------------------------------------------------------------
+bool EntityWorld::Destroy(Entity entity)
+{
+	if (!IsAlive(entity)) return false;
+
+	EntityRecord& record = m_records[entity.index];
+	RemoveRow(record.archetype, record.chunk, record.row);
+
+	// 番号を再利用した時に古いエンティティと区別できるように回数を進める
+	record.archetype = nullptr;
+	record.generation++;
+	m_freeIndices.push_back(entity.index);
+	m_entityCount--;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// 全てのエンティティを削除する関数
+//--------------------------------------------------------------------------------------
+void EntityWorld::Clear()
+{
+	for (const auto& archetype : m_archetypes)
+	{
+		for (const Chunk& chunk : archetype->chunks)
+		{
+			FreeChunk(chunk.data);
+		}
+		archetype->chunks.clear();
+		archetype->entityCount = 0;
+	}
+
+	m_freeIndices.clear();
+	for (uint32_t i = 0; i < m_records.size(); i++)
+	{
+		EntityRecord& record = m_records[i];
+		if (record.archetype)
+		{
+			record.archetype = nullptr;
+			record.generation++;
+		}
+		m_freeIndices.push_back(static_cast<uint32_t>(m_records.size()) - 1 - i);
+	}
+
+	m_entityCount = 0;
+}
+
+//--------------------------------------------------------------------------------------
+// 使用しているチャンクの数を取得する関数
+//--------------------------------------------------------------------------------------
+size_t EntityWorld::GetChunkCount() const
+{
+	size_t count = 0;
+	for (const auto& archetype : m_archetypes)
+	{
+		count += archetype->chunks.size();
+	}
+	return count;
+}
+
+//--------------------------------------------------------------------------------------
+// コンポーネントの組み合わせを指定してエンティティを作成する関数
+//--------------------------------------------------------------------------------------
+Entity EntityWorld::CreateEntity(ComponentMask mask)
+{
+	// 削除したエンティティの番号を再利用する
+	uint32_t index;
+	if (!m_freeIndices.empty())
+	{
+		index = m_freeIndices.back();
+		m_freeIndices.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(m_records.size());
+		m_records.push_back({ nullptr, 0, 0, 0 });
+	}
+
+	Entity entity = { index, m_records[index].generation };
+
+	Archetype* archetype = GetArchetype(mask);
+	uint32_t chunk, row;
+	AllocateRow(archetype, &chunk, &row);
+
+	// コンポーネントの値は 0 にしておく
+	uint8_t* data = archetype->chunks[chunk].data;
+	reinterpret_cast<Entity*>(data)[row] = entity;
+	for (uint32_t type : archetype->types)
+	{
+		size_t size = s_componentSizes[type];
+		memset(data + archetype->offsets[type] + size * row, 0, size);
+	}
+
+	EntityRecord& record = m_records[index];
+	record.archetype = archetype;
+	record.chunk = chunk;
+	record.row = row;
+
+	m_entityCount++;
+
+	return entity;
+}
+
+//--------------------------------------------------------------------------------------
+// コンポーネントを取得する関数
+//--------------------------------------------------------------------------------------
+void* EntityWorld::GetComponent(Entity entity, uint32_t type)
+{
+	if (!IsAlive(entity)) return nullptr;
+
+	const EntityRecord& record = m_records[entity.index];
+	const Archetype* archetype = record.archetype;
+	if (!(archetype->mask & (ComponentMask(1) << type))) return nullptr;
+
+	return archetype->chunks[record.chunk].data + archetype->offsets[type] + s_componentSizes[type] * record.row;
+}
+
+//--------------------------------------------------------------------------------------
+// コンポーネントを追加・削除してアーキタイプを移す関数
+//--------------------------------------------------------------------------------------
+bool EntityWorld::ChangeArchetype(Entity entity, ComponentMask add, ComponentMask remove)
+{
+	if (!IsAlive(entity)) return false;
+
+	EntityRecord& record = m_records[entity.index];
+	Archetype* source = record.archetype;
+
+	ComponentMask mask = (source->mask | add) & ~remove;
+	if (mask == source->mask) return true;
+
+	// コンポーネントを１つだけ追加・削除する場合は覚えておいた移り先を使う
+	Archetype* destination = nullptr;
+	Archetype** edge = nullptr;
+	ComponentMask changed = mask ^ source->mask;
+	if ((changed & (changed - 1)) == 0)
+	{
+		uint32_t type = 0;
+		while (!(changed & (ComponentMask(1) << type))) type++;
+		edge = (mask & changed) ? &source->addEdges[type] : &source->removeEdges[type];
+		destination = *edge;
+	}
+	if (!destination)
+	{
+		destination = GetArchetype(mask);
+		if (edge) *edge = destination;
+	}
+
+	uint32_t chunk, row;
+	AllocateRow(destination, &chunk, &row);
+
+	// 両方にあるコンポーネントはコピーし、追加したコンポーネントは 0 にする
+	const uint8_t* sourceData = source->chunks[record.chunk].data;
+	uint8_t* destinationData = destination->chunks[chunk].data;
+	reinterpret_cast<Entity*>(destinationData)[row] = entity;
+	for (uint32_t type : destination->types)
+	{
+		size_t size = s_componentSizes[type];
+		uint8_t* to = destinationData + destination->offsets[type] + size * row;
+		if (source->mask & (ComponentMask(1) << type))
+		{
+			memcpy(to, sourceData + source->offsets[type] + size * record.row, size);
+		}
+		else
+		{
+			memset(to, 0, size);
+		}
+	}
+
+	RemoveRow(source, record.chunk, record.row);
+
+	record.archetype = destination;
+	record.chunk = chunk;
+	record.row = row;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// アーキタイプを取得する関数
+//--------------------------------------------------------------------------------------
+EntityWorld::Archetype* EntityWorld::GetArchetype(ComponentMask mask)
+{
+	auto it = m_archetypeMap.find(mask);
+	if (it != m_archetypeMap.end()) return it->second;
+
+	auto archetype = std::make_unique<Archetype>();
+	archetype->mask = mask;
+	archetype->entityCount = 0;
+	for (uint32_t type = 0; type < MAX_COMPONENT_TYPES; type++)
+	{
+		archetype->offsets[type] = 0;
+		archetype->addEdges[type] = nullptr;
+		archetype->removeEdges[type] = nullptr;
+		if (mask & (ComponentMask(1) << type)) archetype->types.push_back(type);
+	}
+
+	// １エンティティあたりの大きさからチャンクに入る数を求め、
+	// 配列の先頭をキャッシュラインに揃えて入りきらなくなった分を減らす
+	size_t entitySize = sizeof(Entity);
+	for (uint32_t type : archetype->types) entitySize += s_componentSizes[type];
+
+	auto layout = [&](size_t capacity)
+	{
+		size_t offset = AlignUp(sizeof(Entity) * capacity);
+		for (uint32_t type : archetype->types)
+		{
+			archetype->offsets[type] = static_cast<uint32_t>(offset);
+			offset = AlignUp(offset + s_componentSizes[type] * capacity);
+		}
+		return offset;
+	};
+
+	size_t capacity = ENTITY_CHUNK_SIZE / entitySize;
+	while (capacity > 1 && layout(capacity) > ENTITY_CHUNK_SIZE) capacity--;
+	archetype->capacity = static_cast<uint32_t>(capacity);
+
+	Archetype* result = archetype.get();
+	m_archetypeMap[mask] = result;
+	m_archetypes.push_back(std::move(archetype));
+
+	return result;
+}
+
+//--------------------------------------------------------------------------------------
+// アーキタイプの最後に場所を確保する関数
+//--------------------------------------------------------------------------------------
+void EntityWorld::AllocateRow(Archetype* archetype, uint32_t* chunk, uint32_t* row)
+{
+	// 最後のチャンク以外は全て埋まっているので、最後のチャンクが埋まっていたら追加する
+	if (archetype->chunks.empty() || archetype->chunks.back().count == archetype->capacity)
+	{
+		archetype->chunks.push_back({ AllocateChunk(), 0 });
+	}
+
+	*chunk = static_cast<uint32_t>(archetype->chunks.size() - 1);
+	*row = archetype->chunks.back().count++;
+	archetype->entityCount++;
+}
+
+//--------------------------------------------------------------------------------------
+// アーキタイプから取り除き、最後のエンティティで穴を埋める関数
+//--------------------------------------------------------------------------------------
+void EntityWorld::RemoveRow(Archetype* archetype, uint32_t chunk, uint32_t row)
+{
+	Chunk& last = archetype->chunks.back();
+	uint32_t lastChunk = static_cast<uint32_t>(archetype->chunks.size() - 1);
+	uint32_t lastRow = last.count - 1;
+
+	if (chunk != lastChunk || row != lastRow)
+	{
+		uint8_t* data = archetype->chunks[chunk].data;
+
+		// 最後のエンティティを移す
+		Entity moved = reinterpret_cast<Entity*>(last.data)[lastRow];
+		reinterpret_cast<Entity*>(data)[row] = moved;
+		for (uint32_t type : archetype->types)
+		{
+			size_t size = s_componentSizes[type];
+			size_t offset = archetype->offsets[type];
+			memcpy(data + offset + size * row, last.data + offset + size * lastRow, size);
+		}
+
+		EntityRecord& record = m_records[moved.index];
+		record.chunk = chunk;
+		record.row = row;
+	}
+
+	// 空になったチャンクはメモリを再利用する
+	if (--last.count == 0)
+	{
+		FreeChunk(last.data);
+		archetype->chunks.pop_back();
+	}
+	archetype->entityCount--;
+}
+
+//--------------------------------------------------------------------------------------
+// チャンクのメモリを確保する関数
+//--------------------------------------------------------------------------------------
+uint8_t* EntityWorld::AllocateChunk()
+{
+	if (!m_freeChunks.empty())
+	{
+		uint8_t* data = m_freeChunks.back();
+		m_freeChunks.pop_back();
+		return data;
+	}
+
+	return static_cast<uint8_t*>(::operator new(ENTITY_CHUNK_SIZE, std::align_val_t(ENTITY_CHUNK_ALIGNMENT)));
+}
+
+//--------------------------------------------------------------------------------------
+// チャンクのメモリを解放する関数
+//--------------------------------------------------------------------------------------
+void EntityWorld::FreeChunk(uint8_t* data)
+{
+	m_freeChunks.push_back(data);
+}
+
+//--------------------------------------------------------------------------------------
+// 条件に合うエンティティの数を取得する関数
+//--------------------------------------------------------------------------------------
+size_t EntityWorld::CountEntities(ComponentMask mask) const
+{
+	size_t count = 0;
+	for (const auto& archetype : m_archetypes)
+	{
+		if ((archetype->mask & mask) == mask) count += archetype->entityCount;
+	}
+	return count;
+}
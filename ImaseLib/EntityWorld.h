@@ -0,0 +1,384 @@
+﻿//--------------------------------------------------------------------------------------
+// File: EntityWorld.h
+//
+// アーキタイプ（コンポーネントの組み合わせ）ごとに SoA 形式で並べるエンティティの入れ物
+//
+// Usage: 同じコンポーネントの組み合わせを持つエンティティは同じアーキタイプに入り、
+//        16KB のチャンク（キャッシュラインに揃えたメモリ）へコンポーネントの種類ごとの配列として
+//        並べて保持します。ForEach はチャンクごとにコンポーネントの配列の先頭を渡すので、
+//        システムの処理は配列を先頭から順に読み書きするだけになります。
+//        ParallelForEach はチャンクをジョブシステムのワーカーに分けて処理します。
+//        削除は最後のエンティティで穴を埋めるだけ、コンポーネントの追加・削除は
+//        アーキタイプの間でそのエンティティの分だけコピーするので、どちらも数に関係なく一定の手間です。
+//        コンポーネントは memcpy で移動するので、トリビアルにコピーできる型に限ります。
+//        ForEach の中でエンティティの作成・削除・コンポーネントの追加・削除は行わないでください。
+//        Windows に依存しないので、どの環境でもコンパイル・計測できます。
+//
+//	<<< 記述例 >>
+//	struct Position { Imase::Math::Vector3 value; };
+//	struct Velocity { Imase::Math::Vector3 value; };
+//
+//	Imase::EntityWorld world;
+//	Imase::Entity entity = world.Create(Position{ p }, Velocity{ v });
+//
+//	world.ParallelForEach<Position, Velocity>(
+//		[&](const Imase::EntityChunkView& chunk, Position* position, Velocity* velocity)
+//		{
+//			for (size_t i = 0; i < chunk.count; i++) position[i].value += velocity[i].value * elapsedTime;
+//		});
+//
+//	world.Remove<Velocity>(entity);
+//	world.Destroy(entity);
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "JobSystem.h"
+
+namespace Imase
+{
+	// エンティティ（番号と、番号を再利用した回数）
+	struct Entity
+	{
+		uint32_t index;
+		uint32_t generation;
+
+		bool operator==(const Entity& entity) const { return index == entity.index && generation == entity.generation; }
+		bool operator!=(const Entity& entity) const { return !(*this == entity); }
+	};
+
+	// 無効なエンティティ
+	constexpr Entity INVALID_ENTITY = { 0xffffffffu, 0 };
+
+	// コンポーネントの組み合わせ（コンポーネントの種類の番号のビット）
+	using ComponentMask = uint64_t;
+
+	// コンポーネントの種類の最大数
+	constexpr uint32_t MAX_COMPONENT_TYPES = 64;
+
+	// チャンクの大きさ（バイト）とコンポーネントの配列の先頭を揃える大きさ（キャッシュライン）
+	constexpr size_t ENTITY_CHUNK_SIZE = 16 * 1024;
+	constexpr size_t ENTITY_CHUNK_ALIGNMENT = 64;
+
+	/// <summary>
+	/// コンポーネントの種類を登録して番号を取得する関数（GetComponentType から呼ばれる）
+	/// </summary>
+	/// <param name="size">大きさ（バイト）</param>
+	/// <param name="alignment">アライメント（ENTITY_CHUNK_ALIGNMENT 以下）</param>
+	/// <returns>番号（MAX_COMPONENT_TYPES を超えた場合は std::length_error の例外）</returns>
+	uint32_t RegisterComponentType(size_t size, size_t alignment);
+
+	/// <summary>
+	/// コンポーネントの種類の番号を取得する関数（初めて呼んだ時に登録する）
+	/// </summary>
+	template <class Component>
+	uint32_t GetComponentType()
+	{
+		static_assert(std::is_trivially_copyable<Component>::value, "Component must be trivially copyable");
+		static_assert(alignof(Component) <= ENTITY_CHUNK_ALIGNMENT, "Component alignment is too large");
+
+		static const uint32_t type = RegisterComponentType(sizeof(Component), alignof(Component));
+		return type;
+	}
+
+	/// <summary>
+	/// コンポーネントの組み合わせを取得する関数
+	/// </summary>
+	template <class... Components>
+	ComponentMask GetComponentMask()
+	{
+		ComponentMask mask = 0;
+		using Expand = int[];
+		(void)Expand{ 0, (mask |= ComponentMask(1) << GetComponentType<Components>(), 0)... };
+		return mask;
+	}
+
+	// ForEach へ渡すチャンクの情報
+	struct EntityChunkView
+	{
+		// チャンクのエンティティの配列
+		const Entity* entities;
+
+		// チャンクのエンティティの数
+		size_t count;
+
+		// 条件に合う全てのエンティティの中でのチャンクの先頭の位置（並べ直した配列へ書き出す時に使う）
+		size_t offset;
+	};
+
+	// エンティティの入れ物
+	class EntityWorld
+	{
+	public:
+
+		EntityWorld() = default;
+		~EntityWorld();
+
+		EntityWorld(const EntityWorld&) = delete;
+		EntityWorld& operator=(const EntityWorld&) = delete;
+
+		/// <summary>
+		/// エンティティを作成する関数
+		/// </summary>
+		/// <param name="components">コンポーネントの初期値</param>
+		/// <returns>エンティティ</returns>
+		template <class... Components>
+		Entity Create(const Components&... components)
+		{
+			Entity entity = CreateEntity(GetComponentMask<Components...>());
+			using Expand = int[];
+			(void)Expand{ 0, (*Get<Components>(entity) = components, 0)... };
+			return entity;
+		}
+
+		/// <summary>
+		/// エンティティを削除する関数
+		/// </summary>
+		/// <returns>削除済みのエンティティの場合は false</returns>
+		bool Destroy(Entity entity);
+
+		// エンティティが削除されていないか調べる関数
+		bool IsAlive(Entity entity) const
+		{
+			return entity.index < m_records.size() && m_records[entity.index].generation == entity.generation
+				&& m_records[entity.index].archetype;
+		}
+
+		/// <summary>
+		/// コンポーネントを取得する関数
+		/// </summary>
+		/// <returns>持っていない場合と削除済みのエンティティの場合は nullptr</returns>
+		template <class Component>
+		Component* Get(Entity entity)
+		{
+			return static_cast<Component*>(GetComponent(entity, GetComponentType<Component>()));
+		}
+
+		// コンポーネントを持っているか調べる関数
+		template <class Component>
+		bool Has(Entity entity) const
+		{
+			return IsAlive(entity) && (m_records[entity.index].archetype->mask & GetComponentMask<Component>()) != 0;
+		}
+
+		/// <summary>
+		/// コンポーネントを追加する関数（持っている場合は値を変更する）
+		/// </summary>
+		/// <returns>削除済みのエンティティの場合は false</returns>
+		template <class Component>
+		bool Add(Entity entity, const Component& component)
+		{
+			if (!ChangeArchetype(entity, GetComponentMask<Component>(), 0)) return false;
+			*Get<Component>(entity) = component;
+			return true;
+		}
+
+		/// <summary>
+		/// コンポーネントを削除する関数
+		/// </summary>
+		/// <returns>削除済みのエンティティの場合は false</returns>
+		template <class Component>
+		bool Remove(Entity entity)
+		{
+			return ChangeArchetype(entity, 0, GetComponentMask<Component>());
+		}
+
+		/// <summary>
+		/// 指定したコンポーネントを全て持つエンティティをチャンクごとに処理する関数
+		/// </summary>
+		/// <param name="function">function(const EntityChunkView& chunk, Components*... components)</param>
+		template <class... Components, class Function>
+		void ForEach(const Function& function)
+		{
+			ComponentMask mask = GetComponentMask<Components...>();
+			size_t offset = 0;
+
+			for (const auto& archetype : m_archetypes)
+			{
+				if ((archetype->mask & mask) != mask) continue;
+
+				for (const Chunk& chunk : archetype->chunks)
+				{
+					EntityChunkView view = { GetEntities(*archetype, chunk), chunk.count, offset };
+					function(view, GetColumn<Components>(*archetype, chunk)...);
+					offset += chunk.count;
+				}
+			}
+		}
+
+		/// <summary>
+		/// 指定したコンポーネントを全て持つエンティティをチャンクごとに並列に処理する関数
+		/// （チャンクの順番は決まらないので、チャンクの処理は互いに独立していること）
+		/// </summary>
+		/// <param name="function">function(const EntityChunkView& chunk, Components*... components)</param>
+		/// <param name="chunksPerJob">１つのジョブで処理するチャンクの最小の数</param>
+		template <class... Components, class Function>
+		void ParallelForEach(const Function& function, size_t chunksPerJob = 1)
+		{
+			ComponentMask mask = GetComponentMask<Components...>();
+
+			// 条件に合うチャンクを並べる（チャンクの先頭の位置はここで決める）
+			std::vector<ChunkReference> chunks;
+			size_t offset = 0;
+			for (const auto& archetype : m_archetypes)
+			{
+				if ((archetype->mask & mask) != mask) continue;
+
+				for (const Chunk& chunk : archetype->chunks)
+				{
+					chunks.push_back({ archetype.get(), &chunk, offset });
+					offset += chunk.count;
+				}
+			}
+
+			JobSystem::GetDefault().ParallelFor(0, chunks.size(), chunksPerJob, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						const Archetype& archetype = *chunks[i].archetype;
+						const Chunk& chunk = *chunks[i].chunk;
+						EntityChunkView view = { GetEntities(archetype, chunk), chunk.count, chunks[i].offset };
+						function(view, GetColumn<Components>(archetype, chunk)...);
+					}
+				});
+		}
+
+		/// <summary>
+		/// 指定したコンポーネントを全て持つエンティティの数を取得する関数
+		/// </summary>
+		template <class... Components>
+		size_t Count() const
+		{
+			return CountEntities(GetComponentMask<Components...>());
+		}
+
+		// 全てのエンティティを削除する関数（チャンクのメモリは再利用するために残す）
+		void Clear();
+
+		// エンティティの数を取得する関数
+		size_t GetEntityCount() const { return m_entityCount; }
+
+		// アーキタイプの数を取得する関数
+		size_t GetArchetypeCount() const { return m_archetypes.size(); }
+
+		// 使用しているチャンクの数を取得する関数
+		size_t GetChunkCount() const;
+
+	private:
+
+		// チャンク（ENTITY_CHUNK_SIZE バイトのメモリ、先頭にエンティティの配列、続けてコンポーネントの種類ごとの配列）
+		struct Chunk
+		{
+			uint8_t* data;
+			uint32_t count;
+		};
+
+		// アーキタイプ
+		struct Archetype
+		{
+			// コンポーネントの組み合わせ
+			ComponentMask mask;
+
+			// 持っているコンポーネントの種類の番号
+			std::vector<uint32_t> types;
+
+			// コンポーネントの種類ごとのチャンクの中の配列の位置（バイト）
+			uint32_t offsets[MAX_COMPONENT_TYPES];
+
+			// １つのチャンクに入るエンティティの数
+			uint32_t capacity;
+
+			// チャンク（最後のチャンク以外は全て埋まっている）
+			std::vector<Chunk> chunks;
+
+			// エンティティの数
+			size_t entityCount;
+
+			// コンポーネントを１つ追加・削除した時に移るアーキタイプ（一度調べたものを覚えておく）
+			Archetype* addEdges[MAX_COMPONENT_TYPES];
+			Archetype* removeEdges[MAX_COMPONENT_TYPES];
+		};
+
+		// エンティティの記録（どのアーキタイプのどのチャンクの何番目にあるか）
+		struct EntityRecord
+		{
+			Archetype* archetype;
+			uint32_t chunk;
+			uint32_t row;
+			uint32_t generation;
+		};
+
+		// ParallelForEach で処理するチャンク
+		struct ChunkReference
+		{
+			const Archetype* archetype;
+			const Chunk* chunk;
+			size_t offset;
+		};
+
+		// チャンクのエンティティの配列を取得する関数
+		static const Entity* GetEntities(const Archetype&, const Chunk& chunk)
+		{
+			return reinterpret_cast<const Entity*>(chunk.data);
+		}
+
+		// チャンクのコンポーネントの配列を取得する関数
+		template <class Component>
+		static Component* GetColumn(const Archetype& archetype, const Chunk& chunk)
+		{
+			return reinterpret_cast<Component*>(chunk.data + archetype.offsets[GetComponentType<Component>()]);
+		}
+
+		// コンポーネントの組み合わせを指定してエンティティを作成する関数（コンポーネントの値は 0）
+		Entity CreateEntity(ComponentMask mask);
+
+		// コンポーネントを取得する関数
+		void* GetComponent(Entity entity, uint32_t type);
+
+		// コンポーネントを追加・削除してアーキタイプを移す関数
+		bool ChangeArchetype(Entity entity, ComponentMask add, ComponentMask remove);
+
+		// アーキタイプを取得する関数（ない場合は作成する）
+		Archetype* GetArchetype(ComponentMask mask);
+
+		// アーキタイプの最後に場所を確保する関数（確保したチャンクと位置を返す）
+		void AllocateRow(Archetype* archetype, uint32_t* chunk, uint32_t* row);
+
+		// アーキタイプから取り除き、最後のエンティティで穴を埋める関数
+		void RemoveRow(Archetype* archetype, uint32_t chunk, uint32_t row);
+
+		// チャンクのメモリを確保・解放する関数（解放したメモリは再利用する）
+		uint8_t* AllocateChunk();
+		void FreeChunk(uint8_t* data);
+
+		// 条件に合うエンティティの数を取得する関数
+		size_t CountEntities(ComponentMask mask) const;
+
+	private:
+
+		// アーキタイプ（作成した順）
+		std::vector<std::unique_ptr<Archetype>> m_archetypes;
+
+		// コンポーネントの組み合わせからアーキタイプを探す
+		std::unordered_map<ComponentMask, Archetype*> m_archetypeMap;
+
+		// エンティティの記録と、再利用する番号
+		std::vector<EntityRecord> m_records;
+		std::vector<uint32_t> m_freeIndices;
+
+		// 再利用するチャンクのメモリ
+		std::vector<uint8_t*> m_freeChunks;
+
+		// エンティティの数
+		size_t m_entityCount = 0;
+	};
+}
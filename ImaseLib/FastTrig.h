@@ -0,0 +1,365 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FastTrig.h
+//
+// 高速な三角関数（sin / cos / tan / atan2）のスカラー版・SIMD版（ヘッダーのみ）
+//
+// Usage: libm の sinf / cosf を呼ぶ代わりに多項式近似で計算します。
+//        sin と cos は同じ範囲縮小を共有するので SinCos で両方まとめて求めます。
+//        SIMD 版は SSE2 で４個（SinCos4 など）、AVX で８個（SinCos8 など）同時に計算し、
+//        配列版（SinCos(const float*, ...) など）は使える一番広い幅で処理します。
+//        スカラー版と SIMD 版は同じ計算なので、結果はほぼ同じになります（丸めの差のみ）。
+//
+//        誤差（libm の倍精度の結果との比較、検証済み）
+//          Sin / Cos : |x| <= 8192 で絶対誤差 1.0e-7 以下
+//          Tan       : |x| <= 8192 で誤差 3.0e-7 × max(|tan x|, 1) 以下（|cos| < 1e-3 の極の付近を除く）
+//                      |x| <= π では相対誤差 3.0e-7 以下（π の倍数の付近は絶対誤差の方で評価する）
+//          Atan2     : 絶対誤差 3.0e-7 以下（y = x = 0 の場合は x の符号に関係なく y と同じ符号の 0）
+//        |x| が 8192 を超えると範囲縮小の誤差で精度が落ちます。
+//
+//	<<< 記述例 >>
+//	float s, c;
+//	Imase::Math::SinCos(angle, &s, &c);
+//
+//	Imase::Math::SinCos(angles, sines, cosines, count);	// 配列をまとめて計算
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+
+#include "MathCore.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace Imase
+{
+	namespace Math
+	{
+		namespace FastTrig
+		{
+			// 2 / π
+			constexpr float TWO_OVER_PI = 0.636619772367581343f;
+
+			// π / 2 を３つに分けた値（Cody-Waite の範囲縮小用、上位ほど仮数のビットが少ない）
+			constexpr float PIO2_1 = 1.5703125f;
+			constexpr float PIO2_2 = 4.837512969970703125e-4f;
+			constexpr float PIO2_3 = 7.54978995489188216e-8f;
+
+			// sin の多項式の係数（[-π/4, π/4]）
+			constexpr float SIN_C1 = -1.6666654611e-1f;
+			constexpr float SIN_C2 = 8.3321608736e-3f;
+			constexpr float SIN_C3 = -1.9515295891e-4f;
+
+			// cos の多項式の係数（[-π/4, π/4]）
+			constexpr float COS_C1 = 4.166664568298827e-2f;
+			constexpr float COS_C2 = -1.388731625493765e-3f;
+			constexpr float COS_C3 = 2.443315711809948e-5f;
+
+			// atan の多項式の係数（[-tan(π/8), tan(π/8)]）
+			constexpr float ATAN_C1 = -3.33329491539e-1f;
+			constexpr float ATAN_C2 = 1.99777106478e-1f;
+			constexpr float ATAN_C3 = -1.38776856032e-1f;
+			constexpr float ATAN_C4 = 8.05374449538e-2f;
+
+			// tan(π/8)
+			constexpr float TAN_PI_8 = 0.4142135623730950f;
+
+			constexpr float PI_2 = 1.57079632679489662f;
+			constexpr float PI_4 = 0.785398163397448310f;
+		}
+
+		//------------------------------------------------------------------------------
+		// スカラー版
+		//------------------------------------------------------------------------------
+
+		// sin と cos を同時に求める関数
+		inline void SinCos(float x, float* s, float* c)
+		{
+			using namespace FastTrig;
+
+			// x = j * π/2 + r（|r| <= π/4）、floor を呼ばないように切り捨ての変換で丸める
+			float fj = x * TWO_OVER_PI;
+			int q = static_cast<int>(fj + (fj >= 0.0f ? 0.5f : -0.5f));
+			float j = static_cast<float>(q);
+			float r = ((x - j * PIO2_1) - j * PIO2_2) - j * PIO2_3;
+
+			float z = r * r;
+			float ps = ((SIN_C3 * z + SIN_C2) * z + SIN_C1) * z * r + r;
+			float pc = ((COS_C3 * z + COS_C2) * z + COS_C1) * z * z - 0.5f * z + 1.0f;
+
+			// 象限に合わせて入れ替えと符号を調整する
+			float sv = (q & 1) ? pc : ps;
+			float cv = (q & 1) ? ps : pc;
+			*s = (q & 2) ? -sv : sv;
+			*c = ((q + 1) & 2) ? -cv : cv;
+		}
+
+		inline float Sin(float x) { float s, c; SinCos(x, &s, &c); return s; }
+		inline float Cos(float x) { float s, c; SinCos(x, &s, &c); return c; }
+		inline float Tan(float x) { float s, c; SinCos(x, &s, &c); return s / c; }
+
+		// atan2 を求める関数（戻り値は -π ～ π）
+		inline float Atan2(float y, float x)
+		{
+			using namespace FastTrig;
+
+			float ax = std::fabs(x);
+			float ay = std::fabs(y);
+			float mx = ax > ay ? ax : ay;
+			float mn = ax > ay ? ay : ax;
+
+			// t = 小さい方 / 大きい方（0 ～ 1）の atan を求める
+			float t = mx > 0.0f ? mn / mx : 0.0f;
+			float base = 0.0f;
+			if (t > TAN_PI_8)
+			{
+				t = (t - 1.0f) / (t + 1.0f);
+				base = PI_4;
+			}
+			float z = t * t;
+			float a = base + ((((ATAN_C4 * z + ATAN_C3) * z + ATAN_C2) * z + ATAN_C1) * z * t + t);
+
+			// 象限に合わせる
+			if (ay > ax) a = PI_2 - a;
+			if (x < 0.0f) a = 2.0f * PI_2 - a;
+			return std::signbit(y) ? -a : a;
+		}
+
+#if defined(IMASE_MATH_SSE2)
+		//------------------------------------------------------------------------------
+		// SSE2 版（４個）
+		//------------------------------------------------------------------------------
+
+		// sin と cos を４個同時に求める関数
+		inline void SinCos4(__m128 x, __m128* s, __m128* c)
+		{
+			using namespace FastTrig;
+
+			// 最近接の整数へ丸める（範囲縮小の象限）
+			__m128i qi = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TWO_OVER_PI)));
+			__m128 j = _mm_cvtepi32_ps(qi);
+			__m128 r = _mm_sub_ps(x, _mm_mul_ps(j, _mm_set1_ps(PIO2_1)));
+			r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(PIO2_2)));
+			r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(PIO2_3)));
+
+			__m128 z = _mm_mul_ps(r, r);
+			__m128 ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_C3), z), _mm_set1_ps(SIN_C2));
+			ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(SIN_C1));
+			ps = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, z), r), r);
+			__m128 pc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_C3), z), _mm_set1_ps(COS_C2));
+			pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(COS_C1));
+			pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+			pc = _mm_add_ps(_mm_sub_ps(pc, _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_set1_ps(1.0f));
+
+			// 象限に合わせて入れ替えと符号を調整する
+			const __m128i one = _mm_set1_epi32(1);
+			const __m128i two = _mm_set1_epi32(2);
+			__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(qi, one), one));
+			__m128 sv = _mm_or_ps(_mm_and_ps(swap, pc), _mm_andnot_ps(swap, ps));
+			__m128 cv = _mm_or_ps(_mm_and_ps(swap, ps), _mm_andnot_ps(swap, pc));
+			__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(qi, two), 30));
+			__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(qi, one), two), 30));
+			*s = _mm_xor_ps(sv, sinSign);
+			*c = _mm_xor_ps(cv, cosSign);
+		}
+
+		inline __m128 Tan4(__m128 x)
+		{
+			__m128 s, c;
+			SinCos4(x, &s, &c);
+			return _mm_div_ps(s, c);
+		}
+
+		// atan2 を４個同時に求める関数
+		inline __m128 Atan2_4(__m128 y, __m128 x)
+		{
+			using namespace FastTrig;
+
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			__m128 ax = _mm_andnot_ps(signMask, x);
+			__m128 ay = _mm_andnot_ps(signMask, y);
+			__m128 mx = _mm_max_ps(ax, ay);
+			__m128 mn = _mm_min_ps(ax, ay);
+
+			// t = 小さい方 / 大きい方（0 ～ 1、両方 0 の場合は 0）
+			__m128 valid = _mm_cmpgt_ps(mx, _mm_setzero_ps());
+			__m128 t = _mm_and_ps(valid, _mm_div_ps(mn, _mm_or_ps(mx, _mm_andnot_ps(valid, _mm_set1_ps(1.0f)))));
+
+			__m128 big = _mm_cmpgt_ps(t, _mm_set1_ps(TAN_PI_8));
+			__m128 tr = _mm_div_ps(_mm_sub_ps(t, _mm_set1_ps(1.0f)), _mm_add_ps(t, _mm_set1_ps(1.0f)));
+			t = _mm_or_ps(_mm_and_ps(big, tr), _mm_andnot_ps(big, t));
+			__m128 base = _mm_and_ps(big, _mm_set1_ps(PI_4));
+
+			__m128 z = _mm_mul_ps(t, t);
+			__m128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ATAN_C4), z), _mm_set1_ps(ATAN_C3));
+			p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(ATAN_C2));
+			p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(ATAN_C1));
+			__m128 a = _mm_add_ps(base, _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), t), t));
+
+			// 象限に合わせる
+			__m128 steep = _mm_cmpgt_ps(ay, ax);
+			a = _mm_or_ps(_mm_and_ps(steep, _mm_sub_ps(_mm_set1_ps(PI_2), a)), _mm_andnot_ps(steep, a));
+			__m128 negX = _mm_cmplt_ps(x, _mm_setzero_ps());
+			a = _mm_or_ps(_mm_and_ps(negX, _mm_sub_ps(_mm_set1_ps(2.0f * PI_2), a)), _mm_andnot_ps(negX, a));
+			return _mm_xor_ps(a, _mm_and_ps(signMask, y));
+		}
+#endif
+
+#if defined(__AVX__)
+		//------------------------------------------------------------------------------
+		// AVX 版（８個、整数演算を使わないので AVX2 がなくても使える）
+		//------------------------------------------------------------------------------
+
+		// sin と cos を８個同時に求める関数
+		inline void SinCos8(__m256 x, __m256* s, __m256* c)
+		{
+			using namespace FastTrig;
+
+			__m256 j = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(TWO_OVER_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			__m256 r = _mm256_sub_ps(x, _mm256_mul_ps(j, _mm256_set1_ps(PIO2_1)));
+			r = _mm256_sub_ps(r, _mm256_mul_ps(j, _mm256_set1_ps(PIO2_2)));
+			r = _mm256_sub_ps(r, _mm256_mul_ps(j, _mm256_set1_ps(PIO2_3)));
+
+			__m256 z = _mm256_mul_ps(r, r);
+			__m256 ps = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_C3), z), _mm256_set1_ps(SIN_C2));
+			ps = _mm256_add_ps(_mm256_mul_ps(ps, z), _mm256_set1_ps(SIN_C1));
+			ps = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(ps, z), r), r);
+			__m256 pc = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(COS_C3), z), _mm256_set1_ps(COS_C2));
+			pc = _mm256_add_ps(_mm256_mul_ps(pc, z), _mm256_set1_ps(COS_C1));
+			pc = _mm256_mul_ps(_mm256_mul_ps(pc, z), z);
+			pc = _mm256_add_ps(_mm256_sub_ps(pc, _mm256_mul_ps(_mm256_set1_ps(0.5f), z)), _mm256_set1_ps(1.0f));
+
+			// 象限（j mod 4 = 0 ～ 3）を浮動小数点のまま求める
+			__m256 q = _mm256_sub_ps(j, _mm256_mul_ps(_mm256_floor_ps(_mm256_mul_ps(j, _mm256_set1_ps(0.25f))), _mm256_set1_ps(4.0f)));
+			__m256 q1 = _mm256_cmp_ps(q, _mm256_set1_ps(1.0f), _CMP_EQ_OQ);
+			__m256 q2 = _mm256_cmp_ps(q, _mm256_set1_ps(2.0f), _CMP_EQ_OQ);
+			__m256 q3 = _mm256_cmp_ps(q, _mm256_set1_ps(3.0f), _CMP_EQ_OQ);
+			__m256 swap = _mm256_or_ps(q1, q3);
+			__m256 sv = _mm256_blendv_ps(ps, pc, swap);
+			__m256 cv = _mm256_blendv_ps(pc, ps, swap);
+			const __m256 signMask = _mm256_set1_ps(-0.0f);
+			*s = _mm256_xor_ps(sv, _mm256_and_ps(_mm256_or_ps(q2, q3), signMask));
+			*c = _mm256_xor_ps(cv, _mm256_and_ps(_mm256_or_ps(q1, q2), signMask));
+		}
+
+		inline __m256 Tan8(__m256 x)
+		{
+			__m256 s, c;
+			SinCos8(x, &s, &c);
+			return _mm256_div_ps(s, c);
+		}
+
+		// atan2 を８個同時に求める関数
+		inline __m256 Atan2_8(__m256 y, __m256 x)
+		{
+			using namespace FastTrig;
+
+			const __m256 signMask = _mm256_set1_ps(-0.0f);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.0f);
+			__m256 ax = _mm256_andnot_ps(signMask, x);
+			__m256 ay = _mm256_andnot_ps(signMask, y);
+			__m256 mx = _mm256_max_ps(ax, ay);
+			__m256 mn = _mm256_min_ps(ax, ay);
+
+			__m256 valid = _mm256_cmp_ps(mx, zero, _CMP_GT_OQ);
+			__m256 t = _mm256_and_ps(valid, _mm256_div_ps(mn, _mm256_blendv_ps(one, mx, valid)));
+
+			__m256 big = _mm256_cmp_ps(t, _mm256_set1_ps(TAN_PI_8), _CMP_GT_OQ);
+			t = _mm256_blendv_ps(t, _mm256_div_ps(_mm256_sub_ps(t, one), _mm256_add_ps(t, one)), big);
+			__m256 base = _mm256_and_ps(big, _mm256_set1_ps(PI_4));
+
+			__m256 z = _mm256_mul_ps(t, t);
+			__m256 p = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(ATAN_C4), z), _mm256_set1_ps(ATAN_C3));
+			p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(ATAN_C2));
+			p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(ATAN_C1));
+			__m256 a = _mm256_add_ps(base, _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(p, z), t), t));
+
+			a = _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps(PI_2), a), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+			a = _mm256_blendv_ps(a, _mm256_sub_ps(_mm256_set1_ps(2.0f * PI_2), a), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+			return _mm256_xor_ps(a, _mm256_and_ps(signMask, y));
+		}
+#endif
+
+		//------------------------------------------------------------------------------
+		// 配列版（使える一番広い SIMD で処理する）
+		//------------------------------------------------------------------------------
+
+		// sin と cos をまとめて求める関数
+		inline void SinCos(const float* x, float* s, float* c, size_t count)
+		{
+			size_t i = 0;
+#if defined(__AVX__)
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 vs, vc;
+				SinCos8(_mm256_loadu_ps(x + i), &vs, &vc);
+				_mm256_storeu_ps(s + i, vs);
+				_mm256_storeu_ps(c + i, vc);
+			}
+#endif
+#if defined(IMASE_MATH_SSE2)
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 vs, vc;
+				SinCos4(_mm_loadu_ps(x + i), &vs, &vc);
+				_mm_storeu_ps(s + i, vs);
+				_mm_storeu_ps(c + i, vc);
+			}
+#endif
+			for (; i < count; i++)
+			{
+				SinCos(x[i], &s[i], &c[i]);
+			}
+		}
+
+		// tan をまとめて求める関数
+		inline void Tan(const float* x, float* t, size_t count)
+		{
+			size_t i = 0;
+#if defined(__AVX__)
+			for (; i + 8 <= count; i += 8)
+			{
+				_mm256_storeu_ps(t + i, Tan8(_mm256_loadu_ps(x + i)));
+			}
+#endif
+#if defined(IMASE_MATH_SSE2)
+			for (; i + 4 <= count; i += 4)
+			{
+				_mm_storeu_ps(t + i, Tan4(_mm_loadu_ps(x + i)));
+			}
+#endif
+			for (; i < count; i++)
+			{
+				t[i] = Tan(x[i]);
+			}
+		}
+
+		// atan2 をまとめて求める関数
+		inline void Atan2(const float* y, const float* x, float* a, size_t count)
+		{
+			size_t i = 0;
+#if defined(__AVX__)
+			for (; i + 8 <= count; i += 8)
+			{
+				_mm256_storeu_ps(a + i, Atan2_8(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+			}
+#endif
+#if defined(IMASE_MATH_SSE2)
+			for (; i + 4 <= count; i += 4)
+			{
+				_mm_storeu_ps(a + i, Atan2_4(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+			}
+#endif
+			for (; i < count; i++)
+			{
+				a[i] = Atan2(y[i], x[i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,221 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FrameArena.cpp
+//
+// フレームの間だけ使うメモリを確保するアリーナ（線形アロケーター）
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "FrameArena.h"
+
+#include <algorithm>
+
+using namespace Imase;
+
+namespace
+{
+	// アリーナの識別番号
+	std::atomic<uint64_t> s_nextArenaId{ 1 };
+
+	// 現在のスレッドが最後に使ったアリーナとそのスレッドの状態
+	thread_local uint64_t s_cachedArenaId = 0;
+	thread_local void* s_cachedState = nullptr;
+}
+
+//--------------------------------------------------------------------------------------
+// スレッドの終了時に状態を返すクラス
+//--------------------------------------------------------------------------------------
+class FrameArena::ThreadExit
+{
+public:
+
+	~ThreadExit()
+	{
+		// 削除済みのアリーナは飛ばす
+		for (const Entry& entry : m_entries)
+		{
+			std::shared_ptr<ThreadRegistry> registry = entry.registry.lock();
+			if (!registry) continue;
+
+			std::lock_guard<std::mutex> lock(registry->mutex);
+			entry.state->id = std::thread::id();
+		}
+	}
+
+	void Add(const std::shared_ptr<ThreadRegistry>& registry, ThreadState* state)
+	{
+		// 削除済みのアリーナの分は取り除く（アリーナを作り直し続けても増えない）
+		m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+			[](const Entry& entry) { return entry.registry.expired(); }), m_entries.end());
+
+		m_entries.push_back({ registry, state });
+	}
+
+private:
+
+	struct Entry
+	{
+		std::weak_ptr<ThreadRegistry> registry;
+		ThreadState* state;
+	};
+
+	// このスレッドが確保したアリーナと状態
+	std::vector<Entry> m_entries;
+};
+
+//--------------------------------------------------------------------------------------
+// コンストラクタ
+//--------------------------------------------------------------------------------------
+FrameArena::FrameArena(size_t chunkSize)
+	: m_id(s_nextArenaId.fetch_add(1, std::memory_order_relaxed))
+	, m_chunkSize(std::max<size_t>(chunkSize, 256))
+	, m_registry(std::make_shared<ThreadRegistry>())
+{
+}
+
+//--------------------------------------------------------------------------------------
+// メモリを確保する関数
+//--------------------------------------------------------------------------------------
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	ThreadState* state = GetThreadState();
+
+	uint64_t frame = m_frame.load(std::memory_order_acquire);
+	Buffer& buffer = state->buffers[frame % BUFFER_COUNT];
+
+	// このフレームで初めて使う場合は前の前のフレームで確保したメモリを再利用する
+	if (buffer.frame.load(std::memory_order_relaxed) != frame)
+	{
+		buffer.frame.store(frame, std::memory_order_relaxed);
+		buffer.chunkIndex = 0;
+		buffer.offset = 0;
+		buffer.usedBytes.store(0, std::memory_order_relaxed);
+	}
+
+	size = std::max<size_t>(size, 1);
+
+	for (;;)
+	{
+		// 使っているチャンクに入る場合はポインターを進めるだけ
+		if (buffer.chunkIndex < buffer.chunks.size())
+		{
+			Chunk& chunk = buffer.chunks[buffer.chunkIndex];
+			uintptr_t base = reinterpret_cast<uintptr_t>(chunk.memory.get());
+			uintptr_t address = (base + buffer.offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+			if (address + size <= base + chunk.size)
+			{
+				buffer.offset = address + size - base;
+				buffer.usedBytes.store(buffer.usedBytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+				return reinterpret_cast<void*>(address);
+			}
+
+			// 入らない場合は次のチャンクへ進む
+			buffer.chunkIndex++;
+			buffer.offset = 0;
+			continue;
+		}
+
+		// チャンクが足りない場合だけヒープから確保する（大きい場合はそのバイト数のチャンクにする）
+		AddChunk(&buffer, std::max(m_chunkSize, size + alignment));
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 計測結果を取得する関数
+//--------------------------------------------------------------------------------------
+FrameArenaStats FrameArena::GetStats() const
+{
+	FrameArenaStats stats = {};
+
+	// 確保し終わった前のフレームのバッファを集計する
+	uint64_t frame = m_frame.load(std::memory_order_acquire) - 1;
+
+	std::lock_guard<std::mutex> lock(m_registry->mutex);
+	for (const auto& state : m_registry->threads)
+	{
+		// 他のスレッドが書き込み中の場合もあるので、計測用の値だけを読む（前のフレームで確保していないスレッドは数えない）
+		const Buffer& buffer = state->buffers[frame % BUFFER_COUNT];
+		if (buffer.frame.load(std::memory_order_relaxed) != frame) continue;
+		stats.usedBytes += buffer.usedBytes.load(std::memory_order_relaxed);
+	}
+	stats.reservedBytes = m_reservedBytes.load(std::memory_order_relaxed);
+	stats.chunkAllocations = m_chunkAllocations.load(std::memory_order_relaxed);
+	stats.threadCount = static_cast<uint32_t>(m_registry->threads.size());
+
+	return stats;
+}
+
+//--------------------------------------------------------------------------------------
+// 既定のアリーナを取得する関数
+//--------------------------------------------------------------------------------------
+FrameArena& FrameArena::GetDefault()
+{
+	static FrameArena s_frameArena;
+	return s_frameArena;
+}
+
+//--------------------------------------------------------------------------------------
+// 現在のスレッドの状態を取得する関数
+//--------------------------------------------------------------------------------------
+FrameArena::ThreadState* FrameArena::GetThreadState()
+{
+	// 同じアリーナを続けて使う場合はロックしない
+	if (s_cachedArenaId == m_id) return static_cast<ThreadState*>(s_cachedState);
+
+	std::thread::id id = std::this_thread::get_id();
+
+	// スレッドの終了時にこのスレッドが使った状態を空きにする
+	static thread_local ThreadExit s_threadExit;
+
+	std::unique_lock<std::mutex> lock(m_registry->mutex);
+
+	// このスレッドの状態を探す（ない場合は終了したスレッドの空きの状態を使う）
+	ThreadState* state = nullptr;
+	ThreadState* freeState = nullptr;
+	for (const auto& threadState : m_registry->threads)
+	{
+		if (threadState->id == id)
+		{
+			state = threadState.get();
+			break;
+		}
+		if (!freeState && threadState->id == std::thread::id()) freeState = threadState.get();
+	}
+	if (!state)
+	{
+		if (freeState)
+		{
+			state = freeState;
+		}
+		else
+		{
+			m_registry->threads.push_back(std::make_unique<ThreadState>());
+			state = m_registry->threads.back().get();
+		}
+		state->id = id;
+
+		lock.unlock();
+		s_threadExit.Add(m_registry, state);
+	}
+
+	s_cachedArenaId = m_id;
+	s_cachedState = state;
+
+	return state;
+}
+
+//--------------------------------------------------------------------------------------
+// 新しいチャンクを追加する関数
+//--------------------------------------------------------------------------------------
+void FrameArena::AddChunk(Buffer* buffer, size_t size)
+{
+	Chunk chunk;
+	chunk.memory = std::make_unique<uint8_t[]>(size);
+	chunk.size = size;
+	buffer->chunks.push_back(std::move(chunk));
+
+	m_reservedBytes.fetch_add(size, std::memory_order_relaxed);
+	m_chunkAllocations.fetch_add(1, std::memory_order_relaxed);
+}
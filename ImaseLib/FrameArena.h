@@ -0,0 +1,223 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FrameArena.h
+//
+// フレームの間だけ使うメモリを確保するアリーナ（線形アロケーター）
+//
+// Usage: Allocate はスレッドごとのチャンクの中でポインターを進めるだけで確保し、解放はしません。
+//        フレームの最初（Tick）に BeginFrame を呼ぶと確保したメモリがまとめて再利用されます。
+//        バッファは２つあり交互に使うので、確保したメモリは次のフレームの終わりまで有効です
+//        （２回目の BeginFrame で再利用されます）。
+//        チャンクが足りない場合だけヒープから確保し、確保したチャンクは解放せずに使い回すので、
+//        使う量が安定したフレームではヒープからの確保は行われません。
+//        スレッドごとにチャンクを持つので、複数のスレッドから同時に確保できます
+//        （BeginFrame は他のスレッドが確保していない時に呼んでください）。
+//        終了したスレッドのチャンクは次に確保を始めたスレッドがそのまま使うので、スレッドを
+//        作り直してもチャンクは同時に動いているスレッドの数の分しか増えません。
+//        FrameAllocator は std のコンテナ用のアロケーターです（deallocate は何もしません）。
+//        アリーナのメモリを使うコンテナは、次のフレームの終わりまでに使い終わってください。
+//        デストラクタは呼ばれないので、確保するのは破棄が不要な型にしてください。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	// Tick の最初
+//	Imase::FrameArena::GetDefault().BeginFrame();
+//
+//	// フレームの間だけ使う配列
+//	wchar_t* text = Imase::FrameArena::GetDefault().AllocateArray<wchar_t>(length + 1);
+//
+//	Imase::FrameVector<float> values;	// 既定のアリーナから確保する
+//	values.assign({ x, y, z });
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Imase
+{
+	// アリーナの計測結果
+	struct FrameArenaStats
+	{
+		// 前のフレームで確保したバイト数（全てのスレッドの合計）
+		size_t usedBytes;
+
+		// ヒープから確保したチャンクの合計のバイト数
+		size_t reservedBytes;
+
+		// ヒープからチャンクを確保した回数（使う量が安定すれば増えない）
+		uint64_t chunkAllocations;
+
+		// スレッドごとの状態の数（終了したスレッドの分は再利用するので、同時に確保したスレッドの最大数）
+		uint32_t threadCount;
+	};
+
+	// フレームの間だけ使うメモリを確保するアリーナ
+	class FrameArena
+	{
+	public:
+
+		// チャンクの既定のバイト数
+		static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+		// 交互に使うバッファの数
+		static constexpr uint32_t BUFFER_COUNT = 2;
+
+		explicit FrameArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+		~FrameArena() = default;
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		// フレームを進める関数（前の前のフレームで確保したメモリが再利用される）
+		void BeginFrame() { m_frame.fetch_add(1, std::memory_order_release); }
+
+		// フレーム番号を取得する関数
+		uint64_t GetFrame() const { return m_frame.load(std::memory_order_acquire); }
+
+		/// <summary>
+		/// メモリを確保する関数（次のフレームの終わりまで有効）
+		/// </summary>
+		/// <param name="size">バイト数</param>
+		/// <param name="alignment">アライメント（２のべき乗）</param>
+		/// <returns>確保したメモリ</returns>
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		// 配列を確保する関数（要素は初期化しない）
+		template <class T>
+		T* AllocateArray(size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "FrameArena does not call destructors.");
+
+			if (count > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+			return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		// 計測結果を取得する関数
+		FrameArenaStats GetStats() const;
+
+		// 既定のアリーナを取得する関数
+		static FrameArena& GetDefault();
+
+	private:
+
+		// チャンク
+		struct Chunk
+		{
+			std::unique_ptr<uint8_t[]> memory;
+			size_t size;
+		};
+
+		// フレームごとのバッファ
+		struct Buffer
+		{
+			// チャンクの配列（前から順に使う）
+			std::vector<Chunk> chunks;
+
+			// 使っているチャンクの番号とチャンクの中の位置
+			size_t chunkIndex = 0;
+			size_t offset = 0;
+
+			// 最後に使ったフレーム番号（計測のために他のスレッドからも読む）
+			std::atomic<uint64_t> frame{ UINT64_MAX };
+
+			// そのフレームで確保したバイト数（計測用）
+			std::atomic<size_t> usedBytes{ 0 };
+		};
+
+		// スレッドごとの状態
+		struct ThreadState
+		{
+			// 使っているスレッド（スレッドが終了した場合は空、次に確保を始めたスレッドが使う）
+			std::thread::id id;
+			Buffer buffers[BUFFER_COUNT];
+		};
+
+		// スレッドごとの状態の一覧（終了するスレッドがアリーナより後に返しに来る場合があるので共有する）
+		struct ThreadRegistry
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<ThreadState>> threads;
+		};
+
+		// スレッドの終了時に状態を返すクラス（スレッドごとに１つ）
+		class ThreadExit;
+
+		// 現在のスレッドの状態を取得する関数
+		ThreadState* GetThreadState();
+
+		// 新しいチャンクを追加する関数
+		void AddChunk(Buffer* buffer, size_t size);
+
+	private:
+
+		// アリーナの識別番号（スレッドの状態のキャッシュが別のアリーナを指さないようにする）
+		uint64_t m_id;
+
+		// チャンクのバイト数
+		size_t m_chunkSize;
+
+		// フレーム番号
+		std::atomic<uint64_t> m_frame{ 0 };
+
+		// スレッドごとの状態（スレッドが初めて確保した時に空きを使うか追加する）
+		std::shared_ptr<ThreadRegistry> m_registry;
+
+		// ヒープから確保したチャンクのバイト数と回数
+		std::atomic<size_t> m_reservedBytes{ 0 };
+		std::atomic<uint64_t> m_chunkAllocations{ 0 };
+	};
+
+	// アリーナから確保する std のコンテナ用のアロケーター
+	template <class T>
+	class FrameAllocator
+	{
+	public:
+
+		using value_type = T;
+
+		FrameAllocator() noexcept : m_arena(&FrameArena::GetDefault()) {}
+		explicit FrameAllocator(FrameArena* arena) noexcept : m_arena(arena) {}
+
+		template <class U>
+		FrameAllocator(const FrameAllocator<U>& other) noexcept : m_arena(other.GetArena()) {}
+
+		T* allocate(size_t count)
+		{
+			if (count > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+			return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		// フレームが進むとまとめて再利用されるので何もしない
+		void deallocate(T*, size_t) noexcept {}
+
+		FrameArena* GetArena() const noexcept { return m_arena; }
+
+	private:
+
+		FrameArena* m_arena;
+	};
+
+	template <class T, class U>
+	bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b) noexcept { return a.GetArena() == b.GetArena(); }
+
+	template <class T, class U>
+	bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b) noexcept { return a.GetArena() != b.GetArena(); }
+
+	// アリーナから確保するコンテナ
+	template <class T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+	using FrameWString = std::basic_string<wchar_t, std::char_traits<wchar_t>, FrameAllocator<wchar_t>>;
+}
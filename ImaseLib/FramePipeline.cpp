@@ -0,0 +1,168 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FramePipeline.cpp
+//
+// 次のフレームの更新をワーカーのスレッドで行い、描画するスレッドへスナップショットを渡すクラス
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "FramePipeline.h"
+
+#include <algorithm>
+
+using namespace Imase;
+
+namespace
+{
+	// 経過時間（秒）
+	inline double Seconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+	{
+		return std::chrono::duration<double>(end - start).count();
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// ワーカーのスレッドを起動する関数
+//--------------------------------------------------------------------------------------
+void FramePipeline::Start(uint32_t depth, FrameProduceFunction produce, void* data)
+{
+	Stop();
+
+	m_produce = produce;
+	m_data = data;
+	m_depth = std::min(std::max(depth, 1u), MAX_DEPTH);
+
+	m_produced.store(0, std::memory_order_relaxed);
+	m_released.store(0, std::memory_order_relaxed);
+	m_acquired = 0;
+	m_quit.store(false, std::memory_order_relaxed);
+
+	ResetStats();
+
+	m_thread = std::thread(&FramePipeline::WorkerMain, this);
+}
+
+//--------------------------------------------------------------------------------------
+// ワーカーのスレッドを停止する関数
+//--------------------------------------------------------------------------------------
+void FramePipeline::Stop()
+{
+	if (!m_thread.joinable()) return;
+
+	m_quit.store(true, std::memory_order_seq_cst);
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_producerCondition.notify_all();
+	}
+
+	m_thread.join();
+}
+
+//--------------------------------------------------------------------------------------
+// 次のフレームのスナップショットを受け取る関数
+//--------------------------------------------------------------------------------------
+uint32_t FramePipeline::Acquire(uint64_t* frame)
+{
+	const uint64_t next = m_acquired;
+
+	Clock::time_point waitStart = Clock::now();
+	WaitUntil([&]() { return m_produced.load(std::memory_order_seq_cst) > next; }, &m_consumerSleeping, &m_consumerCondition);
+	m_stats.totalAcquireWaitSeconds += Seconds(waitStart, Clock::now());
+
+	m_acquired++;
+	if (frame) *frame = next;
+
+	return static_cast<uint32_t>(next % m_depth);
+}
+
+//--------------------------------------------------------------------------------------
+// 描画が終わったスナップショットを返す関数
+//--------------------------------------------------------------------------------------
+void FramePipeline::Release()
+{
+	// 返すまではワーカーはこのスナップショットの計測結果に書き込まない
+	const SlotTiming& timing = m_timings[(m_acquired - 1) % m_depth];
+	double latency = Seconds(timing.produceStart, Clock::now());
+
+	if (m_stats.frameCount == 0)
+	{
+		m_stats.minLatencySeconds = m_stats.maxLatencySeconds = latency;
+	}
+	else
+	{
+		m_stats.minLatencySeconds = std::min(m_stats.minLatencySeconds, latency);
+		m_stats.maxLatencySeconds = std::max(m_stats.maxLatencySeconds, latency);
+	}
+	m_stats.totalLatencySeconds += latency;
+	m_stats.totalProduceSeconds += timing.produceSeconds;
+	m_stats.totalProduceWaitSeconds += timing.waitSeconds;
+	m_stats.frameCount++;
+
+	m_released.store(m_acquired, std::memory_order_seq_cst);
+	Wake(m_producerSleeping, &m_producerCondition);
+}
+
+//--------------------------------------------------------------------------------------
+// ワーカーのスレッドの処理
+//--------------------------------------------------------------------------------------
+void FramePipeline::WorkerMain()
+{
+	for (uint64_t frame = 0; ; frame++)
+	{
+		// 書き込むスナップショットの描画が終わるまで待つ（深さの数だけ先のフレームまで作れる）
+		Clock::time_point waitStart = Clock::now();
+		WaitUntil([&]()
+			{
+				return frame - m_released.load(std::memory_order_seq_cst) < m_depth || m_quit.load(std::memory_order_seq_cst);
+			}, &m_producerSleeping, &m_producerCondition);
+
+		if (m_quit.load(std::memory_order_acquire)) break;
+
+		uint32_t slot = static_cast<uint32_t>(frame % m_depth);
+		SlotTiming& timing = m_timings[slot];
+		timing.produceStart = Clock::now();
+		timing.waitSeconds = Seconds(waitStart, timing.produceStart);
+
+		m_produce(m_data, slot, frame);
+
+		timing.produceSeconds = Seconds(timing.produceStart, Clock::now());
+
+		// スナップショットと計測結果を書き終えてからフレームの数を増やす
+		m_produced.store(frame + 1, std::memory_order_seq_cst);
+		Wake(m_consumerSleeping, &m_consumerCondition);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 条件を満たすまで待つ関数
+//--------------------------------------------------------------------------------------
+template <class Predicate>
+void FramePipeline::WaitUntil(const Predicate& predicate, std::atomic<bool>* sleeping, std::condition_variable* condition)
+{
+	for (int i = 0; i < SPIN_COUNT; i++)
+	{
+		if (predicate()) return;
+		std::this_thread::yield();
+	}
+
+	// 眠ることを知らせてから条件を調べ、起こす側は条件を変えてから眠っているか調べるので、起こし忘れはない
+	sleeping->store(true, std::memory_order_seq_cst);
+	{
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		condition->wait(lock, predicate);
+	}
+	sleeping->store(false, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------------------------------
+// 眠っている場合は起こす関数
+//--------------------------------------------------------------------------------------
+void FramePipeline::Wake(const std::atomic<bool>& sleeping, std::condition_variable* condition)
+{
+	if (!sleeping.load(std::memory_order_seq_cst)) return;
+
+	std::lock_guard<std::mutex> lock(m_sleepMutex);
+	condition->notify_one();
+}
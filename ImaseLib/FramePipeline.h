@@ -0,0 +1,178 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FramePipeline.h
+//
+// 次のフレームの更新をワーカーのスレッドで行い、描画するスレッドへスナップショットを渡すクラス
+//
+// Usage: Start で指定した深さ（スナップショットの数）だけ、ワーカーのスレッドが先のフレームの
+//        スナップショットを作ります（depth が 2 の場合はフレーム N を描画している間に
+//        フレーム N + 1 を更新します）。スナップショットは呼び出し側が深さの数だけ用意し、
+//        作る関数には書き込むスナップショットの番号が渡されます。
+//        描画するスレッドは Acquire で次のフレームのスナップショットの番号を受け取り、
+//        描画が終わったら Release で返します。返すまでワーカーはそのスナップショットに
+//        書き込まないので、描画中のスナップショットは変更されません。
+//        受け渡しはフレームの番号の atomic だけで行い、待つ必要がある場合だけ眠ります。
+//        更新の開始から描画の終了（Release）までの時間を遅延として集計します。
+//        更新と描画で同じデータを使う場合は、スナップショットへコピーしてください。
+//        Windows に依存しないので（std::thread と atomic のみ）、どの環境でも使えます。
+//
+//	<<< 記述例 >>
+//	// m_snapshots は Snapshot m_snapshots[Imase::FramePipeline::MAX_DEPTH]
+//	pipeline.Start(2, [](void* data, uint32_t slot, uint64_t frame)
+//		{
+//			static_cast<Game*>(data)->UpdateFrame(slot);	// ワーカーのスレッドで m_snapshots[slot] を作る
+//		}, this);
+//
+//	uint32_t slot = pipeline.Acquire();
+//	Render(m_snapshots[slot]);
+//	pipeline.Release();
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace Imase
+{
+	// スナップショットを作る関数（ワーカーのスレッドで呼ばれる）
+	using FrameProduceFunction = void (*)(void* data, uint32_t slot, uint64_t frame);
+
+	// パイプラインの計測結果（描画するスレッドで集計する）
+	struct FramePipelineStats
+	{
+		// 描画したフレーム数
+		uint64_t frameCount = 0;
+
+		// 更新の開始から描画の終了までの時間（遅延）の合計・最小・最大（秒）
+		double totalLatencySeconds = 0.0;
+		double minLatencySeconds = 0.0;
+		double maxLatencySeconds = 0.0;
+
+		// スナップショットを作った時間の合計（秒）
+		double totalProduceSeconds = 0.0;
+
+		// 描画するスレッドがスナップショットを待った時間の合計（秒、更新が間に合っていない）
+		double totalAcquireWaitSeconds = 0.0;
+
+		// ワーカーのスレッドが空きのスナップショットを待った時間の合計（秒、描画が間に合っていない）
+		double totalProduceWaitSeconds = 0.0;
+
+		// 平均の遅延を取得する関数（秒）
+		double GetAverageLatencySeconds() const { return frameCount ? totalLatencySeconds / frameCount : 0.0; }
+	};
+
+	// 更新と描画を重ねて実行するパイプライン
+	class FramePipeline
+	{
+	public:
+
+		// 深さ（スナップショットの数）の最大値
+		static constexpr uint32_t MAX_DEPTH = 4;
+
+		// 眠る前に待つ回数
+		static constexpr int SPIN_COUNT = 64;
+
+		FramePipeline() = default;
+		~FramePipeline() { Stop(); }
+
+		FramePipeline(const FramePipeline&) = delete;
+		FramePipeline& operator=(const FramePipeline&) = delete;
+
+		/// <summary>
+		/// ワーカーのスレッドを起動してフレーム 0 から更新を始める関数（実行中の場合は停止してから始める）
+		/// </summary>
+		/// <param name="depth">スナップショットの数（1 ～ MAX_DEPTH、1 の場合は更新と描画は重ならない）</param>
+		/// <param name="produce">スナップショットを作る関数</param>
+		/// <param name="data">関数へ渡すデータ</param>
+		void Start(uint32_t depth, FrameProduceFunction produce, void* data);
+
+		// 作っているスナップショットが終わるのを待ってワーカーのスレッドを停止する関数（描画していないスナップショットは捨てる）
+		void Stop();
+
+		// 実行中か調べる関数
+		bool IsRunning() const { return m_thread.joinable(); }
+
+		// 深さを取得する関数
+		uint32_t GetDepth() const { return m_depth; }
+
+		/// <summary>
+		/// 次のフレームのスナップショットを受け取る関数（出来上がるまで待つ）
+		/// </summary>
+		/// <param name="frame">フレーム番号の出力先（nullptr 可）</param>
+		/// <returns>スナップショットの番号</returns>
+		uint32_t Acquire(uint64_t* frame = nullptr);
+
+		// 描画が終わったスナップショットを返す関数（ワーカーのスレッドが次のフレームに使えるようになる）
+		void Release();
+
+		// 計測結果を取得する関数
+		const FramePipelineStats& GetStats() const { return m_stats; }
+
+		// 計測結果を 0 に戻す関数
+		void ResetStats() { m_stats = FramePipelineStats(); }
+
+	private:
+
+		using Clock = std::chrono::steady_clock;
+
+		// スナップショットを作った時の計測結果（ワーカーのスレッドが書き込み、描画するスレッドが読む）
+		struct SlotTiming
+		{
+			Clock::time_point produceStart;
+			double produceSeconds;
+			double waitSeconds;
+		};
+
+		// ワーカーのスレッドの処理
+		void WorkerMain();
+
+		// 条件を満たすまで待つ関数（しばらく待っても満たさない場合は眠る）
+		template <class Predicate>
+		void WaitUntil(const Predicate& predicate, std::atomic<bool>* sleeping, std::condition_variable* condition);
+
+		// 眠っている場合は起こす関数
+		void Wake(const std::atomic<bool>& sleeping, std::condition_variable* condition);
+
+	private:
+
+		// ワーカーのスレッド
+		std::thread m_thread;
+
+		// スナップショットを作る関数とデータ
+		FrameProduceFunction m_produce = nullptr;
+		void* m_data = nullptr;
+
+		// 深さ
+		uint32_t m_depth = 1;
+
+		// 作り終わったフレームの数と描画が終わったフレームの数
+		std::atomic<uint64_t> m_produced{ 0 };
+		std::atomic<uint64_t> m_released{ 0 };
+
+		// 受け取ったフレームの数（描画するスレッドだけが使う）
+		uint64_t m_acquired = 0;
+
+		// スナップショットごとの計測結果
+		SlotTiming m_timings[MAX_DEPTH] = {};
+
+		// 眠って待つための同期オブジェクト
+		std::mutex m_sleepMutex;
+		std::condition_variable m_producerCondition;
+		std::condition_variable m_consumerCondition;
+		std::atomic<bool> m_producerSleeping{ false };
+		std::atomic<bool> m_consumerSleeping{ false };
+
+		// 停止する場合は true
+		std::atomic<bool> m_quit{ false };
+
+		// 計測結果
+		FramePipelineStats m_stats;
+	};
+}
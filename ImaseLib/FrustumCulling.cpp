@@ -0,0 +1,368 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FrustumCulling.cpp
+//
+// 視錐台カリング
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "FrustumCulling.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	// 並列化する場合の１スレッドあたりの最小の数
+	constexpr size_t MIN_OBJECTS_PER_THREAD = 4096;
+
+	// 最下位の 1 のビットの位置を求める関数
+	inline uint32_t CountTrailingZeros(uint32_t v)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, v);
+		return static_cast<uint32_t>(index);
+#else
+		return static_cast<uint32_t>(__builtin_ctz(v));
+#endif
+	}
+
+	// 判定結果のビットマスクから番号を書き出す関数
+	inline size_t EmitIndices(uint32_t mask, size_t base, uint32_t* out)
+	{
+		size_t n = 0;
+		while (mask)
+		{
+			out[n++] = static_cast<uint32_t>(base + CountTrailingZeros(mask));
+			mask &= mask - 1;
+		}
+		return n;
+	}
+
+#if defined(IMASE_MATH_SSE2)
+	// スフィア４個分の判定（ビットが 1 なら可視）
+	inline uint32_t TestSpheres4(const Frustum& f, const SphereArrays& s, size_t i)
+	{
+		__m128 cx = _mm_loadu_ps(s.centerX + i);
+		__m128 cy = _mm_loadu_ps(s.centerY + i);
+		__m128 cz = _mm_loadu_ps(s.centerZ + i);
+		__m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(s.radius + i));
+
+		__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int p = 0; p < f.planeCount; p++)
+		{
+			const Vector4& pl = f.planes[p];
+			__m128 dist = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(pl.x), cx), _mm_mul_ps(_mm_set1_ps(pl.y), cy)),
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(pl.z), cz), _mm_set1_ps(pl.w)));
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(dist, negR));
+		}
+		return static_cast<uint32_t>(_mm_movemask_ps(visible));
+	}
+
+	// AABB４個分の判定（ビットが 1 なら可視）
+	inline uint32_t TestBoxes4(const Frustum& f, const Vector3* absNormals, const BoxArrays& b, size_t i)
+	{
+		__m128 cx = _mm_loadu_ps(b.centerX + i);
+		__m128 cy = _mm_loadu_ps(b.centerY + i);
+		__m128 cz = _mm_loadu_ps(b.centerZ + i);
+		__m128 ex = _mm_loadu_ps(b.extentX + i);
+		__m128 ey = _mm_loadu_ps(b.extentY + i);
+		__m128 ez = _mm_loadu_ps(b.extentZ + i);
+
+		__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int p = 0; p < f.planeCount; p++)
+		{
+			const Vector4& pl = f.planes[p];
+			const Vector3& an = absNormals[p];
+			__m128 dist = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(pl.x), cx), _mm_mul_ps(_mm_set1_ps(pl.y), cy)),
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(pl.z), cz), _mm_set1_ps(pl.w)));
+			// 平面の法線方向へ投影した AABB の半径
+			__m128 r = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(an.x), ex), _mm_mul_ps(_mm_set1_ps(an.y), ey)),
+				_mm_mul_ps(_mm_set1_ps(an.z), ez));
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(dist, r), _mm_setzero_ps()));
+		}
+		return static_cast<uint32_t>(_mm_movemask_ps(visible));
+	}
+#endif
+
+	// スフィア８個分の判定（ビットが 1 なら可視）
+	inline uint32_t TestSpheres8(const Frustum& f, const SphereArrays& s, size_t i)
+	{
+#if defined(__AVX__)
+		__m256 cx = _mm256_loadu_ps(s.centerX + i);
+		__m256 cy = _mm256_loadu_ps(s.centerY + i);
+		__m256 cz = _mm256_loadu_ps(s.centerZ + i);
+		__m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(s.radius + i));
+
+		__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (int p = 0; p < f.planeCount; p++)
+		{
+			const Vector4& pl = f.planes[p];
+			__m256 dist = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(pl.x), cx), _mm256_mul_ps(_mm256_set1_ps(pl.y), cy)),
+				_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(pl.z), cz), _mm256_set1_ps(pl.w)));
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(dist, negR, _CMP_GE_OQ));
+		}
+		return static_cast<uint32_t>(_mm256_movemask_ps(visible));
+#elif defined(IMASE_MATH_SSE2)
+		return TestSpheres4(f, s, i) | (TestSpheres4(f, s, i + 4) << 4);
+#else
+		uint32_t mask = 0;
+		for (uint32_t j = 0; j < 8; j++)
+		{
+			Vector3 c(s.centerX[i + j], s.centerY[i + j], s.centerZ[i + j]);
+			if (f.Intersects(c, s.radius[i + j])) mask |= 1u << j;
+		}
+		return mask;
+#endif
+	}
+
+	// AABB８個分の判定（ビットが 1 なら可視）
+	inline uint32_t TestBoxes8(const Frustum& f, const Vector3* absNormals, const BoxArrays& b, size_t i)
+	{
+#if defined(__AVX__)
+		__m256 cx = _mm256_loadu_ps(b.centerX + i);
+		__m256 cy = _mm256_loadu_ps(b.centerY + i);
+		__m256 cz = _mm256_loadu_ps(b.centerZ + i);
+		__m256 ex = _mm256_loadu_ps(b.extentX + i);
+		__m256 ey = _mm256_loadu_ps(b.extentY + i);
+		__m256 ez = _mm256_loadu_ps(b.extentZ + i);
+
+		__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (int p = 0; p < f.planeCount; p++)
+		{
+			const Vector4& pl = f.planes[p];
+			const Vector3& an = absNormals[p];
+			__m256 dist = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(pl.x), cx), _mm256_mul_ps(_mm256_set1_ps(pl.y), cy)),
+				_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(pl.z), cz), _mm256_set1_ps(pl.w)));
+			__m256 r = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(an.x), ex), _mm256_mul_ps(_mm256_set1_ps(an.y), ey)),
+				_mm256_mul_ps(_mm256_set1_ps(an.z), ez));
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(dist, r), _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+		return static_cast<uint32_t>(_mm256_movemask_ps(visible));
+#elif defined(IMASE_MATH_SSE2)
+		return TestBoxes4(f, absNormals, b, i) | (TestBoxes4(f, absNormals, b, i + 4) << 4);
+#else
+		(void)absNormals;
+		uint32_t mask = 0;
+		for (uint32_t j = 0; j < 8; j++)
+		{
+			Vector3 c(b.centerX[i + j], b.centerY[i + j], b.centerZ[i + j]);
+			Vector3 e(b.extentX[i + j], b.extentY[i + j], b.extentZ[i + j]);
+			if (f.Intersects(c, e)) mask |= 1u << j;
+		}
+		return mask;
+#endif
+	}
+
+	// 指定範囲のスフィアを判定する
+	size_t CullSpheresRange(const Frustum& f, const SphereArrays& s, size_t begin, size_t end, uint32_t* out)
+	{
+		size_t n = 0;
+		size_t i = begin;
+
+		for (; i + 8 <= end; i += 8)
+		{
+			n += EmitIndices(TestSpheres8(f, s, i), i, out + n);
+		}
+
+		// 端数
+		for (; i < end; i++)
+		{
+			if (f.Intersects(Vector3(s.centerX[i], s.centerY[i], s.centerZ[i]), s.radius[i]))
+			{
+				out[n++] = static_cast<uint32_t>(i);
+			}
+		}
+
+		return n;
+	}
+
+	// 指定範囲の AABB を判定する
+	size_t CullBoxesRange(const Frustum& f, const Vector3* absNormals, const BoxArrays& b, size_t begin, size_t end, uint32_t* out)
+	{
+		size_t n = 0;
+		size_t i = begin;
+
+		for (; i + 8 <= end; i += 8)
+		{
+			n += EmitIndices(TestBoxes8(f, absNormals, b, i), i, out + n);
+		}
+
+		// 端数
+		for (; i < end; i++)
+		{
+			Vector3 c(b.centerX[i], b.centerY[i], b.centerZ[i]);
+			Vector3 e(b.extentX[i], b.extentY[i], b.extentZ[i]);
+			if (f.Intersects(c, e))
+			{
+				out[n++] = static_cast<uint32_t>(i);
+			}
+		}
+
+		return n;
+	}
+
+	// 範囲を分割して複数のスレッドで判定し、結果を詰めて出力する
+	template <class CullRange>
+	size_t CullParallel(size_t count, uint32_t* out, unsigned int threadCount, const CullRange& cullRange)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = JobSystem::GetDefault().GetWorkerCount();
+		}
+
+		size_t maxThreads = (count + MIN_OBJECTS_PER_THREAD - 1) / MIN_OBJECTS_PER_THREAD;
+		threadCount = static_cast<unsigned int>(std::min<size_t>(threadCount, maxThreads));
+
+		if (threadCount <= 1)
+		{
+			return cullRange(0, count, out);
+		}
+
+		// 分割の単位は８の倍数にする
+		size_t chunk = ((count + threadCount - 1) / threadCount + 7) & ~size_t(7);
+		size_t chunkCount = (count + chunk - 1) / chunk;
+
+		// 各スレッドは自分の範囲の先頭から書き込む（見えている数は範囲の大きさ以下なので重ならない）
+		std::vector<size_t> counts(chunkCount);
+
+		JobSystem::GetDefault().ParallelFor(0, chunkCount, 1, [&](size_t first, size_t last)
+			{
+				for (size_t k = first; k < last; k++)
+				{
+					size_t begin = k * chunk;
+					size_t end = std::min(begin + chunk, count);
+					counts[k] = cullRange(begin, end, out + begin);
+				}
+			});
+
+		// 結果を先頭へ詰める
+		size_t total = counts[0];
+		for (size_t k = 1; k < chunkCount; k++)
+		{
+			std::memmove(out + total, out + k * chunk, counts[k] * sizeof(uint32_t));
+			total += counts[k];
+		}
+
+		return total;
+	}
+}
+
+// ビュー行列×射影行列から視錐台を作成する関数
+Frustum Frustum::CreateFromViewProjection(const Matrix& viewProjection)
+{
+	const auto& m = viewProjection.m;
+
+	// 行列の各列
+	Vector4 c0(m[0][0], m[1][0], m[2][0], m[3][0]);
+	Vector4 c1(m[0][1], m[1][1], m[2][1], m[3][1]);
+	Vector4 c2(m[0][2], m[1][2], m[2][2], m[3][2]);
+	Vector4 c3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+	// クリップ空間で -w <= x <= w、-w <= y <= w、0 <= z <= w となる平面
+	// （Reverse-Z の場合はニアとファーが入れ替わるだけで平面の組は同じ）
+	Vector4 raw[MAX_PLANES] =
+	{
+		c3 + c0,	// 左
+		c3 - c0,	// 右
+		c3 + c1,	// 下
+		c3 - c1,	// 上
+		c2,			// ニア（Reverse-Z の場合はファー）
+		c3 - c2,	// ファー（Reverse-Z の場合はニア）
+	};
+
+	Frustum frustum;
+	for (const Vector4& p : raw)
+	{
+		float len = p.XYZ().Length();
+
+		// 無限遠の射影行列の場合はファー平面の法線が 0 になるので除外する
+		if (len <= 1.0e-6f) continue;
+
+		frustum.planes[frustum.planeCount++] = p * (1.0f / len);
+	}
+
+	return frustum;
+}
+
+// 球が視錐台と交差しているか調べる関数
+bool Frustum::Intersects(const Vector3& center, float radius) const
+{
+	for (int i = 0; i < planeCount; i++)
+	{
+		if (planes[i].XYZ().Dot(center) + planes[i].w < -radius) return false;
+	}
+	return true;
+}
+
+// AABB が視錐台と交差しているか調べる関数
+bool Frustum::Intersects(const Vector3& center, const Vector3& extents) const
+{
+	for (int i = 0; i < planeCount; i++)
+	{
+		const Vector4& p = planes[i];
+		float r = std::abs(p.x) * extents.x + std::abs(p.y) * extents.y + std::abs(p.z) * extents.z;
+		if (p.XYZ().Dot(center) + p.w < -r) return false;
+	}
+	return true;
+}
+
+// バウンディングスフィアの視錐台カリング
+size_t Imase::CullSpheres(
+	const Frustum& frustum,
+	const SphereArrays& spheres,
+	size_t count,
+	uint32_t* visibleIndices,
+	unsigned int threadCount)
+{
+	return CullParallel(count, visibleIndices, threadCount,
+		[&](size_t begin, size_t end, uint32_t* out)
+		{
+			return CullSpheresRange(frustum, spheres, begin, end, out);
+		});
+}
+
+// AABB の視錐台カリング
+size_t Imase::CullBoxes(
+	const Frustum& frustum,
+	const BoxArrays& boxes,
+	size_t count,
+	uint32_t* visibleIndices,
+	unsigned int threadCount)
+{
+	// 平面の法線の絶対値（AABB の半径の計算用）
+	Vector3 absNormals[Frustum::MAX_PLANES];
+	for (int i = 0; i < frustum.planeCount; i++)
+	{
+		const Vector4& p = frustum.planes[i];
+		absNormals[i] = Vector3(std::abs(p.x), std::abs(p.y), std::abs(p.z));
+	}
+
+	return CullParallel(count, visibleIndices, threadCount,
+		[&](size_t begin, size_t end, uint32_t* out)
+		{
+			return CullBoxesRange(frustum, absNormals, boxes, begin, end, out);
+		});
+}
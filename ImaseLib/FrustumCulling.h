@@ -0,0 +1,102 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FrustumCulling.h
+//
+// 視錐台カリング
+//
+// Usage: ビュー行列×射影行列から視錐台の６平面を取り出し、SoA 形式で並べた
+//        バウンディングスフィア／AABB をSIMDで８個ずつ判定して、
+//        見えているオブジェクトの番号だけを詰めて出力します。
+//        数が多い場合はジョブシステム（JobSystem）のワーカーに分割して判定します。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	Imase::Frustum frustum = Imase::Frustum::CreateFromViewProjection(
+//		Imase::Math::FromSimpleMath(view * proj));
+//	size_t visibleCount = Imase::CullSpheres(frustum, spheres, count, visibleIndices);
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MathCore.h"
+
+namespace Imase
+{
+	// 視錐台
+	struct Frustum
+	{
+		// 平面の最大数（左・右・下・上・ニア・ファー）
+		static constexpr int MAX_PLANES = 6;
+
+		// 平面（ax + by + cz + d >= 0 が内側、(a, b, c) は正規化済み）
+		Math::Vector4 planes[MAX_PLANES];
+
+		// 有効な平面の数（Far が無限遠の場合はファー平面がないので５）
+		int planeCount = 0;
+
+		// ビュー行列×射影行列から視錐台を作成する関数（Reverse-Z / 無限遠にも対応）
+		static Frustum CreateFromViewProjection(const Math::Matrix& viewProjection);
+
+		// 球が視錐台と交差しているか調べる関数
+		bool Intersects(const Math::Vector3& center, float radius) const;
+
+		// AABB（中心と各軸の半分の大きさ）が視錐台と交差しているか調べる関数
+		bool Intersects(const Math::Vector3& center, const Math::Vector3& extents) const;
+	};
+
+	// バウンディングスフィアの配列（SoA形式）
+	struct SphereArrays
+	{
+		const float* centerX;
+		const float* centerY;
+		const float* centerZ;
+		const float* radius;
+	};
+
+	// AABB の配列（SoA形式、中心と各軸の半分の大きさ）
+	struct BoxArrays
+	{
+		const float* centerX;
+		const float* centerY;
+		const float* centerZ;
+		const float* extentX;
+		const float* extentY;
+		const float* extentZ;
+	};
+
+	/// <summary>
+	/// バウンディングスフィアの視錐台カリング
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="spheres">バウンディングスフィアの配列</param>
+	/// <param name="count">数</param>
+	/// <param name="visibleIndices">見えているオブジェクトの番号の出力先（count 個分の領域が必要）</param>
+	/// <param name="threadCount">分割する数（0の場合はジョブシステムのワーカー数、1の場合は呼び出し元のスレッドのみ）</param>
+	/// <returns>見えているオブジェクトの数</returns>
+	size_t CullSpheres(
+		const Frustum& frustum,
+		const SphereArrays& spheres,
+		size_t count,
+		uint32_t* visibleIndices,
+		unsigned int threadCount = 0);
+
+	/// <summary>
+	/// AABB の視錐台カリング
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="boxes">AABB の配列</param>
+	/// <param name="count">数</param>
+	/// <param name="visibleIndices">見えているオブジェクトの番号の出力先（count 個分の領域が必要）</param>
+	/// <param name="threadCount">分割する数（0の場合はジョブシステムのワーカー数、1の場合は呼び出し元のスレッドのみ）</param>
+	/// <returns>見えているオブジェクトの数</returns>
+	size_t CullBoxes(
+		const Frustum& frustum,
+		const BoxArrays& boxes,
+		size_t count,
+		uint32_t* visibleIndices,
+		unsigned int threadCount = 0);
+}
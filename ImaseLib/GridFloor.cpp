@@ -8,6 +8,7 @@
 //--------------------------------------------------------------------------------------
 #include "pch.h"
 #include "GridFloor.h"
+#include "TransientGeometryStream.h"
 
 using namespace DirectX;
 using namespace Imase;
@@ -24,9 +25,11 @@ GridFloor::GridFloor(
 	size_t divs
 )
 	: m_pStates(pStates)
+	, m_pDepthStencilState(nullptr)
 	, m_color(color)
 	, m_size(size)
 	, m_divs(divs)
+	, m_cameraVersion(0)
 {
 	// v~eBuob`̍쐬
 	m_primitiveBatch = std::make_unique<PrimitiveBatch<VertexPositionColor>>(pContext);
@@ -37,6 +40,9 @@ GridFloor::GridFloor(
 	m_basicEffect->SetLightingEnabled(false);
 	m_basicEffect->SetTextureEnabled(false);
 
+	// [hs͒Pʍŝ܂ܕςȂ
+	m_basicEffect->SetWorld(SimpleMath::Matrix::Identity);
+
 	// ̓CAEg̍쐬
 	DX::ThrowIfFailed(
 		CreateInputLayoutFromEffect<VertexPositionColor>(
@@ -50,27 +56,11 @@ GridFloor::GridFloor(
 void GridFloor::Render(
 	ID3D11DeviceContext* pContext,
 	const SimpleMath::Matrix& view,
-	const SimpleMath::Matrix& proj
+	const SimpleMath::Matrix& proj,
+	uint32_t cameraVersion
 )
 {
-	// uhXe[g̐ݒisj
-	pContext->OMSetBlendState(m_pStates->Opaque(), nullptr, 0xFFFFFFFF);
-	// [xobt@̐ݒiʏj
-	pContext->OMSetDepthStencilState(m_pStates->DepthDefault(), 0);
-	// JO̐ݒiJOȂj
-	pContext->RSSetState(m_pStates->CullNone());
-
-	// es̐ݒ
-	SimpleMath::Matrix world;
-	m_basicEffect->SetWorld(world);
-	m_basicEffect->SetView(view);
-	m_basicEffect->SetProjection(proj);
-
-	// GtFNgKp
-	m_basicEffect->Apply(pContext);
-
-	// ̓CAEgݒ
-	pContext->IASetInputLayout(m_inputLayout.Get());
+	Apply(pContext, view, proj, cameraVersion);
 
 	// Obh̏`
 	m_primitiveBatch->Begin();
@@ -86,3 +76,64 @@ void GridFloor::Render(
 
 	m_primitiveBatch->End();
 }
+
+void GridFloor::Render(
+	ID3D11DeviceContext* pContext,
+	IRenderContext* pRenderContext,
+	TransientGeometryStream* pStream,
+	const SimpleMath::Matrix& view,
+	const SimpleMath::Matrix& proj,
+	uint32_t cameraVersion
+)
+{
+	// Xg[gȂꍇ PrimitiveBatch ŕ`悷
+	if (!pStream || !pStream->IsValid())
+	{
+		Render(pContext, view, proj, cameraVersion);
+		return;
+	}
+
+	// Obh̏Xg[֒ǉ
+	DX::DrawGrid(
+		pStream,
+		SimpleMath::Vector3(m_size / 2.0f, 0.0f, 0.0f),
+		SimpleMath::Vector3(0.0f, 0.0f, m_size / 2.0f),
+		SimpleMath::Vector3(0.0f, 0.0f, 0.0f),
+		m_divs, m_divs,
+		m_color
+	);
+
+	Apply(pContext, view, proj, cameraVersion);
+
+	// ܂łɒǉꂽfobO̐Ƃ܂Ƃ߂ĕ`
+	pStream->Flush(pRenderContext);
+}
+
+void GridFloor::Apply(
+	ID3D11DeviceContext* pContext,
+	const SimpleMath::Matrix& view,
+	const SimpleMath::Matrix& proj,
+	uint32_t cameraVersion
+)
+{
+	// uhXe[g̐ݒisj
+	pContext->OMSetBlendState(m_pStates->Opaque(), nullptr, 0xFFFFFFFF);
+	// [xobt@̐ݒiݒ̏ꍇ͒ʏj
+	pContext->OMSetDepthStencilState(m_pDepthStencilState ? m_pDepthStencilState : m_pStates->DepthDefault(), 0);
+	// JO̐ݒiJOȂj
+	pContext->RSSetState(m_pStates->CullNone());
+
+	// es̐ݒiJωĂȂꍇ͑O̍ŝ܂܎gj
+	if (cameraVersion == 0 || cameraVersion != m_cameraVersion)
+	{
+		m_basicEffect->SetView(view);
+		m_basicEffect->SetProjection(proj);
+		m_cameraVersion = cameraVersion;
+	}
+
+	// GtFNgKp
+	m_basicEffect->Apply(pContext);
+
+	// ̓CAEgݒ
+	pContext->IASetInputLayout(m_inputLayout.Get());
+}
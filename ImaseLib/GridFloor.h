@@ -10,6 +10,9 @@
 
 namespace Imase
 {
+	class IRenderContext;
+	class TransientGeometryStream;
+
 	// Obh̏\^XN
 	class GridFloor
 	{
@@ -25,18 +28,41 @@ namespace Imase
 			size_t divs = FLOOR_DIVS
 		);
 
-		// `
+		// `icameraVersion OƓꍇ͍s̐ݒȗB0̏ꍇ͖ݒ肷j
 		void Render(
 			ID3D11DeviceContext* pContext,
 			const DirectX::SimpleMath::Matrix& view,
-			const DirectX::SimpleMath::Matrix& proj
+			const DirectX::SimpleMath::Matrix& proj,
+			uint32_t cameraVersion = 0
+		);
+
+		// `iObhL̒_Xg[֒ǉA܂łɃXg[֒ǉꂽƂ܂Ƃ߂ĂPŕ`悷j
+		void Render(
+			ID3D11DeviceContext* pContext,
+			IRenderContext* pRenderContext,
+			TransientGeometryStream* pStream,
+			const DirectX::SimpleMath::Matrix& view,
+			const DirectX::SimpleMath::Matrix& proj,
+			uint32_t cameraVersion = 0
 		);
 
 	private:
 
+		// Xe[gƃGtFNgƓ̓CAEgݒ肷֐
+		void Apply(
+			ID3D11DeviceContext* pContext,
+			const DirectX::SimpleMath::Matrix& view,
+			const DirectX::SimpleMath::Matrix& proj,
+			uint32_t cameraVersion
+		);
+
+
 		// ʃXe[gւ̃|C^
 		DirectX::CommonStates* m_pStates;
 
+		// [xXeVXe[ginullptȑꍇ͒ʏ̐[xeXgj
+		ID3D11DepthStencilState* m_pDepthStencilState;
+
 		// x[VbNGtFNgւ̃|C^
 		std::unique_ptr<DirectX::BasicEffect> m_basicEffect;
 
@@ -55,6 +81,9 @@ namespace Imase
 		// \F
 		DirectX::SimpleMath::Color m_color;
 
+		// Oݒ肵J̃o[Wԍ
+		uint32_t m_cameraVersion;
+
 	public:
 
 		// 1ӂ̃TCY
@@ -72,5 +101,8 @@ namespace Imase
 		// Fݒ肷֐
 		void SetColor(DirectX::FXMVECTOR color) { m_color = color; }
 
+		// [xXeVXe[gݒ肷֐iReverse-Z ̏ꍇȂǂɎgpj
+		void SetDepthStencilState(ID3D11DepthStencilState* pState) { m_pDepthStencilState = pState; }
+
 	};
 }
@@ -0,0 +1,99 @@
+﻿//--------------------------------------------------------------------------------------
+// File: InterpolatedState.h
+//
+// 固定の間隔の更新の前回と今回の状態を覚えておき、描画する時に補間するクラス（ヘッダーのみ）
+//
+// Usage: 固定の間隔の更新の最初に BeginStep を呼ぶと今回の状態が前回の状態になり、
+//        Set で今回の状態を設定します。描画では DX::StepTimer::GetInterpolationAlpha の値で
+//        前回と今回の状態を補間した Get(alpha) を使うと、更新の間隔と描画の間隔が異なっても
+//        滑らかに動きます（表示は最大で１回分の更新だけ遅れます）。
+//        瞬間移動など補間したくない場合は Teleport で前回と今回の両方を設定してください。
+//        補間は型ごとの Interpolate 関数で行います（float・Vector3・Quaternion・TransformState は
+//        このヘッダーにあります）。他の型は同じ名前空間に Interpolate 関数を用意すれば使えます。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	Imase::InterpolatedState<Imase::TransformState> transform;
+//
+//	// 固定の間隔の更新
+//	transform.BeginStep();
+//	transform.Set(newTransform);
+//
+//	// 描画
+//	float alpha = static_cast<float>(timer.GetInterpolationAlpha());
+//	Imase::Math::Matrix world = transform.Get(alpha).ToMatrix();
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "MathCore.h"
+
+namespace Imase
+{
+	// 位置・回転・スケール
+	struct TransformState
+	{
+		Math::Vector3 position = Math::Vector3::Zero();
+		Math::Quaternion rotation = Math::Quaternion::Identity();
+		Math::Vector3 scale = Math::Vector3::One();
+
+		// ワールド行列を作成する関数
+		Math::Matrix ToMatrix() const { return Math::Matrix::CreateWorld(position, rotation, scale); }
+	};
+
+	// ----- 補間関数（t が 0 の場合は a、1 の場合は b） ----- //
+
+	inline float Interpolate(float a, float b, float t) { return a + (b - a) * t; }
+
+	inline Math::Vector3 Interpolate(const Math::Vector3& a, const Math::Vector3& b, float t) { return Math::Vector3::Lerp(a, b, t); }
+
+	inline Math::Quaternion Interpolate(const Math::Quaternion& a, const Math::Quaternion& b, float t) { return Math::Quaternion::Slerp(a, b, t); }
+
+	// 位置とスケールは線形補間、回転は球面線形補間する
+	inline TransformState Interpolate(const TransformState& a, const TransformState& b, float t)
+	{
+		TransformState state;
+		state.position = Interpolate(a.position, b.position, t);
+		state.rotation = Interpolate(a.rotation, b.rotation, t);
+		state.scale = Interpolate(a.scale, b.scale, t);
+		return state;
+	}
+
+	// 前回と今回の更新の状態を補間するクラス
+	template <class T>
+	class InterpolatedState
+	{
+	public:
+
+		InterpolatedState() : m_previous(), m_current() {}
+		explicit InterpolatedState(const T& value) : m_previous(value), m_current(value) {}
+
+		// 固定の間隔の更新の最初に呼ぶ関数（今回の状態を前回の状態にする）
+		void BeginStep() { m_previous = m_current; }
+
+		// 今回の状態を設定する関数
+		void Set(const T& value) { m_current = value; }
+
+		// 前回と今回の状態を両方設定する関数（補間せずに移動する）
+		void Teleport(const T& value) { m_previous = m_current = value; }
+
+		// 前回と今回の状態を取得する関数
+		const T& GetPrevious() const { return m_previous; }
+		const T& GetCurrent() const { return m_current; }
+
+		/// <summary>
+		/// 補間した状態を取得する関数
+		/// </summary>
+		/// <param name="alpha">0 の場合は前回、1 の場合は今回の状態</param>
+		/// <returns>補間した状態</returns>
+		T Get(float alpha) const { return Interpolate(m_previous, m_current, alpha); }
+
+	private:
+
+		// 前回と今回の更新の状態
+		T m_previous;
+		T m_current;
+	};
+}
@@ -0,0 +1,595 @@
+﻿//--------------------------------------------------------------------------------------
+// File: JobSystem.cpp
+//
+// ワークスティーリングのジョブシステム
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "JobSystem.h"
+
+#include <algorithm>
+
+using namespace Imase;
+
+namespace
+{
+	// 眠る前にジョブを探し直す回数
+	constexpr int SPIN_COUNT = 64;
+
+	// 現在のスレッドのワーカーの番号と、そのワーカーを持つジョブシステム
+	thread_local int s_workerIndex = -1;
+	thread_local const JobSystem* s_owner = nullptr;
+
+	// 盗む相手を選ぶ乱数（xorshift）
+	uint32_t NextRandom(uint32_t& state)
+	{
+		uint32_t x = state;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		state = x;
+		return x;
+	}
+}
+
+//------------------------------------------------------------------
+// Chase-Lev 方式のデック
+// （Lê, Pop, Cohen, Zappa Nardelli "Correct and Efficient Work-Stealing for Weak Memory Models" の C11 版）
+//------------------------------------------------------------------
+
+// 後ろに積む関数（所有者のみ）
+bool JobSystem::JobDeque::Push(Job* job)
+{
+	int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+	int64_t top = m_top.load(std::memory_order_acquire);
+
+	// いっぱいの場合
+	if (bottom - top >= static_cast<int64_t>(MAX_JOBS)) return false;
+
+	m_jobs[bottom & (MAX_JOBS - 1)].store(job, std::memory_order_release);
+	m_bottom.store(bottom + 1, std::memory_order_release);
+
+	return true;
+}
+
+// 後ろから取り出す関数（所有者のみ）
+JobSystem::Job* JobSystem::JobDeque::Pop()
+{
+	int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	m_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = m_top.load(std::memory_order_relaxed);
+
+	// 空の場合
+	if (top > bottom)
+	{
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = m_jobs[bottom & (MAX_JOBS - 1)].load(std::memory_order_relaxed);
+
+	// 最後の１つは盗むワーカーと取り合いになるので top を進めて確保する
+	if (top == bottom)
+	{
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			job = nullptr;
+		}
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	return job;
+}
+
+// 前から盗む関数（所有者以外）
+JobSystem::Job* JobSystem::JobDeque::Steal()
+{
+	int64_t top = m_top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+	// 空の場合
+	if (top >= bottom) return nullptr;
+
+	Job* job = m_jobs[top & (MAX_JOBS - 1)].load(std::memory_order_acquire);
+
+	// 他のワーカーが先に取った場合
+	if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return nullptr;
+	}
+
+	return job;
+}
+
+//------------------------------------------------------------------
+// ジョブシステム
+//------------------------------------------------------------------
+
+JobSystem::~JobSystem()
+{
+	Shutdown();
+}
+
+// ワーカーのスレッドを起動する関数
+void JobSystem::Initialize(unsigned int workerCount)
+{
+	Shutdown();
+
+	if (workerCount == 0) workerCount = std::max(1u, std::thread::hardware_concurrency());
+	workerCount = std::min(workerCount, MAX_WORKERS);
+
+	m_quit = false;
+	m_queuedJobs = 0;
+	m_sleepingWorkers = 0;
+
+	m_externalPool.reset(new Job[MAX_JOBS]);
+	m_nextExternalJob = 0;
+	m_externalCounters.executed = 0;
+	m_externalCounters.stolen = 0;
+	m_externalCounters.inlined = 0;
+
+	m_workers.resize(workerCount);
+	for (unsigned int i = 0; i < workerCount; i++)
+	{
+		m_workers[i] = std::make_unique<Worker>();
+		m_workers[i]->random = 0x9E3779B9u * (i + 1);
+	}
+
+	// 呼び出したスレッドがワーカー０
+	s_workerIndex = 0;
+	s_owner = this;
+
+	for (unsigned int i = 1; i < workerCount; i++)
+	{
+		m_workers[i]->thread = std::thread(&JobSystem::WorkerMain, this, i);
+	}
+}
+
+// ワーカーのスレッドを終了する関数
+void JobSystem::Shutdown()
+{
+	if (m_workers.empty()) return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_quit = true;
+	}
+	m_sleepCondition.notify_all();
+
+	for (auto& worker : m_workers)
+	{
+		if (worker->thread.joinable()) worker->thread.join();
+	}
+	m_workers.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(m_externalMutex);
+		m_externalJobs.clear();
+	}
+	m_externalPool.reset();
+
+	if (s_owner == this)
+	{
+		s_workerIndex = -1;
+		s_owner = nullptr;
+	}
+}
+
+// ジョブを積む関数
+void JobSystem::Run(JobFunction function, void* data, JobCounter* counter)
+{
+	if (counter) counter->m_count.fetch_add(1, std::memory_order_relaxed);
+
+	RunContinuation({ function, data, counter });
+}
+
+// カウンターが 0 になった時に実行するジョブを登録する関数
+void JobSystem::RunAfter(JobCounter* dependency, JobFunction function, void* data, JobCounter* counter)
+{
+	// 登録した時点で待てるようにカウンターを増やしておく
+	if (counter) counter->m_count.fetch_add(1, std::memory_order_relaxed);
+
+	JobCounter::Continuation continuation = { function, data, counter };
+
+	if (dependency)
+	{
+		{
+			std::lock_guard<std::mutex> lock(dependency->m_mutex);
+
+			// 完了していない場合は完了した時に積む
+			if (dependency->m_count.load(std::memory_order_acquire) != 0)
+			{
+				dependency->m_continuations.push_back(continuation);
+				return;
+			}
+		}
+
+		// 最後のジョブが完了の処理を終えるまで待つ（継続の完了を待った側が dependency を破棄してもよいように）
+		while (dependency->m_finishing.load(std::memory_order_acquire) != 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	RunContinuation(continuation);
+}
+
+// 範囲を粒度以下に分割しながら処理するジョブを積む関数
+void JobSystem::RunRange(JobRangeFunction function, void* data, size_t begin, size_t end, size_t grain, JobCounter* counter)
+{
+	if (begin >= end) return;
+
+	if (counter) counter->m_count.fetch_add(1, std::memory_order_relaxed);
+
+	Job* job = AllocateJob();
+	if (!job)
+	{
+		// ジョブの領域が足りない場合はその場で実行する
+		function(data, begin, end);
+		Finish(counter);
+		return;
+	}
+
+	job->function = nullptr;
+	job->rangeFunction = function;
+	job->begin = begin;
+	job->end = end;
+	job->grain = std::max<size_t>(1, grain);
+	job->data = data;
+	job->counter = counter;
+
+	if (!Submit(job)) Execute(job, GetCurrentWorkerIndex());
+}
+
+// カウンターが 0 になるまで待つ関数
+void JobSystem::Wait(JobCounter* counter)
+{
+	if (!counter) return;
+
+	int workerIndex = GetCurrentWorkerIndex();
+
+	// 待っている間は他のジョブを実行する
+	while (!counter->IsDone())
+	{
+		if (Job* job = FindJob(workerIndex))
+		{
+			Execute(job, workerIndex);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+// 計測結果を取得する関数
+JobSystemStats JobSystem::GetStats() const
+{
+	JobSystemStats stats = {};
+
+	stats.external = m_externalCounters.executed.load(std::memory_order_relaxed);
+	stats.executed = stats.external;
+	stats.stolen = m_externalCounters.stolen.load(std::memory_order_relaxed);
+	stats.inlined = m_externalCounters.inlined.load(std::memory_order_relaxed);
+
+	for (const auto& worker : m_workers)
+	{
+		stats.executed += worker->counters.executed.load(std::memory_order_relaxed);
+		stats.stolen += worker->counters.stolen.load(std::memory_order_relaxed);
+		stats.inlined += worker->counters.inlined.load(std::memory_order_relaxed);
+	}
+
+	return stats;
+}
+
+// 計測結果を 0 に戻す関数
+void JobSystem::ResetStats()
+{
+	auto reset = [](Counters& counters)
+		{
+			counters.executed.store(0, std::memory_order_relaxed);
+			counters.stolen.store(0, std::memory_order_relaxed);
+			counters.inlined.store(0, std::memory_order_relaxed);
+		};
+
+	reset(m_externalCounters);
+	for (auto& worker : m_workers) reset(worker->counters);
+}
+
+// プログラム全体で共有するジョブシステムを取得する関数
+JobSystem& JobSystem::GetDefault()
+{
+	static JobSystem s_jobSystem;
+	static std::once_flag s_initialized;
+
+	std::call_once(s_initialized, []()
+		{
+			if (s_jobSystem.GetWorkerCount() == 0) s_jobSystem.Initialize();
+		});
+
+	return s_jobSystem;
+}
+
+// ワーカーのスレッドの処理
+void JobSystem::WorkerMain(unsigned int index)
+{
+	s_workerIndex = static_cast<int>(index);
+	s_owner = this;
+
+	int idle = 0;
+
+	while (!m_quit.load(std::memory_order_acquire))
+	{
+		if (Job* job = FindJob(static_cast<int>(index)))
+		{
+			Execute(job, static_cast<int>(index));
+			idle = 0;
+			continue;
+		}
+
+		// しばらくジョブが見つからない場合は積まれるまで眠る
+		if (++idle < SPIN_COUNT)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		idle = 0;
+
+		// 眠るワーカーの数を増やしてから積まれたジョブの数を調べ、
+		// 積む側はジョブの数を増やしてから眠るワーカーの数を調べるので、起こし忘れはない
+		m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_sleepCondition.wait(lock, [this]()
+				{
+					return m_queuedJobs.load(std::memory_order_seq_cst) != 0 || m_quit.load(std::memory_order_relaxed);
+				});
+		}
+		m_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
+
+// 現在のスレッドのワーカーの番号を取得する関数
+int JobSystem::GetCurrentWorkerIndex() const
+{
+	return s_owner == this ? s_workerIndex : -1;
+}
+
+// ジョブの領域を確保する関数
+JobSystem::Job* JobSystem::AllocateJob()
+{
+	int workerIndex = GetCurrentWorkerIndex();
+
+	Job* job = nullptr;
+
+	if (workerIndex >= 0)
+	{
+		Worker& worker = *m_workers[workerIndex];
+		job = &worker.jobs[worker.nextJob & (MAX_JOBS - 1)];
+		if (job->busy.load(std::memory_order_acquire))
+		{
+			worker.counters.inlined.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		worker.nextJob++;
+		job->busy.store(true, std::memory_order_relaxed);
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(m_externalMutex);
+		if (!m_externalPool) return nullptr;
+		job = &m_externalPool[m_nextExternalJob & (MAX_JOBS - 1)];
+		if (job->busy.load(std::memory_order_acquire))
+		{
+			m_externalCounters.inlined.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		m_nextExternalJob++;
+		job->busy.store(true, std::memory_order_relaxed);
+	}
+
+	return job;
+}
+
+// ジョブを積む関数
+bool JobSystem::Submit(Job* job)
+{
+	int workerIndex = GetCurrentWorkerIndex();
+
+	// 先に数を増やしておく（眠ろうとしているワーカーが見落とさないように）
+	m_queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+
+	if (workerIndex >= 0)
+	{
+		if (!m_workers[workerIndex]->deque.Push(job))
+		{
+			m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return false;
+		}
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(m_externalMutex);
+		m_externalJobs.push_back(job);
+	}
+
+	// 眠っているワーカーがいる場合は起こす
+	if (m_sleepingWorkers.load(std::memory_order_seq_cst) != 0)
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_sleepCondition.notify_one();
+	}
+
+	return true;
+}
+
+// 実行するジョブを探す関数
+JobSystem::Job* JobSystem::FindJob(int workerIndex)
+{
+	Job* job = nullptr;
+
+	// 自分のデック
+	if (workerIndex >= 0)
+	{
+		job = m_workers[workerIndex]->deque.Pop();
+	}
+
+	// ワーカー以外のスレッドから積まれたジョブ
+	if (!job)
+	{
+		std::lock_guard<std::mutex> lock(m_externalMutex);
+		if (!m_externalJobs.empty())
+		{
+			job = m_externalJobs.front();
+			m_externalJobs.pop_front();
+		}
+	}
+
+	// 他のワーカーのデック（乱数で選んだワーカーから順に１周する）
+	if (!job)
+	{
+		size_t count = m_workers.size();
+		uint32_t start = 0;
+		if (workerIndex >= 0)
+		{
+			start = NextRandom(m_workers[workerIndex]->random);
+		}
+		else
+		{
+			static thread_local uint32_t s_random = 0x12345678u;
+			start = NextRandom(s_random);
+		}
+
+		for (size_t i = 0; i < count && !job; i++)
+		{
+			size_t victim = (start + i) % count;
+			if (static_cast<int>(victim) == workerIndex) continue;
+			job = m_workers[victim]->deque.Steal();
+		}
+
+		if (job) GetCounters(workerIndex).stolen.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if (job) m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+	return job;
+}
+
+// ジョブを実行する関数
+void JobSystem::Execute(Job* job, int workerIndex)
+{
+	// 実行に必要なものを取り出して、ジョブの領域はすぐに再利用できるようにする
+	JobFunction function = job->function;
+	JobRangeFunction rangeFunction = job->rangeFunction;
+	size_t begin = job->begin;
+	size_t end = job->end;
+	size_t grain = job->grain;
+	void* data = job->data;
+	JobCounter* counter = job->counter;
+	job->busy.store(false, std::memory_order_release);
+
+	if (function)
+	{
+		function(data);
+	}
+	else
+	{
+		// 粒度以下になるまで後半を分けて積み、空いているワーカーに盗んでもらう
+		while (end - begin > grain)
+		{
+			Job* split = AllocateJob();
+			if (!split) break;
+
+			size_t middle = begin + (end - begin) / 2;
+
+			split->function = nullptr;
+			split->rangeFunction = rangeFunction;
+			split->begin = middle;
+			split->end = end;
+			split->grain = grain;
+			split->data = data;
+			split->counter = counter;
+
+			if (counter) counter->m_count.fetch_add(1, std::memory_order_relaxed);
+
+			if (!Submit(split))
+			{
+				// 積めなかった場合は残りを全て自分で処理する
+				split->busy.store(false, std::memory_order_release);
+				if (counter) counter->m_count.fetch_sub(1, std::memory_order_relaxed);
+				break;
+			}
+
+			end = middle;
+		}
+
+		rangeFunction(data, begin, end);
+	}
+
+	GetCounters(workerIndex).executed.fetch_add(1, std::memory_order_relaxed);
+
+	Finish(counter);
+}
+
+// ジョブが完了した時にカウンターを減らし、0 になった場合は継続を積む関数
+void JobSystem::Finish(JobCounter* counter)
+{
+	if (!counter) return;
+
+	// 処理中の間は待っている側がカウンターを破棄しないようにする
+	counter->m_finishing.fetch_add(1, std::memory_order_seq_cst);
+
+	std::vector<JobCounter::Continuation> continuations;
+	if (counter->m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		{
+			std::lock_guard<std::mutex> lock(counter->m_mutex);
+			continuations.swap(counter->m_continuations);
+		}
+
+		// 継続がある場合は、先にカウンターを減らした他のジョブが完了の処理を終えるまで待つ
+		// （継続の完了を待った側がこのカウンターを破棄してもよいように）
+		if (!continuations.empty())
+		{
+			while (counter->m_finishing.load(std::memory_order_acquire) != 1)
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	counter->m_finishing.fetch_sub(1, std::memory_order_release);
+
+	// 継続を積む（継続の完了を待っている側がこのカウンターを破棄してもよいように、カウンターにはもう触らない）
+	for (const auto& continuation : continuations)
+	{
+		RunContinuation(continuation);
+	}
+}
+
+// 継続を積む関数（カウンターは増やしてあること）
+void JobSystem::RunContinuation(const JobCounter::Continuation& continuation)
+{
+	Job* job = AllocateJob();
+
+	if (job)
+	{
+		job->function = continuation.function;
+		job->rangeFunction = nullptr;
+		job->data = continuation.data;
+		job->counter = continuation.counter;
+
+		if (Submit(job)) return;
+
+		job->busy.store(false, std::memory_order_release);
+	}
+
+	// 積めない場合はその場で実行する
+	continuation.function(continuation.data);
+	Finish(continuation.counter);
+}
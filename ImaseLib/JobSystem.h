@@ -0,0 +1,336 @@
+﻿//--------------------------------------------------------------------------------------
+// File: JobSystem.h
+//
+// ワークスティーリングのジョブシステム
+//
+// Usage: CPU のコア数分のワーカー（呼び出し元のスレッドを含む）がジョブを実行します。
+//        ワーカーはそれぞれ Chase-Lev 方式のデック（両端キュー）を持ち、自分で積んだジョブを
+//        後ろから取り出し、自分のジョブがなくなったら他のワーカーのデックの前から盗みます。
+//        ジョブの完了は JobCounter で待ちます。Wait で待っている間も呼び出し元のスレッドが
+//        ジョブを実行するので、ジョブの中からさらにジョブを積んで待つこともできます。
+//        RunAfter でカウンターが 0 になった時に実行するジョブ（継続）を登録できます。
+//        ParallelFor は範囲を二分割しながらジョブを積み（粒度以下になるまで）、
+//        空いているワーカーが後半を盗んで実行します。
+//        Windows に依存しないので（std::thread と atomic のみ）、どの環境でも使えます。
+//
+//	<<< 記述例 >>
+//	Imase::JobSystem& jobs = Imase::JobSystem::GetDefault();
+//
+//	jobs.ParallelFor(0, count, 256, [&](size_t begin, size_t end)
+//		{
+//			for (size_t i = begin; i < end; i++) Update(i);
+//		});
+//
+//	Imase::JobCounter updated, built;
+//	jobs.Run(&UpdateParticles, &particles, &updated);
+//	jobs.RunAfter(&updated, &BuildVertices, &particles, &built);
+//	jobs.Wait(&built);
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Imase
+{
+	// ジョブの関数
+	using JobFunction = void (*)(void* data);
+
+	// 範囲を処理するジョブの関数（ParallelFor 用）
+	using JobRangeFunction = void (*)(void* data, size_t begin, size_t end);
+
+	// ジョブの完了を待つためのカウンター（積んだジョブの数、完了すると減る）
+	class JobCounter
+	{
+	public:
+
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		// 全てのジョブが完了しているか調べる関数
+		bool IsDone() const
+		{
+			return m_count.load(std::memory_order_acquire) == 0 && m_finishing.load(std::memory_order_acquire) == 0;
+		}
+
+		// 完了していないジョブの数を取得する関数
+		uint32_t GetCount() const { return m_count.load(std::memory_order_acquire); }
+
+	private:
+
+		friend class JobSystem;
+
+		// 継続（カウンターが 0 になった時に実行するジョブ）
+		struct Continuation
+		{
+			JobFunction function;
+			void* data;
+			JobCounter* counter;
+		};
+
+		// 完了していないジョブの数
+		std::atomic<uint32_t> m_count{ 0 };
+
+		// 完了の処理中のジョブの数（Wait から戻った後にカウンターへ触らないようにする）
+		std::atomic<uint32_t> m_finishing{ 0 };
+
+		// 継続
+		std::mutex m_mutex;
+		std::vector<Continuation> m_continuations;
+	};
+
+	// ジョブシステムの計測結果
+	struct JobSystemStats
+	{
+		// 実行したジョブの数
+		uint64_t executed;
+
+		// そのうちワーカー以外のスレッド（Wait で待っているスレッド）が実行した数
+		uint64_t external;
+
+		// 他のワーカーから盗んだジョブの数
+		uint64_t stolen;
+
+		// ジョブの領域が足りずに積まずにその場で実行した数
+		uint64_t inlined;
+	};
+
+	// ワークスティーリングのジョブシステム
+	class JobSystem
+	{
+	public:
+
+		// ワーカーの最大数
+		static constexpr unsigned int MAX_WORKERS = 64;
+
+		// ワーカーごとに同時に積めるジョブの最大数（２のべき乗）
+		static constexpr uint32_t MAX_JOBS = 4096;
+
+		JobSystem() = default;
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		/// <summary>
+		/// ワーカーのスレッドを起動する関数（呼び出したスレッドがワーカー０になる）
+		/// </summary>
+		/// <param name="workerCount">ワーカーの数（呼び出し元のスレッドを含む、0の場合はCPUのコア数）</param>
+		void Initialize(unsigned int workerCount = 0);
+
+		/// <summary>
+		/// ワーカーのスレッドを終了する関数（積んだジョブは全て完了していること）
+		/// </summary>
+		void Shutdown();
+
+		// ワーカーの数を取得する関数（初期化前は 0）
+		unsigned int GetWorkerCount() const { return static_cast<unsigned int>(m_workers.size()); }
+
+		/// <summary>
+		/// ジョブを積む関数
+		/// </summary>
+		/// <param name="function">ジョブの関数</param>
+		/// <param name="data">関数へ渡すデータ（ジョブが完了するまで有効なこと）</param>
+		/// <param name="counter">完了を待つカウンター</param>
+		void Run(JobFunction function, void* data, JobCounter* counter);
+
+		/// <summary>
+		/// カウンターが 0 になった時に実行するジョブを登録する関数
+		/// </summary>
+		/// <param name="dependency">待つカウンター（既に 0 の場合はすぐに積む）</param>
+		/// <param name="function">ジョブの関数</param>
+		/// <param name="data">関数へ渡すデータ</param>
+		/// <param name="counter">このジョブの完了を待つカウンター（登録した時点で増える）</param>
+		void RunAfter(JobCounter* dependency, JobFunction function, void* data, JobCounter* counter);
+
+		/// <summary>
+		/// 範囲を粒度以下に分割しながら処理するジョブを積む関数
+		/// </summary>
+		/// <param name="function">範囲を処理する関数</param>
+		/// <param name="data">関数へ渡すデータ</param>
+		/// <param name="begin">範囲の先頭</param>
+		/// <param name="end">範囲の終わり（含まない）</param>
+		/// <param name="grain">１つのジョブで処理する最小の数</param>
+		/// <param name="counter">完了を待つカウンター</param>
+		void RunRange(JobRangeFunction function, void* data, size_t begin, size_t end, size_t grain, JobCounter* counter);
+
+		/// <summary>
+		/// カウンターが 0 になるまで待つ関数（待っている間は他のジョブを実行する）
+		/// </summary>
+		void Wait(JobCounter* counter);
+
+		/// <summary>
+		/// 範囲を分割して並列に処理する関数（全て完了するまで戻らない）
+		/// </summary>
+		/// <param name="begin">範囲の先頭</param>
+		/// <param name="end">範囲の終わり（含まない）</param>
+		/// <param name="grain">１つのジョブで処理する最小の数</param>
+		/// <param name="function">範囲を処理する関数 function(begin, end)</param>
+		template <class Function>
+		void ParallelFor(size_t begin, size_t end, size_t grain, const Function& function)
+		{
+			if (begin >= end) return;
+
+			// 範囲が粒度以下の場合とワーカーが１つの場合はそのまま実行する
+			if (end - begin <= grain || m_workers.size() <= 1)
+			{
+				function(begin, end);
+				return;
+			}
+
+			JobRangeFunction entry = [](void* data, size_t b, size_t e)
+			{
+				(*static_cast<const Function*>(data))(b, e);
+			};
+
+			JobCounter counter;
+			RunRange(entry, const_cast<void*>(static_cast<const void*>(&function)), begin, end, grain, &counter);
+			Wait(&counter);
+		}
+
+		// 計測結果を取得する関数（全てのワーカーの合計）
+		JobSystemStats GetStats() const;
+
+		// 計測結果を 0 に戻す関数
+		void ResetStats();
+
+		/// <summary>
+		/// プログラム全体で共有するジョブシステムを取得する関数（初期化されていない場合は CPU のコア数で初期化する）
+		/// </summary>
+		static JobSystem& GetDefault();
+
+	private:
+
+		// ジョブ
+		struct Job
+		{
+			// ジョブの関数（範囲のジョブの場合は nullptr）
+			JobFunction function = nullptr;
+
+			// 範囲を処理する関数と範囲と粒度
+			JobRangeFunction rangeFunction = nullptr;
+			size_t begin = 0;
+			size_t end = 0;
+			size_t grain = 0;
+
+			// 関数へ渡すデータと完了を待つカウンター
+			void* data = nullptr;
+			JobCounter* counter = nullptr;
+
+			// 使用中なら true（実行を始めるまで再利用しない）
+			std::atomic<bool> busy{ false };
+		};
+
+		// Chase-Lev 方式のデック（所有者は後ろから積んで取り出し、他のワーカーは前から盗む）
+		class JobDeque
+		{
+		public:
+
+			// 後ろに積む関数（所有者のみ、いっぱいの場合は false）
+			bool Push(Job* job);
+
+			// 後ろから取り出す関数（所有者のみ）
+			Job* Pop();
+
+			// 前から盗む関数（所有者以外）
+			Job* Steal();
+
+		private:
+
+			std::atomic<int64_t> m_top{ 0 };
+			std::atomic<int64_t> m_bottom{ 0 };
+			std::atomic<Job*> m_jobs[MAX_JOBS] = {};
+		};
+
+		// 計測結果のカウンター
+		struct Counters
+		{
+			std::atomic<uint64_t> executed{ 0 };
+			std::atomic<uint64_t> stolen{ 0 };
+			std::atomic<uint64_t> inlined{ 0 };
+		};
+
+		// ワーカー
+		struct alignas(64) Worker
+		{
+			// ジョブのデック
+			JobDeque deque;
+
+			// ジョブの領域（順番に使い回す）
+			Job jobs[MAX_JOBS];
+			uint32_t nextJob = 0;
+
+			// 盗む相手を選ぶ乱数
+			uint32_t random = 1;
+
+			// 計測結果
+			Counters counters;
+
+			// スレッド（ワーカー０は初期化したスレッドなので使わない）
+			std::thread thread;
+		};
+
+		// ワーカーのスレッドの処理
+		void WorkerMain(unsigned int index);
+
+		// 現在のスレッドのワーカーの番号を取得する関数（ワーカーでない場合は -1）
+		int GetCurrentWorkerIndex() const;
+
+		// 計測結果のカウンターを取得する関数（ワーカーでない場合はワーカー以外のスレッドで共有するカウンター）
+		Counters& GetCounters(int workerIndex) { return workerIndex >= 0 ? m_workers[workerIndex]->counters : m_externalCounters; }
+
+		// ジョブの領域を確保する関数（空いていない場合は nullptr）
+		Job* AllocateJob();
+
+		// ジョブを積む関数（積めなかった場合は false）
+		bool Submit(Job* job);
+
+		// 実行するジョブを探す関数（自分のデック → 外部のキュー → 他のワーカーのデック）
+		Job* FindJob(int workerIndex);
+
+		// ジョブを実行する関数
+		void Execute(Job* job, int workerIndex);
+
+		// ジョブが完了した時にカウンターを減らし、0 になった場合は継続を積む関数
+		void Finish(JobCounter* counter);
+
+		// 継続を積む関数
+		void RunContinuation(const JobCounter::Continuation& continuation);
+
+	private:
+
+		// ワーカー
+		std::vector<std::unique_ptr<Worker>> m_workers;
+
+		// ワーカー以外のスレッドから積まれたジョブのキューとジョブの領域
+		std::mutex m_externalMutex;
+		std::deque<Job*> m_externalJobs;
+		std::unique_ptr<Job[]> m_externalPool;
+		uint32_t m_nextExternalJob = 0;
+
+		// ワーカー以外のスレッドの計測結果
+		Counters m_externalCounters;
+
+		// 積まれていて実行が始まっていないジョブの数（ワーカーを眠らせるか判断する）
+		std::atomic<uint32_t> m_queuedJobs{ 0 };
+
+		// 眠っているワーカーを起こす
+		std::mutex m_sleepMutex;
+		std::condition_variable m_sleepCondition;
+		std::atomic<uint32_t> m_sleepingWorkers{ 0 };
+
+		// 終了する場合は true
+		std::atomic<bool> m_quit{ false };
+	};
+}
@@ -0,0 +1,605 @@
+﻿//--------------------------------------------------------------------------------------
+// File: MathCore.h
+//
+// Windows や DirectXMath に依存しない数学ライブラリ（ヘッダーのみ）
+//
+// Usage: カメラやカリングなどの計算を Windows 以外の環境（GCC / Clang）でも
+//        コンパイル・テストできるようにするためのベクトル・行列・クォータニオンです。
+//        規約は SimpleMath と同じです。
+//          ・行列は行優先で、ベクトルは左から掛ける（v * M）
+//          ・右手座標系（CreateLookAt / CreatePerspective は Imase::CreateViewMatrix /
+//            Imase::CreatePerspectiveMatrix と同じ配置）
+//        行列の積と座標変換は SSE2 / NEON が使える場合はSIMDで計算します。
+//        Windows では SimpleMath の型とメモリ配置が同じなので、ToSimpleMath /
+//        FromSimpleMath でコピーだけで変換できます。
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+#include <cstring>
+
+// ----- SIMD の選択 ----- //
+#if !defined(IMASE_MATH_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMASE_MATH_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define IMASE_MATH_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(_WIN32) && !defined(IMASE_MATH_NO_SIMPLEMATH)
+#include "SimpleMath.h"
+#endif
+
+namespace Imase
+{
+	namespace Math
+	{
+		// 円周率
+		constexpr float PI = 3.141592654f;
+
+		// 度をラジアンへ変換する関数
+		constexpr float ToRadians(float degrees) { return degrees * (PI / 180.0f); }
+
+		//------------------------------------------------------------------------------
+		// ３次元ベクトル
+		//------------------------------------------------------------------------------
+		struct Vector3
+		{
+			float x, y, z;
+
+			constexpr Vector3() : x(0.0f), y(0.0f), z(0.0f) {}
+			constexpr Vector3(float ix, float iy, float iz) : x(ix), y(iy), z(iz) {}
+
+			constexpr Vector3 operator-() const { return Vector3(-x, -y, -z); }
+			constexpr Vector3 operator+(const Vector3& v) const { return Vector3(x + v.x, y + v.y, z + v.z); }
+			constexpr Vector3 operator-(const Vector3& v) const { return Vector3(x - v.x, y - v.y, z - v.z); }
+			constexpr Vector3 operator*(float s) const { return Vector3(x * s, y * s, z * s); }
+			constexpr Vector3 operator*(const Vector3& v) const { return Vector3(x * v.x, y * v.y, z * v.z); }
+			constexpr Vector3 operator/(float s) const { return Vector3(x / s, y / s, z / s); }
+
+			Vector3& operator+=(const Vector3& v) { x += v.x; y += v.y; z += v.z; return *this; }
+			Vector3& operator-=(const Vector3& v) { x -= v.x; y -= v.y; z -= v.z; return *this; }
+			Vector3& operator*=(float s) { x *= s; y *= s; z *= s; return *this; }
+
+			constexpr bool operator==(const Vector3& v) const { return x == v.x && y == v.y && z == v.z; }
+			constexpr bool operator!=(const Vector3& v) const { return !(*this == v); }
+
+			constexpr float Dot(const Vector3& v) const { return x * v.x + y * v.y + z * v.z; }
+			constexpr Vector3 Cross(const Vector3& v) const
+			{
+				return Vector3(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x);
+			}
+			constexpr float LengthSquared() const { return Dot(*this); }
+			float Length() const { return std::sqrt(LengthSquared()); }
+
+			// 正規化する関数（長さが0の場合はそのまま）
+			void Normalize()
+			{
+				float len = Length();
+				if (len > 0.0f) *this = *this / len;
+			}
+			Vector3 Normalized() const { Vector3 v = *this; v.Normalize(); return v; }
+
+			static constexpr Vector3 Zero() { return Vector3(0.0f, 0.0f, 0.0f); }
+			static constexpr Vector3 One() { return Vector3(1.0f, 1.0f, 1.0f); }
+			static constexpr Vector3 UnitX() { return Vector3(1.0f, 0.0f, 0.0f); }
+			static constexpr Vector3 UnitY() { return Vector3(0.0f, 1.0f, 0.0f); }
+			static constexpr Vector3 UnitZ() { return Vector3(0.0f, 0.0f, 1.0f); }
+			static constexpr Vector3 Up() { return Vector3(0.0f, 1.0f, 0.0f); }
+			static constexpr Vector3 Forward() { return Vector3(0.0f, 0.0f, -1.0f); }
+
+			static constexpr Vector3 Min(const Vector3& a, const Vector3& b)
+			{
+				return Vector3(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z);
+			}
+			static constexpr Vector3 Max(const Vector3& a, const Vector3& b)
+			{
+				return Vector3(a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z);
+			}
+			static constexpr Vector3 Lerp(const Vector3& a, const Vector3& b, float t)
+			{
+				return a + (b - a) * t;
+			}
+		};
+
+		constexpr Vector3 operator*(float s, const Vector3& v) { return v * s; }
+
+		//------------------------------------------------------------------------------
+		// ４次元ベクトル
+		//------------------------------------------------------------------------------
+		struct Vector4
+		{
+			float x, y, z, w;
+
+			constexpr Vector4() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+			constexpr Vector4(float ix, float iy, float iz, float iw) : x(ix), y(iy), z(iz), w(iw) {}
+			constexpr Vector4(const Vector3& v, float iw) : x(v.x), y(v.y), z(v.z), w(iw) {}
+
+			constexpr Vector4 operator+(const Vector4& v) const { return Vector4(x + v.x, y + v.y, z + v.z, w + v.w); }
+			constexpr Vector4 operator-(const Vector4& v) const { return Vector4(x - v.x, y - v.y, z - v.z, w - v.w); }
+			constexpr Vector4 operator*(float s) const { return Vector4(x * s, y * s, z * s, w * s); }
+
+			constexpr bool operator==(const Vector4& v) const { return x == v.x && y == v.y && z == v.z && w == v.w; }
+			constexpr bool operator!=(const Vector4& v) const { return !(*this == v); }
+
+			constexpr float Dot(const Vector4& v) const { return x * v.x + y * v.y + z * v.z + w * v.w; }
+			constexpr Vector3 XYZ() const { return Vector3(x, y, z); }
+		};
+
+		//------------------------------------------------------------------------------
+		// クォータニオン
+		//------------------------------------------------------------------------------
+		struct Quaternion
+		{
+			float x, y, z, w;
+
+			constexpr Quaternion() : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+			constexpr Quaternion(float ix, float iy, float iz, float iw) : x(ix), y(iy), z(iz), w(iw) {}
+
+			static constexpr Quaternion Identity() { return Quaternion(0.0f, 0.0f, 0.0f, 1.0f); }
+
+			// 回転軸と角度から作成する関数（軸は正規化されていること）
+			static Quaternion CreateFromAxisAngle(const Vector3& axis, float angle)
+			{
+				float s = std::sin(angle * 0.5f);
+				return Quaternion(axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f));
+			}
+
+			// ヨー（Y軸）・ピッチ（X軸）・ロール（Z軸）から作成する関数（SimpleMath と同じ順序）
+			static Quaternion CreateFromYawPitchRoll(float yaw, float pitch, float roll)
+			{
+				float sp = std::sin(pitch * 0.5f), cp = std::cos(pitch * 0.5f);
+				float sy = std::sin(yaw * 0.5f), cy = std::cos(yaw * 0.5f);
+				float sr = std::sin(roll * 0.5f), cr = std::cos(roll * 0.5f);
+				return Quaternion(
+					cr * sp * cy + sr * cp * sy,
+					cr * cp * sy - sr * sp * cy,
+					sr * cp * cy - cr * sp * sy,
+					cr * cp * cy + sr * sp * sy);
+			}
+
+			// 回転の合成（q1 * q2 は q1 の後に q2 で回転する、SimpleMath と同じ）
+			constexpr Quaternion operator*(const Quaternion& q) const
+			{
+				return Quaternion(
+					q.w * x + q.x * w + q.y * z - q.z * y,
+					q.w * y - q.x * z + q.y * w + q.z * x,
+					q.w * z + q.x * y - q.y * x + q.z * w,
+					q.w * w - q.x * x - q.y * y - q.z * z);
+			}
+
+			constexpr bool operator==(const Quaternion& q) const { return x == q.x && y == q.y && z == q.z && w == q.w; }
+			constexpr bool operator!=(const Quaternion& q) const { return !(*this == q); }
+
+			constexpr float Dot(const Quaternion& q) const { return x * q.x + y * q.y + z * q.z + w * q.w; }
+			constexpr Quaternion Conjugate() const { return Quaternion(-x, -y, -z, w); }
+
+			void Normalize()
+			{
+				float len = std::sqrt(Dot(*this));
+				if (len > 0.0f) { x /= len; y /= len; z /= len; w /= len; }
+			}
+
+			// ベクトルを回転する関数
+			constexpr Vector3 Rotate(const Vector3& v) const
+			{
+				// v' = v + 2w(q×v) + 2q×(q×v)
+				Vector3 q(x, y, z);
+				Vector3 t = q.Cross(v) * 2.0f;
+				return v + t * w + q.Cross(t);
+			}
+
+			// 球面線形補間
+			static Quaternion Slerp(const Quaternion& a, Quaternion b, float t)
+			{
+				float cosTheta = a.Dot(b);
+				if (cosTheta < 0.0f)
+				{
+					b = Quaternion(-b.x, -b.y, -b.z, -b.w);
+					cosTheta = -cosTheta;
+				}
+
+				float k0, k1;
+				if (cosTheta > 0.9995f)
+				{
+					// ほぼ同じ向きの場合は線形補間
+					k0 = 1.0f - t;
+					k1 = t;
+				}
+				else
+				{
+					float theta = std::acos(cosTheta);
+					float s = std::sin(theta);
+					k0 = std::sin((1.0f - t) * theta) / s;
+					k1 = std::sin(t * theta) / s;
+				}
+
+				Quaternion q(a.x * k0 + b.x * k1, a.y * k0 + b.y * k1, a.z * k0 + b.z * k1, a.w * k0 + b.w * k1);
+				q.Normalize();
+				return q;
+			}
+		};
+
+		//------------------------------------------------------------------------------
+		// 4×4 行列（行優先・ベクトルは左から掛ける）
+		//------------------------------------------------------------------------------
+		struct Matrix
+		{
+			float m[4][4];
+
+			constexpr Matrix()
+				: m{ { 1.0f, 0.0f, 0.0f, 0.0f },
+					 { 0.0f, 1.0f, 0.0f, 0.0f },
+					 { 0.0f, 0.0f, 1.0f, 0.0f },
+					 { 0.0f, 0.0f, 0.0f, 1.0f } }
+			{
+			}
+
+			constexpr Matrix(
+				float m00, float m01, float m02, float m03,
+				float m10, float m11, float m12, float m13,
+				float m20, float m21, float m22, float m23,
+				float m30, float m31, float m32, float m33)
+				: m{ { m00, m01, m02, m03 },
+					 { m10, m11, m12, m13 },
+					 { m20, m21, m22, m23 },
+					 { m30, m31, m32, m33 } }
+			{
+			}
+
+			static constexpr Matrix Identity() { return Matrix(); }
+
+			constexpr bool operator==(const Matrix& a) const
+			{
+				for (int i = 0; i < 4; i++)
+					for (int j = 0; j < 4; j++)
+						if (m[i][j] != a.m[i][j]) return false;
+				return true;
+			}
+			constexpr bool operator!=(const Matrix& a) const { return !(*this == a); }
+
+			constexpr Vector3 Right() const { return Vector3(m[0][0], m[0][1], m[0][2]); }
+			constexpr Vector3 Up() const { return Vector3(m[1][0], m[1][1], m[1][2]); }
+			constexpr Vector3 Backward() const { return Vector3(m[2][0], m[2][1], m[2][2]); }
+			constexpr Vector3 Translation() const { return Vector3(m[3][0], m[3][1], m[3][2]); }
+
+			// 行列の積（コンパイル時にも計算できるスカラー版）
+			static constexpr Matrix MultiplyScalar(const Matrix& a, const Matrix& b)
+			{
+				Matrix r(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+				for (int i = 0; i < 4; i++)
+					for (int j = 0; j < 4; j++)
+						r.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j] + a.m[i][3] * b.m[3][j];
+				return r;
+			}
+
+			// 行列の積（SIMD版）
+			static Matrix Multiply(const Matrix& a, const Matrix& b)
+			{
+#if defined(IMASE_MATH_SSE2)
+				Matrix r;
+				__m128 b0 = _mm_loadu_ps(b.m[0]);
+				__m128 b1 = _mm_loadu_ps(b.m[1]);
+				__m128 b2 = _mm_loadu_ps(b.m[2]);
+				__m128 b3 = _mm_loadu_ps(b.m[3]);
+				for (int i = 0; i < 4; i++)
+				{
+					__m128 v = _mm_mul_ps(_mm_set1_ps(a.m[i][0]), b0);
+					v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(a.m[i][1]), b1));
+					v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(a.m[i][2]), b2));
+					v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(a.m[i][3]), b3));
+					_mm_storeu_ps(r.m[i], v);
+				}
+				return r;
+#elif defined(IMASE_MATH_NEON)
+				Matrix r;
+				float32x4_t b0 = vld1q_f32(b.m[0]);
+				float32x4_t b1 = vld1q_f32(b.m[1]);
+				float32x4_t b2 = vld1q_f32(b.m[2]);
+				float32x4_t b3 = vld1q_f32(b.m[3]);
+				for (int i = 0; i < 4; i++)
+				{
+					float32x4_t v = vmulq_n_f32(b0, a.m[i][0]);
+					v = vmlaq_n_f32(v, b1, a.m[i][1]);
+					v = vmlaq_n_f32(v, b2, a.m[i][2]);
+					v = vmlaq_n_f32(v, b3, a.m[i][3]);
+					vst1q_f32(r.m[i], v);
+				}
+				return r;
+#else
+				return MultiplyScalar(a, b);
+#endif
+			}
+
+			Matrix operator*(const Matrix& b) const { return Multiply(*this, b); }
+			Matrix& operator*=(const Matrix& b) { *this = Multiply(*this, b); return *this; }
+
+			// 転置行列
+			constexpr Matrix Transpose() const
+			{
+				return Matrix(
+					m[0][0], m[1][0], m[2][0], m[3][0],
+					m[0][1], m[1][1], m[2][1], m[3][1],
+					m[0][2], m[1][2], m[2][2], m[3][2],
+					m[0][3], m[1][3], m[2][3], m[3][3]);
+			}
+
+			// 逆行列（一般の 4×4 行列、余因子展開）
+			constexpr Matrix Invert() const
+			{
+				float a0 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+				float a1 = m[0][0] * m[1][2] - m[0][2] * m[1][0];
+				float a2 = m[0][0] * m[1][3] - m[0][3] * m[1][0];
+				float a3 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+				float a4 = m[0][1] * m[1][3] - m[0][3] * m[1][1];
+				float a5 = m[0][2] * m[1][3] - m[0][3] * m[1][2];
+				float b0 = m[2][0] * m[3][1] - m[2][1] * m[3][0];
+				float b1 = m[2][0] * m[3][2] - m[2][2] * m[3][0];
+				float b2 = m[2][0] * m[3][3] - m[2][3] * m[3][0];
+				float b3 = m[2][1] * m[3][2] - m[2][2] * m[3][1];
+				float b4 = m[2][1] * m[3][3] - m[2][3] * m[3][1];
+				float b5 = m[2][2] * m[3][3] - m[2][3] * m[3][2];
+
+				float det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+				float inv = det != 0.0f ? 1.0f / det : 0.0f;
+
+				return Matrix(
+					(m[1][1] * b5 - m[1][2] * b4 + m[1][3] * b3) * inv,
+					(-m[0][1] * b5 + m[0][2] * b4 - m[0][3] * b3) * inv,
+					(m[3][1] * a5 - m[3][2] * a4 + m[3][3] * a3) * inv,
+					(-m[2][1] * a5 + m[2][2] * a4 - m[2][3] * a3) * inv,
+					(-m[1][0] * b5 + m[1][2] * b2 - m[1][3] * b1) * inv,
+					(m[0][0] * b5 - m[0][2] * b2 + m[0][3] * b1) * inv,
+					(-m[3][0] * a5 + m[3][2] * a2 - m[3][3] * a1) * inv,
+					(m[2][0] * a5 - m[2][2] * a2 + m[2][3] * a1) * inv,
+					(m[1][0] * b4 - m[1][1] * b2 + m[1][3] * b0) * inv,
+					(-m[0][0] * b4 + m[0][1] * b2 - m[0][3] * b0) * inv,
+					(m[3][0] * a4 - m[3][1] * a2 + m[3][3] * a0) * inv,
+					(-m[2][0] * a4 + m[2][1] * a2 - m[2][3] * a0) * inv,
+					(-m[1][0] * b3 + m[1][1] * b1 - m[1][2] * b0) * inv,
+					(m[0][0] * b3 - m[0][1] * b1 + m[0][2] * b0) * inv,
+					(-m[3][0] * a3 + m[3][1] * a1 - m[3][2] * a0) * inv,
+					(m[2][0] * a3 - m[2][1] * a1 + m[2][2] * a0) * inv);
+			}
+
+			// 逆行列（回転＋平行移動のみの行列用、転置で求める）
+			constexpr Matrix InvertOrthonormal() const
+			{
+				Vector3 t = Translation();
+				return Matrix(
+					m[0][0], m[1][0], m[2][0], 0.0f,
+					m[0][1], m[1][1], m[2][1], 0.0f,
+					m[0][2], m[1][2], m[2][2], 0.0f,
+					-t.Dot(Right()), -t.Dot(Up()), -t.Dot(Backward()), 1.0f);
+			}
+
+			// 点の座標変換（w = 1、射影はしない）
+			constexpr Vector3 TransformPoint(const Vector3& v) const
+			{
+				return Vector3(
+					v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0] + m[3][0],
+					v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1] + m[3][1],
+					v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2] + m[3][2]);
+			}
+
+			// 方向ベクトルの座標変換（w = 0）
+			constexpr Vector3 TransformNormal(const Vector3& v) const
+			{
+				return Vector3(
+					v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0],
+					v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1],
+					v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2]);
+			}
+
+			// ４次元ベクトルの座標変換（SIMD版）
+			Vector4 Transform(const Vector4& v) const
+			{
+#if defined(IMASE_MATH_SSE2)
+				__m128 r = _mm_mul_ps(_mm_set1_ps(v.x), _mm_loadu_ps(m[0]));
+				r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.y), _mm_loadu_ps(m[1])));
+				r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.z), _mm_loadu_ps(m[2])));
+				r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.w), _mm_loadu_ps(m[3])));
+				Vector4 out;
+				_mm_storeu_ps(&out.x, r);
+				return out;
+#elif defined(IMASE_MATH_NEON)
+				float32x4_t r = vmulq_n_f32(vld1q_f32(m[0]), v.x);
+				r = vmlaq_n_f32(r, vld1q_f32(m[1]), v.y);
+				r = vmlaq_n_f32(r, vld1q_f32(m[2]), v.z);
+				r = vmlaq_n_f32(r, vld1q_f32(m[3]), v.w);
+				Vector4 out;
+				vst1q_f32(&out.x, r);
+				return out;
+#else
+				return Vector4(
+					v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0] + v.w * m[3][0],
+					v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1] + v.w * m[3][1],
+					v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2] + v.w * m[3][2],
+					v.x * m[0][3] + v.y * m[1][3] + v.z * m[2][3] + v.w * m[3][3]);
+#endif
+			}
+
+			// ----- 行列の作成 ----- //
+
+			static constexpr Matrix CreateTranslation(const Vector3& t)
+			{
+				return Matrix(
+					1.0f, 0.0f, 0.0f, 0.0f,
+					0.0f, 1.0f, 0.0f, 0.0f,
+					0.0f, 0.0f, 1.0f, 0.0f,
+					t.x, t.y, t.z, 1.0f);
+			}
+
+			static constexpr Matrix CreateScale(const Vector3& s)
+			{
+				return Matrix(
+					s.x, 0.0f, 0.0f, 0.0f,
+					0.0f, s.y, 0.0f, 0.0f,
+					0.0f, 0.0f, s.z, 0.0f,
+					0.0f, 0.0f, 0.0f, 1.0f);
+			}
+
+			static constexpr Matrix CreateScale(float s) { return CreateScale(Vector3(s, s, s)); }
+
+			static Matrix CreateRotationX(float angle)
+			{
+				float s = std::sin(angle), c = std::cos(angle);
+				return Matrix(
+					1.0f, 0.0f, 0.0f, 0.0f,
+					0.0f, c, s, 0.0f,
+					0.0f, -s, c, 0.0f,
+					0.0f, 0.0f, 0.0f, 1.0f);
+			}
+
+			static Matrix CreateRotationY(float angle)
+			{
+				float s = std::sin(angle), c = std::cos(angle);
+				return Matrix(
+					c, 0.0f, -s, 0.0f,
+					0.0f, 1.0f, 0.0f, 0.0f,
+					s, 0.0f, c, 0.0f,
+					0.0f, 0.0f, 0.0f, 1.0f);
+			}
+
+			static Matrix CreateRotationZ(float angle)
+			{
+				float s = std::sin(angle), c = std::cos(angle);
+				return Matrix(
+					c, s, 0.0f, 0.0f,
+					-s, c, 0.0f, 0.0f,
+					0.0f, 0.0f, 1.0f, 0.0f,
+					0.0f, 0.0f, 0.0f, 1.0f);
+			}
+
+			// クォータニオンから回転行列を作成する関数
+			static constexpr Matrix CreateFromQuaternion(const Quaternion& q)
+			{
+				float xx = 2.0f * q.x * q.x, yy = 2.0f * q.y * q.y, zz = 2.0f * q.z * q.z;
+				float xy = 2.0f * q.x * q.y, xz = 2.0f * q.x * q.z, yz = 2.0f * q.y * q.z;
+				float wx = 2.0f * q.w * q.x, wy = 2.0f * q.w * q.y, wz = 2.0f * q.w * q.z;
+				return Matrix(
+					1.0f - yy - zz, xy + wz, xz - wy, 0.0f,
+					xy - wz, 1.0f - xx - zz, yz + wx, 0.0f,
+					xz + wy, yz - wx, 1.0f - xx - yy, 0.0f,
+					0.0f, 0.0f, 0.0f, 1.0f);
+			}
+
+			// スケール・回転・平行移動からワールド行列を作成する関数
+			static constexpr Matrix CreateWorld(const Vector3& position, const Quaternion& rotation, const Vector3& scale)
+			{
+				Matrix r = CreateFromQuaternion(rotation);
+				for (int j = 0; j < 3; j++)
+				{
+					r.m[0][j] *= scale.x;
+					r.m[1][j] *= scale.y;
+					r.m[2][j] *= scale.z;
+				}
+				r.m[3][0] = position.x;
+				r.m[3][1] = position.y;
+				r.m[3][2] = position.z;
+				return r;
+			}
+
+			// ビュー行列を作成する関数（Imase::CreateViewMatrix と同じ、ただし X軸は正規化する）
+			static Matrix CreateLookAt(const Vector3& eyePos, const Vector3& focusPos, const Vector3& upVector)
+			{
+				Vector3 zaxis = (eyePos - focusPos).Normalized();
+				Vector3 xaxis = upVector.Cross(zaxis).Normalized();
+				Vector3 yaxis = zaxis.Cross(xaxis);
+
+				return Matrix(
+					xaxis.x, yaxis.x, zaxis.x, 0.0f,
+					xaxis.y, yaxis.y, zaxis.y, 0.0f,
+					xaxis.z, yaxis.z, zaxis.z, 0.0f,
+					-xaxis.Dot(eyePos), -yaxis.Dot(eyePos), -zaxis.Dot(eyePos), 1.0f);
+			}
+
+			// 射影行列を作成する関数（Imase::CreatePerspectiveMatrix と同じ、深度は [0,1]）
+			static Matrix CreatePerspective(float fovY, float aspectRatio, float nearPlane, float farPlane)
+			{
+				float yScale = 1.0f / std::tan(fovY / 2.0f);
+				float xScale = yScale / aspectRatio;
+				return Matrix(
+					xScale, 0.0f, 0.0f, 0.0f,
+					0.0f, yScale, 0.0f, 0.0f,
+					0.0f, 0.0f, farPlane / (nearPlane - farPlane), -1.0f,
+					0.0f, 0.0f, nearPlane * farPlane / (nearPlane - farPlane), 0.0f);
+			}
+
+			// Reverse-Z の射影行列を作成する関数（Imase::CreatePerspectiveMatrixReverseZ と同じ）
+			static Matrix CreatePerspectiveReverseZ(float fovY, float aspectRatio, float nearPlane, float farPlane)
+			{
+				float yScale = 1.0f / std::tan(fovY / 2.0f);
+				float xScale = yScale / aspectRatio;
+				return Matrix(
+					xScale, 0.0f, 0.0f, 0.0f,
+					0.0f, yScale, 0.0f, 0.0f,
+					0.0f, 0.0f, nearPlane / (farPlane - nearPlane), -1.0f,
+					0.0f, 0.0f, nearPlane * farPlane / (farPlane - nearPlane), 0.0f);
+			}
+
+			// Far が無限遠の Reverse-Z の射影行列を作成する関数
+			static Matrix CreatePerspectiveInfiniteReverseZ(float fovY, float aspectRatio, float nearPlane)
+			{
+				float yScale = 1.0f / std::tan(fovY / 2.0f);
+				float xScale = yScale / aspectRatio;
+				return Matrix(
+					xScale, 0.0f, 0.0f, 0.0f,
+					0.0f, yScale, 0.0f, 0.0f,
+					0.0f, 0.0f, 0.0f, -1.0f,
+					0.0f, 0.0f, nearPlane, 0.0f);
+			}
+
+			// 平行投影の射影行列を作成する関数（深度は [0,1]）
+			static constexpr Matrix CreateOrthographicOffCenter(
+				float left, float right, float bottom, float top, float nearPlane, float farPlane)
+			{
+				return Matrix(
+					2.0f / (right - left), 0.0f, 0.0f, 0.0f,
+					0.0f, 2.0f / (top - bottom), 0.0f, 0.0f,
+					0.0f, 0.0f, 1.0f / (nearPlane - farPlane), 0.0f,
+					(left + right) / (left - right), (top + bottom) / (bottom - top), nearPlane / (nearPlane - farPlane), 1.0f);
+			}
+		};
+
+		constexpr Vector3 operator*(const Vector3& v, const Matrix& m) { return m.TransformPoint(v); }
+
+#if defined(_WIN32) && !defined(IMASE_MATH_NO_SIMPLEMATH)
+		// ----- SimpleMath との変換（メモリ配置が同じなのでコピーのみ） ----- //
+
+		static_assert(sizeof(Matrix) == sizeof(DirectX::SimpleMath::Matrix), "Matrix layout mismatch");
+		static_assert(sizeof(Vector3) == sizeof(DirectX::SimpleMath::Vector3), "Vector3 layout mismatch");
+		static_assert(sizeof(Vector4) == sizeof(DirectX::SimpleMath::Vector4), "Vector4 layout mismatch");
+		static_assert(sizeof(Quaternion) == sizeof(DirectX::SimpleMath::Quaternion), "Quaternion layout mismatch");
+
+		inline DirectX::SimpleMath::Matrix ToSimpleMath(const Matrix& m)
+		{
+			DirectX::SimpleMath::Matrix r;
+			std::memcpy(&r, &m, sizeof(r));
+			return r;
+		}
+
+		inline Matrix FromSimpleMath(const DirectX::SimpleMath::Matrix& m)
+		{
+			Matrix r;
+			std::memcpy(&r, &m, sizeof(r));
+			return r;
+		}
+
+		inline DirectX::SimpleMath::Vector3 ToSimpleMath(const Vector3& v) { return DirectX::SimpleMath::Vector3(v.x, v.y, v.z); }
+		inline Vector3 FromSimpleMath(const DirectX::SimpleMath::Vector3& v) { return Vector3(v.x, v.y, v.z); }
+
+		inline DirectX::SimpleMath::Vector4 ToSimpleMath(const Vector4& v) { return DirectX::SimpleMath::Vector4(v.x, v.y, v.z, v.w); }
+		inline Vector4 FromSimpleMath(const DirectX::SimpleMath::Vector4& v) { return Vector4(v.x, v.y, v.z, v.w); }
+
+		inline DirectX::SimpleMath::Quaternion ToSimpleMath(const Quaternion& q) { return DirectX::SimpleMath::Quaternion(q.x, q.y, q.z, q.w); }
+		inline Quaternion FromSimpleMath(const DirectX::SimpleMath::Quaternion& q) { return Quaternion(q.x, q.y, q.z, q.w); }
+#endif
+	}
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "SimpleMath.h"
+#include "FastTrig.h"
+#include "CameraMatrices.h"
 
 namespace Imase
 {
@@ -114,10 +116,11 @@ namespace Imase
         float fovY, float aspectRatio, float nearPlane, float farPlane
     )
     {
-        // ]ځiR^WFgj߂֐
-        auto cot = [](float a) { return cos(a) / sin(a); };
+        // ]ځiR^WFgj߂isin  cos ͂܂Ƃ߂ČvZj
+        float s, c;
+        Imase::Math::SinCos(fovY / 2.0f, &s, &c);
 
-        float yScale = cot(fovY / 2.0f);
+        float yScale = c / s;
         float xScale = yScale / aspectRatio;
 
         DirectX::XMMATRIX proj = {};
@@ -130,4 +133,120 @@ namespace Imase
         return proj;
     }
 
-}
\ No newline at end of file
+    // ----- [xxPˉes ----- //
+    //
+    // Reverse-Z : Near  1AFar  0 ɎʑB_̐[xobt@iD32_FLOATj
+    //             gݍ킹Ɖ̐x傫PB
+    //             [xeXg GREATERA[xobt@̃NAl 0 ɂ邱ƁB
+    // Infinite  : Far 𖳌ƂBFar ɂ`拗̐ȂȂB
+
+    // Reverse-Z ̎ˉes쐬֐
+    static DirectX::XMMATRIX CreatePerspectiveMatrixReverseZ(
+        float fovY, float aspectRatio, float nearPlane, float farPlane
+    )
+    {
+        float s, c;
+        Imase::Math::SinCos(fovY / 2.0f, &s, &c);
+
+        float yScale = c / s;
+        float xScale = yScale / aspectRatio;
+
+        DirectX::XMMATRIX proj = {};
+
+        proj.r[0] = DirectX::XMVectorSet(xScale, 0.0f, 0.0f, 0.0f);
+        proj.r[1] = DirectX::XMVectorSet(0.0f, yScale, 0.0f, 0.0f);
+        proj.r[2] = DirectX::XMVectorSet(0.0f, 0.0f, nearPlane / (farPlane - nearPlane), -1.0f);
+        proj.r[3] = DirectX::XMVectorSet(0.0f, 0.0f, nearPlane * farPlane / (farPlane - nearPlane), 0.0f);
+
+        return proj;
+    }
+
+    // Far ̎ˉes쐬֐
+    static DirectX::XMMATRIX CreatePerspectiveMatrixInfinite(
+        float fovY, float aspectRatio, float nearPlane
+    )
+    {
+        float s, c;
+        Imase::Math::SinCos(fovY / 2.0f, &s, &c);
+
+        float yScale = c / s;
+        float xScale = yScale / aspectRatio;
+
+        DirectX::XMMATRIX proj = {};
+
+        // Far   ̋Ɍ
+        proj.r[0] = DirectX::XMVectorSet(xScale, 0.0f, 0.0f, 0.0f);
+        proj.r[1] = DirectX::XMVectorSet(0.0f, yScale, 0.0f, 0.0f);
+        proj.r[2] = DirectX::XMVectorSet(0.0f, 0.0f, -1.0f, -1.0f);
+        proj.r[3] = DirectX::XMVectorSet(0.0f, 0.0f, -nearPlane, 0.0f);
+
+        return proj;
+    }
+
+    // Far  Reverse-Z ̎ˉes쐬֐
+    static DirectX::XMMATRIX CreatePerspectiveMatrixInfiniteReverseZ(
+        float fovY, float aspectRatio, float nearPlane
+    )
+    {
+        float s, c;
+        Imase::Math::SinCos(fovY / 2.0f, &s, &c);
+
+        float yScale = c / s;
+        float xScale = yScale / aspectRatio;
+
+        DirectX::XMMATRIX proj = {};
+
+        // Far   ̋Ɍi[xl Near /  ɂȂj
+        proj.r[0] = DirectX::XMVectorSet(xScale, 0.0f, 0.0f, 0.0f);
+        proj.r[1] = DirectX::XMVectorSet(0.0f, yScale, 0.0f, 0.0f);
+        proj.r[2] = DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, -1.0f);
+        proj.r[3] = DirectX::XMVectorSet(0.0f, 0.0f, nearPlane, 0.0f);
+
+        return proj;
+    }
+
+    // ----- ̍s܂Ƃ߂č쐬֐ ----- //
+    //
+    // VhẼJXP[hL[ûUʂȂǁAPt[ő
+    // r[sEˉes񂪕KvȏꍇɎgpB
+    // vZ Windows ȊOłeXgł CameraMatrices.h ̊֐ōs
+    // iAVX łWESSE2 łS̃J𓯎ɌvZA[̓XJ[łŌvZjB
+    // SimpleMath ̌^ MathCore ̌^̓zuȂ̂ł̂܂ܓnB
+    //
+    //  CreateViewMatrices  X𐳋KiXMMatrixLookAtRH ƓjBCreateViewMatrix 
+    //    KȂ̂ŁÃxNgƒĂȂꍇ͌ʂقȂB
+
+    static_assert(sizeof(DirectX::SimpleMath::Vector3) == sizeof(Imase::Math::Vector3), "Vector3 layout mismatch");
+    static_assert(sizeof(DirectX::SimpleMath::Matrix) == sizeof(Imase::Math::Matrix), "Matrix layout mismatch");
+
+    // ̃r[s܂Ƃ߂č쐬֐
+    static void CreateViewMatrices(
+        const DirectX::SimpleMath::Vector3* eyePos,
+        const DirectX::SimpleMath::Vector3* focusPos,
+        const DirectX::SimpleMath::Vector3* upVector,
+        DirectX::SimpleMath::Matrix* views,
+        size_t count
+    )
+    {
+        Imase::Math::CreateLookAtMatrices(
+            reinterpret_cast<const Imase::Math::Vector3*>(eyePos),
+            reinterpret_cast<const Imase::Math::Vector3*>(focusPos),
+            reinterpret_cast<const Imase::Math::Vector3*>(upVector),
+            reinterpret_cast<Imase::Math::Matrix*>(views),
+            count);
+    }
+
+    // ̎ˉes܂Ƃ߂č쐬֐
+    static void CreatePerspectiveMatrices(
+        const float* fovY, const float* aspectRatio, const float* nearPlane, const float* farPlane,
+        DirectX::SimpleMath::Matrix* projs,
+        size_t count
+    )
+    {
+        Imase::Math::CreatePerspectiveMatrices(
+            fovY, aspectRatio, nearPlane, farPlane,
+            reinterpret_cast<Imase::Math::Matrix*>(projs),
+            count);
+    }
+
+}
@@ -0,0 +1,440 @@
+﻿//--------------------------------------------------------------------------------------
+// File: NullRenderContext.cpp
+//
+// GPU を使わずに描画コマンドの検証と計測だけを行う IRenderContext の実装
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "NullRenderContext.h"
+
+#include <utility>
+
+using namespace Imase;
+
+namespace
+{
+	// ハンドルをリソースの番号 + 1 の値へ変換する関数
+	inline uintptr_t ToValue(const void* handle) { return reinterpret_cast<uintptr_t>(handle); }
+
+	// リソースの番号 + 1 の値をハンドルへ変換する関数
+	template <class Handle>
+	inline Handle* ToHandle(uint32_t value) { return reinterpret_cast<Handle*>(static_cast<uintptr_t>(value)); }
+
+	// インデックス１個のバイト数
+	inline uint32_t IndexSize(RenderIndexFormat format) { return format == RenderIndexFormat::UInt16 ? 2 : 4; }
+}
+
+//--------------------------------------------------------------------------------------
+// コンストラクタ
+//--------------------------------------------------------------------------------------
+NullRenderContext::NullRenderContext()
+{
+	m_resources.reserve(64);
+}
+
+//--------------------------------------------------------------------------------------
+// リソースの作成
+//--------------------------------------------------------------------------------------
+uint32_t NullRenderContext::AddResource(ResourceKind kind, uint32_t size, bool isDynamic)
+{
+	Resource resource;
+	resource.kind = kind;
+	resource.size = size;
+	resource.isDynamic = isDynamic;
+	resource.isMapped = false;
+	if (isDynamic) resource.memory.resize(size);
+
+	m_resources.push_back(std::move(resource));
+
+	return static_cast<uint32_t>(m_resources.size());
+}
+
+RenderBuffer* NullRenderContext::CreateBuffer(uint32_t byteWidth, bool isDynamic)
+{
+	return ToHandle<RenderBuffer>(AddResource(ResourceKind::Buffer, byteWidth, isDynamic));
+}
+
+RenderInputLayout* NullRenderContext::CreateInputLayout(uint32_t slotCount)
+{
+	return ToHandle<RenderInputLayout>(AddResource(ResourceKind::InputLayout, slotCount, false));
+}
+
+RenderVertexShader* NullRenderContext::CreateVertexShader()
+{
+	return ToHandle<RenderVertexShader>(AddResource(ResourceKind::VertexShader, 0, false));
+}
+
+RenderPixelShader* NullRenderContext::CreatePixelShader()
+{
+	return ToHandle<RenderPixelShader>(AddResource(ResourceKind::PixelShader, 0, false));
+}
+
+RenderShaderResource* NullRenderContext::CreateShaderResource()
+{
+	return ToHandle<RenderShaderResource>(AddResource(ResourceKind::ShaderResource, 0, false));
+}
+
+RenderSampler* NullRenderContext::CreateSampler()
+{
+	return ToHandle<RenderSampler>(AddResource(ResourceKind::Sampler, 0, false));
+}
+
+RenderRasterizerState* NullRenderContext::CreateRasterizerState()
+{
+	return ToHandle<RenderRasterizerState>(AddResource(ResourceKind::RasterizerState, 0, false));
+}
+
+RenderDepthStencilState* NullRenderContext::CreateDepthStencilState()
+{
+	return ToHandle<RenderDepthStencilState>(AddResource(ResourceKind::DepthStencilState, 0, false));
+}
+
+RenderBlendState* NullRenderContext::CreateBlendState()
+{
+	return ToHandle<RenderBlendState>(AddResource(ResourceKind::BlendState, 0, false));
+}
+
+//--------------------------------------------------------------------------------------
+// 設定済みのステートを全て解除する関数
+//--------------------------------------------------------------------------------------
+void NullRenderContext::ClearState()
+{
+	m_inputLayout = nullptr;
+	m_indexBuffer = nullptr;
+	for (const void*& buffer : m_vertexBuffers) buffer = nullptr;
+	m_vertexShader = nullptr;
+	m_pixelShader = nullptr;
+	m_indexFormat = RenderIndexFormat::UInt16;
+	m_indexOffset = 0;
+	m_topology = RenderTopology::Undefined;
+}
+
+//--------------------------------------------------------------------------------------
+// ハンドルからリソースを取得する関数
+//--------------------------------------------------------------------------------------
+NullRenderContext::Resource* NullRenderContext::Find(const void* handle, ResourceKind kind, const char* command)
+{
+	uintptr_t value = ToValue(handle);
+	if (value == 0) return nullptr;
+
+	if (value > m_resources.size())
+	{
+		Error(command, "unknown handle");
+		return nullptr;
+	}
+
+	Resource* resource = &m_resources[value - 1];
+	if (resource->kind != kind)
+	{
+		Error(command, "handle of a different kind");
+		return nullptr;
+	}
+
+	return resource;
+}
+
+//--------------------------------------------------------------------------------------
+// コマンドを数えて記録する関数
+//--------------------------------------------------------------------------------------
+void NullRenderContext::Issue(NullRenderCommand type, uint32_t a0, uint32_t a1, uint32_t a2)
+{
+	m_stats.commands++;
+	if (type < NullRenderCommand::Map) m_stats.stateChanges++;
+
+	if (m_isRecording) m_records.push_back({ type, { a0, a1, a2 } });
+}
+
+//--------------------------------------------------------------------------------------
+// エラーを記録する関数
+//--------------------------------------------------------------------------------------
+void NullRenderContext::Error(const char* command, const char* message)
+{
+	m_stats.errors++;
+
+	m_lastError = command;
+	m_lastError += ": ";
+	m_lastError += message;
+}
+
+//--------------------------------------------------------------------------------------
+// IA
+//--------------------------------------------------------------------------------------
+void NullRenderContext::IASetInputLayout(RenderInputLayout* inputLayout)
+{
+	Find(inputLayout, ResourceKind::InputLayout, "IASetInputLayout");
+	m_inputLayout = inputLayout;
+	Issue(NullRenderCommand::IASetInputLayout, GetResourceId(inputLayout));
+}
+
+void NullRenderContext::IASetPrimitiveTopology(RenderTopology topology)
+{
+	if (topology > RenderTopology::TriangleStrip) Error("IASetPrimitiveTopology", "invalid topology");
+	m_topology = topology;
+	Issue(NullRenderCommand::IASetPrimitiveTopology, static_cast<uint32_t>(topology));
+}
+
+void NullRenderContext::IASetIndexBuffer(RenderBuffer* buffer, RenderIndexFormat format, uint32_t offset)
+{
+	if (format != RenderIndexFormat::UInt16 && format != RenderIndexFormat::UInt32) Error("IASetIndexBuffer", "invalid format");
+	if (offset % IndexSize(format) != 0) Error("IASetIndexBuffer", "offset is not aligned to the index size");
+
+	Find(buffer, ResourceKind::Buffer, "IASetIndexBuffer");
+	m_indexBuffer = buffer;
+	m_indexFormat = format;
+	m_indexOffset = offset;
+	Issue(NullRenderCommand::IASetIndexBuffer, GetResourceId(buffer), static_cast<uint32_t>(format), offset);
+}
+
+void NullRenderContext::IASetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets)
+{
+	if (startSlot + numBuffers > MAX_VERTEX_BUFFERS)
+	{
+		Error("IASetVertexBuffers", "slot out of range");
+		return;
+	}
+
+	for (uint32_t i = 0; i < numBuffers; i++)
+	{
+		Find(buffers[i], ResourceKind::Buffer, "IASetVertexBuffers");
+		if (buffers[i] && strides[i] == 0) Error("IASetVertexBuffers", "stride is zero");
+		m_vertexBuffers[startSlot + i] = buffers[i];
+	}
+	(void)offsets;
+
+	Issue(NullRenderCommand::IASetVertexBuffers, startSlot, numBuffers, numBuffers ? GetResourceId(buffers[0]) : 0);
+}
+
+//--------------------------------------------------------------------------------------
+// VS
+//--------------------------------------------------------------------------------------
+void NullRenderContext::VSSetShader(RenderVertexShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances)
+{
+	if (numClassInstances > 0 && !classInstances) Error("VSSetShader", "class instances are null");
+
+	Find(shader, ResourceKind::VertexShader, "VSSetShader");
+	m_vertexShader = shader;
+	Issue(NullRenderCommand::VSSetShader, GetResourceId(shader));
+}
+
+void NullRenderContext::VSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers)
+{
+	for (uint32_t i = 0; i < numBuffers; i++)
+	{
+		const Resource* resource = Find(buffers[i], ResourceKind::Buffer, "VSSetConstantBuffers");
+		if (resource && resource->size % 16 != 0) Error("VSSetConstantBuffers", "size is not a multiple of 16");
+	}
+	Issue(NullRenderCommand::VSSetConstantBuffers, startSlot, numBuffers, numBuffers ? GetResourceId(buffers[0]) : 0);
+}
+
+void NullRenderContext::VSSetConstantBuffers1(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers,
+	const uint32_t* firstConstants, const uint32_t* numConstants)
+{
+	if (numBuffers > 0 && (!firstConstants || !numConstants)) Error("VSSetConstantBuffers1", "constant ranges are null");
+
+	for (uint32_t i = 0; i < numBuffers; i++)
+	{
+		const Resource* resource = Find(buffers[i], ResourceKind::Buffer, "VSSetConstantBuffers1");
+		if (!resource || !firstConstants || !numConstants) continue;
+
+		// 範囲は 16 定数（256 バイト）単位で、１回に設定できるのは 4096 定数まで
+		uint32_t first = firstConstants[i];
+		uint32_t count = numConstants[i];
+		if (first % 16 != 0) Error("VSSetConstantBuffers1", "first constant is not a multiple of 16");
+		if (count == 0 || count % 16 != 0 || count > 4096) Error("VSSetConstantBuffers1", "number of constants is not a multiple of 16 up to 4096");
+		if ((static_cast<uint64_t>(first) + count) * 16 > resource->size) Error("VSSetConstantBuffers1", "range is out of the buffer");
+	}
+	Issue(NullRenderCommand::VSSetConstantBuffers1, startSlot, numBuffers ? GetResourceId(buffers[0]) : 0,
+		numBuffers && firstConstants ? firstConstants[0] : 0);
+}
+
+//--------------------------------------------------------------------------------------
+// RS
+//--------------------------------------------------------------------------------------
+void NullRenderContext::RSSetState(RenderRasterizerState* rasterizerState)
+{
+	Find(rasterizerState, ResourceKind::RasterizerState, "RSSetState");
+	Issue(NullRenderCommand::RSSetState, GetResourceId(rasterizerState));
+}
+
+//--------------------------------------------------------------------------------------
+// PS
+//--------------------------------------------------------------------------------------
+void NullRenderContext::PSSetShader(RenderPixelShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances)
+{
+	if (numClassInstances > 0 && !classInstances) Error("PSSetShader", "class instances are null");
+
+	Find(shader, ResourceKind::PixelShader, "PSSetShader");
+	m_pixelShader = shader;
+	Issue(NullRenderCommand::PSSetShader, GetResourceId(shader));
+}
+
+void NullRenderContext::PSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers)
+{
+	for (uint32_t i = 0; i < numBuffers; i++)
+	{
+		const Resource* resource = Find(buffers[i], ResourceKind::Buffer, "PSSetConstantBuffers");
+		if (resource && resource->size % 16 != 0) Error("PSSetConstantBuffers", "size is not a multiple of 16");
+	}
+	Issue(NullRenderCommand::PSSetConstantBuffers, startSlot, numBuffers, numBuffers ? GetResourceId(buffers[0]) : 0);
+}
+
+void NullRenderContext::PSSetShaderResources(uint32_t startSlot, uint32_t numViews, RenderShaderResource* const* views)
+{
+	for (uint32_t i = 0; i < numViews; i++)
+	{
+		Find(views[i], ResourceKind::ShaderResource, "PSSetShaderResources");
+	}
+	Issue(NullRenderCommand::PSSetShaderResources, startSlot, numViews, numViews ? GetResourceId(views[0]) : 0);
+}
+
+void NullRenderContext::PSSetSamplers(uint32_t startSlot, uint32_t numSamplers, RenderSampler* const* samplers)
+{
+	for (uint32_t i = 0; i < numSamplers; i++)
+	{
+		Find(samplers[i], ResourceKind::Sampler, "PSSetSamplers");
+	}
+	Issue(NullRenderCommand::PSSetSamplers, startSlot, numSamplers, numSamplers ? GetResourceId(samplers[0]) : 0);
+}
+
+//--------------------------------------------------------------------------------------
+// OM
+//--------------------------------------------------------------------------------------
+void NullRenderContext::OMSetDepthStencilState(RenderDepthStencilState* depthStencilState, uint32_t stencilRef)
+{
+	Find(depthStencilState, ResourceKind::DepthStencilState, "OMSetDepthStencilState");
+	Issue(NullRenderCommand::OMSetDepthStencilState, GetResourceId(depthStencilState), stencilRef);
+}
+
+void NullRenderContext::OMSetBlendState(RenderBlendState* blendState, const float blendFactor[4], uint32_t sampleMask)
+{
+	(void)blendFactor;
+
+	Find(blendState, ResourceKind::BlendState, "OMSetBlendState");
+	Issue(NullRenderCommand::OMSetBlendState, GetResourceId(blendState), sampleMask);
+}
+
+//--------------------------------------------------------------------------------------
+// リソース
+//--------------------------------------------------------------------------------------
+void* NullRenderContext::Map(RenderBuffer* buffer, RenderMap mapType)
+{
+	Issue(NullRenderCommand::Map, GetResourceId(buffer), static_cast<uint32_t>(mapType));
+
+	Resource* resource = Find(buffer, ResourceKind::Buffer, "Map");
+	if (!resource)
+	{
+		if (!buffer) Error("Map", "buffer is null");
+		return nullptr;
+	}
+	if (!resource->isDynamic)
+	{
+		Error("Map", "buffer is not dynamic");
+		return nullptr;
+	}
+	if (resource->isMapped)
+	{
+		Error("Map", "buffer is already mapped");
+		return nullptr;
+	}
+
+	resource->isMapped = true;
+	m_mappedCount++;
+
+	m_stats.maps++;
+	m_stats.mappedBytes += resource->size;
+
+	return resource->memory.data();
+}
+
+void NullRenderContext::Unmap(RenderBuffer* buffer)
+{
+	Issue(NullRenderCommand::Unmap, GetResourceId(buffer));
+
+	Resource* resource = Find(buffer, ResourceKind::Buffer, "Unmap");
+	if (!resource || !resource->isMapped)
+	{
+		Error("Unmap", "buffer is not mapped");
+		return;
+	}
+
+	resource->isMapped = false;
+	m_mappedCount--;
+}
+
+//--------------------------------------------------------------------------------------
+// 描画の前に必要なステートが設定されているか調べる関数
+//--------------------------------------------------------------------------------------
+void NullRenderContext::ValidateDraw(const char* command, bool isIndexed, uint32_t indexCount, uint32_t startIndexLocation)
+{
+	if (!m_inputLayout) Error(command, "input layout is not set");
+	if (!m_vertexShader) Error(command, "vertex shader is not set");
+	if (!m_pixelShader) Error(command, "pixel shader is not set");
+	if (m_topology == RenderTopology::Undefined) Error(command, "primitive topology is not set");
+	if (m_mappedCount > 0) Error(command, "a buffer is still mapped");
+
+	// 入力レイアウトが使うスロットに頂点バッファが設定されているか
+	uintptr_t layout = ToValue(m_inputLayout);
+	if (layout > 0 && layout <= m_resources.size())
+	{
+		uint32_t slotCount = m_resources[layout - 1].size;
+		for (uint32_t slot = 0; slot < slotCount && slot < MAX_VERTEX_BUFFERS; slot++)
+		{
+			if (!m_vertexBuffers[slot])
+			{
+				Error(command, "vertex buffer is not set");
+				break;
+			}
+		}
+	}
+
+	if (!isIndexed) return;
+
+	// インデックスバッファの範囲に収まっているか
+	uintptr_t indexBuffer = ToValue(m_indexBuffer);
+	if (indexBuffer == 0 || indexBuffer > m_resources.size())
+	{
+		Error(command, "index buffer is not set");
+		return;
+	}
+	uint64_t end = m_indexOffset + (uint64_t(startIndexLocation) + indexCount) * IndexSize(m_indexFormat);
+	if (end > m_resources[indexBuffer - 1].size) Error(command, "indices are out of the index buffer");
+}
+
+//--------------------------------------------------------------------------------------
+// 描画
+//--------------------------------------------------------------------------------------
+void NullRenderContext::Draw(uint32_t vertexCount, uint32_t startVertexLocation)
+{
+	ValidateDraw("Draw", false, 0, 0);
+
+	m_stats.draws++;
+	m_stats.instances++;
+	m_stats.vertices += vertexCount;
+	Issue(NullRenderCommand::Draw, vertexCount, startVertexLocation);
+}
+
+void NullRenderContext::DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation)
+{
+	ValidateDraw("DrawIndexed", true, indexCount, startIndexLocation);
+
+	m_stats.draws++;
+	m_stats.instances++;
+	m_stats.vertices += indexCount;
+	Issue(NullRenderCommand::DrawIndexed, indexCount, startIndexLocation, static_cast<uint32_t>(baseVertexLocation));
+}
+
+void NullRenderContext::DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+	uint32_t startIndexLocation, int32_t baseVertexLocation, uint32_t startInstanceLocation)
+{
+	(void)baseVertexLocation;
+
+	ValidateDraw("DrawIndexedInstanced", true, indexCountPerInstance, startIndexLocation);
+
+	m_stats.draws++;
+	m_stats.instances += instanceCount;
+	m_stats.vertices += uint64_t(indexCountPerInstance) * instanceCount;
+	Issue(NullRenderCommand::DrawIndexedInstanced, indexCountPerInstance, instanceCount, startInstanceLocation);
+}
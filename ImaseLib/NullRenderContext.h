@@ -0,0 +1,273 @@
+﻿//--------------------------------------------------------------------------------------
+// File: NullRenderContext.h
+//
+// GPU を使わずに描画コマンドの検証と計測だけを行う IRenderContext の実装
+//
+// Usage: Create～ 関数でダミーのリソースを作成し、D3D11RenderContext の代わりに使います。
+//        描画の時に必要なステート（入力レイアウト・シェーダー・トポロジー・頂点バッファ・
+//        インデックスバッファ）が設定されているか、Map と Unmap が対になっているか等を調べ、
+//        問題があればエラーの数を数えて最後のエラーの内容を覚えておきます。
+//        コマンドの数・描画の回数・書き込んだバイト数を数えるので、ウインドウや GPU のない
+//        環境でもフレームの CPU 側の処理を実行して計測できます。
+//        SetRecording(true) にすると発行したコマンドを記録します（テスト用）。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	Imase::NullRenderContext context;
+//	Imase::RenderBuffer* constantBuffer = context.CreateBuffer(80, true);
+//
+//	context.ResetStats();
+//	... // IRenderContext として描画する
+//	if (context.GetStats().errors > 0) printf("%s\n", context.GetLastError());
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RenderContext.h"
+
+namespace Imase
+{
+	// コマンドの種類
+	enum class NullRenderCommand : uint8_t
+	{
+		IASetInputLayout,
+		IASetPrimitiveTopology,
+		IASetIndexBuffer,
+		IASetVertexBuffers,
+		VSSetShader,
+		VSSetConstantBuffers,
+		VSSetConstantBuffers1,
+		RSSetState,
+		PSSetShader,
+		PSSetConstantBuffers,
+		PSSetShaderResources,
+		PSSetSamplers,
+		OMSetDepthStencilState,
+		OMSetBlendState,
+		Map,
+		Unmap,
+		Draw,
+		DrawIndexed,
+		DrawIndexedInstanced,
+	};
+
+	// 記録したコマンド
+	struct NullRenderCommandRecord
+	{
+		// コマンドの種類
+		NullRenderCommand type;
+
+		// 主な引数（設定系はスロットと数・リソースの番号、描画系は数と開始位置）
+		uint32_t args[3];
+	};
+
+	// コマンドの数
+	struct NullRenderStats
+	{
+		// 発行したコマンドの数（描画・Map・Unmap を含む）
+		uint32_t commands;
+
+		// ステートを設定した回数
+		uint32_t stateChanges;
+
+		// 描画の回数
+		uint32_t draws;
+
+		// 描画したインスタンスの数（インスタンス描画でない場合は１）
+		uint64_t instances;
+
+		// 描画した頂点（インデックス）の数
+		uint64_t vertices;
+
+		// Map した回数と書き込める領域のバイト数
+		uint32_t maps;
+		uint64_t mappedBytes;
+
+		// 検証で見つかったエラーの数
+		uint32_t errors;
+	};
+
+	// GPU を使わない IRenderContext
+	class NullRenderContext : public IRenderContext
+	{
+	public:
+
+		// 頂点バッファのスロットの数
+		static constexpr uint32_t MAX_VERTEX_BUFFERS = 16;
+
+		NullRenderContext();
+
+		// ----- リソースの作成（ハンドルはこのコンテキストでのみ有効） ----- //
+
+		/// <summary>
+		/// バッファを作成する関数
+		/// </summary>
+		/// <param name="byteWidth">バイト数</param>
+		/// <param name="isDynamic">CPU から書き込む場合は true（Map できる）</param>
+		RenderBuffer* CreateBuffer(uint32_t byteWidth, bool isDynamic);
+
+		/// <summary>
+		/// 入力レイアウトを作成する関数
+		/// </summary>
+		/// <param name="slotCount">使用する頂点バッファのスロットの数（描画時に設定されているか調べる）</param>
+		RenderInputLayout* CreateInputLayout(uint32_t slotCount);
+
+		RenderVertexShader* CreateVertexShader();
+		RenderPixelShader* CreatePixelShader();
+		RenderShaderResource* CreateShaderResource();
+		RenderSampler* CreateSampler();
+		RenderRasterizerState* CreateRasterizerState();
+		RenderDepthStencilState* CreateDepthStencilState();
+		RenderBlendState* CreateBlendState();
+
+		// ----- 検証と計測 ----- //
+
+		// コマンドの数を 0 に戻す関数（フレームの最初に呼ぶ）
+		void ResetStats() { m_stats = {}; }
+
+		// コマンドの数を取得する関数
+		const NullRenderStats& GetStats() const { return m_stats; }
+
+		// 最後のエラーの内容を取得する関数（エラーがない場合は空文字列）
+		const char* GetLastError() const { return m_lastError.c_str(); }
+
+		// 設定済みのステートを全て解除する関数（ClearState と同じ）
+		void ClearState();
+
+		// コマンドを記録するか設定する関数
+		void SetRecording(bool isRecording) { m_isRecording = isRecording; }
+
+		// 記録したコマンドを取得する関数
+		const std::vector<NullRenderCommandRecord>& GetRecordedCommands() const { return m_records; }
+
+		// 記録したコマンドを削除する関数
+		void ClearRecordedCommands() { m_records.clear(); }
+
+		/// <summary>
+		/// ハンドルからリソースの番号を取得する関数（nullptr は 0、記録したコマンドの引数と同じ番号）
+		/// </summary>
+		template <class Handle>
+		static uint32_t GetResourceId(Handle* handle) { return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(handle)); }
+
+		// ----- IRenderContext ----- //
+
+		void IASetInputLayout(RenderInputLayout* inputLayout) override;
+		void IASetPrimitiveTopology(RenderTopology topology) override;
+		void IASetIndexBuffer(RenderBuffer* buffer, RenderIndexFormat format, uint32_t offset) override;
+		void IASetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets) override;
+
+		void VSSetShader(RenderVertexShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances) override;
+		void VSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers) override;
+		void VSSetConstantBuffers1(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers,
+			const uint32_t* firstConstants, const uint32_t* numConstants) override;
+
+		void RSSetState(RenderRasterizerState* rasterizerState) override;
+
+		void PSSetShader(RenderPixelShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances) override;
+		void PSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers) override;
+		void PSSetShaderResources(uint32_t startSlot, uint32_t numViews, RenderShaderResource* const* views) override;
+		void PSSetSamplers(uint32_t startSlot, uint32_t numSamplers, RenderSampler* const* samplers) override;
+
+		void OMSetDepthStencilState(RenderDepthStencilState* depthStencilState, uint32_t stencilRef) override;
+		void OMSetBlendState(RenderBlendState* blendState, const float blendFactor[4], uint32_t sampleMask) override;
+
+		void* Map(RenderBuffer* buffer, RenderMap mapType) override;
+		void Unmap(RenderBuffer* buffer) override;
+
+		void Draw(uint32_t vertexCount, uint32_t startVertexLocation) override;
+		void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation) override;
+		void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+			uint32_t startIndexLocation, int32_t baseVertexLocation, uint32_t startInstanceLocation) override;
+
+	private:
+
+		// リソースの種類
+		enum class ResourceKind : uint8_t
+		{
+			Buffer,
+			InputLayout,
+			VertexShader,
+			PixelShader,
+			ShaderResource,
+			Sampler,
+			RasterizerState,
+			DepthStencilState,
+			BlendState,
+		};
+
+		// リソース
+		struct Resource
+		{
+			// 種類
+			ResourceKind kind;
+
+			// バッファはバイト数、入力レイアウトは頂点バッファのスロットの数
+			uint32_t size;
+
+			// CPU から書き込めるバッファなら true
+			bool isDynamic;
+
+			// Map 中なら true
+			bool isMapped;
+
+			// Map で返す領域（CPU から書き込めるバッファのみ）
+			std::vector<uint8_t> memory;
+		};
+
+		// リソースを追加してハンドル（番号 + 1）を返す関数
+		uint32_t AddResource(ResourceKind kind, uint32_t size, bool isDynamic);
+
+		// ハンドルからリソースを取得する関数（nullptr の場合や種類が違う場合はエラーにして nullptr を返す）
+		Resource* Find(const void* handle, ResourceKind kind, const char* command);
+
+		// コマンドを数えて記録する関数
+		void Issue(NullRenderCommand type, uint32_t a0 = 0, uint32_t a1 = 0, uint32_t a2 = 0);
+
+		// エラーを記録する関数
+		void Error(const char* command, const char* message);
+
+		// 描画の前に必要なステートが設定されているか調べる関数
+		void ValidateDraw(const char* command, bool isIndexed, uint32_t indexCount, uint32_t startIndexLocation);
+
+	private:
+
+		// リソース（ハンドルの値 - 1 が番号）
+		std::vector<Resource> m_resources;
+
+		// 設定されているリソースのハンドル
+		const void* m_inputLayout = nullptr;
+		const void* m_indexBuffer = nullptr;
+		const void* m_vertexBuffers[MAX_VERTEX_BUFFERS] = {};
+		const void* m_vertexShader = nullptr;
+		const void* m_pixelShader = nullptr;
+
+		// インデックスの形式と開始位置
+		RenderIndexFormat m_indexFormat = RenderIndexFormat::UInt16;
+		uint32_t m_indexOffset = 0;
+
+		// トポロジー
+		RenderTopology m_topology = RenderTopology::Undefined;
+
+		// Map 中のバッファの数
+		uint32_t m_mappedCount = 0;
+
+		// コマンドの数
+		NullRenderStats m_stats = {};
+
+		// 最後のエラーの内容
+		std::string m_lastError;
+
+		// コマンドを記録する場合は true
+		bool m_isRecording = false;
+
+		// 記録したコマンド
+		std::vector<NullRenderCommandRecord> m_records;
+	};
+}
@@ -0,0 +1,643 @@
+﻿//--------------------------------------------------------------------------------------
+// File: OcclusionCulling.cpp
+//
+// マスク付きの低解像度の階層深度バッファを使ったソフトウェアオクルージョンカリング
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "OcclusionCulling.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+using namespace Imase;
+
+namespace
+{
+	// 並列化する場合の１スレッドあたりの最小の数
+	constexpr size_t MIN_TRIANGLES_PER_THREAD = 64;
+	constexpr size_t MIN_OBJECTS_PER_THREAD = 1024;
+
+	// 遮蔽物を切り取るガードバンドの範囲（NDC、画面の外側の大きな座標で精度が落ちないようにする）
+	constexpr float GUARD_BAND = 2.0f;
+
+	// クリッピングの平面（深度の範囲の２枚と、ガードバンドの４枚）
+	// 深度の範囲（0 <= z <= w）で切り取るので、Reverse-Z でもニア平面の手前は遮蔽物にならない
+	constexpr int CLIP_PLANE_COUNT = 6;
+	constexpr int MAX_CLIP_VERTICES = 3 + CLIP_PLANE_COUNT;
+
+	const Math::Vector4 CLIP_PLANES[CLIP_PLANE_COUNT] =
+	{
+		Math::Vector4(0.0f, 0.0f, 1.0f, 0.0f),			// z >= 0
+		Math::Vector4(0.0f, 0.0f, -1.0f, 1.0f),			// z <= w
+		Math::Vector4(1.0f, 0.0f, 0.0f, GUARD_BAND),	// x >= -GUARD_BAND * w
+		Math::Vector4(-1.0f, 0.0f, 0.0f, GUARD_BAND),	// x <= GUARD_BAND * w
+		Math::Vector4(0.0f, 1.0f, 0.0f, GUARD_BAND),	// y >= -GUARD_BAND * w
+		Math::Vector4(0.0f, -1.0f, 0.0f, GUARD_BAND),	// y <= GUARD_BAND * w
+	};
+
+	// w がこれ以下の頂点を含む AABB はカメラをまたぐので見えているものとする
+	constexpr float MIN_W = 1e-5f;
+
+	// １行のマスクが全て塗られている状態
+	constexpr uint32_t FULL_ROW = 0xffffffff;
+
+	// 時計
+	using Clock = std::chrono::steady_clock;
+
+	// 経過時間（秒）
+	inline double Seconds(Clock::time_point start, Clock::time_point end)
+	{
+		return std::chrono::duration<double>(end - start).count();
+	}
+
+	// first ビット目から last ビット目の手前までが 1 のマスク（0 <= first <= last <= 32）
+	inline uint32_t SpanMask(int32_t first, int32_t last)
+	{
+		uint32_t high = last >= 32 ? FULL_ROW : (1u << last) - 1;
+		uint32_t low = (1u << first) - 1;
+		return high & ~low;
+	}
+
+	// 位置をビュー行列×射影行列で変換する関数
+	inline Math::Vector4 TransformClip(const Math::Vector3& p, const Math::Matrix& m)
+	{
+		return Math::Vector4(
+			p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+			p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+			p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2],
+			p.x * m.m[0][3] + p.y * m.m[1][3] + p.z * m.m[2][3] + m.m[3][3]);
+	}
+
+	//----------------------------------------------------------------------------------
+	// ４ピクセル分の辺の式（SIMD）
+	//----------------------------------------------------------------------------------
+#if defined(IMASE_MATH_SSE2)
+	using EdgeVector = __m128;
+
+	// 左端の値と１ピクセルの変化量から４ピクセル分の値を作る関数
+	inline EdgeVector EdgeSet(float e, float step) { return _mm_setr_ps(e, e + step, e + step * 2.0f, e + step * 3.0f); }
+
+	// 全てのピクセルに同じ値を足す関数
+	inline EdgeVector EdgeAdd(EdgeVector e, EdgeVector step) { return _mm_add_ps(e, step); }
+	inline EdgeVector EdgeSplat(float v) { return _mm_set1_ps(v); }
+
+	// ３つの辺の式が全て 0 以上のピクセルのマスクを求める関数（ビット i がピクセル i）
+	inline uint32_t EdgeCoverage(EdgeVector e0, EdgeVector e1, EdgeVector e2)
+	{
+		__m128 zero = _mm_setzero_ps();
+		__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+		return static_cast<uint32_t>(_mm_movemask_ps(inside));
+	}
+#elif defined(IMASE_MATH_NEON)
+	using EdgeVector = float32x4_t;
+
+	inline EdgeVector EdgeSet(float e, float step)
+	{
+		const float values[4] = { e, e + step, e + step * 2.0f, e + step * 3.0f };
+		return vld1q_f32(values);
+	}
+
+	inline EdgeVector EdgeAdd(EdgeVector e, EdgeVector step) { return vaddq_f32(e, step); }
+	inline EdgeVector EdgeSplat(float v) { return vdupq_n_f32(v); }
+
+	inline uint32_t EdgeCoverage(EdgeVector e0, EdgeVector e1, EdgeVector e2)
+	{
+		float32x4_t zero = vdupq_n_f32(0.0f);
+		uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(e0, zero), vcgeq_f32(e1, zero)), vcgeq_f32(e2, zero));
+		inside = vshrq_n_u32(inside, 31);
+		return vgetq_lane_u32(inside, 0)
+			| (vgetq_lane_u32(inside, 1) << 1)
+			| (vgetq_lane_u32(inside, 2) << 2)
+			| (vgetq_lane_u32(inside, 3) << 3);
+	}
+#else
+	struct EdgeVector { float v[4]; };
+
+	inline EdgeVector EdgeSet(float e, float step) { return { { e, e + step, e + step * 2.0f, e + step * 3.0f } }; }
+
+	inline EdgeVector EdgeAdd(EdgeVector e, EdgeVector step)
+	{
+		for (int i = 0; i < 4; i++) e.v[i] += step.v[i];
+		return e;
+	}
+
+	inline EdgeVector EdgeSplat(float v) { return { { v, v, v, v } }; }
+
+	inline uint32_t EdgeCoverage(EdgeVector e0, EdgeVector e1, EdgeVector e2)
+	{
+		uint32_t mask = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if (e0.v[i] >= 0.0f && e1.v[i] >= 0.0f && e2.v[i] >= 0.0f) mask |= 1u << i;
+		}
+		return mask;
+	}
+#endif
+}
+
+//--------------------------------------------------------------------------------------
+// コンストラクタ
+//--------------------------------------------------------------------------------------
+OcclusionCuller::OcclusionCuller()
+{
+	Resize(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+}
+
+//--------------------------------------------------------------------------------------
+// バッファの大きさを設定する関数
+//--------------------------------------------------------------------------------------
+bool OcclusionCuller::Resize(uint32_t width, uint32_t height)
+{
+	if (width == 0 || height == 0 || width % TILE_WIDTH != 0 || height % TILE_HEIGHT != 0) return false;
+
+	m_width = width;
+	m_height = height;
+	m_tilesX = width / TILE_WIDTH;
+	m_tilesY = height / TILE_HEIGHT;
+	m_tiles.assign(size_t(m_tilesX) * m_tilesY, Tile());
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// フレームを開始する関数
+//--------------------------------------------------------------------------------------
+void OcclusionCuller::BeginFrame(const Math::Matrix& viewProjection)
+{
+	m_viewProjection = viewProjection;
+	m_triangles.clear();
+	m_stats = {};
+
+	// 何も塗られていない状態（1/w が 0 は無限遠）
+	std::memset(m_tiles.data(), 0, m_tiles.size() * sizeof(Tile));
+}
+
+//--------------------------------------------------------------------------------------
+// 遮蔽物を追加する関数
+//--------------------------------------------------------------------------------------
+void OcclusionCuller::AddOccluder(const Math::Vector3* positions, size_t vertexCount,
+	const uint16_t* indices, size_t indexCount, const Math::Matrix& world)
+{
+	Clock::time_point start = Clock::now();
+
+	// クリップ空間へ変換する
+	Math::Matrix worldViewProjection = world * m_viewProjection;
+	m_clipVertices.resize(vertexCount);
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		m_clipVertices[i] = TransformClip(positions[i], worldViewProjection);
+	}
+
+	for (size_t i = 0; i + 2 < indexCount; i += 3)
+	{
+		m_stats.occluderTriangles++;
+
+		if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount) continue;
+
+		const Math::Vector4* v[3] = { &m_clipVertices[indices[i]], &m_clipVertices[indices[i + 1]], &m_clipVertices[indices[i + 2]] };
+
+		// 全ての頂点が１つの平面の外側にあれば捨てる、全て内側にあれば切り取る必要はない
+		int outsideAll = (1 << CLIP_PLANE_COUNT) - 1;
+		int outsideAny = 0;
+		for (int k = 0; k < 3; k++)
+		{
+			int outside = 0;
+			for (int p = 0; p < CLIP_PLANE_COUNT; p++)
+			{
+				if (CLIP_PLANES[p].Dot(*v[k]) < 0.0f) outside |= 1 << p;
+			}
+			outsideAll &= outside;
+			outsideAny |= outside;
+		}
+		if (outsideAll) continue;
+		if (!outsideAny)
+		{
+			SetupTriangle(*v[0], *v[1], *v[2]);
+			continue;
+		}
+
+		// 外側にはみ出た平面だけで切り取る
+		Math::Vector4 polygon[2][MAX_CLIP_VERTICES];
+		int count = 3;
+		for (int k = 0; k < 3; k++) polygon[0][k] = *v[k];
+
+		int current = 0;
+		for (int p = 0; p < CLIP_PLANE_COUNT && count >= 3; p++)
+		{
+			if (!(outsideAny & (1 << p))) continue;
+			count = ClipPolygon(polygon[current], count, CLIP_PLANES[p], polygon[current ^ 1]);
+			current ^= 1;
+		}
+
+		// 扇形に三角形へ分ける
+		for (int k = 1; k + 1 < count; k++)
+		{
+			SetupTriangle(polygon[current][0], polygon[current][k], polygon[current][k + 1]);
+		}
+	}
+
+	m_stats.rasterizeSeconds += Seconds(start, Clock::now());
+}
+
+//--------------------------------------------------------------------------------------
+// 多角形を平面の内側で切り取る関数（Sutherland-Hodgman）
+//--------------------------------------------------------------------------------------
+int OcclusionCuller::ClipPolygon(const Math::Vector4* input, int count, const Math::Vector4& plane, Math::Vector4* output)
+{
+	int n = 0;
+	for (int i = 0; i < count; i++)
+	{
+		const Math::Vector4& a = input[i];
+		const Math::Vector4& b = input[(i + 1) % count];
+		float da = plane.Dot(a);
+		float db = plane.Dot(b);
+
+		if (da >= 0.0f) output[n++] = a;
+
+		// 辺が平面をまたぐ場合は交点を追加する
+		if ((da >= 0.0f) != (db >= 0.0f))
+		{
+			output[n++] = a + (b - a) * (da / (da - db));
+		}
+	}
+	return n;
+}
+
+//--------------------------------------------------------------------------------------
+// クリッピング後の三角形を設定する関数
+//--------------------------------------------------------------------------------------
+void OcclusionCuller::SetupTriangle(const Math::Vector4& v0, const Math::Vector4& v1, const Math::Vector4& v2)
+{
+	const Math::Vector4* v[3] = { &v0, &v1, &v2 };
+
+	// 画面の位置（ピクセル）と 1/w
+	float x[3], y[3], z[3];
+	for (int i = 0; i < 3; i++)
+	{
+		if (!(v[i]->w > 0.0f)) return;
+
+		float invW = 1.0f / v[i]->w;
+		x[i] = (v[i]->x * invW + 1.0f) * 0.5f * static_cast<float>(m_width);
+		y[i] = (1.0f - v[i]->y * invW) * 0.5f * static_cast<float>(m_height);
+		z[i] = invW;
+	}
+
+	// 面積の２倍（両面とも遮蔽物なので、負の場合は頂点を入れ替えて内側を正にする）
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (area == 0.0f) return;
+	if (area < 0.0f)
+	{
+		std::swap(x[1], x[2]);
+		std::swap(y[1], y[2]);
+		std::swap(z[1], z[2]);
+		area = -area;
+	}
+
+	Triangle triangle;
+
+	// 辺の式（辺 i は頂点 i → i + 1、ピクセルの中心で判定する）
+	// 隣の三角形と共有する辺の式が符号だけ逆の同じ値になるように、辺の２つの頂点を
+	// 決まった順番（x, y の小さい順）にして求めてから向きを合わせる（境目のピクセルに隙間ができない）
+	for (int i = 0; i < 3; i++)
+	{
+		int j = (i + 1) % 3;
+		bool isSwapped = x[j] < x[i] || (x[j] == x[i] && y[j] < y[i]);
+		int p = isSwapped ? j : i;
+		int q = isSwapped ? i : j;
+		float a = y[p] - y[q];
+		float b = x[q] - x[p];
+		float c = -(a * x[p] + b * y[p]);
+		triangle.a[i] = isSwapped ? -a : a;
+		triangle.b[i] = isSwapped ? -b : b;
+		triangle.c[i] = isSwapped ? -c : c;
+	}
+
+	// 1/w の平面の式
+	float dz1 = z[1] - z[0];
+	float dz2 = z[2] - z[0];
+	triangle.zx = (dz1 * (y[2] - y[0]) - dz2 * (y[1] - y[0])) / area;
+	triangle.zy = (dz2 * (x[1] - x[0]) - dz1 * (x[2] - x[0])) / area;
+	triangle.z0 = z[0] - triangle.zx * x[0] - triangle.zy * y[0];
+	triangle.minDepth = std::min({ z[0], z[1], z[2] });
+
+	// 外接矩形（中心が含まれる可能性のあるピクセル）
+	triangle.minX = std::max(static_cast<int32_t>(floorf(std::min({ x[0], x[1], x[2] }) - 0.5f)), 0);
+	triangle.minY = std::max(static_cast<int32_t>(floorf(std::min({ y[0], y[1], y[2] }) - 0.5f)), 0);
+	triangle.maxX = std::min(static_cast<int32_t>(ceilf(std::max({ x[0], x[1], x[2] }) + 0.5f)), static_cast<int32_t>(m_width));
+	triangle.maxY = std::min(static_cast<int32_t>(ceilf(std::max({ y[0], y[1], y[2] }) + 0.5f)), static_cast<int32_t>(m_height));
+	if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY) return;
+
+	m_triangles.push_back(triangle);
+	m_stats.rasterizedTriangles++;
+}
+
+//--------------------------------------------------------------------------------------
+// 追加した遮蔽物をバッファへラスタライズする関数
+//--------------------------------------------------------------------------------------
+void OcclusionCuller::RenderOccluders(unsigned int threadCount)
+{
+	if (m_triangles.empty()) return;
+
+	Clock::time_point start = Clock::now();
+
+	if (threadCount == 0)
+	{
+		threadCount = JobSystem::GetDefault().GetWorkerCount();
+	}
+
+	size_t maxThreads = (m_triangles.size() + MIN_TRIANGLES_PER_THREAD - 1) / MIN_TRIANGLES_PER_THREAD;
+	threadCount = static_cast<unsigned int>(std::min<size_t>({ threadCount, maxThreads, m_tilesY }));
+
+	// タイルの行は互いに重ならないので、空いているワーカーが残りの行を盗んでラスタライズする
+	auto rasterizeRows = [&](size_t first, size_t last)
+	{
+		for (size_t row = first; row < last; row++)
+		{
+			RasterizeTileRow(static_cast<int32_t>(row));
+		}
+	};
+
+	if (threadCount <= 1)
+	{
+		rasterizeRows(0, m_tilesY);
+	}
+	else
+	{
+		JobSystem::GetDefault().ParallelFor(0, m_tilesY, 1, rasterizeRows);
+	}
+
+	m_stats.rasterizeSeconds += Seconds(start, Clock::now());
+}
+
+//--------------------------------------------------------------------------------------
+// タイルの行をラスタライズする関数
+//--------------------------------------------------------------------------------------
+void OcclusionCuller::RasterizeTileRow(int32_t tileY)
+{
+	int32_t rowMinY = tileY * TILE_HEIGHT;
+	int32_t rowMaxY = rowMinY + TILE_HEIGHT;
+	Tile* tiles = &m_tiles[size_t(tileY) * m_tilesX];
+
+	// 追加した順番にラスタライズする
+	for (const Triangle& triangle : m_triangles)
+	{
+		if (triangle.maxY <= rowMinY || triangle.minY >= rowMaxY) continue;
+
+		int32_t tileMinX = triangle.minX / TILE_WIDTH;
+		int32_t tileMaxX = (triangle.maxX - 1) / TILE_WIDTH;
+		for (int32_t tileX = tileMinX; tileX <= tileMaxX; tileX++)
+		{
+			RasterizeTile(triangle, tileX, tileY, &tiles[tileX]);
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 三角形をタイルへラスタライズする関数
+//--------------------------------------------------------------------------------------
+void OcclusionCuller::RasterizeTile(const Triangle& triangle, int32_t tileX, int32_t tileY, Tile* tile)
+{
+	int32_t left = tileX * TILE_WIDTH;
+	int32_t top = tileY * TILE_HEIGHT;
+
+	// タイルと外接矩形の重なる範囲
+	int32_t x0 = std::max(triangle.minX, left);
+	int32_t y0 = std::max(triangle.minY, top);
+	int32_t x1 = std::min(triangle.maxX, left + TILE_WIDTH);
+	int32_t y1 = std::min(triangle.maxY, top + TILE_HEIGHT);
+	if (x0 >= x1 || y0 >= y1) return;
+
+	// ----- 塗るピクセルのマスク ----- //
+
+	// 横は４ピクセル単位に広げて判定し、範囲外のビットを落とす
+	// （辺の式は常にタイルの左端から足していく、外接矩形によって足す回数が変わると誤差が変わり、
+	//   隣の三角形との境目に隙間ができるため）
+	int32_t groupStart = (x0 - left) & ~3;
+	uint32_t columnMask = SpanMask(x0 - left, x1 - left);
+
+	EdgeVector step4[3];
+	for (int i = 0; i < 3; i++)
+	{
+		step4[i] = EdgeSplat(triangle.a[i] * 4.0f);
+	}
+
+	uint32_t coverage[TILE_HEIGHT] = {};
+	uint32_t anyCoverage = 0;
+	for (int32_t y = y0; y < y1; y++)
+	{
+		float py = static_cast<float>(y) + 0.5f;
+		float px = static_cast<float>(left) + 0.5f;
+
+		EdgeVector e[3];
+		for (int i = 0; i < 3; i++)
+		{
+			e[i] = EdgeSet(triangle.a[i] * px + (triangle.b[i] * py + triangle.c[i]), triangle.a[i]);
+		}
+
+		uint32_t bits = 0;
+		for (int32_t x = 0; x < x1 - left; x += 4)
+		{
+			if (x >= groupStart) bits |= EdgeCoverage(e[0], e[1], e[2]) << x;
+			for (int i = 0; i < 3; i++) e[i] = EdgeAdd(e[i], step4[i]);
+		}
+
+		bits &= columnMask;
+		coverage[y - top] = bits;
+		anyCoverage |= bits;
+	}
+	if (!anyCoverage) return;
+
+	// ----- 三角形のタイルの中で一番遠い 1/w ----- //
+
+	// 平面なので矩形の４隅の最小値以上、三角形の中なので頂点の最小値以上
+	float fx0 = static_cast<float>(x0), fx1 = static_cast<float>(x1);
+	float fy0 = static_cast<float>(y0), fy1 = static_cast<float>(y1);
+	float zx0 = triangle.zx * fx0, zx1 = triangle.zx * fx1;
+	float zy0 = triangle.zy * fy0, zy1 = triangle.zy * fy1;
+	float depth = triangle.z0 + std::min(zx0, zx1) + std::min(zy0, zy1);
+	depth = std::max(depth, triangle.minDepth);
+
+	// ----- タイルの更新 ----- //
+
+	// タイル全体の深度より遠い場合は何も分からない
+	if (depth <= tile->referenceDepth) return;
+
+	bool hasWorking = false;
+	for (int r = 0; r < TILE_HEIGHT; r++) hasWorking |= tile->mask[r] != 0;
+
+	// 作業中の層より十分に手前の場合は作業中の層を捨てて置き換える
+	// （遠い層と混ぜると深度が遠い方に引っ張られて判定に使えなくなるため）
+	if (!hasWorking || depth - tile->workingDepth > tile->workingDepth - tile->referenceDepth)
+	{
+		std::memcpy(tile->mask, coverage, sizeof(coverage));
+		tile->workingDepth = depth;
+	}
+	else
+	{
+		for (int r = 0; r < TILE_HEIGHT; r++) tile->mask[r] |= coverage[r];
+		tile->workingDepth = std::min(tile->workingDepth, depth);
+	}
+
+	// 全てのピクセルが塗られたら作業中の層をタイル全体の深度にする
+	bool isFull = true;
+	for (int r = 0; r < TILE_HEIGHT; r++) isFull &= tile->mask[r] == FULL_ROW;
+	if (isFull)
+	{
+		tile->referenceDepth = tile->workingDepth;
+		tile->workingDepth = 0.0f;
+		std::memset(tile->mask, 0, sizeof(tile->mask));
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// AABB が遮蔽物に隠れていないか調べる関数
+//--------------------------------------------------------------------------------------
+bool OcclusionCuller::IsVisible(const Math::Vector3& center, const Math::Vector3& extents) const
+{
+	// ８つの頂点を画面へ投影した矩形と、一番手前の 1/w
+	float minX = static_cast<float>(m_width), minY = static_cast<float>(m_height);
+	float maxX = 0.0f, maxY = 0.0f;
+	float maxDepth = 0.0f;
+	for (int i = 0; i < 8; i++)
+	{
+		Math::Vector3 corner(
+			center.x + (i & 1 ? extents.x : -extents.x),
+			center.y + (i & 2 ? extents.y : -extents.y),
+			center.z + (i & 4 ? extents.z : -extents.z));
+		Math::Vector4 p = TransformClip(corner, m_viewProjection);
+
+		// カメラをまたぐ場合は見えているものとする
+		if (p.w <= MIN_W) return true;
+
+		float invW = 1.0f / p.w;
+		float sx = (p.x * invW + 1.0f) * 0.5f * static_cast<float>(m_width);
+		float sy = (1.0f - p.y * invW) * 0.5f * static_cast<float>(m_height);
+		minX = std::min(minX, sx);
+		maxX = std::max(maxX, sx);
+		minY = std::min(minY, sy);
+		maxY = std::max(maxY, sy);
+		maxDepth = std::max(maxDepth, invW);
+	}
+
+	// 少しでも重なるピクセルを全て調べる（画面の外は視錐台カリングに任せる）
+	int32_t x0 = std::max(static_cast<int32_t>(floorf(minX)), 0);
+	int32_t y0 = std::max(static_cast<int32_t>(floorf(minY)), 0);
+	int32_t x1 = std::min(static_cast<int32_t>(ceilf(maxX)), static_cast<int32_t>(m_width));
+	int32_t y1 = std::min(static_cast<int32_t>(ceilf(maxY)), static_cast<int32_t>(m_height));
+	if (x0 >= x1 || y0 >= y1) return true;
+
+	int32_t tileMinX = x0 / TILE_WIDTH, tileMaxX = (x1 - 1) / TILE_WIDTH;
+	int32_t tileMinY = y0 / TILE_HEIGHT, tileMaxY = (y1 - 1) / TILE_HEIGHT;
+	for (int32_t tileY = tileMinY; tileY <= tileMaxY; tileY++)
+	{
+		for (int32_t tileX = tileMinX; tileX <= tileMaxX; tileX++)
+		{
+			const Tile& tile = m_tiles[size_t(tileY) * m_tilesX + tileX];
+
+			// タイル全体の深度より手前なら、マスクの層も調べる
+			if (maxDepth >= tile.referenceDepth)
+			{
+				if (maxDepth >= tile.workingDepth) return true;
+
+				// AABB のピクセルが全てマスクの中にある場合だけ隠れている
+				int32_t left = tileX * TILE_WIDTH;
+				int32_t top = tileY * TILE_HEIGHT;
+				uint32_t columnMask = SpanMask(std::max(x0 - left, 0), std::min(x1 - left, TILE_WIDTH));
+				int32_t rowStart = std::max(y0 - top, 0);
+				int32_t rowEnd = std::min(y1 - top, TILE_HEIGHT);
+				for (int32_t r = rowStart; r < rowEnd; r++)
+				{
+					if (columnMask & ~tile.mask[r]) return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+//--------------------------------------------------------------------------------------
+// AABB のオクルージョンカリング
+//--------------------------------------------------------------------------------------
+size_t OcclusionCuller::CullBoxes(const BoxArrays& boxes, const uint32_t* indices, size_t count,
+	uint32_t* visibleIndices, unsigned int threadCount)
+{
+	Clock::time_point start = Clock::now();
+
+	// 範囲の AABB を判定して見えているものの番号を詰めて出力する
+	auto cullRange = [&](size_t begin, size_t end, uint32_t* out)
+	{
+		size_t n = 0;
+		for (size_t i = begin; i < end; i++)
+		{
+			uint32_t index = indices ? indices[i] : static_cast<uint32_t>(i);
+			Math::Vector3 center(boxes.centerX[index], boxes.centerY[index], boxes.centerZ[index]);
+			Math::Vector3 extents(boxes.extentX[index], boxes.extentY[index], boxes.extentZ[index]);
+			if (IsVisible(center, extents)) out[n++] = index;
+		}
+		return n;
+	};
+
+	if (threadCount == 0)
+	{
+		threadCount = JobSystem::GetDefault().GetWorkerCount();
+	}
+
+	size_t maxThreads = (count + MIN_OBJECTS_PER_THREAD - 1) / MIN_OBJECTS_PER_THREAD;
+	threadCount = static_cast<unsigned int>(std::min<size_t>(threadCount, maxThreads));
+
+	size_t total = 0;
+	if (threadCount <= 1)
+	{
+		total = cullRange(0, count, visibleIndices);
+	}
+	else
+	{
+		size_t chunk = (count + threadCount - 1) / threadCount;
+		size_t chunkCount = (count + chunk - 1) / chunk;
+
+		// 各スレッドは自分の範囲の先頭から書き込む（見えている数は範囲の大きさ以下なので重ならない）
+		std::vector<size_t> counts(chunkCount);
+
+		JobSystem::GetDefault().ParallelFor(0, chunkCount, 1, [&](size_t first, size_t last)
+			{
+				for (size_t k = first; k < last; k++)
+				{
+					size_t begin = k * chunk;
+					size_t end = std::min(begin + chunk, count);
+					counts[k] = cullRange(begin, end, visibleIndices + begin);
+				}
+			});
+
+		// 結果を先頭へ詰める
+		total = counts[0];
+		for (size_t k = 1; k < chunkCount; k++)
+		{
+			std::memmove(visibleIndices + total, visibleIndices + k * chunk, counts[k] * sizeof(uint32_t));
+			total += counts[k];
+		}
+	}
+
+	m_stats.testedObjects += static_cast<uint32_t>(count);
+	m_stats.occludedObjects += static_cast<uint32_t>(count - total);
+	m_stats.testSeconds += Seconds(start, Clock::now());
+
+	return total;
+}
+
+//--------------------------------------------------------------------------------------
+// タイルの深度を取得する関数
+//--------------------------------------------------------------------------------------
+float OcclusionCuller::GetTileDepth(uint32_t tileX, uint32_t tileY) const
+{
+	if (tileX >= m_tilesX || tileY >= m_tilesY) return 0.0f;
+
+	return m_tiles[size_t(tileY) * m_tilesX + tileX].referenceDepth;
+}
@@ -0,0 +1,207 @@
+﻿//--------------------------------------------------------------------------------------
+// File: OcclusionCulling.h
+//
+// マスク付きの低解像度の階層深度バッファを使ったソフトウェアオクルージョンカリング
+//
+// Usage: 遮蔽物（オクルーダー）の簡略化したメッシュを CPU で低解像度のバッファへラスタライズし、
+//        オブジェクトの AABB が遮蔽物の後ろに完全に隠れているか判定します。
+//        バッファは 32×8 ピクセルのタイルに分かれていて、タイルごとに
+//        「タイル全体で保証される一番遠い深度」と「塗ったピクセルのマスクとその一番遠い深度」の
+//        ２層を持ちます（Masked Occlusion Culling の方式）。ピクセルごとの深度を持たないので
+//        小さなメモリで高速に判定できます。
+//        深度はクリップ空間の 1/w を使うので、射影行列の深度の向き（Reverse-Z・無限遠）に関係なく
+//        DebugCamera のビュー行列×射影行列をそのまま渡せます。
+//        判定はバッファの解像度の範囲で保守的（遮蔽物はピクセルの中心で塗り、AABB は少しでも
+//        重なるピクセルを全て調べる）なので、見えていると判定されたオブジェクトが実際には
+//        隠れていることはありますが、その逆はほとんどありません。
+//        ラスタライズはタイルの行ごとに、判定はオブジェクトを分割してジョブシステムのワーカーで行い、
+//        ピクセルの内外判定は SIMD で４ピクセルずつ行います。
+//        Windows に依存しないので、どの環境でもコンパイル・計測できます。
+//
+//	<<< 記述例 >>
+//	culler.BeginFrame(Imase::Math::FromSimpleMath(view * proj));
+//	culler.AddOccluder(positions, vertexCount, indices, indexCount, world);
+//	culler.RenderOccluders();
+//
+//	size_t visibleCount = culler.CullBoxes(boxes, candidates, candidateCount, visibleIndices);
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MathCore.h"
+#include "FrustumCulling.h"
+
+namespace Imase
+{
+	// オクルージョンカリングの計測結果
+	struct OcclusionCullingStats
+	{
+		// 追加された遮蔽物の三角形の数
+		uint32_t occluderTriangles;
+
+		// クリッピング・カリング後にラスタライズした三角形の数
+		uint32_t rasterizedTriangles;
+
+		// 判定したオブジェクトの数と隠れていたオブジェクトの数
+		uint32_t testedObjects;
+		uint32_t occludedObjects;
+
+		// ラスタライズと判定の処理時間（秒）
+		double rasterizeSeconds;
+		double testSeconds;
+	};
+
+	// ソフトウェアオクルージョンカリング
+	class OcclusionCuller
+	{
+	public:
+
+		// タイルの大きさ（ピクセル、横は１行のマスクのビット数）
+		static constexpr int TILE_WIDTH = 32;
+		static constexpr int TILE_HEIGHT = 8;
+
+		// バッファの既定の大きさ（ピクセル）
+		static constexpr uint32_t DEFAULT_WIDTH = 320;
+		static constexpr uint32_t DEFAULT_HEIGHT = 192;
+
+		OcclusionCuller();
+
+		/// <summary>
+		/// バッファの大きさを設定する関数
+		/// </summary>
+		/// <param name="width">幅（TILE_WIDTH の倍数）</param>
+		/// <param name="height">高さ（TILE_HEIGHT の倍数）</param>
+		/// <returns>タイルの倍数でない場合は false</returns>
+		bool Resize(uint32_t width, uint32_t height);
+
+		/// <summary>
+		/// フレームを開始する関数（バッファと遮蔽物と計測結果をクリアする）
+		/// </summary>
+		/// <param name="viewProjection">ビュー行列×射影行列</param>
+		void BeginFrame(const Math::Matrix& viewProjection);
+
+		/// <summary>
+		/// 遮蔽物を追加する関数（両面とも遮蔽物として扱う）
+		/// </summary>
+		/// <param name="positions">頂点の位置</param>
+		/// <param name="vertexCount">頂点の数</param>
+		/// <param name="indices">インデックス（三角形リスト）</param>
+		/// <param name="indexCount">インデックスの数</param>
+		/// <param name="world">ワールド行列</param>
+		void AddOccluder(const Math::Vector3* positions, size_t vertexCount,
+			const uint16_t* indices, size_t indexCount, const Math::Matrix& world);
+
+		/// <summary>
+		/// 追加した遮蔽物をバッファへラスタライズする関数
+		/// </summary>
+		/// <param name="threadCount">分割する数（0の場合はジョブシステムのワーカー数、1の場合は呼び出し元のスレッドのみ）</param>
+		void RenderOccluders(unsigned int threadCount = 0);
+
+		/// <summary>
+		/// AABB が遮蔽物に隠れていないか調べる関数
+		/// </summary>
+		/// <param name="center">中心</param>
+		/// <param name="extents">各軸の半分の大きさ</param>
+		/// <returns>見えている可能性がある場合は true</returns>
+		bool IsVisible(const Math::Vector3& center, const Math::Vector3& extents) const;
+
+		/// <summary>
+		/// AABB のオクルージョンカリング
+		/// </summary>
+		/// <param name="boxes">AABB の配列</param>
+		/// <param name="indices">判定する AABB の番号（視錐台カリングの結果など、nullptr の場合は 0 から count - 1）</param>
+		/// <param name="count">判定する数</param>
+		/// <param name="visibleIndices">見えている AABB の番号の出力先（count 個分の領域が必要、indices と別の領域）</param>
+		/// <param name="threadCount">分割する数（0の場合はジョブシステムのワーカー数、1の場合は呼び出し元のスレッドのみ）</param>
+		/// <returns>見えている AABB の数</returns>
+		size_t CullBoxes(const BoxArrays& boxes, const uint32_t* indices, size_t count,
+			uint32_t* visibleIndices, unsigned int threadCount = 0);
+
+		// 計測結果を取得する関数（BeginFrame でクリアされる）
+		const OcclusionCullingStats& GetStats() const { return m_stats; }
+
+		// バッファの大きさを取得する関数
+		uint32_t GetWidth() const { return m_width; }
+		uint32_t GetHeight() const { return m_height; }
+
+		/// <summary>
+		/// タイルの深度を取得する関数（デバッグ表示用）
+		/// </summary>
+		/// <param name="tileX">タイルの横の番号</param>
+		/// <param name="tileY">タイルの縦の番号</param>
+		/// <returns>タイル全体で保証される一番遠い 1/w（0 の場合は何も塗られていない）</returns>
+		float GetTileDepth(uint32_t tileX, uint32_t tileY) const;
+
+	private:
+
+		// タイル
+		struct Tile
+		{
+			// 塗ったピクセルのマスク（１行 32 ビット × TILE_HEIGHT 行）
+			uint32_t mask[TILE_HEIGHT];
+
+			// タイル全体で保証される一番遠い 1/w
+			float referenceDepth;
+
+			// マスクのピクセルで保証される一番遠い 1/w
+			float workingDepth;
+		};
+
+		// ラスタライズする三角形
+		struct Triangle
+		{
+			// 辺の式 E(x, y) = a * x + b * y + c（ピクセル単位、内側が 0 以上）
+			float a[3];
+			float b[3];
+			float c[3];
+
+			// 1/w の平面の式 z(x, y) = z0 + zx * x + zy * y と頂点の 1/w の最小値
+			float z0, zx, zy;
+			float minDepth;
+
+			// 外接矩形（ピクセル、最大値は含まない）
+			int32_t minX, minY, maxX, maxY;
+		};
+
+		// 多角形を平面 dot(plane, position) >= 0 の内側で切り取る関数（頂点の数を返す）
+		static int ClipPolygon(const Math::Vector4* input, int count, const Math::Vector4& plane, Math::Vector4* output);
+
+		// クリッピング後の三角形を設定する関数（クリップ空間の位置）
+		void SetupTriangle(const Math::Vector4& v0, const Math::Vector4& v1, const Math::Vector4& v2);
+
+		// タイルの行をラスタライズする関数
+		void RasterizeTileRow(int32_t tileY);
+
+		// 三角形をタイルへラスタライズする関数
+		static void RasterizeTile(const Triangle& triangle, int32_t tileX, int32_t tileY, Tile* tile);
+
+	private:
+
+		// バッファの大きさとタイルの数
+		uint32_t m_width = 0;
+		uint32_t m_height = 0;
+		uint32_t m_tilesX = 0;
+		uint32_t m_tilesY = 0;
+
+		// タイル
+		std::vector<Tile> m_tiles;
+
+		// ビュー行列×射影行列
+		Math::Matrix m_viewProjection;
+
+		// ラスタライズする三角形
+		std::vector<Triangle> m_triangles;
+
+		// 頂点の変換結果（作業用）
+		std::vector<Math::Vector4> m_clipVertices;
+
+		// 計測結果
+		OcclusionCullingStats m_stats = {};
+	};
+}
@@ -0,0 +1,234 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ParallelRenderExecutor.cpp
+//
+// レンダーキューのパケットを分割して複数のスレッドでコマンドリストへ記録し、順番に実行するクラス
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "ParallelRenderExecutor.h"
+
+#include <algorithm>
+
+#include "JobSystem.h"
+
+using namespace Imase;
+
+namespace
+{
+	// 未設定を表す番号
+	constexpr uint32_t INVALID_INDEX = 0xffffffff;
+}
+
+//--------------------------------------------------------------------------------------
+// チャンクの数だけコマンドリストを用意する関数
+//--------------------------------------------------------------------------------------
+void RenderCommandListRecorder::Prepare(uint32_t chunkCount)
+{
+	while (m_commandLists.size() < chunkCount)
+	{
+		m_commandLists.push_back(std::make_unique<RenderCommandList>());
+	}
+	for (uint32_t i = 0; i < chunkCount; i++)
+	{
+		m_commandLists[i]->Clear();
+	}
+	m_chunkCount = chunkCount;
+}
+
+//--------------------------------------------------------------------------------------
+// チャンクの記録を開始する関数
+//--------------------------------------------------------------------------------------
+IRenderContext* RenderCommandListRecorder::Begin(uint32_t chunk)
+{
+	return m_commandLists[chunk].get();
+}
+
+//--------------------------------------------------------------------------------------
+// 記録したチャンクを再生する関数
+//--------------------------------------------------------------------------------------
+void RenderCommandListRecorder::Execute(uint32_t chunk)
+{
+	if (m_target) m_commandLists[chunk]->Execute(m_target);
+}
+
+//--------------------------------------------------------------------------------------
+// 全てのチャンクに記録したコマンドの数を取得する関数
+//--------------------------------------------------------------------------------------
+size_t RenderCommandListRecorder::GetCommandCount() const
+{
+	size_t count = 0;
+	for (uint32_t i = 0; i < m_chunkCount; i++) count += m_commandLists[i]->GetCommandCount();
+	return count;
+}
+
+//--------------------------------------------------------------------------------------
+// 全てのチャンクに記録したバイト数を取得する関数
+//--------------------------------------------------------------------------------------
+size_t RenderCommandListRecorder::GetByteSize() const
+{
+	size_t size = 0;
+	for (uint32_t i = 0; i < m_chunkCount; i++) size += m_commandLists[i]->GetByteSize();
+	return size;
+}
+
+//--------------------------------------------------------------------------------------
+// ソート済みのキューのパケットを実行する関数
+//--------------------------------------------------------------------------------------
+void ParallelRenderExecutor::Execute(const RenderQueue& queue, IParallelRenderPacketHandler* handler,
+	StateFilteredContext<IRenderContext>* context, IRenderCommandRecorder* recorder, uint32_t chunkCount)
+{
+	m_stats = {};
+	m_parallelStats = {};
+
+	size_t packetCount = queue.GetPacketCount();
+
+	// 並列に記録しない場合はメインスレッドのコンテキストへ直接描画する
+	if (!recorder || chunkCount <= 1)
+	{
+		ExecuteRange(queue, 0, packetCount, handler, *context, &m_stats);
+		m_parallelStats.immediatePackets = packetCount;
+		return;
+	}
+
+	// EXTERNAL_SHADER のパケットで区切り、区切った範囲をチャンクに分ける
+	m_steps.clear();
+	uint32_t totalChunks = 0;
+	size_t begin = 0;
+	while (begin < packetCount)
+	{
+		if (queue.GetSortedPacket(begin).shader == RenderQueue::EXTERNAL_SHADER)
+		{
+			m_steps.push_back({ begin, begin + 1, -1 });
+			begin++;
+			continue;
+		}
+
+		size_t end = begin + 1;
+		while (end < packetCount && queue.GetSortedPacket(end).shader != RenderQueue::EXTERNAL_SHADER) end++;
+
+		// 最小の数を下回らない範囲で、できるだけ同じ数ずつに分ける
+		size_t count = end - begin;
+		size_t pieces = std::min<size_t>(chunkCount, std::max<size_t>(count / m_minPacketsPerChunk, 1));
+		for (size_t i = 0; i < pieces; i++)
+		{
+			size_t pieceBegin = begin + count * i / pieces;
+			size_t pieceEnd = begin + count * (i + 1) / pieces;
+			m_steps.push_back({ pieceBegin, pieceEnd, static_cast<int32_t>(totalChunks++) });
+		}
+
+		begin = end;
+	}
+
+	// チャンクを並列に記録する（チャンクごとのコンテキストはステートが分からない状態から始める）
+	if (totalChunks > 0)
+	{
+		recorder->Prepare(totalChunks);
+		if (m_chunkContexts.size() < totalChunks) m_chunkContexts.resize(totalChunks);
+		m_chunkStats.assign(totalChunks, RenderQueueStats());
+
+		// チャンクの番号から範囲を引けるように、チャンクの処理の位置を覚える
+		m_chunkSteps.resize(totalChunks);
+		for (size_t i = 0; i < m_steps.size(); i++)
+		{
+			if (m_steps[i].chunk >= 0) m_chunkSteps[m_steps[i].chunk] = i;
+		}
+
+		JobSystem::GetDefault().ParallelFor(0, totalChunks, 1, [&](size_t first, size_t last)
+			{
+				for (size_t i = first; i < last; i++)
+				{
+					uint32_t chunk = static_cast<uint32_t>(i);
+					StateFilteredContext<IRenderContext>& chunkContext = m_chunkContexts[chunk];
+					chunkContext.Reset(recorder->Begin(chunk));
+					chunkContext.ResetStats();
+					const Step& step = m_steps[m_chunkSteps[chunk]];
+					ExecuteRange(queue, step.begin, step.end, handler, chunkContext, &m_chunkStats[chunk]);
+					recorder->End(chunk);
+				}
+			});
+	}
+
+	// 元の順番どおりに実行する（実行した後のステートは分からないので Invalidate する）
+	for (const Step& step : m_steps)
+	{
+		if (step.chunk < 0)
+		{
+			handler->Draw(*context, queue.GetSortedPacket(step.begin));
+			m_stats.packetCount++;
+			m_parallelStats.immediatePackets++;
+		}
+		else
+		{
+			recorder->Execute(static_cast<uint32_t>(step.chunk));
+
+			const RenderQueueStats& chunkStats = m_chunkStats[step.chunk];
+			m_stats.packetCount += chunkStats.packetCount;
+			m_stats.shaderChanges += chunkStats.shaderChanges;
+			m_stats.materialChanges += chunkStats.materialChanges;
+		}
+		context->Invalidate();
+	}
+
+	m_parallelStats.chunkCount = totalChunks;
+}
+
+//--------------------------------------------------------------------------------------
+// チャンクのコンテキストのステートの設定の回数を取得する関数
+//--------------------------------------------------------------------------------------
+StateFilterStats ParallelRenderExecutor::GetChunkStateStats() const
+{
+	StateFilterStats stats = {};
+	for (size_t i = 0; i < m_parallelStats.chunkCount; i++)
+	{
+		const StateFilterStats& chunkStats = m_chunkContexts[i].GetStats();
+		stats.issued += chunkStats.issued;
+		stats.filtered += chunkStats.filtered;
+	}
+	return stats;
+}
+
+//--------------------------------------------------------------------------------------
+// パケットの範囲を順番に実行する関数
+//--------------------------------------------------------------------------------------
+void ParallelRenderExecutor::ExecuteRange(const RenderQueue& queue, size_t begin, size_t end,
+	IParallelRenderPacketHandler* handler, StateFilteredContext<IRenderContext>& context, RenderQueueStats* stats)
+{
+	uint32_t currentShader = INVALID_INDEX;
+	uint32_t currentMaterial = INVALID_INDEX;
+
+	for (size_t i = begin; i < end; i++)
+	{
+		const RenderPacket& packet = queue.GetSortedPacket(i);
+
+		// 自分でステートを設定する描画の後は、設定済みのステートが分からないので設定し直す
+		if (packet.shader == RenderQueue::EXTERNAL_SHADER)
+		{
+			handler->Draw(context, packet);
+			context.Invalidate();
+			currentShader = INVALID_INDEX;
+			currentMaterial = INVALID_INDEX;
+			stats->packetCount++;
+			continue;
+		}
+
+		// 前のパケットと異なる場合だけ設定する
+		if (packet.shader != currentShader)
+		{
+			handler->BindShader(context, packet.shader);
+			currentShader = packet.shader;
+			stats->shaderChanges++;
+		}
+		if (packet.material != currentMaterial)
+		{
+			handler->BindMaterial(context, packet.material);
+			currentMaterial = packet.material;
+			stats->materialChanges++;
+		}
+
+		handler->Draw(context, packet);
+		stats->packetCount++;
+	}
+}
@@ -0,0 +1,211 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ParallelRenderExecutor.h
+//
+// レンダーキューのパケットを分割して複数のスレッドでコマンドリストへ記録し、順番に実行するクラス
+//
+// Usage: ソート済みの RenderQueue を渡すと、並べ替えた順番のパケットを EXTERNAL_SHADER の
+//        パケットで区切り、区切った範囲をそれぞれ最大 chunkCount 個のチャンクに分けます。
+//        チャンクはジョブシステムで並列にコマンドリストへ記録し（チャンクごとに
+//        StateFilteredContext を用意し、ステートは何も設定されていない状態から記録します）、
+//        記録が全て終わった後にメインスレッドで元の順番どおりに実行します。
+//        EXTERNAL_SHADER のパケット（DirectXTK 等）は記録せずに、その順番の位置で
+//        メインスレッドのコンテキストへ直接描画します。
+//        コマンドリストの記録と実行は IRenderCommandRecorder が行うので、Direct3D 11 の
+//        遅延コンテキスト（D3D11DeferredCommandRecorder）と、RenderCommandList へ記録して
+//        別のコンテキストで再生する RenderCommandListRecorder を同じ処理で使えます。
+//        IParallelRenderPacketHandler の関数は複数のスレッドから同時に呼ばれるので、
+//        引数のコンテキスト以外の共有するデータへは書き込まないでください。
+//        chunkCount が 1 以下の場合とレコーダーが nullptr の場合は、メインスレッドの
+//        コンテキストへ直接描画します（RenderQueue::Execute と同じ結果）。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	Imase::RenderCommandListRecorder recorder(&renderContext);
+//	Imase::ParallelRenderExecutor executor;
+//
+//	queue.Sort();
+//	executor.Execute(queue, handler, &stateContext, &recorder, 4);	// handler は IParallelRenderPacketHandler を継承したクラス
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "RenderCommandList.h"
+#include "RenderContext.h"
+#include "RenderQueue.h"
+#include "StateFilteredContext.h"
+
+namespace Imase
+{
+	// 描画パケットを指定したコンテキストへ実行するクラスのインターフェイス（複数のスレッドから同時に呼ばれる）
+	class IParallelRenderPacketHandler
+	{
+	public:
+
+		virtual ~IParallelRenderPacketHandler() = default;
+
+		// シェーダー（入力レイアウト・シェーダー・ステート等）を設定する関数
+		virtual void BindShader(StateFilteredContext<IRenderContext>& context, uint32_t shader) = 0;
+
+		// マテリアル（テクスチャ等）を設定する関数
+		virtual void BindMaterial(StateFilteredContext<IRenderContext>& context, uint32_t material) = 0;
+
+		// 描画する関数（EXTERNAL_SHADER のパケットはメインスレッドのコンテキストで呼ばれる）
+		virtual void Draw(StateFilteredContext<IRenderContext>& context, const RenderPacket& packet) = 0;
+	};
+
+	// チャンクごとのコマンドリストを記録して実行するクラスのインターフェイス
+	class IRenderCommandRecorder
+	{
+	public:
+
+		virtual ~IRenderCommandRecorder() = default;
+
+		/// <summary>
+		/// チャンクの数だけコマンドリストを用意する関数（メインスレッドで記録の前に呼ばれる）
+		/// </summary>
+		virtual void Prepare(uint32_t chunkCount) = 0;
+
+		/// <summary>
+		/// チャンクの記録を開始して記録先のコンテキストを取得する関数（ワーカーのスレッドで呼ばれる）
+		/// </summary>
+		virtual IRenderContext* Begin(uint32_t chunk) = 0;
+
+		/// <summary>
+		/// チャンクの記録を終了する関数（Begin と同じスレッドで呼ばれる）
+		/// </summary>
+		virtual void End(uint32_t chunk) = 0;
+
+		/// <summary>
+		/// 記録したチャンクを実行する関数（メインスレッドでチャンクの順番に呼ばれる）
+		/// </summary>
+		virtual void Execute(uint32_t chunk) = 0;
+	};
+
+	// RenderCommandList へ記録して、指定したコンテキストで再生するレコーダー
+	class RenderCommandListRecorder : public IRenderCommandRecorder
+	{
+	public:
+
+		/// <summary>
+		/// コンストラクタ
+		/// </summary>
+		/// <param name="target">記録したコマンドを再生するコンテキスト</param>
+		explicit RenderCommandListRecorder(IRenderContext* target = nullptr) : m_target(target) {}
+
+		// 再生するコンテキストを設定する関数
+		void SetTarget(IRenderContext* target) { m_target = target; }
+
+		// 最後に用意したチャンクの数を取得する関数
+		uint32_t GetChunkCount() const { return m_chunkCount; }
+
+		// チャンクのコマンドリストを取得する関数
+		const RenderCommandList& GetCommandList(uint32_t chunk) const { return *m_commandLists[chunk]; }
+
+		// 全てのチャンクに記録したコマンドの数とバイト数を取得する関数
+		size_t GetCommandCount() const;
+		size_t GetByteSize() const;
+
+		// ----- IRenderCommandRecorder ----- //
+
+		void Prepare(uint32_t chunkCount) override;
+		IRenderContext* Begin(uint32_t chunk) override;
+		void End(uint32_t) override {}
+		void Execute(uint32_t chunk) override;
+
+	private:
+
+		// 再生するコンテキスト
+		IRenderContext* m_target;
+
+		// チャンクごとのコマンドリスト（確保済みの領域を使い回す）
+		std::vector<std::unique_ptr<RenderCommandList>> m_commandLists;
+
+		// 用意したチャンクの数
+		uint32_t m_chunkCount = 0;
+	};
+
+	// 並列に記録した結果
+	struct ParallelRenderStats
+	{
+		// 記録したチャンクの数
+		size_t chunkCount;
+
+		// メインスレッドで直接描画したパケットの数（EXTERNAL_SHADER と並列に記録しない場合）
+		size_t immediatePackets;
+	};
+
+	// パケットを分割して並列に記録し、順番に実行するクラス
+	class ParallelRenderExecutor
+	{
+	public:
+
+		// １つのチャンクに入れるパケットの最小の数の既定値（少ないと記録の準備の時間の方が長くなる）
+		static constexpr size_t DEFAULT_MIN_PACKETS_PER_CHUNK = 1;
+
+		/// <summary>
+		/// １つのチャンクに入れるパケットの最小の数を設定する関数
+		/// </summary>
+		void SetMinPacketsPerChunk(size_t count) { m_minPacketsPerChunk = count > 0 ? count : 1; }
+
+		/// <summary>
+		/// ソート済みのキューのパケットを実行する関数
+		/// </summary>
+		/// <param name="queue">ソート済みのレンダーキュー</param>
+		/// <param name="handler">パケットを実行するクラス</param>
+		/// <param name="context">メインスレッドのコンテキスト（EXTERNAL_SHADER のパケットとチャンクの実行後に Invalidate する）</param>
+		/// <param name="recorder">コマンドリストのレコーダー（nullptr の場合は直接描画する）</param>
+		/// <param name="chunkCount">区切った範囲ごとのチャンクの最大数（1 以下の場合は直接描画する）</param>
+		void Execute(const RenderQueue& queue, IParallelRenderPacketHandler* handler,
+			StateFilteredContext<IRenderContext>* context, IRenderCommandRecorder* recorder, uint32_t chunkCount);
+
+		// 最後に実行した時のパケットの数とステートの変更の回数を取得する関数
+		const RenderQueueStats& GetStats() const { return m_stats; }
+
+		// 最後に実行した時のチャンクの数を取得する関数
+		const ParallelRenderStats& GetParallelStats() const { return m_parallelStats; }
+
+		// 最後に実行した時のチャンクのコンテキストのステートの設定の回数（全チャンクの合計）を取得する関数
+		StateFilterStats GetChunkStateStats() const;
+
+	private:
+
+		// 実行する順番に並べた処理（チャンクまたは EXTERNAL_SHADER のパケット）
+		struct Step
+		{
+			// 並べ替えた順番のパケットの範囲
+			size_t begin;
+			size_t end;
+
+			// チャンクの番号（EXTERNAL_SHADER のパケットの場合は -1）
+			int32_t chunk;
+		};
+
+		// パケットの範囲を順番に実行する関数（シェーダーとマテリアルは前のパケットと異なる場合だけ設定する）
+		static void ExecuteRange(const RenderQueue& queue, size_t begin, size_t end,
+			IParallelRenderPacketHandler* handler, StateFilteredContext<IRenderContext>& context, RenderQueueStats* stats);
+
+	private:
+
+		// １つのチャンクに入れるパケットの最小の数
+		size_t m_minPacketsPerChunk = DEFAULT_MIN_PACKETS_PER_CHUNK;
+
+		// 実行する順番に並べた処理とチャンクの番号ごとの処理の位置
+		std::vector<Step> m_steps;
+		std::vector<size_t> m_chunkSteps;
+
+		// チャンクごとのコンテキストとステートの変更の回数
+		std::vector<StateFilteredContext<IRenderContext>> m_chunkContexts;
+		std::vector<RenderQueueStats> m_chunkStats;
+
+		// 計測結果
+		RenderQueueStats m_stats = {};
+		ParallelRenderStats m_parallelStats = {};
+	};
+}
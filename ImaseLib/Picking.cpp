@@ -0,0 +1,470 @@
+﻿//--------------------------------------------------------------------------------------
+// File: Picking.cpp
+//
+// マウスピッキング用のレイと BVH（Bounding Volume Hierarchy）
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "Picking.h"
+
+#include <algorithm>
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	// 木の最大の深さ（これより深くなる場合は葉にする、探索用のスタックの大きさにもなる）
+	constexpr int MAX_DEPTH = 64;
+
+	// AABB の表面積の半分
+	inline float HalfArea(const Vector3& bmin, const Vector3& bmax)
+	{
+		Vector3 d = bmax - bmin;
+		return d.x * d.y + d.y * d.z + d.z * d.x;
+	}
+
+	// 空の AABB
+	inline void ResetBounds(Vector3& bmin, Vector3& bmax)
+	{
+		bmin = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+		bmax = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+	}
+
+	// AABB を広げる
+	inline void GrowBounds(Vector3& bmin, Vector3& bmax, const Vector3& pmin, const Vector3& pmax)
+	{
+		bmin = Vector3::Min(bmin, pmin);
+		bmax = Vector3::Max(bmax, pmax);
+	}
+
+	inline float Component(const Vector3& v, int axis)
+	{
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	// 探索中のレイ（SIMD 用に逆数を計算済み）
+	struct TraversalRay
+	{
+		Vector3 origin;
+		Vector3 direction;
+		Vector3 invDirection;
+#if defined(IMASE_MATH_SSE2)
+		__m128 originV;
+		__m128 invDirectionV;
+		__m128 maskXYZ;
+#endif
+
+		explicit TraversalRay(const Ray& ray)
+			: origin(ray.origin)
+			, direction(ray.direction)
+			, invDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z)
+		{
+#if defined(IMASE_MATH_SSE2)
+			originV = _mm_set_ps(0.0f, origin.z, origin.y, origin.x);
+			invDirectionV = _mm_set_ps(0.0f, invDirection.z, invDirection.y, invDirection.x);
+			maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+#endif
+		}
+	};
+
+	// レイと AABB の判定（当たった場合は入る距離、外れた場合は FLT_MAX）
+	// ※ SSE 版は bmin / bmax から４個読み込むので、その後ろに４バイト以上の領域が必要
+	inline float IntersectBox(const TraversalRay& r, const float* bmin, const float* bmax, float tMax)
+	{
+#if defined(IMASE_MATH_SSE2)
+		// ４番目の要素は使わないので 0 にする（非正規化数の演算で遅くならないように）
+		__m128 lo = _mm_and_ps(_mm_loadu_ps(bmin), r.maskXYZ);
+		__m128 hi = _mm_and_ps(_mm_loadu_ps(bmax), r.maskXYZ);
+		__m128 t1 = _mm_mul_ps(_mm_sub_ps(lo, r.originV), r.invDirectionV);
+		__m128 t2 = _mm_mul_ps(_mm_sub_ps(hi, r.originV), r.invDirectionV);
+		__m128 vmin = _mm_min_ps(t1, t2);
+		__m128 vmax = _mm_max_ps(t1, t2);
+
+		// x, y, z の最大値と最小値
+		__m128 nearV = _mm_max_ss(_mm_max_ss(vmin, _mm_shuffle_ps(vmin, vmin, _MM_SHUFFLE(1, 1, 1, 1))),
+			_mm_shuffle_ps(vmin, vmin, _MM_SHUFFLE(2, 2, 2, 2)));
+		__m128 farV = _mm_min_ss(_mm_min_ss(vmax, _mm_shuffle_ps(vmax, vmax, _MM_SHUFFLE(1, 1, 1, 1))),
+			_mm_shuffle_ps(vmax, vmax, _MM_SHUFFLE(2, 2, 2, 2)));
+		float tNear = _mm_cvtss_f32(nearV);
+		float tFar = _mm_cvtss_f32(farV);
+#else
+		float tx1 = (bmin[0] - r.origin.x) * r.invDirection.x;
+		float tx2 = (bmax[0] - r.origin.x) * r.invDirection.x;
+		float ty1 = (bmin[1] - r.origin.y) * r.invDirection.y;
+		float ty2 = (bmax[1] - r.origin.y) * r.invDirection.y;
+		float tz1 = (bmin[2] - r.origin.z) * r.invDirection.z;
+		float tz2 = (bmax[2] - r.origin.z) * r.invDirection.z;
+		float tNear = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+		float tFar = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+#endif
+		tNear = std::max(tNear, 0.0f);
+		return (tNear <= tFar && tNear < tMax) ? tNear : FLT_MAX;
+	}
+
+	// レイと三角形の判定（Möller–Trumbore、両面）
+	inline bool IntersectTriangle(const TraversalRay& r, const Vector3& v0, const Vector3& e1, const Vector3& e2,
+		float tMax, float* t, float* u, float* v)
+	{
+		Vector3 p = r.direction.Cross(e2);
+		float det = e1.Dot(p);
+		if (det == 0.0f) return false;
+
+		float invDet = 1.0f / det;
+		Vector3 s = r.origin - v0;
+		float bu = s.Dot(p) * invDet;
+		if (bu < 0.0f || bu > 1.0f) return false;
+
+		Vector3 q = s.Cross(e1);
+		float bv = r.direction.Dot(q) * invDet;
+		if (bv < 0.0f || bu + bv > 1.0f) return false;
+
+		float dist = e2.Dot(q) * invDet;
+		if (dist < 0.0f || dist >= tMax) return false;
+
+		*t = dist;
+		*u = bu;
+		*v = bv;
+		return true;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// スクリーン座標からレイを作成
+//--------------------------------------------------------------------------------------
+Ray Imase::CreateRayFromScreen(
+	float screenX,
+	float screenY,
+	float screenWidth,
+	float screenHeight,
+	const Matrix& view,
+	const Matrix& proj)
+{
+	// 正規化デバイス座標（-1 ～ 1、Y は上向き）
+	float ndcX = screenX / screenWidth * 2.0f - 1.0f;
+	float ndcY = 1.0f - screenY / screenHeight * 2.0f;
+
+	// ビュー空間のレイ（深度の範囲に関係しないように射影行列の x, y の成分だけから求める）
+	Vector3 origin, direction;
+	if (proj.m[3][3] == 0.0f)
+	{
+		// 透視投影（z = -1 の平面上の点への方向）
+		direction = Vector3((ndcX + proj.m[2][0]) / proj.m[0][0], (ndcY + proj.m[2][1]) / proj.m[1][1], -1.0f);
+	}
+	else
+	{
+		// 正射影（視点の平面上の点から奥へ）
+		origin = Vector3((ndcX - proj.m[3][0]) / proj.m[0][0], (ndcY - proj.m[3][1]) / proj.m[1][1], 0.0f);
+		direction = Vector3(0.0f, 0.0f, -1.0f);
+	}
+
+	// ワールド空間へ変換する
+	Matrix invView = view.InvertOrthonormal();
+
+	Ray ray;
+	ray.origin = invView.TransformPoint(origin);
+	ray.direction = invView.TransformNormal(direction).Normalized();
+
+	return ray;
+}
+
+//--------------------------------------------------------------------------------------
+// BVH の構築
+//--------------------------------------------------------------------------------------
+void Bvh::BuildFromBoxes(const Vector3* boxMin, const Vector3* boxMax, size_t count)
+{
+	m_type = PrimitiveType::Box;
+
+	std::vector<Vector3> bmin(boxMin, boxMin + count);
+	std::vector<Vector3> bmax(boxMax, boxMax + count);
+
+	Build(bmin, bmax);
+
+	// 葉の順に並べ替える（SSE 版の判定で最後の要素の後ろを読むので１個余分に確保する）
+	m_boxes.resize(m_primitiveIndices.size() * 2 + 1);
+	for (size_t i = 0; i < m_primitiveIndices.size(); i++)
+	{
+		m_boxes[i * 2 + 0] = boxMin[m_primitiveIndices[i]];
+		m_boxes[i * 2 + 1] = boxMax[m_primitiveIndices[i]];
+	}
+	m_triangles.clear();
+}
+
+void Bvh::BuildFromTriangles(const Vector3* positions, const uint32_t* indices, size_t triangleCount)
+{
+	m_type = PrimitiveType::Triangle;
+
+	std::vector<Vector3> bmin(triangleCount);
+	std::vector<Vector3> bmax(triangleCount);
+	for (size_t i = 0; i < triangleCount; i++)
+	{
+		const Vector3& a = positions[indices[i * 3 + 0]];
+		const Vector3& b = positions[indices[i * 3 + 1]];
+		const Vector3& c = positions[indices[i * 3 + 2]];
+		bmin[i] = Vector3::Min(Vector3::Min(a, b), c);
+		bmax[i] = Vector3::Max(Vector3::Max(a, b), c);
+	}
+
+	Build(bmin, bmax);
+
+	// 葉の順に並べ替えて辺を計算しておく
+	m_triangles.resize(m_primitiveIndices.size());
+	for (size_t i = 0; i < m_primitiveIndices.size(); i++)
+	{
+		const uint32_t* tri = &indices[m_primitiveIndices[i] * 3];
+		const Vector3& a = positions[tri[0]];
+		m_triangles[i].v0 = a;
+		m_triangles[i].edge1 = positions[tri[1]] - a;
+		m_triangles[i].edge2 = positions[tri[2]] - a;
+	}
+	m_boxes.clear();
+}
+
+void Bvh::Build(const std::vector<Vector3>& boundsMin, const std::vector<Vector3>& boundsMax)
+{
+	const size_t count = boundsMin.size();
+
+	m_nodes.clear();
+	m_primitiveIndices.resize(count);
+	if (count == 0) return;
+
+	// プリミティブの中心
+	std::vector<Vector3> centers(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		m_primitiveIndices[i] = static_cast<uint32_t>(i);
+		centers[i] = (boundsMin[i] + boundsMax[i]) * 0.5f;
+	}
+
+	m_nodes.reserve(count * 2);
+
+	Node root = {};
+	root.leftFirst = 0;
+	root.count = static_cast<uint32_t>(count);
+	m_nodes.push_back(root);
+
+	// 分割するノード（ノードの番号と深さ）
+	struct Task { uint32_t node; int depth; };
+	std::vector<Task> tasks;
+	tasks.push_back({ 0, 0 });
+
+	while (!tasks.empty())
+	{
+		Task task = tasks.back();
+		tasks.pop_back();
+
+		uint32_t first = m_nodes[task.node].leftFirst;
+		uint32_t n = m_nodes[task.node].count;
+
+		// ノードの AABB と中心の範囲
+		Vector3 nodeMin, nodeMax, centerMin, centerMax;
+		ResetBounds(nodeMin, nodeMax);
+		ResetBounds(centerMin, centerMax);
+		for (uint32_t i = first; i < first + n; i++)
+		{
+			uint32_t p = m_primitiveIndices[i];
+			GrowBounds(nodeMin, nodeMax, boundsMin[p], boundsMax[p]);
+			GrowBounds(centerMin, centerMax, centers[p], centers[p]);
+		}
+		m_nodes[task.node].boundsMin = nodeMin;
+		m_nodes[task.node].boundsMax = nodeMax;
+
+		if (n <= 1 || task.depth >= MAX_DEPTH - 1) continue;
+
+		// SAH で分割する軸と位置を求める（軸ごとに区間へ振り分けて評価する）
+		int bestAxis = -1;
+		int bestSplit = 0;
+		float bestCost = FLT_MAX;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float cmin = Component(centerMin, axis);
+			float extent = Component(centerMax, axis) - cmin;
+			if (extent <= 0.0f) continue;
+
+			Vector3 binMin[SAH_BINS], binMax[SAH_BINS];
+			uint32_t binCount[SAH_BINS] = {};
+			for (int b = 0; b < SAH_BINS; b++) ResetBounds(binMin[b], binMax[b]);
+
+			float scale = SAH_BINS / extent;
+			for (uint32_t i = first; i < first + n; i++)
+			{
+				uint32_t p = m_primitiveIndices[i];
+				int b = std::min(SAH_BINS - 1, static_cast<int>((Component(centers[p], axis) - cmin) * scale));
+				binCount[b]++;
+				GrowBounds(binMin[b], binMax[b], boundsMin[p], boundsMax[p]);
+			}
+
+			// 左右から累積して各分割位置のコストを求める
+			float leftArea[SAH_BINS - 1], rightArea[SAH_BINS - 1];
+			uint32_t leftCount[SAH_BINS - 1], rightCount[SAH_BINS - 1];
+			Vector3 lmin, lmax, rmin, rmax;
+			ResetBounds(lmin, lmax);
+			ResetBounds(rmin, rmax);
+			uint32_t lsum = 0, rsum = 0;
+			for (int b = 0; b < SAH_BINS - 1; b++)
+			{
+				lsum += binCount[b];
+				leftCount[b] = lsum;
+				if (binCount[b]) GrowBounds(lmin, lmax, binMin[b], binMax[b]);
+				leftArea[b] = lsum ? HalfArea(lmin, lmax) : 0.0f;
+
+				int rb = SAH_BINS - 1 - b;
+				rsum += binCount[rb];
+				rightCount[rb - 1] = rsum;
+				if (binCount[rb]) GrowBounds(rmin, rmax, binMin[rb], binMax[rb]);
+				rightArea[rb - 1] = rsum ? HalfArea(rmin, rmax) : 0.0f;
+			}
+			for (int b = 0; b < SAH_BINS - 1; b++)
+			{
+				if (leftCount[b] == 0 || rightCount[b] == 0) continue;
+				float cost = leftCount[b] * leftArea[b] + rightCount[b] * rightArea[b];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = b;
+				}
+			}
+		}
+
+		uint32_t mid;
+		if (bestAxis < 0)
+		{
+			// 中心が全て同じ位置の場合は半分に分ける
+			if (n <= MAX_LEAF_PRIMITIVES) continue;
+			mid = first + n / 2;
+		}
+		else
+		{
+			// 分割しない方が安い場合は葉にする（プリミティブ１個の判定とノード１個の判定を同じコストとみなす）
+			float leafCost = n * HalfArea(nodeMin, nodeMax);
+			if (n <= MAX_LEAF_PRIMITIVES && bestCost + HalfArea(nodeMin, nodeMax) >= leafCost) continue;
+
+			float cmin = Component(centerMin, bestAxis);
+			float scale = SAH_BINS / (Component(centerMax, bestAxis) - cmin);
+			uint32_t* begin = m_primitiveIndices.data() + first;
+			uint32_t* split = std::partition(begin, begin + n, [&](uint32_t p)
+				{
+					int b = std::min(SAH_BINS - 1, static_cast<int>((Component(centers[p], bestAxis) - cmin) * scale));
+					return b <= bestSplit;
+				});
+			mid = static_cast<uint32_t>(split - m_primitiveIndices.data());
+		}
+
+		// 子ノードは隣り合わせに配置する
+		uint32_t left = static_cast<uint32_t>(m_nodes.size());
+		Node child = {};
+		child.leftFirst = first;
+		child.count = mid - first;
+		m_nodes.push_back(child);
+		child.leftFirst = mid;
+		child.count = first + n - mid;
+		m_nodes.push_back(child);
+
+		m_nodes[task.node].leftFirst = left;
+		m_nodes[task.node].count = 0;
+
+		tasks.push_back({ left + 1, task.depth + 1 });
+		tasks.push_back({ left, task.depth + 1 });
+	}
+
+	m_nodes.shrink_to_fit();
+}
+
+//--------------------------------------------------------------------------------------
+// レイとの交差判定
+//--------------------------------------------------------------------------------------
+bool Bvh::Intersect(const Ray& ray, RayHit* hit, float maxDistance) const
+{
+	return Traverse<false>(ray, hit, maxDistance);
+}
+
+bool Bvh::IntersectAny(const Ray& ray, float maxDistance) const
+{
+	return Traverse<true>(ray, nullptr, maxDistance);
+}
+
+template <bool ANY_HIT>
+bool Bvh::Traverse(const Ray& ray, RayHit* hit, float maxDistance) const
+{
+	if (m_nodes.empty()) return false;
+
+	TraversalRay r(ray);
+
+	const Node* nodes = m_nodes.data();
+	if (IntersectBox(r, &nodes[0].boundsMin.x, &nodes[0].boundsMax.x, maxDistance) == FLT_MAX) return false;
+
+	// 後で調べるノード（ノードの番号と入る距離）
+	struct Entry { uint32_t node; float distance; };
+	Entry stack[MAX_DEPTH];
+	int stackSize = 0;
+
+	float closest = maxDistance;
+	bool found = false;
+	uint32_t current = 0;
+
+	for (;;)
+	{
+		const Node& node = nodes[current];
+		if (node.IsLeaf())
+		{
+			for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+			{
+				float t, u = 0.0f, v = 0.0f;
+				if (m_type == PrimitiveType::Triangle)
+				{
+					const Triangle& tri = m_triangles[i];
+					if (!IntersectTriangle(r, tri.v0, tri.edge1, tri.edge2, closest, &t, &u, &v)) continue;
+				}
+				else
+				{
+					t = IntersectBox(r, &m_boxes[i * 2].x, &m_boxes[i * 2 + 1].x, closest);
+					if (t == FLT_MAX) continue;
+				}
+
+				if (ANY_HIT) return true;
+
+				closest = t;
+				found = true;
+				hit->distance = t;
+				hit->primitive = m_primitiveIndices[i];
+				hit->u = u;
+				hit->v = v;
+			}
+		}
+		else
+		{
+			// 子ノードを両方調べて近い方から辿る
+			uint32_t child0 = node.leftFirst;
+			uint32_t child1 = node.leftFirst + 1;
+			float d0 = IntersectBox(r, &nodes[child0].boundsMin.x, &nodes[child0].boundsMax.x, closest);
+			float d1 = IntersectBox(r, &nodes[child1].boundsMin.x, &nodes[child1].boundsMax.x, closest);
+			if (d0 > d1)
+			{
+				std::swap(d0, d1);
+				std::swap(child0, child1);
+			}
+			if (d0 != FLT_MAX)
+			{
+				if (d1 != FLT_MAX) stack[stackSize++] = { child1, d1 };
+				current = child0;
+				continue;
+			}
+		}
+
+		// スタックから取り出す（既に見つかった交点より遠いノードは飛ばす）
+		for (;;)
+		{
+			if (stackSize == 0) return found;
+			const Entry& e = stack[--stackSize];
+			if (e.distance < closest)
+			{
+				current = e.node;
+				break;
+			}
+		}
+	}
+}
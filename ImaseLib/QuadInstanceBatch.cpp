@@ -0,0 +1,194 @@
+﻿//--------------------------------------------------------------------------------------
+// File: QuadInstanceBatch.cpp
+//
+// テクスチャ付きの四角形ポリゴンをインスタンス描画するためのデータを作成するクラス
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "QuadInstanceBatch.h"
+
+#include <algorithm>
+
+using namespace Imase;
+
+//--------------------------------------------------------------------------------------
+// ワールド行列などをインスタンスのデータへ詰める関数
+//--------------------------------------------------------------------------------------
+void Imase::PackQuadInstance(
+	const Math::Matrix& world,
+	const Math::Vector4& tint,
+	const Math::Vector4& uvRect,
+	QuadInstance* instance)
+{
+	// 転置した行列の上３行（元の行列の１～３列目）
+	for (int i = 0; i < 3; i++)
+	{
+		instance->world[i] = Math::Vector4(world.m[0][i], world.m[1][i], world.m[2][i], world.m[3][i]);
+	}
+
+	instance->tint = tint;
+	instance->uvRect = uvRect;
+}
+
+//--------------------------------------------------------------------------------------
+// 追加したインスタンスを全て削除する関数
+//--------------------------------------------------------------------------------------
+void QuadInstanceBatch::Clear()
+{
+	m_added.clear();
+	m_textures.clear();
+	m_instances.clear();
+	m_ranges.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// インスタンスの領域を予約する関数
+//--------------------------------------------------------------------------------------
+void QuadInstanceBatch::Reserve(size_t count)
+{
+	m_added.reserve(count);
+	m_textures.reserve(count);
+	m_instances.reserve(count);
+}
+
+//--------------------------------------------------------------------------------------
+// インスタンスを追加する関数
+//--------------------------------------------------------------------------------------
+void QuadInstanceBatch::Add(
+	uint32_t texture,
+	const Math::Matrix& world,
+	const Math::Vector4& tint,
+	const Math::Vector4& uvRect)
+{
+	QuadInstance instance;
+	PackQuadInstance(world, tint, uvRect, &instance);
+
+	m_added.push_back(instance);
+	m_textures.push_back(texture);
+}
+
+//--------------------------------------------------------------------------------------
+// インスタンスを追加する関数（位置・回転・スケールから）
+//--------------------------------------------------------------------------------------
+void QuadInstanceBatch::Add(
+	uint32_t texture,
+	const Math::Vector3& position,
+	const Math::Quaternion& rotation,
+	const Math::Vector3& scale,
+	const Math::Vector4& tint,
+	const Math::Vector4& uvRect)
+{
+	Add(texture, Math::Matrix::CreateWorld(position, rotation, scale), tint, uvRect);
+}
+
+//--------------------------------------------------------------------------------------
+// 追加したインスタンスをテクスチャごとにまとめる関数
+//--------------------------------------------------------------------------------------
+void QuadInstanceBatch::Build()
+{
+	m_instances.clear();
+	m_ranges.clear();
+
+	size_t count = m_added.size();
+	if (count == 0) return;
+
+	// テクスチャごとの数を数える
+	m_counts.clear();
+	bool isSingleTexture = true;
+	for (size_t i = 0; i < count; i++)
+	{
+		uint32_t texture = m_textures[i];
+		if (texture >= m_counts.size()) m_counts.resize(texture + 1, 0);
+		m_counts[texture]++;
+		isSingleTexture &= (texture == m_textures[0]);
+	}
+
+	// テクスチャが１種類の場合は並べ替える必要がない
+	if (isSingleTexture)
+	{
+		m_instances.assign(m_added.begin(), m_added.end());
+		m_ranges.push_back({ m_textures[0], 0, static_cast<uint32_t>(count) });
+		return;
+	}
+
+	// 範囲を求め、数をテクスチャごとの書き込み位置に置き換える
+	uint32_t first = 0;
+	for (size_t texture = 0; texture < m_counts.size(); texture++)
+	{
+		uint32_t textureCount = m_counts[texture];
+		if (textureCount > 0)
+		{
+			m_ranges.push_back({ static_cast<uint32_t>(texture), first, textureCount });
+		}
+		m_counts[texture] = first;
+		first += textureCount;
+	}
+
+	// 追加された順番を保ったまま並べる（計数ソート）
+	m_instances.resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		m_instances[m_counts[m_textures[i]]++] = m_added[i];
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// インスタンスを全てインスタンス用の頂点バッファへ書き込む関数
+//--------------------------------------------------------------------------------------
+bool QuadInstanceBatch::Upload(IRenderContext* context, RenderBuffer* instanceBuffer, uint32_t capacity) const
+{
+	if (m_instances.empty() || m_instances.size() > capacity) return false;
+
+	return context->UpdateBuffer(instanceBuffer, m_instances.data(), sizeof(QuadInstance) * m_instances.size());
+}
+
+//--------------------------------------------------------------------------------------
+// テクスチャごとの範囲を描画する関数
+//--------------------------------------------------------------------------------------
+uint32_t QuadInstanceBatch::DrawRange(
+	IRenderContext* context, RenderBuffer* instanceBuffer, uint32_t capacity, size_t rangeIndex, uint32_t indexCount) const
+{
+	if (capacity == 0 || rangeIndex >= m_ranges.size()) return 0;
+
+	const QuadInstanceRange& range = m_ranges[rangeIndex];
+
+	// Upload で全て書き込んである
+	if (m_instances.size() <= capacity)
+	{
+		context->DrawIndexedInstanced(indexCount, range.instanceCount, 0, 0, range.firstInstance);
+		return 1;
+	}
+
+	// 入りきらない場合はバッファの先頭から capacity 個ずつ書き込んで描画する
+	uint32_t drawCount = 0;
+	for (uint32_t first = 0; first < range.instanceCount; first += capacity)
+	{
+		uint32_t count = std::min(capacity, range.instanceCount - first);
+		if (!context->UpdateBuffer(instanceBuffer, &m_instances[range.firstInstance + first], sizeof(QuadInstance) * count)) break;
+
+		context->DrawIndexedInstanced(indexCount, count, 0, 0, 0);
+		drawCount++;
+	}
+
+	return drawCount;
+}
+
+//--------------------------------------------------------------------------------------
+// 全ての範囲を描画する時の DrawIndexedInstanced の回数を求める関数
+//--------------------------------------------------------------------------------------
+size_t QuadInstanceBatch::GetDrawCount(uint32_t capacity) const
+{
+	if (capacity == 0) return 0;
+	if (m_instances.size() <= capacity) return m_ranges.size();
+
+	size_t drawCount = 0;
+	for (const QuadInstanceRange& range : m_ranges)
+	{
+		drawCount += (range.instanceCount + capacity - 1) / capacity;
+	}
+
+	return drawCount;
+}
@@ -0,0 +1,199 @@
+﻿//--------------------------------------------------------------------------------------
+// File: QuadInstanceBatch.h
+//
+// テクスチャ付きの四角形ポリゴンをインスタンス描画するためのデータを作成するクラス
+//
+// Usage: 描画するオブジェクトのワールド行列・色・テクスチャ座標の範囲を Add で追加し、
+//        Build でテクスチャごとにまとめます。
+//        GetInstances の配列はインスタンス用の頂点バッファへそのままコピーでき、
+//        GetRanges の範囲ごとに DrawIndexedInstanced を１回呼べば描画できます。
+//        同じテクスチャの中では追加した順番が保たれるので、奥から順に追加すれば
+//        半透明のポリゴンも正しく描画できます。
+//        Upload と DrawRange は IRenderContext へ書き込み・描画します。インスタンスが
+//        インスタンス用の頂点バッファ（capacity 個）に入りきらない場合は、Upload は何もせず、
+//        DrawRange が範囲を capacity 個ずつバッファへ書き込んでは描画します。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	batch.Clear();
+//	batch.Add(TEXTURE_TREE, world, tint);
+//	batch.Build();
+//
+//	memcpy(mapped.pData, batch.GetInstances(), sizeof(Imase::QuadInstance) * batch.GetInstanceCount());
+//
+//	for (const Imase::QuadInstanceRange& range : batch.GetRanges())
+//	{
+//		context->PSSetShaderResources(0, 1, textures[range.texture].GetAddressOf());
+//		context->DrawIndexedInstanced(6, range.instanceCount, 0, 0, range.firstInstance);
+//	}
+//
+//	// IRenderContext の場合（バッファに入りきらない場合も描画できる）
+//	batch.Upload(context, instanceBuffer, MAX_INSTANCES);
+//	for (size_t i = 0; i < batch.GetRanges().size(); i++)
+//	{
+//		batch.DrawRange(context, instanceBuffer, MAX_INSTANCES, i, 6);
+//	}
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MathCore.h"
+#include "RenderContext.h"
+
+namespace Imase
+{
+	// インスタンスごとのデータ（80バイト、インスタンス用の頂点バッファへそのままコピーできる配置）
+	struct QuadInstance
+	{
+		// ワールド行列を転置した上３行（転置後の４行目は常に (0, 0, 0, 1) なので省略）
+		// シェーダーでは dot(float4(position, 1), world[i]) で各成分を求める
+		Math::Vector4 world[3];
+
+		// 色（ライティングの結果に乗算する、乗算済みアルファ）
+		Math::Vector4 tint;
+
+		// テクスチャ座標の範囲（左上の u, v と幅, 高さ、テクスチャアトラスの一部を使う場合に指定）
+		Math::Vector4 uvRect;
+	};
+
+	static_assert(sizeof(QuadInstance) == 80, "QuadInstance must be 80 bytes");
+
+	// 同じテクスチャで描画するインスタンスの範囲（DrawIndexedInstanced １回分）
+	struct QuadInstanceRange
+	{
+		// テクスチャの番号
+		uint32_t texture;
+
+		// 最初のインスタンスの位置（StartInstanceLocation）
+		uint32_t firstInstance;
+
+		// インスタンスの数
+		uint32_t instanceCount;
+	};
+
+	/// <summary>
+	/// ワールド行列などをインスタンスのデータへ詰める関数
+	/// </summary>
+	/// <param name="world">ワールド行列（最後の列が (0, 0, 0, 1) であること）</param>
+	/// <param name="tint">色</param>
+	/// <param name="uvRect">テクスチャ座標の範囲</param>
+	/// <param name="instance">出力先</param>
+	void PackQuadInstance(
+		const Math::Matrix& world,
+		const Math::Vector4& tint,
+		const Math::Vector4& uvRect,
+		QuadInstance* instance);
+
+	// インスタンス描画のデータを作成するクラス
+	class QuadInstanceBatch
+	{
+	public:
+
+		// 色の既定値（白）
+		static constexpr Math::Vector4 DEFAULT_TINT = Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+
+		// テクスチャ座標の範囲の既定値（テクスチャ全体）
+		static constexpr Math::Vector4 DEFAULT_UV_RECT = Math::Vector4(0.0f, 0.0f, 1.0f, 1.0f);
+
+		/// <summary>
+		/// 追加したインスタンスを全て削除する関数（確保済みの領域はそのまま使う）
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// インスタンスの領域を予約する関数
+		/// </summary>
+		/// <param name="count">インスタンスの数</param>
+		void Reserve(size_t count);
+
+		/// <summary>
+		/// インスタンスを追加する関数
+		/// </summary>
+		/// <param name="texture">テクスチャの番号（0 から始まる連続した番号）</param>
+		/// <param name="world">ワールド行列</param>
+		/// <param name="tint">色</param>
+		/// <param name="uvRect">テクスチャ座標の範囲</param>
+		void Add(
+			uint32_t texture,
+			const Math::Matrix& world,
+			const Math::Vector4& tint = DEFAULT_TINT,
+			const Math::Vector4& uvRect = DEFAULT_UV_RECT);
+
+		/// <summary>
+		/// インスタンスを追加する関数（位置・回転・スケールから）
+		/// </summary>
+		/// <param name="texture">テクスチャの番号（0 から始まる連続した番号）</param>
+		/// <param name="position">位置</param>
+		/// <param name="rotation">回転（正規化されたクォータニオン）</param>
+		/// <param name="scale">スケール</param>
+		/// <param name="tint">色</param>
+		/// <param name="uvRect">テクスチャ座標の範囲</param>
+		void Add(
+			uint32_t texture,
+			const Math::Vector3& position,
+			const Math::Quaternion& rotation,
+			const Math::Vector3& scale,
+			const Math::Vector4& tint = DEFAULT_TINT,
+			const Math::Vector4& uvRect = DEFAULT_UV_RECT);
+
+		/// <summary>
+		/// 追加したインスタンスをテクスチャごとにまとめる関数
+		/// </summary>
+		void Build();
+
+		// インスタンスの配列を取得する関数（Build 後に有効）
+		const QuadInstance* GetInstances() const { return m_instances.data(); }
+
+		// インスタンスの数を取得する関数
+		size_t GetInstanceCount() const { return m_instances.size(); }
+
+		// テクスチャごとの範囲を取得する関数（Build 後に有効、テクスチャの番号順）
+		const std::vector<QuadInstanceRange>& GetRanges() const { return m_ranges; }
+
+		/// <summary>
+		/// インスタンスを全てインスタンス用の頂点バッファへ書き込む関数（Build 後、１フレームに１回）
+		/// </summary>
+		/// <param name="context">コンテキスト</param>
+		/// <param name="instanceBuffer">インスタンス用の頂点バッファ</param>
+		/// <param name="capacity">バッファに入るインスタンスの数</param>
+		/// <returns>書き込んだ場合は true（入りきらない場合は書き込まずに false）</returns>
+		bool Upload(IRenderContext* context, RenderBuffer* instanceBuffer, uint32_t capacity) const;
+
+		/// <summary>
+		/// テクスチャごとの範囲を描画する関数（入りきらない場合は capacity 個ずつ書き込んで描画する）
+		/// </summary>
+		/// <param name="context">コンテキスト</param>
+		/// <param name="instanceBuffer">インスタンス用の頂点バッファ</param>
+		/// <param name="capacity">バッファに入るインスタンスの数（Upload と同じ値）</param>
+		/// <param name="rangeIndex">範囲の番号</param>
+		/// <param name="indexCount">１インスタンスのインデックスの数</param>
+		/// <returns>DrawIndexedInstanced を呼んだ回数</returns>
+		uint32_t DrawRange(IRenderContext* context, RenderBuffer* instanceBuffer, uint32_t capacity, size_t rangeIndex, uint32_t indexCount) const;
+
+		// 全ての範囲を描画する時の DrawIndexedInstanced の回数を求める関数
+		size_t GetDrawCount(uint32_t capacity) const;
+
+	private:
+
+		// 追加された順のインスタンス
+		std::vector<QuadInstance> m_added;
+
+		// 追加された順のテクスチャの番号
+		std::vector<uint32_t> m_textures;
+
+		// テクスチャごとにまとめたインスタンス
+		std::vector<QuadInstance> m_instances;
+
+		// テクスチャごとの範囲
+		std::vector<QuadInstanceRange> m_ranges;
+
+		// テクスチャごとのインスタンスの数（並べ替えの作業用）
+		std::vector<uint32_t> m_counts;
+	};
+}
@@ -0,0 +1,517 @@
+﻿//--------------------------------------------------------------------------------------
+// File: RenderCommandList.cpp
+//
+// 描画コマンドを記録して、後で別のコンテキストへ発行するコマンドリスト
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "RenderCommandList.h"
+
+#include <cstring>
+
+using namespace Imase;
+
+namespace
+{
+	// コマンドの種類
+	enum Command : uint32_t
+	{
+		CMD_IA_SET_INPUT_LAYOUT,
+		CMD_IA_SET_PRIMITIVE_TOPOLOGY,
+		CMD_IA_SET_INDEX_BUFFER,
+		CMD_IA_SET_VERTEX_BUFFERS,
+		CMD_VS_SET_SHADER,
+		CMD_VS_SET_CONSTANT_BUFFERS,
+		CMD_VS_SET_CONSTANT_BUFFERS1,
+		CMD_RS_SET_STATE,
+		CMD_PS_SET_SHADER,
+		CMD_PS_SET_CONSTANT_BUFFERS,
+		CMD_PS_SET_SHADER_RESOURCES,
+		CMD_PS_SET_SAMPLERS,
+		CMD_OM_SET_DEPTH_STENCIL_STATE,
+		CMD_OM_SET_BLEND_STATE,
+		CMD_MAP,
+		CMD_UPDATE_BUFFER,
+		CMD_DRAW,
+		CMD_DRAW_INDEXED,
+		CMD_DRAW_INDEXED_INSTANCED,
+	};
+
+	// 書き込む位置の境界（ポインタの配列を記録した領域のまま読めるようにする）
+	constexpr size_t STREAM_ALIGNMENT = 8;
+
+	// 境界に揃えたバイト数
+	inline size_t AlignUp(size_t size)
+	{
+		return (size + STREAM_ALIGNMENT - 1) & ~(STREAM_ALIGNMENT - 1);
+	}
+
+	// 記録したバイト列を先頭から読むクラス
+	class StreamReader
+	{
+	public:
+
+		StreamReader(const uint8_t* data, size_t size) : m_data(data), m_end(data + size) {}
+
+		// 最後まで読んだ場合は true を返す関数
+		bool IsEnd() const { return m_data >= m_end; }
+
+		// 値を読む関数
+		template <class T>
+		T Read()
+		{
+			T value;
+			memcpy(&value, m_data, sizeof(T));
+			m_data += AlignUp(sizeof(T));
+			return value;
+		}
+
+		// 配列を読む関数（記録した領域をそのまま指す、数が 0 の場合は nullptr）
+		template <class T>
+		const T* ReadArray(size_t count)
+		{
+			if (count == 0) return nullptr;
+
+			const T* values = reinterpret_cast<const T*>(m_data);
+			m_data += AlignUp(sizeof(T) * count);
+			return values;
+		}
+
+	private:
+
+		const uint8_t* m_data;
+		const uint8_t* m_end;
+	};
+}
+
+//--------------------------------------------------------------------------------------
+// 記録したコマンドを全て削除する関数
+//--------------------------------------------------------------------------------------
+void RenderCommandList::Clear()
+{
+	m_stream.clear();
+	m_commandCount = 0;
+	m_mappedBuffer = nullptr;
+}
+
+//--------------------------------------------------------------------------------------
+// Map で書き込めるようにバッファの大きさを設定する関数
+//--------------------------------------------------------------------------------------
+void RenderCommandList::SetBufferSize(RenderBuffer* buffer, size_t size)
+{
+	for (auto& bufferSize : m_bufferSizes)
+	{
+		if (bufferSize.first == buffer)
+		{
+			bufferSize.second = size;
+			return;
+		}
+	}
+	m_bufferSizes.emplace_back(buffer, size);
+}
+
+//--------------------------------------------------------------------------------------
+// 記録したコマンドを順番に発行する関数
+//--------------------------------------------------------------------------------------
+void RenderCommandList::Execute(IRenderContext* context) const
+{
+	StreamReader reader(m_stream.data(), m_stream.size());
+
+	while (!reader.IsEnd())
+	{
+		switch (reader.Read<uint32_t>())
+		{
+		case CMD_IA_SET_INPUT_LAYOUT:
+			context->IASetInputLayout(reader.Read<RenderInputLayout*>());
+			break;
+
+		case CMD_IA_SET_PRIMITIVE_TOPOLOGY:
+			context->IASetPrimitiveTopology(reader.Read<RenderTopology>());
+			break;
+
+		case CMD_IA_SET_INDEX_BUFFER:
+		{
+			RenderBuffer* buffer = reader.Read<RenderBuffer*>();
+			RenderIndexFormat format = reader.Read<RenderIndexFormat>();
+			uint32_t offset = reader.Read<uint32_t>();
+			context->IASetIndexBuffer(buffer, format, offset);
+			break;
+		}
+
+		case CMD_IA_SET_VERTEX_BUFFERS:
+		{
+			uint32_t startSlot = reader.Read<uint32_t>();
+			uint32_t numBuffers = reader.Read<uint32_t>();
+			RenderBuffer* const* buffers = reader.ReadArray<RenderBuffer*>(numBuffers);
+			const uint32_t* strides = reader.ReadArray<uint32_t>(numBuffers);
+			const uint32_t* offsets = reader.ReadArray<uint32_t>(numBuffers);
+			context->IASetVertexBuffers(startSlot, numBuffers, buffers, strides, offsets);
+			break;
+		}
+
+		case CMD_VS_SET_SHADER:
+		{
+			RenderVertexShader* shader = reader.Read<RenderVertexShader*>();
+			uint32_t numClassInstances = reader.Read<uint32_t>();
+			context->VSSetShader(shader, reader.ReadArray<RenderClassInstance*>(numClassInstances), numClassInstances);
+			break;
+		}
+
+		case CMD_VS_SET_CONSTANT_BUFFERS:
+		{
+			uint32_t startSlot = reader.Read<uint32_t>();
+			uint32_t numBuffers = reader.Read<uint32_t>();
+			context->VSSetConstantBuffers(startSlot, numBuffers, reader.ReadArray<RenderBuffer*>(numBuffers));
+			break;
+		}
+
+		case CMD_VS_SET_CONSTANT_BUFFERS1:
+		{
+			uint32_t startSlot = reader.Read<uint32_t>();
+			uint32_t numBuffers = reader.Read<uint32_t>();
+			RenderBuffer* const* buffers = reader.ReadArray<RenderBuffer*>(numBuffers);
+			const uint32_t* firstConstants = reader.ReadArray<uint32_t>(numBuffers);
+			const uint32_t* numConstants = reader.ReadArray<uint32_t>(numBuffers);
+			context->VSSetConstantBuffers1(startSlot, numBuffers, buffers, firstConstants, numConstants);
+			break;
+		}
+
+		case CMD_RS_SET_STATE:
+			context->RSSetState(reader.Read<RenderRasterizerState*>());
+			break;
+
+		case CMD_PS_SET_SHADER:
+		{
+			RenderPixelShader* shader = reader.Read<RenderPixelShader*>();
+			uint32_t numClassInstances = reader.Read<uint32_t>();
+			context->PSSetShader(shader, reader.ReadArray<RenderClassInstance*>(numClassInstances), numClassInstances);
+			break;
+		}
+
+		case CMD_PS_SET_CONSTANT_BUFFERS:
+		{
+			uint32_t startSlot = reader.Read<uint32_t>();
+			uint32_t numBuffers = reader.Read<uint32_t>();
+			context->PSSetConstantBuffers(startSlot, numBuffers, reader.ReadArray<RenderBuffer*>(numBuffers));
+			break;
+		}
+
+		case CMD_PS_SET_SHADER_RESOURCES:
+		{
+			uint32_t startSlot = reader.Read<uint32_t>();
+			uint32_t numViews = reader.Read<uint32_t>();
+			context->PSSetShaderResources(startSlot, numViews, reader.ReadArray<RenderShaderResource*>(numViews));
+			break;
+		}
+
+		case CMD_PS_SET_SAMPLERS:
+		{
+			uint32_t startSlot = reader.Read<uint32_t>();
+			uint32_t numSamplers = reader.Read<uint32_t>();
+			context->PSSetSamplers(startSlot, numSamplers, reader.ReadArray<RenderSampler*>(numSamplers));
+			break;
+		}
+
+		case CMD_OM_SET_DEPTH_STENCIL_STATE:
+		{
+			RenderDepthStencilState* depthStencilState = reader.Read<RenderDepthStencilState*>();
+			uint32_t stencilRef = reader.Read<uint32_t>();
+			context->OMSetDepthStencilState(depthStencilState, stencilRef);
+			break;
+		}
+
+		case CMD_OM_SET_BLEND_STATE:
+		{
+			RenderBlendState* blendState = reader.Read<RenderBlendState*>();
+			uint32_t hasBlendFactor = reader.Read<uint32_t>();
+			const float* blendFactor = reader.ReadArray<float>(hasBlendFactor ? 4 : 0);
+			uint32_t sampleMask = reader.Read<uint32_t>();
+			context->OMSetBlendState(blendState, blendFactor, sampleMask);
+			break;
+		}
+
+		case CMD_MAP:
+		{
+			// Map で書き込んだ内容を同じ方法で書き込み直す
+			RenderBuffer* buffer = reader.Read<RenderBuffer*>();
+			RenderMap mapType = reader.Read<RenderMap>();
+			uint64_t size = reader.Read<uint64_t>();
+			const uint8_t* data = reader.ReadArray<uint8_t>(static_cast<size_t>(size));
+			void* mapped = context->Map(buffer, mapType);
+			if (mapped)
+			{
+				memcpy(mapped, data, static_cast<size_t>(size));
+				context->Unmap(buffer);
+			}
+			break;
+		}
+
+		case CMD_UPDATE_BUFFER:
+		{
+			RenderBuffer* buffer = reader.Read<RenderBuffer*>();
+			uint64_t size = reader.Read<uint64_t>();
+			const uint8_t* data = reader.ReadArray<uint8_t>(static_cast<size_t>(size));
+			context->UpdateBuffer(buffer, data, static_cast<size_t>(size));
+			break;
+		}
+
+		case CMD_DRAW:
+		{
+			uint32_t vertexCount = reader.Read<uint32_t>();
+			uint32_t startVertexLocation = reader.Read<uint32_t>();
+			context->Draw(vertexCount, startVertexLocation);
+			break;
+		}
+
+		case CMD_DRAW_INDEXED:
+		{
+			uint32_t indexCount = reader.Read<uint32_t>();
+			uint32_t startIndexLocation = reader.Read<uint32_t>();
+			int32_t baseVertexLocation = reader.Read<int32_t>();
+			context->DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
+			break;
+		}
+
+		case CMD_DRAW_INDEXED_INSTANCED:
+		{
+			uint32_t indexCountPerInstance = reader.Read<uint32_t>();
+			uint32_t instanceCount = reader.Read<uint32_t>();
+			uint32_t startIndexLocation = reader.Read<uint32_t>();
+			int32_t baseVertexLocation = reader.Read<int32_t>();
+			uint32_t startInstanceLocation = reader.Read<uint32_t>();
+			context->DrawIndexedInstanced(indexCountPerInstance, instanceCount,
+				startIndexLocation, baseVertexLocation, startInstanceLocation);
+			break;
+		}
+
+		default:
+			// 記録していないコマンドは来ないので、壊れている場合はそこで止める
+			return;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// コマンドの種類を書き込む関数
+//--------------------------------------------------------------------------------------
+void RenderCommandList::BeginCommand(uint32_t command)
+{
+	Write(command);
+	m_commandCount++;
+}
+
+//--------------------------------------------------------------------------------------
+// 引数を書き込む関数（次の書き込み位置は境界に揃える）
+//--------------------------------------------------------------------------------------
+void RenderCommandList::Write(const void* data, size_t size)
+{
+	size_t offset = m_stream.size();
+	m_stream.resize(offset + AlignUp(size));
+	if (size > 0) memcpy(&m_stream[offset], data, size);
+}
+
+//--------------------------------------------------------------------------------------
+// IA
+//--------------------------------------------------------------------------------------
+void RenderCommandList::IASetInputLayout(RenderInputLayout* inputLayout)
+{
+	BeginCommand(CMD_IA_SET_INPUT_LAYOUT);
+	Write(inputLayout);
+}
+
+void RenderCommandList::IASetPrimitiveTopology(RenderTopology topology)
+{
+	BeginCommand(CMD_IA_SET_PRIMITIVE_TOPOLOGY);
+	Write(topology);
+}
+
+void RenderCommandList::IASetIndexBuffer(RenderBuffer* buffer, RenderIndexFormat format, uint32_t offset)
+{
+	BeginCommand(CMD_IA_SET_INDEX_BUFFER);
+	Write(buffer);
+	Write(format);
+	Write(offset);
+}
+
+void RenderCommandList::IASetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets)
+{
+	BeginCommand(CMD_IA_SET_VERTEX_BUFFERS);
+	Write(startSlot);
+	Write(numBuffers);
+	Write(buffers, sizeof(RenderBuffer*) * numBuffers);
+	Write(strides, sizeof(uint32_t) * numBuffers);
+	Write(offsets, sizeof(uint32_t) * numBuffers);
+}
+
+//--------------------------------------------------------------------------------------
+// VS
+//--------------------------------------------------------------------------------------
+void RenderCommandList::VSSetShader(RenderVertexShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances)
+{
+	BeginCommand(CMD_VS_SET_SHADER);
+	Write(shader);
+	Write(numClassInstances);
+	Write(classInstances, sizeof(RenderClassInstance*) * numClassInstances);
+}
+
+void RenderCommandList::VSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers)
+{
+	BeginCommand(CMD_VS_SET_CONSTANT_BUFFERS);
+	Write(startSlot);
+	Write(numBuffers);
+	Write(buffers, sizeof(RenderBuffer*) * numBuffers);
+}
+
+void RenderCommandList::VSSetConstantBuffers1(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers,
+	const uint32_t* firstConstants, const uint32_t* numConstants)
+{
+	BeginCommand(CMD_VS_SET_CONSTANT_BUFFERS1);
+	Write(startSlot);
+	Write(numBuffers);
+	Write(buffers, sizeof(RenderBuffer*) * numBuffers);
+	Write(firstConstants, sizeof(uint32_t) * numBuffers);
+	Write(numConstants, sizeof(uint32_t) * numBuffers);
+}
+
+//--------------------------------------------------------------------------------------
+// RS
+//--------------------------------------------------------------------------------------
+void RenderCommandList::RSSetState(RenderRasterizerState* rasterizerState)
+{
+	BeginCommand(CMD_RS_SET_STATE);
+	Write(rasterizerState);
+}
+
+//--------------------------------------------------------------------------------------
+// PS
+//--------------------------------------------------------------------------------------
+void RenderCommandList::PSSetShader(RenderPixelShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances)
+{
+	BeginCommand(CMD_PS_SET_SHADER);
+	Write(shader);
+	Write(numClassInstances);
+	Write(classInstances, sizeof(RenderClassInstance*) * numClassInstances);
+}
+
+void RenderCommandList::PSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers)
+{
+	BeginCommand(CMD_PS_SET_CONSTANT_BUFFERS);
+	Write(startSlot);
+	Write(numBuffers);
+	Write(buffers, sizeof(RenderBuffer*) * numBuffers);
+}
+
+void RenderCommandList::PSSetShaderResources(uint32_t startSlot, uint32_t numViews, RenderShaderResource* const* views)
+{
+	BeginCommand(CMD_PS_SET_SHADER_RESOURCES);
+	Write(startSlot);
+	Write(numViews);
+	Write(views, sizeof(RenderShaderResource*) * numViews);
+}
+
+void RenderCommandList::PSSetSamplers(uint32_t startSlot, uint32_t numSamplers, RenderSampler* const* samplers)
+{
+	BeginCommand(CMD_PS_SET_SAMPLERS);
+	Write(startSlot);
+	Write(numSamplers);
+	Write(samplers, sizeof(RenderSampler*) * numSamplers);
+}
+
+//--------------------------------------------------------------------------------------
+// OM
+//--------------------------------------------------------------------------------------
+void RenderCommandList::OMSetDepthStencilState(RenderDepthStencilState* depthStencilState, uint32_t stencilRef)
+{
+	BeginCommand(CMD_OM_SET_DEPTH_STENCIL_STATE);
+	Write(depthStencilState);
+	Write(stencilRef);
+}
+
+void RenderCommandList::OMSetBlendState(RenderBlendState* blendState, const float blendFactor[4], uint32_t sampleMask)
+{
+	// ブレンドファクターの nullptr は既定値の意味なのでそのまま残す
+	BeginCommand(CMD_OM_SET_BLEND_STATE);
+	Write(blendState);
+	Write(static_cast<uint32_t>(blendFactor ? 1 : 0));
+	if (blendFactor) Write(blendFactor, sizeof(float) * 4);
+	Write(sampleMask);
+}
+
+//--------------------------------------------------------------------------------------
+// リソース
+//--------------------------------------------------------------------------------------
+void* RenderCommandList::Map(RenderBuffer* buffer, RenderMap mapType)
+{
+	// 大きさの分からないバッファと Map 中の Map は失敗にする
+	if (m_mappedBuffer) return nullptr;
+
+	for (const auto& bufferSize : m_bufferSizes)
+	{
+		if (bufferSize.first == buffer)
+		{
+			m_mappedBuffer = buffer;
+			m_mapType = mapType;
+			m_mapData.resize(bufferSize.second);
+			return m_mapData.data();
+		}
+	}
+
+	return nullptr;
+}
+
+void RenderCommandList::Unmap(RenderBuffer* buffer)
+{
+	if (!m_mappedBuffer || buffer != m_mappedBuffer) return;
+
+	// 書き込まれた範囲は分からないので領域の全体を記録する
+	BeginCommand(CMD_MAP);
+	Write(buffer);
+	Write(m_mapType);
+	Write(static_cast<uint64_t>(m_mapData.size()));
+	Write(m_mapData.data(), m_mapData.size());
+
+	m_mappedBuffer = nullptr;
+}
+
+bool RenderCommandList::UpdateBuffer(RenderBuffer* buffer, const void* data, size_t size)
+{
+	// 書き込むデータだけをコピーしておき、発行する時に書き込む
+	BeginCommand(CMD_UPDATE_BUFFER);
+	Write(buffer);
+	Write(static_cast<uint64_t>(size));
+	Write(data, size);
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// 描画
+//--------------------------------------------------------------------------------------
+void RenderCommandList::Draw(uint32_t vertexCount, uint32_t startVertexLocation)
+{
+	BeginCommand(CMD_DRAW);
+	Write(vertexCount);
+	Write(startVertexLocation);
+}
+
+void RenderCommandList::DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation)
+{
+	BeginCommand(CMD_DRAW_INDEXED);
+	Write(indexCount);
+	Write(startIndexLocation);
+	Write(baseVertexLocation);
+}
+
+void RenderCommandList::DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+	uint32_t startIndexLocation, int32_t baseVertexLocation, uint32_t startInstanceLocation)
+{
+	BeginCommand(CMD_DRAW_INDEXED_INSTANCED);
+	Write(indexCountPerInstance);
+	Write(instanceCount);
+	Write(startIndexLocation);
+	Write(baseVertexLocation);
+	Write(startInstanceLocation);
+}
@@ -0,0 +1,143 @@
+﻿//--------------------------------------------------------------------------------------
+// File: RenderCommandList.h
+//
+// 描画コマンドを記録して、後で別のコンテキストへ発行するコマンドリスト
+//
+// Usage: IRenderContext として描画処理へ渡すと、呼び出された関数と引数（配列の中身を含む）を
+//        バイト列へ順番に記録します。Execute で記録した順番のまま別のコンテキストへ発行します。
+//        記録はコマンドリストごとに独立しているので、複数のスレッドでそれぞれのコマンドリストへ
+//        同時に記録し、メインスレッドで順番に発行できます（Direct3D 11 の遅延コンテキストと
+//        同じ使い方）。
+//        UpdateBuffer は書き込むデータをコマンドリストへコピーし、発行する時に書き込みます。
+//        Map で直接書き込む場合は SetBufferSize でバッファの大きさを教えてください
+//        （大きさの分からないバッファの Map は失敗して nullptr を返します）。
+//        Clear しても確保済みの領域はそのまま使うので、毎フレーム記録してもメモリの確保は増えません。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	Imase::RenderCommandList commandList;
+//
+//	commandList.Clear();
+//	commandList.IASetInputLayout(inputLayout);
+//	commandList.UpdateBuffer(constantBuffer, &data, sizeof(data));
+//	commandList.DrawIndexed(6, 0, 0);
+//
+//	commandList.Execute(&renderContext);	// 記録した順番に発行する
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "RenderContext.h"
+
+namespace Imase
+{
+	// 描画コマンドを記録するコマンドリスト
+	class RenderCommandList : public IRenderContext
+	{
+	public:
+
+		RenderCommandList() = default;
+
+		/// <summary>
+		/// 記録したコマンドを全て削除する関数（確保済みの領域はそのまま使う）
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// 記録したコマンドを順番に発行する関数（何度でも発行できる）
+		/// </summary>
+		/// <param name="context">発行先のコンテキスト</param>
+		void Execute(IRenderContext* context) const;
+
+		/// <summary>
+		/// Map で書き込めるようにバッファの大きさを設定する関数
+		/// </summary>
+		/// <param name="buffer">バッファ</param>
+		/// <param name="size">バッファのバイト数</param>
+		void SetBufferSize(RenderBuffer* buffer, size_t size);
+
+		// 記録したコマンドの数を取得する関数
+		size_t GetCommandCount() const { return m_commandCount; }
+
+		// 記録したバイト数を取得する関数
+		size_t GetByteSize() const { return m_stream.size(); }
+
+		// コマンドを記録していない場合は true を返す関数
+		bool IsEmpty() const { return m_commandCount == 0; }
+
+		// ----- IA ----- //
+
+		void IASetInputLayout(RenderInputLayout* inputLayout) override;
+		void IASetPrimitiveTopology(RenderTopology topology) override;
+		void IASetIndexBuffer(RenderBuffer* buffer, RenderIndexFormat format, uint32_t offset) override;
+		void IASetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets) override;
+
+		// ----- VS ----- //
+
+		void VSSetShader(RenderVertexShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances) override;
+		void VSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers) override;
+		void VSSetConstantBuffers1(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers,
+			const uint32_t* firstConstants, const uint32_t* numConstants) override;
+
+		// ----- RS ----- //
+
+		void RSSetState(RenderRasterizerState* rasterizerState) override;
+
+		// ----- PS ----- //
+
+		void PSSetShader(RenderPixelShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances) override;
+		void PSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers) override;
+		void PSSetShaderResources(uint32_t startSlot, uint32_t numViews, RenderShaderResource* const* views) override;
+		void PSSetSamplers(uint32_t startSlot, uint32_t numSamplers, RenderSampler* const* samplers) override;
+
+		// ----- OM ----- //
+
+		void OMSetDepthStencilState(RenderDepthStencilState* depthStencilState, uint32_t stencilRef) override;
+		void OMSetBlendState(RenderBlendState* blendState, const float blendFactor[4], uint32_t sampleMask) override;
+
+		// ----- リソース ----- //
+
+		void* Map(RenderBuffer* buffer, RenderMap mapType) override;
+		void Unmap(RenderBuffer* buffer) override;
+		bool UpdateBuffer(RenderBuffer* buffer, const void* data, size_t size) override;
+
+		// ----- 描画 ----- //
+
+		void Draw(uint32_t vertexCount, uint32_t startVertexLocation) override;
+		void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation) override;
+		void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+			uint32_t startIndexLocation, int32_t baseVertexLocation, uint32_t startInstanceLocation) override;
+
+	private:
+
+		// コマンドの種類と引数を書き込む関数
+		void BeginCommand(uint32_t command);
+		void Write(const void* data, size_t size);
+
+		template <class T>
+		void Write(const T& value) { Write(&value, sizeof(T)); }
+
+	private:
+
+		// 記録したコマンド（種類・引数・配列の中身の順に詰めたバイト列）
+		std::vector<uint8_t> m_stream;
+
+		// 記録したコマンドの数
+		size_t m_commandCount = 0;
+
+		// Map で書き込めるバッファの大きさ
+		std::vector<std::pair<RenderBuffer*, size_t>> m_bufferSizes;
+
+		// Map 中のバッファと書き込む方法と書き込み先の領域
+		RenderBuffer* m_mappedBuffer = nullptr;
+		RenderMap m_mapType = RenderMap::WriteDiscard;
+		std::vector<uint8_t> m_mapData;
+	};
+}
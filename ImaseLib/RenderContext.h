@@ -0,0 +1,151 @@
+﻿//--------------------------------------------------------------------------------------
+// File: RenderContext.h
+//
+// 描画コマンドを発行するインターフェイス（グラフィックス API に依存しない）
+//
+// Usage: 描画処理は ID3D11DeviceContext の代わりに IRenderContext を使います。
+//        関数の名前と引数は ID3D11DeviceContext と同じ並びなので、StateFilteredContext で
+//        包むこともできます。
+//        実装は D3D11RenderContext（Direct3D 11）と NullRenderContext（GPU を使わずに
+//        コマンドの検証と計測だけを行う）があり、NullRenderContext を使えば
+//        Windows 以外の環境でもフレームの処理を実行できます。
+//        RenderCommandList はコマンドを記録しておき、後で別のコンテキストへ発行します。
+//        リソースはバックエンドごとの実体を指すハンドル（中身の分からない型へのポインタ）で扱います。
+//
+//	<<< 記述例 >>
+//	context->IASetInputLayout(inputLayout);
+//	context->UpdateBuffer(constantBuffer, &data, sizeof(data));
+//	context->DrawIndexed(6, 0, 0);
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Imase
+{
+	// リソースのハンドル（実体は各バックエンドが決める）
+	struct RenderBuffer;
+	struct RenderInputLayout;
+	struct RenderVertexShader;
+	struct RenderPixelShader;
+	struct RenderClassInstance;
+	struct RenderShaderResource;
+	struct RenderSampler;
+	struct RenderRasterizerState;
+	struct RenderDepthStencilState;
+	struct RenderBlendState;
+
+	// プリミティブのトポロジー（値は D3D_PRIMITIVE_TOPOLOGY と同じ）
+	enum class RenderTopology : uint32_t
+	{
+		Undefined = 0,
+		PointList = 1,
+		LineList = 2,
+		LineStrip = 3,
+		TriangleList = 4,
+		TriangleStrip = 5,
+	};
+
+	// インデックスの形式（値は DXGI_FORMAT と同じ）
+	enum class RenderIndexFormat : uint32_t
+	{
+		UInt32 = 42,
+		UInt16 = 57,
+	};
+
+	// バッファを書き換える方法（値は D3D11_MAP と同じ）
+	enum class RenderMap : uint32_t
+	{
+		// 前の内容を破棄する
+		WriteDiscard = 4,
+
+		// GPU が使用中の範囲は書き換えないことを約束する
+		WriteNoOverwrite = 5,
+	};
+
+	// 描画コマンドを発行するインターフェイス
+	class IRenderContext
+	{
+	public:
+
+		virtual ~IRenderContext() = default;
+
+		// ----- IA ----- //
+
+		virtual void IASetInputLayout(RenderInputLayout* inputLayout) = 0;
+		virtual void IASetPrimitiveTopology(RenderTopology topology) = 0;
+		virtual void IASetIndexBuffer(RenderBuffer* buffer, RenderIndexFormat format, uint32_t offset) = 0;
+		virtual void IASetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets) = 0;
+
+		// ----- VS ----- //
+
+		virtual void VSSetShader(RenderVertexShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances) = 0;
+		virtual void VSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers) = 0;
+
+		/// <summary>
+		/// 定数バッファの一部の範囲を設定する関数（ID3D11DeviceContext1::VSSetConstantBuffers1 と同じ）
+		/// </summary>
+		/// <param name="firstConstants">バッファごとの先頭の位置（16 バイト単位の定数の数、16 の倍数）</param>
+		/// <param name="numConstants">バッファごとの定数の数（16 の倍数、4096 以下）</param>
+		virtual void VSSetConstantBuffers1(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers,
+			const uint32_t* firstConstants, const uint32_t* numConstants) = 0;
+
+		// ----- RS ----- //
+
+		virtual void RSSetState(RenderRasterizerState* rasterizerState) = 0;
+
+		// ----- PS ----- //
+
+		virtual void PSSetShader(RenderPixelShader* shader, RenderClassInstance* const* classInstances, uint32_t numClassInstances) = 0;
+		virtual void PSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, RenderBuffer* const* buffers) = 0;
+		virtual void PSSetShaderResources(uint32_t startSlot, uint32_t numViews, RenderShaderResource* const* views) = 0;
+		virtual void PSSetSamplers(uint32_t startSlot, uint32_t numSamplers, RenderSampler* const* samplers) = 0;
+
+		// ----- OM ----- //
+
+		virtual void OMSetDepthStencilState(RenderDepthStencilState* depthStencilState, uint32_t stencilRef) = 0;
+		virtual void OMSetBlendState(RenderBlendState* blendState, const float blendFactor[4], uint32_t sampleMask) = 0;
+
+		// ----- リソース ----- //
+
+		/// <summary>
+		/// バッファへ書き込む領域を取得する関数（失敗した場合は nullptr）
+		/// </summary>
+		virtual void* Map(RenderBuffer* buffer, RenderMap mapType) = 0;
+
+		/// <summary>
+		/// バッファへの書き込みを終了する関数
+		/// </summary>
+		virtual void Unmap(RenderBuffer* buffer) = 0;
+
+		// ----- 描画 ----- //
+
+		virtual void Draw(uint32_t vertexCount, uint32_t startVertexLocation) = 0;
+		virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation) = 0;
+		virtual void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+			uint32_t startIndexLocation, int32_t baseVertexLocation, uint32_t startInstanceLocation) = 0;
+
+		/// <summary>
+		/// バッファの内容を書き換える関数（前の内容は破棄する、コマンドを記録する実装は上書きする）
+		/// </summary>
+		/// <param name="buffer">バッファ（CPU から書き込めるもの）</param>
+		/// <param name="data">書き込むデータ</param>
+		/// <param name="size">書き込むバイト数</param>
+		/// <returns>書き込めた場合は true</returns>
+		virtual bool UpdateBuffer(RenderBuffer* buffer, const void* data, size_t size)
+		{
+			void* mapped = Map(buffer, RenderMap::WriteDiscard);
+			if (!mapped) return false;
+
+			memcpy(mapped, data, size);
+			Unmap(buffer);
+
+			return true;
+		}
+	};
+}
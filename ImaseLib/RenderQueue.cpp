@@ -0,0 +1,220 @@
+﻿//--------------------------------------------------------------------------------------
+// File: RenderQueue.cpp
+//
+// ソートキーで描画の順番を並べ替えるレンダーキュー
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "RenderQueue.h"
+
+#include <cstring>
+
+using namespace Imase;
+
+namespace
+{
+	// 基数ソートの１回分のビット数と回数
+	constexpr int RADIX_BITS = 8;
+	constexpr int RADIX_SIZE = 1 << RADIX_BITS;
+	constexpr int RADIX_PASSES = 64 / RADIX_BITS;
+
+	// 未設定を表す番号
+	constexpr uint32_t INVALID_INDEX = 0xffffffff;
+
+	// ビットマスク
+	constexpr uint64_t Mask(int bits) { return (uint64_t(1) << bits) - 1; }
+
+	// 距離をソートキーの深度へ変換する関数
+	// （正の浮動小数点数はビット列を整数として比較しても大小関係が同じなので、上位ビットを使う）
+	inline uint64_t DepthToBits(float depth)
+	{
+		if (!(depth > 0.0f)) return 0;
+
+		uint32_t bits;
+		memcpy(&bits, &depth, sizeof(bits));
+
+		return bits >> (31 - RenderQueue::DEPTH_BITS);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// ソートキーを作成する関数
+//--------------------------------------------------------------------------------------
+uint64_t RenderQueue::EncodeKey(uint32_t layer, uint32_t shader, uint32_t material, float depth, RenderSortMode mode)
+{
+	uint64_t l = layer & Mask(LAYER_BITS);
+	uint64_t s = shader & Mask(SHADER_BITS);
+	uint64_t m = material & Mask(MATERIAL_BITS);
+	uint64_t d = DepthToBits(depth);
+
+	if (mode == RenderSortMode::BackToFront)
+	{
+		// レイヤー | 深度（反転） | シェーダー | マテリアル
+		d = ~d & Mask(DEPTH_BITS);
+		return (l << (64 - LAYER_BITS))
+			| (d << (SHADER_BITS + MATERIAL_BITS))
+			| (s << MATERIAL_BITS)
+			| m;
+	}
+
+	// レイヤー | シェーダー | マテリアル | 深度
+	return (l << (64 - LAYER_BITS))
+		| (s << (MATERIAL_BITS + DEPTH_BITS))
+		| (m << DEPTH_BITS)
+		| d;
+}
+
+//--------------------------------------------------------------------------------------
+// コンストラクタ
+//--------------------------------------------------------------------------------------
+RenderQueue::RenderQueue()
+{
+	for (RenderSortMode& mode : m_layerSortModes)
+	{
+		mode = RenderSortMode::FrontToBack;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// レイヤー内の並べ方を設定する関数
+//--------------------------------------------------------------------------------------
+void RenderQueue::SetLayerSortMode(uint32_t layer, RenderSortMode mode)
+{
+	if (layer < MAX_LAYERS) m_layerSortModes[layer] = mode;
+}
+
+//--------------------------------------------------------------------------------------
+// パケットの領域を予約する関数
+//--------------------------------------------------------------------------------------
+void RenderQueue::Reserve(size_t count)
+{
+	m_packets.reserve(count);
+	m_sorted.reserve(count);
+	m_work.reserve(count);
+}
+
+//--------------------------------------------------------------------------------------
+// 積んだパケットを全て削除する関数
+//--------------------------------------------------------------------------------------
+void RenderQueue::Clear()
+{
+	m_packets.clear();
+	m_sorted.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// パケットを積む関数
+//--------------------------------------------------------------------------------------
+void RenderQueue::Submit(uint32_t layer, uint32_t shader, uint32_t material, float depth, uint32_t command, uint32_t argument)
+{
+	RenderSortMode mode = layer < MAX_LAYERS ? m_layerSortModes[layer] : RenderSortMode::FrontToBack;
+
+	RenderPacket packet;
+	packet.key = EncodeKey(layer, shader, material, depth, mode);
+	packet.shader = shader;
+	packet.material = material;
+	packet.command = command;
+	packet.argument = argument;
+
+	m_packets.push_back(packet);
+}
+
+//--------------------------------------------------------------------------------------
+// ソートキーで並べ替える関数
+//--------------------------------------------------------------------------------------
+void RenderQueue::Sort()
+{
+	size_t count = m_packets.size();
+
+	m_sorted.resize(count);
+	m_work.resize(count);
+
+	// 各桁の出現回数をまとめて数える
+	uint32_t histograms[RADIX_PASSES][RADIX_SIZE] = {};
+	for (size_t i = 0; i < count; i++)
+	{
+		uint64_t key = m_packets[i].key;
+		m_sorted[i] = { key, static_cast<uint32_t>(i) };
+
+		for (int pass = 0; pass < RADIX_PASSES; pass++)
+		{
+			histograms[pass][(key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)]++;
+		}
+	}
+
+	if (count < 2) return;
+
+	// 下の桁から安定な計数ソートを繰り返す（LSD 基数ソート）
+	for (int pass = 0; pass < RADIX_PASSES; pass++)
+	{
+		int shift = pass * RADIX_BITS;
+		uint32_t* histogram = histograms[pass];
+
+		// 全てのキーでこの桁が同じ場合は並びが変わらないので飛ばす
+		// （レイヤーやシェーダーの桁は種類が少ないので飛ばせることが多い）
+		if (histogram[(m_sorted[0].key >> shift) & (RADIX_SIZE - 1)] == count) continue;
+
+		// 出現回数を書き込み位置に置き換える
+		uint32_t offset = 0;
+		for (int digit = 0; digit < RADIX_SIZE; digit++)
+		{
+			uint32_t n = histogram[digit];
+			histogram[digit] = offset;
+			offset += n;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const SortItem& item = m_sorted[i];
+			m_work[histogram[(item.key >> shift) & (RADIX_SIZE - 1)]++] = item;
+		}
+
+		m_sorted.swap(m_work);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 並べ替えた順番にパケットを実行する関数
+//--------------------------------------------------------------------------------------
+void RenderQueue::Execute(IRenderPacketHandler* handler)
+{
+	m_stats = {};
+
+	uint32_t currentShader = INVALID_INDEX;
+	uint32_t currentMaterial = INVALID_INDEX;
+
+	for (const SortItem& item : m_sorted)
+	{
+		const RenderPacket& packet = m_packets[item.index];
+
+		// 自分でステートを設定する描画の後は、設定済みのステートが分からないので設定し直す
+		if (packet.shader == EXTERNAL_SHADER)
+		{
+			handler->Draw(packet);
+			currentShader = INVALID_INDEX;
+			currentMaterial = INVALID_INDEX;
+			m_stats.packetCount++;
+			continue;
+		}
+
+		// 前のパケットと異なる場合だけ設定する
+		if (packet.shader != currentShader)
+		{
+			handler->BindShader(packet.shader);
+			currentShader = packet.shader;
+			m_stats.shaderChanges++;
+		}
+		if (packet.material != currentMaterial)
+		{
+			handler->BindMaterial(packet.material);
+			currentMaterial = packet.material;
+			m_stats.materialChanges++;
+		}
+
+		handler->Draw(packet);
+		m_stats.packetCount++;
+	}
+}
@@ -0,0 +1,200 @@
+﻿//--------------------------------------------------------------------------------------
+// File: RenderQueue.h
+//
+// ソートキーで描画の順番を並べ替えるレンダーキュー
+//
+// Usage: 各処理は描画したい内容を描画パケット（レイヤー・シェーダー・マテリアル・深度と
+//        描画の種類）として Submit で積みます。Sort で 64 ビットのソートキーを基数ソートし、
+//        Execute で並べ替えた順番に描画します。
+//        シェーダー（パイプラインステート）とマテリアル（テクスチャ等）は前のパケットと
+//        番号が異なる場合だけ設定し直すので、ステートの変更が最小になります。
+//        DirectXTK 等、自分でステートを設定する描画は EXTERNAL_SHADER を指定します。
+//        描画後は設定済みのステートが分からなくなるので、次のパケットで設定し直します。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	queue.SetLayerSortMode(LAYER_TRANSLUCENT, Imase::RenderSortMode::BackToFront);
+//
+//	queue.Clear();
+//	queue.Submit(LAYER_OPAQUE, SHADER_MODEL, MATERIAL_ROCK, distance, DRAW_ROCK);
+//	queue.Submit(LAYER_OVERLAY, Imase::RenderQueue::EXTERNAL_SHADER, 0, 0.0f, DRAW_FONT);
+//	queue.Sort();
+//	queue.Execute(handler);		// handler は IRenderPacketHandler を継承したクラス
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Imase
+{
+	// レイヤー内の並べ方
+	enum class RenderSortMode
+	{
+		// シェーダー → マテリアル → 手前から奥（不透明なオブジェクト用、ステートの変更が最小）
+		FrontToBack,
+
+		// 奥から手前 → シェーダー → マテリアル（半透明なオブジェクト用）
+		BackToFront,
+	};
+
+	// 描画パケット
+	struct RenderPacket
+	{
+		// ソートキー
+		uint64_t key;
+
+		// シェーダーの番号
+		uint32_t shader;
+
+		// マテリアルの番号
+		uint32_t material;
+
+		// 描画の種類（IRenderPacketHandler が解釈する）
+		uint32_t command;
+
+		// 描画の引数（IRenderPacketHandler が解釈する）
+		uint32_t argument;
+	};
+
+	// 描画パケットを実行するクラスのインターフェイス
+	class IRenderPacketHandler
+	{
+	public:
+
+		virtual ~IRenderPacketHandler() = default;
+
+		// シェーダー（入力レイアウト・シェーダー・ステート等）を設定する関数
+		virtual void BindShader(uint32_t shader) = 0;
+
+		// マテリアル（テクスチャ等）を設定する関数
+		virtual void BindMaterial(uint32_t material) = 0;
+
+		// 描画する関数
+		virtual void Draw(const RenderPacket& packet) = 0;
+	};
+
+	// ステートの変更の回数
+	struct RenderQueueStats
+	{
+		// 実行したパケットの数
+		size_t packetCount;
+
+		// シェーダーを設定した回数
+		size_t shaderChanges;
+
+		// マテリアルを設定した回数
+		size_t materialChanges;
+	};
+
+	// レンダーキュー
+	class RenderQueue
+	{
+	public:
+
+		// ソートキーの各項目のビット数
+		static constexpr int LAYER_BITS = 8;
+		static constexpr int SHADER_BITS = 12;
+		static constexpr int MATERIAL_BITS = 20;
+		static constexpr int DEPTH_BITS = 24;
+
+		// レイヤーの数
+		static constexpr uint32_t MAX_LAYERS = 1u << LAYER_BITS;
+
+		// 自分でステートを設定する描画のシェーダーの番号
+		static constexpr uint32_t EXTERNAL_SHADER = (1u << SHADER_BITS) - 1;
+
+		/// <summary>
+		/// ソートキーを作成する関数
+		/// </summary>
+		/// <param name="layer">レイヤー（小さい順に描画する）</param>
+		/// <param name="shader">シェーダーの番号</param>
+		/// <param name="material">マテリアルの番号</param>
+		/// <param name="depth">カメラからの距離（0 以上）</param>
+		/// <param name="mode">レイヤー内の並べ方</param>
+		/// <returns>ソートキー</returns>
+		static uint64_t EncodeKey(uint32_t layer, uint32_t shader, uint32_t material, float depth, RenderSortMode mode);
+
+		RenderQueue();
+
+		/// <summary>
+		/// レイヤー内の並べ方を設定する関数（既定値は FrontToBack）
+		/// </summary>
+		void SetLayerSortMode(uint32_t layer, RenderSortMode mode);
+
+		/// <summary>
+		/// パケットの領域を予約する関数
+		/// </summary>
+		void Reserve(size_t count);
+
+		/// <summary>
+		/// 積んだパケットを全て削除する関数（確保済みの領域はそのまま使う）
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// パケットを積む関数（ソートキーはレイヤーの並べ方に従って作成する）
+		/// </summary>
+		/// <param name="layer">レイヤー</param>
+		/// <param name="shader">シェーダーの番号（EXTERNAL_SHADER の場合は自分でステートを設定する描画）</param>
+		/// <param name="material">マテリアルの番号</param>
+		/// <param name="depth">カメラからの距離</param>
+		/// <param name="command">描画の種類</param>
+		/// <param name="argument">描画の引数</param>
+		void Submit(uint32_t layer, uint32_t shader, uint32_t material, float depth, uint32_t command, uint32_t argument = 0);
+
+		/// <summary>
+		/// パケットを積む関数（ソートキーは作成済み）
+		/// </summary>
+		void Submit(const RenderPacket& packet) { m_packets.push_back(packet); }
+
+		/// <summary>
+		/// ソートキーで並べ替える関数（基数ソート、キーが同じ場合は積んだ順番を保つ）
+		/// </summary>
+		void Sort();
+
+		/// <summary>
+		/// 並べ替えた順番にパケットを実行する関数
+		/// </summary>
+		/// <param name="handler">パケットを実行するクラス</param>
+		void Execute(IRenderPacketHandler* handler);
+
+		// 積んだパケットの数を取得する関数
+		size_t GetPacketCount() const { return m_packets.size(); }
+
+		// 積んだ順番のパケットを取得する関数
+		const RenderPacket& GetPacket(size_t index) const { return m_packets[index]; }
+
+		// 並べ替えた順番で index 番目のパケットを取得する関数（Sort 後に有効）
+		const RenderPacket& GetSortedPacket(size_t index) const { return m_packets[m_sorted[index].index]; }
+
+		// 最後に実行した時のステートの変更の回数を取得する関数
+		const RenderQueueStats& GetStats() const { return m_stats; }
+
+	private:
+
+		// 並べ替え用の要素（キーとパケットの番号）
+		struct SortItem
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		// 積んだ順番のパケット
+		std::vector<RenderPacket> m_packets;
+
+		// 並べ替えた順番（基数ソートの作業用と交互に使う）
+		std::vector<SortItem> m_sorted;
+		std::vector<SortItem> m_work;
+
+		// レイヤーごとの並べ方
+		RenderSortMode m_layerSortModes[MAX_LAYERS];
+
+		// ステートの変更の回数
+		RenderQueueStats m_stats = {};
+	};
+}
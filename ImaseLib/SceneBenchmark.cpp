@@ -0,0 +1,389 @@
+﻿//--------------------------------------------------------------------------------------
+// File: SceneBenchmark.cpp
+//
+// 合成したシーン（TreeScene）の描画の CPU 側の処理を、ウインドウと GPU を使わずに計測するベンチマーク
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "SceneBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include "DebugCameraView.h"
+#include "FastTrig.h"
+
+using namespace Imase;
+
+namespace
+{
+	// 木と森を積むレイヤー（半透明なので奥から順）
+	constexpr uint32_t LAYER_TRANSLUCENT = 1;
+
+	// 処理の数
+	constexpr int PHASE_COUNT = static_cast<int>(SceneBenchmarkPhase::Count);
+
+	// 処理の名前（CSV の列名）
+	const char* const PHASE_NAMES[PHASE_COUNT] = { "camera_ms", "submit_ms", "sort_ms", "execute_ms", "frame_ms" };
+
+	// 定数のリングバッファのバイト数
+	constexpr uint32_t CONSTANT_RING_SIZE = 64 * 1024;
+
+	// 時計
+	using Clock = std::chrono::steady_clock;
+
+	// 経過時間（秒）
+	inline double Seconds(Clock::time_point start, Clock::time_point end)
+	{
+		return std::chrono::duration<double>(end - start).count();
+	}
+
+	// 遮蔽物の壁を置く円の半径と壁の高さ・厚さ
+	constexpr float OCCLUDER_RING_RADIUS = 5.0f;
+	constexpr float OCCLUDER_WALL_HEIGHT = 3.0f;
+	constexpr float OCCLUDER_WALL_THICKNESS = 0.5f;
+
+	// 箱（幅・高さ・奥行きが１、底面の中央が原点）
+	const Math::Vector3 BOX_POSITIONS[8] =
+	{
+		Math::Vector3(-0.5f, 0.0f, -0.5f), Math::Vector3(0.5f, 0.0f, -0.5f),
+		Math::Vector3(0.5f, 1.0f, -0.5f), Math::Vector3(-0.5f, 1.0f, -0.5f),
+		Math::Vector3(-0.5f, 0.0f, 0.5f), Math::Vector3(0.5f, 0.0f, 0.5f),
+		Math::Vector3(0.5f, 1.0f, 0.5f), Math::Vector3(-0.5f, 1.0f, 0.5f),
+	};
+
+	const uint16_t BOX_INDICES[36] =
+	{
+		0, 2, 1, 0, 3, 2,	// 奥
+		4, 5, 6, 4, 6, 7,	// 手前
+		0, 4, 7, 0, 7, 3,	// 左
+		1, 2, 6, 1, 6, 5,	// 右
+		3, 7, 6, 3, 6, 2,	// 上
+		0, 1, 5, 0, 5, 4,	// 下
+	};
+}
+
+//--------------------------------------------------------------------------------------
+// コンストラクタ
+//--------------------------------------------------------------------------------------
+SceneBenchmark::SceneBenchmark()
+{
+	// ダミーのリソースを作成する
+	TreeSceneResources& resources = m_resources;
+	resources = {};
+	resources.vertexBuffer = m_renderContext.CreateBuffer(sizeof(TreeScene::QUAD_VERTICES), false);
+	resources.indexBuffer = m_renderContext.CreateBuffer(sizeof(TreeScene::QUAD_INDICES), false);
+	resources.instanceBuffer = m_renderContext.CreateBuffer(sizeof(QuadInstance) * TreeScene::MAX_QUAD_INSTANCES, true);
+	resources.frameConstantBuffer = m_renderContext.CreateBuffer(sizeof(TreeScene::FrameConstants), true);
+	resources.treeMaterialConstantBuffer = m_renderContext.CreateBuffer(sizeof(TreeScene::MaterialConstants), true);
+	resources.objectConstantBuffer = m_renderContext.CreateBuffer(sizeof(TreeScene::ObjectConstants), true);
+	resources.constantRing = &m_constantRing;
+	resources.inputLayout = m_renderContext.CreateInputLayout(1);
+	resources.vertexShader = m_renderContext.CreateVertexShader();
+	resources.instancedInputLayout = m_renderContext.CreateInputLayout(2);
+	resources.instancedVertexShader = m_renderContext.CreateVertexShader();
+	resources.pixelShader = m_renderContext.CreatePixelShader();
+	resources.treeTexture = m_renderContext.CreateShaderResource();
+	resources.samplerState = m_renderContext.CreateSampler();
+	resources.rasterizerState = m_renderContext.CreateRasterizerState();
+	resources.depthStencilState = m_renderContext.CreateDepthStencilState();
+	resources.blendState = m_renderContext.CreateBlendState();
+
+	m_constantRing.Initialize(m_renderContext.CreateBuffer(CONSTANT_RING_SIZE, true), CONSTANT_RING_SIZE);
+
+	m_stateContext.Reset(&m_renderContext);
+	m_commandListRecorder.SetTarget(&m_renderContext);
+
+	m_scene.Initialize();
+	m_scene.SetResources(resources, &m_stateContext);
+
+	m_renderQueue.SetLayerSortMode(LAYER_TRANSLUCENT, RenderSortMode::BackToFront);
+}
+
+//--------------------------------------------------------------------------------------
+// フレームを実行する関数
+//--------------------------------------------------------------------------------------
+const SceneBenchmarkReport& SceneBenchmark::Run(const SceneBenchmarkSettings& settings)
+{
+	m_report = SceneBenchmarkReport();
+	m_frames.clear();
+	m_frames.reserve(settings.frameCount);
+
+	m_settings = settings;
+	m_path = settings.cameraPath;
+	if (m_path && m_path->GetKeyCount() == 0) m_path = nullptr;
+
+	// 射影行列（フレーム中は変わらない）
+	float aspectRatio = static_cast<float>(settings.width) / static_cast<float>(std::max(settings.height, 1u));
+	m_projection = Math::Matrix::CreatePerspectiveInfiniteReverseZ(settings.fovY, aspectRatio, settings.nearPlane);
+
+	TreeSceneView view = {};
+	view.fovY = settings.fovY;
+	view.aspectRatio = aspectRatio;
+	view.nearPlane = settings.nearPlane;
+	view.farPlane = settings.farPlane;
+
+	// 実行するフレーム数（経路の最後まで再生したら終了する）
+	uint32_t frameCount = 0;
+	while (frameCount < settings.frameCount
+		&& !(m_path && m_path->GetStartTime() + frameCount * settings.secondsPerFrame > m_path->GetEndTime()))
+	{
+		frameCount++;
+	}
+
+	// パイプラインの場合はワーカーのスレッドでカメラとライトを先に求める
+	bool isPipelined = settings.pipelineDepth > 1;
+	if (isPipelined)
+	{
+		for (TreeSceneView& pipelineView : m_pipelineViews) pipelineView = view;
+
+		m_pipeline.Start(settings.pipelineDepth, [](void* data, uint32_t slot, uint64_t frame)
+			{
+				SceneBenchmark* loop = static_cast<SceneBenchmark*>(data);
+				loop->UpdateView(frame, &loop->m_pipelineViews[slot]);
+			}, this);
+	}
+
+	m_stateContext.Invalidate();
+
+	// 定数のリングバッファを使うか設定する（リングバッファは空に戻す）
+	m_constantRing.Initialize(m_constantRing.GetBuffer(), CONSTANT_RING_SIZE);
+	m_resources.constantRing = settings.constantRing ? &m_constantRing : nullptr;
+	m_scene.SetResources(m_resources, &m_stateContext);
+
+	// 中央の床の周りに遮蔽物の壁を円形に並べる（隙間から奥の木が見える）
+	m_scene.ClearOccluders();
+	for (uint32_t i = 0; i < settings.occluderWalls; i++)
+	{
+		float angle = 6.28318531f * i / settings.occluderWalls;
+		float width = 6.28318531f * OCCLUDER_RING_RADIUS / settings.occluderWalls * 0.75f;
+
+		float s, c;
+		Math::SinCos(angle, &s, &c);
+		Math::Matrix world = Math::Matrix::CreateScale(Math::Vector3(width, OCCLUDER_WALL_HEIGHT, OCCLUDER_WALL_THICKNESS))
+			* Math::Matrix::CreateRotationY(angle)
+			* Math::Matrix::CreateTranslation(Math::Vector3(s, 0.0f, c) * OCCLUDER_RING_RADIUS);
+		m_scene.AddOccluder(BOX_POSITIONS, 8, BOX_INDICES, 36, world);
+	}
+
+	for (uint32_t frame = 0; frame < frameCount; frame++)
+	{
+		m_renderContext.ResetStats();
+		m_stateContext.ResetStats();
+
+		FrameRecord record = {};
+
+		// ----- カメラ ----- //
+
+		Clock::time_point frameStart = Clock::now();
+		const TreeSceneView* frameView = &view;
+		if (isPipelined)
+		{
+			// ワーカーのスレッドが求めたスナップショットを受け取る（フレームの順番に届く）
+			frameView = &m_pipelineViews[m_pipeline.Acquire()];
+		}
+		else
+		{
+			UpdateView(frame, &view);
+		}
+
+		// ----- パケットの作成 ----- //
+
+		Clock::time_point submitStart = Clock::now();
+		m_renderQueue.Clear();
+		m_constantRing.BeginFrame();
+		m_scene.Update();
+		m_scene.Submit(&m_renderQueue, LAYER_TRANSLUCENT, *frameView);
+
+		// ----- ソート ----- //
+
+		Clock::time_point sortStart = Clock::now();
+		m_renderQueue.Sort();
+
+		// ----- 実行 ----- //
+
+		Clock::time_point executeStart = Clock::now();
+		bool isParallel = settings.recordingChunks > 1;
+		if (isParallel)
+		{
+			m_parallelExecutor.Execute(m_renderQueue, &m_scene, &m_stateContext, &m_commandListRecorder, settings.recordingChunks);
+		}
+		else
+		{
+			m_renderQueue.Execute(&m_scene);
+		}
+
+		Clock::time_point frameEnd = Clock::now();
+
+		// 描画が終わったのでワーカーのスレッドが次のスナップショットに使えるようにする
+		if (isPipelined) m_pipeline.Release();
+
+		record.seconds[static_cast<int>(SceneBenchmarkPhase::Camera)] = Seconds(frameStart, submitStart);
+		record.seconds[static_cast<int>(SceneBenchmarkPhase::Submit)] = Seconds(submitStart, sortStart);
+		record.seconds[static_cast<int>(SceneBenchmarkPhase::Sort)] = Seconds(sortStart, executeStart);
+		record.seconds[static_cast<int>(SceneBenchmarkPhase::Execute)] = Seconds(executeStart, frameEnd);
+		record.seconds[static_cast<int>(SceneBenchmarkPhase::Frame)] = Seconds(frameStart, frameEnd);
+
+		// ----- 集計 ----- //
+
+		const NullRenderStats& renderStats = m_renderContext.GetStats();
+		const RenderQueueStats& queueStats = isParallel ? m_parallelExecutor.GetStats() : m_renderQueue.GetStats();
+
+		// 並列に記録した場合はチャンクのコンテキストの回数も足す
+		StateFilterStats stateStats = m_stateContext.GetStats();
+		if (isParallel)
+		{
+			StateFilterStats chunkStats = m_parallelExecutor.GetChunkStateStats();
+			stateStats.issued += chunkStats.issued;
+			stateStats.filtered += chunkStats.filtered;
+
+			m_report.recordedChunks += m_parallelExecutor.GetParallelStats().chunkCount;
+			m_report.recordedCommands += m_commandListRecorder.GetCommandCount();
+		}
+
+		record.draws = renderStats.draws;
+		record.commands = renderStats.commands;
+		record.filtered = stateStats.filtered;
+
+		const OcclusionCullingStats& occlusionStats = m_scene.GetOcclusionStats();
+		record.occluded = occlusionStats.occludedObjects;
+		record.occlusionSeconds = occlusionStats.rasterizeSeconds + occlusionStats.testSeconds;
+
+		for (int i = 0; i < PHASE_COUNT; i++)
+		{
+			SceneBenchmarkPhaseStats& phase = m_report.phases[i];
+			double seconds = record.seconds[i];
+			if (m_report.frameCount == 0)
+			{
+				phase.minSeconds = phase.maxSeconds = seconds;
+			}
+			else
+			{
+				phase.minSeconds = std::min(phase.minSeconds, seconds);
+				phase.maxSeconds = std::max(phase.maxSeconds, seconds);
+			}
+			phase.totalSeconds += seconds;
+		}
+
+		NullRenderStats& total = m_report.renderStats;
+		total.commands += renderStats.commands;
+		total.stateChanges += renderStats.stateChanges;
+		total.draws += renderStats.draws;
+		total.instances += renderStats.instances;
+		total.vertices += renderStats.vertices;
+		total.maps += renderStats.maps;
+		total.mappedBytes += renderStats.mappedBytes;
+		total.errors += renderStats.errors;
+
+		m_report.queueStats.packetCount += queueStats.packetCount;
+		m_report.queueStats.shaderChanges += queueStats.shaderChanges;
+		m_report.queueStats.materialChanges += queueStats.materialChanges;
+
+		m_report.stateStats.issued += stateStats.issued;
+		m_report.stateStats.filtered += stateStats.filtered;
+
+		OcclusionCullingStats& occlusion = m_report.occlusionStats;
+		occlusion.occluderTriangles += occlusionStats.occluderTriangles;
+		occlusion.rasterizedTriangles += occlusionStats.rasterizedTriangles;
+		occlusion.testedObjects += occlusionStats.testedObjects;
+		occlusion.occludedObjects += occlusionStats.occludedObjects;
+		occlusion.rasterizeSeconds += occlusionStats.rasterizeSeconds;
+		occlusion.testSeconds += occlusionStats.testSeconds;
+
+		const TreeSceneConstantStats& constantStats = m_scene.GetConstantStats();
+		record.constantBytes = static_cast<uint32_t>(constantStats.GetUploadedBytes());
+		ConstantUploadStats* totalConstants[] = { &m_report.constantStats.frame, &m_report.constantStats.material, &m_report.constantStats.object };
+		const ConstantUploadStats* frameConstants[] = { &constantStats.frame, &constantStats.material, &constantStats.object };
+		for (int i = 0; i < 3; i++)
+		{
+			totalConstants[i]->uploads += frameConstants[i]->uploads;
+			totalConstants[i]->skips += frameConstants[i]->skips;
+			totalConstants[i]->uploadedBytes += frameConstants[i]->uploadedBytes;
+		}
+
+		if (renderStats.errors > 0 && m_report.firstError.empty())
+		{
+			m_report.firstError = m_renderContext.GetLastError();
+			m_report.firstErrorFrame = frame;
+		}
+
+		m_frames.push_back(record);
+		m_report.frameCount++;
+
+		if (settings.frameEndFunction) settings.frameEndFunction(settings.frameEndData, frame);
+	}
+
+	if (isPipelined)
+	{
+		m_pipeline.Stop();
+		m_report.pipelineStats = m_pipeline.GetStats();
+	}
+
+	if (settings.constantRing) m_report.constantRingStats = m_constantRing.GetStats();
+
+	return m_report;
+}
+
+//--------------------------------------------------------------------------------------
+// 指定したフレームのカメラとライトを求める関数
+//--------------------------------------------------------------------------------------
+void SceneBenchmark::UpdateView(uint64_t frame, TreeSceneView* view) const
+{
+	double time = frame * m_settings.secondsPerFrame;
+
+	CameraPathKey key = { 0.0f, static_cast<float>(time) * m_settings.orbitSpeed, m_settings.orbitPitch, m_settings.orbitDistance };
+	if (m_path) key = m_path->Evaluate(static_cast<float>(m_path->GetStartTime() + time));
+
+	// DebugCamera と同じ計算
+	Math::Vector3 eye, up;
+	DebugCameraView::ComputeEye({ key.yaw, key.pitch, key.distance }, &eye, &up);
+
+	view->view = Math::Matrix::CreateLookAt(eye, Math::Vector3(0.0f, 0.0f, 0.0f), up);
+	view->viewProjection = view->view * m_projection;
+	view->frustum = Frustum::CreateFromViewProjection(view->viewProjection);
+	view->eyePosition = eye;
+	view->lightDirection = TreeScene::GetLightDirection(time);
+}
+
+//--------------------------------------------------------------------------------------
+// フレームごとの計測結果を CSV ファイルへ出力する関数
+//--------------------------------------------------------------------------------------
+bool SceneBenchmark::WriteReport(const char* fileName) const
+{
+	std::ofstream ofs(fileName);
+	if (!ofs) return false;
+
+	ofs << "frame";
+	for (int i = 0; i < PHASE_COUNT; i++) ofs << ',' << PHASE_NAMES[i];
+	ofs << ",draws,commands,filtered,occluded,occlusion_ms,constant_bytes\n";
+
+	for (size_t frame = 0; frame < m_frames.size(); frame++)
+	{
+		const FrameRecord& record = m_frames[frame];
+		ofs << frame;
+		for (int i = 0; i < PHASE_COUNT; i++) ofs << ',' << record.seconds[i] * 1000.0;
+		ofs << ',' << record.draws << ',' << record.commands << ',' << record.filtered
+			<< ',' << record.occluded << ',' << record.occlusionSeconds * 1000.0 << ',' << record.constantBytes << '\n';
+	}
+
+	// 平均
+	uint32_t frameCount = m_report.frameCount;
+	ofs << "average";
+	for (int i = 0; i < PHASE_COUNT; i++) ofs << ',' << m_report.phases[i].GetAverageSeconds(frameCount) * 1000.0;
+	if (frameCount > 0)
+	{
+		ofs << ',' << static_cast<double>(m_report.renderStats.draws) / frameCount
+			<< ',' << static_cast<double>(m_report.renderStats.commands) / frameCount
+			<< ',' << static_cast<double>(m_report.stateStats.filtered) / frameCount
+			<< ',' << static_cast<double>(m_report.occlusionStats.occludedObjects) / frameCount
+			<< ',' << (m_report.occlusionStats.rasterizeSeconds + m_report.occlusionStats.testSeconds) / frameCount * 1000.0
+			<< ',' << static_cast<double>(m_report.constantStats.GetUploadedBytes()) / frameCount;
+	}
+	ofs << '\n';
+
+	return static_cast<bool>(ofs);
+}
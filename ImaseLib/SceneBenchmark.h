@@ -0,0 +1,266 @@
+﻿//--------------------------------------------------------------------------------------
+// File: SceneBenchmark.h
+//
+// 合成したシーン（TreeScene）の描画の CPU 側の処理を、ウインドウと GPU を使わずに計測するベンチマーク
+//
+// ※ ゲームのフレームを実行するものではありません。Game::Tick・Update・Render は呼ばず、
+//    TreeScene（床・木・森・遮蔽物の壁）だけを NullRenderContext へ描画します。Game の
+//    GridFloor・DebugDraw・DebugFont・ImGui・画面のクリアと Present は D3D11 でのみ動くので
+//    計測に含まれません。結果はゲームのフレーム時間ではなく、このシーンのカリング・パケットの
+//    作成・ソート・実行の処理時間として見てください。
+//
+// Usage: NullRenderContext へ TreeScene を描画するフレームを指定した回数だけ実行し、
+//        処理ごと（カメラ・パケットの作成・ソート・実行）の処理時間の最小・平均・最大と、
+//        コマンドの数・ステートの設定の回数・検証で見つかったエラーを集計します。
+//        カメラはカメラの経路を再生するか、経路がない場合は注視点の周りを一定の速さで回ります。
+//        occluderWalls を指定すると中央の床の周りに遮蔽物の壁を置き、オクルージョンカリングで
+//        隠れた木の数と処理時間も集計します。
+//        recordingChunks を 2 以上にすると、パケットを ParallelRenderExecutor で分割して
+//        複数のスレッドで RenderCommandList へ記録し、NullRenderContext で順番に再生します。
+//        直接描画した場合と描画の回数・コマンドの検証の結果を比べることができます。
+//        pipelineDepth を 2 以上にすると、カメラの更新を FramePipeline のワーカーのスレッドで
+//        先のフレームまで行い、このスレッドはスナップショットを受け取って描画します
+//        （Camera の処理時間はスナップショットを待った時間になります）。
+//        constantRing が true の場合はオブジェクトごとの定数を ConstantRing へ書き込み、
+//        VSSetConstantBuffers1 で範囲を設定して描画します（範囲の検証も行います）。
+//        フレームごとに定数バッファへ書き込んだバイト数も集計します。
+//        １フレームで進める時間は固定なので、毎回同じフレームで同じ処理が実行されます。
+//        frameEndFunction を指定すると各フレームの集計の後に呼ぶので、フレームごとのヒープからの
+//        確保の回数などを外から数えることができます。
+//        Windows に依存しないので、どの環境でもコンパイル・実行できます。
+//
+//	<<< 記述例 >>
+//	Imase::SceneBenchmarkSettings settings;
+//	settings.frameCount = 600;
+//	settings.cameraPath = &cameraPath;		// nullptr の場合は回るカメラ
+//
+//	Imase::SceneBenchmark loop;
+//	const Imase::SceneBenchmarkReport& report = loop.Run(settings);
+//	loop.WriteReport("SceneBenchmarkReport.csv");
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CameraPath.h"
+#include "ConstantRing.h"
+#include "FramePipeline.h"
+#include "NullRenderContext.h"
+#include "ParallelRenderExecutor.h"
+#include "RenderQueue.h"
+#include "StateFilteredContext.h"
+#include "TreeScene.h"
+
+namespace Imase
+{
+	// フレームの最後に呼ぶ関数（frame は 0 から始まるフレーム番号）
+	using SceneBenchmarkFrameFunction = void (*)(void* data, uint32_t frame);
+
+	// 実行の設定
+	struct SceneBenchmarkSettings
+	{
+		// 実行するフレーム数（カメラの経路を再生する場合は経路の最後まで、または frameCount まで）
+		uint32_t frameCount = 600;
+
+		// １フレームで進める時間（秒）
+		double secondsPerFrame = 1.0 / 60.0;
+
+		// 画面サイズ（アスペクト比に使用）
+		uint32_t width = 1280;
+		uint32_t height = 720;
+
+		// 視野角（縦方向、ラジアン）とニアクリップ・ファークリップ（射影は Far が無限遠の Reverse-Z）
+		float fovY = 0.785398163f;
+		float nearPlane = 0.1f;
+		float farPlane = 100.0f;
+
+		// 再生するカメラの経路（nullptr の場合は注視点の周りを回る）
+		const CameraPath* cameraPath = nullptr;
+
+		// 回るカメラの縦回転（ラジアン）・注視点からの距離・１秒に回る角度（ラジアン）
+		// 既定の視点は森の中の壁の上端より低い位置（高さ約 2.6）なので、壁の奥の木が隠れる
+		float orbitPitch = -0.6f;
+		float orbitDistance = 10.0f;
+		float orbitSpeed = 0.5f;
+
+		// 中央の床の周りに円形に並べる遮蔽物の壁の数（0 の場合は遮蔽物なし）
+		uint32_t occluderWalls = 0;
+
+		// パケットを分割して並列に記録するチャンクの最大数（1 以下の場合は直接描画する）
+		uint32_t recordingChunks = 0;
+
+		// 更新と描画を重ねるパイプラインの深さ（1 以下の場合は同じスレッドで順番に実行する）
+		uint32_t pipelineDepth = 0;
+
+		// オブジェクトごとの定数をリングバッファへ書き込む場合は true（false の場合は内容が変わった時だけ定数バッファへ書き込む）
+		bool constantRing = true;
+
+		// 各フレームの集計の後に呼ぶ関数とデータ（nullptr の場合は呼ばない）
+		SceneBenchmarkFrameFunction frameEndFunction = nullptr;
+		void* frameEndData = nullptr;
+	};
+
+	// 処理の種類
+	enum class SceneBenchmarkPhase
+	{
+		Camera,		// カメラと視錐台の更新
+		Submit,		// エンティティから配列の作成・カリング・インスタンスのデータの作成・パケットの作成
+		Sort,		// パケットのソート
+		Execute,	// パケットの実行（並列に記録する場合は記録と再生、コマンドの発行と検証）
+		Frame,		// １フレーム全体
+
+		Count
+	};
+
+	// 処理時間の集計
+	struct SceneBenchmarkPhaseStats
+	{
+		// 処理時間の合計・最小・最大（秒）
+		double totalSeconds = 0.0;
+		double minSeconds = 0.0;
+		double maxSeconds = 0.0;
+
+		// 平均の処理時間を取得する関数（秒）
+		double GetAverageSeconds(uint32_t frameCount) const { return frameCount ? totalSeconds / frameCount : 0.0; }
+	};
+
+	// 実行結果
+	struct SceneBenchmarkReport
+	{
+		// 実行したフレーム数
+		uint32_t frameCount = 0;
+
+		// 処理ごとの処理時間
+		SceneBenchmarkPhaseStats phases[static_cast<int>(SceneBenchmarkPhase::Count)];
+
+		// 全フレームのコマンドの数（エラーの数を含む）
+		NullRenderStats renderStats = {};
+
+		// 全フレームのパケットの数とステートの変更の回数
+		RenderQueueStats queueStats = {};
+
+		// 全フレームのステートの設定の回数
+		StateFilterStats stateStats = {};
+
+		// 全フレームのオクルージョンカリングの計測結果
+		OcclusionCullingStats occlusionStats = {};
+
+		// 全フレームの並列に記録したチャンクの数とコマンドの数
+		uint64_t recordedChunks = 0;
+		uint64_t recordedCommands = 0;
+
+		// パイプラインの遅延と待った時間（パイプラインを使った場合）
+		FramePipelineStats pipelineStats = {};
+
+		// 定数のリングバッファの確保の回数と Map の回数（リングバッファを使った場合）
+		ConstantRingStats constantRingStats = {};
+
+		// 全フレームの定数バッファへ書き込んだ回数とバイト数
+		TreeSceneConstantStats constantStats = {};
+
+		// 最初に見つかったエラーの内容とフレーム番号（エラーがない場合は空文字列）
+		std::string firstError;
+		uint32_t firstErrorFrame = 0;
+	};
+
+	// 合成したシーンのベンチマーク（ウインドウと GPU を使わない）
+	class SceneBenchmark
+	{
+	public:
+
+		// フレームごとの計測結果
+		struct FrameRecord
+		{
+			// 処理ごとの処理時間（秒）
+			double seconds[static_cast<int>(SceneBenchmarkPhase::Count)];
+
+			// 描画の回数・コマンドの数・ステートの設定を省略した回数
+			uint32_t draws;
+			uint32_t commands;
+			uint32_t filtered;
+
+			// 遮蔽物に隠れていた木の数とオクルージョンカリングの処理時間（秒、Submit に含まれる）
+			uint32_t occluded;
+			double occlusionSeconds;
+
+			// 定数バッファへ書き込んだバイト数
+			uint32_t constantBytes;
+		};
+
+		SceneBenchmark();
+
+		/// <summary>
+		/// フレームを実行する関数
+		/// </summary>
+		/// <param name="settings">実行の設定</param>
+		/// <returns>実行結果</returns>
+		const SceneBenchmarkReport& Run(const SceneBenchmarkSettings& settings);
+
+		// 実行結果を取得する関数
+		const SceneBenchmarkReport& GetReport() const { return m_report; }
+
+		// フレームごとの計測結果を取得する関数
+		const std::vector<FrameRecord>& GetFrameRecords() const { return m_frames; }
+
+		/// <summary>
+		/// フレームごとの計測結果を CSV ファイルへ出力する関数（最後の行は平均）
+		/// </summary>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns>成功した場合は true</returns>
+		bool WriteReport(const char* fileName) const;
+
+		// 描画するシーンを取得する関数
+		TreeScene& GetScene() { return m_scene; }
+
+		// 描画先のコンテキストを取得する関数
+		NullRenderContext& GetRenderContext() { return m_renderContext; }
+
+	private:
+
+		// 指定したフレームのカメラとライトを求める関数（パイプラインの場合はワーカーのスレッドで呼ばれる）
+		void UpdateView(uint64_t frame, TreeSceneView* view) const;
+
+	private:
+
+		// コマンドの検証と計測を行うコンテキスト
+		NullRenderContext m_renderContext;
+
+		// ステートの設定を省略するコンテキスト
+		StateFilteredContext<IRenderContext> m_stateContext;
+
+		// レンダーキュー
+		RenderQueue m_renderQueue;
+
+		// パケットを分割して並列に記録する処理と、記録したコマンドを m_renderContext で再生するレコーダー
+		ParallelRenderExecutor m_parallelExecutor;
+		RenderCommandListRecorder m_commandListRecorder;
+
+		// シーンとシーンの描画に使用するダミーのリソース
+		TreeScene m_scene;
+		TreeSceneResources m_resources = {};
+
+		// オブジェクトごとの定数を書き込むリングバッファ
+		ConstantRing m_constantRing;
+
+		// 実行結果
+		SceneBenchmarkReport m_report;
+
+		// フレームごとの計測結果
+		std::vector<FrameRecord> m_frames;
+
+		// 実行中の設定と再生するカメラの経路と射影行列（UpdateView で使用）
+		SceneBenchmarkSettings m_settings;
+		const CameraPath* m_path = nullptr;
+		Math::Matrix m_projection;
+
+		// パイプラインで受け渡すカメラとライトと、更新と描画を重ねるパイプライン
+		TreeSceneView m_pipelineViews[FramePipeline::MAX_DEPTH];
+		FramePipeline m_pipeline;
+	};
+}
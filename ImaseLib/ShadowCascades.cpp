@@ -0,0 +1,293 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ShadowCascades.cpp
+//
+// 平行光源のカスケードシャドウマップ（CPU 側の計算）
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "ShadowCascades.h"
+
+#include <algorithm>
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	// カリング用のカスケードの範囲（ライト空間）
+	struct CascadeBounds
+	{
+		float minX, maxX;
+		float minY, maxY;
+		float minZ, maxZ;
+	};
+
+	// ライト空間の座標（ライトのビュー行列の x, y, z 軸）
+	struct LightAxes
+	{
+		Vector3 x, y, z;
+	};
+
+	inline LightAxes GetLightAxes(const Matrix& lightView)
+	{
+		LightAxes axes;
+		axes.x = Vector3(lightView.m[0][0], lightView.m[1][0], lightView.m[2][0]);
+		axes.y = Vector3(lightView.m[0][1], lightView.m[1][1], lightView.m[2][1]);
+		axes.z = Vector3(lightView.m[0][2], lightView.m[1][2], lightView.m[2][2]);
+		return axes;
+	}
+
+	// １個分の判定（ビットが 1 ならそのカスケードに影を落とす）
+	inline uint32_t TestCaster(const LightAxes& axes, const CascadeBounds* bounds, int cascadeCount,
+		float cx, float cy, float cz, float r)
+	{
+		float lx = cx * axes.x.x + cy * axes.x.y + cz * axes.x.z;
+		float ly = cx * axes.y.x + cy * axes.y.y + cz * axes.y.z;
+		float lz = cx * axes.z.x + cy * axes.z.y + cz * axes.z.z;
+
+		uint32_t mask = 0;
+		for (int c = 0; c < cascadeCount; c++)
+		{
+			const CascadeBounds& b = bounds[c];
+			if (lx + r >= b.minX && lx - r <= b.maxX &&
+				ly + r >= b.minY && ly - r <= b.maxY &&
+				lz + r >= b.minZ && lz - r <= b.maxZ)
+			{
+				mask |= 1u << c;
+			}
+		}
+		return mask;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 分割位置の計算
+//--------------------------------------------------------------------------------------
+void Imase::ComputeCascadeSplits(float nearPlane, float farPlane, int count, float lambda, float* splits)
+{
+	for (int i = 1; i <= count; i++)
+	{
+		float t = static_cast<float>(i) / static_cast<float>(count);
+
+		// 対数分割と均等分割を混ぜる
+		float logSplit = nearPlane * std::pow(farPlane / nearPlane, t);
+		float uniformSplit = nearPlane + (farPlane - nearPlane) * t;
+		splits[i - 1] = lambda * logSplit + (1.0f - lambda) * uniformSplit;
+	}
+
+	// 誤差で最後がファーからずれないようにする
+	splits[count - 1] = farPlane;
+}
+
+//--------------------------------------------------------------------------------------
+// カスケードの計算
+//--------------------------------------------------------------------------------------
+ShadowCascades Imase::ComputeShadowCascades(
+	const Matrix& view,
+	float fovY,
+	float aspectRatio,
+	float nearPlane,
+	float farPlane,
+	const Vector3& lightDirection,
+	const ShadowCascadeSettings& settings)
+{
+	ShadowCascades result;
+	result.count = std::min(std::max(settings.cascadeCount, 1), MAX_SHADOW_CASCADES);
+	result.lightDirection = lightDirection.Normalized();
+
+	// ライトのビュー行列（回転のみ、ライトの方向が真上・真下に近い場合は上方向を変える）
+	Vector3 up = std::fabs(result.lightDirection.y) > 0.99f ? Vector3::UnitZ() : Vector3::UnitY();
+	result.lightView = Matrix::CreateLookAt(Vector3::Zero(), result.lightDirection, up);
+
+	// カメラの位置と向き
+	Matrix invView = view.InvertOrthonormal();
+	Vector3 eye = invView.Translation();
+	Vector3 forward = -invView.Backward();
+
+	// 分割位置
+	float shadowFar = std::min(farPlane, settings.maxShadowDistance);
+	float splits[MAX_SHADOW_CASCADES];
+	ComputeCascadeSplits(nearPlane, shadowFar, result.count, settings.splitLambda, splits);
+
+	// 視錐台の中心軸からの広がり（四隅の方向の tan の２乗）
+	float tanHalfFov = std::tan(fovY * 0.5f);
+	float k = tanHalfFov * tanHalfFov * (1.0f + aspectRatio * aspectRatio);
+
+	float splitNear = nearPlane;
+	for (int i = 0; i < result.count; i++)
+	{
+		ShadowCascade& cascade = result.cascades[i];
+		float n = splitNear;
+		float f = splits[i];
+
+		// 分割した視錐台を囲む最小の球（中心は視線上）
+		// カメラの向きに関係なく半径が一定なので、回転しても正射影の大きさが変わらない
+		float c = 0.5f * (f + n) * (1.0f + k);
+		float radius;
+		if (c >= f)
+		{
+			c = f;
+			radius = f * std::sqrt(k);
+		}
+		else
+		{
+			radius = std::sqrt((f - c) * (f - c) + f * f * k);
+		}
+
+		// ライト空間での中心をテクセル単位に合わせる（移動した時のちらつき防止）
+		Vector3 center = result.lightView.TransformPoint(eye + forward * c);
+		float texelSize = 2.0f * radius / static_cast<float>(settings.shadowMapSize);
+		center.x = std::floor(center.x / texelSize) * texelSize;
+		center.y = std::floor(center.y / texelSize) * texelSize;
+
+		// ライト空間は -Z 方向が奥（ライトの進む向き）なので、ライト側へ延ばすのはニア側
+		float depth = -center.z;
+		cascade.depthNear = depth - radius - settings.casterExtension;
+		cascade.depthFar = depth + radius;
+		cascade.projection = Matrix::CreateOrthographicOffCenter(
+			center.x - radius, center.x + radius,
+			center.y - radius, center.y + radius,
+			cascade.depthNear, cascade.depthFar);
+
+		cascade.viewProjection = Matrix::Multiply(result.lightView, cascade.projection);
+		cascade.center = center;
+		cascade.radius = radius;
+		cascade.texelSize = texelSize;
+		cascade.splitNear = n;
+		cascade.splitFar = f;
+
+		splitNear = f;
+	}
+
+	return result;
+}
+
+//--------------------------------------------------------------------------------------
+// シェーダーへ渡す定数の書き込み
+//--------------------------------------------------------------------------------------
+void Imase::WriteShadowConstants(const ShadowCascades& cascades, ShadowConstants* constants)
+{
+	for (int i = 0; i < MAX_SHADOW_CASCADES; i++)
+	{
+		// 使用しないカスケードは最後のカスケードと同じにしておく
+		const ShadowCascade& cascade = cascades.cascades[std::min(i, cascades.count - 1)];
+		constants->lightViewProjection[i] = cascade.viewProjection.Transpose();
+		constants->splitDistances[i] = cascade.splitFar;
+		constants->texelSizes[i] = cascade.texelSize;
+	}
+	constants->cascadeCount = static_cast<uint32_t>(cascades.count);
+	constants->padding[0] = constants->padding[1] = constants->padding[2] = 0.0f;
+}
+
+//--------------------------------------------------------------------------------------
+// 影を落とすオブジェクトのカリング
+//--------------------------------------------------------------------------------------
+size_t Imase::CullShadowCasters(
+	const ShadowCascades& cascades,
+	const SphereArrays& spheres,
+	size_t count,
+	uint8_t* cascadeMasks,
+	uint32_t* const* casterIndices,
+	size_t* casterCounts)
+{
+	// カスケードごとの範囲（ライト空間の Z はライト側が大きい）
+	CascadeBounds bounds[MAX_SHADOW_CASCADES];
+	for (int c = 0; c < cascades.count; c++)
+	{
+		const ShadowCascade& cascade = cascades.cascades[c];
+		bounds[c].minX = cascade.center.x - cascade.radius;
+		bounds[c].maxX = cascade.center.x + cascade.radius;
+		bounds[c].minY = cascade.center.y - cascade.radius;
+		bounds[c].maxY = cascade.center.y + cascade.radius;
+		bounds[c].minZ = -cascade.depthFar;
+		bounds[c].maxZ = -cascade.depthNear;
+	}
+
+	LightAxes axes = GetLightAxes(cascades.lightView);
+
+	size_t counts[MAX_SHADOW_CASCADES] = {};
+	size_t casterCount = 0;
+
+	size_t i = 0;
+
+#if defined(IMASE_MATH_SSE2)
+	// ４個ずつ判定する
+	const __m128 axX = _mm_set1_ps(axes.x.x), axY = _mm_set1_ps(axes.x.y), axZ = _mm_set1_ps(axes.x.z);
+	const __m128 ayX = _mm_set1_ps(axes.y.x), ayY = _mm_set1_ps(axes.y.y), ayZ = _mm_set1_ps(axes.y.z);
+	const __m128 azX = _mm_set1_ps(axes.z.x), azY = _mm_set1_ps(axes.z.y), azZ = _mm_set1_ps(axes.z.z);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 cx = _mm_loadu_ps(spheres.centerX + i);
+		__m128 cy = _mm_loadu_ps(spheres.centerY + i);
+		__m128 cz = _mm_loadu_ps(spheres.centerZ + i);
+		__m128 r = _mm_loadu_ps(spheres.radius + i);
+
+		// ライト空間へ変換する
+		__m128 lx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, axX), _mm_mul_ps(cy, axY)), _mm_mul_ps(cz, axZ));
+		__m128 ly = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, ayX), _mm_mul_ps(cy, ayY)), _mm_mul_ps(cz, ayZ));
+		__m128 lz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, azX), _mm_mul_ps(cy, azY)), _mm_mul_ps(cz, azZ));
+
+		__m128 lxMin = _mm_sub_ps(lx, r), lxMax = _mm_add_ps(lx, r);
+		__m128 lyMin = _mm_sub_ps(ly, r), lyMax = _mm_add_ps(ly, r);
+		__m128 lzMin = _mm_sub_ps(lz, r), lzMax = _mm_add_ps(lz, r);
+
+		// カスケードごとのビットマスク（４個分）
+		uint32_t masks[MAX_SHADOW_CASCADES];
+		uint32_t any = 0;
+		for (int c = 0; c < cascades.count; c++)
+		{
+			const CascadeBounds& b = bounds[c];
+			__m128 in = _mm_and_ps(_mm_cmpge_ps(lxMax, _mm_set1_ps(b.minX)), _mm_cmple_ps(lxMin, _mm_set1_ps(b.maxX)));
+			in = _mm_and_ps(in, _mm_and_ps(_mm_cmpge_ps(lyMax, _mm_set1_ps(b.minY)), _mm_cmple_ps(lyMin, _mm_set1_ps(b.maxY))));
+			in = _mm_and_ps(in, _mm_and_ps(_mm_cmpge_ps(lzMax, _mm_set1_ps(b.minZ)), _mm_cmple_ps(lzMin, _mm_set1_ps(b.maxZ))));
+			masks[c] = static_cast<uint32_t>(_mm_movemask_ps(in));
+			any |= masks[c];
+		}
+		if (!any && !cascadeMasks) continue;
+
+		for (int j = 0; j < 4; j++)
+		{
+			uint32_t objectMask = 0;
+			for (int c = 0; c < cascades.count; c++)
+			{
+				if (masks[c] & (1u << j))
+				{
+					objectMask |= 1u << c;
+					if (casterIndices) casterIndices[c][counts[c]] = static_cast<uint32_t>(i + j);
+					counts[c]++;
+				}
+			}
+			if (cascadeMasks) cascadeMasks[i + j] = static_cast<uint8_t>(objectMask);
+			if (objectMask) casterCount++;
+		}
+	}
+#endif
+
+	// 残り
+	for (; i < count; i++)
+	{
+		uint32_t objectMask = TestCaster(axes, bounds, cascades.count,
+			spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i], spheres.radius[i]);
+		for (int c = 0; c < cascades.count; c++)
+		{
+			if (objectMask & (1u << c))
+			{
+				if (casterIndices) casterIndices[c][counts[c]] = static_cast<uint32_t>(i);
+				counts[c]++;
+			}
+		}
+		if (cascadeMasks) cascadeMasks[i] = static_cast<uint8_t>(objectMask);
+		if (objectMask) casterCount++;
+	}
+
+	if (casterCounts)
+	{
+		for (int c = 0; c < cascades.count; c++) casterCounts[c] = counts[c];
+	}
+
+	return casterCount;
+}
@@ -0,0 +1,175 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ShadowCascades.h
+//
+// 平行光源のカスケードシャドウマップ（CPU 側の計算）
+//
+// Usage: カメラの視錐台をニア～ファーの間で分割（Practical Split Scheme）し、
+//        カスケードごとにライト空間の正射影行列を作成します。
+//        正射影の範囲は分割した視錐台を囲む球から求め、テクセル単位に合わせるので、
+//        カメラが回転・移動してもシャドウマップの縁がちらつきません。
+//        影を落とすオブジェクトのカリングは、バウンディングスフィアの配列を
+//        １回走査するだけで全カスケード分を判定します。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	Imase::ShadowCascades cascades = Imase::ComputeShadowCascades(
+//		view, fovY, aspectRatio, NEAR_PLANE, FAR_PLANE, lightDir, settings);
+//
+//	Imase::ShadowConstants constants;
+//	Imase::WriteShadowConstants(cascades, &constants);	// 定数バッファへコピーする
+//
+//	Imase::CullShadowCasters(cascades, spheres, count, nullptr, casterIndices, casterCounts);
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MathCore.h"
+#include "FrustumCulling.h"
+
+namespace Imase
+{
+	// カスケードの最大数
+	constexpr int MAX_SHADOW_CASCADES = 4;
+
+	// カスケードシャドウの設定
+	struct ShadowCascadeSettings
+	{
+		// カスケードの数（1 ～ MAX_SHADOW_CASCADES）
+		int cascadeCount = MAX_SHADOW_CASCADES;
+
+		// 対数分割と均等分割の割合（1 で対数分割、0 で均等分割）
+		float splitLambda = 0.75f;
+
+		// シャドウマップの解像度（テクセル単位に合わせるのに使用）
+		uint32_t shadowMapSize = 2048;
+
+		// 影を描画する最大距離（ファーが無限遠の場合や遠すぎる場合に制限する）
+		float maxShadowDistance = 100.0f;
+
+		// カスケードの範囲よりライト側にある物体も影を落とせるように奥行きを延ばす距離
+		float casterExtension = 50.0f;
+	};
+
+	// カスケード
+	struct ShadowCascade
+	{
+		// 分割した視錐台の範囲（カメラからの距離）
+		float splitNear;
+		float splitFar;
+
+		// ライト空間（ライトのビュー行列で変換した空間）での範囲の中心（テクセル単位に合わせ済み）
+		Math::Vector3 center;
+
+		// 範囲の半径
+		float radius;
+
+		// 正射影のニア・ファー（ライト空間の -Z 方向の距離）
+		float depthNear;
+		float depthFar;
+
+		// テクセルのワールド空間での大きさ
+		float texelSize;
+
+		// 正射影行列
+		Math::Matrix projection;
+
+		// ライトのビュー行列×正射影行列
+		Math::Matrix viewProjection;
+	};
+
+	// カスケードシャドウの計算結果
+	struct ShadowCascades
+	{
+		// カスケードの数
+		int count;
+
+		// ライトの方向（正規化済み）
+		Math::Vector3 lightDirection;
+
+		// ライトのビュー行列（回転のみ、全カスケード共通）
+		Math::Matrix lightView;
+
+		// カスケード
+		ShadowCascade cascades[MAX_SHADOW_CASCADES];
+	};
+
+	// シェーダーへ渡す定数（そのまま定数バッファへコピーできる配置）
+	struct ShadowConstants
+	{
+		// ライトのビュー行列×正射影行列（シェーダーへ渡すため転置済み）
+		Math::Matrix lightViewProjection[MAX_SHADOW_CASCADES];
+
+		// 各カスケードの奥の距離（カメラからの距離、ピクセルシェーダーでカスケードの選択に使用）
+		float splitDistances[MAX_SHADOW_CASCADES];
+
+		// 各カスケードのテクセルのワールド空間での大きさ（デプスバイアスの調整に使用）
+		float texelSizes[MAX_SHADOW_CASCADES];
+
+		// カスケードの数
+		uint32_t cascadeCount;
+
+		float padding[3];
+	};
+
+	static_assert(sizeof(ShadowConstants) % 16 == 0, "ShadowConstants must be a multiple of 16 bytes");
+
+	/// <summary>
+	/// 視錐台の分割位置を求める関数（Practical Split Scheme）
+	/// </summary>
+	/// <param name="nearPlane">ニアクリップ</param>
+	/// <param name="farPlane">ファークリップ</param>
+	/// <param name="count">分割数</param>
+	/// <param name="lambda">対数分割と均等分割の割合</param>
+	/// <param name="splits">各カスケードの奥の距離の出力先（count 個）</param>
+	void ComputeCascadeSplits(float nearPlane, float farPlane, int count, float lambda, float* splits);
+
+	/// <summary>
+	/// カスケードシャドウの行列を計算する関数
+	/// </summary>
+	/// <param name="view">カメラのビュー行列</param>
+	/// <param name="fovY">カメラの縦方向の視野角（ラジアン）</param>
+	/// <param name="aspectRatio">カメラのアスペクト比</param>
+	/// <param name="nearPlane">カメラのニアクリップ</param>
+	/// <param name="farPlane">カメラのファークリップ（無限遠の場合は maxShadowDistance まで）</param>
+	/// <param name="lightDirection">ライトの方向（光が進む向き）</param>
+	/// <param name="settings">設定</param>
+	/// <returns>計算結果</returns>
+	ShadowCascades ComputeShadowCascades(
+		const Math::Matrix& view,
+		float fovY,
+		float aspectRatio,
+		float nearPlane,
+		float farPlane,
+		const Math::Vector3& lightDirection,
+		const ShadowCascadeSettings& settings);
+
+	/// <summary>
+	/// シェーダーへ渡す定数を書き込む関数
+	/// </summary>
+	/// <param name="cascades">カスケードシャドウの計算結果</param>
+	/// <param name="constants">出力先</param>
+	void WriteShadowConstants(const ShadowCascades& cascades, ShadowConstants* constants);
+
+	/// <summary>
+	/// 影を落とすオブジェクトのカリング（全カスケードを１回の走査で判定）
+	/// </summary>
+	/// <param name="cascades">カスケードシャドウの計算結果</param>
+	/// <param name="spheres">バウンディングスフィアの配列</param>
+	/// <param name="count">数</param>
+	/// <param name="cascadeMasks">オブジェクトごとの影を落とすカスケードのビットの出力先（不要な場合は nullptr）</param>
+	/// <param name="casterIndices">カスケードごとの影を落とすオブジェクトの番号の出力先（各 count 個分、不要な場合は nullptr）</param>
+	/// <param name="casterCounts">カスケードごとの影を落とすオブジェクトの数の出力先（不要な場合は nullptr）</param>
+	/// <returns>いずれかのカスケードに影を落とすオブジェクトの数</returns>
+	size_t CullShadowCasters(
+		const ShadowCascades& cascades,
+		const SphereArrays& spheres,
+		size_t count,
+		uint8_t* cascadeMasks,
+		uint32_t* const* casterIndices,
+		size_t* casterCounts);
+}
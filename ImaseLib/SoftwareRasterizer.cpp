@@ -0,0 +1,849 @@
+﻿//--------------------------------------------------------------------------------------
+// File: SoftwareRasterizer.cpp
+//
+// GPU を使わずに VertexShader.hlsl / PixelShader.hlsl と同じ描画を行うソフトウェアラスタライザー
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "SoftwareRasterizer.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+using namespace Imase;
+
+namespace
+{
+	// サブピクセルの数とピクセルの中心
+	constexpr int32_t SUBPIXELS = 1 << SoftwareRasterizer::SUBPIXEL_BITS;
+	constexpr int32_t HALF_PIXEL = SUBPIXELS / 2;
+
+	// 頂点の位置を丸める画面の範囲（ピクセル、ガードバンド）
+	// （この範囲で辺の式の係数が 32 ビットに収まり、タイルの中の変化量も 2^30 未満になる）
+	constexpr float GUARD_BAND = 8192.0f;
+
+	// タイルの左上の辺の式の値の上限
+	// （これより大きい値は三角形の内側・外側が変わらないので丸め、タイルの中は 32 ビットで計算する）
+	constexpr int64_t EDGE_CLAMP = int64_t(1) << 30;
+
+	// クリッピングの平面の数と、切り取った後の頂点の最大数
+	constexpr int CLIP_PLANE_COUNT = 6;
+	constexpr int MAX_CLIP_VERTICES = 3 + CLIP_PLANE_COUNT;
+
+	// 補間する値の番号
+	constexpr int INTERPOLANT_INV_W = 0;
+	constexpr int INTERPOLANT_DEPTH = 1;
+	constexpr int INTERPOLANT_ATTRIBUTES = 2;
+
+	// R8G8B8A8 を 0～1 の値へ変換する関数
+	inline Math::Vector4 UnpackColor(uint32_t c)
+	{
+		constexpr float s = 1.0f / 255.0f;
+		return Math::Vector4(
+			static_cast<float>(c & 0xff) * s,
+			static_cast<float>((c >> 8) & 0xff) * s,
+			static_cast<float>((c >> 16) & 0xff) * s,
+			static_cast<float>(c >> 24) * s);
+	}
+
+	// 0～1 の値を R8G8B8A8 へ変換する関数（UNORM の変換と同じく最も近い値に丸める）
+	inline uint32_t PackColor(const Math::Vector4& c)
+	{
+		auto unorm = [](float v)
+		{
+			v = std::min(std::max(v, 0.0f), 1.0f);
+			return static_cast<uint32_t>(v * 255.0f + 0.5f);
+		};
+		return unorm(c.x) | (unorm(c.y) << 8) | (unorm(c.z) << 16) | (unorm(c.w) << 24);
+	}
+
+	// 線形補間
+	inline Math::Vector4 Lerp(const Math::Vector4& a, const Math::Vector4& b, float t)
+	{
+		return a + (b - a) * t;
+	}
+
+	// 負の数にも対応した剰余
+	inline int32_t Wrap(int32_t i, int32_t n)
+	{
+		int32_t r = i % n;
+		return r < 0 ? r + n : r;
+	}
+
+	//----------------------------------------------------------------------------------
+	// ４ピクセル分の辺の式（SIMD）
+	//----------------------------------------------------------------------------------
+#if defined(IMASE_MATH_SSE2)
+	using EdgeVector = __m128i;
+
+	// 左端の値と１ピクセルの変化量から４ピクセル分の値を作る関数
+	inline EdgeVector EdgeSet(int32_t e, int32_t step) { return _mm_setr_epi32(e, e + step, e + step * 2, e + step * 3); }
+
+	// 全てのピクセルに同じ値を足す関数
+	inline EdgeVector EdgeAdd(EdgeVector e, EdgeVector step) { return _mm_add_epi32(e, step); }
+	inline EdgeVector EdgeSplat(int32_t v) { return _mm_set1_epi32(v); }
+
+	// ３つの辺の式が全て 0 以上のピクセルのマスクを求める関数（ビット i がピクセル i）
+	inline int EdgeCoverage(EdgeVector e0, EdgeVector e1, EdgeVector e2)
+	{
+		__m128i any = _mm_or_si128(_mm_or_si128(e0, e1), e2);
+		return ~_mm_movemask_ps(_mm_castsi128_ps(any)) & 0xf;
+	}
+#elif defined(IMASE_MATH_NEON)
+	using EdgeVector = int32x4_t;
+
+	inline EdgeVector EdgeSet(int32_t e, int32_t step)
+	{
+		const int32_t values[4] = { e, e + step, e + step * 2, e + step * 3 };
+		return vld1q_s32(values);
+	}
+
+	inline EdgeVector EdgeAdd(EdgeVector e, EdgeVector step) { return vaddq_s32(e, step); }
+	inline EdgeVector EdgeSplat(int32_t v) { return vdupq_n_s32(v); }
+
+	inline int EdgeCoverage(EdgeVector e0, EdgeVector e1, EdgeVector e2)
+	{
+		uint32x4_t sign = vshrq_n_u32(vreinterpretq_u32_s32(vorrq_s32(vorrq_s32(e0, e1), e2)), 31);
+		int mask = static_cast<int>(vgetq_lane_u32(sign, 0))
+			| static_cast<int>(vgetq_lane_u32(sign, 1) << 1)
+			| static_cast<int>(vgetq_lane_u32(sign, 2) << 2)
+			| static_cast<int>(vgetq_lane_u32(sign, 3) << 3);
+		return ~mask & 0xf;
+	}
+#else
+	struct EdgeVector { int32_t v[4]; };
+
+	inline EdgeVector EdgeSet(int32_t e, int32_t step) { return { { e, e + step, e + step * 2, e + step * 3 } }; }
+
+	inline EdgeVector EdgeAdd(EdgeVector e, EdgeVector step)
+	{
+		for (int i = 0; i < 4; i++) e.v[i] += step.v[i];
+		return e;
+	}
+
+	inline EdgeVector EdgeSplat(int32_t v) { return { { v, v, v, v } }; }
+
+	inline int EdgeCoverage(EdgeVector e0, EdgeVector e1, EdgeVector e2)
+	{
+		int mask = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if ((e0.v[i] | e1.v[i] | e2.v[i]) >= 0) mask |= 1 << i;
+		}
+		return mask;
+	}
+#endif
+}
+
+//--------------------------------------------------------------------------------------
+// テクスチャを作成する関数
+//--------------------------------------------------------------------------------------
+bool SoftwareTexture::Create(uint32_t width, uint32_t height, const uint32_t* pixels, bool generateMips)
+{
+	m_levels.clear();
+	if (width == 0 || height == 0 || !pixels) return false;
+
+	Level top;
+	top.width = width;
+	top.height = height;
+	top.texels.resize(size_t(width) * height);
+	for (size_t i = 0; i < top.texels.size(); i++)
+	{
+		top.texels[i] = UnpackColor(pixels[i]);
+	}
+	m_levels.push_back(std::move(top));
+
+	// ２×２の平均で 1×1 まで縮小する（乗算済みアルファなので色をそのまま平均できる）
+	while (generateMips)
+	{
+		const Level& src = m_levels.back();
+		if (src.width == 1 && src.height == 1) break;
+
+		Level dst;
+		dst.width = std::max(src.width / 2, 1u);
+		dst.height = std::max(src.height / 2, 1u);
+		dst.texels.resize(size_t(dst.width) * dst.height);
+
+		for (uint32_t y = 0; y < dst.height; y++)
+		{
+			uint32_t y0 = std::min(y * 2, src.height - 1);
+			uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+			for (uint32_t x = 0; x < dst.width; x++)
+			{
+				uint32_t x0 = std::min(x * 2, src.width - 1);
+				uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+				Math::Vector4 sum = src.texels[y0 * src.width + x0] + src.texels[y0 * src.width + x1]
+					+ src.texels[y1 * src.width + x0] + src.texels[y1 * src.width + x1];
+				dst.texels[y * dst.width + x] = sum * 0.25f;
+			}
+		}
+
+		m_levels.push_back(std::move(dst));
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// サンプリングする関数
+//--------------------------------------------------------------------------------------
+Math::Vector4 SoftwareTexture::Sample(float u, float v, float lod) const
+{
+	if (m_levels.empty()) return Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+
+	// 拡大する場合は一番大きいミップマップ、縮小する場合は隣り合う２枚を補間する
+	float maxLevel = static_cast<float>(m_levels.size() - 1);
+	lod = std::min(std::max(lod, 0.0f), maxLevel);
+
+	int level = static_cast<int>(lod);
+	float t = lod - static_cast<float>(level);
+
+	Math::Vector4 c0 = SampleLevel(m_levels[level], u, v);
+	if (t == 0.0f) return c0;
+
+	return Lerp(c0, SampleLevel(m_levels[level + 1], u, v), t);
+}
+
+//--------------------------------------------------------------------------------------
+// バイリニアでサンプリングする関数
+//--------------------------------------------------------------------------------------
+Math::Vector4 SoftwareTexture::SampleLevel(const Level& level, float u, float v) const
+{
+	int32_t w = static_cast<int32_t>(level.width);
+	int32_t h = static_cast<int32_t>(level.height);
+
+	// テクセルの中心が整数になる座標
+	float x = u * static_cast<float>(w) - 0.5f;
+	float y = v * static_cast<float>(h) - 0.5f;
+	float fx = floorf(x);
+	float fy = floorf(y);
+	float tx = x - fx;
+	float ty = y - fy;
+
+	// WRAP
+	int32_t x0 = Wrap(static_cast<int32_t>(fx), w);
+	int32_t y0 = Wrap(static_cast<int32_t>(fy), h);
+	int32_t x1 = x0 + 1 < w ? x0 + 1 : 0;
+	int32_t y1 = y0 + 1 < h ? y0 + 1 : 0;
+
+	const Math::Vector4* row0 = &level.texels[size_t(y0) * w];
+	const Math::Vector4* row1 = &level.texels[size_t(y1) * w];
+
+	return Lerp(Lerp(row0[x0], row0[x1], tx), Lerp(row1[x0], row1[x1], tx), ty);
+}
+
+//--------------------------------------------------------------------------------------
+// コンストラクタ
+//--------------------------------------------------------------------------------------
+SoftwareRasterizer::SoftwareRasterizer()
+{
+	m_constants.lightDirection = Math::Vector3(0.0f, 0.0f, -1.0f);
+}
+
+//--------------------------------------------------------------------------------------
+// 描画先の大きさを設定する関数
+//--------------------------------------------------------------------------------------
+bool SoftwareRasterizer::Resize(uint32_t width, uint32_t height)
+{
+	if (width == 0 || height == 0 || width > MAX_TARGET_SIZE || height > MAX_TARGET_SIZE) return false;
+
+	m_width = width;
+	m_height = height;
+	m_tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+	m_tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+	m_colorBuffer.assign(size_t(width) * height, 0);
+	m_depthBuffer.assign(size_t(width) * height, 1.0f);
+	m_bins.assign(size_t(m_tilesX) * m_tilesY, std::vector<uint32_t>());
+	m_tileShadedPixels.assign(m_bins.size(), 0);
+
+	m_triangles.clear();
+	m_draws.clear();
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// カラーバッファと深度バッファをクリアする関数
+//--------------------------------------------------------------------------------------
+void SoftwareRasterizer::Clear(const float color[4], float depth)
+{
+	uint32_t packed = PackColor(Math::Vector4(color[0], color[1], color[2], color[3]));
+	std::fill(m_colorBuffer.begin(), m_colorBuffer.end(), packed);
+	std::fill(m_depthBuffer.begin(), m_depthBuffer.end(), depth);
+}
+
+//--------------------------------------------------------------------------------------
+// インデックス付きの三角形リストを描画する関数
+//--------------------------------------------------------------------------------------
+void SoftwareRasterizer::DrawIndexed(const SoftwareVertex* vertices, size_t vertexCount, const uint16_t* indices, size_t indexCount)
+{
+	if (m_width == 0) return;
+
+	uint32_t draw = static_cast<uint32_t>(m_draws.size());
+	m_draws.push_back({ m_state, m_texture });
+
+	// ----- 頂点シェーダー（VertexShader.hlsl） ----- //
+
+	const Math::Matrix& m = m_constants.worldViewProjection;
+	Math::Vector3 toLight = -m_constants.lightDirection;
+
+	m_clipVertices.resize(vertexCount);
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		const SoftwareVertex& in = vertices[i];
+		ClipVertex& out = m_clipVertices[i];
+
+		// mul(float4(position, 1), WorldViewProj)
+		const float* p = in.position;
+		out.position = Math::Vector4(
+			p[0] * m.m[0][0] + p[1] * m.m[1][0] + p[2] * m.m[2][0] + m.m[3][0],
+			p[0] * m.m[0][1] + p[1] * m.m[1][1] + p[2] * m.m[2][1] + m.m[3][1],
+			p[0] * m.m[0][2] + p[1] * m.m[1][2] + p[2] * m.m[2][2] + m.m[3][2],
+			p[0] * m.m[0][3] + p[1] * m.m[1][3] + p[2] * m.m[2][3] + m.m[3][3]);
+
+		// ComputeLight（法線はそのまま使う）
+		float dotL = toLight.x * in.normal[0] + toLight.y * in.normal[1] + toLight.z * in.normal[2];
+		float diffuse = dotL >= 0.0f ? dotL : 0.0f;
+
+		out.attributes[0] = diffuse;
+		out.attributes[1] = diffuse;
+		out.attributes[2] = diffuse;
+		out.attributes[3] = 1.0f;
+		out.attributes[4] = in.textureCoordinate[0];
+		out.attributes[5] = in.textureCoordinate[1];
+	}
+
+	// ----- クリッピング ----- //
+
+	// ガードバンドの範囲（NDC）
+	float guardX = 2.0f * GUARD_BAND / static_cast<float>(m_width) - 1.0f;
+	float guardY = 2.0f * GUARD_BAND / static_cast<float>(m_height) - 1.0f;
+
+	const Math::Vector4 planes[CLIP_PLANE_COUNT] =
+	{
+		Math::Vector4(0.0f, 0.0f, 1.0f, 0.0f),		// z >= 0
+		Math::Vector4(0.0f, 0.0f, -1.0f, 1.0f),		// z <= w
+		Math::Vector4(1.0f, 0.0f, 0.0f, guardX),	// x >= -guardX * w
+		Math::Vector4(-1.0f, 0.0f, 0.0f, guardX),	// x <= guardX * w
+		Math::Vector4(0.0f, 1.0f, 0.0f, guardY),	// y >= -guardY * w
+		Math::Vector4(0.0f, -1.0f, 0.0f, guardY),	// y <= guardY * w
+	};
+
+	for (size_t i = 0; i + 2 < indexCount; i += 3)
+	{
+		m_stats.triangles++;
+
+		if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount)
+		{
+			m_stats.culledTriangles++;
+			continue;
+		}
+
+		const ClipVertex* v[3] = { &m_clipVertices[indices[i]], &m_clipVertices[indices[i + 1]], &m_clipVertices[indices[i + 2]] };
+
+		// 全ての頂点が１つの平面の外側にあれば描画しない、全て内側にあれば切り取る必要はない
+		int outsideAll = (1 << CLIP_PLANE_COUNT) - 1;
+		int outsideAny = 0;
+		for (int k = 0; k < 3; k++)
+		{
+			int outside = 0;
+			for (int p = 0; p < CLIP_PLANE_COUNT; p++)
+			{
+				if (planes[p].Dot(v[k]->position) < 0.0f) outside |= 1 << p;
+			}
+			outsideAll &= outside;
+			outsideAny |= outside;
+		}
+		if (outsideAll)
+		{
+			m_stats.culledTriangles++;
+			continue;
+		}
+		if (!outsideAny)
+		{
+			SetupTriangle(*v[0], *v[1], *v[2], draw);
+			continue;
+		}
+
+		// 外側にはみ出た平面だけで切り取る
+		ClipVertex polygon[2][MAX_CLIP_VERTICES];
+		int count = 3;
+		for (int k = 0; k < 3; k++) polygon[0][k] = *v[k];
+
+		int current = 0;
+		for (int p = 0; p < CLIP_PLANE_COUNT && count >= 3; p++)
+		{
+			if (!(outsideAny & (1 << p))) continue;
+			count = ClipPolygon(polygon[current], count, planes[p], polygon[current ^ 1]);
+			current ^= 1;
+		}
+
+		if (count < 3)
+		{
+			m_stats.culledTriangles++;
+			continue;
+		}
+
+		// 扇形に三角形へ分ける
+		for (int k = 1; k + 1 < count; k++)
+		{
+			SetupTriangle(polygon[current][0], polygon[current][k], polygon[current][k + 1], draw);
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 多角形を平面の内側で切り取る関数（Sutherland-Hodgman）
+//--------------------------------------------------------------------------------------
+int SoftwareRasterizer::ClipPolygon(const ClipVertex* input, int count, const Math::Vector4& plane, ClipVertex* output)
+{
+	int n = 0;
+	for (int i = 0; i < count; i++)
+	{
+		const ClipVertex& a = input[i];
+		const ClipVertex& b = input[(i + 1) % count];
+		float da = plane.Dot(a.position);
+		float db = plane.Dot(b.position);
+
+		if (da >= 0.0f) output[n++] = a;
+
+		// 辺が平面をまたぐ場合は交点を追加する
+		if ((da >= 0.0f) != (db >= 0.0f))
+		{
+			float t = da / (da - db);
+			ClipVertex& c = output[n++];
+			c.position = Lerp(a.position, b.position, t);
+			for (int k = 0; k < ATTRIBUTE_COUNT; k++)
+			{
+				c.attributes[k] = a.attributes[k] + (b.attributes[k] - a.attributes[k]) * t;
+			}
+		}
+	}
+	return n;
+}
+
+//--------------------------------------------------------------------------------------
+// クリッピング後の三角形をタイルへ振り分ける関数
+//--------------------------------------------------------------------------------------
+void SoftwareRasterizer::SetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, uint32_t draw)
+{
+	const SoftwareRasterizerState& state = m_draws[draw].state;
+	const ClipVertex* v[3] = { &v0, &v1, &v2 };
+
+	// 画面の位置（サブピクセル単位の固定小数点）と補間する値
+	int32_t x[3], y[3];
+	float values[3][INTERPOLANT_COUNT];
+	for (int i = 0; i < 3; i++)
+	{
+		const Math::Vector4& p = v[i]->position;
+		float invW = p.w > 0.0f ? 1.0f / p.w : 0.0f;
+
+		float sx = (p.x * invW + 1.0f) * 0.5f * static_cast<float>(m_width);
+		float sy = (1.0f - p.y * invW) * 0.5f * static_cast<float>(m_height);
+		x[i] = static_cast<int32_t>(lrintf(sx * SUBPIXELS));
+		y[i] = static_cast<int32_t>(lrintf(sy * SUBPIXELS));
+
+		values[i][INTERPOLANT_INV_W] = invW;
+		values[i][INTERPOLANT_DEPTH] = std::min(std::max(p.z * invW, 0.0f), 1.0f);
+		for (int k = 0; k < ATTRIBUTE_COUNT; k++)
+		{
+			values[i][INTERPOLANT_ATTRIBUTES + k] = v[i]->attributes[k] * invW;
+		}
+	}
+
+	// 面積の２倍（画面は y が下向きなので、正の場合は時計回り）
+	int64_t area = int64_t(x[1] - x[0]) * (y[2] - y[0]) - int64_t(x[2] - x[0]) * (y[1] - y[0]);
+	if (area == 0)
+	{
+		m_stats.culledTriangles++;
+		return;
+	}
+
+	// 裏面カリング
+	bool isClockwise = area > 0;
+	bool isFront = state.frontCounterClockwise ? !isClockwise : isClockwise;
+	if ((state.cullMode == SoftwareCullMode::Back && !isFront) || (state.cullMode == SoftwareCullMode::Front && isFront))
+	{
+		m_stats.culledTriangles++;
+		return;
+	}
+
+	// 時計回りにそろえる（辺の式は内側が正になる）
+	int order[3] = { 0, 1, 2 };
+	if (area < 0)
+	{
+		std::swap(order[1], order[2]);
+		area = -area;
+	}
+
+	int32_t px[3], py[3];
+	for (int i = 0; i < 3; i++)
+	{
+		px[i] = x[order[i]];
+		py[i] = y[order[i]];
+	}
+
+	Triangle triangle;
+	triangle.draw = draw;
+
+	// 辺の式（辺 i は頂点 i → i + 1、左上の辺以外は境界のピクセルを含まない）
+	for (int i = 0; i < 3; i++)
+	{
+		int j = (i + 1) % 3;
+		int32_t a = py[i] - py[j];
+		int32_t b = px[j] - px[i];
+		int64_t c = -(int64_t(a) * px[i] + int64_t(b) * py[i]);
+
+		bool isTopLeft = a > 0 || (a == 0 && b > 0);
+		if (!isTopLeft) c -= 1;
+
+		triangle.a[i] = a;
+		triangle.b[i] = b;
+		triangle.c[i] = c;
+	}
+
+	// 外接矩形（画面の範囲に制限する）
+	int32_t minX = std::min({ px[0], px[1], px[2] });
+	int32_t minY = std::min({ py[0], py[1], py[2] });
+	int32_t maxX = std::max({ px[0], px[1], px[2] });
+	int32_t maxY = std::max({ py[0], py[1], py[2] });
+	triangle.minX = std::max((minX - HALF_PIXEL) >> SUBPIXEL_BITS, 0);
+	triangle.minY = std::max((minY - HALF_PIXEL) >> SUBPIXEL_BITS, 0);
+	triangle.maxX = std::min(((maxX - HALF_PIXEL) >> SUBPIXEL_BITS) + 1, static_cast<int32_t>(m_width));
+	triangle.maxY = std::min(((maxY - HALF_PIXEL) >> SUBPIXEL_BITS) + 1, static_cast<int32_t>(m_height));
+	if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY)
+	{
+		m_stats.culledTriangles++;
+		return;
+	}
+
+	// 補間する値の平面の式（頂点０を基準に、重心座標の変化量から求める）
+	// 頂点１の重み = 辺２の式 / 面積、頂点２の重み = 辺０の式 / 面積
+	double scale = static_cast<double>(SUBPIXELS) / static_cast<double>(area);
+	double w1dx = triangle.a[2] * scale, w1dy = triangle.b[2] * scale;
+	double w2dx = triangle.a[0] * scale, w2dy = triangle.b[0] * scale;
+
+	triangle.originX = static_cast<float>(px[0]) / SUBPIXELS;
+	triangle.originY = static_cast<float>(py[0]) / SUBPIXELS;
+	for (int k = 0; k < INTERPOLANT_COUNT; k++)
+	{
+		double f0 = values[order[0]][k];
+		double d1 = values[order[1]][k] - f0;
+		double d2 = values[order[2]][k] - f0;
+		triangle.planes[k][0] = static_cast<float>(f0);
+		triangle.planes[k][1] = static_cast<float>(d1 * w1dx + d2 * w2dx);
+		triangle.planes[k][2] = static_cast<float>(d1 * w1dy + d2 * w2dy);
+	}
+
+	// タイルへ振り分ける
+	uint32_t index = static_cast<uint32_t>(m_triangles.size());
+	m_triangles.push_back(triangle);
+	m_stats.rasterizedTriangles++;
+
+	int32_t tileMinX = triangle.minX / TILE_SIZE;
+	int32_t tileMinY = triangle.minY / TILE_SIZE;
+	int32_t tileMaxX = (triangle.maxX - 1) / TILE_SIZE;
+	int32_t tileMaxY = (triangle.maxY - 1) / TILE_SIZE;
+	for (int32_t ty = tileMinY; ty <= tileMaxY; ty++)
+	{
+		for (int32_t tx = tileMinX; tx <= tileMaxX; tx++)
+		{
+			m_bins[size_t(ty) * m_tilesX + tx].push_back(index);
+			m_stats.binnedTriangles++;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// タイルに振り分けた三角形を塗る関数
+//--------------------------------------------------------------------------------------
+void SoftwareRasterizer::Flush(unsigned int threadCount)
+{
+	if (m_triangles.empty())
+	{
+		m_draws.clear();
+		return;
+	}
+
+	uint32_t tileCount = m_tilesX * m_tilesY;
+
+	if (threadCount == 0)
+	{
+		threadCount = JobSystem::GetDefault().GetWorkerCount();
+	}
+	threadCount = std::max(1u, std::min(threadCount, tileCount));
+
+	// タイルは互いに重ならないので、空いているワーカーが残りのタイルを盗んで塗る
+	// （タイルごとに塗る量が違うので、ワーカー数より細かく分けておく）
+	auto rasterizeTiles = [&](size_t first, size_t last)
+	{
+		for (size_t tile = first; tile < last; tile++)
+		{
+			RasterizeTile(static_cast<uint32_t>(tile));
+		}
+	};
+
+	if (threadCount == 1)
+	{
+		rasterizeTiles(0, tileCount);
+	}
+	else
+	{
+		size_t grain = std::max<size_t>(1, tileCount / (threadCount * 4));
+		JobSystem::GetDefault().ParallelFor(0, tileCount, grain, rasterizeTiles);
+	}
+
+	for (uint32_t tile = 0; tile < tileCount; tile++)
+	{
+		m_stats.shadedPixels += m_tileShadedPixels[tile];
+		m_tileShadedPixels[tile] = 0;
+		m_bins[tile].clear();
+	}
+
+	m_triangles.clear();
+	m_draws.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// タイルを塗る関数
+//--------------------------------------------------------------------------------------
+void SoftwareRasterizer::RasterizeTile(uint32_t tile)
+{
+	int32_t tileX = static_cast<int32_t>(tile % m_tilesX) * TILE_SIZE;
+	int32_t tileY = static_cast<int32_t>(tile / m_tilesX) * TILE_SIZE;
+
+	// 描画した順番に塗る
+	for (uint32_t index : m_bins[tile])
+	{
+		RasterizeTriangle(m_triangles[index], tileX, tileY);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 三角形のタイルの中の部分を塗る関数
+//--------------------------------------------------------------------------------------
+void SoftwareRasterizer::RasterizeTriangle(const Triangle& triangle, int32_t tileX, int32_t tileY)
+{
+	const DrawState& drawState = m_draws[triangle.draw];
+	const SoftwareRasterizerState& state = drawState.state;
+	const SoftwareTexture* texture = drawState.texture;
+
+	// タイルと外接矩形の重なる範囲（横は４ピクセル単位に広げる）
+	int32_t x0 = std::max(triangle.minX, tileX) & ~3;
+	int32_t y0 = std::max(triangle.minY, tileY);
+	int32_t x1 = std::min({ triangle.maxX, tileX + TILE_SIZE, static_cast<int32_t>(m_width) });
+	int32_t y1 = std::min({ triangle.maxY, tileY + TILE_SIZE, static_cast<int32_t>(m_height) });
+	if (x0 >= x1 || y0 >= y1) return;
+
+	// １ピクセル・４ピクセルの変化量
+	EdgeVector step4[3];
+	for (int i = 0; i < 3; i++)
+	{
+		step4[i] = EdgeSplat(triangle.a[i] * SUBPIXELS * 4);
+	}
+
+	float texWidth = texture ? static_cast<float>(texture->GetWidth()) : 0.0f;
+	float texHeight = texture ? static_cast<float>(texture->GetHeight()) : 0.0f;
+
+	const float (*planes)[3] = triangle.planes;
+	uint64_t shaded = 0;
+
+	for (int32_t y = y0; y < y1; y++)
+	{
+		// 行の左端の辺の式（64 ビットで求めて丸め、行の中は 32 ビットで計算する）
+		int64_t sx = int64_t(x0) * SUBPIXELS + HALF_PIXEL;
+		int64_t sy = int64_t(y) * SUBPIXELS + HALF_PIXEL;
+		EdgeVector e[3];
+		for (int i = 0; i < 3; i++)
+		{
+			int64_t value = triangle.a[i] * sx + triangle.b[i] * sy + triangle.c[i];
+			value = std::min(std::max(value, -EDGE_CLAMP), EDGE_CLAMP);
+			e[i] = EdgeSet(static_cast<int32_t>(value), triangle.a[i] * SUBPIXELS);
+		}
+
+		float dy = static_cast<float>(y) + 0.5f - triangle.originY;
+		uint32_t* colorRow = &m_colorBuffer[size_t(y) * m_width];
+		float* depthRow = &m_depthBuffer[size_t(y) * m_width];
+
+		for (int32_t x = x0; x < x1; x += 4)
+		{
+			int mask = EdgeCoverage(e[0], e[1], e[2]);
+			for (int i = 0; i < 3; i++) e[i] = EdgeAdd(e[i], step4[i]);
+
+			// 範囲外のピクセルを除く
+			if (x + 4 > x1) mask &= (1 << (x1 - x)) - 1;
+			if (!mask) continue;
+
+			for (int lane = 0; lane < 4; lane++)
+			{
+				if (!(mask & (1 << lane))) continue;
+
+				int32_t px = x + lane;
+				float dx = static_cast<float>(px) + 0.5f - triangle.originX;
+
+				// 深度テスト
+				float depth = planes[INTERPOLANT_DEPTH][0] + planes[INTERPOLANT_DEPTH][1] * dx + planes[INTERPOLANT_DEPTH][2] * dy;
+				float& dstDepth = depthRow[px];
+				if (state.depthFunc == SoftwareDepthFunc::Less && !(depth < dstDepth)) continue;
+				if (state.depthFunc == SoftwareDepthFunc::Greater && !(depth > dstDepth)) continue;
+				if (state.depthWrite) dstDepth = depth;
+
+				// 透視補正した属性
+				float invW = planes[INTERPOLANT_INV_W][0] + planes[INTERPOLANT_INV_W][1] * dx + planes[INTERPOLANT_INV_W][2] * dy;
+				float w = 1.0f / invW;
+				float attributes[ATTRIBUTE_COUNT];
+				for (int k = 0; k < ATTRIBUTE_COUNT; k++)
+				{
+					const float* plane = planes[INTERPOLANT_ATTRIBUTES + k];
+					attributes[k] = (plane[0] + plane[1] * dx + plane[2] * dy) * w;
+				}
+				Math::Vector4 diffuse(attributes[0], attributes[1], attributes[2], attributes[3]);
+				float u = attributes[4];
+				float v = attributes[5];
+
+				// ピクセルシェーダー（PixelShader.hlsl）
+				Math::Vector4 color = diffuse;
+				if (texture)
+				{
+					// 画面上の１ピクセルあたりのテクスチャ座標の変化量からミップレベルを求める
+					const float* pu = planes[INTERPOLANT_ATTRIBUTES + 4];
+					const float* pv = planes[INTERPOLANT_ATTRIBUTES + 5];
+					const float* pw = planes[INTERPOLANT_INV_W];
+					float dudx = (pu[1] - u * pw[1]) * w * texWidth;
+					float dvdx = (pv[1] - v * pw[1]) * w * texHeight;
+					float dudy = (pu[2] - u * pw[2]) * w * texWidth;
+					float dvdy = (pv[2] - v * pw[2]) * w * texHeight;
+					float rho = std::max(dudx * dudx + dvdx * dvdx, dudy * dudy + dvdy * dvdy);
+					float lod = rho > 0.0f ? 0.5f * log2f(rho) : 0.0f;
+
+					Math::Vector4 texel = texture->Sample(u, v, lod);
+					color = Math::Vector4(texel.x * diffuse.x, texel.y * diffuse.y, texel.z * diffuse.z, texel.w * diffuse.w);
+				}
+
+				// ブレンド
+				if (state.blendMode == SoftwareBlendMode::PremultipliedAlpha)
+				{
+					Math::Vector4 dst = UnpackColor(colorRow[px]);
+					color = color + dst * (1.0f - color.w);
+				}
+				colorRow[px] = PackColor(color);
+				shaded++;
+			}
+		}
+	}
+
+	uint32_t tile = static_cast<uint32_t>(tileY / TILE_SIZE) * m_tilesX + static_cast<uint32_t>(tileX / TILE_SIZE);
+	m_tileShadedPixels[tile] += shaded;
+}
+
+//--------------------------------------------------------------------------------------
+// カラーバッファを TGA ファイルへ保存する関数
+//--------------------------------------------------------------------------------------
+bool SoftwareRasterizer::WriteImage(const char* fileName) const
+{
+	std::ofstream ofs(fileName, std::ios::binary);
+	if (!ofs) return false;
+
+	// 無圧縮のフルカラー、32 ビット、左上が原点
+	uint8_t header[18] = {};
+	header[2] = 2;
+	header[12] = static_cast<uint8_t>(m_width & 0xff);
+	header[13] = static_cast<uint8_t>(m_width >> 8);
+	header[14] = static_cast<uint8_t>(m_height & 0xff);
+	header[15] = static_cast<uint8_t>(m_height >> 8);
+	header[16] = 32;
+	header[17] = 0x28;
+	ofs.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+	// BGRA の順に並べる
+	std::vector<uint8_t> row(size_t(m_width) * 4);
+	for (uint32_t y = 0; y < m_height; y++)
+	{
+		const uint32_t* src = &m_colorBuffer[size_t(y) * m_width];
+		for (uint32_t x = 0; x < m_width; x++)
+		{
+			uint32_t c = src[x];
+			row[x * 4 + 0] = static_cast<uint8_t>(c >> 16);
+			row[x * 4 + 1] = static_cast<uint8_t>(c >> 8);
+			row[x * 4 + 2] = static_cast<uint8_t>(c);
+			row[x * 4 + 3] = static_cast<uint8_t>(c >> 24);
+		}
+		ofs.write(reinterpret_cast<const char*>(row.data()), row.size());
+	}
+
+	return static_cast<bool>(ofs);
+}
+
+//--------------------------------------------------------------------------------------
+// TGA ファイルを読み込む関数
+//--------------------------------------------------------------------------------------
+bool SoftwareRasterizer::ReadImage(const char* fileName, uint32_t* width, uint32_t* height, std::vector<uint32_t>* pixels)
+{
+	std::ifstream ifs(fileName, std::ios::binary);
+	if (!ifs) return false;
+
+	uint8_t header[18];
+	if (!ifs.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+
+	// 無圧縮のフルカラー、32 ビットのみ
+	if (header[1] != 0 || header[2] != 2 || header[16] != 32) return false;
+
+	uint32_t w = header[12] | (header[13] << 8);
+	uint32_t h = header[14] | (header[15] << 8);
+	bool isTopDown = (header[17] & 0x20) != 0;
+	if (w == 0 || h == 0) return false;
+
+	ifs.ignore(header[0]);
+
+	std::vector<uint8_t> data(size_t(w) * h * 4);
+	if (!ifs.read(reinterpret_cast<char*>(data.data()), data.size())) return false;
+
+	pixels->resize(size_t(w) * h);
+	for (uint32_t y = 0; y < h; y++)
+	{
+		const uint8_t* src = &data[size_t(isTopDown ? y : h - 1 - y) * w * 4];
+		uint32_t* dst = &(*pixels)[size_t(y) * w];
+		for (uint32_t x = 0; x < w; x++)
+		{
+			const uint8_t* bgra = src + x * 4;
+			dst[x] = uint32_t(bgra[2]) | (uint32_t(bgra[1]) << 8) | (uint32_t(bgra[0]) << 16) | (uint32_t(bgra[3]) << 24);
+		}
+	}
+
+	*width = w;
+	*height = h;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// ２つの画像を比較する関数
+//--------------------------------------------------------------------------------------
+size_t SoftwareRasterizer::CompareImages(const uint32_t* a, const uint32_t* b, size_t count, int tolerance, int* maxDifference)
+{
+	size_t differentCount = 0;
+	int maxDiff = 0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		int diff = 0;
+		for (int shift = 0; shift < 32; shift += 8)
+		{
+			int ca = static_cast<int>((a[i] >> shift) & 0xff);
+			int cb = static_cast<int>((b[i] >> shift) & 0xff);
+			diff = std::max(diff, std::abs(ca - cb));
+		}
+		if (diff > tolerance) differentCount++;
+		maxDiff = std::max(maxDiff, diff);
+	}
+
+	if (maxDifference) *maxDifference = maxDiff;
+
+	return differentCount;
+}
@@ -0,0 +1,349 @@
+﻿//--------------------------------------------------------------------------------------
+// File: SoftwareRasterizer.h
+//
+// GPU を使わずに VertexShader.hlsl / PixelShader.hlsl と同じ描画を行うソフトウェアラスタライザー
+//
+// Usage: GPU のない環境で、シェーダーの描画結果の確認（ゴールデンイメージとの比較）と
+//        CPU 側の処理時間の計測を行うための参照実装です。
+//        頂点の形式は Header.hlsli の VSInput（Game の頂点バッファと同じ 48 バイト）、
+//        シェーディングは ComputeLight（ランバート）×テクスチャで、乗算済みアルファで
+//        ブレンドします。カリングと深度テストの既定値は Game のラスタライザーステート・
+//        深度ステンシルステートと同じ（裏面カリング、時計回りが表、LESS）です。
+//        テクスチャはバイリニア＋ミップマップ（MIN_MAG_MIP_LINEAR、WRAP）でサンプリングします。
+//        DrawIndexed は頂点の変換・クリッピング・タイルへの振り分けまでを行い、
+//        Flush でタイルごとにジョブシステムのワーカーで塗ります（辺の判定は SIMD で４ピクセルずつ）。
+//        同じタイルの中では描画した順番に塗るので、半透明のポリゴンも GPU と同じ順番で合成されます。
+//        Windows に依存しないので、どの環境でもコンパイル・実行できます。
+//
+//	<<< 記述例 >>
+//	Imase::SoftwareTexture texture;
+//	texture.Create(width, height, pixels);		// R8G8B8A8（乗算済みアルファ）
+//
+//	Imase::SoftwareRasterizer rasterizer;
+//	rasterizer.Resize(1280, 720);
+//	rasterizer.Clear(clearColor, 1.0f);
+//	rasterizer.SetTexture(&texture);
+//	rasterizer.SetConstants(constants);		// ワールド行列×ビュー行列×射影行列（転置しない）
+//	rasterizer.DrawIndexed(vertices, 4, indices, 6);
+//	rasterizer.Flush();
+//	rasterizer.WriteImage("result.tga");
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MathCore.h"
+
+namespace Imase
+{
+	// 頂点（Header.hlsli の VSInput と同じ配置）
+	struct SoftwareVertex
+	{
+		float position[3];
+		float color[4];
+		float textureCoordinate[2];
+		float normal[3];
+	};
+
+	// 定数（Header.hlsli の Parameters と同じ内容、行列は転置しない）
+	struct SoftwareConstants
+	{
+		// ワールド行列×ビュー行列×プロジェクション行列
+		Math::Matrix worldViewProjection;
+
+		// ライトの方向ベクトル
+		Math::Vector3 lightDirection;
+	};
+
+	// カリングの方法（D3D11_CULL_MODE と同じ）
+	enum class SoftwareCullMode
+	{
+		None,
+		Front,
+		Back,
+	};
+
+	// 深度の比較方法
+	enum class SoftwareDepthFunc
+	{
+		Less,			// Standard
+		Greater,		// Reverse-Z
+		Always,
+	};
+
+	// ブレンドの方法
+	enum class SoftwareBlendMode
+	{
+		Opaque,					// 上書き
+		PremultipliedAlpha,		// 乗算済みアルファ（ONE, INV_SRC_ALPHA）
+	};
+
+	// ステート（既定値は Game のラスタライザーステート・深度ステンシルステート・ブレンドステート）
+	struct SoftwareRasterizerState
+	{
+		SoftwareCullMode cullMode = SoftwareCullMode::Back;
+		bool frontCounterClockwise = false;
+		SoftwareDepthFunc depthFunc = SoftwareDepthFunc::Less;
+		bool depthWrite = true;
+		SoftwareBlendMode blendMode = SoftwareBlendMode::PremultipliedAlpha;
+	};
+
+	// 描画の回数
+	struct SoftwareRasterizerStats
+	{
+		// 入力された三角形の数
+		uint32_t triangles;
+
+		// カリング（裏面・面積 0・画面外）された三角形の数
+		uint32_t culledTriangles;
+
+		// クリッピングで分割された後の三角形の数
+		uint32_t rasterizedTriangles;
+
+		// タイルへ振り分けた数（１つの三角形が複数のタイルに入る）
+		uint32_t binnedTriangles;
+
+		// 深度テストに合格して塗ったピクセルの数
+		uint64_t shadedPixels;
+	};
+
+	// テクスチャ（ミップマップ付き、テクセルは 0～1 の float で持つ）
+	class SoftwareTexture
+	{
+	public:
+
+		/// <summary>
+		/// テクスチャを作成する関数
+		/// </summary>
+		/// <param name="width">幅</param>
+		/// <param name="height">高さ</param>
+		/// <param name="pixels">R8G8B8A8 のピクセル（乗算済みアルファ、width × height 個）</param>
+		/// <param name="generateMips">ミップマップを作成する場合は true（２×２の平均で縮小）</param>
+		/// <returns>作成できた場合は true</returns>
+		bool Create(uint32_t width, uint32_t height, const uint32_t* pixels, bool generateMips = true);
+
+		/// <summary>
+		/// サンプリングする関数（MIN_MAG_MIP_LINEAR、WRAP）
+		/// </summary>
+		/// <param name="u">テクスチャ座標 U</param>
+		/// <param name="v">テクスチャ座標 V</param>
+		/// <param name="lod">ミップレベル（0 が一番大きい）</param>
+		/// <returns>色</returns>
+		Math::Vector4 Sample(float u, float v, float lod) const;
+
+		// 幅と高さを取得する関数
+		uint32_t GetWidth() const { return m_levels.empty() ? 0 : m_levels[0].width; }
+		uint32_t GetHeight() const { return m_levels.empty() ? 0 : m_levels[0].height; }
+
+		// ミップマップの数を取得する関数
+		uint32_t GetMipCount() const { return static_cast<uint32_t>(m_levels.size()); }
+
+	private:
+
+		// ミップマップの１枚
+		struct Level
+		{
+			uint32_t width;
+			uint32_t height;
+			std::vector<Math::Vector4> texels;
+		};
+
+		// バイリニアでサンプリングする関数
+		Math::Vector4 SampleLevel(const Level& level, float u, float v) const;
+
+	private:
+
+		// ミップマップ
+		std::vector<Level> m_levels;
+	};
+
+	// ソフトウェアラスタライザー
+	class SoftwareRasterizer
+	{
+	public:
+
+		// タイルの大きさ（ピクセル）
+		static constexpr int TILE_SIZE = 32;
+
+		// サブピクセルのビット数（頂点の位置は 1/16 ピクセル単位に丸める）
+		static constexpr int SUBPIXEL_BITS = 4;
+
+		// 描画先の最大の大きさ（固定小数点の辺の計算があふれない範囲）
+		static constexpr uint32_t MAX_TARGET_SIZE = 4096;
+
+		SoftwareRasterizer();
+
+		/// <summary>
+		/// 描画先の大きさを設定する関数（カラーバッファは R8G8B8A8、深度バッファは float）
+		/// </summary>
+		/// <returns>MAX_TARGET_SIZE を超える場合は false</returns>
+		bool Resize(uint32_t width, uint32_t height);
+
+		/// <summary>
+		/// カラーバッファと深度バッファをクリアする関数
+		/// </summary>
+		/// <param name="color">色（RGBA）</param>
+		/// <param name="depth">深度（Reverse-Z の場合は 0）</param>
+		void Clear(const float color[4], float depth);
+
+		// ステートを設定する関数
+		void SetState(const SoftwareRasterizerState& state) { m_state = state; }
+
+		// テクスチャを設定する関数（nullptr の場合は白、Flush まで破棄しないこと）
+		void SetTexture(const SoftwareTexture* texture) { m_texture = texture; }
+
+		// 定数を設定する関数
+		void SetConstants(const SoftwareConstants& constants) { m_constants = constants; }
+
+		/// <summary>
+		/// インデックス付きの三角形リストを描画する関数（Flush で塗られる）
+		/// </summary>
+		/// <param name="vertices">頂点</param>
+		/// <param name="vertexCount">頂点の数</param>
+		/// <param name="indices">インデックス</param>
+		/// <param name="indexCount">インデックスの数（３の倍数）</param>
+		void DrawIndexed(const SoftwareVertex* vertices, size_t vertexCount, const uint16_t* indices, size_t indexCount);
+
+		/// <summary>
+		/// タイルに振り分けた三角形を塗る関数
+		/// </summary>
+		/// <param name="threadCount">分割する数（0 の場合はジョブシステムのワーカー数、1 の場合は呼び出し元のスレッドのみ）</param>
+		void Flush(unsigned int threadCount = 0);
+
+		// 描画の回数を 0 に戻す関数
+		void ResetStats() { m_stats = {}; }
+
+		// 描画の回数を取得する関数
+		const SoftwareRasterizerStats& GetStats() const { return m_stats; }
+
+		// 描画先の大きさを取得する関数
+		uint32_t GetWidth() const { return m_width; }
+		uint32_t GetHeight() const { return m_height; }
+
+		// カラーバッファ（R8G8B8A8、Flush 後に有効）
+		const uint32_t* GetColorBuffer() const { return m_colorBuffer.data(); }
+
+		// 深度バッファ（Flush 後に有効）
+		const float* GetDepthBuffer() const { return m_depthBuffer.data(); }
+
+		/// <summary>
+		/// カラーバッファを TGA ファイル（32 ビット、無圧縮）へ保存する関数
+		/// </summary>
+		/// <returns>成功した場合は true</returns>
+		bool WriteImage(const char* fileName) const;
+
+		/// <summary>
+		/// TGA ファイル（32 ビット、無圧縮）を読み込む関数（ゴールデンイメージ用）
+		/// </summary>
+		/// <param name="fileName">ファイル名</param>
+		/// <param name="width">幅の出力先</param>
+		/// <param name="height">高さの出力先</param>
+		/// <param name="pixels">R8G8B8A8 のピクセルの出力先</param>
+		/// <returns>成功した場合は true</returns>
+		static bool ReadImage(const char* fileName, uint32_t* width, uint32_t* height, std::vector<uint32_t>* pixels);
+
+		/// <summary>
+		/// ２つの画像を比較する関数
+		/// </summary>
+		/// <param name="a">R8G8B8A8 のピクセル</param>
+		/// <param name="b">R8G8B8A8 のピクセル</param>
+		/// <param name="count">ピクセルの数</param>
+		/// <param name="tolerance">許容する各チャンネルの差</param>
+		/// <param name="maxDifference">各チャンネルの差の最大値の出力先（nullptr 可）</param>
+		/// <returns>差が許容値を超えたピクセルの数</returns>
+		static size_t CompareImages(const uint32_t* a, const uint32_t* b, size_t count, int tolerance, int* maxDifference);
+
+	private:
+
+		// VS の出力の属性の数（Diffuse RGBA, U, V）と補間する値の数（1/w・z/w を加える）
+		static constexpr int ATTRIBUTE_COUNT = 6;
+		static constexpr int INTERPOLANT_COUNT = ATTRIBUTE_COUNT + 2;
+
+		// 描画ごとの設定（Flush まで保持する）
+		struct DrawState
+		{
+			SoftwareRasterizerState state;
+			const SoftwareTexture* texture;
+		};
+
+		// 塗るための三角形のデータ
+		struct Triangle
+		{
+			// 辺の式 E(x, y) = a * x + b * y + c（サブピクセル単位、内側が 0 以上）
+			int32_t a[3];
+			int32_t b[3];
+			int64_t c[3];
+
+			// 外接矩形（ピクセル、最大値は含まない）
+			int32_t minX, minY, maxX, maxY;
+
+			// 補間する値の平面の式の基準の位置（頂点０の画面上の位置）
+			float originX, originY;
+
+			// 補間する値（1/w・z/w・Diffuse RGBA/w・U/w・V/w）の基準の位置の値と x・y 方向の変化量
+			float planes[INTERPOLANT_COUNT][3];
+
+			// 描画の番号
+			uint32_t draw;
+		};
+
+		// クリップ空間の頂点（VS の出力）
+		struct ClipVertex
+		{
+			Math::Vector4 position;
+			float attributes[ATTRIBUTE_COUNT];
+		};
+
+		// 多角形を平面 dot(plane, position) >= 0 の内側で切り取る関数（頂点の数を返す）
+		static int ClipPolygon(const ClipVertex* input, int count, const Math::Vector4& plane, ClipVertex* output);
+
+		// クリッピング後の三角形をタイルへ振り分ける関数
+		void SetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, uint32_t draw);
+
+		// タイルを塗る関数
+		void RasterizeTile(uint32_t tile);
+
+		// 三角形のタイルの中の部分を塗る関数
+		void RasterizeTriangle(const Triangle& triangle, int32_t tileX, int32_t tileY);
+
+	private:
+
+		// 描画先の大きさとタイルの数
+		uint32_t m_width = 0;
+		uint32_t m_height = 0;
+		uint32_t m_tilesX = 0;
+		uint32_t m_tilesY = 0;
+
+		// カラーバッファ（R8G8B8A8）と深度バッファ
+		std::vector<uint32_t> m_colorBuffer;
+		std::vector<float> m_depthBuffer;
+
+		// 現在の設定
+		SoftwareRasterizerState m_state;
+		const SoftwareTexture* m_texture = nullptr;
+		SoftwareConstants m_constants;
+
+		// 描画ごとの設定
+		std::vector<DrawState> m_draws;
+
+		// 三角形
+		std::vector<Triangle> m_triangles;
+
+		// タイルごとの三角形の番号（描画した順番）
+		std::vector<std::vector<uint32_t>> m_bins;
+
+		// 頂点の変換結果（作業用）
+		std::vector<ClipVertex> m_clipVertices;
+
+		// タイルごとに塗ったピクセルの数（スレッドごとに書き込むので分ける）
+		std::vector<uint64_t> m_tileShadedPixels;
+
+		// 描画の回数
+		SoftwareRasterizerStats m_stats = {};
+	};
+}
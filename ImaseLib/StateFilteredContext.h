@@ -0,0 +1,455 @@
+﻿//--------------------------------------------------------------------------------------
+// File: StateFilteredContext.h
+//
+// 設定済みのステートを覚えておき、同じ設定の呼び出しを省略するデバイスコンテキストのラッパー
+//
+// Usage: ID3D11DeviceContext の代わりに同じ名前の関数を呼ぶと、現在設定されているステートと
+//        同じ場合は呼び出しを省略します。スロットのある設定（頂点バッファ・定数バッファ・
+//        シェーダーリソース・サンプラー）は変わったスロットの範囲だけ設定します。
+//        VSSetConstantBuffers1 はバッファと範囲（先頭の位置・定数の数）の両方を比べます。
+//        DirectXTK のエフェクトや ImGui など、ラッパーを通さずにステートを変更する処理の後は
+//        Invalidate を呼んでください（次の呼び出しは必ず設定されます）。
+//        呼び出した回数と省略した回数を数えるので、フレームの最初に ResetStats を呼べば
+//        １フレーム分の回数が分かります。
+//        コンテキストの型はテンプレート引数なので、Windows 以外の環境でも
+//        同じ名前の関数を持つダミーのクラスでテストできます。
+//
+//	<<< 記述例 >>
+//	Imase::StateFilteredContext<ID3D11DeviceContext> stateContext;
+//	stateContext.Reset(context);
+//
+//	stateContext.ResetStats();
+//	stateContext.RSSetState(rasterizerState);
+//	stateContext.RSSetState(rasterizerState);	// 同じなので省略される
+//
+//	m_basicEffect->Apply(context);			// ラッパーを通さない
+//	stateContext.Invalidate();
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Imase
+{
+	// ステートの設定の回数
+	struct StateFilterStats
+	{
+		// コンテキストへ設定した回数
+		uint32_t issued;
+
+		// 同じ設定なので省略した回数
+		uint32_t filtered;
+	};
+
+	// ステートの設定を省略するデバイスコンテキストのラッパー
+	template <class Context>
+	class StateFilteredContext
+	{
+	public:
+
+		// 覚えておくスロットの数（これより後ろのスロットは毎回設定する）
+		static constexpr uint32_t MAX_VERTEX_BUFFERS = 4;
+		static constexpr uint32_t MAX_CONSTANT_BUFFERS = 8;
+		static constexpr uint32_t MAX_SHADER_RESOURCES = 8;
+		static constexpr uint32_t MAX_SAMPLERS = 4;
+
+		StateFilteredContext() { Invalidate(); }
+
+		/// <summary>
+		/// コンテキストを設定する関数（設定済みのステートは分からないので Invalidate する）
+		/// </summary>
+		/// <param name="context">デバイスコンテキスト</param>
+		void Reset(Context* context)
+		{
+			m_context = context;
+			Invalidate();
+		}
+
+		/// <summary>
+		/// 設定済みのステートを忘れる関数（ラッパーを通さずにステートを変更した後に呼ぶ）
+		/// </summary>
+		void Invalidate()
+		{
+			m_inputLayout = UNKNOWN;
+			m_primitiveTopology = UNKNOWN;
+			m_indexBuffer = UNKNOWN;
+			m_indexFormat = UNKNOWN;
+			m_indexOffset = UNKNOWN;
+			m_vertexShader = UNKNOWN;
+			m_pixelShader = UNKNOWN;
+			m_rasterizerState = UNKNOWN;
+			m_depthStencilState = UNKNOWN;
+			m_stencilRef = UNKNOWN;
+			m_blendState = UNKNOWN;
+			m_sampleMask = UNKNOWN;
+			// NaN はどの値とも等しくならないので、次の設定は必ず行われる
+			m_blendFactor[0] = m_blendFactor[1] = m_blendFactor[2] = m_blendFactor[3] = std::numeric_limits<float>::quiet_NaN();
+			Fill(m_vertexBuffers, MAX_VERTEX_BUFFERS);
+			Fill(m_vertexStrides, MAX_VERTEX_BUFFERS);
+			Fill(m_vertexOffsets, MAX_VERTEX_BUFFERS);
+			Fill(m_vsConstantBuffers, MAX_CONSTANT_BUFFERS);
+			for (uint32_t i = 0; i < MAX_CONSTANT_BUFFERS; i++) m_vsFirstConstants[i] = m_vsNumConstants[i] = 0;
+			Fill(m_psConstantBuffers, MAX_CONSTANT_BUFFERS);
+			Fill(m_psShaderResources, MAX_SHADER_RESOURCES);
+			Fill(m_psSamplers, MAX_SAMPLERS);
+		}
+
+		// 回数を 0 に戻す関数（フレームの最初に呼ぶ）
+		void ResetStats() { m_stats = {}; }
+
+		// 回数を取得する関数
+		const StateFilterStats& GetStats() const { return m_stats; }
+
+		// コンテキストを取得する関数（ラッパーにない関数を呼ぶ場合に使用）
+		Context* Get() const { return m_context; }
+
+		// ----- IA ----- //
+
+		template <class InputLayout>
+		void IASetInputLayout(InputLayout* inputLayout)
+		{
+			if (!Change(&m_inputLayout, ToValue(inputLayout))) return;
+			m_context->IASetInputLayout(inputLayout);
+		}
+
+		template <class Topology>
+		void IASetPrimitiveTopology(Topology topology)
+		{
+			if (!Change(&m_primitiveTopology, static_cast<uintptr_t>(topology))) return;
+			m_context->IASetPrimitiveTopology(topology);
+		}
+
+		template <class Buffer, class Format>
+		void IASetIndexBuffer(Buffer* buffer, Format format, uint32_t offset)
+		{
+			if (m_indexBuffer == ToValue(buffer)
+				&& m_indexFormat == static_cast<uintptr_t>(format)
+				&& m_indexOffset == offset)
+			{
+				m_stats.filtered++;
+				return;
+			}
+			m_indexBuffer = ToValue(buffer);
+			m_indexFormat = static_cast<uintptr_t>(format);
+			m_indexOffset = offset;
+			m_stats.issued++;
+			m_context->IASetIndexBuffer(buffer, format, offset);
+		}
+
+		template <class Buffer, class Uint>
+		void IASetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, Buffer* const* buffers, const Uint* strides, const Uint* offsets)
+		{
+			// 覚えていないスロットを含む場合はそのまま設定する
+			if (startSlot + numBuffers > MAX_VERTEX_BUFFERS)
+			{
+				InvalidateSlots(m_vertexBuffers, MAX_VERTEX_BUFFERS, startSlot, numBuffers);
+				InvalidateSlots(m_vertexStrides, MAX_VERTEX_BUFFERS, startSlot, numBuffers);
+				InvalidateSlots(m_vertexOffsets, MAX_VERTEX_BUFFERS, startSlot, numBuffers);
+				m_stats.issued++;
+				m_context->IASetVertexBuffers(startSlot, numBuffers, buffers, strides, offsets);
+				return;
+			}
+
+			// 変わったスロットの範囲を求める
+			uint32_t first = numBuffers, last = 0;
+			for (uint32_t i = 0; i < numBuffers; i++)
+			{
+				uint32_t slot = startSlot + i;
+				if (m_vertexBuffers[slot] != ToValue(buffers[i])
+					|| m_vertexStrides[slot] != strides[i]
+					|| m_vertexOffsets[slot] != offsets[i])
+				{
+					if (first == numBuffers) first = i;
+					last = i;
+					m_vertexBuffers[slot] = ToValue(buffers[i]);
+					m_vertexStrides[slot] = strides[i];
+					m_vertexOffsets[slot] = offsets[i];
+				}
+			}
+
+			if (first == numBuffers)
+			{
+				m_stats.filtered++;
+				return;
+			}
+			m_stats.issued++;
+			m_context->IASetVertexBuffers(startSlot + first, last - first + 1, buffers + first, strides + first, offsets + first);
+		}
+
+		// ----- VS ----- //
+
+		template <class Shader, class ClassInstances>
+		void VSSetShader(Shader* shader, ClassInstances classInstances, uint32_t numClassInstances)
+		{
+			// クラスインスタンスを使う場合は覚えない
+			if (numClassInstances > 0)
+			{
+				m_vertexShader = UNKNOWN;
+				m_stats.issued++;
+				m_context->VSSetShader(shader, classInstances, numClassInstances);
+				return;
+			}
+			if (!Change(&m_vertexShader, ToValue(shader))) return;
+			m_context->VSSetShader(shader, classInstances, numClassInstances);
+		}
+
+		template <class Buffer>
+		void VSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, Buffer* const* buffers)
+		{
+			// 範囲を指定して設定したスロットは、同じバッファでも全体を設定し直す
+			for (uint32_t slot = startSlot; slot < startSlot + numBuffers && slot < MAX_CONSTANT_BUFFERS; slot++)
+			{
+				if (m_vsNumConstants[slot] == 0) continue;
+				m_vsConstantBuffers[slot] = UNKNOWN;
+				m_vsFirstConstants[slot] = m_vsNumConstants[slot] = 0;
+			}
+
+			uint32_t first, count;
+			if (!ChangeSlots(m_vsConstantBuffers, MAX_CONSTANT_BUFFERS, startSlot, numBuffers, buffers, &first, &count)) return;
+			m_context->VSSetConstantBuffers(startSlot + first, count, buffers + first);
+		}
+
+		template <class Buffer>
+		void VSSetConstantBuffers1(uint32_t startSlot, uint32_t numBuffers, Buffer* const* buffers,
+			const uint32_t* firstConstants, const uint32_t* numConstants)
+		{
+			// 覚えていないスロットを含む場合はそのまま設定する
+			if (startSlot + numBuffers > MAX_CONSTANT_BUFFERS)
+			{
+				InvalidateSlots(m_vsConstantBuffers, MAX_CONSTANT_BUFFERS, startSlot, numBuffers);
+				m_stats.issued++;
+				m_context->VSSetConstantBuffers1(startSlot, numBuffers, buffers, firstConstants, numConstants);
+				return;
+			}
+
+			uint32_t begin = numBuffers, end = 0;
+			for (uint32_t i = 0; i < numBuffers; i++)
+			{
+				uint32_t slot = startSlot + i;
+				uintptr_t value = ToValue(buffers[i]);
+				if (m_vsConstantBuffers[slot] != value
+					|| m_vsFirstConstants[slot] != firstConstants[i] || m_vsNumConstants[slot] != numConstants[i])
+				{
+					if (begin == numBuffers) begin = i;
+					end = i + 1;
+					m_vsConstantBuffers[slot] = value;
+					m_vsFirstConstants[slot] = firstConstants[i];
+					m_vsNumConstants[slot] = numConstants[i];
+				}
+			}
+
+			if (begin == numBuffers)
+			{
+				m_stats.filtered++;
+				return;
+			}
+			m_stats.issued++;
+			m_context->VSSetConstantBuffers1(startSlot + begin, end - begin, buffers + begin, firstConstants + begin, numConstants + begin);
+		}
+
+		// ----- RS ----- //
+
+		template <class RasterizerState>
+		void RSSetState(RasterizerState* rasterizerState)
+		{
+			if (!Change(&m_rasterizerState, ToValue(rasterizerState))) return;
+			m_context->RSSetState(rasterizerState);
+		}
+
+		// ----- PS ----- //
+
+		template <class Shader, class ClassInstances>
+		void PSSetShader(Shader* shader, ClassInstances classInstances, uint32_t numClassInstances)
+		{
+			// クラスインスタンスを使う場合は覚えない
+			if (numClassInstances > 0)
+			{
+				m_pixelShader = UNKNOWN;
+				m_stats.issued++;
+				m_context->PSSetShader(shader, classInstances, numClassInstances);
+				return;
+			}
+			if (!Change(&m_pixelShader, ToValue(shader))) return;
+			m_context->PSSetShader(shader, classInstances, numClassInstances);
+		}
+
+		template <class Buffer>
+		void PSSetConstantBuffers(uint32_t startSlot, uint32_t numBuffers, Buffer* const* buffers)
+		{
+			uint32_t first, count;
+			if (!ChangeSlots(m_psConstantBuffers, MAX_CONSTANT_BUFFERS, startSlot, numBuffers, buffers, &first, &count)) return;
+			m_context->PSSetConstantBuffers(startSlot + first, count, buffers + first);
+		}
+
+		template <class ShaderResourceView>
+		void PSSetShaderResources(uint32_t startSlot, uint32_t numViews, ShaderResourceView* const* views)
+		{
+			uint32_t first, count;
+			if (!ChangeSlots(m_psShaderResources, MAX_SHADER_RESOURCES, startSlot, numViews, views, &first, &count)) return;
+			m_context->PSSetShaderResources(startSlot + first, count, views + first);
+		}
+
+		template <class SamplerState>
+		void PSSetSamplers(uint32_t startSlot, uint32_t numSamplers, SamplerState* const* samplers)
+		{
+			uint32_t first, count;
+			if (!ChangeSlots(m_psSamplers, MAX_SAMPLERS, startSlot, numSamplers, samplers, &first, &count)) return;
+			m_context->PSSetSamplers(startSlot + first, count, samplers + first);
+		}
+
+		// ----- OM ----- //
+
+		template <class DepthStencilState>
+		void OMSetDepthStencilState(DepthStencilState* depthStencilState, uint32_t stencilRef)
+		{
+			if (m_depthStencilState == ToValue(depthStencilState) && m_stencilRef == stencilRef)
+			{
+				m_stats.filtered++;
+				return;
+			}
+			m_depthStencilState = ToValue(depthStencilState);
+			m_stencilRef = stencilRef;
+			m_stats.issued++;
+			m_context->OMSetDepthStencilState(depthStencilState, stencilRef);
+		}
+
+		template <class BlendState>
+		void OMSetBlendState(BlendState* blendState, const float blendFactor[4], uint32_t sampleMask)
+		{
+			// nullptr の場合のブレンドファクターは (1, 1, 1, 1)
+			static const float DEFAULT_BLEND_FACTOR[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			const float* factor = blendFactor ? blendFactor : DEFAULT_BLEND_FACTOR;
+
+			if (m_blendState == ToValue(blendState) && m_sampleMask == sampleMask
+				&& m_blendFactor[0] == factor[0] && m_blendFactor[1] == factor[1]
+				&& m_blendFactor[2] == factor[2] && m_blendFactor[3] == factor[3])
+			{
+				m_stats.filtered++;
+				return;
+			}
+			m_blendState = ToValue(blendState);
+			m_sampleMask = sampleMask;
+			for (int i = 0; i < 4; i++) m_blendFactor[i] = factor[i];
+			m_stats.issued++;
+			m_context->OMSetBlendState(blendState, blendFactor, sampleMask);
+		}
+
+	private:
+
+		// 設定されている値が分からないことを表す値（ポインタや列挙型の値と重ならない）
+		static constexpr uintptr_t UNKNOWN = ~uintptr_t(0);
+
+		// ポインタを比較用の値へ変換する関数
+		template <class T>
+		static uintptr_t ToValue(T* p) { return reinterpret_cast<uintptr_t>(p); }
+
+		// 配列を UNKNOWN で埋める関数
+		static void Fill(uintptr_t* values, uint32_t count)
+		{
+			for (uint32_t i = 0; i < count; i++) values[i] = UNKNOWN;
+		}
+
+		// 範囲内のスロットを UNKNOWN にする関数
+		static void InvalidateSlots(uintptr_t* values, uint32_t maxSlots, uint32_t startSlot, uint32_t count)
+		{
+			for (uint32_t slot = startSlot; slot < startSlot + count && slot < maxSlots; slot++) values[slot] = UNKNOWN;
+		}
+
+		// 値が変わる場合は覚えて true を返す関数
+		bool Change(uintptr_t* current, uintptr_t value)
+		{
+			if (*current == value)
+			{
+				m_stats.filtered++;
+				return false;
+			}
+			*current = value;
+			m_stats.issued++;
+			return true;
+		}
+
+		// スロットの値が変わる場合は覚えて、変わった範囲（values の中の位置と数）と true を返す関数
+		template <class T>
+		bool ChangeSlots(uintptr_t* current, uint32_t maxSlots, uint32_t startSlot, uint32_t count, T* const* values,
+			uint32_t* first, uint32_t* changedCount)
+		{
+			// 覚えていないスロットを含む場合はそのまま設定する
+			if (startSlot + count > maxSlots)
+			{
+				InvalidateSlots(current, maxSlots, startSlot, count);
+				*first = 0;
+				*changedCount = count;
+				m_stats.issued++;
+				return true;
+			}
+
+			uint32_t begin = count, end = 0;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uintptr_t value = ToValue(values[i]);
+				if (current[startSlot + i] != value)
+				{
+					if (begin == count) begin = i;
+					end = i + 1;
+					current[startSlot + i] = value;
+				}
+			}
+
+			if (begin == count)
+			{
+				m_stats.filtered++;
+				return false;
+			}
+			*first = begin;
+			*changedCount = end - begin;
+			m_stats.issued++;
+			return true;
+		}
+
+	private:
+
+		// デバイスコンテキスト
+		Context* m_context = nullptr;
+
+		// IA
+		uintptr_t m_inputLayout;
+		uintptr_t m_primitiveTopology;
+		uintptr_t m_indexBuffer;
+		uintptr_t m_indexFormat;
+		uintptr_t m_indexOffset;
+		uintptr_t m_vertexBuffers[MAX_VERTEX_BUFFERS];
+		uintptr_t m_vertexStrides[MAX_VERTEX_BUFFERS];
+		uintptr_t m_vertexOffsets[MAX_VERTEX_BUFFERS];
+
+		// VS
+		uintptr_t m_vertexShader;
+		uintptr_t m_vsConstantBuffers[MAX_CONSTANT_BUFFERS];
+		// 定数バッファの範囲（定数の数が 0 の場合はバッファ全体）
+		uint32_t m_vsFirstConstants[MAX_CONSTANT_BUFFERS];
+		uint32_t m_vsNumConstants[MAX_CONSTANT_BUFFERS];
+
+		// RS
+		uintptr_t m_rasterizerState;
+
+		// PS
+		uintptr_t m_pixelShader;
+		uintptr_t m_psConstantBuffers[MAX_CONSTANT_BUFFERS];
+		uintptr_t m_psShaderResources[MAX_SHADER_RESOURCES];
+		uintptr_t m_psSamplers[MAX_SAMPLERS];
+
+		// OM
+		uintptr_t m_depthStencilState;
+		uintptr_t m_stencilRef;
+		uintptr_t m_blendState;
+		uintptr_t m_sampleMask;
+		float m_blendFactor[4];
+
+		// 回数
+		StateFilterStats m_stats = {};
+	};
+}
@@ -0,0 +1,56 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TrackedConstantBuffer.cpp
+//
+// 内容が変わった時だけ書き込む定数バッファ
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TrackedConstantBuffer.h"
+
+using namespace Imase;
+
+//--------------------------------------------------------------------------------------
+// 内容が変わっている場合だけバッファへ書き込む関数
+//--------------------------------------------------------------------------------------
+bool TrackedConstantBuffer::Update(IRenderContext* context, const void* data, size_t size, ConstantUploadStats* stats)
+{
+	uint64_t hash = Hash(data, size);
+	if (!m_dirty && hash == m_hash)
+	{
+		if (stats) stats->skips++;
+		return false;
+	}
+
+	if (!context->UpdateBuffer(m_buffer, data, size)) return false;
+
+	m_hash = hash;
+	m_dirty = false;
+
+	if (stats)
+	{
+		stats->uploads++;
+		stats->uploadedBytes += size;
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// 64 ビットの FNV-1a のハッシュ値を求める関数
+//--------------------------------------------------------------------------------------
+uint64_t TrackedConstantBuffer::Hash(const void* data, size_t size)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
@@ -0,0 +1,90 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TrackedConstantBuffer.h
+//
+// 内容が変わった時だけ書き込む定数バッファ
+//
+// Usage: Update に書き込みたい内容を渡すと、前に書き込んだ内容のハッシュ値と比べて、
+//        変わっている場合だけ WriteDiscard で Map して書き込みます（同じ場合は何もしません）。
+//        MarkDirty を呼ぶと次の Update はハッシュ値が同じでも書き込みます
+//        （Initialize の後も同じです）。
+//        書き込んだ回数・省略した回数・書き込んだバイト数を ConstantUploadStats へ足すので、
+//        フレームの最初に 0 に戻せば１フレームで書き込んだバイト数が分かります。
+//        ハッシュ値は 64 ビットの FNV-1a です。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	m_frameConstants.Initialize(frameConstantBuffer);
+//
+//	Imase::ConstantUploadStats stats = {};
+//	m_frameConstants.Update(context, &data, sizeof(data), &stats);	// 変わっていなければ書き込まない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "RenderContext.h"
+
+namespace Imase
+{
+	// 定数バッファへの書き込みの計測結果
+	struct ConstantUploadStats
+	{
+		// 書き込んだ回数
+		uint32_t uploads;
+
+		// 内容が同じなので書き込みを省略した回数
+		uint32_t skips;
+
+		// 書き込んだバイト数
+		uint64_t uploadedBytes;
+	};
+
+	// 内容が変わった時だけ書き込む定数バッファ
+	class TrackedConstantBuffer
+	{
+	public:
+
+		TrackedConstantBuffer() = default;
+
+		// バッファを設定する関数（次の Update は必ず書き込む）
+		void Initialize(RenderBuffer* buffer)
+		{
+			m_buffer = buffer;
+			m_dirty = true;
+		}
+
+		// バッファを取得する関数
+		RenderBuffer* GetBuffer() const { return m_buffer; }
+
+		// 次の Update で必ず書き込むようにする関数（ラッパーを通さずに書き換えた場合等）
+		void MarkDirty() { m_dirty = true; }
+
+		/// <summary>
+		/// 内容が変わっている場合だけバッファへ書き込む関数
+		/// </summary>
+		/// <param name="context">Map するコンテキスト</param>
+		/// <param name="data">書き込む内容</param>
+		/// <param name="size">バイト数</param>
+		/// <param name="stats">計測結果を足す先（nullptr 可）</param>
+		/// <returns>書き込んだ場合は true</returns>
+		bool Update(IRenderContext* context, const void* data, size_t size, ConstantUploadStats* stats);
+
+		// 64 ビットの FNV-1a のハッシュ値を求める関数
+		static uint64_t Hash(const void* data, size_t size);
+
+	private:
+
+		// バッファ
+		RenderBuffer* m_buffer = nullptr;
+
+		// 最後に書き込んだ内容のハッシュ値
+		uint64_t m_hash = 0;
+
+		// 次の Update で必ず書き込む場合は true
+		bool m_dirty = true;
+	};
+}
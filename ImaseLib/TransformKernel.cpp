@@ -0,0 +1,276 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TransformKernel.cpp
+//
+// 多数のオブジェクトのワールド×ビュー×射影行列をまとめて計算する関数
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TransformKernel.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace Imase;
+using Imase::Math::Matrix;
+
+namespace
+{
+	// 並列化する場合の１スレッドあたりの最小のオブジェクト数
+	constexpr size_t MIN_OBJECTS_PER_THREAD = 2048;
+
+	// 出力先のアドレスを取得する関数
+	inline float* GetDestination(void* destination, size_t stride, size_t index)
+	{
+		return reinterpret_cast<float*>(static_cast<uint8_t*>(destination) + stride * index);
+	}
+
+#if defined(__AVX2__)
+	// AVX2（８個ずつ）
+	struct Float8
+	{
+		using Type = __m256;
+		static constexpr size_t WIDTH = 8;
+
+		static Type Load(const float* p) { return _mm256_loadu_ps(p); }
+		static Type Set(float v) { return _mm256_set1_ps(v); }
+		static Type Add(Type a, Type b) { return _mm256_add_ps(a, b); }
+		static Type Sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+		static Type Mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+		static Type MulAdd(Type a, Type b, Type c) { return _mm256_fmadd_ps(a, b, c); }
+
+		// ４つのベクトルを転置して各オブジェクトの出力先へ書き込む
+		static void StoreTransposed(Type r0, Type r1, Type r2, Type r3, float* const* dst, size_t offset)
+		{
+			Type t0 = _mm256_unpacklo_ps(r0, r1);
+			Type t1 = _mm256_unpackhi_ps(r0, r1);
+			Type t2 = _mm256_unpacklo_ps(r2, r3);
+			Type t3 = _mm256_unpackhi_ps(r2, r3);
+
+			// 下位128ビットはオブジェクト0～3、上位128ビットはオブジェクト4～7
+			Type o0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+			Type o1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+			Type o2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			Type o3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+			_mm_storeu_ps(dst[0] + offset, _mm256_castps256_ps128(o0));
+			_mm_storeu_ps(dst[1] + offset, _mm256_castps256_ps128(o1));
+			_mm_storeu_ps(dst[2] + offset, _mm256_castps256_ps128(o2));
+			_mm_storeu_ps(dst[3] + offset, _mm256_castps256_ps128(o3));
+			_mm_storeu_ps(dst[4] + offset, _mm256_extractf128_ps(o0, 1));
+			_mm_storeu_ps(dst[5] + offset, _mm256_extractf128_ps(o1, 1));
+			_mm_storeu_ps(dst[6] + offset, _mm256_extractf128_ps(o2, 1));
+			_mm_storeu_ps(dst[7] + offset, _mm256_extractf128_ps(o3, 1));
+		}
+	};
+#endif
+
+#if defined(IMASE_MATH_SSE2)
+	// SSE2（４個ずつ）
+	struct Float4
+	{
+		using Type = __m128;
+		static constexpr size_t WIDTH = 4;
+
+		static Type Load(const float* p) { return _mm_loadu_ps(p); }
+		static Type Set(float v) { return _mm_set1_ps(v); }
+		static Type Add(Type a, Type b) { return _mm_add_ps(a, b); }
+		static Type Sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+		static Type Mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+		static Type MulAdd(Type a, Type b, Type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+		// ４つのベクトルを転置して各オブジェクトの出力先へ書き込む
+		static void StoreTransposed(Type r0, Type r1, Type r2, Type r3, float* const* dst, size_t offset)
+		{
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			_mm_storeu_ps(dst[0] + offset, r0);
+			_mm_storeu_ps(dst[1] + offset, r1);
+			_mm_storeu_ps(dst[2] + offset, r2);
+			_mm_storeu_ps(dst[3] + offset, r3);
+		}
+	};
+#endif
+
+	// WIDTH 個のオブジェクトの WVP 行列を計算する
+	template <class S>
+	void ComputeBlock(
+		const TransformArrays& t, size_t index,
+		const Matrix& vp,
+		void* destination, size_t stride)
+	{
+		using V = typename S::Type;
+
+		V px = S::Load(t.positionX + index);
+		V py = S::Load(t.positionY + index);
+		V pz = S::Load(t.positionZ + index);
+
+		V qx = S::Load(t.rotationX + index);
+		V qy = S::Load(t.rotationY + index);
+		V qz = S::Load(t.rotationZ + index);
+		V qw = S::Load(t.rotationW + index);
+
+		V sx = S::Load(t.scaleX + index);
+		V sy = S::Load(t.scaleY + index);
+		V sz = S::Load(t.scaleZ + index);
+
+		// クォータニオンから回転行列を求める（Math::Matrix::CreateFromQuaternion と同じ）
+		V x2 = S::Add(qx, qx);
+		V y2 = S::Add(qy, qy);
+		V z2 = S::Add(qz, qz);
+
+		V xx = S::Mul(qx, x2);
+		V yy = S::Mul(qy, y2);
+		V zz = S::Mul(qz, z2);
+		V xy = S::Mul(qx, y2);
+		V xz = S::Mul(qx, z2);
+		V yz = S::Mul(qy, z2);
+		V wx = S::Mul(qw, x2);
+		V wy = S::Mul(qw, y2);
+		V wz = S::Mul(qw, z2);
+
+		V one = S::Set(1.0f);
+
+		// ワールド行列（スケール×回転×平行移動）の 3×3 部分
+		V w[3][3] =
+		{
+			{ S::Mul(S::Sub(one, S::Add(yy, zz)), sx), S::Mul(S::Add(xy, wz), sx), S::Mul(S::Sub(xz, wy), sx) },
+			{ S::Mul(S::Sub(xy, wz), sy), S::Mul(S::Sub(one, S::Add(xx, zz)), sy), S::Mul(S::Add(yz, wx), sy) },
+			{ S::Mul(S::Add(xz, wy), sz), S::Mul(S::Sub(yz, wx), sz), S::Mul(S::Sub(one, S::Add(xx, yy)), sz) },
+		};
+
+		// 各オブジェクトの出力先
+		float* dst[S::WIDTH];
+		for (size_t i = 0; i < S::WIDTH; i++)
+		{
+			dst[i] = GetDestination(destination, stride, index + i);
+		}
+
+		// WVP の j 列目を求め、転置して j 行目へ書き込む
+		for (size_t j = 0; j < 4; j++)
+		{
+			V vp0 = S::Set(vp.m[0][j]);
+			V vp1 = S::Set(vp.m[1][j]);
+			V vp2 = S::Set(vp.m[2][j]);
+			V vp3 = S::Set(vp.m[3][j]);
+
+			V m0 = S::MulAdd(w[0][0], vp0, S::MulAdd(w[0][1], vp1, S::Mul(w[0][2], vp2)));
+			V m1 = S::MulAdd(w[1][0], vp0, S::MulAdd(w[1][1], vp1, S::Mul(w[1][2], vp2)));
+			V m2 = S::MulAdd(w[2][0], vp0, S::MulAdd(w[2][1], vp1, S::Mul(w[2][2], vp2)));
+			V m3 = S::MulAdd(px, vp0, S::MulAdd(py, vp1, S::MulAdd(pz, vp2, vp3)));
+
+			S::StoreTransposed(m0, m1, m2, m3, dst, j * 4);
+		}
+	}
+
+	// 指定範囲のオブジェクトの WVP 行列を計算する
+	void ComputeRange(
+		const TransformArrays& t, size_t begin, size_t end,
+		const Matrix& vp,
+		void* destination, size_t stride)
+	{
+		size_t i = begin;
+
+#if defined(__AVX2__)
+		for (; i + Float8::WIDTH <= end; i += Float8::WIDTH)
+		{
+			ComputeBlock<Float8>(t, i, vp, destination, stride);
+		}
+#endif
+
+#if defined(IMASE_MATH_SSE2)
+		for (; i + Float4::WIDTH <= end; i += Float4::WIDTH)
+		{
+			ComputeBlock<Float4>(t, i, vp, destination, stride);
+		}
+#endif
+
+		// 端数（SIMDが使えない環境では全て）はスカラー版で計算する
+		ComputeWorldViewProjectionsScalar(t, i, end, vp, destination, stride);
+	}
+}
+
+// 転置済みの WVP 行列をまとめて計算する関数
+void Imase::ComputeWorldViewProjections(
+	const TransformArrays& transforms,
+	size_t count,
+	const Matrix& viewProjection,
+	void* destination,
+	size_t destinationStride,
+	unsigned int threadCount)
+{
+	if (threadCount == 0)
+	{
+		threadCount = JobSystem::GetDefault().GetWorkerCount();
+	}
+
+	// 少ない場合はジョブを積むコストの方が大きい
+	size_t maxThreads = (count + MIN_OBJECTS_PER_THREAD - 1) / MIN_OBJECTS_PER_THREAD;
+	threadCount = static_cast<unsigned int>(std::min<size_t>(threadCount, maxThreads));
+
+	if (threadCount <= 1)
+	{
+		ComputeRange(transforms, 0, count, viewProjection, destination, destinationStride);
+		return;
+	}
+
+	// 分割の単位は SIMD の幅（８）の倍数にする
+	size_t chunk = ((count + threadCount - 1) / threadCount + 7) & ~size_t(7);
+
+	size_t chunkCount = (count + chunk - 1) / chunk;
+
+	JobSystem::GetDefault().ParallelFor(0, chunkCount, 1, [&](size_t first, size_t last)
+		{
+			size_t begin = first * chunk;
+			size_t end = std::min(last * chunk, count);
+			ComputeRange(transforms, begin, end, viewProjection, destination, destinationStride);
+		});
+}
+
+// 転置済みの WVP 行列を計算する関数（スカラー版）
+void Imase::ComputeWorldViewProjectionsScalar(
+	const TransformArrays& t,
+	size_t begin,
+	size_t end,
+	const Matrix& vp,
+	void* destination,
+	size_t destinationStride)
+{
+	for (size_t i = begin; i < end; i++)
+	{
+		float qx = t.rotationX[i], qy = t.rotationY[i], qz = t.rotationZ[i], qw = t.rotationW[i];
+		float sx = t.scaleX[i], sy = t.scaleY[i], sz = t.scaleZ[i];
+
+		float xx = 2.0f * qx * qx, yy = 2.0f * qy * qy, zz = 2.0f * qz * qz;
+		float xy = 2.0f * qx * qy, xz = 2.0f * qx * qz, yz = 2.0f * qy * qz;
+		float wx = 2.0f * qw * qx, wy = 2.0f * qw * qy, wz = 2.0f * qw * qz;
+
+		// ワールド行列
+		float w[4][3] =
+		{
+			{ (1.0f - yy - zz) * sx, (xy + wz) * sx, (xz - wy) * sx },
+			{ (xy - wz) * sy, (1.0f - xx - zz) * sy, (yz + wx) * sy },
+			{ (xz + wy) * sz, (yz - wx) * sz, (1.0f - xx - yy) * sz },
+			{ t.positionX[i], t.positionY[i], t.positionZ[i] },
+		};
+
+		float* dst = GetDestination(destination, destinationStride, i);
+
+		// WVP の (r, j) 要素を転置して (j, r) へ書き込む
+		for (size_t j = 0; j < 4; j++)
+		{
+			for (size_t r = 0; r < 4; r++)
+			{
+				float v = w[r][0] * vp.m[0][j] + w[r][1] * vp.m[1][j] + w[r][2] * vp.m[2][j];
+				if (r == 3) v += vp.m[3][j];
+				dst[j * 4 + r] = v;
+			}
+		}
+	}
+}
@@ -0,0 +1,71 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TransformKernel.h
+//
+// 多数のオブジェクトのワールド×ビュー×射影行列をまとめて計算する関数
+//
+// Usage: オブジェクトの位置・回転（クォータニオン）・スケールを SoA 形式の配列で渡すと、
+//        シェーダーへそのまま渡せる転置済みの WVP 行列を出力先へ書き込みます。
+//        出力先は定数バッファ等の構造体の配列を想定し、要素の間隔（バイト数）を指定できます。
+//        SIMD（AVX2 の場合は８個、SSE2 の場合は４個ずつ）で計算し、数が多い場合は
+//        ジョブシステム（JobSystem）のワーカーに分割して処理します。
+//        Windows や DirectXMath に依存しないので、どの環境でも使用できます。
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+
+#include "MathCore.h"
+
+namespace Imase
+{
+	// オブジェクトの姿勢の配列（SoA形式）
+	struct TransformArrays
+	{
+		// 位置
+		const float* positionX;
+		const float* positionY;
+		const float* positionZ;
+
+		// 回転（正規化されたクォータニオン）
+		const float* rotationX;
+		const float* rotationY;
+		const float* rotationZ;
+		const float* rotationW;
+
+		// スケール
+		const float* scaleX;
+		const float* scaleY;
+		const float* scaleZ;
+	};
+
+	/// <summary>
+	/// 転置済みの WVP 行列をまとめて計算する関数
+	/// </summary>
+	/// <param name="transforms">オブジェクトの姿勢の配列</param>
+	/// <param name="count">オブジェクトの数</param>
+	/// <param name="viewProjection">ビュー行列×射影行列</param>
+	/// <param name="destination">出力先（先頭の要素の行列の位置）</param>
+	/// <param name="destinationStride">出力先の要素の間隔（バイト数）</param>
+	/// <param name="threadCount">分割する数（0の場合はジョブシステムのワーカー数、1の場合は呼び出し元のスレッドのみ）</param>
+	void ComputeWorldViewProjections(
+		const TransformArrays& transforms,
+		size_t count,
+		const Math::Matrix& viewProjection,
+		void* destination,
+		size_t destinationStride = sizeof(Math::Matrix),
+		unsigned int threadCount = 0);
+
+	/// <summary>
+	/// 転置済みの WVP 行列を計算する関数（スカラー版）
+	/// </summary>
+	void ComputeWorldViewProjectionsScalar(
+		const TransformArrays& transforms,
+		size_t begin,
+		size_t end,
+		const Math::Matrix& viewProjection,
+		void* destination,
+		size_t destinationStride = sizeof(Math::Matrix));
+}
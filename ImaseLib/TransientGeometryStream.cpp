@@ -0,0 +1,215 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TransientGeometryStream.cpp
+//
+// デバッグの線やグリッドの頂点をフレームの間ためて、大きな１つの頂点バッファへ追記して描画するストリーム
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TransientGeometryStream.h"
+
+#include <cstring>
+
+using namespace Imase;
+
+//--------------------------------------------------------------------------------------
+// 書き込むバッファを設定する関数
+//--------------------------------------------------------------------------------------
+void TransientGeometryStream::Initialize(RenderBuffer* vertexBuffer, uint32_t vertexCapacity, RenderBuffer* indexBuffer, uint32_t indexCapacity)
+{
+	m_vertexBuffer = vertexBuffer;
+	m_indexBuffer = indexBuffer;
+
+	bool isValid = IsValid();
+	m_vertexAllocator.Reset(isValid ? vertexCapacity : 0);
+	m_indexAllocator.Reset(isValid ? indexCapacity : 0);
+	m_vertexAllocator.ResetStats();
+	m_indexAllocator.ResetStats();
+
+	m_frame = 0;
+	m_vertexDiscard = true;
+	m_indexDiscard = true;
+
+	Clear();
+	m_stats = {};
+	m_lastStats = {};
+}
+
+//--------------------------------------------------------------------------------------
+// フレームの最初に呼ぶ関数
+//--------------------------------------------------------------------------------------
+void TransientGeometryStream::BeginFrame()
+{
+	if (m_frame > 0)
+	{
+		m_vertexAllocator.EndFrame(m_frame);
+		m_indexAllocator.EndFrame(m_frame);
+	}
+	m_frame++;
+
+	// GPU は FRAME_LATENCY フレームまで遅れるので、それより前のフレームは使い終わっている
+	if (m_frame > FRAME_LATENCY + 1)
+	{
+		m_vertexAllocator.Retire(m_frame - FRAME_LATENCY - 1);
+		m_indexAllocator.Retire(m_frame - FRAME_LATENCY - 1);
+	}
+
+	// 描画しなかった線は前のフレームのものなので捨てる
+	Clear();
+
+	m_lastStats = m_stats;
+	m_stats = {};
+}
+
+//--------------------------------------------------------------------------------------
+// ラインリストを追加する関数
+//--------------------------------------------------------------------------------------
+void TransientGeometryStream::AddLines(const TransientVertex* vertices, uint32_t vertexCount)
+{
+	vertexCount &= ~1u;
+	if (!IsValid() || vertexCount == 0) return;
+
+	uint32_t base = static_cast<uint32_t>(m_vertices.size());
+	m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+	for (uint32_t i = 0; i < vertexCount; i++)
+	{
+		m_indices.push_back(base + i);
+	}
+
+	m_stats.primitives++;
+}
+
+//--------------------------------------------------------------------------------------
+// ラインストリップを追加する関数
+//--------------------------------------------------------------------------------------
+void TransientGeometryStream::AddLineStrip(const TransientVertex* vertices, uint32_t vertexCount)
+{
+	if (!IsValid() || vertexCount < 2) return;
+
+	// 隣り合う頂点を結ぶ線のインデックスにする（頂点は共有する）
+	uint32_t base = static_cast<uint32_t>(m_vertices.size());
+	m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+	for (uint32_t i = 0; i + 1 < vertexCount; i++)
+	{
+		m_indices.push_back(base + i);
+		m_indices.push_back(base + i + 1);
+	}
+
+	m_stats.primitives++;
+}
+
+//--------------------------------------------------------------------------------------
+// インデックス付きのラインリストを追加する関数
+//--------------------------------------------------------------------------------------
+void TransientGeometryStream::AddIndexedLines(const uint16_t* indices, uint32_t indexCount, const TransientVertex* vertices, uint32_t vertexCount)
+{
+	indexCount &= ~1u;
+	if (!IsValid() || indexCount == 0 || vertexCount == 0) return;
+
+	uint32_t base = static_cast<uint32_t>(m_vertices.size());
+	m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+	for (uint32_t i = 0; i < indexCount; i++)
+	{
+		// 頂点の範囲外のインデックスは先頭の頂点にする（他の図形の頂点を指さないようにする）
+		uint32_t index = indices[i] < vertexCount ? indices[i] : 0;
+		m_indices.push_back(base + index);
+	}
+
+	m_stats.primitives++;
+}
+
+//--------------------------------------------------------------------------------------
+// 線を１本追加する関数
+//--------------------------------------------------------------------------------------
+void TransientGeometryStream::AddLine(const TransientVertex& v1, const TransientVertex& v2)
+{
+	if (!IsValid()) return;
+
+	uint32_t base = static_cast<uint32_t>(m_vertices.size());
+	m_vertices.push_back(v1);
+	m_vertices.push_back(v2);
+	m_indices.push_back(base);
+	m_indices.push_back(base + 1);
+
+	m_stats.primitives++;
+}
+
+//--------------------------------------------------------------------------------------
+// ためた線をバッファへ書き込んで描画する関数
+//--------------------------------------------------------------------------------------
+bool TransientGeometryStream::Flush(IRenderContext* context)
+{
+	if (m_indices.empty()) return false;
+
+	uint32_t vertexCount = static_cast<uint32_t>(m_vertices.size());
+	uint32_t indexCount = static_cast<uint32_t>(m_indices.size());
+	uint32_t vertexBytes = vertexCount * VERTEX_STRIDE;
+	uint32_t indexBytes = indexCount * static_cast<uint32_t>(sizeof(uint32_t));
+
+	// 確保した位置は 256 バイト単位なので、頂点の大きさの倍数へ進められるように余分に確保する
+	// （頂点だけ確保できた場合、その範囲はこのフレームの範囲に含まれて後で再利用される）
+	uint32_t allocatedOffset = 0, indexOffset = 0;
+	bool isAllocated = m_vertexAllocator.Allocate(vertexBytes + VERTEX_STRIDE - 1, &allocatedOffset)
+		&& m_indexAllocator.Allocate(indexBytes, &indexOffset);
+	uint32_t vertexOffset = (allocatedOffset + VERTEX_STRIDE - 1) / VERTEX_STRIDE * VERTEX_STRIDE;
+
+	if (!isAllocated
+		|| !Write(context, m_vertexBuffer, &m_vertexDiscard, vertexOffset, m_vertices.data(), vertexBytes)
+		|| !Write(context, m_indexBuffer, &m_indexDiscard, indexOffset, m_indices.data(), indexBytes))
+	{
+		m_stats.failures++;
+		Clear();
+		return false;
+	}
+
+	// バッファは先頭から設定し、追記した位置は最初のインデックスと頂点の番号で指定して１回で描画する
+	// （フレームの間、頂点バッファとインデックスバッファの設定は変わらない）
+	uint32_t stride = VERTEX_STRIDE;
+	uint32_t bufferOffset = 0;
+	context->IASetVertexBuffers(0, 1, &m_vertexBuffer, &stride, &bufferOffset);
+	context->IASetIndexBuffer(m_indexBuffer, RenderIndexFormat::UInt32, 0);
+	context->IASetPrimitiveTopology(RenderTopology::LineList);
+	context->DrawIndexed(indexCount, indexOffset / sizeof(uint32_t), static_cast<int32_t>(vertexOffset / VERTEX_STRIDE));
+
+	m_stats.vertices += vertexCount;
+	m_stats.indices += indexCount;
+	m_stats.streamedBytes += uint64_t(vertexBytes) + indexBytes;
+	m_stats.draws++;
+
+	Clear();
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// ためた線を描画せずに捨てる関数
+//--------------------------------------------------------------------------------------
+void TransientGeometryStream::Clear()
+{
+	// 容量は残して使い回す
+	m_vertices.clear();
+	m_indices.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// 確保した位置へ書き込む関数
+//--------------------------------------------------------------------------------------
+bool TransientGeometryStream::Write(IRenderContext* context, RenderBuffer* buffer, bool* discard, uint32_t offset, const void* data, uint32_t size)
+{
+	// GPU が使用中の範囲は確保されないので、上書きしないことを約束して Map する（バッファの名前の付け替えが起きない）
+	RenderMap mapType = *discard ? RenderMap::WriteDiscard : RenderMap::WriteNoOverwrite;
+
+	uint8_t* mapped = static_cast<uint8_t*>(context->Map(buffer, mapType));
+	if (!mapped) return false;
+
+	memcpy(mapped + offset, data, size);
+	context->Unmap(buffer);
+
+	m_stats.maps++;
+	if (mapType == RenderMap::WriteDiscard) m_stats.discards++;
+	*discard = false;
+
+	return true;
+}
@@ -0,0 +1,178 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TransientGeometryStream.h
+//
+// デバッグの線やグリッドの頂点をフレームの間ためて、大きな１つの頂点バッファへ追記して描画するストリーム
+//
+// Usage: AddLines・AddLineStrip・AddIndexedLines で追加した線は CPU 側の配列にたまり、
+//        Flush でまとめて頂点バッファとインデックスバッファへ書き込み、１回の DrawIndexed
+//        （ラインリスト）で描画します。ラインストリップはラインリストのインデックスへ
+//        変換するので、PrimitiveBatch のようにストリップごとに描画が分かれません。
+//        バッファの中の位置は ConstantRingAllocator で確保し（256 バイト単位）、確保した
+//        位置だけを WriteNoOverwrite で Map して追記します（最初の書き込みだけ WriteDiscard）。
+//        頂点の位置は頂点の大きさの倍数へ進めてあり、バッファは先頭から設定して、追記した
+//        位置は DrawIndexed の最初のインデックスと頂点の番号で指定します。末尾に入らない
+//        場合は分けずに先頭へ戻って書き込みます。
+//        フェンスはフレーム番号で、ConstantRing と同じく FRAME_LATENCY フレームより前の
+//        フレームの範囲を再利用します。空きが足りない場合はためた線を捨てて失敗を数えます。
+//        Flush の前にシェーダー・入力レイアウト・ステートは呼び出し側で設定してください
+//        （頂点バッファ・インデックスバッファ・プリミティブの種類は Flush が設定します）。
+//        頂点の並びは DirectXTK の VertexPositionColor と同じです。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	// 初期化（バッファは CPU から書き込める頂点バッファとインデックスバッファ）
+//	m_debugStream.Initialize(vertexBuffer, 1024 * 1024, indexBuffer, 256 * 1024);
+//
+//	// フレームの最初
+//	m_debugStream.BeginFrame();
+//
+//	// フレームの間に線を追加する（DX::Draw などのストリーム版を使う）
+//	DX::Draw(&m_debugStream, boundingBox, Colors::Yellow);
+//
+//	// エフェクトと入力レイアウトを設定してからまとめて描画する
+//	basicEffect->Apply(context);
+//	context->IASetInputLayout(inputLayout);
+//	m_debugStream.Flush(renderContext);
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "RenderContext.h"
+#include "ConstantRing.h"
+
+namespace Imase
+{
+	// 頂点（DirectXTK の VertexPositionColor と同じ並び）
+	struct TransientVertex
+	{
+		float position[3];
+		float color[4];
+	};
+
+	// ストリームの計測結果（１フレーム分）
+	struct TransientGeometryStats
+	{
+		// 追加した図形の数（PrimitiveBatch ではストリップごとに描画が分かれていた単位）
+		uint32_t primitives;
+
+		// 描画した頂点とインデックスの数
+		uint32_t vertices;
+		uint32_t indices;
+
+		// バッファへ書き込んだバイト数（頂点とインデックスの合計）
+		uint64_t streamedBytes;
+
+		// 描画した回数
+		uint32_t draws;
+
+		// Map した回数と、そのうち WriteDiscard で Map した回数
+		uint32_t maps;
+		uint32_t discards;
+
+		// 空きが足りずに描画できなかった回数
+		uint32_t failures;
+	};
+
+	// フレームの間の線をまとめて描画するストリーム
+	class TransientGeometryStream
+	{
+	public:
+
+		// GPU が遅れる最大のフレーム数（これより前のフレームは GPU が使い終わっている）
+		static constexpr uint64_t FRAME_LATENCY = ConstantRing::FRAME_LATENCY;
+
+		// 頂点の大きさ（頂点バッファの中の位置はこの倍数に揃える）
+		static constexpr uint32_t VERTEX_STRIDE = sizeof(TransientVertex);
+
+		TransientGeometryStream() = default;
+
+		TransientGeometryStream(const TransientGeometryStream&) = delete;
+		TransientGeometryStream& operator=(const TransientGeometryStream&) = delete;
+
+		/// <summary>
+		/// 書き込むバッファを設定する関数
+		/// </summary>
+		/// <param name="vertexBuffer">CPU から書き込める頂点バッファ（nullptr の場合は使わない）</param>
+		/// <param name="vertexCapacity">頂点バッファのバイト数</param>
+		/// <param name="indexBuffer">CPU から書き込めるインデックスバッファ（32 ビットのインデックス）</param>
+		/// <param name="indexCapacity">インデックスバッファのバイト数</param>
+		void Initialize(RenderBuffer* vertexBuffer, uint32_t vertexCapacity, RenderBuffer* indexBuffer, uint32_t indexCapacity);
+
+		// バッファを設定したか調べる関数
+		bool IsValid() const { return m_vertexBuffer && m_indexBuffer; }
+
+		// フレームの最初に呼ぶ関数（前のフレームを終わらせて、古いフレームの範囲を再利用する）
+		void BeginFrame();
+
+		// ラインリストを追加する関数（２頂点で１本）
+		void AddLines(const TransientVertex* vertices, uint32_t vertexCount);
+
+		// ラインストリップを追加する関数（ラインリストへ変換する）
+		void AddLineStrip(const TransientVertex* vertices, uint32_t vertexCount);
+
+		// インデックス付きのラインリストを追加する関数
+		void AddIndexedLines(const uint16_t* indices, uint32_t indexCount, const TransientVertex* vertices, uint32_t vertexCount);
+
+		// 線を１本追加する関数
+		void AddLine(const TransientVertex& v1, const TransientVertex& v2);
+
+		// 描画していない線があるか調べる関数
+		bool IsEmpty() const { return m_indices.empty(); }
+
+		/// <summary>
+		/// ためた線をバッファへ書き込んで描画する関数
+		/// </summary>
+		/// <param name="context">Map して描画するコンテキスト（イミディエイトコンテキスト）</param>
+		/// <returns>描画した場合は true</returns>
+		bool Flush(IRenderContext* context);
+
+		// ためた線を描画せずに捨てる関数
+		void Clear();
+
+		// 頂点とインデックスのアロケーターを取得する関数
+		const ConstantRingAllocator& GetVertexAllocator() const { return m_vertexAllocator; }
+		const ConstantRingAllocator& GetIndexAllocator() const { return m_indexAllocator; }
+
+		// 前のフレームの計測結果を取得する関数
+		const TransientGeometryStats& GetStats() const { return m_lastStats; }
+
+		// 現在のフレームの計測結果を取得する関数
+		const TransientGeometryStats& GetFrameStats() const { return m_stats; }
+
+	private:
+
+		// 確保した位置へ書き込む関数
+		bool Write(IRenderContext* context, RenderBuffer* buffer, bool* discard, uint32_t offset, const void* data, uint32_t size);
+
+	private:
+
+		// 書き込むバッファ
+		RenderBuffer* m_vertexBuffer = nullptr;
+		RenderBuffer* m_indexBuffer = nullptr;
+
+		// バッファの中の位置を確保するアロケーター
+		ConstantRingAllocator m_vertexAllocator;
+		ConstantRingAllocator m_indexAllocator;
+
+		// フレーム番号（フェンスの値）
+		uint64_t m_frame = 0;
+
+		// 次の Map を WriteDiscard にする場合は true
+		bool m_vertexDiscard = true;
+		bool m_indexDiscard = true;
+
+		// 描画していない頂点とインデックス（使い回すので、量が安定すればヒープから確保しない）
+		std::vector<TransientVertex> m_vertices;
+		std::vector<uint32_t> m_indices;
+
+		// 現在のフレームと前のフレームの計測結果
+		TransientGeometryStats m_stats = {};
+		TransientGeometryStats m_lastStats = {};
+	};
+}
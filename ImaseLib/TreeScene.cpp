@@ -0,0 +1,474 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TreeScene.cpp
+//
+// 木と森（インスタンス描画）のシーン
+//
+// ※ Windows 以外の環境でもコンパイルできるようにプリコンパイル済みヘッダーは使用しない
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TreeScene.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "FastTrig.h"
+
+using namespace Imase;
+
+namespace
+{
+	// 木のバウンディングスフィア（幅２×高さ２のポリゴン）
+	constexpr Math::Vector3 TREE_CENTER = Math::Vector3(0.0f, 1.0f, 0.0f);
+	constexpr float TREE_RADIUS = 1.41421356f;
+
+	// 木の AABB の大きさの半分（厚さのないポリゴン）
+	constexpr Math::Vector3 TREE_EXTENTS = Math::Vector3(1.0f, 1.0f, 0.0f);
+
+	// 木のスケール
+	constexpr float TREE_SCALE = 2.0f;
+}
+
+//--------------------------------------------------------------------------------------
+// 四角形ポリゴンの頂点とインデックス
+//--------------------------------------------------------------------------------------
+const TreeScene::Vertex TreeScene::QUAD_VERTICES[4] =
+{
+	{ {  -0.5f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f },{ 0.0f, 0.0f },{ 0.0f, 0.0f, 1.0f } },	// 0
+	{ {   0.5f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 1.0f },{ 1.0f, 0.0f },{ 0.0f, 0.0f, 1.0f } },	// 1
+	{ {   0.5f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 1.0f },{ 1.0f, 1.0f },{ 0.0f, 0.0f, 1.0f } },	// 2
+	{ {  -0.5f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f, 1.0f },{ 0.0f, 1.0f },{ 0.0f, 0.0f, 1.0f } },	// 3
+};
+
+const uint16_t TreeScene::QUAD_INDICES[6] = { 0, 1, 2, 0, 2, 3 };
+
+//--------------------------------------------------------------------------------------
+// ライトの方向を取得する関数
+//--------------------------------------------------------------------------------------
+Math::Vector3 TreeScene::GetLightDirection(double totalSeconds)
+{
+	// Forward を Y 軸回りに回転させたもの（回転行列を作らずに直接求める）
+	float s, c;
+	Math::SinCos(static_cast<float>(totalSeconds), &s, &c);
+
+	return Math::Vector3(-s, 0.0f, -c);
+}
+
+//--------------------------------------------------------------------------------------
+// 森の木を配置する関数
+//--------------------------------------------------------------------------------------
+void TreeScene::Initialize()
+{
+	m_world.Clear();
+
+	// 毎回同じ森になるように乱数の種は固定する
+	uint32_t seed = 12345;
+	auto random = [&seed]()
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<float>(seed >> 8) / static_cast<float>(1 << 24);
+	};
+
+	for (int z = 0; z < FOREST_SIZE; z++)
+	{
+		for (int x = 0; x < FOREST_SIZE; x++)
+		{
+			float px = (x - FOREST_SIZE / 2 + random()) * FOREST_SPACING;
+			float pz = (z - FOREST_SIZE / 2 + random()) * FOREST_SPACING;
+			float scale = 1.5f + random();
+			float shade = 0.7f + 0.3f * random();
+
+			// 中央の床の範囲には置かない
+			if (fabsf(px) < FOREST_CLEARING && fabsf(pz) < FOREST_CLEARING) continue;
+
+			m_world.Create(
+				TreeTransform{ Math::Vector3(px, 0.0f, pz), scale },
+				TreeTint{ Math::Vector4(shade, shade, shade, 1.0f) });
+		}
+	}
+
+	m_quadInstanceBatch.Reserve(MAX_QUAD_INSTANCES);
+
+	m_isForestDirty = true;
+	Update();
+}
+
+//--------------------------------------------------------------------------------------
+// 森の木のエンティティからカリングとインスタンスのデータの作成に使う配列を作る関数
+//--------------------------------------------------------------------------------------
+bool TreeScene::Update()
+{
+	// エンティティが変わっていない場合は前の配列をそのまま使う
+	if (!m_isForestDirty) return false;
+	m_isForestDirty = false;
+
+	size_t count = m_world.Count<TreeTransform, TreeTint>();
+	m_forestPositions.resize(count);
+	m_forestScales.resize(count);
+	m_forestTints.resize(count);
+	m_forestCenterX.resize(count);
+	m_forestCenterY.resize(count);
+	m_forestCenterZ.resize(count);
+	m_forestRadius.resize(count);
+	m_forestExtentX.resize(count);
+	m_forestExtentY.resize(count);
+	m_forestExtentZ.assign(count, 0.0f);
+	m_forestCandidateIndices.resize(count);
+	m_forestVisibleIndices.resize(count);
+
+	// チャンクごとに先頭から順に読み、並べた配列のチャンクの位置へ書き出す
+	// バウンディングスフィアと AABB は幅 scale × 高さ scale のポリゴン
+	m_world.ParallelForEach<TreeTransform, TreeTint>(
+		[&](const EntityChunkView& chunk, const TreeTransform* transforms, const TreeTint* tints)
+		{
+			for (size_t i = 0; i < chunk.count; i++)
+			{
+				size_t index = chunk.offset + i;
+				const Math::Vector3& position = transforms[i].position;
+				float scale = transforms[i].scale;
+
+				m_forestPositions[index] = position;
+				m_forestScales[index] = scale;
+				m_forestTints[index] = tints[i].color;
+
+				m_forestCenterX[index] = position.x;
+				m_forestCenterY[index] = position.y + scale * 0.5f;
+				m_forestCenterZ[index] = position.z;
+				m_forestRadius[index] = scale * 0.70710678f;
+				m_forestExtentX[index] = scale * 0.5f;
+				m_forestExtentY[index] = scale * 0.5f;
+			}
+		});
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// 描画に使用するリソースとコンテキストを設定する関数
+//--------------------------------------------------------------------------------------
+void TreeScene::SetResources(const TreeSceneResources& resources, StateFilteredContext<IRenderContext>* context)
+{
+	m_resources = resources;
+	m_context = context;
+
+	// 新しいバッファなので次の Submit で必ず書き込む
+	m_frameConstants.Initialize(resources.frameConstantBuffer);
+	m_treeMaterialConstants.Initialize(resources.treeMaterialConstantBuffer);
+	m_objectConstants.Initialize(resources.objectConstantBuffer);
+}
+
+//--------------------------------------------------------------------------------------
+// 遮蔽物を追加する関数
+//--------------------------------------------------------------------------------------
+bool TreeScene::AddOccluder(const Math::Vector3* positions, size_t vertexCount,
+	const uint16_t* indices, size_t indexCount, const Math::Matrix& world)
+{
+	size_t base = m_occluderPositions.size();
+	if (base + vertexCount > 0x10000) return false;
+
+	// 毎フレーム変換しなくてよいようにワールド座標で保持する
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		m_occluderPositions.push_back(world.TransformPoint(positions[i]));
+	}
+	for (size_t i = 0; i < indexCount; i++)
+	{
+		m_occluderIndices.push_back(static_cast<uint16_t>(base + indices[i]));
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// 遮蔽物を全て削除する関数
+//--------------------------------------------------------------------------------------
+void TreeScene::ClearOccluders()
+{
+	m_occluderPositions.clear();
+	m_occluderIndices.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// カリングとインスタンスのデータの更新を行い、描画パケットを積む関数
+//--------------------------------------------------------------------------------------
+void TreeScene::Submit(RenderQueue* queue, uint32_t layer, const TreeSceneView& view)
+{
+	m_viewProjection = view.viewProjection;
+	m_lightDirection = view.lightDirection;
+
+	// カスケードシャドウの行列を計算し、影を落とすオブジェクトをカリングする
+	{
+		m_shadowCascades = ComputeShadowCascades(
+			view.view, view.fovY, view.aspectRatio, view.nearPlane, view.farPlane,
+			view.lightDirection, m_shadowSettings);
+		WriteShadowConstants(m_shadowCascades, &m_shadowConstants);
+
+		SphereArrays casters = { &TREE_CENTER.x, &TREE_CENTER.y, &TREE_CENTER.z, &TREE_RADIUS };
+		CullShadowCasters(m_shadowCascades, casters, 1, nullptr, nullptr, m_shadowCasterCounts);
+	}
+
+	// 遮蔽物をラスタライズする（遮蔽物がない場合は計測結果のクリアだけ行う）
+	m_occlusionCuller.BeginFrame(view.viewProjection);
+	if (!m_occluderIndices.empty())
+	{
+		m_occlusionCuller.AddOccluder(m_occluderPositions.data(), m_occluderPositions.size(),
+			m_occluderIndices.data(), m_occluderIndices.size(), Math::Matrix::Identity());
+		m_occlusionCuller.RenderOccluders();
+	}
+
+	// 木（視錐台の外にある場合と遮蔽物に隠れている場合は描画しない）
+	bool isTreeVisible = view.frustum.Intersects(TREE_CENTER, TREE_RADIUS)
+		&& (m_occluderIndices.empty() || m_occlusionCuller.IsVisible(TREE_CENTER, TREE_EXTENTS));
+	if (isTreeVisible)
+	{
+		float depth = (view.eyePosition - TREE_CENTER).Length();
+		queue->Submit(layer, SHADER_QUAD, TEXTURE_TREE, depth, DRAW_TREE);
+	}
+
+	// 森（インスタンス描画）
+	SubmitForest(queue, layer, view);
+
+	// 定数バッファへまとめて書き込む（描画では設定するだけなので、並列に記録しても書き込まない）
+	UpdateConstants(isTreeVisible);
+}
+
+//--------------------------------------------------------------------------------------
+// 森をカリングしてインスタンスのデータを更新し、テクスチャごとにパケットを積む関数
+//--------------------------------------------------------------------------------------
+void TreeScene::SubmitForest(RenderQueue* queue, uint32_t layer, const TreeSceneView& view)
+{
+	m_forestInstanceCount = 0;
+	m_forestDrawCount = 0;
+
+	// 視錐台カリング（遮蔽物がある場合は結果をオクルージョンカリングの候補にする）
+	bool hasOccluders = !m_occluderIndices.empty();
+	uint32_t* frustumVisible = hasOccluders ? m_forestCandidateIndices.data() : m_forestVisibleIndices.data();
+
+	SphereArrays spheres =
+	{
+		m_forestCenterX.data(), m_forestCenterY.data(), m_forestCenterZ.data(), m_forestRadius.data()
+	};
+	size_t visibleCount = CullSpheres(view.frustum, spheres, m_forestPositions.size(), frustumVisible);
+
+	// オクルージョンカリング
+	if (hasOccluders && visibleCount > 0)
+	{
+		BoxArrays boxes =
+		{
+			m_forestCenterX.data(), m_forestCenterY.data(), m_forestCenterZ.data(),
+			m_forestExtentX.data(), m_forestExtentY.data(), m_forestExtentZ.data()
+		};
+		visibleCount = m_occlusionCuller.CullBoxes(boxes, frustumVisible, visibleCount, m_forestVisibleIndices.data());
+	}
+	if (visibleCount == 0) return;
+
+	// 半透明のポリゴンなので奥から順に描画する（同じテクスチャの中では追加した順番が保たれる）
+	const Math::Vector3& eye = view.eyePosition;
+	auto distanceSquared = [&](uint32_t index)
+	{
+		const Math::Vector3& p = m_forestPositions[index];
+		float dx = p.x - eye.x;
+		float dz = p.z - eye.z;
+		return dx * dx + dz * dz;
+	};
+	std::sort(m_forestVisibleIndices.begin(), m_forestVisibleIndices.begin() + visibleCount,
+		[&](uint32_t a, uint32_t b) { return distanceSquared(a) > distanceSquared(b); });
+
+	// インスタンスのデータを作成する
+	m_quadInstanceBatch.Clear();
+	for (size_t i = 0; i < visibleCount; i++)
+	{
+		uint32_t index = m_forestVisibleIndices[i];
+		float scale = m_forestScales[index];
+		m_quadInstanceBatch.Add(TEXTURE_TREE,
+			m_forestPositions[index], Math::Quaternion(), Math::Vector3(scale, scale, scale),
+			m_forestTints[index]);
+	}
+	m_quadInstanceBatch.Build();
+
+	// インスタンス用の頂点バッファの更新（１フレームに１回、入りきらない場合は描画する時に分けて書き込む）
+	m_quadInstanceBatch.Upload(m_context->Get(), m_resources.instanceBuffer, MAX_QUAD_INSTANCES);
+
+	// テクスチャごとに１パケット（森は一番奥の木の距離で他の半透明のポリゴンと並べる）
+	float depth = sqrtf(distanceSquared(m_forestVisibleIndices[0]));
+	const auto& ranges = m_quadInstanceBatch.GetRanges();
+	for (size_t i = 0; i < ranges.size(); i++)
+	{
+		queue->Submit(layer, SHADER_INSTANCED_QUAD, ranges[i].texture, depth, DRAW_FOREST, static_cast<uint32_t>(i));
+	}
+
+	m_forestInstanceCount = m_quadInstanceBatch.GetInstanceCount();
+	m_forestDrawCount = m_quadInstanceBatch.GetDrawCount(MAX_QUAD_INSTANCES);
+}
+
+//--------------------------------------------------------------------------------------
+// 入力レイアウト・シェーダー・ステートを設定する関数
+//--------------------------------------------------------------------------------------
+void TreeScene::BindShader(uint32_t shader)
+{
+	BindShader(*m_context, shader);
+}
+
+//--------------------------------------------------------------------------------------
+// テクスチャを設定する関数
+//--------------------------------------------------------------------------------------
+void TreeScene::BindMaterial(uint32_t material)
+{
+	BindMaterial(*m_context, material);
+}
+
+//--------------------------------------------------------------------------------------
+// 描画する関数
+//--------------------------------------------------------------------------------------
+void TreeScene::Draw(const RenderPacket& packet)
+{
+	Draw(*m_context, packet);
+}
+
+//--------------------------------------------------------------------------------------
+// 入力レイアウト・シェーダー・ステートを指定したコンテキストへ設定する関数
+//--------------------------------------------------------------------------------------
+void TreeScene::BindShader(StateFilteredContext<IRenderContext>& context, uint32_t shader)
+{
+	// 頂点バッファと入力レイアウトの設定
+	if (shader == SHADER_INSTANCED_QUAD)
+	{
+		// スロット０：頂点、スロット１：インスタンス
+		RenderBuffer* buffers[] = { m_resources.vertexBuffer, m_resources.instanceBuffer };
+		uint32_t strides[] = { sizeof(Vertex), sizeof(QuadInstance) };
+		uint32_t offsets[] = { 0, 0 };
+		context.IASetVertexBuffers(0, 2, buffers, strides, offsets);
+		context.IASetInputLayout(m_resources.instancedInputLayout);
+		context.VSSetShader(m_resources.instancedVertexShader, nullptr, 0);
+	}
+	else
+	{
+		RenderBuffer* buffers[] = { m_resources.vertexBuffer };
+		uint32_t stride = sizeof(Vertex);
+		uint32_t offset = 0;
+		context.IASetVertexBuffers(0, 1, buffers, &stride, &offset);
+		context.IASetInputLayout(m_resources.inputLayout);
+		context.VSSetShader(m_resources.vertexShader, nullptr, 0);
+	}
+
+	// インデックスバッファの設定
+	context.IASetIndexBuffer(m_resources.indexBuffer, RenderIndexFormat::UInt16, 0);
+
+	// トポロジーの設定
+	context.IASetPrimitiveTopology(RenderTopology::TriangleList);
+
+	// フレームごとの定数バッファの設定（マテリアルごとはテクスチャと一緒に、オブジェクトごとは描画の時に設定する）
+	RenderBuffer* cBuffers[] = { m_resources.frameConstantBuffer };
+	context.VSSetConstantBuffers(CONSTANT_SLOT_FRAME, 1, cBuffers);
+
+	// ピクセルシェーダーの設定
+	context.PSSetShader(m_resources.pixelShader, nullptr, 0);
+
+	// サンプラーステートの設定
+	RenderSampler* samplers[] = { m_resources.samplerState };
+	context.PSSetSamplers(0, 1, samplers);
+
+	// ラスタライザーステートの設定
+	context.RSSetState(m_resources.rasterizerState);
+
+	// 深度ステンシルバッファの設定
+	context.OMSetDepthStencilState(m_resources.depthStencilState, 0);
+
+	// ブレンドステートの設定
+	context.OMSetBlendState(m_resources.blendState, nullptr, 0xffffffff);
+}
+
+//--------------------------------------------------------------------------------------
+// テクスチャを指定したコンテキストへ設定する関数
+//--------------------------------------------------------------------------------------
+void TreeScene::BindMaterial(StateFilteredContext<IRenderContext>& context, uint32_t material)
+{
+	// マテリアルの番号はテクスチャの番号
+	RenderShaderResource* textures[] = { m_resources.treeTexture };
+	context.PSSetShaderResources(0, 1, &textures[material]);
+
+	// マテリアルごとの定数バッファ（ライティングは頂点シェーダーで行う）
+	RenderBuffer* cBuffers[] = { m_resources.treeMaterialConstantBuffer };
+	context.VSSetConstantBuffers(CONSTANT_SLOT_MATERIAL, 1, &cBuffers[material]);
+}
+
+//--------------------------------------------------------------------------------------
+// 指定したコンテキストへ描画する関数
+//--------------------------------------------------------------------------------------
+void TreeScene::Draw(StateFilteredContext<IRenderContext>& filteredContext, const RenderPacket& packet)
+{
+	IRenderContext* context = filteredContext.Get();
+
+	switch (packet.command)
+	{
+	case DRAW_TREE:
+	{
+		// オブジェクトごとの定数バッファ（リングバッファの場合は書き込んだ範囲）
+		RenderBuffer* cBuffers[] = { m_useConstantRing ? m_resources.constantRing->GetBuffer() : m_resources.objectConstantBuffer };
+		if (m_useConstantRing)
+		{
+			filteredContext.VSSetConstantBuffers1(CONSTANT_SLOT_OBJECT, 1, cBuffers, &m_treeConstants.firstConstant, &m_treeConstants.numConstants);
+		}
+		else
+		{
+			filteredContext.VSSetConstantBuffers(CONSTANT_SLOT_OBJECT, 1, cBuffers);
+		}
+		context->DrawIndexed(6, 0, 0);
+		break;
+	}
+
+	case DRAW_FOREST:
+	{
+		// ワールド行列はインスタンスのデータにあるのでオブジェクトごとの定数は使わない
+
+		// 同じテクスチャのインスタンスをまとめて描画する
+		m_quadInstanceBatch.DrawRange(context, m_resources.instanceBuffer, MAX_QUAD_INSTANCES, packet.argument, 6);
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 内容が変わった定数バッファへ書き込む関数
+//--------------------------------------------------------------------------------------
+void TreeScene::UpdateConstants(bool isTreeVisible)
+{
+	IRenderContext* context = m_context->Get();
+
+	m_constantStats = {};
+
+	// フレームごとの定数（カメラもライトも動いていない場合は書き込まない）
+	FrameConstants frame = {};
+	frame.viewProjection = m_viewProjection.Transpose();	// シェーダーへ列優先行列を渡すため転置する
+	frame.lightDirection = m_lightDirection;
+	frame.lightColor = m_lightColor;
+	frame.ambientColor = m_ambientColor;
+	m_frameConstants.Update(context, &frame, sizeof(frame), &m_constantStats.frame);
+
+	// マテリアルごとの定数（色を変えた時だけ書き込む）
+	MaterialConstants material = {};
+	material.diffuseColor = m_materialColors[TEXTURE_TREE];
+	m_treeMaterialConstants.Update(context, &material, sizeof(material), &m_constantStats.material);
+
+	// オブジェクトごとの定数（木は原点にスケール２で置く、森のワールド行列はインスタンスのデータにある）
+	m_useConstantRing = false;
+	if (!isTreeVisible) return;
+
+	ObjectConstants object = {};
+	object.world = Math::Matrix::CreateScale(TREE_SCALE).Transpose();
+
+	// リングバッファは毎フレーム書き込む（描画するオブジェクトが多い場合に Map の回数と名前の付け替えが減る）
+	if (m_resources.constantRing && m_resources.constantRing->Write(context, &object, sizeof(object), &m_treeConstants))
+	{
+		m_useConstantRing = true;
+		m_constantStats.object.uploads++;
+		m_constantStats.object.uploadedBytes += sizeof(object);
+		return;
+	}
+
+	m_objectConstants.Update(context, &object, sizeof(object), &m_constantStats.object);
+}
@@ -0,0 +1,416 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TreeScene.h
+//
+// 木と森（インスタンス描画）のシーン
+//
+// Usage: 木の配置・視錐台カリング・インスタンスのデータの作成・カスケードシャドウの計算と
+//        描画パケットの作成を行います。描画は IRenderContext を通して行うので、
+//        D3D11RenderContext でも NullRenderContext でも同じ処理で描画できます。
+//        リソース（シェーダー・バッファ等）は所有者が作成して SetResources で渡します。
+//        頂点・インデックス・定数バッファのデータの形はこのクラスで決めているので、
+//        リソースを作成する時は QUAD_VERTICES 等を使ってください。
+//        AddOccluder で遮蔽物を追加すると、視錐台カリングの後に遮蔽物に隠れた木を
+//        オクルージョンカリングで取り除いてからパケットを積みます。
+//        森の木は EntityWorld のエンティティ（TreeTransform・TreeTint）として保持し、
+//        Update でチャンクを順に読んでカリング用の SoA 形式の配列を作り直します。
+//        配列を作り直すのは GetWorld でエンティティを変更できるようにした後だけで、
+//        木を追加・削除・移動した場合も次の Update で描画に反映されます。
+//        IParallelRenderPacketHandler の関数は引数のコンテキストへ描画し、シーンのデータは
+//        読むだけなので、ParallelRenderExecutor で複数のスレッドから同時に記録できます。
+//        定数バッファは更新の頻度で分けています（b0：フレームごと、b1：マテリアルごと、
+//        b2：オブジェクトごと）。どれも Submit で書き込み、内容が変わっていない場合は
+//        書き込みません（ハッシュ値で比べる）。描画では定数バッファを設定するだけです。
+//        resources.constantRing を設定すると、オブジェクトごとの定数はリングバッファへ書き込み、
+//        VSSetConstantBuffers1 で範囲を設定します（設定しない場合やリングバッファが一杯の場合は
+//        objectConstantBuffer へ書き込みます）。書き込んだバイト数は GetConstantStats で分かります。
+//        Windows に依存しないので、どの環境でもコンパイル・テストできます。
+//
+//	<<< 記述例 >>
+//	scene.Initialize();
+//	scene.SetResources(resources, &stateContext);
+//
+//	scene.Update();
+//	scene.Submit(&queue, LAYER_TRANSLUCENT, view);
+//	queue.Sort();
+//	queue.Execute(&scene);		// 他の描画もある場合は所有者のハンドラーから呼ぶ
+//
+// Date: 2026.10.16
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MathCore.h"
+#include "EntityWorld.h"
+#include "FrustumCulling.h"
+#include "OcclusionCulling.h"
+#include "ShadowCascades.h"
+#include "QuadInstanceBatch.h"
+#include "RenderQueue.h"
+#include "ParallelRenderExecutor.h"
+#include "RenderContext.h"
+#include "ConstantRing.h"
+#include "TrackedConstantBuffer.h"
+#include "StateFilteredContext.h"
+
+namespace Imase
+{
+	// シーンの描画に使用するリソース
+	struct TreeSceneResources
+	{
+		// 頂点バッファ・インデックスバッファ（QUAD_VERTICES・QUAD_INDICES）
+		RenderBuffer* vertexBuffer;
+		RenderBuffer* indexBuffer;
+
+		// インスタンス用の頂点バッファ（QuadInstance × MAX_QUAD_INSTANCES、CPU から書き込める）
+		RenderBuffer* instanceBuffer;
+
+		// フレームごと・木のマテリアル・オブジェクトごとの定数バッファ
+		// （TreeScene::FrameConstants・MaterialConstants・ObjectConstants、CPU から書き込める）
+		RenderBuffer* frameConstantBuffer;
+		RenderBuffer* treeMaterialConstantBuffer;
+		RenderBuffer* objectConstantBuffer;
+
+		// オブジェクトごとの定数を書き込むリングバッファ（nullptr の場合は objectConstantBuffer へ書き込む）
+		ConstantRing* constantRing;
+
+		// 入力レイアウト（スロット０：頂点）と頂点シェーダー
+		RenderInputLayout* inputLayout;
+		RenderVertexShader* vertexShader;
+
+		// 入力レイアウト（スロット０：頂点、スロット１：インスタンス）と頂点シェーダー（インスタンス描画用）
+		RenderInputLayout* instancedInputLayout;
+		RenderVertexShader* instancedVertexShader;
+
+		// ピクセルシェーダー
+		RenderPixelShader* pixelShader;
+
+		// 木のテクスチャ
+		RenderShaderResource* treeTexture;
+
+		// ステート
+		RenderSampler* samplerState;
+		RenderRasterizerState* rasterizerState;
+		RenderDepthStencilState* depthStencilState;
+		RenderBlendState* blendState;
+	};
+
+	// 森の木の位置とスケール（エンティティのコンポーネント）
+	struct TreeTransform
+	{
+		Math::Vector3 position;
+		float scale;
+	};
+
+	// 森の木の色（エンティティのコンポーネント）
+	struct TreeTint
+	{
+		Math::Vector4 color;
+	};
+
+	// シーンを描画するカメラとライト
+	struct TreeSceneView
+	{
+		// ビュー行列とビュー行列×射影行列
+		Math::Matrix view;
+		Math::Matrix viewProjection;
+
+		// 視錐台
+		Frustum frustum;
+
+		// 視点の位置
+		Math::Vector3 eyePosition;
+
+		// ライトの方向
+		Math::Vector3 lightDirection;
+
+		// 射影行列の視野角（縦方向）・アスペクト比・ニアクリップ・ファークリップ（カスケードシャドウ用）
+		float fovY;
+		float aspectRatio;
+		float nearPlane;
+		float farPlane;
+	};
+
+	// 定数バッファへ書き込んだ回数とバイト数（１フレーム分）
+	struct TreeSceneConstantStats
+	{
+		// フレームごと・マテリアルごと・オブジェクトごとの定数
+		ConstantUploadStats frame;
+		ConstantUploadStats material;
+		ConstantUploadStats object;
+
+		// 書き込んだバイト数の合計を取得する関数
+		uint64_t GetUploadedBytes() const { return frame.uploadedBytes + material.uploadedBytes + object.uploadedBytes; }
+	};
+
+	// 木と森のシーン
+	class TreeScene : public IRenderPacketHandler, public IParallelRenderPacketHandler
+	{
+	public:
+
+		// シェーダー
+		static constexpr uint32_t SHADER_QUAD = 0;
+		static constexpr uint32_t SHADER_INSTANCED_QUAD = 1;
+
+		// テクスチャ（マテリアルの番号）
+		static constexpr uint32_t TEXTURE_TREE = 0;
+		static constexpr uint32_t MATERIAL_COUNT = 1;
+
+		// 描画の種類（所有者の描画の種類と重ならないように 0x100 から）
+		static constexpr uint32_t DRAW_TREE = 0x100;
+		static constexpr uint32_t DRAW_FOREST = 0x101;		// 引数はインスタンスの範囲の番号
+
+		// 森の木の並び（FOREST_SIZE × FOREST_SIZE、中央の床の範囲には置かない）
+		static constexpr int FOREST_SIZE = 64;
+		static constexpr float FOREST_SPACING = 1.5f;
+		static constexpr float FOREST_CLEARING = 6.0f;
+
+		// インスタンス用の頂点バッファに入るインスタンスの最大数（超えた分の遠くの木は描画しない）
+		static constexpr uint32_t MAX_QUAD_INSTANCES = FOREST_SIZE * FOREST_SIZE;
+
+		// 頂点（48バイト、頂点バッファへそのままコピーできる配置）
+		struct Vertex
+		{
+			float position[3];
+			float color[4];
+			float textureCoordinate[2];
+			float normal[3];
+		};
+
+		// 定数バッファのスロット
+		static constexpr uint32_t CONSTANT_SLOT_FRAME = 0;
+		static constexpr uint32_t CONSTANT_SLOT_MATERIAL = 1;
+		static constexpr uint32_t CONSTANT_SLOT_OBJECT = 2;
+
+		// フレームごとの定数（b0、112バイト、シェーダーへ渡す行列は転置済み）
+		struct FrameConstants
+		{
+			// ビュー行列×プロジェクション行列
+			Math::Matrix viewProjection;
+
+			// ライトの方向ベクトル
+			Math::Vector3 lightDirection;
+			float padding;
+
+			// ライトの色と環境光の色
+			Math::Vector4 lightColor;
+			Math::Vector4 ambientColor;
+		};
+
+		// マテリアルごとの定数（b1、16バイト）
+		struct MaterialConstants
+		{
+			// ディフューズ色
+			Math::Vector4 diffuseColor;
+		};
+
+		// オブジェクトごとの定数（b2、64バイト、シェーダーへ渡す行列は転置済み）
+		struct ObjectConstants
+		{
+			// ワールド行列
+			Math::Matrix world;
+		};
+
+		// 四角形ポリゴンの頂点とインデックス（幅１×高さ１、下辺の中央が原点）
+		static const Vertex QUAD_VERTICES[4];
+		static const uint16_t QUAD_INDICES[6];
+
+		/// <summary>
+		/// ライトの方向を取得する関数（経過時間で Y 軸回りに回転する）
+		/// </summary>
+		/// <param name="totalSeconds">経過時間（秒）</param>
+		static Math::Vector3 GetLightDirection(double totalSeconds);
+
+		/// <summary>
+		/// 森の木を配置する関数（毎回同じ配置になる）
+		/// </summary>
+		void Initialize();
+
+		/// <summary>
+		/// 森の木のエンティティからカリングとインスタンスのデータの作成に使う配列を作る関数（Submit の前に呼ぶ）
+		/// （GetWorld でエンティティを変更できるようにした後だけ作り直す）
+		/// </summary>
+		/// <returns>配列を作り直した場合は true</returns>
+		bool Update();
+
+		/// <summary>
+		/// 描画に使用するリソースとコンテキストを設定する関数
+		/// </summary>
+		/// <param name="resources">リソース</param>
+		/// <param name="context">ステートの設定を省略するコンテキスト（所有者がフレームをまたいで保持する）</param>
+		void SetResources(const TreeSceneResources& resources, StateFilteredContext<IRenderContext>* context);
+
+		// ライトの色と環境光の色を設定する関数（次の Submit で定数バッファへ書き込む）
+		void SetLightColor(const Math::Vector4& lightColor, const Math::Vector4& ambientColor)
+		{
+			m_lightColor = lightColor;
+			m_ambientColor = ambientColor;
+		}
+
+		// マテリアルのディフューズ色を設定する関数（次の Submit で定数バッファへ書き込む）
+		void SetMaterialColor(uint32_t material, const Math::Vector4& diffuseColor) { m_materialColors[material] = diffuseColor; }
+
+		/// <summary>
+		/// 遮蔽物を追加する関数（ワールド座標に変換して保持し、毎フレームラスタライズする）
+		/// </summary>
+		/// <param name="positions">頂点の位置</param>
+		/// <param name="vertexCount">頂点の数</param>
+		/// <param name="indices">インデックス（三角形リスト）</param>
+		/// <param name="indexCount">インデックスの数</param>
+		/// <param name="world">ワールド行列</param>
+		/// <returns>頂点の数が 16 ビットのインデックスの範囲を超える場合は false</returns>
+		bool AddOccluder(const Math::Vector3* positions, size_t vertexCount,
+			const uint16_t* indices, size_t indexCount, const Math::Matrix& world);
+
+		// 遮蔽物を全て削除する関数
+		void ClearOccluders();
+
+		/// <summary>
+		/// カリングとインスタンスのデータの更新を行い、描画パケットを積む関数
+		/// </summary>
+		/// <param name="queue">レンダーキュー</param>
+		/// <param name="layer">木と森を積むレイヤー（半透明なので奥から順に並べるレイヤー）</param>
+		/// <param name="view">カメラとライト</param>
+		void Submit(RenderQueue* queue, uint32_t layer, const TreeSceneView& view);
+
+		// ----- IRenderPacketHandler ----- //
+
+		void BindShader(uint32_t shader) override;
+		void BindMaterial(uint32_t material) override;
+		void Draw(const RenderPacket& packet) override;
+
+		// ----- IParallelRenderPacketHandler ----- //
+
+		void BindShader(StateFilteredContext<IRenderContext>& context, uint32_t shader) override;
+		void BindMaterial(StateFilteredContext<IRenderContext>& context, uint32_t material) override;
+		void Draw(StateFilteredContext<IRenderContext>& context, const RenderPacket& packet) override;
+
+		// ----- 計測結果 ----- //
+
+		// カスケードシャドウの設定
+		ShadowCascadeSettings& GetShadowSettings() { return m_shadowSettings; }
+
+		// カスケードシャドウの計算結果
+		const ShadowCascades& GetShadowCascades() const { return m_shadowCascades; }
+
+		// シャドウマップ描画用の定数
+		const ShadowConstants& GetShadowConstants() const { return m_shadowConstants; }
+
+		// カスケードごとの影を落とすオブジェクトの数
+		const size_t* GetShadowCasterCounts() const { return m_shadowCasterCounts; }
+
+		// 森の木の数（前の Update の時点）
+		size_t GetForestTreeCount() const { return m_forestPositions.size(); }
+
+		// 森の木のエンティティ（変更されるかもしれないので、次の Update で配列を作り直す）
+		EntityWorld& GetWorld() { m_isForestDirty = true; return m_world; }
+		const EntityWorld& GetWorld() const { return m_world; }
+
+		// 描画した森のインスタンスの数と描画の回数
+		size_t GetForestInstanceCount() const { return m_forestInstanceCount; }
+		size_t GetForestDrawCount() const { return m_forestDrawCount; }
+
+		// 遮蔽物の三角形の数
+		size_t GetOccluderTriangleCount() const { return m_occluderIndices.size() / 3; }
+
+		// オクルージョンカリングの計測結果（隠れていた木の数と処理時間）
+		const OcclusionCullingStats& GetOcclusionStats() const { return m_occlusionCuller.GetStats(); }
+
+		// 前の Submit で定数バッファへ書き込んだ回数とバイト数
+		const TreeSceneConstantStats& GetConstantStats() const { return m_constantStats; }
+
+	private:
+
+		// 森をカリングしてインスタンスのデータを更新し、テクスチャごとにパケットを積む関数
+		void SubmitForest(RenderQueue* queue, uint32_t layer, const TreeSceneView& view);
+
+		// 内容が変わった定数バッファへ書き込む関数（木を描画する場合はオブジェクトごとの定数も書き込む）
+		void UpdateConstants(bool isTreeVisible);
+
+	private:
+
+		// リソース
+		TreeSceneResources m_resources = {};
+
+		// ステートの設定を省略するコンテキスト
+		StateFilteredContext<IRenderContext>* m_context = nullptr;
+
+		// このフレームのビュー行列×射影行列とライトの方向
+		Math::Matrix m_viewProjection;
+		Math::Vector3 m_lightDirection;
+
+		// ライトの色と環境光の色、マテリアルのディフューズ色
+		Math::Vector4 m_lightColor = Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+		Math::Vector4 m_ambientColor = Math::Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+		Math::Vector4 m_materialColors[MATERIAL_COUNT] = { Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f) };
+
+		// 内容が変わった時だけ書き込む定数バッファ（フレームごと・木のマテリアル・オブジェクトごと）
+		TrackedConstantBuffer m_frameConstants;
+		TrackedConstantBuffer m_treeMaterialConstants;
+		TrackedConstantBuffer m_objectConstants;
+
+		// このフレームの木の定数をリングバッファへ書き込んだ場合は true と、その範囲
+		bool m_useConstantRing = false;
+		ConstantRingRange m_treeConstants = {};
+
+		// 前の Submit で定数バッファへ書き込んだ回数とバイト数
+		TreeSceneConstantStats m_constantStats = {};
+
+		// カスケードシャドウの設定
+		ShadowCascadeSettings m_shadowSettings;
+
+		// カスケードシャドウの計算結果
+		ShadowCascades m_shadowCascades = {};
+
+		// シャドウマップ描画用の定数（シャドウ用の定数バッファへそのままコピーできる）
+		ShadowConstants m_shadowConstants = {};
+
+		// カスケードごとの影を落とすオブジェクトの数
+		size_t m_shadowCasterCounts[MAX_SHADOW_CASCADES] = {};
+
+		// 森の木のエンティティ
+		EntityWorld m_world;
+
+		// エンティティが変更されたかもしれない場合は true（Update で配列を作り直す）
+		bool m_isForestDirty = true;
+
+		// 森の木の位置・スケール・色（Update でエンティティから並べたもの、以下の配列の番号は同じ木を指す）
+		std::vector<Math::Vector3> m_forestPositions;
+		std::vector<float> m_forestScales;
+		std::vector<Math::Vector4> m_forestTints;
+
+		// 森の木のバウンディングスフィア（SoA形式、カリング用）
+		std::vector<float> m_forestCenterX;
+		std::vector<float> m_forestCenterY;
+		std::vector<float> m_forestCenterZ;
+		std::vector<float> m_forestRadius;
+
+		// 森の木の AABB の大きさの半分（SoA形式、オクルージョンカリング用、中心はバウンディングスフィアと同じ）
+		std::vector<float> m_forestExtentX;
+		std::vector<float> m_forestExtentY;
+		std::vector<float> m_forestExtentZ;
+
+		// 視錐台の中にある木の番号（オクルージョンカリングの前）
+		std::vector<uint32_t> m_forestCandidateIndices;
+
+		// 見えている木の番号
+		std::vector<uint32_t> m_forestVisibleIndices;
+
+		// 遮蔽物（ワールド座標）
+		std::vector<Math::Vector3> m_occluderPositions;
+		std::vector<uint16_t> m_occluderIndices;
+
+		// オクルージョンカリング
+		OcclusionCuller m_occlusionCuller;
+
+		// インスタンス描画のデータ
+		QuadInstanceBatch m_quadInstanceBatch;
+
+		// 描画したインスタンスの数と描画の回数
+		size_t m_forestInstanceCount = 0;
+		size_t m_forestDrawCount = 0;
+	};
+}
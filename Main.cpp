@@ -41,7 +41,6 @@ extern "C"
 int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ int nCmdShow)
 {
     UNREFERENCED_PARAMETER(hPrevInstance);
-    UNREFERENCED_PARAMETER(lpCmdLine);
 
     if (!XMVerifyCPUSupport())
         return 1;
@@ -50,6 +49,19 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     if (FAILED(hr))
         return 1;
 
+    // -scene-benchmark [t[]FV[iTreeScenej̕` CPU ̏Ԃ
+    // EChE GPU g킸ɌviQ[̃t[͎sȂj
+    if (wcsncmp(lpCmdLine, L"-scene-benchmark", 16) == 0)
+    {
+        int frameCount = _wtoi(lpCmdLine + 16);
+
+        g_game = std::make_unique<Game>();
+        int result = g_game->RunSceneBenchmark(frameCount > 0 ? static_cast<uint32_t>(frameCount) : 600);
+        g_game.reset();
+
+        return result;
+    }
+
     // L[{[h̍쐬
     std::unique_ptr<Keyboard> keyboard = std::make_unique<Keyboard>();
 
@@ -1,9 +1,31 @@
-cbuffer Parameters : register(b0)
+// Per-frame constants (Imase::TreeScene::FrameConstants)
+cbuffer PerFrame : register(b0)
 {
-    float4x4 WorldViewProj;
+    float4x4 ViewProj;
     float3 LightDirection;
+    float4 LightColor;
+    float4 AmbientColor;
 };
 
+// Per-material constants (Imase::TreeScene::MaterialConstants)
+cbuffer PerMaterial : register(b1)
+{
+    float4 DiffuseColor;
+};
+
+// Per-object constants (Imase::TreeScene::ObjectConstants)
+cbuffer PerObject : register(b2)
+{
+    float4x4 World;
+};
+
+float3 ComputeLight(float3 worldNormal)
+{
+    float3 dotL = mul(-LightDirection, worldNormal);
+    float3 zeroL = step(0, dotL);
+    return AmbientColor.rgb + zeroL * dotL * LightColor.rgb;
+}
+
 struct VSInput
 {
     float4 Position : SV_Position;
@@ -12,6 +34,20 @@ struct VSInput
     float3 Normal : NORMAL;
 };
 
+// Per-instance data (Imase::QuadInstance)
+struct VSInstanceInput
+{
+    float4 Position : SV_Position;
+    float4 Color : COLOR0;
+    float2 TexCoord : TEXCOORD0;
+    float3 Normal : NORMAL;
+    float4 World0 : WORLD0;     // transposed world matrix rows
+    float4 World1 : WORLD1;
+    float4 World2 : WORLD2;
+    float4 Tint : COLOR1;
+    float4 UVRect : TEXCOORD1;  // u, v, width, height
+};
+
 struct VSOutput
 {
     float4 Diffuse : COLOR0;
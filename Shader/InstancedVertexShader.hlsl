@@ -0,0 +1,18 @@
+#include "Header.hlsli"
+
+// The world matrix comes from the instance data (PerObject is not used).
+
+VSOutput main(VSInstanceInput vin)
+{
+    VSOutput vout;
+
+    float4 position = float4(vin.Position.xyz, 1.0f);
+    float4 worldPosition = float4(dot(position, vin.World0), dot(position, vin.World1), dot(position, vin.World2), 1.0f);
+    float3 worldNormal = normalize(float3(dot(vin.Normal, vin.World0.xyz), dot(vin.Normal, vin.World1.xyz), dot(vin.Normal, vin.World2.xyz)));
+
+    vout.Position = mul(worldPosition, ViewProj);
+    vout.Diffuse = float4(ComputeLight(worldNormal), 1.0f) * DiffuseColor * vin.Tint;
+    vout.TexCoord = vin.UVRect.xy + vin.TexCoord * vin.UVRect.zw;
+
+    return vout;
+}
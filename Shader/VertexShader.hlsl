@@ -1,18 +1,14 @@
 #include "Header.hlsli"
 
-float3 ComputeLight(float3 worldNormal)
-{
-    float3 dotL = mul(-LightDirection, worldNormal);
-    float3 zeroL = step(0, dotL);
-    return zeroL * dotL;
-}
-
 VSOutput main(VSInput vin)
 {
     VSOutput vout;
     
-    vout.Position = mul(vin.Position, WorldViewProj);
-    vout.Diffuse = float4(ComputeLight(vin.Normal), 1.0f);
+    float4 worldPosition = mul(vin.Position, World);
+    float3 worldNormal = normalize(mul(vin.Normal, (float3x3)World));
+
+    vout.Position = mul(worldPosition, ViewProj);
+    vout.Diffuse = float4(ComputeLight(worldNormal), 1.0f) * DiffuseColor;
     vout.TexCoord = vin.TexCoord;
     
     return vout;
@@ -8,6 +8,10 @@
 #include <cstdint>
 #include <exception>
 
+#ifndef _WIN32
+#include <chrono>
+#endif
+
 
 namespace DX
 {
@@ -15,29 +19,43 @@ namespace DX
     class StepTimer
     {
     public:
+        // Function that returns the current value of a clock (in its own units).
+        using ClockFunction = uint64_t(*)(void* context);
+
         StepTimer() noexcept(false) :
             m_elapsedTicks(0),
             m_totalTicks(0),
             m_leftOverTicks(0),
+            m_frameElapsedTicks(0),
             m_frameCount(0),
             m_framesPerSecond(0),
             m_framesThisSecond(0),
             m_qpcSecondCounter(0),
             m_isFixedTimeStep(false),
-            m_targetElapsedTicks(TicksPerSecond / 60)
+            m_targetElapsedTicks(TicksPerSecond / 60),
+            m_maxUpdatesPerTick(0),
+            m_droppedUpdates(0)
         {
-            if (!QueryPerformanceFrequency(&m_qpcFrequency))
-            {
-                throw std::exception();
-            }
+            SetClock(QueryClock, nullptr, QueryClockFrequency());
+        }
 
-            if (!QueryPerformanceCounter(&m_qpcLastTime))
+        // Replace the clock used to measure time (for instance a fake clock for deterministic tests).
+        // The frequency is the number of clock units per second.
+        void SetClock(ClockFunction clock, void* context, uint64_t frequency)
+        {
+            if (!clock || frequency == 0)
             {
                 throw std::exception();
             }
 
+            m_clock = clock;
+            m_clockContext = context;
+            m_qpcFrequency = frequency;
+
             // Initialize max delta to 1/10 of a second.
-            m_qpcMaxDelta = static_cast<uint64_t>(m_qpcFrequency.QuadPart / 10);
+            m_qpcMaxDelta = m_qpcFrequency / 10;
+
+            ResetElapsedTime();
         }
 
         // Get elapsed time since the previous Update call.
@@ -48,6 +66,23 @@ namespace DX
         uint64_t GetTotalTicks() const noexcept { return m_totalTicks; }
         double GetTotalSeconds() const noexcept { return TicksToSeconds(m_totalTicks); }
 
+        // Get elapsed time of the previous Tick call (one rendered frame), however many updates it ran.
+        uint64_t GetFrameElapsedTicks() const noexcept { return m_frameElapsedTicks; }
+        double GetFrameElapsedSeconds() const noexcept { return TicksToSeconds(m_frameElapsedTicks); }
+
+        // Get how far the time has advanced past the last fixed timestep update, as a fraction of
+        // the timestep (0 to 1). Render the state interpolated between the last two updates by this
+        // amount to move smoothly at any frame rate. Always 1 in variable timestep mode.
+        double GetInterpolationAlpha() const noexcept
+        {
+            if (!m_isFixedTimeStep || m_targetElapsedTicks == 0)
+            {
+                return 1.0;
+            }
+
+            return static_cast<double>(m_leftOverTicks) / static_cast<double>(m_targetElapsedTicks);
+        }
+
         // Get total number of updates since start of the program.
         uint32_t GetFrameCount() const noexcept { return m_frameCount; }
 
@@ -61,6 +96,14 @@ namespace DX
         void SetTargetElapsedTicks(uint64_t targetElapsed) noexcept { m_targetElapsedTicks = targetElapsed; }
         void SetTargetElapsedSeconds(double targetElapsed) noexcept { m_targetElapsedTicks = SecondsToTicks(targetElapsed); }
 
+        // Set the maximum number of fixed timestep updates in one Tick call (0 means no limit).
+        // When the updates cannot keep up, the remaining whole timesteps are dropped instead of
+        // being carried over, so one slow frame cannot make every following frame slower.
+        void SetMaxUpdatesPerTick(uint32_t maxUpdates) noexcept { m_maxUpdatesPerTick = maxUpdates; }
+
+        // Get total number of fixed timestep updates dropped by the limit above.
+        uint64_t GetDroppedUpdateCount() const noexcept { return m_droppedUpdates; }
+
         // Integer format represents time using 10,000,000 ticks per second.
         static constexpr uint64_t TicksPerSecond = 10000000;
 
@@ -73,10 +116,7 @@ namespace DX
 
         void ResetElapsedTime()
         {
-            if (!QueryPerformanceCounter(&m_qpcLastTime))
-            {
-                throw std::exception();
-            }
+            m_qpcLastTime = m_clock(m_clockContext);
 
             m_leftOverTicks = 0;
             m_framesPerSecond = 0;
@@ -89,14 +129,9 @@ namespace DX
         void Tick(const TUpdate& update)
         {
             // Query the current time.
-            LARGE_INTEGER currentTime;
+            const uint64_t currentTime = m_clock(m_clockContext);
 
-            if (!QueryPerformanceCounter(&currentTime))
-            {
-                throw std::exception();
-            }
-
-            uint64_t timeDelta = static_cast<uint64_t>(currentTime.QuadPart - m_qpcLastTime.QuadPart);
+            uint64_t timeDelta = currentTime - m_qpcLastTime;
 
             m_qpcLastTime = currentTime;
             m_qpcSecondCounter += timeDelta;
@@ -109,7 +144,9 @@ namespace DX
 
             // Convert QPC units into a canonical tick format. This cannot overflow due to the previous clamp.
             timeDelta *= TicksPerSecond;
-            timeDelta /= static_cast<uint64_t>(m_qpcFrequency.QuadPart);
+            timeDelta /= m_qpcFrequency;
+
+            m_frameElapsedTicks = timeDelta;
 
             const uint32_t lastFrameCount = m_frameCount;
 
@@ -131,8 +168,21 @@ namespace DX
 
                 m_leftOverTicks += timeDelta;
 
+                uint32_t updateCount = 0;
+
                 while (m_leftOverTicks >= m_targetElapsedTicks)
                 {
+                    // Drop the whole timesteps the updates could not catch up with, but keep the
+                    // fraction so the interpolation alpha stays continuous.
+                    if (m_maxUpdatesPerTick != 0 && updateCount >= m_maxUpdatesPerTick)
+                    {
+                        m_droppedUpdates += m_leftOverTicks / m_targetElapsedTicks;
+                        m_leftOverTicks %= m_targetElapsedTicks;
+                        break;
+                    }
+
+                    updateCount++;
+
                     m_elapsedTicks = m_targetElapsedTicks;
                     m_totalTicks += m_targetElapsedTicks;
                     m_leftOverTicks -= m_targetElapsedTicks;
@@ -158,24 +208,63 @@ namespace DX
                 m_framesThisSecond++;
             }
 
-            if (m_qpcSecondCounter >= static_cast<uint64_t>(m_qpcFrequency.QuadPart))
+            if (m_qpcSecondCounter >= m_qpcFrequency)
             {
                 m_framesPerSecond = m_framesThisSecond;
                 m_framesThisSecond = 0;
-                m_qpcSecondCounter %= static_cast<uint64_t>(m_qpcFrequency.QuadPart);
+                m_qpcSecondCounter %= m_qpcFrequency;
             }
         }
 
     private:
-        // Source timing data uses QPC units.
-        LARGE_INTEGER m_qpcFrequency;
-        LARGE_INTEGER m_qpcLastTime;
+        // Default clock: QPC on Windows, the steady clock elsewhere.
+        static uint64_t QueryClock(void*)
+        {
+#ifdef _WIN32
+            LARGE_INTEGER time;
+
+            if (!QueryPerformanceCounter(&time))
+            {
+                throw std::exception();
+            }
+
+            return static_cast<uint64_t>(time.QuadPart);
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        static uint64_t QueryClockFrequency()
+        {
+#ifdef _WIN32
+            LARGE_INTEGER frequency;
+
+            if (!QueryPerformanceFrequency(&frequency))
+            {
+                throw std::exception();
+            }
+
+            return static_cast<uint64_t>(frequency.QuadPart);
+#else
+            using Period = std::chrono::steady_clock::period;
+            return static_cast<uint64_t>(Period::den / Period::num);
+#endif
+        }
+
+        // Clock used to measure time.
+        ClockFunction m_clock;
+        void* m_clockContext;
+
+        // Source timing data uses clock units (QPC units by default).
+        uint64_t m_qpcFrequency;
+        uint64_t m_qpcLastTime;
         uint64_t m_qpcMaxDelta;
 
         // Derived timing data uses a canonical tick format.
         uint64_t m_elapsedTicks;
         uint64_t m_totalTicks;
         uint64_t m_leftOverTicks;
+        uint64_t m_frameElapsedTicks;
 
         // Members for tracking the framerate.
         uint32_t m_frameCount;
@@ -186,5 +275,9 @@ namespace DX
         // Members for configuring fixed timestep mode.
         bool m_isFixedTimeStep;
         uint64_t m_targetElapsedTicks;
+
+        // Members for limiting the catch-up updates.
+        uint32_t m_maxUpdatesPerTick;
+        uint64_t m_droppedUpdates;
     };
 }
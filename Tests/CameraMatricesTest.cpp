@@ -0,0 +1,139 @@
+﻿//--------------------------------------------------------------------------------------
+// File: CameraMatricesTest.cpp
+//
+// CameraMatrices（複数のビュー行列・射影行列の作成）のテスト
+//
+// SIMD 版の結果がスカラー版（基準の実装）と一致することを、上向きのベクトルが視線と
+// 直交していない場合や、８・４で割り切れない端数を含めて確認します。
+// CMake では AVX を有効にした実行ファイル（CameraMatricesAvxTest）もビルドし、
+// ８つずつ計算する経路も同じテストで確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <random>
+
+#include "CameraMatrices.h"
+
+using namespace Imase::Math;
+
+namespace
+{
+	// 各要素の差が tolerance 以下か調べる関数
+	bool IsNear(const Matrix& a, const Matrix& b, float tolerance)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				if (std::fabs(a.m[i][j] - b.m[i][j]) > tolerance) return false;
+			}
+		}
+		return true;
+	}
+
+	// 乱数でカメラを作成する（上向きのベクトルは視線と直交させない）
+	void MakeCameras(size_t count, std::vector<Vector3>* eyes, std::vector<Vector3>* targets, std::vector<Vector3>* ups)
+	{
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+		std::uniform_real_distribution<float> tilt(-0.5f, 0.5f);
+		for (size_t i = 0; i < count; i++)
+		{
+			eyes->push_back(Vector3(position(random), position(random), position(random)));
+			targets->push_back(Vector3(position(random), position(random), position(random)));
+			ups->push_back(Vector3(tilt(random), 1.0f + tilt(random), tilt(random)) * 3.0f);
+		}
+	}
+}
+
+// 既知のカメラでビュー行列が期待した値になる
+TEST_CASE(LookAtKnownCamera)
+{
+	Vector3 eye(0.0f, 0.0f, 5.0f), target(0.0f, 0.0f, 0.0f), up(0.0f, 1.0f, 0.0f);
+	Matrix view;
+	CreateLookAtMatrices(&eye, &target, &up, &view, 1);
+
+	Matrix expected(
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, -5.0f, 1.0f);
+	CHECK(IsNear(view, expected, 1.0e-6f));
+}
+
+// SIMD 版とスカラー版が端数を含めて一致する（AVX の８つ・SSE2 の４つ・スカラーの組み合わせ）
+TEST_CASE(LookAtSimdMatchesScalar)
+{
+	for (size_t count = 0; count <= 19; count++)
+	{
+		std::vector<Vector3> eyes, targets, ups;
+		MakeCameras(count, &eyes, &targets, &ups);
+
+		std::vector<Matrix> simd(count), scalar(count);
+		CreateLookAtMatrices(eyes.data(), targets.data(), ups.data(), simd.data(), count);
+		CreateLookAtMatricesScalar(eyes.data(), targets.data(), ups.data(), scalar.data(), count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			// 平行移動は座標の大きさ（最大 50 程度）に比例した丸め誤差を含む
+			CHECK(IsNear(simd[i], scalar[i], 1.0e-4f));
+		}
+	}
+}
+
+// 上向きのベクトルが直交していなくても回転部分は正規直交になる
+TEST_CASE(LookAtIsOrthonormal)
+{
+	std::vector<Vector3> eyes, targets, ups;
+	MakeCameras(8, &eyes, &targets, &ups);
+
+	std::vector<Matrix> views(8);
+	CreateLookAtMatrices(eyes.data(), targets.data(), ups.data(), views.data(), views.size());
+
+	for (const Matrix& view : views)
+	{
+		for (int a = 0; a < 3; a++)
+		{
+			Vector3 axisA(view.m[0][a], view.m[1][a], view.m[2][a]);
+			CHECK_NEAR(axisA.Length(), 1.0f, 1.0e-5f);
+			for (int b = a + 1; b < 3; b++)
+			{
+				Vector3 axisB(view.m[0][b], view.m[1][b], view.m[2][b]);
+				CHECK_NEAR(axisA.Dot(axisB), 0.0f, 1.0e-5f);
+			}
+		}
+	}
+}
+
+// 射影行列の SIMD 版がスカラー版と std::tan を使う Matrix::CreatePerspective に一致する
+TEST_CASE(PerspectiveMatchesReference)
+{
+	const size_t count = 15;		// 8 + 4 + 3
+	float fovY[count], aspect[count], nearPlane[count], farPlane[count];
+	for (size_t i = 0; i < count; i++)
+	{
+		fovY[i] = 0.3f + 0.18f * static_cast<float>(i);
+		aspect[i] = 1.0f + 0.2f * static_cast<float>(i);
+		nearPlane[i] = 0.1f * static_cast<float>(i + 1);
+		farPlane[i] = 100.0f + 50.0f * static_cast<float>(i);
+	}
+
+	Matrix simd[count], scalar[count];
+	CreatePerspectiveMatrices(fovY, aspect, nearPlane, farPlane, simd, count);
+	CreatePerspectiveMatricesScalar(fovY, aspect, nearPlane, farPlane, scalar, count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Matrix reference = Matrix::CreatePerspective(fovY[i], aspect[i], nearPlane[i], farPlane[i]);
+		CHECK(IsNear(simd[i], scalar[i], 1.0e-5f));
+		CHECK(IsNear(scalar[i], reference, 1.0e-5f));
+	}
+}
+
+int main()
+{
+	return ImaseTest::RunTests();
+}
@@ -0,0 +1,255 @@
+﻿//--------------------------------------------------------------------------------------
+// File: CameraPathTest.cpp
+//
+// CameraPath・CameraPathPlayer（カメラの経路の記録・再生）のテスト
+//
+// バイナリファイルへの保存と読み込みでキーがビット単位で元に戻ることと、壊れたファイル
+// （ヘッダーの途中で終わる・識別子が違う・キーの途中で終わる・時間順でない）を読み込まずに
+// 元の内容を残すことを確認します。再生は固定のティック数で進めるので、フレームの処理時間を
+// 変えて２回再生してもカメラの状態がビット単位で同じになることと、経路の前後では端のキーに
+// 留まり、最後まで再生すると停止することを確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "CameraPath.h"
+
+using namespace Imase;
+
+namespace
+{
+	// テストで作るファイル（実行するディレクトリに作って最後に削除する）
+	const char* const FILE_NAME = "CameraPathTest.bin";
+
+	// 1 ティック = 1/60 秒で１フレームずつ進める
+	constexpr uint64_t TICKS_PER_SECOND = 60;
+	constexpr uint64_t TICKS_PER_FRAME = 1;
+
+	// 0 ～ 2 秒の経路
+	CameraPath MakePath()
+	{
+		CameraPath path;
+		path.AddKey({ 0.0f, 0.0f, 0.1f, 10.0f });
+		path.AddKey({ 0.5f, 0.7f, 0.3f, 12.0f });
+		path.AddKey({ 1.25f, 1.9f, -0.2f, 8.0f });
+		path.AddKey({ 2.0f, 3.1f, 0.0f, 9.5f });
+		return path;
+	}
+
+	// キーがビット単位で同じか調べる
+	bool IsSameKey(const CameraPathKey& a, const CameraPathKey& b)
+	{
+		return std::memcmp(&a, &b, sizeof(CameraPathKey)) == 0;
+	}
+
+	// バイト列をそのままファイルへ書き込む
+	void WriteBytes(const void* data, size_t size)
+	{
+		std::ofstream ofs(FILE_NAME, std::ios::binary);
+		ofs.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+	}
+
+	// 最後まで再生してフレームごとのカメラの状態を返す（処理時間はシードで変える）
+	std::vector<CameraPathKey> Play(const CameraPath& path, uint32_t seed, CameraPathPlayer* player)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<double> frameSeconds(0.001, 0.05);
+
+		std::vector<CameraPathKey> keys;
+		player->Start(path, TICKS_PER_FRAME, TICKS_PER_SECOND);
+		CameraPathKey key = {};
+		while (player->Advance(frameSeconds(random), &key)) keys.push_back(key);
+		return keys;
+	}
+}
+
+// 保存して読み込んだキーはビット単位で元と同じ
+TEST_CASE(SaveLoadRoundTrip)
+{
+	CameraPath path = MakePath();
+	CHECK(path.Save(FILE_NAME));
+
+	CameraPath loaded;
+	CHECK(loaded.Load(FILE_NAME));
+	CHECK_EQUAL(loaded.GetKeyCount(), path.GetKeyCount());
+	for (size_t i = 0; i < path.GetKeyCount(); i++)
+	{
+		CHECK(IsSameKey(loaded.GetKey(i), path.GetKey(i)));
+	}
+
+	// キーが 0 個の経路も保存・読み込みできる
+	CameraPath empty;
+	CHECK(empty.Save(FILE_NAME));
+	CHECK(loaded.Load(FILE_NAME));
+	CHECK_EQUAL(loaded.GetKeyCount(), size_t(0));
+
+	std::remove(FILE_NAME);
+}
+
+// 壊れたファイルは読み込まず、読み込みに失敗しても元の内容は変わらない
+TEST_CASE(LoadRejectsBadFiles)
+{
+	CameraPath source = MakePath();
+	CHECK(source.Save(FILE_NAME));
+	std::vector<char> bytes;
+	{
+		std::ifstream ifs(FILE_NAME, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+	}
+	const size_t headerSize = 2 * sizeof(uint32_t);
+	CHECK_EQUAL(bytes.size(), headerSize + sizeof(CameraPathKey) * source.GetKeyCount());
+
+	CameraPath path = MakePath();
+	path.AddKey({ 3.0f, 0.0f, 0.0f, 1.0f });
+	const size_t keyCount = path.GetKeyCount();
+
+	// ファイルがない
+	std::remove(FILE_NAME);
+	CHECK(!path.Load(FILE_NAME));
+
+	// ヘッダーの途中で終わる
+	WriteBytes(bytes.data(), headerSize - 2);
+	CHECK(!path.Load(FILE_NAME));
+
+	// 識別子が違う
+	std::vector<char> badMagic = bytes;
+	badMagic[0] ^= 0x20;
+	WriteBytes(badMagic.data(), badMagic.size());
+	CHECK(!path.Load(FILE_NAME));
+
+	// キーの途中で終わる
+	WriteBytes(bytes.data(), bytes.size() - sizeof(float));
+	CHECK(!path.Load(FILE_NAME));
+
+	// キーの数が多すぎる
+	std::vector<char> tooMany = bytes;
+	uint32_t hugeCount = 0xffffffffu;
+	std::memcpy(tooMany.data() + sizeof(uint32_t), &hugeCount, sizeof(hugeCount));
+	WriteBytes(tooMany.data(), tooMany.size());
+	CHECK(!path.Load(FILE_NAME));
+
+	// 時間順に並んでいない
+	std::vector<char> unsorted = bytes;
+	float time = 10.0f;
+	std::memcpy(unsorted.data() + headerSize, &time, sizeof(time));
+	WriteBytes(unsorted.data(), unsorted.size());
+	CHECK(!path.Load(FILE_NAME));
+
+	CHECK_EQUAL(path.GetKeyCount(), keyCount);
+	CHECK_EQUAL(path.GetEndTime(), 3.0f);
+
+	// 壊していないファイルは読み込める
+	WriteBytes(bytes.data(), bytes.size());
+	CHECK(path.Load(FILE_NAME));
+	CHECK_EQUAL(path.GetKeyCount(), source.GetKeyCount());
+
+	std::remove(FILE_NAME);
+}
+
+// フレームの処理時間が違っても、同じ経路の再生はビット単位で同じカメラの状態になる
+TEST_CASE(PlaybackIsDeterministic)
+{
+	CameraPath path = MakePath();
+	CameraPathPlayer player;
+
+	std::vector<CameraPathKey> first = Play(path, 1, &player);
+	std::vector<CameraPathKey> second = Play(path, 2, &player);
+
+	// 0 ～ 2 秒を 1/60 秒ずつ（両端を含む）
+	CHECK_EQUAL(first.size(), size_t(121));
+	CHECK_EQUAL(second.size(), first.size());
+
+	uint32_t differences = 0;
+	for (size_t i = 0; i < first.size() && i < second.size(); i++)
+	{
+		if (!IsSameKey(first[i], second[i])) differences++;
+	}
+	CHECK_EQUAL(differences, 0u);
+
+	// 保存して読み込んだ経路の再生も同じ
+	CHECK(path.Save(FILE_NAME));
+	CameraPath loaded;
+	CHECK(loaded.Load(FILE_NAME));
+	std::vector<CameraPathKey> replayed = Play(loaded, 3, &player);
+	CHECK_EQUAL(replayed.size(), first.size());
+	for (size_t i = 0; i < first.size() && i < replayed.size(); i++)
+	{
+		if (!IsSameKey(first[i], replayed[i])) differences++;
+	}
+	CHECK_EQUAL(differences, 0u);
+	std::remove(FILE_NAME);
+
+	// キーの時間ちょうどのフレームではキーの値になる（0.5 秒 = 30 フレーム目）
+	CHECK(IsSameKey(first[0], path.GetKey(0)));
+	CHECK_EQUAL(first[30].yaw, path.GetKey(1).yaw);
+	CHECK_EQUAL(first[30].distance, path.GetKey(1).distance);
+	CHECK(IsSameKey(first[120], path.GetKey(3)));
+}
+
+// 経路の前後では端のキーに留まり、最後まで再生すると停止する
+TEST_CASE(ClampsAtEnds)
+{
+	CameraPath path = MakePath();
+
+	CameraPathKey before = path.Evaluate(-1.0f);
+	CHECK_EQUAL(before.time, -1.0f);
+	CHECK_EQUAL(before.yaw, path.GetKey(0).yaw);
+	CHECK_EQUAL(before.pitch, path.GetKey(0).pitch);
+	CHECK_EQUAL(before.distance, path.GetKey(0).distance);
+
+	CameraPathKey after = path.Evaluate(5.0f);
+	CHECK_EQUAL(after.yaw, path.GetKey(3).yaw);
+	CHECK_EQUAL(after.pitch, path.GetKey(3).pitch);
+	CHECK_EQUAL(after.distance, path.GetKey(3).distance);
+
+	CHECK_EQUAL(path.GetSegmentIndex(-1.0f), size_t(0));
+	CHECK_EQUAL(path.GetSegmentIndex(0.75f), size_t(1));
+	CHECK_EQUAL(path.GetSegmentIndex(5.0f), size_t(2));
+
+	// 最後のフレームの後は停止し、それ以降も進まない
+	CameraPathPlayer player;
+	std::vector<CameraPathKey> keys = Play(path, 1, &player);
+	CHECK(!player.IsPlaying());
+	CameraPathKey key = {};
+	CHECK(!player.Advance(0.01, &key));
+	CHECK_EQUAL(keys.back().time, path.GetEndTime());
+
+	// 区間ごとの集計は再生したフレームの数だけある
+	uint32_t frameCount = 0;
+	for (const CameraPathSegmentStats& stats : player.GetSegmentStats()) frameCount += stats.frameCount;
+	CHECK_EQUAL(player.GetSegmentStats().size(), path.GetSegmentCount());
+	CHECK_EQUAL(frameCount, static_cast<uint32_t>(keys.size()));
+	CHECK_EQUAL(player.GetFrameTimings().size(), keys.size());
+
+	// キーが１個以下の経路は再生しない
+	CameraPath single;
+	single.AddKey({ 0.0f, 1.0f, 2.0f, 3.0f });
+	player.Start(single, TICKS_PER_FRAME, TICKS_PER_SECOND);
+	CHECK(!player.IsPlaying());
+	CHECK(!player.Advance(0.01, &key));
+}
+
+// キーは時間順にだけ追加でき、記録は間隔を空けて追加する
+TEST_CASE(KeysAreOrdered)
+{
+	CameraPath path;
+	CHECK(path.AddKey({ 1.0f, 0.0f, 0.0f, 1.0f }));
+	CHECK(!path.AddKey({ 1.0f, 0.0f, 0.0f, 1.0f }));
+	CHECK(!path.AddKey({ 0.5f, 0.0f, 0.0f, 1.0f }));
+
+	CHECK(!path.Record({ 1.1f, 0.0f, 0.0f, 1.0f }, 0.25f));
+	CHECK(path.Record({ 1.3f, 0.0f, 0.0f, 1.0f }, 0.25f));
+	CHECK_EQUAL(path.GetKeyCount(), size_t(2));
+	CHECK_EQUAL(path.GetStartTime(), 1.0f);
+	CHECK_EQUAL(path.GetEndTime(), 1.3f);
+}
+
+int main() { return ImaseTest::RunTests(); }
@@ -0,0 +1,243 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ConstantRingTest.cpp
+//
+// ConstantRing（フレームごとの定数を１つの定数バッファへ詰めるリングバッファ）のテスト
+//
+// ConstantRingAllocator の 256 バイト単位の確保・末尾に入らない場合に先頭へ戻る処理・
+// 空きが足りない場合の失敗・覚えきれないフレームをまとめる処理を決まった手順で確認し、
+// ConstantRing を NullRenderContext のバッファで多くのフレーム実行して、GPU が使用中の
+// フレーム（FRAME_LATENCY フレーム前まで）の範囲へ書き込まないことを確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "ConstantRing.h"
+#include "NullRenderContext.h"
+
+using namespace Imase;
+
+namespace
+{
+	constexpr uint32_t UNIT = ConstantRingAllocator::ALIGNMENT;
+}
+
+// 確保は 256 バイト単位に揃えて先頭から順に並ぶ
+TEST_CASE(AllocationsAreAligned)
+{
+	ConstantRingAllocator allocator;
+	allocator.Reset(64 * UNIT + 100);		// 容量は 256 バイト単位に切り捨てる
+	CHECK_EQUAL(allocator.GetCapacity(), 64 * UNIT);
+
+	const uint32_t sizes[] = { 1, 0, 64, 256, 257, 1000 };
+	const uint32_t expected[] = { 0, 256, 512, 768, 1024, 1536 };
+	for (int i = 0; i < 6; i++)
+	{
+		uint32_t offset = UINT32_MAX;
+		bool wrapped = true;
+		CHECK(allocator.Allocate(sizes[i], &offset, &wrapped));
+		CHECK_EQUAL(offset, expected[i]);
+		CHECK_EQUAL(offset % UNIT, 0u);
+		CHECK(!wrapped);
+	}
+
+	CHECK_EQUAL(allocator.GetUsedBytes(), 2560u);
+	CHECK_EQUAL(allocator.GetStats().allocations, 6u);
+	CHECK_EQUAL(allocator.GetStats().allocatedBytes, uint64_t(2560));
+	CHECK_EQUAL(ConstantRingAllocator::AlignUp(257), 512u);
+}
+
+// 末尾に入らない場合は末尾を使わずに先頭へ戻り、使わなかった末尾もフレームの範囲に含める
+TEST_CASE(WrapAroundSkipsTail)
+{
+	ConstantRingAllocator allocator;
+	allocator.Reset(4 * UNIT);
+	uint32_t offset = 0;
+	bool wrapped = false;
+
+	// フレーム 1：[0, 512)
+	CHECK(allocator.Allocate(2 * UNIT, &offset));
+	CHECK_EQUAL(offset, 0u);
+	allocator.EndFrame(1);
+
+	// フレーム 2：[512, 768)
+	CHECK(allocator.Allocate(UNIT, &offset));
+	CHECK_EQUAL(offset, 2 * UNIT);
+	allocator.EndFrame(2);
+
+	// フレーム 1 を使い終わると [0, 512) が空く
+	allocator.Retire(1);
+	CHECK_EQUAL(allocator.GetUsedBytes(), UNIT);
+	CHECK_EQUAL(allocator.GetFramesInFlight(), 1u);
+
+	// フレーム 3：末尾の [768, 1024) には入らないので先頭の [0, 512) を使う
+	CHECK(allocator.Allocate(2 * UNIT, &offset, &wrapped));
+	CHECK_EQUAL(offset, 0u);
+	CHECK(wrapped);
+	CHECK_EQUAL(allocator.GetStats().wraps, 1u);
+	CHECK_EQUAL(allocator.GetUsedBytes(), 4 * UNIT);	// 使わなかった末尾も使用中に含める
+
+	// 満杯なので確保できない
+	CHECK(!allocator.Allocate(1, &offset));
+	CHECK_EQUAL(allocator.GetStats().failures, 1u);
+	allocator.EndFrame(3);
+
+	// フレーム 2 とフレーム 3（末尾を含む）を使い終わると空になる
+	allocator.Retire(2);
+	CHECK_EQUAL(allocator.GetUsedBytes(), 3 * UNIT);
+	allocator.Retire(3);
+	CHECK_EQUAL(allocator.GetUsedBytes(), 0u);
+	CHECK_EQUAL(allocator.GetFramesInFlight(), 0u);
+
+	// 空になった後は先頭から使う
+	CHECK(allocator.Allocate(4 * UNIT, &offset, &wrapped));
+	CHECK_EQUAL(offset, 0u);
+	CHECK(!wrapped);
+	CHECK_EQUAL(allocator.GetStats().wraps, 2u);	// ちょうど最後まで使った場合も先頭へ戻る
+}
+
+// 空きが足りない場合は確保に失敗し、使用中の範囲は変わらない
+TEST_CASE(OverflowFails)
+{
+	ConstantRingAllocator allocator;
+	allocator.Reset(4 * UNIT);
+	uint32_t offset = 0;
+
+	CHECK(!allocator.Allocate(5 * UNIT, &offset));
+	CHECK(allocator.Allocate(3 * UNIT, &offset));
+	CHECK(!allocator.Allocate(2 * UNIT, &offset));
+	CHECK(allocator.Allocate(UNIT, &offset));
+	CHECK_EQUAL(offset, 3 * UNIT);
+	CHECK(!allocator.Allocate(1, &offset));
+
+	CHECK_EQUAL(allocator.GetStats().failures, 3u);
+	CHECK_EQUAL(allocator.GetUsedBytes(), 4 * UNIT);
+
+	// 使用中の範囲の間の空き [head, tail) より大きい場合も失敗する
+	allocator.EndFrame(1);
+	allocator.Retire(1);
+	CHECK(allocator.Allocate(2 * UNIT, &offset));
+	allocator.EndFrame(2);
+	CHECK(allocator.Allocate(UNIT, &offset));
+	allocator.EndFrame(3);
+	allocator.Retire(2);								// [0, 512) が空く、使用中は [512, 768)
+	CHECK(allocator.Allocate(UNIT, &offset));			// [768, 1024)
+	CHECK(allocator.Allocate(UNIT, &offset));			// 先頭へ戻って [0, 256)
+	CHECK_EQUAL(offset, 0u);
+	CHECK(!allocator.Allocate(2 * UNIT, &offset));		// 空きは [256, 512) だけ
+	CHECK(allocator.Allocate(UNIT, &offset));
+	CHECK_EQUAL(offset, UNIT);
+	CHECK_EQUAL(allocator.GetUsedBytes(), 4 * UNIT);
+}
+
+// 覚えきれないフレームは最後のフレームへまとめ、まとめたフレームのフェンスまで再利用しない
+TEST_CASE(FramesBeyondCapacityAreMerged)
+{
+	ConstantRingAllocator allocator;
+	allocator.Reset(64 * UNIT);
+	uint32_t offset = 0;
+
+	const uint32_t frameCount = ConstantRingAllocator::MAX_FRAMES_IN_FLIGHT + 2;
+	for (uint32_t fence = 1; fence <= frameCount; fence++)
+	{
+		CHECK(allocator.Allocate(UNIT, &offset));
+		allocator.EndFrame(fence);
+	}
+	CHECK_EQUAL(allocator.GetFramesInFlight(), ConstantRingAllocator::MAX_FRAMES_IN_FLIGHT);
+
+	// フェンス 1 ～ 7 は別々に、8 ～ 10 は１つにまとめられている
+	allocator.Retire(frameCount - 1);
+	CHECK_EQUAL(allocator.GetUsedBytes(), 3 * UNIT);
+	CHECK_EQUAL(allocator.GetFramesInFlight(), 1u);
+
+	allocator.Retire(frameCount);
+	CHECK_EQUAL(allocator.GetUsedBytes(), 0u);
+}
+
+// ConstantRing は GPU が使用中のフレームの範囲へ書き込まず、書き込んだ定数はバッファの指定の位置にある
+TEST_CASE(RingNeverOverwritesFramesInFlight)
+{
+	const uint32_t capacity = 16 * UNIT;		// 使用中のフレームのすぐ後ろまで使い、ときどき確保に失敗する大きさ
+	NullRenderContext null;
+	RenderBuffer* buffer = null.CreateBuffer(capacity, true);
+
+	ConstantRing ring;
+	ring.Initialize(buffer, capacity);
+
+	// 256 バイトの単位ごとに最後に書き込んだフレーム
+	std::vector<uint64_t> owner(capacity / UNIT, 0);
+	uint32_t overwrites = 0, mismatches = 0, written = 0, failed = 0;
+
+	std::mt19937 random(3);
+	std::vector<uint8_t> data(4 * UNIT);
+	for (uint64_t frame = 1; frame <= 500; frame++)
+	{
+		ring.BeginFrame();
+
+		uint32_t writes = 1 + random() % 4;
+		for (uint32_t w = 0; w < writes; w++)
+		{
+			uint32_t size = 16 + random() % (2 * UNIT);
+			for (uint32_t i = 0; i < size; i++) data[i] = static_cast<uint8_t>(frame * 31 + w * 7 + i);
+
+			ConstantRingRange range = {};
+			if (!ring.Write(&null, data.data(), size, &range))
+			{
+				failed++;
+				continue;
+			}
+			written++;
+
+			uint32_t offset = range.firstConstant * 16;
+			CHECK_EQUAL(range.numConstants, ConstantRingAllocator::AlignUp(size) / 16);
+
+			for (uint32_t unit = offset / UNIT; unit < (offset + range.numConstants * 16) / UNIT; unit++)
+			{
+				// GPU は FRAME_LATENCY フレーム前まで使っている
+				if (owner[unit] != 0 && owner[unit] != frame && owner[unit] + ConstantRing::FRAME_LATENCY >= frame) overwrites++;
+				owner[unit] = frame;
+			}
+
+			const uint8_t* mapped = static_cast<const uint8_t*>(null.Map(buffer, RenderMap::WriteNoOverwrite));
+			if (std::memcmp(mapped + offset, data.data(), size) != 0) mismatches++;
+			null.Unmap(buffer);
+		}
+	}
+
+	CHECK_EQUAL(overwrites, 0u);
+	CHECK_EQUAL(mismatches, 0u);
+	CHECK(written > 1000);
+	CHECK(failed > 0);
+	CHECK(ring.GetStats().wraps > 0);
+	CHECK_EQUAL(ring.GetStats().failures, failed);
+	CHECK_EQUAL(ring.GetStats().discards, 1u);		// WriteDiscard は最初の書き込みだけ
+	CHECK_EQUAL(null.GetStats().errors, 0u);
+}
+
+// バッファがない場合と定数が大きすぎる場合は書き込まない
+TEST_CASE(RingRejectsInvalidWrites)
+{
+	NullRenderContext null;
+	uint8_t data[16] = {};
+	ConstantRingRange range = {};
+
+	ConstantRing ring;
+	ring.Initialize(nullptr, 4096);
+	ring.BeginFrame();
+	CHECK(!ring.IsValid());
+	CHECK(!ring.Write(&null, data, sizeof(data), &range));
+
+	RenderBuffer* buffer = null.CreateBuffer(4096, true);
+	ring.Initialize(buffer, 4096);
+	ring.BeginFrame();
+	CHECK(!ring.Write(&null, data, 4096 * 16 + 1, &range));
+	CHECK(ring.Write(&null, data, sizeof(data), &range));
+	CHECK_EQUAL(null.GetStats().maps, 1u);
+}
+
+int main() { return ImaseTest::RunTests(); }
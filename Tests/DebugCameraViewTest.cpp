@@ -0,0 +1,129 @@
+﻿//--------------------------------------------------------------------------------------
+// File: DebugCameraViewTest.cpp
+//
+// DebugCameraView（デバッグカメラの行列の計算と変化の検出）のテスト
+//
+// 入力が変化した時だけ行列を再計算してバージョン番号が増えることと、
+// 計算した行列・視錐台が MathCore で直接求めた値と一致することを確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include "DebugCameraView.h"
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	Matrix Projection(float farPlane)
+	{
+		return Matrix::CreatePerspective(0.785398163f, 16.0f / 9.0f, 0.1f, farPlane);
+	}
+
+	bool IsNear(const Matrix& a, const Matrix& b, float tolerance)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				if (std::fabs(a.m[i][j] - b.m[i][j]) > tolerance) return false;
+			}
+		}
+		return true;
+	}
+}
+
+// 最初の状態を設定するまでは計算しない（射影行列は保存だけする）
+TEST_CASE(NothingComputedBeforeFirstState)
+{
+	DebugCameraView view;
+	CHECK_EQUAL(view.GetVersion(), 0u);
+
+	CHECK(!view.SetProjection(Projection(100.0f)));
+	CHECK_EQUAL(view.GetVersion(), 0u);
+
+	CHECK(view.SetState({ 0.3f, 0.2f, 10.0f }));
+	CHECK_EQUAL(view.GetVersion(), 1u);
+	CHECK(view.GetProjection() == Projection(100.0f));
+}
+
+// 同じ入力では再計算せず、変化した時だけバージョン番号が１つ増える
+TEST_CASE(VersionChangesOnlyWhenInputsChange)
+{
+	DebugCameraView view;
+	view.SetProjection(Projection(100.0f));
+	view.SetState({ 0.3f, 0.2f, 10.0f });
+	uint32_t version = view.GetVersion();
+
+	// 同じ状態・同じ射影行列を何度設定しても変わらない
+	for (int i = 0; i < 10; i++)
+	{
+		CHECK(!view.SetState({ 0.3f, 0.2f, 10.0f }));
+		CHECK(!view.SetProjection(Projection(100.0f)));
+	}
+	CHECK_EQUAL(view.GetVersion(), version);
+
+	// 回転・距離・射影行列のどれが変わっても増える
+	CHECK(view.SetState({ 0.4f, 0.2f, 10.0f }));
+	CHECK_EQUAL(view.GetVersion(), version + 1);
+	CHECK(view.SetState({ 0.4f, 0.25f, 10.0f }));
+	CHECK(view.SetState({ 0.4f, 0.25f, 12.0f }));
+	CHECK(view.SetProjection(Projection(200.0f)));
+	CHECK_EQUAL(view.GetVersion(), version + 4);
+}
+
+// 補間した状態で描画してから今の状態に戻すと、その度に再計算される
+TEST_CASE(InterpolatedStatesRecompute)
+{
+	DebugCameraView view;
+	view.SetProjection(Projection(100.0f));
+
+	DebugCameraState previous = { 0.0f, 0.2f, 10.0f };
+	DebugCameraState current = { 0.1f, 0.2f, 10.0f };
+	view.SetState(current);
+	uint32_t version = view.GetVersion();
+
+	CHECK(view.SetState(Interpolate(previous, current, 0.5f)));
+	CHECK(view.GetState() == Interpolate(previous, current, 0.5f));
+
+	// 補間の係数が 1 なら今の状態と同じなので再計算しない
+	CHECK(view.SetState(current));
+	CHECK(!view.SetState(Interpolate(previous, current, 1.0f)));
+	CHECK_EQUAL(view.GetVersion(), version + 2);
+}
+
+// 行列と視錐台は MathCore で直接求めた値と一致する
+TEST_CASE(MatricesMatchMathCore)
+{
+	DebugCameraView view;
+	view.SetProjection(Projection(100.0f));
+	DebugCameraState state = { 0.7f, -0.4f, 8.0f };
+	view.SetState(state);
+
+	Vector3 eye, up;
+	DebugCameraView::ComputeEye(state, &eye, &up);
+	CHECK(view.GetEyePosition() == eye);
+
+	// 視点は注視点（原点）から (0, 1, 1) 方向の distance 倍
+	CHECK_NEAR(eye.Length(), state.distance * std::sqrt(2.0f), 1.0e-4f);
+
+	Matrix expected = Matrix::CreateLookAt(eye, Vector3::Zero(), up);
+	CHECK(view.GetView() == expected);
+	CHECK(view.GetViewProjection() == expected * Projection(100.0f));
+	CHECK(IsNear(view.GetView() * view.GetInverseView(), Matrix::Identity(), 1.0e-5f));
+
+	Frustum frustum = Frustum::CreateFromViewProjection(view.GetViewProjection());
+	CHECK_EQUAL(view.GetFrustum().planeCount, frustum.planeCount);
+	for (int i = 0; i < frustum.planeCount; i++)
+	{
+		CHECK(view.GetFrustum().planes[i] == frustum.planes[i]);
+	}
+}
+
+int main()
+{
+	return ImaseTest::RunTests();
+}
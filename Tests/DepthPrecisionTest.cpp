@@ -0,0 +1,137 @@
+﻿//--------------------------------------------------------------------------------------
+// File: DepthPrecisionTest.cpp
+//
+// DepthPrecision（深度バッファの精度）のテスト
+//
+// 射影行列（MathCore）で求めた深度値が DepthProjection の式と一致することと、
+// D32_FLOAT / D24_UNORM の誤差が理論上の上限に収まることを確認します。
+// Far が無限遠の Reverse-Z と通常の Z を、同じ距離で比較します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include "DepthPrecision.h"
+#include "MathCore.h"
+
+using namespace Imase;
+
+namespace
+{
+	const float NEAR_PLANE = 0.1f;
+	const float FAR_PLANE = 1000.0f;
+
+	// 比較する射影
+	DepthProjection Standard() { return { NEAR_PLANE, FAR_PLANE, false, false }; }
+	DepthProjection ReverseZ() { return { NEAR_PLANE, FAR_PLANE, true, false }; }
+	DepthProjection InfiniteReverseZ() { return { NEAR_PLANE, FAR_PLANE, true, true }; }
+
+	// 射影行列で距離 distance の点を変換した時の深度値（GPU と同じく float で計算）
+	float ProjectDepth(const Math::Matrix& proj, float distance)
+	{
+		Math::Vector4 p = proj.Transform(Math::Vector4(0.0f, 0.0f, -distance, 1.0f));
+		return p.z / p.w;
+	}
+
+	// 距離を対数的に区切った値
+	double Distance(int i, int count, double minDistance, double maxDistance)
+	{
+		return minDistance * std::pow(maxDistance / minDistance, double(i) / double(count - 1));
+	}
+
+	const int SAMPLE_COUNT = 200;
+}
+
+// 射影行列の深度値が DepthProjection の式と一致する
+TEST_CASE(MatricesMatchDepthProjection)
+{
+	const float fov = 0.785398163f, aspect = 16.0f / 9.0f;
+	Math::Matrix standard = Math::Matrix::CreatePerspective(fov, aspect, NEAR_PLANE, FAR_PLANE);
+	Math::Matrix reverse = Math::Matrix::CreatePerspectiveReverseZ(fov, aspect, NEAR_PLANE, FAR_PLANE);
+	Math::Matrix infinite = Math::Matrix::CreatePerspectiveInfiniteReverseZ(fov, aspect, NEAR_PLANE);
+
+	for (int i = 0; i < SAMPLE_COUNT; i++)
+	{
+		float d = static_cast<float>(Distance(i, SAMPLE_COUNT, NEAR_PLANE, FAR_PLANE));
+		CHECK_NEAR(ProjectDepth(standard, d), Standard().ToDepth(d), 1.0e-6);
+		CHECK_NEAR(ProjectDepth(reverse, d), ReverseZ().ToDepth(d), 1.0e-6);
+		CHECK_NEAR(ProjectDepth(infinite, d), InfiniteReverseZ().ToDepth(d), 1.0e-6);
+	}
+
+	// Near は 0（Reverse-Z では 1）、Far は 1（Reverse-Z では 0）になる
+	CHECK_NEAR(ProjectDepth(standard, NEAR_PLANE), 0.0f, 1.0e-6f);
+	CHECK_NEAR(ProjectDepth(standard, FAR_PLANE), 1.0f, 1.0e-6f);
+	CHECK_NEAR(ProjectDepth(reverse, NEAR_PLANE), 1.0f, 1.0e-6f);
+	CHECK_NEAR(ProjectDepth(reverse, FAR_PLANE), 0.0f, 1.0e-6f);
+	CHECK_NEAR(ProjectDepth(infinite, NEAR_PLANE), 1.0f, 1.0e-6f);
+	CHECK(ProjectDepth(infinite, 1.0e6f) > 0.0f);
+}
+
+// D32_FLOAT + 無限遠の Reverse-Z は全ての距離で相対誤差が float の精度程度になる
+TEST_CASE(InfiniteReverseZFloatRelativeError)
+{
+	// 深度値 = n / d なので、距離の相対誤差は深度値の相対誤差（2^-24）と同じ
+	const double bound = std::ldexp(1.0, -23);
+	for (int i = 0; i < SAMPLE_COUNT; i++)
+	{
+		double d = Distance(i, SAMPLE_COUNT, NEAR_PLANE, 1.0e6);
+		CHECK(DepthError(d, InfiniteReverseZ(), DepthFormat::D32_FLOAT) / d <= bound);
+		CHECK(DepthResolution(d, InfiniteReverseZ(), DepthFormat::D32_FLOAT) / d <= 2.0 * bound);
+	}
+}
+
+// D32_FLOAT では Reverse-Z の方が通常の Z より遠くの分解能が高い
+TEST_CASE(ReverseZBeatsStandardWithFloat)
+{
+	for (int i = 0; i < SAMPLE_COUNT; i++)
+	{
+		double d = Distance(i, SAMPLE_COUNT, 1.0, FAR_PLANE);
+		double standard = DepthResolution(d, Standard(), DepthFormat::D32_FLOAT);
+		double reverse = DepthResolution(d, ReverseZ(), DepthFormat::D32_FLOAT);
+		double infinite = DepthResolution(d, InfiniteReverseZ(), DepthFormat::D32_FLOAT);
+		CHECK(reverse < standard);
+		CHECK(infinite < standard);
+	}
+
+	// 通常の Z では Far 付近で千倍以上悪くなる（Near 0.1 / Far 1000 で約 0.48 と約 0.00006）
+	double standardFar = DepthResolution(FAR_PLANE * 0.9, Standard(), DepthFormat::D32_FLOAT);
+	double infiniteFar = DepthResolution(FAR_PLANE * 0.9, InfiniteReverseZ(), DepthFormat::D32_FLOAT);
+	CHECK(standardFar > infiniteFar * 1.0e3);
+}
+
+// D24_UNORM の分解能は d^2 / (|B| * (2^24 - 1)) になり、Reverse-Z でも変わらない
+TEST_CASE(FixedPointResolutionBound)
+{
+	const double unit = 1.0 / double((1 << 24) - 1);
+	const DepthProjection projections[] = { Standard(), ReverseZ(), InfiniteReverseZ() };
+	for (const DepthProjection& projection : projections)
+	{
+		double a, b;
+		projection.GetCoefficients(a, b);
+		for (int i = 0; i < SAMPLE_COUNT; i++)
+		{
+			double d = Distance(i, SAMPLE_COUNT, 1.0, FAR_PLANE * 0.5);
+			double bound = d * d * unit / std::abs(b);
+
+			// １段階ずれた距離は d + bound 程度（d の２次の項で少し大きくなる）
+			double resolution = DepthResolution(d, projection, DepthFormat::D24_UNORM);
+			CHECK(resolution <= bound * 1.05);
+			CHECK(resolution >= bound * 0.95);
+
+			// 量子化による誤差は半段階以内
+			CHECK(DepthError(d, projection, DepthFormat::D24_UNORM) <= 0.5 * bound * 1.05);
+		}
+	}
+
+	// 固定小数点では Reverse-Z にしても分解能はほとんど変わらない
+	double d = FAR_PLANE * 0.5;
+	double standard = DepthResolution(d, Standard(), DepthFormat::D24_UNORM);
+	double reverse = DepthResolution(d, ReverseZ(), DepthFormat::D24_UNORM);
+	CHECK_NEAR(reverse / standard, 1.0, 0.05);
+}
+
+int main()
+{
+	return ImaseTest::RunTests();
+}
@@ -0,0 +1,244 @@
+﻿//--------------------------------------------------------------------------------------
+// File: EntityWorldTest.cpp
+//
+// EntityWorld（アーキタイプごとの SoA 形式のエンティティの入れ物）のテスト
+//
+// コンポーネントの追加・削除でエンティティが別のアーキタイプへ移り、値が引き継がれることと、
+// 削除で最後のエンティティを穴へ移した時に移したエンティティの場所が正しく直されることを、
+// 複数のチャンクにまたがる数のエンティティで確認します。場所は Get で取り出した値と、
+// ForEach のチャンクのエンティティの配列とコンポーネントの配列の対応の両方で確かめます。
+// 番号を再利用した後の古いエンティティ（回数が違う）は、取得・追加・削除・削除の
+// どの操作でも受け付けないことを確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <random>
+#include <vector>
+
+#include "EntityWorld.h"
+
+using namespace Imase;
+
+namespace
+{
+	// エンティティごとに違う値を入れて、場所が正しいか確かめるコンポーネント
+	struct Id { uint32_t value; };
+	struct Velocity { float x, y, z; };
+
+	// １つのチャンクに十数個しか入らない大きなコンポーネント（少ない数で複数のチャンクにまたがる）
+	struct Payload { uint32_t data[256]; };
+
+	// 生きているエンティティが全て自分の Id を持ち、ForEach で１回ずつ見つかるか調べる
+	// （見つからない・２回見つかる・配列の対応がずれているものの数を返す）
+	uint32_t CountMisplaced(EntityWorld& world, const std::vector<Entity>& entities, const std::vector<uint32_t>& ids)
+	{
+		uint32_t misplaced = 0;
+		std::vector<uint32_t> found(entities.size(), 0);
+
+		world.ForEach<Id>([&](const EntityChunkView& chunk, Id* id)
+			{
+				for (size_t i = 0; i < chunk.count; i++)
+				{
+					uint32_t index = id[i].value;
+					if (index >= entities.size() || chunk.entities[i] != entities[index]) misplaced++;
+					else found[index]++;
+				}
+			});
+
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			bool isAlive = world.IsAlive(entities[i]);
+			if (found[i] != (isAlive ? 1u : 0u)) misplaced++;
+
+			const Id* id = world.Get<Id>(entities[i]);
+			if (isAlive && (!id || id->value != ids[i])) misplaced++;
+		}
+
+		return misplaced;
+	}
+}
+
+// コンポーネントの追加・削除でアーキタイプが移り、両方にあるコンポーネントの値は引き継がれる
+TEST_CASE(AddRemoveMovesArchetype)
+{
+	EntityWorld world;
+	Entity a = world.Create(Id{ 1 });
+	Entity b = world.Create(Id{ 2 });
+	CHECK_EQUAL(world.GetArchetypeCount(), size_t(1));
+	CHECK_EQUAL(world.Count<Id>(), size_t(2));
+	CHECK_EQUAL((world.Count<Id, Velocity>()), size_t(0));
+
+	// 追加すると (Id, Velocity) のアーキタイプへ移る
+	CHECK(world.Add(a, Velocity{ 1.0f, 2.0f, 3.0f }));
+	CHECK_EQUAL(world.GetArchetypeCount(), size_t(2));
+	CHECK_EQUAL(world.Count<Id>(), size_t(2));
+	CHECK_EQUAL((world.Count<Id, Velocity>()), size_t(1));
+	CHECK(world.Has<Velocity>(a));
+	CHECK(!world.Has<Velocity>(b));
+	CHECK_EQUAL(world.Get<Id>(a)->value, 1u);
+	CHECK_EQUAL(world.Get<Velocity>(a)->y, 2.0f);
+	CHECK(world.Get<Velocity>(b) == nullptr);
+
+	// a が抜けた穴は b で埋まっているので b の値もそのまま
+	CHECK_EQUAL(world.Get<Id>(b)->value, 2u);
+
+	// 持っているコンポーネントを追加すると値だけが変わる
+	CHECK(world.Add(a, Velocity{ 4.0f, 5.0f, 6.0f }));
+	CHECK_EQUAL(world.GetArchetypeCount(), size_t(2));
+	CHECK_EQUAL((world.Count<Id, Velocity>()), size_t(1));
+	CHECK_EQUAL(world.Get<Velocity>(a)->z, 6.0f);
+
+	// ForEach は (Id, Velocity) のアーキタイプの a だけを渡す
+	uint32_t visited = 0;
+	world.ForEach<Id, Velocity>([&](const EntityChunkView& chunk, Id* id, Velocity* velocity)
+		{
+			for (size_t i = 0; i < chunk.count; i++)
+			{
+				CHECK(chunk.entities[i] == a);
+				CHECK_EQUAL(id[i].value, 1u);
+				CHECK_EQUAL(velocity[i].x, 4.0f);
+				visited++;
+			}
+		});
+	CHECK_EQUAL(visited, 1u);
+
+	// 削除すると元のアーキタイプへ戻り、新しいアーキタイプは作らない
+	CHECK(world.Remove<Velocity>(a));
+	CHECK_EQUAL(world.GetArchetypeCount(), size_t(2));
+	CHECK_EQUAL((world.Count<Id, Velocity>()), size_t(0));
+	CHECK(!world.Has<Velocity>(a));
+	CHECK(world.Get<Velocity>(a) == nullptr);
+	CHECK_EQUAL(world.Get<Id>(a)->value, 1u);
+
+	// 持っていないコンポーネントの削除は何もしない
+	CHECK(world.Remove<Velocity>(b));
+	CHECK_EQUAL(world.Get<Id>(b)->value, 2u);
+
+	// 移り先で追加したコンポーネントは 0 から始まる（前に持っていた値は残らない）
+	CHECK(world.Remove<Id>(a));
+	CHECK(!world.Has<Id>(a));
+	CHECK(world.IsAlive(a));
+	CHECK(world.Add(a, Velocity{ 7.0f, 8.0f, 9.0f }));
+	CHECK(world.Add(b, Velocity{ 1.0f, 1.0f, 1.0f }));
+	CHECK(world.Remove<Velocity>(b));
+	CHECK_EQUAL(world.Count<Velocity>(), size_t(1));
+	CHECK_EQUAL(world.Get<Velocity>(a)->x, 7.0f);
+	CHECK_EQUAL(world.GetEntityCount(), size_t(2));
+}
+
+// 削除・アーキタイプの移動で最後のエンティティを穴へ移した時に、その場所が直される
+TEST_CASE(SwapRemoveFixesLocations)
+{
+	EntityWorld world;
+	const uint32_t count = 200;
+
+	std::vector<Entity> entities;
+	std::vector<uint32_t> ids;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		Payload payload = {};
+		payload.data[0] = i;
+		entities.push_back(world.Create(Id{ i }, payload));
+		ids.push_back(i);
+	}
+
+	// 複数のチャンクにまたがっている
+	size_t chunkCount = world.GetChunkCount();
+	CHECK(chunkCount >= 8);
+	CHECK_EQUAL(CountMisplaced(world, entities, ids), 0u);
+
+	// 先頭のチャンク・途中・最後のエンティティを削除、移動する操作を順番に混ぜる
+	std::mt19937 random(11);
+	uint32_t destroyed = 0, moved = 0;
+	for (int step = 0; step < 300; step++)
+	{
+		Entity entity = entities[random() % count];
+		if (!world.IsAlive(entity)) continue;
+
+		switch (random() % 3)
+		{
+		case 0:
+			CHECK(world.Destroy(entity));
+			destroyed++;
+			break;
+		case 1:
+			CHECK(world.Add(entity, Velocity{ 1.0f, 0.0f, 0.0f }));
+			moved++;
+			break;
+		default:
+			CHECK(world.Remove<Payload>(entity));
+			moved++;
+			break;
+		}
+	}
+	CHECK(destroyed > 30);
+	CHECK(moved > 60);
+	CHECK_EQUAL(world.GetEntityCount(), size_t(count - destroyed));
+	CHECK_EQUAL(world.Count<Id>(), world.GetEntityCount());
+	CHECK_EQUAL(CountMisplaced(world, entities, ids), 0u);
+
+	// Payload の値も移動に付いてきている
+	uint32_t wrongPayloads = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const Payload* payload = world.Get<Payload>(entities[i]);
+		if (payload && payload->data[0] != i) wrongPayloads++;
+	}
+	CHECK_EQUAL(wrongPayloads, 0u);
+
+	// 全て削除すると空になったチャンクは解放される
+	for (const Entity& entity : entities) world.Destroy(entity);
+	CHECK_EQUAL(world.GetEntityCount(), size_t(0));
+	CHECK_EQUAL(world.GetChunkCount(), size_t(0));
+	CHECK_EQUAL(CountMisplaced(world, entities, ids), 0u);
+}
+
+// 番号を再利用した後の古いエンティティはどの操作でも受け付けない
+TEST_CASE(StaleHandlesRejected)
+{
+	EntityWorld world;
+	Entity old = world.Create(Id{ 1 });
+	Entity other = world.Create(Id{ 2 });
+	CHECK(world.Destroy(old));
+	CHECK(!world.Destroy(old));
+
+	// 削除した番号を再利用し、回数で区別する
+	Entity reused = world.Create(Id{ 3 }, Velocity{ 1.0f, 2.0f, 3.0f });
+	CHECK_EQUAL(reused.index, old.index);
+	CHECK_EQUAL(reused.generation, old.generation + 1);
+	CHECK(reused != old);
+
+	CHECK(!world.IsAlive(old));
+	CHECK(world.Get<Id>(old) == nullptr);
+	CHECK(!world.Has<Id>(old));
+	CHECK(!world.Add(old, Id{ 9 }));
+	CHECK(!world.Remove<Velocity>(old));
+	CHECK(!world.Destroy(old));
+
+	// 古いエンティティへの操作は新しいエンティティに影響しない
+	CHECK(world.IsAlive(reused));
+	CHECK_EQUAL(world.Get<Id>(reused)->value, 3u);
+	CHECK(world.Has<Velocity>(reused));
+	CHECK_EQUAL(world.GetEntityCount(), size_t(2));
+
+	// 無効なエンティティと範囲外の番号
+	CHECK(!world.IsAlive(INVALID_ENTITY));
+	CHECK(world.Get<Id>(INVALID_ENTITY) == nullptr);
+	CHECK(!world.Destroy(Entity{ 100, 0 }));
+
+	// Clear した後はそれまでのエンティティが全て古くなる
+	world.Clear();
+	CHECK(!world.IsAlive(reused));
+	CHECK(!world.IsAlive(other));
+	Entity fresh = world.Create(Id{ 4 });
+	CHECK(fresh != reused && fresh != other);
+	CHECK(world.Get<Id>(reused) == nullptr);
+	CHECK(world.Get<Id>(other) == nullptr);
+	CHECK_EQUAL(world.Get<Id>(fresh)->value, 4u);
+	CHECK_EQUAL(world.GetEntityCount(), size_t(1));
+}
+
+int main() { return ImaseTest::RunTests(); }
@@ -0,0 +1,219 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FastTrigTest.cpp
+//
+// FastTrig（高速な三角関数）の精度のテスト
+//
+// |x| <= 8192 の範囲を float のビット列で一定の間隔ごとに全て調べ、libm の倍精度の
+// 結果との誤差の最大値が FastTrig.h に書いてある上限以下であることを確認します。
+// スカラー版と配列版（SIMD）の両方を調べます。π/2 の倍数の付近も重点的に調べます。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "FastTrig.h"
+
+using namespace Imase::Math;
+
+namespace
+{
+	// FastTrig.h に書いてある誤差の上限
+	const double SIN_COS_MAX_ERROR = 1.0e-7;
+	const double TAN_MAX_ERROR = 3.0e-7;
+	const double ATAN2_MAX_ERROR = 3.0e-7;
+	const float MAX_ARGUMENT = 8192.0f;
+
+	// 調べる float のビット列の間隔（0 ～ 8192 の約 11 億個から約 1,100 万個）
+	const uint32_t BIT_STRIDE = 101;
+
+	float FromBits(uint32_t bits)
+	{
+		float f;
+		std::memcpy(&f, &bits, sizeof(f));
+		return f;
+	}
+
+	uint32_t ToBits(float f)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &f, sizeof(bits));
+		return bits;
+	}
+
+	// 調べる引数の集合（正負の一定間隔のビット列と π/2 の倍数の付近）
+	std::vector<float> MakeArguments()
+	{
+		std::vector<float> args;
+		for (uint32_t bits = 0; bits <= ToBits(MAX_ARGUMENT); bits += BIT_STRIDE)
+		{
+			float x = FromBits(bits);
+			args.push_back(x);
+			args.push_back(-x);
+		}
+		for (int k = -5215; k <= 5215; k++)
+		{
+			float x = static_cast<float>(k * 1.5707963267948966);
+			for (int ulp = -8; ulp <= 8; ulp++)
+			{
+				float y = x;
+				for (int i = 0; i < std::abs(ulp); i++) y = std::nextafter(y, ulp < 0 ? -MAX_ARGUMENT : MAX_ARGUMENT);
+				if (std::fabs(y) <= MAX_ARGUMENT) args.push_back(y);
+			}
+		}
+		return args;
+	}
+
+	// 誤差の最大値
+	struct MaxError
+	{
+		double error = 0.0;
+		float argument = 0.0f;
+
+		void Add(double e, float x)
+		{
+			if (!(e <= error))	// NaN も最大として記録する
+			{
+				error = e;
+				argument = x;
+			}
+		}
+	};
+
+	void Report(const char* name, const MaxError& e, const char* argumentName = "x")
+	{
+		std::printf("  %-18s max error %.3g at %s = %.9g\n", name, e.error, argumentName, e.argument);
+	}
+}
+
+// sin / cos の絶対誤差（スカラー版と配列版）
+TEST_CASE(SinCosFullRange)
+{
+	std::vector<float> args = MakeArguments();
+	std::vector<float> s(args.size()), c(args.size());
+	SinCos(args.data(), s.data(), c.data(), args.size());
+
+	MaxError scalarSin, scalarCos, arraySin, arrayCos;
+	for (size_t i = 0; i < args.size(); i++)
+	{
+		float x = args[i];
+		double rs = std::sin(static_cast<double>(x));
+		double rc = std::cos(static_cast<double>(x));
+
+		float fs, fc;
+		SinCos(x, &fs, &fc);
+		scalarSin.Add(std::fabs(fs - rs), x);
+		scalarCos.Add(std::fabs(fc - rc), x);
+		arraySin.Add(std::fabs(s[i] - rs), x);
+		arrayCos.Add(std::fabs(c[i] - rc), x);
+	}
+
+	Report("Sin", scalarSin);
+	Report("Cos", scalarCos);
+	Report("SinCos (array)", arraySin);
+	Report("SinCos (array) cos", arrayCos);
+	CHECK(scalarSin.error <= SIN_COS_MAX_ERROR);
+	CHECK(scalarCos.error <= SIN_COS_MAX_ERROR);
+	CHECK(arraySin.error <= SIN_COS_MAX_ERROR);
+	CHECK(arrayCos.error <= SIN_COS_MAX_ERROR);
+}
+
+// tan の誤差（|cos| < 1e-3 の極の付近を除く）
+// π の倍数の付近では tan が 0 に近く、範囲縮小の誤差で相対誤差は大きくなるので、
+// max(|tan x|, 1) に対する誤差で評価する（|x| <= π では相対誤差でも評価する）
+TEST_CASE(TanFullRange)
+{
+	std::vector<float> args = MakeArguments();
+	std::vector<float> t(args.size());
+	Tan(args.data(), t.data(), args.size());
+
+	MaxError scalarTan, arrayTan, relativeTan;
+	for (size_t i = 0; i < args.size(); i++)
+	{
+		float x = args[i];
+		if (std::fabs(std::cos(static_cast<double>(x))) < 1.0e-3) continue;
+
+		double r = std::tan(static_cast<double>(x));
+		double scale = std::max(std::fabs(r), 1.0);
+		scalarTan.Add(std::fabs(Tan(x) - r) / scale, x);
+		arrayTan.Add(std::fabs(t[i] - r) / scale, x);
+
+		if (std::fabs(x) <= 3.14159265f && r != 0.0)
+		{
+			relativeTan.Add(std::fabs(Tan(x) - r) / std::fabs(r), x);
+		}
+	}
+
+	Report("Tan", scalarTan);
+	Report("Tan (array)", arrayTan);
+	Report("Tan |x| <= pi rel", relativeTan);
+	CHECK(scalarTan.error <= TAN_MAX_ERROR);
+	CHECK(arrayTan.error <= TAN_MAX_ERROR);
+	CHECK(relativeTan.error <= TAN_MAX_ERROR);
+}
+
+// atan2 の絶対誤差（全ての方向と大きさ、軸上と 0 を含む）
+TEST_CASE(Atan2AllDirections)
+{
+	std::vector<float> ys, xs;
+	const float radii[] = { 1.0e-30f, 1.0e-3f, 1.0f, 7.0f, 1.0e3f, 1.0e30f };
+	const int steps = 200000;
+	for (float r : radii)
+	{
+		for (int i = 0; i <= steps; i++)
+		{
+			double angle = -3.141592653589793 + 6.283185307179586 * i / steps;
+			ys.push_back(static_cast<float>(r * std::sin(angle)));
+			xs.push_back(static_cast<float>(r * std::cos(angle)));
+		}
+	}
+	const float axes[] = { 0.0f, -0.0f, 1.0f, -1.0f, 1.0e-38f, -1.0e-38f };
+	for (float y : axes)
+	{
+		for (float x : axes)
+		{
+			ys.push_back(y);
+			xs.push_back(x);
+		}
+	}
+
+	std::vector<float> a(ys.size());
+	Atan2(ys.data(), xs.data(), a.data(), ys.size());
+
+	MaxError scalarAtan2, arrayAtan2;
+	for (size_t i = 0; i < ys.size(); i++)
+	{
+		// y = x = 0 は libm（x が -0 の場合は ±π）と異なるので下で別に調べる
+		if (ys[i] == 0.0f && xs[i] == 0.0f) continue;
+
+		double r = std::atan2(static_cast<double>(ys[i]), static_cast<double>(xs[i]));
+		scalarAtan2.Add(std::fabs(Atan2(ys[i], xs[i]) - r), ys[i]);
+		arrayAtan2.Add(std::fabs(a[i] - r), ys[i]);
+	}
+
+	Report("Atan2", scalarAtan2, "y");
+	Report("Atan2 (array)", arrayAtan2, "y");
+	CHECK(scalarAtan2.error <= ATAN2_MAX_ERROR);
+	CHECK(arrayAtan2.error <= ATAN2_MAX_ERROR);
+
+	// y = x = 0 の場合は y と同じ符号の 0、負の x 軸上は符号付きの π
+	const float zeros[] = { 0.0f, -0.0f };
+	for (float y : zeros)
+	{
+		for (float x : zeros)
+		{
+			float value = Atan2(y, x);
+			CHECK(value == 0.0f && std::signbit(value) == std::signbit(y));
+		}
+	}
+	CHECK_NEAR(Atan2(0.0f, -1.0f), 3.141592653589793, 3.0e-7);
+	CHECK_NEAR(Atan2(-0.0f, -1.0f), -3.141592653589793, 3.0e-7);
+}
+
+int main()
+{
+	return ImaseTest::RunTests();
+}
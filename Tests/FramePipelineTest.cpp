@@ -0,0 +1,253 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FramePipelineTest.cpp
+//
+// FramePipeline（更新をワーカーのスレッドで行い、スナップショットを描画するスレッドへ渡す）のテスト
+//
+// Game と同じように、ワーカーのスレッドが更新する状態をスナップショットへコピーし、
+// 描画するスレッドはスナップショットだけを読みます。更新と描画の時間を乱数（シード固定）で
+// ばらつかせても、描画されるスナップショットの並びがパイプラインを使わずに順番に
+// 実行した場合と同じになることと、描画中のスナップショットへ書き込まないこと、
+// 深さより先のフレームを作らないことを全ての深さで確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "FramePipeline.h"
+
+using namespace Imase;
+
+namespace
+{
+	constexpr uint32_t VALUE_COUNT = 64;
+
+	// 描画に渡すスナップショット（途中まで書き換えられていれば値が合わなくなる）
+	struct Snapshot
+	{
+		uint64_t frame;
+		float position;
+		uint32_t values[VALUE_COUNT];
+	};
+
+	// 更新する状態（ワーカーのスレッドだけが触る）
+	struct State
+	{
+		float position = 0.0f;
+		float velocity = 1.0f;
+
+		void Update(uint64_t frame)
+		{
+			velocity += (frame % 7 == 0) ? -0.5f : 0.125f;
+			position += velocity * (1.0f / 60.0f);
+		}
+	};
+
+	uint32_t Hash(uint64_t frame, uint32_t index)
+	{
+		uint32_t h = static_cast<uint32_t>(frame) * 2654435761u ^ (index * 40503u);
+		return h ^ (h >> 15);
+	}
+
+	void Capture(const State& state, uint64_t frame, Snapshot* snapshot)
+	{
+		snapshot->frame = frame;
+		snapshot->position = state.position;
+		for (uint32_t i = 0; i < VALUE_COUNT; i++) snapshot->values[i] = Hash(frame, i);
+	}
+
+	bool IsConsistent(const Snapshot& snapshot)
+	{
+		for (uint32_t i = 0; i < VALUE_COUNT; i++)
+		{
+			if (snapshot.values[i] != Hash(snapshot.frame, i)) return false;
+		}
+		return true;
+	}
+
+	// ときどき少しだけ眠って、更新と描画のどちらかが待つ状況を作る
+	void Jitter(std::mt19937* random)
+	{
+		uint32_t r = (*random)();
+		if (r % 4 == 0) std::this_thread::sleep_for(std::chrono::microseconds(r % 200));
+	}
+
+	// パイプラインを使わずに順番に実行した場合の描画する位置の並び
+	std::vector<float> RunSerial(uint32_t frameCount)
+	{
+		std::vector<float> positions;
+		State state;
+		Snapshot snapshot;
+		for (uint64_t frame = 0; frame < frameCount; frame++)
+		{
+			state.Update(frame);
+			Capture(state, frame, &snapshot);
+			positions.push_back(snapshot.position);
+		}
+		return positions;
+	}
+
+	// ワーカーのスレッドで更新してスナップショットを作る側
+	struct Producer
+	{
+		State state;
+		Snapshot snapshots[FramePipeline::MAX_DEPTH] = {};
+		uint32_t depth = 1;
+
+		// 描画するスレッドが持っているスナップショット
+		std::atomic<bool> held[FramePipeline::MAX_DEPTH] = {};
+
+		// 描画が終わったフレームの数（Release の前に増やす）
+		std::atomic<uint64_t> released{ 0 };
+
+		// 規則に反した回数（ワーカーのスレッドでは CHECK を使わない）
+		std::atomic<uint32_t> heldWrites{ 0 };
+		std::atomic<uint32_t> tooFarAhead{ 0 };
+		std::atomic<uint32_t> wrongSlots{ 0 };
+
+		std::mt19937 random{ 1 };
+
+		static void Produce(void* data, uint32_t slot, uint64_t frame)
+		{
+			Producer* p = static_cast<Producer*>(data);
+			if (p->held[slot].load()) p->heldWrites++;
+			if (frame >= p->released.load() + p->depth) p->tooFarAhead++;
+			if (slot != frame % p->depth) p->wrongSlots++;
+
+			p->state.Update(frame);
+			Jitter(&p->random);
+			Capture(p->state, frame, &p->snapshots[slot]);
+		}
+	};
+}
+
+// 描画されるスナップショットの並びは深さと時間のばらつきによらず順番に実行した場合と同じ
+TEST_CASE(SnapshotsMatchSerialExecution)
+{
+	const uint32_t frameCount = 300;
+	const std::vector<float> serial = RunSerial(frameCount);
+
+	for (uint32_t depth = 1; depth <= FramePipeline::MAX_DEPTH; depth++)
+	{
+		Producer producer;
+		producer.depth = depth;
+
+		FramePipeline pipeline;
+		pipeline.Start(depth, &Producer::Produce, &producer);
+		CHECK_EQUAL(pipeline.GetDepth(), depth);
+
+		std::mt19937 random(depth);
+		uint32_t wrongFrames = 0, torn = 0, mismatches = 0;
+		for (uint64_t expected = 0; expected < frameCount; expected++)
+		{
+			uint64_t frame = 0;
+			uint32_t slot = pipeline.Acquire(&frame);
+			producer.held[slot] = true;
+
+			// 描画（スナップショットだけを読む）
+			const Snapshot& snapshot = producer.snapshots[slot];
+			if (frame != expected || snapshot.frame != expected) wrongFrames++;
+			Jitter(&random);
+			if (!IsConsistent(snapshot)) torn++;
+			if (snapshot.position != serial[expected]) mismatches++;
+
+			producer.held[slot] = false;
+			producer.released++;
+			pipeline.Release();
+		}
+		pipeline.Stop();
+
+		CHECK_EQUAL(wrongFrames, 0u);
+		CHECK_EQUAL(torn, 0u);
+		CHECK_EQUAL(mismatches, 0u);
+		CHECK_EQUAL(producer.heldWrites.load(), 0u);
+		CHECK_EQUAL(producer.tooFarAhead.load(), 0u);
+		CHECK_EQUAL(producer.wrongSlots.load(), 0u);
+		CHECK_EQUAL(pipeline.GetStats().frameCount, uint64_t(frameCount));
+	}
+}
+
+// 描画するスレッドが止まっている間は深さの数のフレームまでしか作らない
+TEST_CASE(ProducerStopsAtDepth)
+{
+	for (uint32_t depth = 1; depth <= FramePipeline::MAX_DEPTH; depth++)
+	{
+		Producer producer;
+		producer.depth = depth;
+
+		FramePipeline pipeline;
+		pipeline.Start(depth, &Producer::Produce, &producer);
+
+		// 作れるだけ作らせてから受け取る（depth 個は待たずに受け取れる）
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		uint64_t frame = 0;
+		for (uint32_t i = 0; i < depth; i++)
+		{
+			pipeline.Acquire(&frame);
+			CHECK_EQUAL(frame, uint64_t(i));
+			CHECK(IsConsistent(producer.snapshots[frame % depth]));
+		}
+		CHECK_EQUAL(producer.tooFarAhead.load(), 0u);
+		pipeline.Stop();
+	}
+}
+
+// 停止すると描画していないスナップショットは捨て、再び開始するとフレーム 0 から始まる
+TEST_CASE(RestartBeginsAtFrameZero)
+{
+	Producer producer;
+	producer.depth = 2;
+
+	FramePipeline pipeline;
+	pipeline.Start(2, &Producer::Produce, &producer);
+	for (int i = 0; i < 5; i++)
+	{
+		pipeline.Acquire();
+		producer.released++;
+		pipeline.Release();
+	}
+	pipeline.Acquire();		// 返さずに停止する
+	pipeline.Stop();
+	CHECK(!pipeline.IsRunning());
+	CHECK_EQUAL(pipeline.GetStats().frameCount, uint64_t(5));
+
+	producer.released = 0;
+	pipeline.Start(2, &Producer::Produce, &producer);
+	CHECK_EQUAL(pipeline.GetStats().frameCount, uint64_t(0));
+
+	uint64_t frame = 1;
+	uint32_t slot = pipeline.Acquire(&frame);
+	CHECK_EQUAL(frame, uint64_t(0));
+	CHECK_EQUAL(slot, 0u);
+	CHECK_EQUAL(producer.snapshots[slot].frame, uint64_t(0));
+	producer.released++;
+	pipeline.Release();
+	pipeline.Stop();
+
+	const FramePipelineStats& stats = pipeline.GetStats();
+	CHECK_EQUAL(stats.frameCount, uint64_t(1));
+	CHECK(stats.minLatencySeconds <= stats.maxLatencySeconds);
+}
+
+// 深さは 1 ～ MAX_DEPTH に切り詰める
+TEST_CASE(DepthIsClamped)
+{
+	Producer producer;
+	FramePipeline pipeline;
+
+	pipeline.Start(0, &Producer::Produce, &producer);
+	CHECK_EQUAL(pipeline.GetDepth(), 1u);
+	pipeline.Stop();
+
+	pipeline.Start(FramePipeline::MAX_DEPTH + 3, &Producer::Produce, &producer);
+	CHECK_EQUAL(pipeline.GetDepth(), FramePipeline::MAX_DEPTH);
+	pipeline.Stop();
+}
+
+int main() { return ImaseTest::RunTests(); }
@@ -0,0 +1,146 @@
+﻿//--------------------------------------------------------------------------------------
+// File: FrustumCullingTest.cpp
+//
+// FrustumCulling（視錐台カリング）のテスト
+//
+// SIMD 版（CullSpheres / CullBoxes）の結果が、スカラー版の Frustum::Intersects を
+// １つずつ呼んだ結果と一致することを、端数とスレッドの分割を含めて確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <random>
+
+#include "FrustumCulling.h"
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	// カメラの視錐台（Near 0.1、Far 100）
+	Frustum CreateFrustum(bool infinite)
+	{
+		Matrix view = Matrix::CreateLookAt(Vector3(0.0f, 5.0f, 20.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3::Up());
+		Matrix proj = infinite
+			? Matrix::CreatePerspectiveInfiniteReverseZ(0.785398163f, 16.0f / 9.0f, 0.1f)
+			: Matrix::CreatePerspective(0.785398163f, 16.0f / 9.0f, 0.1f, 100.0f);
+		return Frustum::CreateFromViewProjection(view * proj);
+	}
+
+	// SoA 形式のスフィアと AABB
+	struct Bounds
+	{
+		std::vector<float> x, y, z, radius, ex, ey, ez;
+
+		explicit Bounds(size_t count, unsigned int seed = 7)
+		{
+			std::mt19937 random(seed);
+			std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+			std::uniform_real_distribution<float> size(0.1f, 5.0f);
+			for (size_t i = 0; i < count; i++)
+			{
+				x.push_back(position(random)); y.push_back(position(random) * 0.2f); z.push_back(position(random));
+				radius.push_back(size(random));
+				ex.push_back(size(random)); ey.push_back(size(random)); ez.push_back(size(random));
+			}
+		}
+
+		SphereArrays Spheres() const { return { x.data(), y.data(), z.data(), radius.data() }; }
+		BoxArrays Boxes() const { return { x.data(), y.data(), z.data(), ex.data(), ey.data(), ez.data() }; }
+	};
+
+	// スカラー版で見えている番号を求める
+	std::vector<uint32_t> CullSpheresScalar(const Frustum& f, const Bounds& b)
+	{
+		std::vector<uint32_t> out;
+		for (size_t i = 0; i < b.x.size(); i++)
+		{
+			if (f.Intersects(Vector3(b.x[i], b.y[i], b.z[i]), b.radius[i])) out.push_back(static_cast<uint32_t>(i));
+		}
+		return out;
+	}
+
+	std::vector<uint32_t> CullBoxesScalar(const Frustum& f, const Bounds& b)
+	{
+		std::vector<uint32_t> out;
+		for (size_t i = 0; i < b.x.size(); i++)
+		{
+			if (f.Intersects(Vector3(b.x[i], b.y[i], b.z[i]), Vector3(b.ex[i], b.ey[i], b.ez[i]))) out.push_back(static_cast<uint32_t>(i));
+		}
+		return out;
+	}
+
+	// SIMD 版で見えている番号を求める
+	std::vector<uint32_t> CullSpheresSimd(const Frustum& f, const Bounds& b, unsigned int threadCount)
+	{
+		std::vector<uint32_t> out(b.x.size());
+		out.resize(CullSpheres(f, b.Spheres(), b.x.size(), out.data(), threadCount));
+		return out;
+	}
+
+	std::vector<uint32_t> CullBoxesSimd(const Frustum& f, const Bounds& b, unsigned int threadCount)
+	{
+		std::vector<uint32_t> out(b.x.size());
+		out.resize(CullBoxes(f, b.Boxes(), b.x.size(), out.data(), threadCount));
+		return out;
+	}
+}
+
+// 視錐台の平面の数（無限遠の場合はファー平面がない）と、前後の判定
+TEST_CASE(FrustumPlanes)
+{
+	Frustum f = CreateFrustum(false);
+	CHECK_EQUAL(f.planeCount, 6);
+	CHECK_EQUAL(CreateFrustum(true).planeCount, 5);
+
+	// 注視点は見え、カメラの後ろと Far の外は見えない
+	CHECK(f.Intersects(Vector3(0.0f, 0.0f, 0.0f), 0.5f));
+	CHECK(!f.Intersects(Vector3(0.0f, 5.0f, 30.0f), 0.5f));
+	CHECK(!f.Intersects(Vector3(0.0f, -30.0f, -200.0f), 0.5f));
+	CHECK(CreateFrustum(true).Intersects(Vector3(0.0f, -30.0f, -200.0f), 0.5f));
+
+	// 平面をまたぐ大きな球と AABB は見える
+	CHECK(f.Intersects(Vector3(0.0f, 5.0f, 30.0f), 15.0f));
+	CHECK(f.Intersects(Vector3(0.0f, 5.0f, 30.0f), Vector3(15.0f, 15.0f, 15.0f)));
+}
+
+// SIMD 版は端数を含めてスカラー版と同じ番号を同じ順序で出力する
+TEST_CASE(SimdMatchesScalar)
+{
+	for (bool infinite : { false, true })
+	{
+		Frustum f = CreateFrustum(infinite);
+		for (size_t count = 0; count <= 40; count++)
+		{
+			Bounds b(count, static_cast<unsigned int>(count));
+			CHECK(CullSpheresSimd(f, b, 1) == CullSpheresScalar(f, b));
+			CHECK(CullBoxesSimd(f, b, 1) == CullBoxesScalar(f, b));
+		}
+
+		Bounds large(100000);
+		std::vector<uint32_t> spheres = CullSpheresScalar(f, large);
+		CHECK(!spheres.empty() && spheres.size() < large.x.size());
+		CHECK(CullSpheresSimd(f, large, 1) == spheres);
+		CHECK(CullBoxesSimd(f, large, 1) == CullBoxesScalar(f, large));
+	}
+}
+
+// スレッドに分割しても結果は１スレッドの場合と同じになる
+TEST_CASE(ThreadSplitMatchesSingleThread)
+{
+	Frustum f = CreateFrustum(false);
+	Bounds b(100003);
+	for (unsigned int threads : { 2u, 3u, 8u })
+	{
+		CHECK(CullSpheresSimd(f, b, threads) == CullSpheresSimd(f, b, 1));
+		CHECK(CullBoxesSimd(f, b, threads) == CullBoxesSimd(f, b, 1));
+	}
+}
+
+int main()
+{
+	return ImaseTest::RunTests();
+}
@@ -0,0 +1,238 @@
+﻿//--------------------------------------------------------------------------------------
+// File: JobSystemTest.cpp
+//
+// JobSystem（ワークスティーリングのジョブシステム）のストレステスト
+//
+// 大量のジョブ・入れ子の ParallelFor・継続の連鎖・ワーカー以外の複数のスレッドからの投入を
+// 繰り返し実行して、全てのジョブが１回ずつ実行されることと、実行した数の集計
+// （ワーカー以外のスレッドが実行した分をワーカー０に数えないこと）を確認します。
+// ジョブの中では CHECK を使わず、結果をアトミック変数へ集めてから確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.h"
+
+using namespace Imase;
+
+namespace
+{
+	// テストで使うワーカーの数（コアが少ない環境でもスレッドの取り合いを起こす）
+	constexpr unsigned int WORKER_COUNT = 4;
+
+	void Increment(void* data)
+	{
+		static_cast<std::atomic<uint32_t>*>(data)->fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// 積んだジョブは「キューから実行」か「領域が足りずにその場で実行」のどちらかで１回だけ数えられる
+	bool IsAccounted(const JobSystemStats& stats, uint64_t submitted)
+	{
+		return stats.executed + stats.inlined == submitted;
+	}
+}
+
+// 大量のジョブを積んでも全て１回ずつ実行される（ワーカーごとのジョブの領域より多い）
+TEST_CASE(ManyJobsRunExactlyOnce)
+{
+	JobSystem jobs;
+	jobs.Initialize(WORKER_COUNT);
+
+	const uint32_t count = JobSystem::MAX_JOBS * 8;
+	std::atomic<uint32_t> value{ 0 };
+	JobCounter counter;
+	for (uint32_t i = 0; i < count; i++) jobs.Run(&Increment, &value, &counter);
+	jobs.Wait(&counter);
+
+	CHECK(counter.IsDone());
+	CHECK_EQUAL(value.load(), count);
+	CHECK(IsAccounted(jobs.GetStats(), count));
+	CHECK_EQUAL(jobs.GetStats().external, uint64_t(0));
+}
+
+// ワーカー以外のスレッドが Wait で実行したジョブはワーカー０ではなく external に数える
+TEST_CASE(ExternalThreadJobsAreCountedSeparately)
+{
+	JobSystem jobs;
+	jobs.Initialize(1);		// ワーカーはこのスレッドだけで、ジョブを探すループは回らない
+
+	const uint32_t count = 1000;
+	std::atomic<uint32_t> value{ 0 };
+	std::thread external([&]()
+		{
+			JobCounter counter;
+			for (uint32_t i = 0; i < count; i++) jobs.Run(&Increment, &value, &counter);
+			jobs.Wait(&counter);
+		});
+	external.join();
+
+	JobSystemStats stats = jobs.GetStats();
+	CHECK_EQUAL(value.load(), count);
+	CHECK_EQUAL(stats.executed, uint64_t(count));
+	CHECK_EQUAL(stats.external, uint64_t(count));
+
+	jobs.ResetStats();
+	CHECK_EQUAL(jobs.GetStats().executed, uint64_t(0));
+	CHECK_EQUAL(jobs.GetStats().external, uint64_t(0));
+}
+
+// 複数のスレッドから同時に積んで待っても、それぞれのジョブが全て完了する
+TEST_CASE(ConcurrentExternalSubmitters)
+{
+	JobSystem jobs;
+	jobs.Initialize(WORKER_COUNT);
+
+	constexpr int THREAD_COUNT = 4;
+	const uint32_t perThread = 5000;
+	std::atomic<uint32_t> values[THREAD_COUNT] = {};
+	std::atomic<uint32_t> incomplete{ 0 };
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREAD_COUNT; t++)
+	{
+		threads.emplace_back([&, t]()
+			{
+				JobCounter counter;
+				for (uint32_t i = 0; i < perThread; i++) jobs.Run(&Increment, &values[t], &counter);
+				jobs.Wait(&counter);
+				if (values[t].load() != perThread) incomplete++;
+			});
+	}
+
+	// このスレッド（ワーカー０）も同時に ParallelFor を実行する
+	std::atomic<uint64_t> sum{ 0 };
+	jobs.ParallelFor(0, 100000, 64, [&](size_t begin, size_t end)
+		{
+			uint64_t local = 0;
+			for (size_t i = begin; i < end; i++) local += i;
+			sum.fetch_add(local, std::memory_order_relaxed);
+		});
+
+	for (std::thread& thread : threads) thread.join();
+
+	CHECK_EQUAL(incomplete.load(), 0u);
+	CHECK_EQUAL(sum.load(), uint64_t(100000) * 99999 / 2);
+	for (int t = 0; t < THREAD_COUNT; t++) CHECK_EQUAL(values[t].load(), perThread);
+}
+
+// ジョブの中で ParallelFor を呼んで待っても（入れ子）全ての要素が１回ずつ処理される
+TEST_CASE(NestedParallelFor)
+{
+	JobSystem jobs;
+	jobs.Initialize(WORKER_COUNT);
+
+	const size_t outer = 64;
+	const size_t inner = 1000;
+	std::vector<std::atomic<uint32_t>> visits(outer * inner);
+
+	jobs.ParallelFor(0, outer, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t o = begin; o < end; o++)
+			{
+				jobs.ParallelFor(0, inner, 16, [&, o](size_t b, size_t e)
+					{
+						for (size_t i = b; i < e; i++) visits[o * inner + i].fetch_add(1, std::memory_order_relaxed);
+					});
+			}
+		});
+
+	size_t wrong = 0;
+	for (const std::atomic<uint32_t>& v : visits) wrong += v.load() != 1;
+	CHECK_EQUAL(wrong, size_t(0));
+}
+
+// 継続は依存するカウンターが 0 になった後に、登録した順番の依存関係どおりに実行される
+TEST_CASE(ContinuationChainRunsInOrder)
+{
+	JobSystem jobs;
+	jobs.Initialize(WORKER_COUNT);
+
+	struct Step
+	{
+		std::atomic<uint32_t>* sequence;
+		std::atomic<uint32_t>* outOfOrder;
+		uint32_t index;
+	};
+
+	const uint32_t length = 2000;
+	std::atomic<uint32_t> sequence{ 0 };
+	std::atomic<uint32_t> outOfOrder{ 0 };
+	std::unique_ptr<JobCounter[]> counters(new JobCounter[length]);
+	std::vector<Step> steps(length);
+
+	JobFunction step = [](void* data)
+		{
+			Step* s = static_cast<Step*>(data);
+			if (s->sequence->fetch_add(1) != s->index) s->outOfOrder->fetch_add(1);
+		};
+
+	for (uint32_t i = 0; i < length; i++)
+	{
+		steps[i] = { &sequence, &outOfOrder, i };
+		jobs.RunAfter(i > 0 ? &counters[i - 1] : nullptr, step, &steps[i], &counters[i]);
+	}
+	jobs.Wait(&counters[length - 1]);
+
+	CHECK_EQUAL(sequence.load(), length);
+	CHECK_EQUAL(outOfOrder.load(), 0u);
+}
+
+// 多くのジョブの完了を待つ継続（ファンイン）は全てのジョブの後に１回だけ実行される
+TEST_CASE(FanInContinuationSeesAllJobs)
+{
+	JobSystem jobs;
+	jobs.Initialize(WORKER_COUNT);
+
+	struct FanIn
+	{
+		std::atomic<uint32_t> value{ 0 };
+		std::atomic<uint32_t> seen{ 0 };
+		std::atomic<uint32_t> calls{ 0 };
+	};
+
+	for (int round = 0; round < 50; round++)
+	{
+		FanIn fanIn;
+		JobCounter work, done;
+		for (int i = 0; i < 500; i++) jobs.Run(&Increment, &fanIn.value, &work);
+		jobs.RunAfter(&work, [](void* data)
+			{
+				FanIn* f = static_cast<FanIn*>(data);
+				f->seen = f->value.load();
+				f->calls++;
+			}, &fanIn, &done);
+		jobs.Wait(&done);
+
+		CHECK_EQUAL(fanIn.seen.load(), 500u);
+		CHECK_EQUAL(fanIn.calls.load(), 1u);
+	}
+}
+
+// 起動と終了を繰り返してもジョブを取りこぼさず、終了で止まらない
+TEST_CASE(RepeatedInitializeAndShutdown)
+{
+	JobSystem jobs;
+	for (int round = 0; round < 50; round++)
+	{
+		jobs.Initialize(WORKER_COUNT);
+
+		std::atomic<uint32_t> value{ 0 };
+		JobCounter counter;
+		for (int i = 0; i < 100; i++) jobs.Run(&Increment, &value, &counter);
+		jobs.Wait(&counter);
+		CHECK_EQUAL(value.load(), 100u);
+		CHECK(IsAccounted(jobs.GetStats(), 100));
+
+		jobs.Shutdown();
+		CHECK_EQUAL(jobs.GetWorkerCount(), 0u);
+	}
+}
+
+int main() { return ImaseTest::RunTests(); }
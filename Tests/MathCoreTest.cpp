@@ -0,0 +1,183 @@
+﻿//--------------------------------------------------------------------------------------
+// File: MathCoreTest.cpp
+//
+// MathCore（ベクトル・行列・クォータニオン）のテスト
+//
+// SIMD 版の行列の積・座標変換がスカラー版と一致すること、逆行列・回転・補間・
+// カメラ行列が SimpleMath と同じ規約になっていることを確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <random>
+
+#include "MathCore.h"
+
+using namespace Imase::Math;
+
+namespace
+{
+	// 要素の差が tolerance 以下か調べる関数
+	bool IsNear(const Matrix& a, const Matrix& b, float tolerance)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				if (std::fabs(a.m[i][j] - b.m[i][j]) > tolerance) return false;
+			}
+		}
+		return true;
+	}
+
+	bool IsNear(const Vector3& a, const Vector3& b, float tolerance)
+	{
+		return (a - b).Length() <= tolerance;
+	}
+
+	// 乱数で行列を作成する
+	Matrix RandomMatrix(std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> value(-2.0f, 2.0f);
+		Matrix m;
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++) m.m[i][j] = value(random);
+		}
+		return m;
+	}
+
+	// 乱数で回転を作成する
+	Quaternion RandomRotation(std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+		Quaternion q(value(random), value(random), value(random), value(random));
+		q.Normalize();
+		return q;
+	}
+
+	// コンパイル時にも計算できる
+	static_assert(Matrix::MultiplyScalar(Matrix::Identity(), Matrix::CreateScale(2.0f)) == Matrix::CreateScale(2.0f), "constexpr multiply");
+	static_assert(Matrix::CreateTranslation(Vector3(1.0f, 2.0f, 3.0f)).TransformPoint(Vector3()) == Vector3(1.0f, 2.0f, 3.0f), "constexpr transform");
+}
+
+// 行列の積の SIMD 版はスカラー版と一致する
+TEST_CASE(MultiplyMatchesScalar)
+{
+	std::mt19937 random(1);
+	for (int i = 0; i < 1000; i++)
+	{
+		Matrix a = RandomMatrix(random), b = RandomMatrix(random);
+		CHECK(IsNear(Matrix::Multiply(a, b), Matrix::MultiplyScalar(a, b), 1.0e-5f));
+	}
+}
+
+// ４次元ベクトルの座標変換の SIMD 版は行ベクトル × 行列と一致する
+TEST_CASE(TransformMatchesScalar)
+{
+	std::mt19937 random(2);
+	std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+	for (int i = 0; i < 1000; i++)
+	{
+		Matrix m = RandomMatrix(random);
+		Vector4 v(value(random), value(random), value(random), value(random));
+		Vector4 r = m.Transform(v);
+		for (int j = 0; j < 4; j++)
+		{
+			float expected = v.x * m.m[0][j] + v.y * m.m[1][j] + v.z * m.m[2][j] + v.w * m.m[3][j];
+			CHECK_NEAR((&r.x)[j], expected, 1.0e-4f);
+		}
+
+		// w = 1 の場合は TransformPoint と同じ
+		Vector3 p = m.TransformPoint(v.XYZ());
+		Vector4 q = m.Transform(Vector4(v.XYZ(), 1.0f));
+		CHECK(IsNear(p, q.XYZ(), 1.0e-4f));
+	}
+}
+
+// 逆行列を掛けると単位行列になり、回転＋平行移動の場合は転置版と一致する
+TEST_CASE(InvertRoundTrips)
+{
+	std::mt19937 random(3);
+	for (int i = 0; i < 200; i++)
+	{
+		Matrix world = Matrix::CreateWorld(Vector3(1.0f, -2.0f, 3.0f), RandomRotation(random), Vector3(0.5f, 2.0f, 1.5f));
+		CHECK(IsNear(world * world.Invert(), Matrix::Identity(), 1.0e-5f));
+
+		Matrix rigid = Matrix::CreateFromQuaternion(RandomRotation(random)) * Matrix::CreateTranslation(Vector3(4.0f, 5.0f, -6.0f));
+		CHECK(IsNear(rigid.InvertOrthonormal(), rigid.Invert(), 1.0e-5f));
+	}
+
+	// 特異な行列は 0 になる（例外やNaNにならない）
+	Matrix singular = Matrix::CreateScale(Vector3(1.0f, 0.0f, 1.0f));
+	Matrix zero(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+	CHECK(singular.Invert() == zero);
+}
+
+// クォータニオンの回転は回転行列と一致し、合成の順序は SimpleMath と同じ
+TEST_CASE(QuaternionMatchesMatrix)
+{
+	std::mt19937 random(4);
+	Vector3 v(0.3f, -1.2f, 2.5f);
+	for (int i = 0; i < 200; i++)
+	{
+		Quaternion a = RandomRotation(random), b = RandomRotation(random);
+		Matrix ma = Matrix::CreateFromQuaternion(a), mb = Matrix::CreateFromQuaternion(b);
+
+		CHECK(IsNear(a.Rotate(v), ma.TransformNormal(v), 1.0e-5f));
+
+		// a * b は a の後に b で回転する（行列では ma * mb）
+		CHECK(IsNear((a * b).Rotate(v), (ma * mb).TransformNormal(v), 1.0e-5f));
+	}
+
+	// ヨー・ピッチ・ロールはロール → ピッチ → ヨーの順で回転する
+	float yaw = 0.7f, pitch = -0.4f, roll = 1.1f;
+	Matrix expected = Matrix::CreateRotationZ(roll) * Matrix::CreateRotationX(pitch) * Matrix::CreateRotationY(yaw);
+	CHECK(IsNear(Matrix::CreateFromQuaternion(Quaternion::CreateFromYawPitchRoll(yaw, pitch, roll)), expected, 1.0e-5f));
+
+	// 軸と角度（右手系なので Y 軸回りに 90 度回すと +X は -Z へ向く）
+	Quaternion q = Quaternion::CreateFromAxisAngle(Vector3::UnitY(), PI / 2.0f);
+	CHECK(IsNear(q.Rotate(Vector3::UnitX()), Vector3(0.0f, 0.0f, -1.0f), 1.0e-6f));
+	CHECK(IsNear(q.Rotate(Vector3::UnitX()), Matrix::CreateRotationY(PI / 2.0f).TransformNormal(Vector3::UnitX()), 1.0e-6f));
+}
+
+// 球面線形補間は両端で元の回転になり、中間では角度が半分になる
+TEST_CASE(SlerpInterpolatesAngle)
+{
+	Quaternion a = Quaternion::Identity();
+	Quaternion b = Quaternion::CreateFromAxisAngle(Vector3::UnitY(), 2.0f);
+
+	CHECK(IsNear(Quaternion::Slerp(a, b, 0.0f).Rotate(Vector3::UnitX()), a.Rotate(Vector3::UnitX()), 1.0e-5f));
+	CHECK(IsNear(Quaternion::Slerp(a, b, 1.0f).Rotate(Vector3::UnitX()), b.Rotate(Vector3::UnitX()), 1.0e-5f));
+
+	Quaternion half = Quaternion::Slerp(a, b, 0.5f);
+	Quaternion expected = Quaternion::CreateFromAxisAngle(Vector3::UnitY(), 1.0f);
+	CHECK_NEAR(std::fabs(half.Dot(expected)), 1.0f, 1.0e-6f);
+
+	// 逆向きのクォータニオン（同じ回転）でも短い方を補間する
+	Quaternion negated(-b.x, -b.y, -b.z, -b.w);
+	CHECK_NEAR(std::fabs(Quaternion::Slerp(a, negated, 0.5f).Dot(expected)), 1.0f, 1.0e-6f);
+}
+
+// ビュー行列は視点を原点へ、注視点を -Z 方向へ移し、射影行列は Near / Far を 0 / 1 にする
+TEST_CASE(CameraMatricesFollowConventions)
+{
+	Vector3 eye(3.0f, 4.0f, 5.0f), focus(-1.0f, 0.5f, 2.0f);
+	Matrix view = Matrix::CreateLookAt(eye, focus, Vector3::Up());
+	CHECK(IsNear(view.TransformPoint(eye), Vector3(), 1.0e-5f));
+
+	Vector3 f = view.TransformPoint(focus);
+	CHECK(IsNear(f, Vector3(0.0f, 0.0f, -(focus - eye).Length()), 1.0e-5f));
+
+	Matrix ortho = Matrix::CreateOrthographicOffCenter(-2.0f, 2.0f, -1.0f, 1.0f, 0.5f, 10.0f);
+	CHECK_NEAR(ortho.TransformPoint(Vector3(0.0f, 0.0f, -0.5f)).z, 0.0f, 1.0e-6f);
+	CHECK_NEAR(ortho.TransformPoint(Vector3(0.0f, 0.0f, -10.0f)).z, 1.0f, 1.0e-6f);
+	CHECK(IsNear(ortho.TransformPoint(Vector3(2.0f, 1.0f, -1.0f)), Vector3(1.0f, 1.0f, ortho.TransformPoint(Vector3(0.0f, 0.0f, -1.0f)).z), 1.0e-6f));
+}
+
+int main()
+{
+	return ImaseTest::RunTests();
+}
@@ -0,0 +1,226 @@
+﻿//--------------------------------------------------------------------------------------
+// File: OcclusionCullingTest.cpp
+//
+// OcclusionCuller（マスク付きのソフトウェアオクルージョンカリング）が保守的であることのテスト
+//
+// カメラの前に壁を置き、壁の後ろに完全に隠れた AABB は取り除かれ、一部が見えている AABB・
+// 壁より手前の AABB・ニアクリップ面やカメラをまたぐ AABB は残ることを確認します。
+// ニアクリップ面をまたぐ斜めの壁（クリッピングされる遮蔽物）の後ろの AABB も確認します。
+// 乱数で置いた AABB については、取り除かれたものの表面の点がカメラから見えないことを
+// 壁との交差で調べます（バッファの解像度の分だけ壁を広げて判定します）。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "OcclusionCulling.h"
+
+using namespace Imase;
+
+namespace
+{
+	// カメラ（壁の正面、Z 軸の負の方向を見る）
+	const Math::Vector3 EYE(0.0f, 2.0f, 10.0f);
+	constexpr float FOV_Y = 1.04719755f;
+	constexpr float NEAR_PLANE = 0.1f;
+	constexpr float FAR_PLANE = 100.0f;
+
+	// Z 軸に垂直な壁（x0 ～ x1、y0 ～ y1）
+	struct Wall
+	{
+		float z;
+		float x0, x1;
+		float y0, y1;
+	};
+
+	// 遮蔽物の壁（正面の大きな壁・右の高い壁・奥の低い壁）
+	const Wall WALLS[] =
+	{
+		{  0.0f, -5.0f, -0.5f, -1.0f, 5.0f },
+		{  0.0f,  0.5f,  5.0f, -1.0f, 6.0f },
+		{ -6.0f, -3.0f,  3.0f, -1.0f, 2.5f },
+	};
+
+	// ビュー行列×射影行列
+	Math::Matrix GetViewProjection(const OcclusionCuller& culler)
+	{
+		Math::Matrix view = Math::Matrix::CreateLookAt(EYE, Math::Vector3(0.0f, 2.0f, 0.0f), Math::Vector3(0.0f, 1.0f, 0.0f));
+		float aspectRatio = static_cast<float>(culler.GetWidth()) / static_cast<float>(culler.GetHeight());
+		return view * Math::Matrix::CreatePerspective(FOV_Y, aspectRatio, NEAR_PLANE, FAR_PLANE);
+	}
+
+	// 四角形の遮蔽物を追加する
+	void AddQuad(OcclusionCuller* culler, const Math::Vector3& p0, const Math::Vector3& p1, const Math::Vector3& p2, const Math::Vector3& p3)
+	{
+		const Math::Vector3 positions[4] = { p0, p1, p2, p3 };
+		const uint16_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+		culler->AddOccluder(positions, 4, indices, 6, Math::Matrix::Identity());
+	}
+
+	// 壁を遮蔽物としてラスタライズする
+	void RenderWalls(OcclusionCuller* culler, const Wall* walls, size_t count)
+	{
+		culler->BeginFrame(GetViewProjection(*culler));
+		for (size_t i = 0; i < count; i++)
+		{
+			const Wall& w = walls[i];
+			AddQuad(culler,
+				Math::Vector3(w.x0, w.y1, w.z), Math::Vector3(w.x1, w.y1, w.z),
+				Math::Vector3(w.x1, w.y0, w.z), Math::Vector3(w.x0, w.y0, w.z));
+		}
+		culler->RenderOccluders(1);
+	}
+
+	// カメラから点までの線分が（margin だけ広げた）壁と交差するか
+	bool IsBehindWalls(const Math::Vector3& point, float pixelAngle)
+	{
+		for (const Wall& w : WALLS)
+		{
+			float t = (w.z - EYE.z) / (point.z - EYE.z);
+			if (!(t > 0.0f && t < 1.0f)) continue;
+
+			// 壁の位置での２ピクセル分の大きさ
+			float margin = 2.0f * pixelAngle * (EYE.z - w.z);
+			float x = EYE.x + (point.x - EYE.x) * t;
+			float y = EYE.y + (point.y - EYE.y) * t;
+			if (x >= w.x0 - margin && x <= w.x1 + margin && y >= w.y0 - margin && y <= w.y1 + margin) return true;
+		}
+		return false;
+	}
+
+	// AABB の表面の点（各面 5×5）が全て壁の後ろにあるか
+	bool IsHiddenBoxSampled(const Math::Vector3& center, const Math::Vector3& extents, float pixelAngle)
+	{
+		const float steps[5] = { -1.0f, -0.5f, 0.0f, 0.5f, 1.0f };
+		for (int axis = 0; axis < 3; axis++)
+		{
+			for (float side : { -1.0f, 1.0f })
+			{
+				for (float s : steps)
+				{
+					for (float t : steps)
+					{
+						float u[3];
+						u[axis] = side;
+						u[(axis + 1) % 3] = s;
+						u[(axis + 2) % 3] = t;
+						Math::Vector3 p(center.x + u[0] * extents.x, center.y + u[1] * extents.y, center.z + u[2] * extents.z);
+						if (!IsBehindWalls(p, pixelAngle)) return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+}
+
+// 壁の後ろに完全に隠れたものだけを取り除き、一部が見えるもの・手前のものは残す
+TEST_CASE(HiddenBoxesAreCulledVisibleBoxesKept)
+{
+	OcclusionCuller culler;
+	const Wall wall = { 0.0f, -5.0f, 5.0f, -1.0f, 5.0f };
+	RenderWalls(&culler, &wall, 1);
+	CHECK_EQUAL(culler.GetStats().rasterizedTriangles, 2u);
+
+	// 完全に隠れている（壁の真後ろ・壁の端の近くでも内側）
+	CHECK(!culler.IsVisible(Math::Vector3(0.0f, 2.0f, -5.0f), Math::Vector3(1.0f, 1.0f, 1.0f)));
+	CHECK(!culler.IsVisible(Math::Vector3(2.5f, 1.0f, -20.0f), Math::Vector3(1.0f, 1.0f, 1.0f)));
+
+	// 一部が壁の横・上から見えている
+	CHECK(culler.IsVisible(Math::Vector3(7.5f, 2.0f, -5.0f), Math::Vector3(1.0f, 1.0f, 1.0f)));
+	CHECK(culler.IsVisible(Math::Vector3(0.0f, 7.0f, -5.0f), Math::Vector3(1.0f, 1.0f, 1.0f)));
+
+	// 壁より手前・壁を貫いている
+	CHECK(culler.IsVisible(Math::Vector3(0.0f, 2.0f, 3.0f), Math::Vector3(1.0f, 1.0f, 1.0f)));
+	CHECK(culler.IsVisible(Math::Vector3(0.0f, 2.0f, 0.0f), Math::Vector3(1.0f, 1.0f, 1.0f)));
+
+	// 遮蔽物がなければ何も取り除かない
+	culler.BeginFrame(GetViewProjection(culler));
+	culler.RenderOccluders(1);
+	CHECK(culler.IsVisible(Math::Vector3(0.0f, 2.0f, -5.0f), Math::Vector3(1.0f, 1.0f, 1.0f)));
+}
+
+// ニアクリップ面やカメラをまたぐ AABB は常に残す
+TEST_CASE(BoxesCrossingNearPlaneAreKept)
+{
+	OcclusionCuller culler;
+	const Wall wall = { 0.0f, -5.0f, 5.0f, -1.0f, 5.0f };
+	RenderWalls(&culler, &wall, 1);
+
+	// カメラを囲む
+	CHECK(culler.IsVisible(EYE, Math::Vector3(1.0f, 1.0f, 1.0f)));
+
+	// カメラの前だがニアクリップ面をまたぐ（全ての頂点の w は正）
+	CHECK(culler.IsVisible(Math::Vector3(0.0f, 2.0f, 9.5f), Math::Vector3(0.5f, 0.5f, 0.47f)));
+
+	// カメラの後ろから壁の後ろまで伸びる
+	CHECK(culler.IsVisible(Math::Vector3(0.0f, 2.0f, 0.0f), Math::Vector3(0.5f, 0.5f, 12.0f)));
+
+	// ニアクリップ面をまたぐ斜めの壁（クリッピングされる）の後ろは隠れている
+	culler.BeginFrame(GetViewProjection(culler));
+	AddQuad(&culler,
+		Math::Vector3(-50.0f, 50.0f, 30.0f), Math::Vector3(50.0f, 50.0f, -20.0f),
+		Math::Vector3(50.0f, -50.0f, -20.0f), Math::Vector3(-50.0f, -50.0f, 30.0f));
+	culler.RenderOccluders(1);
+	CHECK(culler.GetStats().rasterizedTriangles > 0);
+	CHECK(!culler.IsVisible(Math::Vector3(0.0f, 2.0f, -10.0f), Math::Vector3(1.0f, 1.0f, 1.0f)));
+
+	// 同じ壁の手前でニアクリップ面をまたぐものは残す
+	CHECK(culler.IsVisible(Math::Vector3(0.0f, 2.0f, 9.5f), Math::Vector3(0.5f, 0.5f, 0.47f)));
+}
+
+// 取り除かれた AABB は表面のどの点も見えない（乱数で置いた多数の AABB）
+TEST_CASE(CulledBoxesAreHidden)
+{
+	OcclusionCuller culler;
+	RenderWalls(&culler, WALLS, sizeof(WALLS) / sizeof(WALLS[0]));
+
+	// １ピクセルの角度の大きさ（縦方向、tan の値）
+	float pixelAngle = 2.0f * tanf(FOV_Y * 0.5f) / static_cast<float>(culler.GetHeight());
+
+	const size_t count = 4000;
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> x(-12.0f, 12.0f);
+	std::uniform_real_distribution<float> y(-2.0f, 8.0f);
+	std::uniform_real_distribution<float> z(-40.0f, 9.0f);
+	std::uniform_real_distribution<float> extent(0.05f, 1.5f);
+
+	std::vector<float> cx(count), cy(count), cz(count), ex(count), ey(count), ez(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		cx[i] = x(random); cy[i] = y(random); cz[i] = z(random);
+		ex[i] = extent(random); ey[i] = extent(random); ez[i] = extent(random);
+	}
+	BoxArrays boxes = { cx.data(), cy.data(), cz.data(), ex.data(), ey.data(), ez.data() };
+
+	std::vector<uint32_t> visible(count);
+	size_t visibleCount = culler.CullBoxes(boxes, nullptr, count, visible.data(), 1);
+	CHECK_EQUAL(culler.GetStats().testedObjects, static_cast<uint32_t>(count));
+	CHECK_EQUAL(culler.GetStats().occludedObjects, static_cast<uint32_t>(count - visibleCount));
+
+	// 十分な数が取り除かれている（全て残すだけの実装では通らない）
+	CHECK(count - visibleCount > 200);
+
+	std::vector<bool> isVisible(count, false);
+	for (size_t i = 0; i < visibleCount; i++) isVisible[visible[i]] = true;
+
+	uint32_t wronglyCulled = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (isVisible[i]) continue;
+		Math::Vector3 center(cx[i], cy[i], cz[i]);
+		Math::Vector3 extents(ex[i], ey[i], ez[i]);
+		if (!IsHiddenBoxSampled(center, extents, pixelAngle)) wronglyCulled++;
+
+		// IsVisible と CullBoxes の結果は同じ
+		CHECK(!culler.IsVisible(center, extents));
+	}
+	CHECK_EQUAL(wronglyCulled, 0u);
+}
+
+int main() { return ImaseTest::RunTests(); }
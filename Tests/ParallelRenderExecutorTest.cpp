@@ -0,0 +1,265 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ParallelRenderExecutorTest.cpp
+//
+// ParallelRenderExecutor（パケットを分割して並列に記録して順番に実行する）のテスト
+//
+// 同じソート済みのキューを、メインスレッドで直接描画した場合と、チャンクに分けて
+// RenderCommandList へ並列に記録して NullRenderContext で再生した場合で比べます。
+// チャンクはステートが分からない状態から記録するので、ステートを設定するコマンドの数は
+// 増えますが、描画の順番・引数と、それぞれの描画の時点で設定されているステートは
+// 同じでなければなりません（記録したコマンドを先頭から再生して求めます）。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include "NullRenderContext.h"
+#include "ParallelRenderExecutor.h"
+#include "RenderQueue.h"
+
+using namespace Imase;
+
+namespace
+{
+	constexpr uint32_t SHADER_COUNT = 3;
+	constexpr uint32_t MATERIAL_COUNT = 5;
+	constexpr uint32_t INDEX_COUNT = 3 * 64;
+
+	// 描画の時点のステート（コマンドの種類ごとの最後の値）と描画のコマンド
+	enum StateSlot
+	{
+		INPUT_LAYOUT, TOPOLOGY, INDEX_BUFFER, VERTEX_BUFFER, VERTEX_SHADER, PIXEL_SHADER,
+		SHADER_RESOURCE, SAMPLER, RASTERIZER, DRAW_TYPE, DRAW_ARG0, DRAW_ARG1, DRAW_ARG2, STATE_SLOT_COUNT
+	};
+	using DrawState = std::array<uint32_t, STATE_SLOT_COUNT>;
+
+	// 記録したコマンドを先頭から再生して、描画ごとのステートを求める
+	std::vector<DrawState> CollectDraws(const std::vector<NullRenderCommandRecord>& records)
+	{
+		std::vector<DrawState> draws;
+		DrawState state = {};
+		for (const NullRenderCommandRecord& record : records)
+		{
+			switch (record.type)
+			{
+			case NullRenderCommand::IASetInputLayout:		state[INPUT_LAYOUT] = record.args[0]; break;
+			case NullRenderCommand::IASetPrimitiveTopology:	state[TOPOLOGY] = record.args[0]; break;
+			case NullRenderCommand::IASetIndexBuffer:		state[INDEX_BUFFER] = record.args[0]; break;
+			case NullRenderCommand::VSSetShader:			state[VERTEX_SHADER] = record.args[0]; break;
+			case NullRenderCommand::PSSetShader:			state[PIXEL_SHADER] = record.args[0]; break;
+			case NullRenderCommand::RSSetState:				state[RASTERIZER] = record.args[0]; break;
+			// スロットのある設定は (先頭のスロット, 数, 先頭のリソース) なのでスロット０だけ追う
+			case NullRenderCommand::IASetVertexBuffers:		if (record.args[0] == 0) state[VERTEX_BUFFER] = record.args[2]; break;
+			case NullRenderCommand::PSSetShaderResources:	if (record.args[0] == 0) state[SHADER_RESOURCE] = record.args[2]; break;
+			case NullRenderCommand::PSSetSamplers:			if (record.args[0] == 0) state[SAMPLER] = record.args[2]; break;
+			case NullRenderCommand::Draw:
+			case NullRenderCommand::DrawIndexed:
+			case NullRenderCommand::DrawIndexedInstanced:
+				state[DRAW_TYPE] = static_cast<uint32_t>(record.type);
+				state[DRAW_ARG0] = record.args[0];
+				state[DRAW_ARG1] = record.args[1];
+				state[DRAW_ARG2] = record.args[2];
+				draws.push_back(state);
+				break;
+			default:
+				break;
+			}
+		}
+		return draws;
+	}
+
+	// シェーダーとマテリアルごとにステートを設定して描画するハンドラー
+	class TestHandler : public IParallelRenderPacketHandler
+	{
+	public:
+
+		explicit TestHandler(NullRenderContext* null)
+		{
+			m_inputLayout = null->CreateInputLayout(1);
+			m_vertexBuffer = null->CreateBuffer(1024, false);
+			m_indexBuffer = null->CreateBuffer(INDEX_COUNT * 2, false);
+			for (uint32_t i = 0; i < SHADER_COUNT; i++)
+			{
+				m_vertexShaders[i] = null->CreateVertexShader();
+				m_pixelShaders[i] = null->CreatePixelShader();
+				m_rasterizerStates[i] = null->CreateRasterizerState();
+			}
+			for (uint32_t i = 0; i < MATERIAL_COUNT; i++)
+			{
+				m_views[i] = null->CreateShaderResource();
+				m_samplers[i] = null->CreateSampler();
+			}
+			m_externalPixelShader = null->CreatePixelShader();
+		}
+
+		void BindShader(StateFilteredContext<IRenderContext>& context, uint32_t shader) override
+		{
+			context.IASetInputLayout(m_inputLayout);
+			context.IASetPrimitiveTopology(RenderTopology::TriangleList);
+			context.VSSetShader(m_vertexShaders[shader], static_cast<RenderClassInstance* const*>(nullptr), 0);
+			context.PSSetShader(m_pixelShaders[shader], static_cast<RenderClassInstance* const*>(nullptr), 0);
+			context.RSSetState(m_rasterizerStates[shader]);
+		}
+
+		void BindMaterial(StateFilteredContext<IRenderContext>& context, uint32_t material) override
+		{
+			context.PSSetShaderResources(0, 1, &m_views[material]);
+			context.PSSetSamplers(0, 1, &m_samplers[material]);
+		}
+
+		void Draw(StateFilteredContext<IRenderContext>& context, const RenderPacket& packet) override
+		{
+			const uint32_t stride = 16, offset = 0;
+
+			// EXTERNAL_SHADER のパケットはラッパーを通さずに自分でステートを設定する（DirectXTK と同じ）
+			if (packet.shader == RenderQueue::EXTERNAL_SHADER)
+			{
+				IRenderContext* raw = context.Get();
+				raw->IASetInputLayout(m_inputLayout);
+				raw->IASetVertexBuffers(0, 1, &m_vertexBuffer, &stride, &offset);
+				raw->IASetPrimitiveTopology(RenderTopology::TriangleStrip);
+				raw->VSSetShader(m_vertexShaders[0], nullptr, 0);
+				raw->PSSetShader(m_externalPixelShader, nullptr, 0);
+				raw->Draw(4, packet.argument);
+				return;
+			}
+
+			context.IASetVertexBuffers(0, 1, &m_vertexBuffer, &stride, &offset);
+			context.IASetIndexBuffer(m_indexBuffer, RenderIndexFormat::UInt16, 0);
+			if (packet.command == 0)
+			{
+				context.Get()->DrawIndexed(3 + 3 * (packet.argument % 32), 0, 0);
+			}
+			else
+			{
+				context.Get()->DrawIndexedInstanced(6, packet.argument + 1, 0, 0, packet.command);
+			}
+		}
+
+	private:
+
+		RenderInputLayout* m_inputLayout;
+		RenderBuffer* m_vertexBuffer;
+		RenderBuffer* m_indexBuffer;
+		RenderVertexShader* m_vertexShaders[SHADER_COUNT];
+		RenderPixelShader* m_pixelShaders[SHADER_COUNT];
+		RenderRasterizerState* m_rasterizerStates[SHADER_COUNT];
+		RenderShaderResource* m_views[MATERIAL_COUNT];
+		RenderSampler* m_samplers[MATERIAL_COUNT];
+		RenderPixelShader* m_externalPixelShader;
+	};
+
+	// ２つのレイヤー（手前から奥・奥から手前）にランダムなパケットを積む（一部は EXTERNAL_SHADER）
+	void FillQueue(RenderQueue* queue, size_t count, uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		queue->SetLayerSortMode(1, RenderSortMode::BackToFront);
+		queue->Clear();
+		for (size_t i = 0; i < count; i++)
+		{
+			uint32_t layer = random() % 2;
+			float depth = static_cast<float>(random() % 1000) * 0.1f;
+			uint32_t argument = random() % 100;
+			if (random() % 20 == 0)
+			{
+				queue->Submit(layer, RenderQueue::EXTERNAL_SHADER, 0, depth, 0, argument);
+			}
+			else
+			{
+				queue->Submit(layer, random() % SHADER_COUNT, random() % MATERIAL_COUNT, depth, random() % 3, argument);
+			}
+		}
+		queue->Sort();
+	}
+
+	// 直接描画した場合の描画ごとのステートを求める
+	std::vector<DrawState> ExecuteSerial(NullRenderContext* null, TestHandler* handler, const RenderQueue& queue)
+	{
+		null->ClearState();
+		null->ClearRecordedCommands();
+		null->ResetStats();
+
+		StateFilteredContext<IRenderContext> context;
+		context.Reset(null);
+		ParallelRenderExecutor executor;
+		executor.Execute(queue, handler, &context, nullptr, 1);
+		return CollectDraws(null->GetRecordedCommands());
+	}
+}
+
+// 並列に記録したコマンドリストを再生しても、直接描画した場合と同じ描画になる
+TEST_CASE(ChunkedRecordingMatchesSerial)
+{
+	NullRenderContext null;
+	TestHandler handler(&null);
+	null.SetRecording(true);
+
+	RenderQueue queue;
+	FillQueue(&queue, 2000, 1);
+
+	std::vector<DrawState> serial = ExecuteSerial(&null, &handler, queue);
+	CHECK_EQUAL(serial.size(), queue.GetPacketCount());
+	CHECK_EQUAL(null.GetStats().errors, 0u);
+	uint32_t serialStateChanges = null.GetStats().stateChanges;
+
+	for (uint32_t chunkCount : { 2u, 3u, 4u, 8u, 64u })
+	{
+		null.ClearState();
+		null.ClearRecordedCommands();
+		null.ResetStats();
+
+		StateFilteredContext<IRenderContext> context;
+		context.Reset(&null);
+		RenderCommandListRecorder recorder(&null);
+		ParallelRenderExecutor executor;
+		executor.Execute(queue, &handler, &context, &recorder, chunkCount);
+
+		std::vector<DrawState> chunked = CollectDraws(null.GetRecordedCommands());
+		CHECK_EQUAL(null.GetStats().errors, 0u);
+		CHECK(executor.GetParallelStats().chunkCount > chunkCount);		// EXTERNAL_SHADER で区切られるので多くなる
+		CHECK_EQUAL(executor.GetStats().packetCount, queue.GetPacketCount());
+		CHECK(chunked == serial);
+
+		// チャンクごとにステートを設定し直すので、設定の回数は直接描画より少なくならない
+		CHECK(null.GetStats().stateChanges >= serialStateChanges);
+	}
+}
+
+// パケットが少なくチャンクの最小の数を下回る場合も同じ描画になる
+TEST_CASE(SmallQueuesAndMinPacketsPerChunk)
+{
+	NullRenderContext null;
+	TestHandler handler(&null);
+	null.SetRecording(true);
+
+	for (size_t count : { size_t(1), size_t(2), size_t(7), size_t(33) })
+	{
+		RenderQueue queue;
+		FillQueue(&queue, count, static_cast<uint32_t>(count));
+		std::vector<DrawState> serial = ExecuteSerial(&null, &handler, queue);
+
+		for (size_t minPackets : { size_t(1), size_t(4), size_t(100) })
+		{
+			null.ClearState();
+			null.ClearRecordedCommands();
+			null.ResetStats();
+
+			StateFilteredContext<IRenderContext> context;
+			context.Reset(&null);
+			RenderCommandListRecorder recorder(&null);
+			ParallelRenderExecutor executor;
+			executor.SetMinPacketsPerChunk(minPackets);
+			executor.Execute(queue, &handler, &context, &recorder, 4);
+
+			CHECK(CollectDraws(null.GetRecordedCommands()) == serial);
+			CHECK_EQUAL(null.GetStats().errors, 0u);
+		}
+	}
+}
+
+int main() { return ImaseTest::RunTests(); }
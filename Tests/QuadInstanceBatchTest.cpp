@@ -0,0 +1,278 @@
+﻿//--------------------------------------------------------------------------------------
+// File: QuadInstanceBatchTest.cpp
+//
+// QuadInstanceBatch（四角形ポリゴンのインスタンス描画のデータ）のテスト
+//
+// ワールド行列が転置した上３行として色・テクスチャ座標の範囲と一緒に詰められることと、
+// Build がテクスチャごとに追加した順番を保ってまとめることを確認します。
+// 描画は NullRenderContext で行い、インスタンスがバッファに入りきる場合は１回の書き込みと
+// 範囲ごとに１回の描画になり、入りきらない場合は範囲を capacity 個ずつ書き込んで描画する
+// （書き込んだ内容・描画の回数・インスタンスの数が GetDrawCount と一致する）ことを確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <cstring>
+#include <vector>
+
+#include "NullRenderContext.h"
+#include "QuadInstanceBatch.h"
+
+using namespace Imase;
+
+namespace
+{
+	// UpdateBuffer で書き込んだインスタンスを覚えておくコンテキスト
+	class UploadRecordingContext : public NullRenderContext
+	{
+	public:
+
+		bool UpdateBuffer(RenderBuffer* buffer, const void* data, size_t size) override
+		{
+			const QuadInstance* instances = static_cast<const QuadInstance*>(data);
+			uploads.emplace_back(instances, instances + size / sizeof(QuadInstance));
+			return NullRenderContext::UpdateBuffer(buffer, data, size);
+		}
+
+		// 書き込みごとのインスタンス
+		std::vector<std::vector<QuadInstance>> uploads;
+	};
+
+	// 描画に必要なステートを設定したコンテキストとインスタンス用の頂点バッファ
+	struct Fixture
+	{
+		UploadRecordingContext context;
+		RenderBuffer* instanceBuffer;
+
+		explicit Fixture(uint32_t capacity)
+		{
+			RenderBuffer* vertexBuffer = context.CreateBuffer(4 * 32, false);
+			RenderBuffer* indexBuffer = context.CreateBuffer(6 * sizeof(uint16_t), false);
+			instanceBuffer = context.CreateBuffer(capacity * sizeof(QuadInstance), true);
+
+			RenderBuffer* buffers[] = { vertexBuffer, instanceBuffer };
+			uint32_t strides[] = { 32, sizeof(QuadInstance) };
+			uint32_t offsets[] = { 0, 0 };
+			context.IASetInputLayout(context.CreateInputLayout(2));
+			context.IASetPrimitiveTopology(RenderTopology::TriangleList);
+			context.IASetVertexBuffers(0, 2, buffers, strides, offsets);
+			context.IASetIndexBuffer(indexBuffer, RenderIndexFormat::UInt16, 0);
+			context.VSSetShader(context.CreateVertexShader(), nullptr, 0);
+			context.PSSetShader(context.CreatePixelShader(), nullptr, 0);
+
+			context.SetRecording(true);
+			context.ResetStats();
+		}
+
+		// 記録した描画のコマンド
+		std::vector<NullRenderCommandRecord> Draws() const
+		{
+			std::vector<NullRenderCommandRecord> draws;
+			for (const NullRenderCommandRecord& record : context.GetRecordedCommands())
+			{
+				if (record.type == NullRenderCommand::DrawIndexedInstanced) draws.push_back(record);
+			}
+			return draws;
+		}
+	};
+
+	// 番号が分かるインスタンスを追加する（色の r に番号を入れる）
+	void AddNumbered(QuadInstanceBatch* batch, uint32_t texture, uint32_t number)
+	{
+		Math::Matrix world = Math::Matrix::CreateTranslation(Math::Vector3(static_cast<float>(number), 0.0f, 0.0f));
+		batch->Add(texture, world, Math::Vector4(static_cast<float>(number), 0.0f, 0.0f, 1.0f));
+	}
+
+	// インスタンスの番号
+	uint32_t GetNumber(const QuadInstance& instance)
+	{
+		return static_cast<uint32_t>(instance.tint.x);
+	}
+
+	// 全ての範囲を描画して描画の回数を返す
+	uint32_t DrawAll(const QuadInstanceBatch& batch, Fixture* f, uint32_t capacity)
+	{
+		batch.Upload(&f->context, f->instanceBuffer, capacity);
+
+		uint32_t drawCount = 0;
+		for (size_t i = 0; i < batch.GetRanges().size(); i++)
+		{
+			drawCount += batch.DrawRange(&f->context, f->instanceBuffer, capacity, i, 6);
+		}
+		return drawCount;
+	}
+}
+
+// ワールド行列は転置した上３行、色とテクスチャ座標の範囲はそのまま詰める
+TEST_CASE(PacksTransposedRows)
+{
+	Math::Matrix world = Math::Matrix::CreateRotationY(0.5f) * Math::Matrix::CreateTranslation(Math::Vector3(1.0f, 2.0f, 3.0f));
+	Math::Vector4 tint(0.5f, 0.25f, 0.125f, 0.75f);
+	Math::Vector4 uvRect(0.25f, 0.5f, 0.125f, 0.25f);
+
+	QuadInstance instance;
+	PackQuadInstance(world, tint, uvRect, &instance);
+
+	for (int row = 0; row < 3; row++)
+	{
+		CHECK_EQUAL(instance.world[row].x, world.m[0][row]);
+		CHECK_EQUAL(instance.world[row].y, world.m[1][row]);
+		CHECK_EQUAL(instance.world[row].z, world.m[2][row]);
+		CHECK_EQUAL(instance.world[row].w, world.m[3][row]);
+	}
+	CHECK_EQUAL(instance.world[0].w, 1.0f);
+	CHECK_EQUAL(instance.world[1].w, 2.0f);
+	CHECK_EQUAL(instance.world[2].w, 3.0f);
+	CHECK(std::memcmp(&instance.tint, &tint, sizeof(tint)) == 0);
+	CHECK(std::memcmp(&instance.uvRect, &uvRect, sizeof(uvRect)) == 0);
+
+	// 位置・回転・スケールから追加しても CreateWorld の行列と同じ
+	Math::Vector3 position(4.0f, 5.0f, 6.0f);
+	Math::Quaternion rotation = Math::Quaternion::CreateFromAxisAngle(Math::Vector3(0.0f, 1.0f, 0.0f), 0.3f);
+	Math::Vector3 scale(2.0f, 3.0f, 4.0f);
+	QuadInstanceBatch batch;
+	batch.Add(0, position, rotation, scale);
+	batch.Build();
+
+	QuadInstance expected;
+	PackQuadInstance(Math::Matrix::CreateWorld(position, rotation, scale),
+		QuadInstanceBatch::DEFAULT_TINT, QuadInstanceBatch::DEFAULT_UV_RECT, &expected);
+	CHECK_EQUAL(batch.GetInstanceCount(), size_t(1));
+	CHECK(std::memcmp(batch.GetInstances(), &expected, sizeof(QuadInstance)) == 0);
+}
+
+// テクスチャごとにまとめ、同じテクスチャの中では追加した順番を保つ
+TEST_CASE(BuildGroupsByTextureInOrder)
+{
+	const uint32_t textures[] = { 2, 0, 2, 2, 0, 3, 0, 2 };
+	QuadInstanceBatch batch;
+	for (uint32_t i = 0; i < 8; i++) AddNumbered(&batch, textures[i], i);
+	batch.Build();
+
+	// テクスチャ 1 は使っていないので範囲がない
+	const std::vector<QuadInstanceRange>& ranges = batch.GetRanges();
+	CHECK_EQUAL(ranges.size(), size_t(3));
+	if (ranges.size() == 3)
+	{
+		CHECK_EQUAL(ranges[0].texture, 0u); CHECK_EQUAL(ranges[0].firstInstance, 0u); CHECK_EQUAL(ranges[0].instanceCount, 3u);
+		CHECK_EQUAL(ranges[1].texture, 2u); CHECK_EQUAL(ranges[1].firstInstance, 3u); CHECK_EQUAL(ranges[1].instanceCount, 4u);
+		CHECK_EQUAL(ranges[2].texture, 3u); CHECK_EQUAL(ranges[2].firstInstance, 7u); CHECK_EQUAL(ranges[2].instanceCount, 1u);
+	}
+
+	const uint32_t expected[] = { 1, 4, 6, 0, 2, 3, 7, 5 };
+	CHECK_EQUAL(batch.GetInstanceCount(), size_t(8));
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		CHECK_EQUAL(GetNumber(batch.GetInstances()[i]), expected[i]);
+	}
+
+	// テクスチャが１種類の場合は追加した順のまま１つの範囲になる
+	batch.Clear();
+	CHECK_EQUAL(batch.GetInstanceCount(), size_t(0));
+	CHECK(batch.GetRanges().empty());
+	for (uint32_t i = 0; i < 5; i++) AddNumbered(&batch, 4, i);
+	batch.Build();
+	CHECK_EQUAL(batch.GetRanges().size(), size_t(1));
+	CHECK_EQUAL(batch.GetRanges()[0].texture, 4u);
+	CHECK_EQUAL(batch.GetRanges()[0].instanceCount, 5u);
+	for (uint32_t i = 0; i < 5; i++)
+	{
+		CHECK_EQUAL(GetNumber(batch.GetInstances()[i]), i);
+	}
+}
+
+// バッファに入りきる場合は１回だけ書き込み、範囲ごとに１回描画する
+TEST_CASE(FitsInOneUpload)
+{
+	const uint32_t capacity = 16;
+	Fixture f(capacity);
+
+	QuadInstanceBatch batch;
+	for (uint32_t i = 0; i < 10; i++) AddNumbered(&batch, i % 3, i);
+	batch.Build();
+
+	CHECK_EQUAL(DrawAll(batch, &f, capacity), 3u);
+	CHECK_EQUAL(batch.GetDrawCount(capacity), size_t(3));
+	CHECK_EQUAL(f.context.GetStats().errors, 0u);
+	CHECK_EQUAL(f.context.GetStats().maps, 1u);
+	CHECK_EQUAL(f.context.GetStats().draws, 3u);
+	CHECK_EQUAL(f.context.GetStats().instances, uint64_t(10));
+
+	CHECK_EQUAL(f.context.uploads.size(), size_t(1));
+	CHECK_EQUAL(f.context.uploads[0].size(), size_t(10));
+
+	// 範囲の位置を StartInstanceLocation に指定する
+	std::vector<NullRenderCommandRecord> draws = f.Draws();
+	CHECK_EQUAL(draws.size(), size_t(3));
+	for (size_t i = 0; i < draws.size(); i++)
+	{
+		CHECK_EQUAL(draws[i].args[1], batch.GetRanges()[i].instanceCount);
+		CHECK_EQUAL(draws[i].args[2], batch.GetRanges()[i].firstInstance);
+	}
+
+	// 空のバッチは書き込まず描画もしない
+	batch.Clear();
+	batch.Build();
+	f.context.ResetStats();
+	CHECK(!batch.Upload(&f.context, f.instanceBuffer, capacity));
+	CHECK_EQUAL(batch.GetDrawCount(capacity), size_t(0));
+	CHECK_EQUAL(f.context.GetStats().maps, 0u);
+}
+
+// 入りきらない場合は範囲を capacity 個ずつバッファの先頭へ書き込んで描画する
+TEST_CASE(OverflowFlushesInChunks)
+{
+	const uint32_t capacity = 4;
+	Fixture f(capacity);
+
+	// テクスチャ 0 が 10 個、テクスチャ 1 が 3 個、テクスチャ 2 が 4 個
+	QuadInstanceBatch batch;
+	uint32_t number = 0;
+	for (uint32_t i = 0; i < 10; i++) AddNumbered(&batch, 0, number++);
+	for (uint32_t i = 0; i < 3; i++) AddNumbered(&batch, 1, number++);
+	for (uint32_t i = 0; i < 4; i++) AddNumbered(&batch, 2, number++);
+	batch.Build();
+
+	// 3 + 1 + 1 回
+	CHECK(!batch.Upload(&f.context, f.instanceBuffer, capacity));
+	CHECK(f.context.uploads.empty());
+	CHECK_EQUAL(batch.GetDrawCount(capacity), size_t(5));
+
+	f.context.ResetStats();
+	CHECK_EQUAL(DrawAll(batch, &f, capacity), 5u);
+	CHECK_EQUAL(f.context.GetStats().errors, 0u);
+	CHECK_EQUAL(f.context.GetStats().draws, 5u);
+	CHECK_EQUAL(f.context.GetStats().maps, 5u);
+	CHECK_EQUAL(f.context.GetStats().instances, uint64_t(17));
+
+	// 書き込みは range の中を順番に capacity 個まで、描画は常にバッファの先頭から
+	const uint32_t expectedCounts[] = { 4, 4, 2, 3, 4 };
+	std::vector<NullRenderCommandRecord> draws = f.Draws();
+	CHECK_EQUAL(draws.size(), size_t(5));
+	CHECK_EQUAL(f.context.uploads.size(), size_t(5));
+	uint32_t expectedNumber = 0;
+	for (size_t i = 0; i < draws.size() && i < f.context.uploads.size(); i++)
+	{
+		CHECK_EQUAL(draws[i].args[1], expectedCounts[i]);
+		CHECK_EQUAL(draws[i].args[2], 0u);
+		CHECK_EQUAL(f.context.uploads[i].size(), size_t(expectedCounts[i]));
+		for (const QuadInstance& instance : f.context.uploads[i])
+		{
+			CHECK_EQUAL(GetNumber(instance), expectedNumber);
+			expectedNumber++;
+		}
+	}
+	CHECK_EQUAL(expectedNumber, 17u);
+
+	// 範囲ごとの回数
+	CHECK_EQUAL(batch.DrawRange(&f.context, f.instanceBuffer, capacity, 0, 6), 3u);
+	CHECK_EQUAL(batch.DrawRange(&f.context, f.instanceBuffer, capacity, 1, 6), 1u);
+	CHECK_EQUAL(batch.DrawRange(&f.context, f.instanceBuffer, capacity, 3, 6), 0u);
+	CHECK_EQUAL(batch.GetDrawCount(17), size_t(3));
+	CHECK_EQUAL(batch.GetDrawCount(1), size_t(17));
+	CHECK_EQUAL(f.context.GetStats().errors, 0u);
+}
+
+int main() { return ImaseTest::RunTests(); }
@@ -0,0 +1,320 @@
+﻿//--------------------------------------------------------------------------------------
+// File: ShadowCascadesTest.cpp
+//
+// ShadowCascades（カスケードシャドウの CPU 側の計算）のテスト
+//
+// 分割位置が Practical Split Scheme の両端（lambda = 0 で均等分割、1 で対数分割）と
+// その間で期待した値になることと、正射影の中心のテクセル単位への合わせ込み（テクセルより
+// 小さいカメラの移動では行列が変わらず、ワールドの原点がテクセルの格子の上に写る）を
+// 確認します。影を落とすオブジェクトのカリングは、カスケードごとの範囲で１個ずつ判定した
+// 結果と全カスケードのビット・番号の一覧・数が一致することを確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ShadowCascades.h"
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	const float FOV_Y = 0.785398163f;
+	const float ASPECT = 16.0f / 9.0f;
+	const float NEAR_PLANE = 0.1f;
+	const float FAR_PLANE = 200.0f;
+
+	Vector3 GetLightDirection() { return Vector3(0.3f, -1.0f, 0.2f).Normalized(); }
+
+	Matrix MakeView(const Vector3& eye)
+	{
+		return Matrix::CreateLookAt(eye, eye + Vector3(0.6f, -0.3f, -1.0f), Vector3::Up());
+	}
+
+	// ライト空間の x 軸（ライトのビュー行列の１列目）
+	Vector3 GetLightAxisX(const ShadowCascades& cascades)
+	{
+		const Matrix& m = cascades.lightView;
+		return Vector3(m.m[0][0], m.m[1][0], m.m[2][0]);
+	}
+
+	// 正射影の x, y の範囲を決める要素（奥行きは含めない）
+	bool IsSameShadowRect(const Matrix& a, const Matrix& b)
+	{
+		return a.m[0][0] == b.m[0][0] && a.m[1][1] == b.m[1][1] && a.m[3][0] == b.m[3][0] && a.m[3][1] == b.m[3][1];
+	}
+
+	// １個ずつの判定（CullShadowCasters と同じ範囲をカスケードごとに調べる）
+	uint32_t ReferenceMask(const ShadowCascades& cascades, const Vector3& center, float radius)
+	{
+		Vector3 l = cascades.lightView.TransformPoint(center);
+		uint32_t mask = 0;
+		for (int c = 0; c < cascades.count; c++)
+		{
+			const ShadowCascade& cascade = cascades.cascades[c];
+			if (l.x + radius >= cascade.center.x - cascade.radius && l.x - radius <= cascade.center.x + cascade.radius &&
+				l.y + radius >= cascade.center.y - cascade.radius && l.y - radius <= cascade.center.y + cascade.radius &&
+				l.z + radius >= -cascade.depthFar && l.z - radius <= -cascade.depthNear)
+			{
+				mask |= 1u << c;
+			}
+		}
+		return mask;
+	}
+}
+
+// lambda = 0 は均等分割、1 は対数分割、その間は両者の線形補間で、最後はファーちょうど
+TEST_CASE(SplitSchemeEndpoints)
+{
+	const int count = 4;
+	const float n = 0.5f, f = 128.0f;
+	float uniform[count], logarithmic[count], practical[count];
+	ComputeCascadeSplits(n, f, count, 0.0f, uniform);
+	ComputeCascadeSplits(n, f, count, 1.0f, logarithmic);
+	ComputeCascadeSplits(n, f, count, 0.25f, practical);
+
+	for (int i = 0; i < count; i++)
+	{
+		float t = static_cast<float>(i + 1) / count;
+		float expectedUniform = n + (f - n) * t;
+		float expectedLog = n * std::pow(f / n, t);
+		CHECK_NEAR(uniform[i], expectedUniform, 1.0e-4f);
+		CHECK_NEAR(logarithmic[i], expectedLog, 1.0e-3f);
+		CHECK_NEAR(practical[i], 0.25f * expectedLog + 0.75f * expectedUniform, 1.0e-3f);
+		if (i > 0) CHECK(practical[i] > practical[i - 1]);
+	}
+
+	// 対数分割の比は一定（0.5 → 2 → 8 → 32 → 128）
+	CHECK_NEAR(logarithmic[0], 2.0f, 1.0e-4f);
+	CHECK_NEAR(logarithmic[1], 8.0f, 1.0e-3f);
+	CHECK_NEAR(logarithmic[2], 32.0f, 1.0e-3f);
+	CHECK_EQUAL(uniform[count - 1], f);
+	CHECK_EQUAL(logarithmic[count - 1], f);
+	CHECK_EQUAL(practical[count - 1], f);
+
+	// カスケードの範囲は分割位置で隙間なく繋がり、影の最大距離で打ち切られる
+	ShadowCascadeSettings settings;
+	settings.maxShadowDistance = 80.0f;
+	ShadowCascades cascades = ComputeShadowCascades(MakeView(Vector3(0.0f, 5.0f, 0.0f)),
+		FOV_Y, ASPECT, NEAR_PLANE, FAR_PLANE, GetLightDirection(), settings);
+	float splits[MAX_SHADOW_CASCADES];
+	ComputeCascadeSplits(NEAR_PLANE, 80.0f, MAX_SHADOW_CASCADES, settings.splitLambda, splits);
+	CHECK_EQUAL(cascades.count, MAX_SHADOW_CASCADES);
+	CHECK_EQUAL(cascades.cascades[0].splitNear, NEAR_PLANE);
+	for (int i = 0; i < cascades.count; i++)
+	{
+		CHECK_EQUAL(cascades.cascades[i].splitFar, splits[i]);
+		if (i > 0) CHECK_EQUAL(cascades.cascades[i].splitNear, cascades.cascades[i - 1].splitFar);
+	}
+
+	// カスケードの数は 1 ～ MAX_SHADOW_CASCADES に切り詰める
+	settings.cascadeCount = 0;
+	CHECK_EQUAL(ComputeShadowCascades(MakeView(Vector3()), FOV_Y, ASPECT, NEAR_PLANE, FAR_PLANE, GetLightDirection(), settings).count, 1);
+	settings.cascadeCount = MAX_SHADOW_CASCADES + 3;
+	CHECK_EQUAL(ComputeShadowCascades(MakeView(Vector3()), FOV_Y, ASPECT, NEAR_PLANE, FAR_PLANE, GetLightDirection(), settings).count, MAX_SHADOW_CASCADES);
+}
+
+// テクセルより小さいカメラの移動では正射影は変わらず、ずれる時はちょうど１テクセル
+TEST_CASE(SubTexelMovesKeepLightMatrix)
+{
+	ShadowCascadeSettings settings;
+	const Vector3 start(3.0f, 5.0f, -2.0f);
+	ShadowCascades first = ComputeShadowCascades(MakeView(start), FOV_Y, ASPECT, NEAR_PLANE, FAR_PLANE, GetLightDirection(), settings);
+	const Vector3 axisX = GetLightAxisX(first);
+
+	for (int c = 0; c < first.count; c++)
+	{
+		// 1/8 テクセルずつ 2 テクセル分、ライト空間の x 方向へ動かす
+		const float texelSize = first.cascades[c].texelSize;
+		ShadowCascades previous = first;
+		int changes = 0, wrongShifts = 0;
+		for (int step = 1; step <= 16; step++)
+		{
+			Vector3 eye = start + axisX * (texelSize * 0.125f * static_cast<float>(step));
+			ShadowCascades current = ComputeShadowCascades(MakeView(eye), FOV_Y, ASPECT, NEAR_PLANE, FAR_PLANE, GetLightDirection(), settings);
+			const ShadowCascade& a = previous.cascades[c];
+			const ShadowCascade& b = current.cascades[c];
+
+			// 半径はカメラの位置によらないのでテクセルの大きさも変わらない
+			CHECK_EQUAL(b.texelSize, texelSize);
+			CHECK_EQUAL(b.center.y, a.center.y);
+			if (!IsSameShadowRect(a.projection, b.projection))
+			{
+				changes++;
+				if (std::fabs(b.center.x - a.center.x - texelSize) > texelSize * 1.0e-3f) wrongShifts++;
+			}
+			previous = current;
+		}
+
+		// 2 テクセル動かすと、テクセルの境界をちょうど２回越える
+		CHECK_EQUAL(changes, 2);
+		CHECK_EQUAL(wrongShifts, 0);
+	}
+}
+
+// カメラを回転・移動しても、ワールドの原点はシャドウマップのテクセルの格子の上に写る
+TEST_CASE(OriginLandsOnTexelGrid)
+{
+	ShadowCascadeSettings settings;
+	settings.shadowMapSize = 1024;
+	float radius[MAX_SHADOW_CASCADES] = {};
+
+	std::mt19937 random(9);
+	std::uniform_real_distribution<float> position(-40.0f, 40.0f);
+	std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+	for (int i = 0; i < 50; i++)
+	{
+		Vector3 eye(position(random), 2.0f + std::fabs(position(random)) * 0.1f, position(random));
+		float yaw = angle(random);
+		Matrix view = Matrix::CreateLookAt(eye, eye + Vector3(std::sin(yaw), -0.2f, std::cos(yaw)), Vector3::Up());
+		ShadowCascades cascades = ComputeShadowCascades(view, FOV_Y, ASPECT, NEAR_PLANE, FAR_PLANE, GetLightDirection(), settings);
+
+		for (int c = 0; c < cascades.count; c++)
+		{
+			const ShadowCascade& cascade = cascades.cascades[c];
+
+			// 原点のシャドウマップ上のテクセルの位置（NDC → テクセル）
+			Vector3 ndc = cascade.viewProjection.TransformPoint(Vector3());
+			float u = (ndc.x * 0.5f + 0.5f) * settings.shadowMapSize;
+			float v = (ndc.y * 0.5f + 0.5f) * settings.shadowMapSize;
+			CHECK_NEAR(u, std::round(u), 2.0e-2f);
+			CHECK_NEAR(v, std::round(v), 2.0e-2f);
+
+			// 半径（正射影の大きさ）はカメラの向きと位置によらない
+			if (i == 0) radius[c] = cascade.radius;
+			CHECK_EQUAL(cascade.radius, radius[c]);
+			CHECK_NEAR(cascade.texelSize, 2.0f * cascade.radius / settings.shadowMapSize, 1.0e-6f);
+		}
+	}
+}
+
+// カスケードごとのビット・番号の一覧・数はカスケードごとに１個ずつ判定した結果と一致する
+TEST_CASE(CasterMasksMatchPerCascadeTest)
+{
+	ShadowCascadeSettings settings;
+	ShadowCascades cascades = ComputeShadowCascades(MakeView(Vector3(0.0f, 5.0f, 0.0f)),
+		FOV_Y, ASPECT, NEAR_PLANE, FAR_PLANE, GetLightDirection(), settings);
+
+	// 乱数の球（４の倍数でない数にしてスカラーの残りも通す）
+	const size_t count = 1003;
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> position(-120.0f, 120.0f);
+	std::uniform_real_distribution<float> size(0.1f, 4.0f);
+	std::vector<float> x(count), y(count), z(count), r(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		x[i] = position(random); y[i] = position(random) * 0.2f; z[i] = position(random); r[i] = size(random);
+	}
+	SphereArrays spheres = { x.data(), y.data(), z.data(), r.data() };
+
+	std::vector<uint8_t> masks(count);
+	std::vector<uint32_t> indexStorage[MAX_SHADOW_CASCADES];
+	uint32_t* indices[MAX_SHADOW_CASCADES];
+	for (int c = 0; c < MAX_SHADOW_CASCADES; c++)
+	{
+		indexStorage[c].resize(count);
+		indices[c] = indexStorage[c].data();
+	}
+	size_t counts[MAX_SHADOW_CASCADES] = {};
+	size_t casterCount = CullShadowCasters(cascades, spheres, count, masks.data(), indices, counts);
+
+	uint32_t wrongMasks = 0, wrongIndices = 0;
+	size_t expectedCasters = 0;
+	size_t expectedCounts[MAX_SHADOW_CASCADES] = {};
+	for (size_t i = 0; i < count; i++)
+	{
+		uint32_t expected = ReferenceMask(cascades, Vector3(x[i], y[i], z[i]), r[i]);
+		if (masks[i] != expected) wrongMasks++;
+		if (expected) expectedCasters++;
+		for (int c = 0; c < cascades.count; c++)
+		{
+			if (!(expected & (1u << c))) continue;
+
+			// 番号の一覧は小さい順に並ぶ
+			size_t k = expectedCounts[c]++;
+			if (k >= counts[c] || indices[c][k] != i) wrongIndices++;
+		}
+	}
+	CHECK_EQUAL(wrongMasks, 0u);
+	CHECK_EQUAL(wrongIndices, 0u);
+	CHECK_EQUAL(casterCount, expectedCasters);
+	for (int c = 0; c < cascades.count; c++)
+	{
+		CHECK_EQUAL(counts[c], expectedCounts[c]);
+		CHECK(counts[c] > 0);
+	}
+	CHECK(casterCount < count);
+
+	// マスクだけ・数だけを求めても結果は同じ
+	std::vector<uint8_t> masksOnly(count);
+	CHECK_EQUAL(CullShadowCasters(cascades, spheres, count, masksOnly.data(), nullptr, nullptr), casterCount);
+	CHECK(masksOnly == masks);
+	CHECK_EQUAL(CullShadowCasters(cascades, spheres, count, nullptr, nullptr, nullptr), casterCount);
+}
+
+// ライト側へ延ばした範囲の物体は影を落とし、それより遠い物体と受ける側より奥の物体は落とさない
+TEST_CASE(CasterExtensionTowardLight)
+{
+	ShadowCascadeSettings settings;
+	settings.cascadeCount = 1;
+	ShadowCascades cascades = ComputeShadowCascades(MakeView(Vector3(0.0f, 5.0f, 0.0f)),
+		FOV_Y, ASPECT, NEAR_PLANE, FAR_PLANE, GetLightDirection(), settings);
+	const ShadowCascade& cascade = cascades.cascades[0];
+
+	// カスケードの中心（ワールド空間）
+	Vector3 center = cascades.lightView.InvertOrthonormal().TransformPoint(cascade.center);
+	Vector3 toLight = -cascades.lightDirection;
+	const float reach = cascade.radius + settings.casterExtension;
+
+	const Vector3 points[] =
+	{
+		center,
+		center + toLight * (reach - 1.0f),
+		center + toLight * (reach + 1.0f),
+		center - toLight * (cascade.radius - 1.0f),
+		center - toLight * (cascade.radius + 1.0f),
+		center + toLight * (reach + 0.25f),							// 範囲の境界をまたぐ球は含める
+		center - toLight * (cascade.radius + 0.25f),
+		center + GetLightAxisX(cascades) * (cascade.radius + 1.0f),	// 横に外れている
+	};
+	const uint8_t expected[] = { 1, 1, 0, 1, 0, 1, 1, 0 };
+
+	const size_t count = sizeof(points) / sizeof(points[0]);		// 8 個（SIMD の経路で判定する）
+	float x[count], y[count], z[count], r[count];
+	for (size_t i = 0; i < count; i++)
+	{
+		x[i] = points[i].x; y[i] = points[i].y; z[i] = points[i].z; r[i] = 0.5f;
+	}
+	SphereArrays spheres = { x, y, z, r };
+	uint8_t masks[count] = {};
+	CHECK_EQUAL(CullShadowCasters(cascades, spheres, count, masks, nullptr, nullptr), size_t(5));
+	for (size_t i = 0; i < count; i++) CHECK_EQUAL(masks[i], expected[i]);
+}
+
+// 使わないカスケードの定数は最後のカスケードと同じにする
+TEST_CASE(ConstantsRepeatLastCascade)
+{
+	ShadowCascadeSettings settings;
+	settings.cascadeCount = 2;
+	ShadowCascades cascades = ComputeShadowCascades(MakeView(Vector3()), FOV_Y, ASPECT, NEAR_PLANE, FAR_PLANE, GetLightDirection(), settings);
+
+	ShadowConstants constants = {};
+	WriteShadowConstants(cascades, &constants);
+	CHECK_EQUAL(constants.cascadeCount, 2u);
+	CHECK_EQUAL(constants.splitDistances[0], cascades.cascades[0].splitFar);
+	CHECK_EQUAL(constants.splitDistances[1], cascades.cascades[1].splitFar);
+	CHECK_EQUAL(constants.splitDistances[3], cascades.cascades[1].splitFar);
+	CHECK_EQUAL(constants.texelSizes[2], cascades.cascades[1].texelSize);
+
+	// 転置して書き込む
+	CHECK_EQUAL(constants.lightViewProjection[0].m[0][3], cascades.cascades[0].viewProjection.m[3][0]);
+	CHECK_EQUAL(constants.lightViewProjection[3].m[1][3], cascades.cascades[1].viewProjection.m[3][1]);
+}
+
+int main() { return ImaseTest::RunTests(); }
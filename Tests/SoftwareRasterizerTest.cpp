@@ -0,0 +1,238 @@
+﻿//--------------------------------------------------------------------------------------
+// File: SoftwareRasterizerTest.cpp
+//
+// SoftwareRasterizer（ソフトウェアラスタライザー）のゴールデンイメージのテスト
+//
+// Game と同じシーン（グリッドの床・中央の木・TreeScene の森）を固定のカメラとライトで
+// 256×144 の画像へ描画し、Tests/Data/SoftwareRasterizerGolden.tga と比較します。
+// 各チャンネルの差が GOLDEN_TOLERANCE を超えたピクセルが１つでもあれば失敗し、
+// 描画結果を SoftwareRasterizerActual.tga（実行したディレクトリ）へ保存します。
+// タイルを塗るスレッドの数を変えても同じ画像になることも確認します。
+// 描画を意図して変えた場合は --update-golden を付けて実行し、画像を作り直してください。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "SoftwareRasterizer.h"
+#include "TreeScene.h"
+
+using namespace Imase;
+
+namespace
+{
+	// ゴールデンイメージ（CMake が IMASE_TEST_DATA_DIR にソースの Tests/Data を指定する）
+	const std::string GOLDEN_FILE = std::string(IMASE_TEST_DATA_DIR) + "/SoftwareRasterizerGolden.tga";
+
+	// 失敗した時の描画結果
+	const char* const ACTUAL_FILE = "SoftwareRasterizerActual.tga";
+
+	// 画像の大きさ
+	constexpr uint32_t IMAGE_WIDTH = 256;
+	constexpr uint32_t IMAGE_HEIGHT = 144;
+
+	// 許容する各チャンネルの差（コンパイラーによる浮動小数点の計算の違いの分）
+	constexpr int GOLDEN_TOLERANCE = 4;
+
+	// 床の大きさ（-FLOOR_SIZE ～ FLOOR_SIZE）とグリッドの数
+	constexpr float FLOOR_SIZE = 10.0f;
+	constexpr float FLOOR_CELLS = 20.0f;
+
+	// R8G8B8A8 のピクセル（乗算済みアルファ）
+	uint32_t MakePixel(float r, float g, float b, float a)
+	{
+		auto unorm = [](float v) { return static_cast<uint32_t>(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f); };
+		return unorm(r * a) | (unorm(g * a) << 8) | (unorm(b * a) << 16) | (unorm(a) << 24);
+	}
+
+	// グリッドのテクスチャ（１枚で１マス、左と上の辺に線）
+	void CreateGridTexture(SoftwareTexture* texture)
+	{
+		const uint32_t size = 16;
+		std::vector<uint32_t> pixels(size * size);
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				bool isLine = x == 0 || y == 0;
+				pixels[y * size + x] = isLine ? MakePixel(0.9f, 0.9f, 0.9f, 1.0f) : MakePixel(0.35f, 0.4f, 0.35f, 1.0f);
+			}
+		}
+		texture->Create(size, size, pixels.data());
+	}
+
+	// 木のテクスチャ（三角形の葉と幹、周りは透明）
+	void CreateTreeTexture(SoftwareTexture* texture)
+	{
+		const uint32_t size = 32;
+		std::vector<uint32_t> pixels(size * size);
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				float dx = std::fabs(static_cast<float>(x) + 0.5f - size * 0.5f);
+				uint32_t pixel = 0;
+				if (y < 24 && dx < (static_cast<float>(y) + 1.0f) * 0.6f) pixel = MakePixel(0.15f, 0.6f, 0.2f, 1.0f);
+				else if (y >= 24 && dx < 3.0f) pixel = MakePixel(0.45f, 0.3f, 0.15f, 1.0f);
+				pixels[y * size + x] = pixel;
+			}
+		}
+		texture->Create(size, size, pixels.data());
+	}
+
+	// 木の位置とスケール
+	struct Tree
+	{
+		Math::Vector3 position;
+		float scale;
+	};
+
+	// シーンを描画する
+	void RenderScene(SoftwareRasterizer* rasterizer, unsigned int threadCount)
+	{
+		SoftwareTexture gridTexture;
+		SoftwareTexture treeTexture;
+		CreateGridTexture(&gridTexture);
+		CreateTreeTexture(&treeTexture);
+
+		// 固定のカメラとライト
+		Math::Vector3 eye(0.0f, 3.5f, 12.0f);
+		Math::Matrix view = Math::Matrix::CreateLookAt(eye, Math::Vector3(0.0f, 1.0f, 0.0f), Math::Vector3(0.0f, 1.0f, 0.0f));
+		Math::Matrix projection = Math::Matrix::CreatePerspective(
+			0.785398163f, static_cast<float>(IMAGE_WIDTH) / IMAGE_HEIGHT, 0.1f, 100.0f);
+		Math::Matrix viewProjection = view * projection;
+		Math::Vector3 lightDirection = Math::Vector3(0.3f, -0.8f, -0.5f).Normalized();
+
+		rasterizer->Resize(IMAGE_WIDTH, IMAGE_HEIGHT);
+		const float clearColor[4] = { 0.39f, 0.58f, 0.93f, 1.0f };
+		rasterizer->Clear(clearColor, 1.0f);
+
+		// グリッドの床（不透明、裏からも見えるようにカリングしない）
+		const SoftwareVertex floorVertices[4] =
+		{
+			{ { -FLOOR_SIZE, 0.0f, -FLOOR_SIZE }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } },
+			{ {  FLOOR_SIZE, 0.0f, -FLOOR_SIZE }, { 1.0f, 1.0f, 1.0f, 1.0f }, { FLOOR_CELLS, 0.0f }, { 0.0f, 1.0f, 0.0f } },
+			{ {  FLOOR_SIZE, 0.0f,  FLOOR_SIZE }, { 1.0f, 1.0f, 1.0f, 1.0f }, { FLOOR_CELLS, FLOOR_CELLS }, { 0.0f, 1.0f, 0.0f } },
+			{ { -FLOOR_SIZE, 0.0f,  FLOOR_SIZE }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, FLOOR_CELLS }, { 0.0f, 1.0f, 0.0f } },
+		};
+		const uint16_t floorIndices[6] = { 0, 1, 2, 0, 2, 3 };
+
+		SoftwareRasterizerState floorState;
+		floorState.cullMode = SoftwareCullMode::None;
+		floorState.blendMode = SoftwareBlendMode::Opaque;
+		rasterizer->SetState(floorState);
+		rasterizer->SetTexture(&gridTexture);
+		rasterizer->SetConstants({ viewProjection, lightDirection });
+		rasterizer->DrawIndexed(floorVertices, 4, floorIndices, 6);
+
+		// 中央の木と TreeScene の森の木（半透明なので奥から順に描画する）
+		TreeScene scene;
+		scene.Initialize();
+		std::vector<Tree> trees = { { Math::Vector3(0.0f, 0.0f, 0.0f), 2.0f } };
+		scene.GetWorld().ForEach<TreeTransform>([&](const EntityChunkView& chunk, const TreeTransform* transforms)
+		{
+			for (size_t i = 0; i < chunk.count; i++) trees.push_back({ transforms[i].position, transforms[i].scale });
+		});
+		std::stable_sort(trees.begin(), trees.end(), [&](const Tree& a, const Tree& b)
+		{
+			return (a.position - eye).LengthSquared() > (b.position - eye).LengthSquared();
+		});
+
+		SoftwareVertex quadVertices[4];
+		static_assert(sizeof(SoftwareVertex) == sizeof(TreeScene::Vertex), "vertex layouts must match");
+		std::memcpy(quadVertices, TreeScene::QUAD_VERTICES, sizeof(quadVertices));
+
+		rasterizer->SetState(SoftwareRasterizerState());
+		rasterizer->SetTexture(&treeTexture);
+		for (const Tree& tree : trees)
+		{
+			Math::Matrix world = Math::Matrix::CreateScale(tree.scale) * Math::Matrix::CreateTranslation(tree.position);
+			rasterizer->SetConstants({ world * viewProjection, lightDirection });
+			rasterizer->DrawIndexed(quadVertices, 4, TreeScene::QUAD_INDICES, 6);
+		}
+
+		rasterizer->Flush(threadCount);
+	}
+}
+
+// 描画結果がゴールデンイメージと許容値の範囲で一致する
+TEST_CASE(MatchesGoldenImage)
+{
+	SoftwareRasterizer rasterizer;
+	RenderScene(&rasterizer, 1);
+
+	// 床と木が描画されている
+	const SoftwareRasterizerStats& stats = rasterizer.GetStats();
+	CHECK(stats.triangles > 2);
+	CHECK(stats.shadedPixels > IMAGE_WIDTH * IMAGE_HEIGHT / 4);
+
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector<uint32_t> golden;
+	bool isLoaded = SoftwareRasterizer::ReadImage(GOLDEN_FILE.c_str(), &width, &height, &golden);
+	CHECK(isLoaded);
+	CHECK_EQUAL(width, IMAGE_WIDTH);
+	CHECK_EQUAL(height, IMAGE_HEIGHT);
+	if (!isLoaded || width != IMAGE_WIDTH || height != IMAGE_HEIGHT) return;
+
+	int maxDifference = 0;
+	size_t differentPixels = SoftwareRasterizer::CompareImages(
+		rasterizer.GetColorBuffer(), golden.data(), golden.size(), GOLDEN_TOLERANCE, &maxDifference);
+	if (differentPixels > 0)
+	{
+		rasterizer.WriteImage(ACTUAL_FILE);
+		std::printf("  %zu pixels differ from the golden image (max difference %d), wrote %s\n",
+			differentPixels, maxDifference, ACTUAL_FILE);
+	}
+	CHECK_EQUAL(differentPixels, size_t(0));
+}
+
+// 比較は１ピクセルの違いも見つける
+TEST_CASE(CompareDetectsSinglePixel)
+{
+	SoftwareRasterizer rasterizer;
+	RenderScene(&rasterizer, 1);
+
+	std::vector<uint32_t> changed(rasterizer.GetColorBuffer(), rasterizer.GetColorBuffer() + IMAGE_WIDTH * IMAGE_HEIGHT);
+	changed[IMAGE_WIDTH * 70 + 128] ^= 0x20;
+
+	int maxDifference = 0;
+	CHECK_EQUAL(SoftwareRasterizer::CompareImages(rasterizer.GetColorBuffer(), changed.data(), changed.size(),
+		GOLDEN_TOLERANCE, &maxDifference), size_t(1));
+	CHECK_EQUAL(maxDifference, 0x20);
+}
+
+// タイルを塗るスレッドの数を変えても同じ画像になる
+TEST_CASE(ThreadCountDoesNotChangeImage)
+{
+	SoftwareRasterizer single;
+	SoftwareRasterizer parallel;
+	RenderScene(&single, 1);
+	RenderScene(&parallel, 4);
+
+	CHECK(std::memcmp(single.GetColorBuffer(), parallel.GetColorBuffer(), sizeof(uint32_t) * IMAGE_WIDTH * IMAGE_HEIGHT) == 0);
+	CHECK_EQUAL(single.GetStats().shadedPixels, parallel.GetStats().shadedPixels);
+}
+
+int main(int argc, char* argv[])
+{
+	// --update-golden：ゴールデンイメージを作り直す
+	if (argc > 1 && std::strcmp(argv[1], "--update-golden") == 0)
+	{
+		SoftwareRasterizer rasterizer;
+		RenderScene(&rasterizer, 1);
+		bool isWritten = rasterizer.WriteImage(GOLDEN_FILE.c_str());
+		std::printf("%s %s\n", isWritten ? "Wrote" : "Failed to write", GOLDEN_FILE.c_str());
+		return isWritten ? 0 : 1;
+	}
+
+	return ImaseTest::RunTests();
+}
@@ -0,0 +1,281 @@
+﻿//--------------------------------------------------------------------------------------
+// File: StateFilteredContextTest.cpp
+//
+// StateFilteredContext（同じステートの設定を省略するラッパー）のテスト
+//
+// NullRenderContext を包んで呼び出し、省略された設定がコンテキストまで届かないことと、
+// スロットのある設定は変わった範囲だけが届くことを記録したコマンドで確認します。
+// 省略・発行の回数は NullRenderContext が受け取ったステートの設定の回数と一致する必要があります。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include "NullRenderContext.h"
+#include "StateFilteredContext.h"
+
+using namespace Imase;
+
+namespace
+{
+	// テストで使うコンテキストとリソース
+	struct Fixture
+	{
+		NullRenderContext null;
+		StateFilteredContext<IRenderContext> context;
+
+		RenderBuffer* buffers[4];
+		RenderInputLayout* inputLayouts[2];
+		RenderVertexShader* vertexShaders[2];
+		RenderPixelShader* pixelShaders[2];
+		RenderShaderResource* views[2];
+		RenderSampler* samplers[2];
+		RenderRasterizerState* rasterizerStates[2];
+		RenderDepthStencilState* depthStencilStates[2];
+		RenderBlendState* blendStates[2];
+
+		Fixture()
+		{
+			for (RenderBuffer*& buffer : buffers) buffer = null.CreateBuffer(4096, true);
+			for (int i = 0; i < 2; i++)
+			{
+				inputLayouts[i] = null.CreateInputLayout(2);
+				vertexShaders[i] = null.CreateVertexShader();
+				pixelShaders[i] = null.CreatePixelShader();
+				views[i] = null.CreateShaderResource();
+				samplers[i] = null.CreateSampler();
+				rasterizerStates[i] = null.CreateRasterizerState();
+				depthStencilStates[i] = null.CreateDepthStencilState();
+				blendStates[i] = null.CreateBlendState();
+			}
+			null.SetRecording(true);
+			context.Reset(&null);
+			Clear();
+		}
+
+		// 記録したコマンドと回数を消す
+		void Clear()
+		{
+			null.ClearRecordedCommands();
+			null.ResetStats();
+			context.ResetStats();
+		}
+
+		// 発行した回数がコンテキストの受け取った回数と一致するか
+		bool StatsMatch() const
+		{
+			return context.GetStats().issued == null.GetStats().stateChanges
+				&& null.GetStats().errors == 0;
+		}
+
+		const std::vector<NullRenderCommandRecord>& Records() const { return null.GetRecordedCommands(); }
+	};
+}
+
+// 同じ値の設定は２回目以降が省略される（スロットのないステート）
+TEST_CASE(RedundantSingleStatesAreFiltered)
+{
+	Fixture f;
+
+	for (int i = 0; i < 3; i++)
+	{
+		f.context.IASetInputLayout(f.inputLayouts[0]);
+		f.context.IASetPrimitiveTopology(RenderTopology::TriangleList);
+		f.context.IASetIndexBuffer(f.buffers[0], RenderIndexFormat::UInt16, 0);
+		f.context.VSSetShader(f.vertexShaders[0], static_cast<RenderClassInstance* const*>(nullptr), 0);
+		f.context.PSSetShader(f.pixelShaders[0], static_cast<RenderClassInstance* const*>(nullptr), 0);
+		f.context.RSSetState(f.rasterizerStates[0]);
+		f.context.OMSetDepthStencilState(f.depthStencilStates[0], 1);
+		f.context.OMSetBlendState(f.blendStates[0], nullptr, 0xffffffff);
+	}
+
+	CHECK_EQUAL(f.context.GetStats().issued, 8u);
+	CHECK_EQUAL(f.context.GetStats().filtered, 16u);
+	CHECK_EQUAL(f.Records().size(), size_t(8));
+	CHECK(f.StatsMatch());
+}
+
+// 値が変われば設定される（変わった引数が１つだけでも省略しない）
+TEST_CASE(ChangedStatesAreIssued)
+{
+	Fixture f;
+	f.context.IASetIndexBuffer(f.buffers[0], RenderIndexFormat::UInt16, 0);
+	f.context.OMSetDepthStencilState(f.depthStencilStates[0], 1);
+	f.context.OMSetBlendState(f.blendStates[0], nullptr, 0xffffffff);
+	f.context.VSSetShader(f.vertexShaders[0], static_cast<RenderClassInstance* const*>(nullptr), 0);
+	f.Clear();
+
+	f.context.IASetIndexBuffer(f.buffers[0], RenderIndexFormat::UInt32, 0);
+	f.context.IASetIndexBuffer(f.buffers[0], RenderIndexFormat::UInt32, 8);
+	f.context.IASetIndexBuffer(f.buffers[1], RenderIndexFormat::UInt32, 8);
+	f.context.OMSetDepthStencilState(f.depthStencilStates[0], 2);
+	f.context.OMSetDepthStencilState(f.depthStencilStates[1], 2);
+	f.context.VSSetShader(f.vertexShaders[1], static_cast<RenderClassInstance* const*>(nullptr), 0);
+
+	const float factorA[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	const float factorB[4] = { 0.5f, 1.0f, 1.0f, 1.0f };
+
+	// nullptr のブレンドファクターは (1, 1, 1, 1) と同じ扱い
+	f.context.OMSetBlendState(f.blendStates[0], factorA, 0xffffffff);
+	f.context.OMSetBlendState(f.blendStates[0], factorB, 0xffffffff);
+	f.context.OMSetBlendState(f.blendStates[0], factorB, 0x0000000f);
+
+	CHECK_EQUAL(f.context.GetStats().issued, 8u);
+	CHECK_EQUAL(f.context.GetStats().filtered, 1u);
+	CHECK(f.StatsMatch());
+}
+
+// スロットのある設定は、変わったスロットの範囲だけが設定される
+TEST_CASE(SlotSubsetsAreNarrowed)
+{
+	Fixture f;
+	RenderBuffer* const cbs[4] = { f.buffers[0], f.buffers[1], f.buffers[2], f.buffers[3] };
+	f.context.PSSetConstantBuffers(0, 4, cbs);
+	f.Clear();
+
+	// 全て同じなら省略
+	f.context.PSSetConstantBuffers(0, 4, cbs);
+	CHECK_EQUAL(f.context.GetStats().filtered, 1u);
+	CHECK(f.Records().empty());
+
+	// スロット１と２だけ変わる → スロット１から２つ
+	RenderBuffer* const changed[4] = { f.buffers[0], f.buffers[3], f.buffers[0], f.buffers[3] };
+	f.context.PSSetConstantBuffers(0, 4, changed);
+	CHECK_EQUAL(f.Records().size(), size_t(1));
+	CHECK(f.Records()[0].type == NullRenderCommand::PSSetConstantBuffers);
+	CHECK_EQUAL(f.Records()[0].args[0], 1u);
+	CHECK_EQUAL(f.Records()[0].args[1], 2u);
+	CHECK_EQUAL(f.Records()[0].args[2], NullRenderContext::GetResourceId(f.buffers[3]));
+
+	// シェーダーリソースとサンプラーも同じ
+	RenderShaderResource* const views[2] = { f.views[0], f.views[1] };
+	RenderSampler* const samplers[2] = { f.samplers[0], f.samplers[1] };
+	f.context.PSSetShaderResources(0, 2, views);
+	f.context.PSSetShaderResources(1, 1, views + 1);
+	f.context.PSSetSamplers(0, 2, samplers);
+	f.context.PSSetSamplers(0, 1, samplers);
+	CHECK_EQUAL(f.context.GetStats().issued, 3u);
+	CHECK_EQUAL(f.context.GetStats().filtered, 3u);
+	CHECK(f.StatsMatch());
+}
+
+// 頂点バッファはバッファ・ストライド・オフセットのどれが変わっても設定される
+TEST_CASE(VertexBuffersCompareStrideAndOffset)
+{
+	Fixture f;
+	RenderBuffer* const vbs[2] = { f.buffers[0], f.buffers[1] };
+	const uint32_t strides[2] = { 12, 16 };
+	const uint32_t offsets[2] = { 0, 0 };
+	f.context.IASetVertexBuffers(0, 2, vbs, strides, offsets);
+	f.Clear();
+
+	f.context.IASetVertexBuffers(0, 2, vbs, strides, offsets);
+	CHECK(f.Records().empty());
+
+	const uint32_t newOffsets[2] = { 0, 64 };
+	f.context.IASetVertexBuffers(0, 2, vbs, strides, newOffsets);
+	CHECK_EQUAL(f.Records().size(), size_t(1));
+	CHECK_EQUAL(f.Records()[0].args[0], 1u);
+	CHECK_EQUAL(f.Records()[0].args[1], 1u);
+
+	const uint32_t newStrides[2] = { 24, 16 };
+	f.context.IASetVertexBuffers(0, 2, vbs, newStrides, newOffsets);
+	CHECK_EQUAL(f.Records().size(), size_t(2));
+	CHECK_EQUAL(f.Records()[1].args[0], 0u);
+	CHECK_EQUAL(f.Records()[1].args[1], 1u);
+	CHECK(f.StatsMatch());
+}
+
+// VSSetConstantBuffers1 はバッファが同じでも範囲が変われば設定される
+TEST_CASE(ConstantBufferRangesAreCompared)
+{
+	Fixture f;
+	RenderBuffer* const cb[1] = { f.buffers[0] };
+	const uint32_t first0[1] = { 0 };
+	const uint32_t first16[1] = { 16 };
+	const uint32_t count[1] = { 16 };
+
+	f.context.VSSetConstantBuffers1(0, 1, cb, first0, count);
+	f.context.VSSetConstantBuffers1(0, 1, cb, first0, count);
+	f.context.VSSetConstantBuffers1(0, 1, cb, first16, count);
+	CHECK_EQUAL(f.context.GetStats().issued, 2u);
+	CHECK_EQUAL(f.context.GetStats().filtered, 1u);
+	CHECK_EQUAL(f.Records().back().args[2], 16u);
+
+	// 範囲を指定したスロットは、範囲なしで同じバッファを設定しても省略しない
+	f.context.VSSetConstantBuffers(0, 1, cb);
+	CHECK_EQUAL(f.context.GetStats().issued, 3u);
+	CHECK(f.Records().back().type == NullRenderCommand::VSSetConstantBuffers);
+
+	// 範囲なしの設定は覚えるので次は省略される
+	f.context.VSSetConstantBuffers(0, 1, cb);
+	CHECK_EQUAL(f.context.GetStats().filtered, 2u);
+	CHECK(f.StatsMatch());
+}
+
+// Invalidate の後は同じ値でも必ず設定される
+TEST_CASE(InvalidateForcesReissue)
+{
+	Fixture f;
+	RenderSampler* const samplers[1] = { f.samplers[0] };
+	f.context.RSSetState(f.rasterizerStates[0]);
+	f.context.PSSetSamplers(0, 1, samplers);
+	f.context.OMSetBlendState(f.blendStates[0], nullptr, 0xffffffff);
+	f.Clear();
+
+	f.context.Invalidate();
+	f.context.RSSetState(f.rasterizerStates[0]);
+	f.context.PSSetSamplers(0, 1, samplers);
+	f.context.OMSetBlendState(f.blendStates[0], nullptr, 0xffffffff);
+	CHECK_EQUAL(f.context.GetStats().issued, 3u);
+	CHECK_EQUAL(f.context.GetStats().filtered, 0u);
+	CHECK_EQUAL(f.Records().size(), size_t(3));
+	CHECK(f.StatsMatch());
+}
+
+// 覚えるスロットの数を超える設定は毎回そのまま設定され、重なるスロットは忘れる
+TEST_CASE(SlotsBeyondTheCapPassThrough)
+{
+	using Filtered = StateFilteredContext<IRenderContext>;
+	static_assert(Filtered::MAX_VERTEX_BUFFERS < NullRenderContext::MAX_VERTEX_BUFFERS, "");
+
+	Fixture f;
+	RenderBuffer* const vbs[2] = { f.buffers[0], f.buffers[1] };
+	const uint32_t strides[2] = { 16, 16 };
+	const uint32_t offsets[2] = { 0, 0 };
+	const uint32_t last = Filtered::MAX_VERTEX_BUFFERS - 1;
+
+	f.context.IASetVertexBuffers(last, 2, vbs, strides, offsets);
+	f.context.IASetVertexBuffers(last, 2, vbs, strides, offsets);
+	CHECK_EQUAL(f.context.GetStats().issued, 2u);
+	CHECK_EQUAL(f.context.GetStats().filtered, 0u);
+
+	// 範囲を超えた設定で last スロットを忘れたので、last だけの設定も省略されない
+	f.context.IASetVertexBuffers(last, 1, vbs, strides, offsets);
+	CHECK_EQUAL(f.context.GetStats().issued, 3u);
+	f.context.IASetVertexBuffers(last, 1, vbs, strides, offsets);
+	CHECK_EQUAL(f.context.GetStats().filtered, 1u);
+
+	RenderShaderResource* const views[2] = { f.views[0], f.views[1] };
+	f.context.PSSetShaderResources(Filtered::MAX_SHADER_RESOURCES, 2, views);
+	f.context.PSSetShaderResources(Filtered::MAX_SHADER_RESOURCES, 2, views);
+	CHECK_EQUAL(f.context.GetStats().issued, 5u);
+	CHECK(f.StatsMatch());
+}
+
+// クラスインスタンスを使うシェーダーの設定は覚えない
+TEST_CASE(ClassInstancesAreNotRemembered)
+{
+	Fixture f;
+	RenderClassInstance* const instances[1] = { nullptr };
+	f.context.PSSetShader(f.pixelShaders[0], instances, 1);
+	f.context.PSSetShader(f.pixelShaders[0], instances, 1);
+	f.context.PSSetShader(f.pixelShaders[0], static_cast<RenderClassInstance* const*>(nullptr), 0);
+	f.context.PSSetShader(f.pixelShaders[0], static_cast<RenderClassInstance* const*>(nullptr), 0);
+	CHECK_EQUAL(f.context.GetStats().issued, 3u);
+	CHECK_EQUAL(f.context.GetStats().filtered, 1u);
+	CHECK(f.StatsMatch());
+}
+
+int main() { return ImaseTest::RunTests(); }
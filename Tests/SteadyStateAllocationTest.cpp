@@ -0,0 +1,352 @@
+﻿//--------------------------------------------------------------------------------------
+// File: SteadyStateAllocationTest.cpp
+//
+// 使う量が安定したフレームでヒープからの確保が行われないことのテスト
+//
+// グローバルな operator new・delete を置き換えて確保した回数を数えます（このテストの
+// 実行ファイルの中だけで置き換わるので、他のテストとは別の実行ファイルにしています）。
+// FrameArena・FrameVector と、DebugFont の文字列の書式と登録（DebugTextList）を数フレーム
+// 実行してチャンクと配列の容量を確保した後、同じ量を使うフレームでは確保が 0 回になることを
+// 確認します。SceneBenchmark::Run は直接描画・並列の記録・パイプライン・リングバッファなしの
+// それぞれの設定で１回実行して容量を確保した後、同じ設定でもう１回実行し、どのフレームでも確保が
+// 0 回になることをフレームの最後に呼ばれる関数で数えて確認します（最初のフレームの前には
+// パイプラインのスレッドの起動が入るので、２フレーム目から数えます）。終了したスレッドの FrameArena の状態は
+// 次のスレッドが使うので、スレッドを作り直しても状態とチャンクが増えないことも確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cwchar>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "DebugTextList.h"
+#include "FrameArena.h"
+#include "SceneBenchmark.h"
+
+// ----- 確保した回数を数える operator new・delete ----- //
+
+namespace
+{
+	std::atomic<uint64_t> s_allocationCount{ 0 };
+
+	void* CountedAllocate(size_t size)
+	{
+		s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		if (void* p = std::malloc(size ? size : 1)) return p;
+		throw std::bad_alloc();
+	}
+
+	void* CountedAllocateAligned(size_t size, std::align_val_t alignment)
+	{
+		s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		size_t align = static_cast<size_t>(alignment);
+		size_t alignedSize = (std::max<size_t>(size, 1) + align - 1) / align * align;
+#ifdef _WIN32
+		if (void* p = _aligned_malloc(alignedSize, align)) return p;
+#else
+		if (void* p = std::aligned_alloc(align, alignedSize)) return p;
+#endif
+		throw std::bad_alloc();
+	}
+
+	void FreeAligned(void* p)
+	{
+#ifdef _WIN32
+		_aligned_free(p);
+#else
+		std::free(p);
+#endif
+	}
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { try { return CountedAllocate(size); } catch (...) { return nullptr; } }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { try { return CountedAllocate(size); } catch (...) { return nullptr; } }
+void* operator new(size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { FreeAligned(p); }
+
+using namespace Imase;
+
+namespace
+{
+	// 容量を確保するフレームの数と、確保が 0 回になることを確認するフレームの数
+	constexpr int WARMUP_FRAMES = 4;
+	constexpr int STEADY_FRAMES = 200;
+
+	// DebugFont の代わりの位置と色
+	struct Position { float x, y; };
+	struct Color { float r, g, b, a; };
+
+	// 関数を実行する間に確保した回数を数える
+	template <class Function>
+	uint64_t CountAllocations(const Function& function)
+	{
+		uint64_t start = s_allocationCount.load();
+		function();
+		return s_allocationCount.load() - start;
+	}
+
+	// Game の画面の文字列と同じように、毎フレーム書式を指定した文字列を登録して描画する
+	size_t RenderDebugText(FrameArena* arena, DebugTextList<Position, Color>* texts, int frame)
+	{
+		arena->BeginFrame();
+
+		texts->Add(texts->Format(L"Update %u Hz  alpha %.2f  dropped %llu", 60u, (frame % 100) * 0.01, 0ull),
+			{ 10.0f, 10.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, 1.0f);
+		texts->Add(texts->Format(L"Pick  triangle %u  distance %.3f", static_cast<unsigned int>(frame * 7), frame * 0.25f),
+			{ 10.0f, 30.0f }, { 1.0f, 1.0f, 0.0f, 1.0f }, 1.0f);
+		texts->Add(texts->Format(L"Camera path  %ls", frame % 2 ? L"recording" : L"stopped"),
+			{ 10.0f, 50.0f }, { 0.0f, 1.0f, 0.0f, 1.0f }, 1.0f);
+		texts->Add(texts->Copy(L"Debug"), { 10.0f, 70.0f }, { 1.0f, 0.0f, 0.0f, 1.0f }, 2.0f);
+
+		// スタックの領域に入りきらない長い文字列（アリーナで書き直す）
+		texts->Add(texts->Format(L"%1500d", frame), { 10.0f, 90.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, 1.0f);
+
+		// 描画の代わりに文字数を数える
+		size_t length = 0;
+		for (size_t i = 0; i < texts->size(); i++) length += std::wcslen((*texts)[i].string);
+		texts->Clear();
+
+		return length;
+	}
+}
+
+// 確保を数えていることの確認（0 回の結果が数え忘れではない）
+TEST_CASE(CountsHeapAllocations)
+{
+	uint64_t count = CountAllocations([]()
+		{
+			int* value = new int(1);
+			delete value;
+			std::vector<float> values(16);
+		});
+	CHECK_EQUAL(count, uint64_t(2));
+}
+
+// 容量を確保した後は、DebugFont の文字列の書式と登録でヒープから確保しない
+TEST_CASE(DebugTextHasNoSteadyStateAllocations)
+{
+	FrameArena arena(4 * 1024);		// 小さなチャンクで、チャンクを追加するフレームも作る
+	DebugTextList<Position, Color> texts(&arena);
+
+	for (int frame = 0; frame < WARMUP_FRAMES; frame++) RenderDebugText(&arena, &texts, frame);
+	uint64_t chunkAllocations = arena.GetStats().chunkAllocations;
+	CHECK(chunkAllocations > 0);
+
+	size_t length = 0;
+	uint64_t count = CountAllocations([&]()
+		{
+			for (int frame = WARMUP_FRAMES; frame < WARMUP_FRAMES + STEADY_FRAMES; frame++)
+			{
+				length += RenderDebugText(&arena, &texts, frame);
+			}
+		});
+
+	CHECK_EQUAL(count, uint64_t(0));
+	CHECK_EQUAL(arena.GetStats().chunkAllocations, chunkAllocations);
+	CHECK(length > STEADY_FRAMES * 1500);
+}
+
+// 書式を指定した文字列はスタックに入りきらない場合も正しく書き込まれる
+TEST_CASE(DebugTextFormatsLongStrings)
+{
+	FrameArena arena;
+	DebugTextList<Position, Color> texts(&arena);
+	arena.BeginFrame();
+
+	const wchar_t* shortText = texts.Format(L"%d/%ls", 42, L"abc");
+	CHECK(std::wcscmp(shortText, L"42/abc") == 0);
+
+	const wchar_t* longText = texts.Format(L"%3000d", 7);
+	CHECK_EQUAL(std::wcslen(longText), size_t(3000));
+	CHECK_EQUAL(longText[2999], L'7');
+	CHECK_EQUAL(longText[0], L' ');
+
+	texts.Add(shortText, { 1.0f, 2.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, 0.5f);
+	CHECK_EQUAL(texts.size(), size_t(1));
+	CHECK_EQUAL(texts[0].pos.y, 2.0f);
+	CHECK_EQUAL(texts[0].scale, 0.5f);
+	texts.Clear();
+	CHECK_EQUAL(texts.size(), size_t(0));
+}
+
+// 容量を確保した後は、FrameVector を毎フレーム作り直してもヒープから確保しない
+TEST_CASE(FrameVectorHasNoSteadyStateAllocations)
+{
+	FrameArena& arena = FrameArena::GetDefault();
+	auto runFrame = [&](int frame)
+	{
+		arena.BeginFrame();
+		FrameVector<float> values;
+		for (int i = 0; i < 5000; i++) values.push_back(static_cast<float>(i + frame));
+		FrameVector<uint32_t> indices(values.size());
+		for (size_t i = 0; i < indices.size(); i++) indices[i] = static_cast<uint32_t>(i);
+		return values.back() + static_cast<float>(indices.back());
+	};
+
+	for (int frame = 0; frame < WARMUP_FRAMES; frame++) runFrame(frame);
+
+	float sum = 0.0f;
+	uint64_t count = CountAllocations([&]()
+		{
+			for (int frame = 0; frame < STEADY_FRAMES; frame++) sum += runFrame(frame);
+		});
+
+	CHECK_EQUAL(count, uint64_t(0));
+	CHECK(sum > 0.0f);
+}
+
+// SceneBenchmark の容量を確保した後は、同じフレームを実行してもヒープから確保しない
+TEST_CASE(SceneBenchmarkHasNoSteadyStateAllocations)
+{
+	constexpr uint32_t FRAME_COUNT = 120;
+
+	// 各フレームの最後の確保の回数（配列は先に確保しておく）
+	struct FrameAllocations
+	{
+		uint64_t counts[FRAME_COUNT];
+	};
+	auto allocations = std::make_unique<FrameAllocations>();
+
+	auto benchmark = std::make_unique<SceneBenchmark>();
+
+	struct Variant
+	{
+		const char* name;
+		uint32_t recordingChunks;
+		uint32_t pipelineDepth;
+		bool constantRing;
+	};
+	const Variant variants[] =
+	{
+		{ "direct", 0, 0, true },
+		{ "parallel", 4, 0, true },
+		{ "pipelined", 0, 2, true },
+		{ "no ring", 0, 0, false },
+	};
+
+	for (const Variant& variant : variants)
+	{
+		SceneBenchmarkSettings settings;
+		settings.frameCount = FRAME_COUNT;
+		settings.occluderWalls = 8;
+		settings.recordingChunks = variant.recordingChunks;
+		settings.pipelineDepth = variant.pipelineDepth;
+		settings.constantRing = variant.constantRing;
+
+		// １回目は容量を確保する（パケットの数はカメラの向きで変わるので、最大になるまで増える）
+		CHECK_EQUAL(benchmark->Run(settings).frameCount, FRAME_COUNT);
+
+		settings.frameEndFunction = [](void* data, uint32_t frame)
+			{
+				static_cast<FrameAllocations*>(data)->counts[frame] = s_allocationCount.load();
+			};
+		settings.frameEndData = allocations.get();
+
+		const SceneBenchmarkReport& report = benchmark->Run(settings);
+		CHECK_EQUAL(report.frameCount, FRAME_COUNT);
+		CHECK_EQUAL(report.renderStats.errors, 0u);
+
+		// ２回目は全てのフレームで確保しない
+		uint64_t steadyAllocations = 0;
+		uint32_t allocatingFrames = 0;
+		for (uint32_t frame = 1; frame < FRAME_COUNT; frame++)
+		{
+			uint64_t count = allocations->counts[frame] - allocations->counts[frame - 1];
+			steadyAllocations += count;
+			if (count > 0) allocatingFrames++;
+		}
+		if (steadyAllocations > 0)
+		{
+			std::printf("  %s: %llu allocations in %u frames\n", variant.name,
+				static_cast<unsigned long long>(steadyAllocations), allocatingFrames);
+		}
+		CHECK_EQUAL(steadyAllocations, uint64_t(0));
+	}
+}
+
+// 終了したスレッドの状態は次に確保を始めたスレッドが使うので、スレッドを作り直しても増えない
+TEST_CASE(ExitedThreadStatesAreReused)
+{
+	FrameArena arena(4 * 1024);
+	arena.BeginFrame();
+	arena.Allocate(100);
+
+	auto allocateOnThread = [&]()
+	{
+		std::thread thread([&]()
+			{
+				for (int i = 0; i < 8; i++) arena.Allocate(1000);
+			});
+		thread.join();
+	};
+
+	// ２つのバッファのチャンクを確保する
+	allocateOnThread();
+	arena.BeginFrame();
+	allocateOnThread();
+	FrameArenaStats first = arena.GetStats();
+	CHECK_EQUAL(first.threadCount, 2u);
+
+	// １つずつ作り直すスレッドは同じ状態とチャンクを使う
+	for (int frame = 0; frame < 20; frame++)
+	{
+		arena.BeginFrame();
+		allocateOnThread();
+	}
+	FrameArenaStats reused = arena.GetStats();
+	CHECK_EQUAL(reused.threadCount, 2u);
+	CHECK_EQUAL(reused.chunkAllocations, first.chunkAllocations);
+	CHECK_EQUAL(reused.usedBytes, size_t(8000));
+
+	// 同時に動いているスレッドはそれぞれの状態を使う（両方が確保し終わるまで終了しない）
+	std::atomic<int> allocated{ 0 };
+	auto allocateTogether = [&]()
+	{
+		arena.Allocate(1000);
+		allocated++;
+		while (allocated.load() != 2) std::this_thread::yield();
+	};
+	std::thread a(allocateTogether);
+	std::thread b(allocateTogether);
+	a.join();
+	b.join();
+	CHECK_EQUAL(arena.GetStats().threadCount, 3u);
+
+	// アリーナを先に削除しても、後で終了するスレッドは削除済みのアリーナに触らない
+	auto shortLived = std::make_unique<FrameArena>();
+	std::atomic<int> step{ 0 };
+	std::thread late([&]()
+		{
+			shortLived->Allocate(64);
+			step = 1;
+			while (step.load() != 2) std::this_thread::yield();
+		});
+	while (step.load() != 1) std::this_thread::yield();
+	shortLived.reset();
+	step = 2;
+	late.join();
+	CHECK(shortLived == nullptr);
+}
+
+int main() { return ImaseTest::RunTests(); }
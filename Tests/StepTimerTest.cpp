@@ -0,0 +1,186 @@
+﻿//--------------------------------------------------------------------------------------
+// File: StepTimerTest.cpp
+//
+// DX::StepTimer（固定・可変タイムステップのタイマー）のテスト
+//
+// SetClock で時刻を自分で進める偽の時計（1 単位 = 1 マイクロ秒）に差し替えて、
+// Tick ごとの Update の回数・補間の割合・1/4 ミリ秒以内のずれの丸め・大きな時間の切り詰め・
+// １回の Tick の Update の上限・可変タイムステップ・フレームレートの集計を決まった値で確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <cstdint>
+
+#include "StepTimer.h"
+
+namespace
+{
+	// 1 単位 = 1 マイクロ秒の偽の時計
+	constexpr uint64_t CLOCK_FREQUENCY = 1000000;
+
+	struct FakeClock
+	{
+		uint64_t now = 0;
+
+		static uint64_t Read(void* context) { return static_cast<FakeClock*>(context)->now; }
+	};
+
+	// 偽の時計と 10 ミリ秒の固定タイムステップを設定したタイマー
+	struct Fixture
+	{
+		FakeClock clock;
+		DX::StepTimer timer;
+
+		explicit Fixture(bool isFixedTimeStep = true)
+		{
+			timer.SetClock(&FakeClock::Read, &clock, CLOCK_FREQUENCY);
+			timer.SetFixedTimeStep(isFixedTimeStep);
+			timer.SetTargetElapsedSeconds(0.01);
+		}
+
+		// 時計をマイクロ秒だけ進めて Tick を呼び、Update が呼ばれた回数を返す
+		uint32_t Tick(uint64_t microseconds)
+		{
+			clock.now += microseconds;
+			uint32_t updates = 0;
+			timer.Tick([&]() { updates++; });
+			return updates;
+		}
+	};
+}
+
+// 固定タイムステップでは経過時間に含まれるステップの数だけ Update を呼び、端数は補間の割合になる
+TEST_CASE(FixedStepRunsWholeSteps)
+{
+	Fixture f;
+
+	CHECK_EQUAL(f.Tick(25000), 2u);
+	CHECK_EQUAL(f.timer.GetElapsedTicks(), uint64_t(100000));
+	CHECK_EQUAL(f.timer.GetTotalTicks(), uint64_t(200000));
+	CHECK_EQUAL(f.timer.GetFrameElapsedTicks(), uint64_t(250000));
+	CHECK_EQUAL(f.timer.GetFrameCount(), 2u);
+	CHECK_NEAR(f.timer.GetInterpolationAlpha(), 0.5, 1.0e-9);
+
+	// 端数は次の Tick に持ち越される
+	CHECK_EQUAL(f.Tick(5000), 1u);
+	CHECK_NEAR(f.timer.GetInterpolationAlpha(), 0.0, 1.0e-9);
+
+	// ステップに満たない Tick では Update を呼ばない
+	CHECK_EQUAL(f.Tick(4000), 0u);
+	CHECK_EQUAL(f.timer.GetFrameElapsedTicks(), uint64_t(40000));
+	CHECK_NEAR(f.timer.GetInterpolationAlpha(), 0.4, 1.0e-9);
+}
+
+// ステップとのずれが 1/4 ミリ秒より小さい場合はステップちょうどに丸めて端数を溜めない
+TEST_CASE(SmallDeviationsSnapToTarget)
+{
+	Fixture f;
+
+	for (int i = 0; i < 100; i++) CHECK_EQUAL(f.Tick(10200), 1u);
+	CHECK_NEAR(f.timer.GetInterpolationAlpha(), 0.0, 1.0e-9);
+	CHECK_EQUAL(f.timer.GetTotalTicks(), uint64_t(100 * 100000));
+
+	// 1/4 ミリ秒以上のずれは丸めない
+	CHECK_EQUAL(f.Tick(10300), 1u);
+	CHECK_NEAR(f.timer.GetInterpolationAlpha(), 0.03, 1.0e-9);
+}
+
+// １回の Tick の経過時間は 1/10 秒で切り詰める（デバッガーで止めた後など）
+TEST_CASE(LargeDeltaIsClamped)
+{
+	Fixture f;
+
+	CHECK_EQUAL(f.Tick(2000000), 10u);
+	CHECK_NEAR(f.timer.GetFrameElapsedSeconds(), 0.1, 1.0e-9);
+	CHECK_NEAR(f.timer.GetTotalSeconds(), 0.1, 1.0e-9);
+	CHECK_EQUAL(f.timer.GetDroppedUpdateCount(), uint64_t(0));
+}
+
+// Update の上限を超えたステップは捨てて、端数だけ残す
+TEST_CASE(MaxUpdatesPerTickDropsWholeSteps)
+{
+	Fixture f;
+	f.timer.SetMaxUpdatesPerTick(2);
+
+	CHECK_EQUAL(f.Tick(55000), 2u);
+	CHECK_EQUAL(f.timer.GetDroppedUpdateCount(), uint64_t(3));
+	CHECK_EQUAL(f.timer.GetTotalTicks(), uint64_t(200000));
+	CHECK_NEAR(f.timer.GetInterpolationAlpha(), 0.5, 1.0e-9);
+
+	// 上限に届かない Tick では捨てない
+	CHECK_EQUAL(f.Tick(15000), 2u);
+	CHECK_EQUAL(f.timer.GetDroppedUpdateCount(), uint64_t(3));
+
+	// 0 は上限なし
+	f.timer.SetMaxUpdatesPerTick(0);
+	CHECK_EQUAL(f.Tick(50000), 5u);
+	CHECK_EQUAL(f.timer.GetDroppedUpdateCount(), uint64_t(3));
+}
+
+// 可変タイムステップでは Tick ごとに経過時間で１回 Update を呼び、補間の割合は常に 1
+TEST_CASE(VariableStepUpdatesOncePerTick)
+{
+	Fixture f(false);
+
+	CHECK_EQUAL(f.Tick(7000), 1u);
+	CHECK_EQUAL(f.timer.GetElapsedTicks(), uint64_t(70000));
+	CHECK_EQUAL(f.Tick(13000), 1u);
+	CHECK_EQUAL(f.timer.GetElapsedTicks(), uint64_t(130000));
+	CHECK_EQUAL(f.timer.GetTotalTicks(), uint64_t(200000));
+	CHECK_NEAR(f.timer.GetInterpolationAlpha(), 1.0, 1.0e-9);
+}
+
+// フレームレートは Update を呼んだ Tick の数を１秒ごとに集計する
+TEST_CASE(FramesPerSecondCountsTicksWithUpdates)
+{
+	Fixture f;
+
+	// 5 ミリ秒ごとの Tick では２回に１回だけ Update を呼ぶ
+	for (int i = 0; i < 199; i++) f.Tick(5000);
+	CHECK_EQUAL(f.timer.GetFramesPerSecond(), 0u);
+	f.Tick(5000);
+	CHECK_EQUAL(f.timer.GetFramesPerSecond(), 100u);
+	CHECK_EQUAL(f.timer.GetFrameCount(), 100u);
+
+	// １回の Tick で何回 Update を呼んでも１フレームと数える
+	for (int i = 0; i < 50; i++) f.Tick(20000);
+	CHECK_EQUAL(f.timer.GetFramesPerSecond(), 50u);
+	CHECK_EQUAL(f.timer.GetFrameCount(), 200u);
+}
+
+// ResetElapsedTime の前に経過した時間と端数は Update に使わない
+TEST_CASE(ResetElapsedTimeDiscardsPendingTime)
+{
+	Fixture f;
+
+	CHECK_EQUAL(f.Tick(15000), 1u);
+	f.clock.now += 80000;
+	f.timer.ResetElapsedTime();
+
+	CHECK_NEAR(f.timer.GetInterpolationAlpha(), 0.0, 1.0e-9);
+	CHECK_EQUAL(f.Tick(0), 0u);
+	CHECK_EQUAL(f.Tick(10000), 1u);
+	CHECK_EQUAL(f.timer.GetTotalTicks(), uint64_t(200000));
+}
+
+// 時計の関数がない場合と周波数が 0 の場合は例外を投げる
+TEST_CASE(SetClockRejectsInvalidClock)
+{
+	DX::StepTimer timer;
+	FakeClock clock;
+
+	bool thrown = false;
+	try { timer.SetClock(nullptr, &clock, CLOCK_FREQUENCY); }
+	catch (const std::exception&) { thrown = true; }
+	CHECK(thrown);
+
+	thrown = false;
+	try { timer.SetClock(&FakeClock::Read, &clock, 0); }
+	catch (const std::exception&) { thrown = true; }
+	CHECK(thrown);
+}
+
+int main() { return ImaseTest::RunTests(); }
@@ -0,0 +1,94 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TestCommon.h
+//
+// テストの登録と確認を行う小さなフレームワーク（ヘッダーのみ）
+//
+// Usage: TEST_CASE で定義したテストを RunTests でまとめて実行します。
+//        CHECK・CHECK_EQUAL・CHECK_NEAR は失敗しても続けて、失敗した場所を表示します。
+//        失敗したテストがあった場合は RunTests は 1 を返します（CTest で失敗になります）。
+//
+//	<<< 記述例 >>
+//	TEST_CASE(Addition)
+//	{
+//		CHECK_EQUAL(1 + 1, 2);
+//		CHECK_NEAR(0.1f + 0.2f, 0.3f, 1.0e-6f);
+//	}
+//
+//	int main() { return ImaseTest::RunTests(); }
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace ImaseTest
+{
+	// テスト
+	struct TestCase
+	{
+		const char* name;
+		void (*function)();
+	};
+
+	// 登録されたテストの配列
+	inline std::vector<TestCase>& GetTestCases()
+	{
+		static std::vector<TestCase> s_testCases;
+		return s_testCases;
+	}
+
+	// 実行中のテストで失敗した確認の数
+	inline int& GetFailureCount()
+	{
+		static int s_failureCount = 0;
+		return s_failureCount;
+	}
+
+	// テストを登録するクラス（TEST_CASE で使用）
+	struct Registrar
+	{
+		Registrar(const char* name, void (*function)()) { GetTestCases().push_back({ name, function }); }
+	};
+
+	// 確認に失敗した場所を表示する関数
+	inline void Fail(const char* file, int line, const char* expression)
+	{
+		std::printf("  %s(%d): CHECK(%s) failed\n", file, line, expression);
+		GetFailureCount()++;
+	}
+
+	// 登録されたテストを全て実行する関数（失敗したテストがあった場合は 1 を返す）
+	inline int RunTests()
+	{
+		int failedTests = 0;
+		for (const TestCase& test : GetTestCases())
+		{
+			GetFailureCount() = 0;
+			test.function();
+			bool isPassed = GetFailureCount() == 0;
+			std::printf("[%s] %s\n", isPassed ? "  OK  " : "FAILED", test.name);
+			if (!isPassed) failedTests++;
+		}
+		std::printf("%d / %d tests passed\n", static_cast<int>(GetTestCases().size()) - failedTests, static_cast<int>(GetTestCases().size()));
+		return failedTests > 0 ? 1 : 0;
+	}
+}
+
+#define TEST_CASE(name) \
+	static void name(); \
+	static ImaseTest::Registrar s_registrar_##name(#name, name); \
+	static void name()
+
+#define CHECK(expression) \
+	do { if (!(expression)) ImaseTest::Fail(__FILE__, __LINE__, #expression); } while (false)
+
+#define CHECK_EQUAL(a, b) \
+	do { if (!((a) == (b))) ImaseTest::Fail(__FILE__, __LINE__, #a " == " #b); } while (false)
+
+#define CHECK_NEAR(a, b, tolerance) \
+	do { if (!(std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= static_cast<double>(tolerance))) \
+		ImaseTest::Fail(__FILE__, __LINE__, #a " ~= " #b); } while (false)
@@ -0,0 +1,141 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TransformKernelTest.cpp
+//
+// TransformKernel（WVP 行列の一括計算）のテスト
+//
+// SIMD 版の結果がスカラー版（基準の実装）と一致すること、スカラー版が MathCore の
+// 行列の掛け算と一致すること、出力先の間隔と端数・スレッドの分割を確認します。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <cstring>
+#include <random>
+
+#include "TransformKernel.h"
+
+using namespace Imase;
+using namespace Imase::Math;
+
+namespace
+{
+	// SoA 形式の姿勢の配列
+	struct TransformData
+	{
+		std::vector<float> px, py, pz, qx, qy, qz, qw, sx, sy, sz;
+
+		explicit TransformData(size_t count)
+		{
+			std::mt19937 random(42);
+			std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+			std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+			std::uniform_real_distribution<float> scale(0.2f, 5.0f);
+			for (size_t i = 0; i < count; i++)
+			{
+				px.push_back(position(random)); py.push_back(position(random)); pz.push_back(position(random));
+				Quaternion q(unit(random), unit(random), unit(random), unit(random));
+				q.Normalize();
+				qx.push_back(q.x); qy.push_back(q.y); qz.push_back(q.z); qw.push_back(q.w);
+				sx.push_back(scale(random)); sy.push_back(scale(random)); sz.push_back(scale(random));
+			}
+		}
+
+		TransformArrays GetArrays() const
+		{
+			return { px.data(), py.data(), pz.data(), qx.data(), qy.data(), qz.data(), qw.data(), sx.data(), sy.data(), sz.data() };
+		}
+	};
+
+	// 定数バッファを想定した出力先（行列の後ろに別のデータがある）
+	struct ObjectConstants
+	{
+		Matrix worldViewProjection;
+		float color[4];
+	};
+
+	const float PADDING = 12345.0f;
+
+	Matrix GetViewProjection()
+	{
+		return Matrix::CreateLookAt(Vector3(10.0f, 20.0f, 30.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f))
+			* Matrix::CreatePerspective(0.785398163f, 16.0f / 9.0f, 0.1f, 1000.0f);
+	}
+
+	// 要素の差が値の大きさに対して tolerance 以下か調べる関数
+	bool IsNear(const Matrix& a, const Matrix& b, float tolerance)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				float scale = std::max(1.0f, std::fabs(b.m[i][j]));
+				if (std::fabs(a.m[i][j] - b.m[i][j]) > tolerance * scale) return false;
+			}
+		}
+		return true;
+	}
+}
+
+// スカラー版は MathCore の (ワールド × ビュー射影) の転置と一致する
+TEST_CASE(ScalarMatchesMathCore)
+{
+	const size_t count = 64;
+	TransformData data(count);
+	Matrix vp = GetViewProjection();
+
+	std::vector<Matrix> result(count);
+	ComputeWorldViewProjectionsScalar(data.GetArrays(), 0, count, vp, result.data());
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Matrix world = Matrix::CreateWorld(
+			Vector3(data.px[i], data.py[i], data.pz[i]),
+			Quaternion(data.qx[i], data.qy[i], data.qz[i], data.qw[i]),
+			Vector3(data.sx[i], data.sy[i], data.sz[i]));
+		CHECK(IsNear(result[i], (world * vp).Transpose(), 1.0e-5f));
+	}
+}
+
+// SIMD 版は端数を含めてスカラー版と一致し、出力先の間隔の外側を書き換えない
+TEST_CASE(SimdMatchesScalarWithStride)
+{
+	Matrix vp = GetViewProjection();
+	for (size_t count = 0; count <= 19; count++)
+	{
+		TransformData data(count);
+
+		ObjectConstants fill = {};
+		std::fill(std::begin(fill.color), std::end(fill.color), PADDING);
+		std::vector<ObjectConstants> simd(count, fill), scalar(count, fill);
+
+		ComputeWorldViewProjections(data.GetArrays(), count, vp, simd.data(), sizeof(ObjectConstants), 1);
+		ComputeWorldViewProjectionsScalar(data.GetArrays(), 0, count, vp, scalar.data(), sizeof(ObjectConstants));
+
+		for (size_t i = 0; i < count; i++)
+		{
+			CHECK(IsNear(simd[i].worldViewProjection, scalar[i].worldViewProjection, 1.0e-5f));
+			for (float c : simd[i].color) CHECK_EQUAL(c, PADDING);
+		}
+	}
+}
+
+// スレッドに分割しても結果は１スレッドの場合と同じになる
+TEST_CASE(ThreadSplitMatchesSingleThread)
+{
+	const size_t count = 10003;
+	TransformData data(count);
+	Matrix vp = GetViewProjection();
+
+	std::vector<Matrix> single(count), split(count);
+	ComputeWorldViewProjections(data.GetArrays(), count, vp, single.data(), sizeof(Matrix), 1);
+	ComputeWorldViewProjections(data.GetArrays(), count, vp, split.data(), sizeof(Matrix), 4);
+
+	CHECK(std::memcmp(single.data(), split.data(), sizeof(Matrix) * count) == 0);
+}
+
+int main()
+{
+	return ImaseTest::RunTests();
+}
@@ -0,0 +1,435 @@
+﻿//--------------------------------------------------------------------------------------
+// File: TransientGeometryStreamTest.cpp
+//
+// TransientGeometryStream（デバッグの線をまとめて１つの頂点バッファへ追記するストリーム）のテスト
+//
+// ラインリスト・ラインストリップ・インデックス付きのラインリストを混ぜて追加しても１回の
+// DrawIndexed になり、計測結果（図形・頂点・インデックスの数、書き込んだバイト数、描画と
+// Map の回数）が合うことを NullRenderContext で確認します。描画した線はバッファから
+// 最初のインデックスと頂点の番号で読み戻し、追加した頂点と一致することを確かめます。
+// 確保は 256 バイト単位でも頂点の位置は頂点の大きさの倍数になること、末尾に入らない
+// まとまりは分けずに先頭へ戻ること、GPU が使用中のフレームの範囲へ書き込まないことも
+// 確認します。DebugDraw の図形はこのストリームの Add～ 関数を呼ぶだけなので、同じ形の
+// 頂点とインデックスで確かめます。
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "TestCommon.h"
+
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "NullRenderContext.h"
+#include "TransientGeometryStream.h"
+
+using namespace Imase;
+
+namespace
+{
+	constexpr uint32_t UNIT = ConstantRingAllocator::ALIGNMENT;
+	constexpr uint32_t STRIDE = TransientGeometryStream::VERTEX_STRIDE;
+
+	// 番号を x 座標に入れた頂点（読み戻した時にどの頂点か分かる）
+	TransientVertex MakeVertex(float id)
+	{
+		return { { id, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } };
+	}
+
+	// 番号が first から続く頂点の配列
+	std::vector<TransientVertex> MakeVertices(float first, uint32_t count)
+	{
+		std::vector<TransientVertex> vertices;
+		for (uint32_t i = 0; i < count; i++) vertices.push_back(MakeVertex(first + i));
+		return vertices;
+	}
+
+	// 描画に必要なステートを設定したコンテキストとストリーム
+	struct Fixture
+	{
+		NullRenderContext context;
+		RenderBuffer* vertexBuffer;
+		RenderBuffer* indexBuffer;
+		uint32_t vertexCapacity;
+		TransientGeometryStream stream;
+
+		Fixture(uint32_t vertexBytes, uint32_t indexBytes)
+			: vertexCapacity(vertexBytes)
+		{
+			vertexBuffer = context.CreateBuffer(vertexBytes, true);
+			indexBuffer = context.CreateBuffer(indexBytes, true);
+			stream.Initialize(vertexBuffer, vertexBytes, indexBuffer, indexBytes);
+
+			context.IASetInputLayout(context.CreateInputLayout(1));
+			context.VSSetShader(context.CreateVertexShader(), nullptr, 0);
+			context.PSSetShader(context.CreatePixelShader(), nullptr, 0);
+
+			context.SetRecording(true);
+			context.ResetStats();
+		}
+
+		// 記録した DrawIndexed のコマンド（引数はインデックスの数・最初のインデックス・頂点の番号）
+		std::vector<NullRenderCommandRecord> Draws() const
+		{
+			std::vector<NullRenderCommandRecord> draws;
+			for (const NullRenderCommandRecord& record : context.GetRecordedCommands())
+			{
+				if (record.type == NullRenderCommand::DrawIndexed) draws.push_back(record);
+			}
+			return draws;
+		}
+
+		// 描画した線の頂点の番号をインデックスの順に読み戻す（頂点バッファの外を指す場合は -1）
+		std::vector<float> ReadBack(const NullRenderCommandRecord& draw)
+		{
+			uint32_t indexCount = draw.args[0];
+			uint32_t startIndex = draw.args[1];
+			uint32_t baseVertex = draw.args[2];
+
+			const uint8_t* vertices = static_cast<const uint8_t*>(context.Map(vertexBuffer, RenderMap::WriteNoOverwrite));
+			const uint32_t* indices = static_cast<const uint32_t*>(context.Map(indexBuffer, RenderMap::WriteNoOverwrite));
+
+			std::vector<float> ids;
+			for (uint32_t i = 0; i < indexCount; i++)
+			{
+				uint64_t offset = (uint64_t(baseVertex) + indices[startIndex + i]) * STRIDE;
+				if (offset + STRIDE > vertexCapacity)
+				{
+					ids.push_back(-1.0f);
+					continue;
+				}
+				TransientVertex vertex;
+				std::memcpy(&vertex, vertices + offset, sizeof(vertex));
+				ids.push_back(vertex.position[0]);
+			}
+
+			context.Unmap(indexBuffer);
+			context.Unmap(vertexBuffer);
+
+			return ids;
+		}
+	};
+}
+
+// 種類の違う線を混ぜても１回の描画になり、計測結果が描画した内容と合う
+TEST_CASE(MixedShapesGoOutInOneDraw)
+{
+	Fixture fixture(64 * 1024, 16 * 1024);
+	TransientGeometryStream& stream = fixture.stream;
+	stream.BeginFrame();
+
+	// ラインリスト（奇数の頂点は最後を捨てる）
+	std::vector<TransientVertex> lines = MakeVertices(1.0f, 4);
+	stream.AddLines(lines.data(), 4);
+	std::vector<TransientVertex> odd = MakeVertices(5.0f, 3);
+	stream.AddLines(odd.data(), 3);
+
+	// ラインストリップはラインリストへ変換する（１頂点では線にならない）
+	std::vector<TransientVertex> strip = MakeVertices(10.0f, 5);
+	stream.AddLineStrip(strip.data(), 5);
+	stream.AddLineStrip(strip.data(), 1);
+
+	// インデックス付き（DebugDraw の箱や円と同じ形、範囲外のインデックスは先頭の頂点にする）
+	std::vector<TransientVertex> triangle = MakeVertices(20.0f, 3);
+	const uint16_t indices[] = { 0, 1, 1, 2, 2, 0, 0, 9 };
+	stream.AddIndexedLines(indices, 8, triangle.data(), 3);
+
+	stream.AddLine(MakeVertex(30.0f), MakeVertex(31.0f));
+
+	CHECK(!stream.IsEmpty());
+	CHECK(stream.Flush(&fixture.context));
+	CHECK(stream.IsEmpty());
+
+	std::vector<NullRenderCommandRecord> draws = fixture.Draws();
+	CHECK_EQUAL(draws.size(), size_t(1));
+	CHECK_EQUAL(draws[0].args[0], 24u);
+
+	const float expected[] =
+	{
+		1, 2, 3, 4, 5, 6,
+		10, 11, 11, 12, 12, 13, 13, 14,
+		20, 21, 21, 22, 22, 20, 20, 20,
+		30, 31,
+	};
+	CHECK((fixture.ReadBack(draws[0]) == std::vector<float>(expected, expected + 24)));
+
+	const TransientGeometryStats& stats = stream.GetFrameStats();
+	CHECK_EQUAL(stats.primitives, 5u);
+	CHECK_EQUAL(stats.vertices, 16u);
+	CHECK_EQUAL(stats.indices, 24u);
+	CHECK_EQUAL(stats.streamedBytes, uint64_t(16 * STRIDE + 24 * 4));
+	CHECK_EQUAL(stats.draws, 1u);
+	CHECK_EQUAL(stats.maps, 2u);
+	CHECK_EQUAL(stats.discards, 2u);		// 最初の書き込みだけ WriteDiscard
+	CHECK_EQUAL(stats.failures, 0u);
+
+	// 何もない場合は描画しない
+	CHECK(!stream.Flush(&fixture.context));
+	CHECK_EQUAL(fixture.Draws().size(), size_t(1));
+
+	// 同じフレームの２回目は続きへ追記する
+	stream.AddLine(MakeVertex(40.0f), MakeVertex(41.0f));
+	CHECK(stream.Flush(&fixture.context));
+	draws = fixture.Draws();
+	CHECK_EQUAL(draws.size(), size_t(2));
+	CHECK((fixture.ReadBack(draws[1]) == std::vector<float>{ 40.0f, 41.0f }));
+	CHECK(draws[1].args[2] * STRIDE >= 16 * STRIDE);
+	CHECK(draws[1].args[1] * 4 >= 24 * 4);
+	CHECK_EQUAL(stream.GetFrameStats().draws, 2u);
+	CHECK_EQUAL(stream.GetFrameStats().maps, 4u);
+	CHECK_EQUAL(stream.GetFrameStats().discards, 2u);
+
+	// バッファは先頭から設定する
+	uint32_t vertexBindings = 0, indexBindings = 0;
+	for (const NullRenderCommandRecord& record : fixture.context.GetRecordedCommands())
+	{
+		if (record.type == NullRenderCommand::IASetVertexBuffers)
+		{
+			CHECK_EQUAL(record.args[2], NullRenderContext::GetResourceId(fixture.vertexBuffer));
+			vertexBindings++;
+		}
+		if (record.type == NullRenderCommand::IASetIndexBuffer)
+		{
+			CHECK_EQUAL(record.args[1], static_cast<uint32_t>(RenderIndexFormat::UInt32));
+			CHECK_EQUAL(record.args[2], 0u);
+			indexBindings++;
+		}
+	}
+	CHECK_EQUAL(vertexBindings, 2u);
+	CHECK_EQUAL(indexBindings, 2u);
+
+	// 次のフレームでは前のフレームの計測結果になる
+	stream.BeginFrame();
+	CHECK_EQUAL(stream.GetStats().draws, 2u);
+	CHECK_EQUAL(stream.GetStats().primitives, 6u);
+	CHECK_EQUAL(stream.GetFrameStats().draws, 0u);
+
+	// 描画しなかった線は次のフレームで捨てる
+	stream.AddLine(MakeVertex(50.0f), MakeVertex(51.0f));
+	stream.BeginFrame();
+	CHECK(stream.IsEmpty());
+	CHECK_EQUAL(stream.GetStats().primitives, 1u);
+	CHECK_EQUAL(stream.GetStats().draws, 0u);
+	CHECK_EQUAL(fixture.Draws().size(), size_t(2));
+
+	CHECK_EQUAL(fixture.context.GetStats().errors, 0u);
+
+	// バッファを設定していないストリームは何もしない
+	TransientGeometryStream invalid;
+	invalid.BeginFrame();
+	invalid.AddLine(MakeVertex(1.0f), MakeVertex(2.0f));
+	CHECK(!invalid.IsValid());
+	CHECK(invalid.IsEmpty());
+	CHECK(!invalid.Flush(&fixture.context));
+}
+
+// 確保は 256 バイト単位でも、頂点の位置は頂点の大きさの倍数で確保した範囲の中にある
+TEST_CASE(VertexOffsetsAreStrideAligned)
+{
+	Fixture fixture(64 * 1024, 64 * 1024);
+	TransientGeometryStream& stream = fixture.stream;
+
+	std::mt19937 random(5);
+	float nextId = 1.0f;
+	uint32_t drawCount = 0, unalignedStarts = 0, mismatches = 0, overlaps = 0;
+	for (int frame = 0; frame < 40; frame++)
+	{
+		stream.BeginFrame();
+
+		// このフレームで描画した頂点の範囲（バイト）
+		std::vector<std::pair<uint32_t, uint32_t>> ranges;
+
+		uint32_t flushes = 1 + random() % 4;
+		for (uint32_t f = 0; f < flushes; f++)
+		{
+			uint32_t count = 2 * (1 + random() % 50);
+			std::vector<TransientVertex> vertices = MakeVertices(nextId, count);
+			stream.AddLines(vertices.data(), count);
+			CHECK(stream.Flush(&fixture.context));
+
+			NullRenderCommandRecord draw = fixture.Draws().back();
+			uint32_t begin = draw.args[2] * STRIDE;
+			uint32_t end = begin + count * STRIDE;
+
+			// 頂点の位置は確保した 256 バイト単位の位置から頂点１つ分未満だけ進めた所
+			if (begin % UNIT >= STRIDE) unalignedStarts++;
+
+			// インデックスの位置は 256 バイト単位
+			if (draw.args[1] * 4 % UNIT != 0) unalignedStarts++;
+
+			std::vector<float> ids = fixture.ReadBack(draw);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (ids.size() != count || ids[i] != nextId + i) mismatches++;
+			}
+
+			for (const auto& range : ranges)
+			{
+				if (begin < range.second && range.first < end) overlaps++;
+			}
+			ranges.push_back({ begin, end });
+
+			nextId += count;
+			drawCount++;
+		}
+	}
+
+	CHECK_EQUAL(fixture.Draws().size(), size_t(drawCount));
+	CHECK_EQUAL(unalignedStarts, 0u);
+	CHECK_EQUAL(mismatches, 0u);
+	CHECK_EQUAL(overlaps, 0u);
+	CHECK(stream.GetVertexAllocator().GetStats().wraps > 0);
+	CHECK_EQUAL(fixture.context.GetStats().errors, 0u);
+}
+
+// 末尾に入らないまとまりは分けずに先頭へ戻り、GPU が使用中のフレームが使い終わるまで待つ
+TEST_CASE(BatchThatDoesNotFitMovesToStart)
+{
+	// 頂点 20 個（560 バイト）は頂点の大きさへ揃える分を足して 768 バイトを確保する
+	Fixture fixture(8 * UNIT, 64 * 1024);
+	TransientGeometryStream& stream = fixture.stream;
+	const uint32_t count = 20;
+
+	auto addBatch = [&](float first)
+		{
+			std::vector<TransientVertex> vertices = MakeVertices(first, count);
+			stream.AddLines(vertices.data(), count);
+		};
+	auto expectedIds = [&](float first)
+		{
+			std::vector<float> ids;
+			for (uint32_t i = 0; i < count; i++) ids.push_back(first + i);
+			return ids;
+		};
+
+	// フレーム 1：[0, 768) の先頭から
+	stream.BeginFrame();
+	addBatch(100.0f);
+	CHECK(stream.Flush(&fixture.context));
+	CHECK_EQUAL(fixture.Draws().back().args[2], 0u);
+
+	// フレーム 2：[768, 1536)、頂点は 768 の次の 28 の倍数の 784 バイト目（28 番目の頂点）から
+	stream.BeginFrame();
+	addBatch(200.0f);
+	CHECK(stream.Flush(&fixture.context));
+	NullRenderCommandRecord frame2 = fixture.Draws().back();
+	CHECK_EQUAL(frame2.args[2], 28u);
+	CHECK((fixture.ReadBack(frame2) == expectedIds(200.0f)));
+
+	// フレーム 3：末尾は 512 バイトしかなく、先頭はフレーム 1 が使用中なので描画できない
+	stream.BeginFrame();
+	addBatch(300.0f);
+	CHECK(!stream.Flush(&fixture.context));
+	CHECK(stream.IsEmpty());
+	CHECK_EQUAL(stream.GetFrameStats().failures, 1u);
+	CHECK_EQUAL(stream.GetFrameStats().draws, 0u);
+	CHECK_EQUAL(fixture.Draws().size(), size_t(2));
+
+	// フレーム 4 はまだフレーム 1 が使用中
+	stream.BeginFrame();
+	CHECK_EQUAL(stream.GetVertexAllocator().GetUsedBytes(), 6 * UNIT);
+
+	// フレーム 5：フレーム 1 が使い終わったので、末尾を使わずに先頭の [0, 768) へまとめて書き込む
+	stream.BeginFrame();
+	CHECK_EQUAL(stream.GetVertexAllocator().GetUsedBytes(), 3 * UNIT);
+	addBatch(500.0f);
+	CHECK(stream.Flush(&fixture.context));
+	NullRenderCommandRecord frame5 = fixture.Draws().back();
+	CHECK_EQUAL(frame5.args[2], 0u);
+	CHECK(frame5.args[2] * STRIDE + count * STRIDE <= 3 * UNIT);
+	CHECK((fixture.ReadBack(frame5) == expectedIds(500.0f)));
+	CHECK_EQUAL(stream.GetVertexAllocator().GetStats().wraps, 1u);
+	CHECK_EQUAL(stream.GetVertexAllocator().GetUsedBytes(), 8 * UNIT);	// 使わなかった末尾も使用中
+
+	// GPU が使用中のフレーム 2 の頂点はそのまま残っている
+	CHECK((fixture.ReadBack(frame2) == expectedIds(200.0f)));
+
+	stream.BeginFrame();
+	CHECK_EQUAL(stream.GetStats().draws, 1u);
+	CHECK_EQUAL(stream.GetStats().failures, 0u);
+	CHECK_EQUAL(fixture.context.GetStats().errors, 0u);
+}
+
+// 多くのフレームを実行しても GPU が使用中のフレームの範囲へ書き込まず、計測結果と描画の回数が合う
+TEST_CASE(RetiredFramesAreReusedWithoutOverwriting)
+{
+	const uint32_t capacity = 16 * UNIT;
+	Fixture fixture(capacity, 64 * 1024);
+	TransientGeometryStream& stream = fixture.stream;
+
+	// 256 バイトの単位ごとに最後に書き込んだフレーム
+	std::vector<uint64_t> owner(capacity / UNIT, 0);
+
+	std::mt19937 random(9);
+	float nextId = 1.0f;
+	uint32_t overwrites = 0, mismatches = 0, drawn = 0, failed = 0;
+	uint32_t statsDraws = 0, statsFailures = 0;
+	uint64_t statsBytes = 0, streamedBytes = 0;
+	for (uint64_t frame = 1; frame <= 300; frame++)
+	{
+		stream.BeginFrame();
+		if (frame > 1)
+		{
+			statsDraws += stream.GetStats().draws;
+			statsFailures += stream.GetStats().failures;
+			statsBytes += stream.GetStats().streamedBytes;
+		}
+
+		uint32_t flushes = 1 + random() % 3;
+		for (uint32_t f = 0; f < flushes; f++)
+		{
+			uint32_t count = 2 + random() % 30;
+			std::vector<TransientVertex> vertices = MakeVertices(nextId, count);
+			stream.AddLineStrip(vertices.data(), count);
+			if (!stream.Flush(&fixture.context))
+			{
+				failed++;
+				nextId += count;
+				continue;
+			}
+			drawn++;
+			streamedBytes += count * STRIDE + (count - 1) * 2 * 4;
+
+			NullRenderCommandRecord draw = fixture.Draws().back();
+			uint32_t begin = draw.args[2] * STRIDE;
+			uint32_t end = begin + count * STRIDE;
+			if (end > capacity) overwrites++;
+
+			// GPU は FRAME_LATENCY フレーム前まで使っている
+			for (uint32_t unit = begin / UNIT; unit < (end + UNIT - 1) / UNIT && unit < owner.size(); unit++)
+			{
+				if (owner[unit] != 0 && owner[unit] != frame && owner[unit] + TransientGeometryStream::FRAME_LATENCY >= frame) overwrites++;
+				owner[unit] = frame;
+			}
+
+			std::vector<float> ids = fixture.ReadBack(draw);
+			for (uint32_t i = 0; i + 1 < count; i++)
+			{
+				if (ids.size() != 2 * (count - 1) || ids[2 * i] != nextId + i || ids[2 * i + 1] != nextId + i + 1) mismatches++;
+			}
+
+			nextId += count;
+		}
+	}
+	stream.BeginFrame();
+	statsDraws += stream.GetStats().draws;
+	statsFailures += stream.GetStats().failures;
+	statsBytes += stream.GetStats().streamedBytes;
+
+	CHECK_EQUAL(overwrites, 0u);
+	CHECK_EQUAL(mismatches, 0u);
+	CHECK(drawn > 300);
+	CHECK(failed > 0);
+	CHECK(stream.GetVertexAllocator().GetStats().wraps > 0);
+
+	// 計測結果は描画の回数・失敗の回数・書き込んだバイト数と合う
+	CHECK_EQUAL(statsDraws, drawn);
+	CHECK_EQUAL(statsFailures, failed);
+	CHECK_EQUAL(statsBytes, streamedBytes);
+	CHECK_EQUAL(fixture.Draws().size(), size_t(drawn));
+	CHECK_EQUAL(fixture.context.GetStats().errors, 0u);
+}
+
+int main() { return ImaseTest::RunTests(); }